@@ -0,0 +1,791 @@
+/**
+ * @summary bench_compile.cc: Measures the throughput and latency of the GpuCC
+ * compile path at increasing thread counts, using a stand-in compiler backend
+ * with configurable latency, output size and failure rate in place of a real
+ * vendor compiler. The time reported is therefore GpuCC's own overhead plus
+ * the configured backend latency, and the benchmark runs on any Linux host.
+ *
+ * Unlike the sample, this program links with libgpucc.so directly rather than
+ * using the runtime loader, since registering a backend requires the internal
+ * GPUCC_PROGRAM_COMPILER_BASE interface.
+ */
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+
+/* @summary Define the value stored in GPUCC_PROGRAM_COMPILER_BASE::BackendVersion by the stand-in backend.
+ * A distinct version keeps its results from ever matching those of a real backend in a shared bytecode cache.
+ */
+#ifndef GPUCC_BENCH_BACKEND_VERSION
+#   define GPUCC_BENCH_BACKEND_VERSION                                         0x000042454E434800ULL
+#endif
+
+/* @summary Define the log text stored in the bytecode container when the stand-in backend reports a failure.
+ */
+static char const BenchFailureLog[] = "bench_compile: simulated compile failure.";
+
+/* @summary Define the behavior of the stand-in compiler backend.
+ * Latency, output and failure are derived from a hash of the source code, so every run over the same corpus does the same work.
+ */
+typedef struct GPUCC_BENCH_BACKEND_CONFIG {
+    uint64_t                       LatencyNanoseconds;                         /* The minimum time spent in each compilation. */
+    uint64_t                       JitterNanoseconds;                          /* The maximum additional time, chosen per source, spent in each compilation. */
+    uint64_t                       OutputSize;                                 /* The number of bytes of bytecode produced by each successful compilation. */
+    uint32_t                       FailurePpm;                                 /* The number of sources per million that fail to compile. */
+    int32_t                        SleepFlag;                                  /* Non-zero to sleep for the latency, or zero to spin, modeling a CPU-bound compiler. */
+} GPUCC_BENCH_BACKEND_CONFIG;
+
+/* @summary Define the compiler record of the stand-in backend.
+ */
+typedef struct GPUCC_COMPILER_BENCH {
+    GPUCC_PROGRAM_COMPILER_BASE    CommonFields;                               /* The fields common to all compiler types. Must be the first field. */
+    GPUCC_BENCH_BACKEND_CONFIG     Backend;                                    /* The behavior of the backend. */
+} GPUCC_COMPILER_BENCH;
+
+/* @summary Define the bytecode container of the stand-in backend.
+ */
+typedef struct GPUCC_BYTECODE_BENCH {
+    GPUCC_PROGRAM_BYTECODE_BASE    CommonFields;                               /* The fields common to all bytecode types. Must be the first field. */
+    uint8_t                       *OutputBuffer;                               /* The buffer holding the generated bytecode. The buffer is retained when the container is reset. */
+    size_t                         OutputCapacity;                             /* The capacity of the OutputBuffer, in bytes. */
+} GPUCC_BYTECODE_BENCH;
+
+/* @summary Define the options specified on the command line.
+ */
+typedef struct GPUCC_BENCH_OPTIONS {
+    GPUCC_BENCH_BACKEND_CONFIG     Backend;                                    /* The behavior of the stand-in backend. */
+    char const                    *CorpusPath;                                 /* The directory of source files to compile, or NULL to generate a corpus. */
+    char const                    *CachePath;                                  /* The bytecode cache directory, or NULL to leave the cache disabled. */
+    uint32_t                       CorpusSize;                                 /* The number of sources to generate if no corpus directory is specified. */
+    uint32_t                       MaxThreads;                                 /* The highest number of compiling threads. */
+    uint32_t                       Iterations;                                 /* The number of passes over the corpus at each thread count. */
+} GPUCC_BENCH_OPTIONS;
+
+/* @summary Define a single source file of the corpus.
+ */
+typedef struct GPUCC_BENCH_SOURCE {
+    std::string                    Path;                                       /* The path or generated name of the source, used in log output. */
+    std::string                    Code;                                       /* The source code. */
+} GPUCC_BENCH_SOURCE;
+
+/* @summary Define the measurements taken by one compiling thread during a run.
+ */
+typedef struct GPUCC_BENCH_THREAD_RESULT {
+    std::vector<uint64_t>          Latency;                                    /* The wall-clock time of each call to gpuccCompileProgramBytecode, in nanoseconds. */
+    uint64_t                       FailureCount;                               /* The number of compilations that failed. */
+    uint64_t                       AllocationCount;                            /* The number of heap allocations made by the thread during the run. */
+} GPUCC_BENCH_THREAD_RESULT;
+
+/* @summary The number of heap allocations made by the calling thread, through the benchmark host allocator or operator new.
+ * The counter is per-thread so that counting does not itself limit scaling.
+ */
+static thread_local uint64_t t_AllocationCount = 0;
+
+/* Replace the global allocation functions so that allocations made with operator new inside libgpucc.so are counted too. */
+void*
+operator new
+(
+    size_t size
+)
+{
+    void *p = nullptr;
+    t_AllocationCount++;
+    if ((p = malloc(size != 0 ? size : 1)) == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void*
+operator new[]
+(
+    size_t size
+)
+{
+    return operator new(size);
+}
+
+void*
+operator new
+(
+    size_t                size,
+    std::nothrow_t const &tag
+) noexcept
+{
+    (void) tag;
+    t_AllocationCount++;
+    return malloc(size != 0 ? size : 1);
+}
+
+void*
+operator new[]
+(
+    size_t                size,
+    std::nothrow_t const &tag
+) noexcept
+{
+    return operator new(size, tag);
+}
+
+void
+operator delete
+(
+    void *address
+) noexcept
+{
+    free(address);
+}
+
+void
+operator delete[]
+(
+    void *address
+) noexcept
+{
+    free(address);
+}
+
+void
+operator delete
+(
+    void                 *address,
+    std::nothrow_t const &tag
+) noexcept
+{
+    (void) tag;
+    free(address);
+}
+
+void
+operator delete[]
+(
+    void                 *address,
+    std::nothrow_t const &tag
+) noexcept
+{
+    (void) tag;
+    free(address);
+}
+
+/* @summary Implement GPUCC_HOST_ALLOCATOR::Allocate on the C runtime heap, counting the allocation.
+ */
+static void*
+gpuccBenchHostAllocate
+(
+    void *user_data,
+    size_t     size,
+    size_t alignment
+)
+{
+    (void) user_data;
+    (void) alignment;
+    t_AllocationCount++;
+    return malloc(size);
+}
+
+/* @summary Implement GPUCC_HOST_ALLOCATOR::Reallocate on the C runtime heap, counting the allocation.
+ */
+static void*
+gpuccBenchHostReallocate
+(
+    void *user_data,
+    void   *address,
+    size_t     size,
+    size_t alignment
+)
+{
+    (void) user_data;
+    (void) alignment;
+    t_AllocationCount++;
+    return realloc(address, size);
+}
+
+/* @summary Implement GPUCC_HOST_ALLOCATOR::Free on the C runtime heap.
+ */
+static void
+gpuccBenchHostFree
+(
+    void *user_data,
+    void   *address
+)
+{
+    (void) user_data;
+    free(address);
+}
+
+/* @summary Compute a 64-bit FNV-1a hash of a source file, used to derive the behavior of the stand-in backend.
+ * @param data The source code.
+ * @param size The number of bytes of source code.
+ * @return The hash value.
+ */
+static uint64_t
+gpuccBenchHashSource
+(
+    char const *data,
+    uint64_t    size
+)
+{
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (uint64_t i = 0; i < size; ++i) {
+        h ^= (uint8_t) data[i];
+        h *= 0x00000100000001B3ULL;
+    }
+    return h;
+}
+
+/* @summary Implement PFN_CreateBytecode for the stand-in backend.
+ */
+static struct GPUCC_PROGRAM_BYTECODE*
+gpuccCreateProgramBytecodeBench
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_BYTECODE_BENCH *code = nullptr;
+
+    if ((code = (GPUCC_BYTECODE_BENCH*) gpuccHostAlloc(gpuccQueryCompilerHostAllocator_(compiler), sizeof(GPUCC_BYTECODE_BENCH), alignof(GPUCC_BYTECODE_BENCH))) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    } memset(code, 0, sizeof(GPUCC_BYTECODE_BENCH));
+
+    code->CommonFields.Compiler      = compiler;
+    code->CommonFields.CompileResult = gpuccMakeResult(GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER);
+    return (struct GPUCC_PROGRAM_BYTECODE*) code;
+}
+
+/* @summary Implement PFN_ResetBytecode for the stand-in backend. The output buffer is retained.
+ */
+static void
+gpuccResetProgramBytecodeBench
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_BYTECODE_BENCH *container_ =(GPUCC_BYTECODE_BENCH*) bytecode;
+
+    container_->CommonFields.BytecodeSize   = 0;
+    container_->CommonFields.BytecodeBuffer = nullptr;
+    container_->CommonFields.LogBufferSize  = 0;
+    container_->CommonFields.LogBuffer      = nullptr;
+}
+
+/* @summary Implement PFN_DeleteBytecode for the stand-in backend.
+ */
+static void
+gpuccDeleteProgramBytecodeBench
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_BYTECODE_BENCH   *container_ =(GPUCC_BYTECODE_BENCH*) bytecode;
+    GPUCC_HOST_ALLOCATOR const  *alloc = gpuccQueryBytecodeHostAllocator_(bytecode);
+
+    gpuccResetProgramBytecodeBench(bytecode);
+    gpuccHostFree(alloc, container_->OutputBuffer);
+    gpuccHostFree(alloc, container_->CommonFields.StringBuffer);
+    gpuccHostFree(alloc, container_);
+}
+
+/* @summary Implement PFN_CompileBytecode for the stand-in backend.
+ * The backend waits for the configured latency, then either fails with a fixed log or produces OutputSize bytes derived from the source hash.
+ */
+static struct GPUCC_RESULT
+gpuccCompileBytecodeBench
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size,
+    char const                  *source_path,
+    char const                  *entry_point
+)
+{
+    GPUCC_COMPILER_BENCH    *compiler_ =(GPUCC_COMPILER_BENCH*) gpuccQueryBytecodeCompiler_(container);
+    GPUCC_BYTECODE_BENCH   *container_ =(GPUCC_BYTECODE_BENCH*) container;
+    GPUCC_BENCH_BACKEND_CONFIG *config =&compiler_->Backend;
+    GPUCC_HOST_ALLOCATOR const  *alloc = gpuccQueryBytecodeHostAllocator_(container);
+    uint64_t                      hash = gpuccBenchHashSource(source_code, source_size);
+    uint64_t                     start = gpuccQueryClockNanoseconds();
+    uint64_t                  deadline = start + config->LatencyNanoseconds;
+
+    (void) source_path;
+    (void) entry_point;
+    if (config->JitterNanoseconds != 0) {
+        deadline += (hash >> 16) % (config->JitterNanoseconds + 1);
+    }
+    if (config->SleepFlag) {
+        uint64_t        ns = deadline - start;
+        struct timespec ts = { (time_t)(ns / 1000000000ULL), (long)(ns % 1000000000ULL) };
+        while (nanosleep(&ts, &ts) != 0) {
+            /* Interrupted by a signal; ts holds the remaining time. */
+        }
+    } else {
+        while (gpuccQueryClockNanoseconds() < deadline) {
+            /* Spin, as a CPU-bound compiler would. */
+        }
+    }
+    start = gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_COMPILE, start);
+
+    if ((hash % 1000000) < config->FailurePpm) {
+        container_->CommonFields.LogBuffer     =(char*) BenchFailureLog;
+        container_->CommonFields.LogBufferSize = sizeof(BenchFailureLog);
+        gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_OUTPUT, start);
+        return gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
+    }
+    if (container_->OutputCapacity < config->OutputSize) {
+        uint8_t *buf = (uint8_t*) gpuccHostRealloc(alloc, container_->OutputBuffer, (size_t) config->OutputSize, alignof(uint64_t));
+        if (buf == nullptr) {
+            gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+            return gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
+        }
+        container_->OutputBuffer   = buf;
+        container_->OutputCapacity =(size_t) config->OutputSize;
+    }
+    for (uint64_t i = 0; i < config->OutputSize; i += sizeof(uint64_t)) {
+        uint64_t n = std::min((uint64_t) sizeof(uint64_t), config->OutputSize - i);
+        memcpy(container_->OutputBuffer + i, &hash, (size_t) n);
+        hash = hash * 0x5851F42D4C957F2DULL + 1;
+    }
+    container_->CommonFields.BytecodeBuffer = container_->OutputBuffer;
+    container_->CommonFields.BytecodeSize   = config->OutputSize;
+    gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_OUTPUT, start);
+    return gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+}
+
+/* @summary Implement PFN_CleanupCompiler for the stand-in backend, which holds no backend objects.
+ */
+static void
+gpuccCleanupCompilerBench
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    (void) compiler;
+}
+
+/* @summary Create a compiler that uses the stand-in backend, and run the setup gpuccCreateCompiler runs for a real backend through gpuccInitCompilerCommon.
+ * The compiler reports itself as a shaderc compiler producing SPIR-V, the backend it replaces on Linux, and is deleted with gpuccDeleteCompiler.
+ * @param config The compiler configuration. The BytecodeType field is ignored.
+ * @param backend The behavior of the stand-in backend.
+ * @return The new compiler, or NULL if memory allocation failed.
+ */
+static struct GPUCC_PROGRAM_COMPILER*
+gpuccCreateCompilerBench
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT      *config,
+    GPUCC_BENCH_BACKEND_CONFIG const       *backend
+)
+{
+    GPUCC_COMPILER_BENCH        *bc = nullptr;
+    struct GPUCC_PROGRAM_COMPILER *c = nullptr;
+    GPUCC_HOST_ALLOCATOR       alloc;
+
+    if (gpuccInitHostAllocator(&alloc, config->HostAllocator) == 0) {
+        return nullptr;
+    }
+    if ((bc = (GPUCC_COMPILER_BENCH*) gpuccHostAlloc(&alloc, sizeof(GPUCC_COMPILER_BENCH), alignof(GPUCC_COMPILER_BENCH))) == nullptr) {
+        return nullptr;
+    } memset(bc, 0, sizeof(GPUCC_COMPILER_BENCH));
+
+    bc->CommonFields.CreateBytecode  = gpuccCreateProgramBytecodeBench;
+    bc->CommonFields.DeleteBytecode  = gpuccDeleteProgramBytecodeBench;
+    bc->CommonFields.ResetBytecode   = gpuccResetProgramBytecodeBench;
+    bc->CommonFields.CompileBytecode = gpuccCompileBytecodeBench;
+    bc->CommonFields.CleanupCompiler = gpuccCleanupCompilerBench;
+    bc->CommonFields.CompilerType    = GPUCC_COMPILER_TYPE_SHADERC;
+    bc->CommonFields.BytecodeType    = GPUCC_BYTECODE_TYPE_SPIRV;
+    bc->CommonFields.BackendVersion  = GPUCC_BENCH_BACKEND_VERSION;
+    bc->CommonFields.HostAllocator   = alloc;
+    bc->Backend                      =*backend;
+    c = (struct GPUCC_PROGRAM_COMPILER*) bc;
+    return gpuccInitCompilerCommon(c, config);
+}
+
+/* @summary Read every regular file in a directory into the corpus.
+ * @param o_corpus The corpus to populate.
+ * @param path The directory path.
+ * @return Non-zero if the directory could be read, or zero otherwise.
+ */
+static int32_t
+gpuccBenchLoadCorpus
+(
+    std::vector<GPUCC_BENCH_SOURCE> &o_corpus,
+    char const                         *path
+)
+{
+    DIR           *dir = nullptr;
+    struct dirent  *ent = nullptr;
+
+    if ((dir = opendir(path)) == nullptr) {
+        return 0;
+    }
+    while ((ent = readdir(dir)) != nullptr) {
+        GPUCC_BENCH_SOURCE src;
+        FILE               *fp = nullptr;
+        char               buf[4096];
+        size_t              nb = 0;
+
+        if (ent->d_name[0] == '.') {
+            continue;
+        }
+        src.Path = std::string(path) + "/" + ent->d_name;
+        if ((fp = fopen(src.Path.c_str(), "rb")) == nullptr) {
+            continue;
+        }
+        while ((nb = fread(buf, 1, sizeof(buf), fp)) > 0) {
+            src.Code.append(buf, nb);
+        }
+        fclose(fp);
+        if (!src.Code.empty()) {
+            o_corpus.push_back(src);
+        }
+    }
+    closedir(dir);
+    std::sort(o_corpus.begin(), o_corpus.end(), [] (GPUCC_BENCH_SOURCE const &a, GPUCC_BENCH_SOURCE const &b) { return a.Path < b.Path; });
+    return 1;
+}
+
+/* @summary Generate a corpus of distinct HLSL-like sources between roughly 0.5 and 16 KB in size.
+ * @param o_corpus The corpus to populate.
+ * @param count The number of sources to generate.
+ */
+static void
+gpuccBenchGenerateCorpus
+(
+    std::vector<GPUCC_BENCH_SOURCE> &o_corpus,
+    uint32_t                           count
+)
+{
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        GPUCC_BENCH_SOURCE src;
+        char               line[128];
+        uint32_t          lines = 0;
+
+        seed  = seed * 0x5851F42D4C957F2DULL + 1;
+        lines = 8 + (uint32_t)((seed >> 33) % 256);
+        snprintf(line, sizeof(line), "generated/shader_%04u.hlsl", i);
+        src.Path = line;
+        snprintf(line, sizeof(line), "// Generated shader %u\nfloat4 main(float4 pos : SV_POSITION) : SV_TARGET0\n{\n    float4 c = pos;\n", i);
+        src.Code = line;
+        for (uint32_t j = 0; j < lines; ++j) {
+            snprintf(line, sizeof(line), "    c = c * float4(%u.0, %u.5, 0.25, 1.0) + c.yzwx;\n", (i + j) % 97, j % 13);
+            src.Code += line;
+        }
+        src.Code += "    return c;\n}\n";
+        o_corpus.push_back(src);
+    }
+}
+
+/* @summary Retrieve a memory usage field of the process from /proc/self/status.
+ * @param field The field name, including the colon, for example "VmRSS:" for the resident set size or "VmHWM:" for its peak.
+ * @return The value of the field, in bytes, or zero if it could not be determined.
+ */
+static uint64_t
+gpuccBenchQueryMemoryStatus
+(
+    char const *field
+)
+{
+    FILE                *fp = fopen("/proc/self/status", "r");
+    size_t               nb = strlen(field);
+    unsigned long long   kb = 0;
+    char               line[256];
+
+    if (fp == nullptr) {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), fp) != nullptr) {
+        if (strncmp(line, field, nb) == 0) {
+            kb = strtoull(line + nb, nullptr, 10);
+            break;
+        }
+    }
+    fclose(fp);
+    return (uint64_t) kb * 1024ULL;
+}
+
+/* @summary Retrieve a percentile of a sorted array of latencies using the nearest-rank method.
+ * @param sorted The latencies, in ascending order.
+ * @param percent The percentile, in [1, 100].
+ * @return The latency at the percentile, or zero if the array is empty.
+ */
+static uint64_t
+gpuccBenchPercentile
+(
+    std::vector<uint64_t> const &sorted,
+    uint64_t                    percent
+)
+{
+    uint64_t rank = 0;
+
+    if (sorted.empty()) {
+        return 0;
+    }
+    rank = (sorted.size() * percent + 99) / 100;
+    return sorted[(size_t)(rank > 0 ? rank - 1 : 0)];
+}
+
+/* @summary Compile a share of the corpus on the calling thread.
+ * Each thread compiles every thread_count'th source, starting at thread_index, reusing one bytecode container for all of them.
+ * @param result On return, stores the measurements taken by the thread. The Latency array must have capacity for every compile.
+ * @param compiler The compiler to use.
+ * @param corpus The corpus to compile.
+ * @param ready Incremented when the thread is ready to start.
+ * @param go Set by the main thread to start all threads at once.
+ * @param thread_index The zero-based index of the thread.
+ * @param thread_count The number of compiling threads.
+ * @param iterations The number of passes over the corpus.
+ */
+static void
+gpuccBenchCompileThread
+(
+    GPUCC_BENCH_THREAD_RESULT             *result,
+    struct GPUCC_PROGRAM_COMPILER        *compiler,
+    std::vector<GPUCC_BENCH_SOURCE> const  *corpus,
+    std::atomic<uint32_t>                  *ready,
+    std::atomic<uint32_t>                     *go,
+    uint32_t                         thread_index,
+    uint32_t                         thread_count,
+    uint32_t                           iterations
+)
+{
+    struct GPUCC_PROGRAM_BYTECODE *b = gpuccCreateBytecodeContainer(compiler);
+    uint64_t                    allocs = 0;
+
+    ready->fetch_add(1, std::memory_order_release);
+    while (go->load(std::memory_order_acquire) == 0) {
+        std::this_thread::yield();
+    }
+    allocs = t_AllocationCount;
+    for (uint32_t pass = 0; pass < iterations && b != nullptr; ++pass) {
+        for (size_t i = thread_index, n = corpus->size(); i < n; i += thread_count) {
+            GPUCC_BENCH_SOURCE const &src = (*corpus)[i];
+            uint64_t                   t0 = 0;
+            GPUCC_RESULT                r;
+
+            gpuccResetBytecodeContainer(b);
+            t0 = gpuccQueryClockNanoseconds();
+            r  = gpuccCompileProgramBytecode(b, src.Code.data(), src.Code.size(), src.Path.c_str(), "main");
+            result->Latency.push_back(gpuccQueryClockNanoseconds() - t0);
+            if (gpuccFailure(r)) {
+                result->FailureCount++;
+            }
+        }
+    }
+    result->AllocationCount = t_AllocationCount - allocs;
+    gpuccDeleteBytecodeContainer(b);
+}
+
+/* @summary Print the command-line usage.
+ * @param exe The name of the executable.
+ */
+static void
+gpuccBenchPrintUsage
+(
+    char const *exe
+)
+{
+    printf("Usage: %s [options]\n", exe);
+    printf("  --threads N          Measure 1, 2, 4, ... up to N compiling threads (default: hardware threads).\n");
+    printf("  --iterations N       Passes over the corpus at each thread count (default: 4).\n");
+    printf("  --corpus DIR         Compile the files in DIR (default: generate a corpus).\n");
+    printf("  --corpus-size N      Number of sources to generate (default: 256).\n");
+    printf("  --cache DIR          Enable the bytecode cache in DIR, which must exist. Later runs then hit the cache.\n");
+    printf("  --latency-us N       Backend latency per compile, in microseconds (default: 200).\n");
+    printf("  --jitter-us N        Maximum additional per-source latency, in microseconds (default: 0).\n");
+    printf("  --output-bytes N     Bytecode size produced per compile (default: 4096).\n");
+    printf("  --failure-rate F     Fraction of sources that fail to compile, in [0, 1] (default: 0.01).\n");
+    printf("  --sleep              Sleep for the backend latency instead of spinning.\n");
+}
+
+/* @summary Parse the command line.
+ * @param o_options On return, stores the options.
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @return Non-zero if the command line was valid, or zero otherwise.
+ */
+static int32_t
+gpuccBenchParseOptions
+(
+    GPUCC_BENCH_OPTIONS *o_options,
+    int                       argc,
+    char                   **argv
+)
+{
+    o_options->Backend.LatencyNanoseconds = 200000;
+    o_options->Backend.JitterNanoseconds  = 0;
+    o_options->Backend.OutputSize         = 4096;
+    o_options->Backend.FailurePpm         = 10000;
+    o_options->Backend.SleepFlag          = 0;
+    o_options->CorpusPath                 = nullptr;
+    o_options->CachePath                  = nullptr;
+    o_options->CorpusSize                 = 256;
+    o_options->MaxThreads                 = std::max(1U, std::thread::hardware_concurrency());
+    o_options->Iterations                 = 4;
+
+    for (int i = 1; i < argc; ++i) {
+        char const *arg = argv[i];
+        char const *val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--sleep") == 0) {
+            o_options->Backend.SleepFlag = 1;
+            continue;
+        }
+        if (val == nullptr) {
+            return 0;
+        }
+        if (strcmp(arg, "--threads") == 0) {
+            o_options->MaxThreads = (uint32_t) strtoul(val, nullptr, 10);
+        } else if (strcmp(arg, "--iterations") == 0) {
+            o_options->Iterations = (uint32_t) strtoul(val, nullptr, 10);
+        } else if (strcmp(arg, "--corpus") == 0) {
+            o_options->CorpusPath = val;
+        } else if (strcmp(arg, "--corpus-size") == 0) {
+            o_options->CorpusSize = (uint32_t) strtoul(val, nullptr, 10);
+        } else if (strcmp(arg, "--cache") == 0) {
+            o_options->CachePath = val;
+        } else if (strcmp(arg, "--latency-us") == 0) {
+            o_options->Backend.LatencyNanoseconds = strtoull(val, nullptr, 10) * 1000ULL;
+        } else if (strcmp(arg, "--jitter-us") == 0) {
+            o_options->Backend.JitterNanoseconds = strtoull(val, nullptr, 10) * 1000ULL;
+        } else if (strcmp(arg, "--output-bytes") == 0) {
+            o_options->Backend.OutputSize = strtoull(val, nullptr, 10);
+        } else if (strcmp(arg, "--failure-rate") == 0) {
+            double rate = strtod(val, nullptr);
+            if (rate < 0.0 || rate > 1.0) {
+                return 0;
+            }
+            o_options->Backend.FailurePpm = (uint32_t)(rate * 1000000.0 + 0.5);
+        } else {
+            return 0;
+        }
+        ++i;
+    }
+    return (o_options->MaxThreads > 0 && o_options->Iterations > 0) ? 1 : 0;
+}
+
+int main
+(
+    int    argc,
+    char **argv
+)
+{
+    GPUCC_BENCH_OPTIONS               options;
+    GPUCC_HOST_ALLOCATOR              counting_alloc = { gpuccBenchHostAllocate, gpuccBenchHostReallocate, gpuccBenchHostFree, nullptr };
+    GPUCC_PROGRAM_COMPILER_INIT       config;
+    std::vector<GPUCC_BENCH_SOURCE>   corpus;
+    std::vector<uint32_t>             thread_counts;
+    struct GPUCC_PROGRAM_COMPILER    *compiler = nullptr;
+    GPUCC_RESULT                      r;
+    double                            base_rate = 0.0;
+
+    if (gpuccBenchParseOptions(&options, argc, argv) == 0) {
+        gpuccBenchPrintUsage(argv[0]);
+        return 1;
+    }
+    if (options.CorpusPath != nullptr) {
+        if (gpuccBenchLoadCorpus(corpus, options.CorpusPath) == 0) {
+            fprintf(stderr, "bench_compile: Cannot read corpus directory \"%s\".\n", options.CorpusPath);
+            return 1;
+        }
+    } else {
+        gpuccBenchGenerateCorpus(corpus, options.CorpusSize);
+    }
+    if (corpus.empty()) {
+        fprintf(stderr, "bench_compile: The corpus is empty.\n");
+        return 1;
+    }
+    if (gpuccFailure((r = gpuccStartup(GPUCC_USAGE_MODE_OFFLINE)))) {
+        fprintf(stderr, "bench_compile: gpuccStartup failed (%s).\n", gpuccErrorString(r.LibraryResult));
+        return 1;
+    }
+    if (options.CachePath != nullptr && gpuccFailure((r = gpuccEnableBytecodeCache(options.CachePath)))) {
+        fprintf(stderr, "bench_compile: Cannot enable the bytecode cache in \"%s\" (%s).\n", options.CachePath, gpuccErrorString(r.LibraryResult));
+        gpuccShutdown();
+        return 1;
+    }
+
+    memset(&config, 0, sizeof(config));
+    config.BytecodeType  = GPUCC_BYTECODE_TYPE_SPIRV;
+    config.TargetRuntime = GPUCC_TARGET_RUNTIME_VULKAN_1_1;
+    config.TargetProfile = "ps_6_0";
+    config.HostAllocator =&counting_alloc;
+    if ((compiler = gpuccCreateCompilerBench(&config, &options.Backend)) == nullptr) {
+        fprintf(stderr, "bench_compile: Cannot create the stand-in compiler.\n");
+        gpuccShutdown();
+        return 1;
+    }
+
+    for (uint32_t n = 1; n < options.MaxThreads; n *= 2) {
+        thread_counts.push_back(n);
+    }
+    thread_counts.push_back(options.MaxThreads);
+
+    printf("Corpus: %zu sources, %u passes per run. Backend: %.1f us %s (+%.1f us jitter), %llu output bytes, %.4f failure rate.\n",
+        corpus.size(), options.Iterations, options.Backend.LatencyNanoseconds / 1000.0, options.Backend.SleepFlag ? "sleep" : "spin",
+        options.Backend.JitterNanoseconds / 1000.0, (unsigned long long) options.Backend.OutputSize, options.Backend.FailurePpm / 1000000.0);
+    printf("%7s %9s %8s %12s %8s %10s %10s %10s %10s %12s %9s\n", "Threads", "Compiles", "Failed", "Compiles/s", "Speedup", "p50 (us)", "p90 (us)", "p99 (us)", "Max (us)", "Allocs/comp", "RSS (MB)");
+
+    for (size_t t = 0; t < thread_counts.size(); ++t) {
+        uint32_t                               nthreads = thread_counts[t];
+        std::vector<GPUCC_BENCH_THREAD_RESULT>  results(nthreads);
+        std::vector<std::thread>                threads;
+        std::vector<uint64_t>                   latency;
+        std::atomic<uint32_t>                   ready(0);
+        std::atomic<uint32_t>                   go(0);
+        uint64_t                                failures = 0;
+        uint64_t                                allocs = 0;
+        uint64_t                                t0 = 0;
+        uint64_t                                elapsed = 0;
+        double                                  rate = 0.0;
+
+        for (uint32_t i = 0; i < nthreads; ++i) {
+            results[i].Latency.reserve((corpus.size() / nthreads + 1) * options.Iterations);
+            results[i].FailureCount    = 0;
+            results[i].AllocationCount = 0;
+            threads.emplace_back(gpuccBenchCompileThread, &results[i], compiler, &corpus, &ready, &go, i, nthreads, options.Iterations);
+        }
+        while (ready.load(std::memory_order_acquire) != nthreads) {
+            std::this_thread::yield();
+        }
+        t0 = gpuccQueryClockNanoseconds();
+        go.store(1, std::memory_order_release);
+        for (size_t i = 0; i < threads.size(); ++i) {
+            threads[i].join();
+        }
+        elapsed = gpuccQueryClockNanoseconds() - t0;
+
+        for (uint32_t i = 0; i < nthreads; ++i) {
+            latency.insert(latency.end(), results[i].Latency.begin(), results[i].Latency.end());
+            failures += results[i].FailureCount;
+            allocs   += results[i].AllocationCount;
+        }
+        std::sort(latency.begin(), latency.end());
+        rate = (elapsed != 0) ? latency.size() * 1000000000.0 / elapsed : 0.0;
+        if (t == 0) {
+            base_rate = rate;
+        }
+        printf("%7u %9zu %8llu %12.1f %7.2fx %10.1f %10.1f %10.1f %10.1f %12.2f %9.1f\n",
+            nthreads, latency.size(), (unsigned long long) failures, rate, (base_rate > 0.0) ? rate / base_rate : 0.0,
+            gpuccBenchPercentile(latency, 50) / 1000.0, gpuccBenchPercentile(latency, 90) / 1000.0,
+            gpuccBenchPercentile(latency, 99) / 1000.0, gpuccBenchPercentile(latency, 100) / 1000.0,
+            latency.empty() ? 0.0 : (double) allocs / latency.size(), gpuccBenchQueryMemoryStatus("VmRSS:") / (1024.0 * 1024.0));
+        fflush(stdout);
+    }
+
+    printf("Peak RSS: %.1f MB\n", gpuccBenchQueryMemoryStatus("VmHWM:") / (1024.0 * 1024.0));
+    gpuccDeleteCompiler(compiler);
+    gpuccShutdown();
+    return 0;
+}
@@ -28,10 +28,53 @@
 #ifndef GPUCC_VERSION_CONSTANTS
 #   define GPUCC_VERSION_CONSTANTS
 #   define GPUCC_VERSION_MAJOR                                                1
-#   define GPUCC_VERSION_MINOR                                                0
+#   define GPUCC_VERSION_MINOR                                                1
 #   define GPUCC_VERSION_PATCH                                                0
 #endif
 
+/* @summary Define the number of values in the GPUCC_COMPILE_PRIORITY enumeration.
+ */
+#ifndef GPUCC_COMPILE_PRIORITY_COUNT
+#   define GPUCC_COMPILE_PRIORITY_COUNT                                       4
+#endif
+
+/* @summary Specify that gpuccWaitCompileJob should wait until the job completes, however long that takes.
+ */
+#ifndef GPUCC_WAIT_INFINITE
+#   define GPUCC_WAIT_INFINITE                                     0xFFFFFFFFUL
+#endif
+
+/* @summary Specify, within a permutation exclusion rule, that the rule matches any value of the corresponding axis.
+ */
+#ifndef GPUCC_PERMUTATION_ANY
+#   define GPUCC_PERMUTATION_ANY                                   0xFFFFFFFFUL
+#endif
+
+/* @summary The value returned by gpuccFindPermutation when no permutation has the given key, and stored in GPUCC_PERMUTATION_ENTRY::BlobIndex when a permutation failed to compile.
+ */
+#ifndef GPUCC_PERMUTATION_NOT_FOUND
+#   define GPUCC_PERMUTATION_NOT_FOUND                             0xFFFFFFFFUL
+#endif
+
+/* @summary The time, in milliseconds, a reload service waits after the most recent file change before recompiling, if GPUCC_RELOAD_SERVICE_INIT::DebounceMilliseconds is zero.
+ * Editors often save a file as several writes and renames, so recompiling on the first notification would compile a partial file.
+ */
+#ifndef GPUCC_RELOAD_DEFAULT_DEBOUNCE_MS
+#   define GPUCC_RELOAD_DEFAULT_DEBOUNCE_MS                                 100
+#endif
+
+/* @summary The time, in milliseconds, a compile running in a worker process waits for the worker to respond before the worker is killed, if GPUCC_WORKER_PROCESS_POOL_INIT::ReplyTimeoutMilliseconds is zero.
+ */
+#ifndef GPUCC_WORKER_DEFAULT_REPLY_TIMEOUT_MS
+#   define GPUCC_WORKER_DEFAULT_REPLY_TIMEOUT_MS                         300000
+#endif
+
+/* @summary The number of events held by the trace buffer of each thread if zero is passed to gpuccEnableTracing.
+ */
+#ifndef GPUCC_TRACE_DEFAULT_EVENT_COUNT
+#   define GPUCC_TRACE_DEFAULT_EVENT_COUNT                                 4096
+#endif
+
 /* @summary A macro used to specify a "public" API function available for use 
  * within other modules (but not necessarily exported from the library).
  * @param _return_type The return type of the function, such as int or void.
@@ -43,6 +86,14 @@
 /* Forward-declare opaque types used by the library but not defined publicly. */
 struct GPUCC_PROGRAM_BYTECODE;
 struct GPUCC_PROGRAM_COMPILER;
+struct GPUCC_COMPILE_JOB;
+struct GPUCC_PERMUTATION_TABLE;
+struct GPUCC_INCLUDE_CACHE;
+struct GPUCC_RELOAD_SERVICE;
+struct GPUCC_PUBLISHED_PROGRAM;
+struct GPUCC_TIERED_COMPILER;
+struct GPUCC_CANCEL_TOKEN;
+struct GPUCC_WORKER_PROCESS_POOL;
 
 /* @summary Define the supported usage modes for the GpuCC library.
  */
@@ -92,6 +143,8 @@ typedef enum GPUCC_ERROR_CODE {
     GPUCC_RESULT_CODE_CANNOT_LOAD                 = -10,                       /* The GpuCC library cannot be dynamically loaded. */
     GPUCC_RESULT_CODE_COMPILE_FAILED              = -11,                       /* Program compilation failed. Check the bytecode object log for more information. */
     GPUCC_RESULT_CODE_INVALID_BYTECODE_CONTAINER  = -12,                       /* The supplied bytecode container is invalid because it has already been used to store compilation results. */
+    GPUCC_RESULT_CODE_TIMEOUT                     = -13,                       /* The wait timed out before the compile job completed. */
+    GPUCC_RESULT_CODE_CANCELLED                   = -14,                       /* The compile job was cancelled, or its deadline passed, before it completed. */
 } GPUCC_RESULT_CODE;
 
 /* @summary Define the set of supported GPU program compilers. Not all compilers are supported on all platforms.
@@ -128,6 +181,50 @@ typedef enum GPUCC_COMPILER_FLAGS {
     GPUCC_COMPILER_FLAG_ENABLE_IEEE_STRICT        = (1ULL <<  6),              /* Conform to IEEE requirements. */
 } GPUCC_COMPILER_FLAGS;
 
+/* @summary Define the forms of #include directive that an include handler may be asked to resolve.
+ */
+typedef enum GPUCC_INCLUDE_TYPE {
+    GPUCC_INCLUDE_TYPE_LOCAL                      =   0,                       /* The directive uses quotes (#include "file"). The directory of the including file is searched first. */
+    GPUCC_INCLUDE_TYPE_SYSTEM                     =   1,                       /* The directive uses angle brackets (#include <file>). Only the search paths are searched. */
+} GPUCC_INCLUDE_TYPE;
+
+/* @summary Define the outcome of a single item processed by gpuccBuildIncremental.
+ */
+typedef enum GPUCC_BUILD_STATUS {
+    GPUCC_BUILD_STATUS_UP_TO_DATE                 =   0,                       /* The output and every file it depends on are unchanged since the last successful build, so the item was not compiled. */
+    GPUCC_BUILD_STATUS_REBUILT                    =   1,                       /* The item was compiled successfully and its output was written. */
+    GPUCC_BUILD_STATUS_FAILED                     =   2,                       /* The item could not be read, compiled or written. The item will be compiled again on the next build. */
+} GPUCC_BUILD_STATUS;
+
+/* @summary Define the priority classes of compile work queued to the internal worker pool.
+ * Workers always start the queued job with the highest priority (lowest value) first. Jobs within a class are started in the order they were queued.
+ */
+typedef enum GPUCC_COMPILE_PRIORITY {
+    GPUCC_COMPILE_PRIORITY_INTERACTIVE            =   0,                       /* The application is blocked waiting for the result, for example a pipeline needed to draw the current frame. */
+    GPUCC_COMPILE_PRIORITY_VISIBLE                =   1,                       /* The result is needed soon, for example by an object that is about to come into view. */
+    GPUCC_COMPILE_PRIORITY_SPECULATIVE            =   2,                       /* The result may be needed, for example a variant prewarmed ahead of a level transition. */
+    GPUCC_COMPILE_PRIORITY_BACKGROUND             =   3,                       /* The result improves on something already available, for example the optimized build of a tiered compile. */
+} GPUCC_COMPILE_PRIORITY;
+
+/* @summary Define the operating system scheduling priorities that can be applied to the compile worker threads.
+ */
+typedef enum GPUCC_WORKER_THREAD_PRIORITY {
+    GPUCC_WORKER_THREAD_PRIORITY_NORMAL           =   0,                       /* Workers run at the default priority. */
+    GPUCC_WORKER_THREAD_PRIORITY_REDUCED          =   1,                       /* Workers run below normal priority (a positive nice value on Linux). */
+    GPUCC_WORKER_THREAD_PRIORITY_IDLE             =   2,                       /* Workers run only when a core would otherwise be idle (SCHED_IDLE on Linux). */
+} GPUCC_WORKER_THREAD_PRIORITY;
+
+/* @summary Define the phases of a compilation for which GpuCC records the elapsed time. See gpuccQueryBytecodeTimings.
+ */
+typedef enum GPUCC_COMPILE_PHASE {
+    GPUCC_COMPILE_PHASE_CACHE_LOOKUP              =   0,                       /* Searching the bytecode cache and joining an identical compilation already in progress, including any time spent waiting for it. */
+    GPUCC_COMPILE_PHASE_STRING_INTERN             =   1,                       /* Copying the entry point and source path into the container, and converting strings into the encoding expected by the backend. */
+    GPUCC_COMPILE_PHASE_BACKEND_SETUP             =   2,                       /* Acquiring backend objects and building the source, options and arguments passed to the backend. */
+    GPUCC_COMPILE_PHASE_COMPILE                   =   3,                       /* Running the backend compiler. For a compiler that uses a worker process pool, the complete round trip to the worker process. */
+    GPUCC_COMPILE_PHASE_OUTPUT                    =   4,                       /* Retrieving the bytecode and log from the backend and copying them into the container. */
+    GPUCC_COMPILE_PHASE_COUNT
+} GPUCC_COMPILE_PHASE;
+
 /* @summary A structure for returning an error result from a GPUCC API call.
  * Use the gpuccFailure and gpuccSuccess functions to determine whether the result represents a failed call.
  */
@@ -136,8 +233,67 @@ typedef struct GPUCC_RESULT {
     int32_t      PlatformResult;                                               /* The error code returned by the underlying platform (errno, GetLastError, etc.) cast to a 32-bit signed integer. */
 } GPUCC_RESULT;
 
+/* @summary Define the signatures of the host memory allocation callbacks supplied through GPUCC_HOST_ALLOCATOR.
+ * Allocate and Reallocate return NULL if the request cannot be satisfied. Reallocate preserves the contents of the existing block up to the smaller of the old and new sizes.
+ * The alignment is a power of two. Free is never called with a NULL address.
+ */
+typedef void* (*PFN_GpuCC_HostAllocate  )(void *user_data, size_t size, size_t alignment);
+typedef void* (*PFN_GpuCC_HostReallocate)(void *user_data, void *address, size_t size, size_t alignment);
+typedef void  (*PFN_GpuCC_HostFree      )(void *user_data, void *address);
+
+/* @summary Define a set of callbacks used to allocate host memory on behalf of a compiler.
+ * Either all three callbacks must be specified, or the application may specify no allocator at all, in which case the C runtime heap is used.
+ * The callbacks may be invoked concurrently from any thread that uses the compiler, including internal worker threads.
+ */
+typedef struct GPUCC_HOST_ALLOCATOR {
+    PFN_GpuCC_HostAllocate    Allocate;                                        /* The function used to allocate a new memory block. */
+    PFN_GpuCC_HostReallocate  Reallocate;                                      /* The function used to resize an existing memory block. */
+    PFN_GpuCC_HostFree        Free;                                            /* The function used to return a memory block. */
+    void                     *UserData;                                        /* Opaque data passed through to each callback. */
+} GPUCC_HOST_ALLOCATOR;
+
+/* @summary Define the data returned by an include handler for a successfully resolved #include directive.
+ * The data must remain valid until the handler's Release callback is invoked for the result.
+ */
+typedef struct GPUCC_INCLUDE_RESULT {
+    char const                *ResolvedPath;                                   /* A nul-terminated UTF-8 string specifying the full path of the file that was opened. This path is passed as the requesting path for nested includes. */
+    char const                *Content;                                        /* The file contents. The byte at Content[ContentSize] must be a nul, since some backends require nul-terminated headers. */
+    uint64_t                   ContentSize;                                    /* The number of bytes of file content, not including the nul. */
+    void                      *Context;                                        /* Opaque data owned by the handler, for use by the Release callback. */
+} GPUCC_INCLUDE_RESULT;
+
+/* @summary Define the signatures of the include handler callbacks supplied through GPUCC_INCLUDE_HANDLER.
+ * Resolve returns non-zero and fills o_result if the file was found, or returns zero if the file could not be found or read.
+ * The requesting path is the ResolvedPath of the including file, the source path passed to the compile call, or NULL if the backend does not report it.
+ */
+typedef int32_t (*PFN_GpuCC_ResolveInclude)(void *user_data, char const *include_path, char const *requesting_path, int32_t include_type, struct GPUCC_INCLUDE_RESULT *o_result);
+typedef void    (*PFN_GpuCC_ReleaseInclude)(void *user_data, struct GPUCC_INCLUDE_RESULT *result);
+
+/* @summary Define a set of callbacks used to resolve #include directives encountered while compiling.
+ * The callbacks may be invoked concurrently from any thread that uses the compiler, including internal worker threads.
+ * Use gpuccQueryIncludeCacheHandler to obtain a handler backed by a shared in-memory file cache.
+ */
+typedef struct GPUCC_INCLUDE_HANDLER {
+    PFN_GpuCC_ResolveInclude   Resolve;                                        /* The function used to locate and load an included file. */
+    PFN_GpuCC_ReleaseInclude   Release;                                        /* The function used to release a result returned by Resolve. */
+    void                      *UserData;                                       /* Opaque data passed through to each callback. */
+} GPUCC_INCLUDE_HANDLER;
+
+/* @summary Define the configuration of the compile scheduler, which divides the CPU time of the internal worker pool between priority classes.
+ * The application calls gpuccCompileSchedulerTick once per frame. Jobs in budgeted classes are only started while the CPU time they consumed since the most recent tick is within the budget.
+ * A job that is running is never interrupted, so a tick may overrun its budget; the overrun is deducted from the following ticks.
+ */
+typedef struct GPUCC_COMPILE_SCHEDULER_CONFIG {
+    uint64_t     TickBudgetNanoseconds;                                        /* The CPU time, summed across all workers, that jobs in budgeted classes may consume per tick, or zero for no limit. */
+    int32_t      BudgetedPriority;                                             /* One of the values of the GPUCC_COMPILE_PRIORITY enumeration. Jobs of this class and every lower class are subject to the budget. */
+    int32_t      WorkerThreadPriority;                                         /* One of the values of the GPUCC_WORKER_THREAD_PRIORITY enumeration specifying the operating system priority of the worker threads. On Linux, lowering the priority cannot be undone without CAP_SYS_NICE. */
+} GPUCC_COMPILE_SCHEDULER_CONFIG;
+
 /* @summary Define the data used to initialize a GpuCC program compiler.
  * Data is copied from this structure into the compiler data at the time of the gpuccCreateCompiler call.
+ * IMPORTANT: Zero-initialize the structure (for example, with = {} or memset) before setting any fields. Fields are added to the end of
+ * the structure as GpuCC gains features, and a zero value always selects the previous behavior, so code that sets fields one by one
+ * continues to work when it is compiled against a newer header, whereas an uninitialized field is read as garbage.
  */
 typedef struct GPUCC_PROGRAM_COMPILER_INIT {
     char const **DefineSymbols;                                                /* An array of DefineCount nul-terminated strings specifying defined preprocessor symbols. */
@@ -147,8 +303,161 @@ typedef struct GPUCC_PROGRAM_COMPILER_INIT {
     int32_t      BytecodeType;                                                 /* One of the values of the GPUCC_BYTECODE_TYPE enumeration specifying the type of bytecode to be generated by the compiler. */
     uint64_t     CompilerFlags;                                                /* One or more bitwise OR'd values of the GPUCC_COMPILER_FLAGS enumeration specifying compiler behaviors. */
     uint32_t     DefineCount;                                                  /* The number of items in the DefineSymbols and DefineValues arrays. */
+    GPUCC_HOST_ALLOCATOR const *HostAllocator;                                 /* The allocator used for the compiler, its bytecode containers and compile jobs, or NULL to use the C runtime heap. The callbacks are copied. */
+    GPUCC_INCLUDE_HANDLER const *IncludeHandler;                               /* The handler used to resolve #include directives, or NULL if the source code must not include other files. The callbacks are copied. */
+    struct GPUCC_WORKER_PROCESS_POOL *WorkerPool;                              /* The pool of worker processes that run the compiler backend, or NULL to run the backend in the calling process. */
+    uint32_t     RecycleCompileCount;                                          /* The number of compilations after which the backend objects are destroyed and recreated, or zero to never recycle them based on the compilation count. */
+    uint64_t     RecycleMemoryBytes;                                           /* The growth in tracked backend memory, in bytes, after which the backend objects are destroyed and recreated, or zero to never recycle them based on memory usage. */
+    uint64_t     BackendArenaSize;                                             /* The size, in bytes, of an arena reserved for each concurrent compilation, from which the backend allocates during a compilation before falling back to the heap, or zero to allocate only from the heap. The arena is reset after each compilation. Only DXC supports arenas. */
 } GPUCC_PROGRAM_COMPILER_INIT;
 
+/* @summary Define the memory usage of a compiler backend, as observed by the allocator through which the backend allocates.
+ * For a compiler, the values cover the lifetime of the compiler. For a bytecode container, the values cover the most recent compilation into the container.
+ */
+typedef struct GPUCC_BACKEND_MEMORY_STATS {
+    uint64_t                       CurrentBytes;                               /* The number of bytes currently allocated. For a bytecode container, the number of bytes allocated by the compilation and still allocated when it completed. */
+    uint64_t                       PeakBytes;                                  /* The largest value of CurrentBytes observed. */
+    uint64_t                       TotalBytes;                                 /* The total number of bytes allocated, including blocks that have since been freed. */
+    uint64_t                       ArenaBytes;                                 /* The portion of TotalBytes allocated from arenas rather than the heap. */
+    uint64_t                       AllocationCount;                            /* The number of allocations. */
+} GPUCC_BACKEND_MEMORY_STATS;
+
+/* @summary Define the time spent in each phase of the most recent compilation into a bytecode container, measured with a monotonic clock.
+ * Phases that were not executed, for example because the result was found in the bytecode cache, are zero.
+ */
+typedef struct GPUCC_COMPILE_TIMINGS {
+    uint64_t                       PhaseNanoseconds[GPUCC_COMPILE_PHASE_COUNT]; /* The time spent in each phase, in nanoseconds, indexed by the values of the GPUCC_COMPILE_PHASE enumeration. */
+    uint64_t                       TotalNanoseconds;                           /* The time spent in gpuccCompileProgramBytecode or its equivalent, in nanoseconds. This exceeds the sum of the phases by the time spent in GpuCC bookkeeping. */
+} GPUCC_COMPILE_TIMINGS;
+
+/* @summary Define a snapshot of the process-wide statistics counters returned by gpuccQueryStatistics.
+ * The counters start at zero when the library is loaded and are never reset. Compute the difference between two snapshots to measure an interval.
+ */
+typedef struct GPUCC_STATISTICS {
+    uint64_t                       CompileCount[GPUCC_COMPILER_TYPE_COUNT];    /* The number of compilations that ran the backend, in process or in a worker process, indexed by the GPUCC_COMPILER_TYPE of the compiler. Includes compiles started by the batch, asynchronous and build functions. Excludes results taken from the bytecode cache or shared from an identical compilation. */
+    uint64_t                       SuccessCount;                               /* The number of calls to gpuccCompileProgramBytecode that succeeded, including those satisfied from the bytecode cache. */
+    uint64_t                       FailureCount;                               /* The number of calls to gpuccCompileProgramBytecode that failed or were cancelled. */
+    uint64_t                       SourceBytes;                                /* The total number of bytes of program source code supplied to the compilations. */
+    uint64_t                       BytecodeBytes;                              /* The total number of bytes of bytecode produced by successful compilations. */
+    uint64_t                       CacheHitCount;                              /* The number of bytecode cache lookups that found a result. Lookups are made only while the bytecode cache is enabled. */
+    uint64_t                       CacheMissCount;                             /* The number of bytecode cache lookups that did not find a result. */
+    uint64_t                       CompileNanoseconds;                         /* The total time spent in the compilations, in nanoseconds. This is the sum of GPUCC_COMPILE_TIMINGS::TotalNanoseconds. */
+    uint64_t                       BackendNanoseconds;                         /* The portion of CompileNanoseconds spent running the backend compiler. This is the sum of the GPUCC_COMPILE_PHASE_COMPILE timings. */
+} GPUCC_STATISTICS;
+
+/* @summary Define the compile latency distribution for one combination of compiler type and target profile, returned by gpuccQueryCompileLatency.
+ * Latencies are the values of GPUCC_COMPILE_TIMINGS::TotalNanoseconds, recorded into logarithmic buckets, so each percentile is accurate to within about 6%.
+ * Only compilations that ran the backend are recorded. Results taken from the bytecode cache or shared from an identical compilation in progress are excluded, since they would skew the distribution towards zero.
+ */
+typedef struct GPUCC_COMPILE_LATENCY {
+    int32_t                        CompilerType;                               /* One of the values of the GPUCC_COMPILER_TYPE enumeration. */
+    char const                    *TargetProfile;                              /* The TargetProfile the compilers were created with, or an empty string. The string remains valid until the library is unloaded. */
+    uint64_t                       SampleCount;                                /* The number of compilations recorded. */
+    uint64_t                       P50Nanoseconds;                             /* The median compile latency, in nanoseconds. */
+    uint64_t                       P90Nanoseconds;                             /* The 90th percentile compile latency, in nanoseconds. */
+    uint64_t                       P99Nanoseconds;                             /* The 99th percentile compile latency, in nanoseconds. */
+    uint64_t                       MaxNanoseconds;                             /* The highest compile latency recorded, in nanoseconds. This value is exact. */
+} GPUCC_COMPILE_LATENCY;
+
+/* @summary Define the configuration of a worker process pool, passed to gpuccCreateWorkerProcessPoolEx.
+ * Zero-initialize the structure and set only the fields whose defaults are not suitable.
+ */
+typedef struct GPUCC_WORKER_PROCESS_POOL_INIT {
+    char const                    *HostPath;                                   /* The path of the executable that hosts the worker processes, which must call gpuccRunWorkerProcess at the start of main, or NULL to use the gpucc_worker executable in the directory containing the GpuCC library. */
+    uint32_t                       WorkerCount;                                /* The number of worker processes. Specify zero to use one worker per hardware thread. */
+    uint32_t                       ReplyTimeoutMilliseconds;                   /* The time a compile waits for each message from its worker before killing the worker and failing, or zero to use GPUCC_WORKER_DEFAULT_REPLY_TIMEOUT_MS. Specify GPUCC_WAIT_INFINITE to wait indefinitely. */
+} GPUCC_WORKER_PROCESS_POOL_INIT;
+
+/* @summary Define the data describing a single compilation within a call to gpuccCompileProgramBatch.
+ * The fields correspond to the arguments of gpuccCompileProgramBytecode. Each item must specify a distinct container.
+ */
+typedef struct GPUCC_COMPILE_BATCH_ITEM {
+    struct GPUCC_PROGRAM_BYTECODE *Container;                                  /* The container that will be used to store the program bytecode. */
+    char const                    *SourceCode;                                 /* Pointer to a buffer containing UTF-8 encoded GPU program source code. */
+    uint64_t                       SourceSize;                                 /* The number of bytes of program source code in the SourceCode buffer. */
+    char const                    *SourcePath;                                 /* A nul-terminated UTF-8 string specifying the path to the source file, for use in log output. This value may be NULL. */
+    char const                    *EntryPoint;                                 /* A nul-terminated string specifying the program entry point. */
+} GPUCC_COMPILE_BATCH_ITEM;
+
+/* @summary Define the aggregate timing information returned by gpuccCompileProgramBatch.
+ * Dividing CompileNanoseconds by ElapsedNanoseconds gives the average number of items compiled in parallel.
+ */
+typedef struct GPUCC_COMPILE_BATCH_TIMING {
+    uint64_t                       ElapsedNanoseconds;                         /* The wall-clock time from the start of the call until the last item completed. */
+    uint64_t                       CompileNanoseconds;                         /* The sum of the time spent compiling each item. */
+    uint64_t                       MaxItemNanoseconds;                         /* The longest time spent compiling any single item. */
+    uint32_t                       ItemCount;                                  /* The number of items in the batch. */
+    uint32_t                       FailureCount;                               /* The number of items whose compilation failed. */
+    uint32_t                       WorkerCount;                                /* The number of pool worker threads available to the batch. The calling thread also compiles items while it waits. */
+} GPUCC_COMPILE_BATCH_TIMING;
+
+/* @summary Define one axis of a permutation space. Each permutation selects exactly one of the axis values.
+ * A NULL entry in the Values array selects the variant in which Symbol is not defined at all.
+ */
+typedef struct GPUCC_PERMUTATION_AXIS {
+    char const                    *Symbol;                                     /* A nul-terminated string specifying the preprocessor symbol controlled by the axis. */
+    char const                   **Values;                                     /* An array of ValueCount nul-terminated strings specifying the values the symbol may take. Entries may be NULL or empty. */
+    uint32_t                       ValueCount;                                 /* The number of items in the Values array. This value must be at least one. */
+} GPUCC_PERMUTATION_AXIS;
+
+/* @summary Define the permutation space compiled by gpuccCompilePermutations.
+ * The space is the cartesian product of the axis values, less any permutation matched by an exclusion rule.
+ * Each exclusion rule is a run of AxisCount value indices, one per axis, in which GPUCC_PERMUTATION_ANY matches every value of that axis.
+ * A permutation is excluded if every entry of any one rule matches it.
+ */
+typedef struct GPUCC_PERMUTATION_SPEC {
+    struct GPUCC_PROGRAM_COMPILER_INIT const *BaseConfig;                      /* The configuration shared by all permutations. Axis symbols are defined after the BaseConfig symbols, and must not repeat them. */
+    struct GPUCC_PERMUTATION_AXIS const      *Axes;                            /* An array of AxisCount axis descriptors. */
+    uint32_t const                           *ExclusionRules;                  /* An array of ExclusionCount * AxisCount value indices specifying the excluded permutations. This value may be NULL if ExclusionCount is zero. */
+    uint32_t                                  AxisCount;                       /* The number of items in the Axes array. */
+    uint32_t                                  ExclusionCount;                  /* The number of exclusion rules. */
+} GPUCC_PERMUTATION_SPEC;
+
+/* @summary Define the data returned for a single permutation by gpuccQueryPermutation.
+ * The permutation key is the mixed-radix number formed from the value indices, with axis zero as the least significant digit.
+ * All pointers remain valid until the permutation table is deleted.
+ */
+typedef struct GPUCC_PERMUTATION_ENTRY {
+    uint64_t                       Key;                                        /* The permutation key. Entries are stored in increasing key order. */
+    uint32_t const                *ValueIndices;                               /* An array of AxisCount indices specifying the value selected on each axis. */
+    char const                    *LogBuffer;                                  /* A nul-terminated UTF-8 string containing the compiler log if the permutation failed to compile, or NULL. */
+    struct GPUCC_RESULT            CompileResult;                              /* The result of compiling the permutation. */
+    uint32_t                       BlobIndex;                                  /* The index of the deduplicated bytecode blob, or GPUCC_PERMUTATION_NOT_FOUND if the permutation failed to compile. */
+} GPUCC_PERMUTATION_ENTRY;
+
+/* @summary Define a single output produced by gpuccBuildIncremental.
+ * An output is identified by OutputPath; two items must not specify the same OutputPath.
+ */
+typedef struct GPUCC_BUILD_ITEM {
+    char const                    *SourcePath;                                 /* A nul-terminated UTF-8 string specifying the path of the source file to compile. */
+    char const                    *EntryPoint;                                 /* A nul-terminated string specifying the program entry point. */
+    char const                    *OutputPath;                                 /* A nul-terminated UTF-8 string specifying the path of the file that receives the bytecode. */
+    char const                    *DepfilePath;                                /* A nul-terminated UTF-8 string specifying the path of a Makefile-style dependency file written alongside the output, or NULL. */
+    char const                    *LogPath;                                    /* A nul-terminated UTF-8 string specifying the path of a file that receives the compiler log whenever the item is compiled, or NULL. */
+} GPUCC_BUILD_ITEM;
+
+/* @summary Define the data returned for a single item by gpuccBuildIncremental.
+ */
+typedef struct GPUCC_BUILD_ITEM_RESULT {
+    struct GPUCC_RESULT            CompileResult;                              /* The result of compiling the item, or GPUCC_RESULT_CODE_SUCCESS if the item was up-to-date. */
+    int32_t                        Status;                                     /* One of the values of the GPUCC_BUILD_STATUS enumeration. */
+} GPUCC_BUILD_ITEM_RESULT;
+
+/* @summary Define the signature of the callback invoked by a reload service each time a program has been compiled.
+ * The callback is invoked on the reload service thread, with no service lock held, so it may call any GpuCC function, including gpuccReloadServiceRemoveProgram.
+ * Ownership of the bytecode container passes to the callback, which must eventually free it with gpuccDeleteBytecodeContainer.
+ * The container is NULL if the source file could not be read or the container could not be created; the result specifies why.
+ */
+typedef void (*PFN_GpuCC_ProgramReloaded)(void *user_data, uint32_t program_id, struct GPUCC_RESULT result, struct GPUCC_PROGRAM_BYTECODE *bytecode);
+
+/* @summary Define the data used to create a reload service with gpuccCreateReloadService.
+ */
+typedef struct GPUCC_RELOAD_SERVICE_INIT {
+    PFN_GpuCC_ProgramReloaded      Callback;                                   /* The function invoked each time a program has been compiled. Required. */
+    void                          *UserData;                                   /* Opaque data passed through to the callback. */
+    uint32_t                       DebounceMilliseconds;                       /* The time to wait after the most recent change before recompiling, or zero to use GPUCC_RELOAD_DEFAULT_DEBOUNCE_MS. */
+} GPUCC_RELOAD_SERVICE_INIT;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -255,7 +564,7 @@ gpuccGetLastResult
 );
 
 /* @summary Create a new GPU program compiler with the given configuration.
- * @param config Data used to configure the compiler instance. Data is copied into the compiler storage before the function returns.
+ * @param config Data used to configure the compiler instance. The structure must be zero-initialized before its fields are set. Data is copied into the compiler storage before the function returns.
  * @return A pointer to the new compiler structure, or NULL if an error occurred.
  */
 GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
@@ -313,7 +622,7 @@ gpuccDeleteBytecodeContainer
 );
 
 /* @summary Compile GPU program source code into intermediate bytecode.
- * The caller is responsible for processing any source code includes and supplying the full resulting source code in the source_code buffer.
+ * Any #include directives are resolved through the GPUCC_PROGRAM_COMPILER_INIT::IncludeHandler specified when the compiler was created. If the compiler has no include handler, the source code must not include other files, and the caller must supply the fully preprocessed source code in the source_code buffer.
  * The function blocks the calling thread until compilation has completed.
  * @param container The container that will be used to store the program bytecode.
  * @param source_code Pointer to a buffer containing UTF-8 encoded GPU program source code.
@@ -420,782 +729,3091 @@ gpuccQueryBytecodeLogBuffer
     struct GPUCC_PROGRAM_BYTECODE *bytecode
 );
 
-#endif /* GPUCC_NO_PROTOTYPES */
+/* @summary Enable the persistent bytecode cache for all subsequent compilations in the process.
+ * Compiled bytecode is stored in the cache directory under a name derived from a hash of the compiler configuration, backend version, entry point and source code.
+ * Only successful compilations are cached. The directory must already exist, and may be shared between processes.
+ * Each entry also records the path and content hash of every file read through the include handler. A cached result is reused only if each of
+ * those paths, opened again through the compiler's include handler, still has the same content.
+ * This function must not be called while compilations are in progress on other threads.
+ * @param cache_directory A nul-terminated UTF-8 string specifying the path of the cache directory.
+ * @return A GPUCC_RESULT value.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccEnableBytecodeCache
+(
+    char const *cache_directory
+);
 
-#ifdef __cplusplus
-}; /* extern "C" */
-#endif
+/* @summary Disable the persistent bytecode cache. Existing cache files are not deleted.
+ * The cache is disabled automatically by gpuccShutdown.
+ * This function must not be called while compilations are in progress on other threads.
+ */
+GPUCC_API(void)
+gpuccDisableBytecodeCache
+(
+    void
+);
 
-#endif /* __GPUCC_H__ */
+/* @summary Start compiling GPU program source code into intermediate bytecode on an internal worker thread.
+ * The function copies the source code and strings and returns immediately. The caller's buffers may be freed as soon as the function returns.
+ * When the job completes, the container holds the same results that gpuccCompileProgramBytecode would have produced, and the usual query functions can be used.
+ * The container must not be accessed until gpuccPollCompileJob returns non-zero or gpuccWaitCompileJob returns a result other than GPUCC_RESULT_CODE_TIMEOUT.
+ * @param container The container that will be used to store the program bytecode.
+ * @param source_code Pointer to a buffer containing UTF-8 encoded GPU program source code.
+ * @param source_size The number of bytes of program source code in the source_code buffer.
+ * @param source_path A nul-terminated UTF-8 string specifying the path to the source file, for use in log output. This value may be NULL.
+ * @param entry_point A nul-terminated string specifying the program entry point.
+ * @return A handle to the compile job, which must be freed with gpuccDeleteCompileJob, or NULL if the job could not be started. Call gpuccGetLastResult to determine the reason for failure.
+ */
+GPUCC_API(struct GPUCC_COMPILE_JOB*)
+gpuccCompileProgramBytecodeAsync
+(
+    struct GPUCC_PROGRAM_BYTECODE *container, 
+    char const                  *source_code, 
+    uint64_t                     source_size, 
+    char const                  *source_path, 
+    char const                  *entry_point
+);
 
-#ifdef GPUCC_LOADER_IMPLEMENTATION
+/* @summary Determine whether an asynchronous compile job has completed, without blocking.
+ * @param job The compile job returned by gpuccCompileProgramBytecodeAsync.
+ * @return Non-zero if the job has completed, or zero if the job is still queued or running.
+ */
+GPUCC_API(int32_t)
+gpuccPollCompileJob
+(
+    struct GPUCC_COMPILE_JOB *job
+);
 
-/* @summary Define a general signature for a dynamically-loaded function.
- * Code will have to cast the function pointer to the correct type.
+/* @summary Block the calling thread until an asynchronous compile job completes or a timeout elapses.
+ * @param job The compile job returned by gpuccCompileProgramBytecodeAsync.
+ * @param timeout_ms The maximum amount of time to wait, in milliseconds. Specify zero to return immediately, or GPUCC_WAIT_INFINITE to wait until the job completes.
+ * @return The result of the compilation if the job completed, or GPUCC_RESULT_CODE_TIMEOUT if the timeout elapsed first.
  */
-typedef int (*PFN_GpuCC_Unknown)(void);
+GPUCC_API(struct GPUCC_RESULT)
+gpuccWaitCompileJob
+(
+    struct GPUCC_COMPILE_JOB *job, 
+    uint32_t           timeout_ms
+);
 
-/* @summary Helper macro for populating a dispatch table with functions loaded at runtime.
- * If the function is not found, the entry point is updated to point to a stub implementation provided by the caller.
- * This macro relies on specific naming conventions:
- * - The signature must be PFN_BlahBlahBlah where BlahBlahBlah corresponds to the _fn argument.
- * - The dispatch table field must be BlahBlahBlah where BlahBlahBlah corresponds to the _fn argument.
- * - The stub function must be named BlahBlahBlah_Stub where BlahBlahBlah corresponds to the _fn argument.
- * @param _disp A pointer to the dispatch table to populate.
- * @param _module The GPUCC_RUNTIME_MODULE representing the module loaded into the process address space.
- * @param _fn The name of the function to dynamically load.
+/* @summary Free resources associated with an asynchronous compile job. If the job has not completed, the calling thread blocks until it does.
+ * Deleting the job does not affect the bytecode container, which must still be deleted with gpuccDeleteBytecodeContainer.
+ * gpuccShutdown runs every queued job to completion, so a job may also be waited for, cancelled or deleted after gpuccShutdown returns.
+ * @param job The compile job to delete. This value may be NULL.
  */
-#ifndef gpuccResolveRuntimeFunction
-#define gpuccResolveRuntimeFunction(_disp, _module, _fn)                       \
-    for (;;) {                                                                 \
-        (_disp)->_fn=(PFN_##_fn) gpuccRuntimeModuleResolve((_module), #_fn);   \
-        if ((_disp)->_fn == NULL) {                                            \
-            (_disp)->_fn  = _fn##_Stub;                                        \
-        } break;                                                               \
-    }
-#endif
+GPUCC_API(void)
+gpuccDeleteCompileJob
+(
+    struct GPUCC_COMPILE_JOB *job
+);
 
-/**
- * Implement a small shim layer for each platform that the loader can rely on 
- * for dynamically loading a DLL or shared object library into the process 
- * address space and resolving entry points.
+/* @summary Compile many GPU programs in parallel on the internal work-stealing worker pool.
+ * Items are divided among the worker threads, and idle workers steal from busy ones, so throughput scales with the number of hardware threads.
+ * The calling thread also compiles items, and the function does not return until every item has completed.
+ * Each item is compiled exactly as if gpuccCompileProgramBytecode had been called with the corresponding fields.
+ * @param items An array of item_count descriptors specifying the compilations to perform. Each item must specify a distinct, empty bytecode container.
+ * @param o_results An array of item_count GPUCC_RESULT values that on return store the result of each compilation.
+ * @param item_count The number of items in the items and o_results arrays.
+ * @param o_timing On return, stores aggregate timing information for the batch. This value may be NULL.
+ * @return GPUCC_RESULT_CODE_SUCCESS if every item compiled successfully, GPUCC_RESULT_CODE_COMPILE_FAILED if one or more items failed, or another code if the batch could not be run.
  */
-#if   defined(__APPLE__)
-#   if defined(TARGET_OS_IPHONE) || defined(TARGET_OS_IPHONE_SIMULATOR)
-#       error No GpuCC loader implementation for iOS (yet).
-#   else
-#       error No GpuCC loader implementation for macOS (yet).
-#   endif
-#elif defined(_WIN32) || defined(_WIN64)
-/** BEGIN WINDOWS **/
-#   ifndef GPUCC_LOADER_NO_INCLUDES
-#       include <Windows.h>
-#   endif
+GPUCC_API(struct GPUCC_RESULT)
+gpuccCompileProgramBatch
+(
+    struct GPUCC_COMPILE_BATCH_ITEM const *items, 
+    struct GPUCC_RESULT               *o_results, 
+    uint32_t                          item_count, 
+    struct GPUCC_COMPILE_BATCH_TIMING  *o_timing
+);
 
-#   ifndef GPUCC_LOADER_UNUSED
-#       define GPUCC_LOADER_UNUSED(_x) (void)(_x)
-#   endif
+/* @summary Return a bytecode container to the empty state so that it can be used for another compilation.
+ * Backend result objects (blobs, compilation results, and any bytecode loaded from the cache) are released, but the container itself and its internal buffers are retained.
+ * Applications that compile repeatedly, for example when hot-reloading, can recycle a fixed set of containers without creating new ones.
+ * Any bytecode, log or string pointers previously retrieved from the container become invalid.
+ * The container must not be reset while an asynchronous compile job is writing to it.
+ * @param bytecode The bytecode container to reset. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccResetBytecodeContainer
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+);
 
-    /* @summary Declare the runtime module type. On Windows, this is the type returned by LoadLibraryW.
-     */
-    typedef HMODULE GPUCC_RUNTIME_MODULE;
+/* @summary Compile every permutation of a preprocessor define space from a single source, in parallel on the internal worker pool.
+ * Each permutation is compiled with a transient compiler created from the BaseConfig plus the axis defines, exactly as if the application had created it with gpuccCreateCompiler.
+ * Permutations that produce byte-identical bytecode share a single blob in the returned table.
+ * The calling thread also compiles permutations, and the function does not return until every permutation has completed.
+ * @param spec The permutation space to compile.
+ * @param source_code Pointer to a buffer containing UTF-8 encoded GPU program source code.
+ * @param source_size The number of bytes of program source code in the source_code buffer.
+ * @param source_path A nul-terminated UTF-8 string specifying the path to the source file, for use in log output. This value may be NULL.
+ * @param entry_point A nul-terminated string specifying the program entry point.
+ * @return A permutation table, which must be freed with gpuccDeletePermutationTable, or NULL if the permutations could not be compiled. If one or more permutations failed to compile, the table is still returned and gpuccGetLastResult returns GPUCC_RESULT_CODE_COMPILE_FAILED.
+ */
+GPUCC_API(struct GPUCC_PERMUTATION_TABLE*)
+gpuccCompilePermutations
+(
+    struct GPUCC_PERMUTATION_SPEC const *spec, 
+    char const                   *source_code, 
+    uint64_t                      source_size, 
+    char const                   *source_path, 
+    char const                   *entry_point
+);
 
-    /* @summary Resolve a function entry point declared with C linkage.
-     * This function is used by the gpuccResolveRuntimeFunction macro.
-     * @param module The module handle of the DLL.
-     * @param symbol The unmangled symbol name.
-     * @return A pointer to the function loaded into the process address space, or NULL if the entry point is not found.
-     */
-    static PFN_GpuCC_Unknown
-    gpuccRuntimeModuleResolve
-    (
-        GPUCC_RUNTIME_MODULE module, 
-        char const          *symbol
-    )
-    {
-        if (module != NULL) {
-            return (PFN_GpuCC_Unknown) GetProcAddress(module, symbol);
-        } else {
-            return (PFN_GpuCC_Unknown) NULL;
-        }
-    }
+/* @summary Free resources associated with a permutation table.
+ * @param table The permutation table to delete. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccDeletePermutationTable
+(
+    struct GPUCC_PERMUTATION_TABLE *table
+);
 
-    /* @summary Load the GpuCC DLL into the address space of the calling process.
-     * @return The module handle, or NULL if GpuCC.dll could not be loaded.
-     */
-    static GPUCC_RUNTIME_MODULE
-    gpuccRuntimeModuleLoad
-    (
-        void
-    )
-    {
-        return (GPUCC_RUNTIME_MODULE) LoadLibraryW(L"gpucc.dll");
-    }
+/* @summary Retrieve the number of permutations stored in a permutation table. Excluded permutations are not stored.
+ * @param table The permutation table returned by gpuccCompilePermutations.
+ * @return The number of permutations.
+ */
+GPUCC_API(uint32_t)
+gpuccQueryPermutationCount
+(
+    struct GPUCC_PERMUTATION_TABLE *table
+);
 
-    /* @summary Unload the GpuCC DLL from the address space of the calling process.
-     */
-    static void
-    gpuccRuntimeModuleUnload
-    (
-        GPUCC_RUNTIME_MODULE module
-    )
-    {
-        if (module != NULL) {
-            FreeLibrary(module);
-        }
-    }
+/* @summary Retrieve the number of distinct bytecode blobs stored in a permutation table.
+ * @param table The permutation table returned by gpuccCompilePermutations.
+ * @return The number of distinct blobs.
+ */
+GPUCC_API(uint32_t)
+gpuccQueryPermutationBlobCount
+(
+    struct GPUCC_PERMUTATION_TABLE *table
+);
 
-/*** END WINDOWS ***/
-#elif defined(__linux__) || defined(__gnu_linux__)
-#   error No GpuCC loader implementation for Linux (yet).
-#else
-#   error No GpuCC loader implementation for your platform (yet).
-#endif
+/* @summary Retrieve the data associated with a single permutation.
+ * @param table The permutation table returned by gpuccCompilePermutations.
+ * @param index The zero-based index of the permutation, which must be less than the value returned by gpuccQueryPermutationCount.
+ * @param o_entry On return, stores the permutation data.
+ * @return Non-zero if the entry was retrieved, or zero if an argument was invalid.
+ */
+GPUCC_API(int32_t)
+gpuccQueryPermutation
+(
+    struct GPUCC_PERMUTATION_TABLE   *table, 
+    uint32_t                          index, 
+    struct GPUCC_PERMUTATION_ENTRY *o_entry
+);
 
-/*** FUNCTION POINTER TYPES ***/
-typedef void                           (*PFN_gpuccVersion                   )(int32_t*, int32_t*, int32_t*);
-typedef int32_t                        (*PFN_gpuccFailure                   )(struct GPUCC_RESULT);
-typedef int32_t                        (*PFN_gpuccSuccess                   )(struct GPUCC_RESULT);
-typedef char const*                    (*PFN_gpuccErrorString               )(int32_t);
-typedef char const*                    (*PFN_gpuccBytecodeTypeString        )(int32_t);
-typedef char const*                    (*PFN_gpuccCompilerTypeString        )(int32_t);
-typedef struct GPUCC_RESULT            (*PFN_gpuccStartup                   )(uint32_t gpucc_usage_mode);
-typedef void                           (*PFN_gpuccShutdown                  )(void);
-typedef struct GPUCC_RESULT            (*PFN_gpuccGetLastResult             )(void);
-typedef struct GPUCC_PROGRAM_COMPILER* (*PFN_gpuccCreateCompiler            )(struct GPUCC_PROGRAM_COMPILER_INIT*);
-typedef void                           (*PFN_gpuccDeleteCompiler            )(struct GPUCC_PROGRAM_COMPILER*);
-typedef int32_t                        (*PFN_gpuccQueryCompilerType         )(struct GPUCC_PROGRAM_COMPILER*);
-typedef int32_t                        (*PFN_gpuccQueryBytecodeType         )(struct GPUCC_PROGRAM_COMPILER*);
-typedef struct GPUCC_PROGRAM_BYTECODE* (*PFN_gpuccCreateBytecodeContainer   )(struct GPUCC_PROGRAM_COMPILER*);
-typedef void                           (*PFN_gpuccDeleteBytecodeContainer   )(struct GPUCC_PROGRAM_BYTECODE*);
-typedef struct GPUCC_PROGRAM_COMPILER* (*PFN_gpuccQueryBytecodeCompiler     )(struct GPUCC_PROGRAM_BYTECODE*);
-typedef char const*                    (*PFN_gpuccQueryBytecodeEntryPoint   )(struct GPUCC_PROGRAM_BYTECODE*);
-typedef char const*                    (*PFN_gpuccQueryBytecodeSourcePath   )(struct GPUCC_PROGRAM_BYTECODE*);
-typedef struct GPUCC_RESULT            (*PFN_gpuccQueryBytecodeCompileResult)(struct GPUCC_PROGRAM_BYTECODE*);
-typedef uint64_t                       (*PFN_gpuccQueryBytecodeSizeBytes    )(struct GPUCC_PROGRAM_BYTECODE*);
-typedef uint64_t                       (*PFN_gpuccQueryBytecodeLogSizeBytes )(struct GPUCC_PROGRAM_BYTECODE*);
-typedef uint8_t*                       (*PFN_gpuccQueryBytecodeBuffer       )(struct GPUCC_PROGRAM_BYTECODE*);
-typedef char*                          (*PFN_gpuccQueryBytecodeLogBuffer    )(struct GPUCC_PROGRAM_BYTECODE*);
-typedef struct GPUCC_RESULT            (*PFN_gpuccCompileProgramBytecode    )(struct GPUCC_PROGRAM_BYTECODE*, char const*, uint64_t, char const*, char const*);
+/* @summary Locate the permutation with a given key.
+ * @param table The permutation table returned by gpuccCompilePermutations.
+ * @param key The permutation key.
+ * @return The zero-based index of the permutation, or GPUCC_PERMUTATION_NOT_FOUND if the key is not present because the permutation was excluded or is out of range.
+ */
+GPUCC_API(uint32_t)
+gpuccFindPermutation
+(
+    struct GPUCC_PERMUTATION_TABLE *table, 
+    uint64_t                          key
+);
 
-/* @summary Define the dispatch table structure used for calling runtime-resolved GpuCC entry points.
+/* @summary Retrieve one of the distinct bytecode blobs stored in a permutation table.
+ * @param table The permutation table returned by gpuccCompilePermutations.
+ * @param blob_index The zero-based index of the blob, which must be less than the value returned by gpuccQueryPermutationBlobCount.
+ * @param o_size On return, stores the size of the blob, in bytes. This value may be NULL.
+ * @return A pointer to the bytecode, which remains valid until the table is deleted, or NULL if an argument was invalid.
  */
-typedef struct GPUCC_LOADER_DISPATCH {
-    PFN_gpuccVersion                     gpuccVersion;
-    PFN_gpuccFailure                     gpuccFailure;
-    PFN_gpuccSuccess                     gpuccSuccess;
-    PFN_gpuccErrorString                 gpuccErrorString;
-    PFN_gpuccBytecodeTypeString          gpuccBytecodeTypeString;
-    PFN_gpuccCompilerTypeString          gpuccCompilerTypeString;
-    PFN_gpuccStartup                     gpuccStartup;
-    PFN_gpuccShutdown                    gpuccShutdown;
-    PFN_gpuccGetLastResult               gpuccGetLastResult;
-    PFN_gpuccCreateCompiler              gpuccCreateCompiler;
-    PFN_gpuccDeleteCompiler              gpuccDeleteCompiler;
-    PFN_gpuccQueryCompilerType           gpuccQueryCompilerType;
-    PFN_gpuccQueryBytecodeType           gpuccQueryBytecodeType;
-    PFN_gpuccCreateBytecodeContainer     gpuccCreateBytecodeContainer;
-    PFN_gpuccDeleteBytecodeContainer     gpuccDeleteBytecodeContainer;
-    PFN_gpuccQueryBytecodeCompiler       gpuccQueryBytecodeCompiler;
-    PFN_gpuccQueryBytecodeEntryPoint     gpuccQueryBytecodeEntryPoint;
-    PFN_gpuccQueryBytecodeSourcePath     gpuccQueryBytecodeSourcePath;
-    PFN_gpuccQueryBytecodeCompileResult  gpuccQueryBytecodeCompileResult;
-    PFN_gpuccQueryBytecodeSizeBytes      gpuccQueryBytecodeSizeBytes;
-    PFN_gpuccQueryBytecodeLogSizeBytes   gpuccQueryBytecodeLogSizeBytes;
-    PFN_gpuccQueryBytecodeBuffer         gpuccQueryBytecodeBuffer;
-    PFN_gpuccQueryBytecodeLogBuffer      gpuccQueryBytecodeLogBuffer;
-    PFN_gpuccCompileProgramBytecode      gpuccCompileProgramBytecode;
-    GPUCC_RUNTIME_MODULE                 ModuleHandle_GpuCC;
-} GPUCC_LOADER_DISPATCH;
-
-/*** STUB IMPLEMENTATIONS ***/
-static void
-gpuccVersion_Stub
+GPUCC_API(uint8_t const*)
+gpuccQueryPermutationBlob
 (
-    int32_t *o_major, 
-    int32_t *o_minor, 
-    int32_t *o_patch
-)
-{
-    if (o_major) *o_major = 0;
-    if (o_minor) *o_minor = 0;
-    if (o_patch) *o_patch = 0;
-}
+    struct GPUCC_PERMUTATION_TABLE *table, 
+    uint32_t                   blob_index, 
+    uint64_t                      *o_size
+);
 
-static int32_t
-gpuccFailure_Stub
+/* @summary Create a thread-safe, in-memory cache of included files that can be shared by any number of compilers.
+ * Each file is read from disk once and shared by every compile that includes it, until its modification time or size changes.
+ * @param search_paths An array of search_path_count nul-terminated UTF-8 strings specifying the directories searched for included files, in order. The strings are copied.
+ * @param search_path_count The number of items in the search_paths array.
+ * @return A pointer to the include cache, which must be freed with gpuccDeleteIncludeCache, or NULL if an error occurred.
+ */
+GPUCC_API(struct GPUCC_INCLUDE_CACHE*)
+gpuccCreateIncludeCache
 (
-    struct GPUCC_RESULT r
-)
-{
-    return (r.LibraryResult < 0);
-}
+    char const  **search_paths, 
+    uint32_t search_path_count
+);
 
-static int32_t
-gpuccSuccess_Stub
+/* @summary Free resources associated with an include cache.
+ * Every compiler created with a handler for the cache must be deleted first.
+ * @param cache The include cache to delete. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccDeleteIncludeCache
 (
-    struct GPUCC_RESULT r
-)
-{
-    return (r.LibraryResult >= 0);
-}
+    struct GPUCC_INCLUDE_CACHE *cache
+);
 
-static char const*
-gpuccErrorString_Stub
+/* @summary Retrieve an include handler that resolves #include directives through an include cache.
+ * Specify the handler in GPUCC_PROGRAM_COMPILER_INIT::IncludeHandler.
+ * @param cache The include cache returned by gpuccCreateIncludeCache.
+ * @param o_handler On return, stores the include handler callbacks.
+ */
+GPUCC_API(void)
+gpuccQueryIncludeCacheHandler
 (
-    int32_t gpucc_result_code
-)
-{
-    switch (gpucc_result_code) {
-        case GPUCC_RESULT_CODE_SUCCESS                   : return "GPUCC_RESULT_CODE_SUCCESS";
-        case GPUCC_RESULT_CODE_ALREADY_INITIALIZED       : return "GPUCC_RESULT_CODE_ALREADY_INITIALIZED";
-        case GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER  : return "GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER";
-        case GPUCC_RESULT_CODE_NOT_INITIALIZED           : return "GPUCC_RESULT_CODE_NOT_INITIALIZED";
-        case GPUCC_RESULT_CODE_PLATFORM_ERROR            : return "GPUCC_RESULT_CODE_PLATFORM_ERROR";
-        case GPUCC_RESULT_CODE_INVALID_USAGE_MODE        : return "GPUCC_RESULT_CODE_INVALID_USAGE_MODE";
-        case GPUCC_RESULT_CODE_COMPILER_NOT_SUPPORTED    : return "GPUCC_RESULT_CODE_COMPILER_NOT_SUPPORTED";
-        case GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY        : return "GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY";
-        case GPUCC_RESULT_CODE_INVALID_TARGET_PROFILE    : return "GPUCC_RESULT_CODE_INVALID_TARGET_PROFILE";
-        case GPUCC_RESULT_CODE_INVALID_TARGET_RUNTIME    : return "GPUCC_RESULT_CODE_INVALID_TARGET_RUNTIME";
-        case GPUCC_RESULT_CODE_INVALID_BYTECODE_TYPE     : return "GPUCC_RESULT_CODE_INVALID_BYTECODE_TYPE";
-        case GPUCC_RESULT_CODE_INVALID_ARGUMENT          : return "GPUCC_RESULT_CODE_INVALID_ARGUMENT";
-        case GPUCC_RESULT_CODE_CANNOT_LOAD               : return "GPUCC_RESULT_CODE_CANNOT_LOAD";
-        case GPUCC_RESULT_CODE_COMPILE_FAILED            : return "GPUCC_RESULT_CODE_COMPILE_FAILED";
-        case GPUCC_RESULT_CODE_INVALID_BYTECODE_CONTAINER: return "GPUCC_RESULT_CODE_INVALID_BYTECODE_CONTAINER";
-        default                                          : return "GPUCC_RESULT_CODE (unknown)";
-    }
-}
+    struct GPUCC_INCLUDE_CACHE       *cache, 
+    struct GPUCC_INCLUDE_HANDLER *o_handler
+);
 
-static char const*
-gpuccBytecodeTypeString_Stub
+/* @summary Retrieve the number of files read through the include handler while compiling the program stored in a bytecode container.
+ * Each file is counted once, however many times it was included. The main source file is not included in the count.
+ * Dependencies are only recorded for compilers created with an include handler.
+ * @param bytecode The program bytecode object to query.
+ * @return The number of dependencies, or zero if the container is empty.
+ */
+GPUCC_API(uint32_t)
+gpuccQueryBytecodeDependencyCount
 (
-    int32_t gpucc_bytecode_type
-)
-{
-    switch (gpucc_bytecode_type) {
-        case GPUCC_BYTECODE_TYPE_UNKNOWN: return "GPUCC_BYTECODE_TYPE_UNKNOWN";
-        case GPUCC_BYTECODE_TYPE_DXIL   : return "GPUCC_BYTECODE_TYPE_DXIL";
-        case GPUCC_BYTECODE_TYPE_DXBC   : return "GPUCC_BYTECODE_TYPE_DXBC";
-        case GPUCC_BYTECODE_TYPE_SPIRV  : return "GPUCC_BYTECODE_TYPE_SPIRV";
-        case GPUCC_BYTECODE_TYPE_PTX    : return "GPUCC_BYTECODE_TYPE_PTX";
-        default                         : return "GPUCC_BYTECODE_TYPE (unknown)";
-    }
-}
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+);
 
-static char const*
-gpuccCompilerTypeString_Stub
+/* @summary Retrieve the resolved path of a file read through the include handler while compiling the program stored in a bytecode container.
+ * Dependencies are listed in the order they were first opened.
+ * @param bytecode The program bytecode object to query.
+ * @param index The zero-based index of the dependency, less than the value returned by gpuccQueryBytecodeDependencyCount.
+ * @return A nul-terminated UTF-8 string specifying the path, or NULL if index is out of range. The string remains valid until the container is reset or deleted.
+ */
+GPUCC_API(char const*)
+gpuccQueryBytecodeDependency
 (
-    int32_t gpucc_compiler_type
-)
-{
-    switch (gpucc_compiler_type) {
-        case GPUCC_COMPILER_TYPE_UNKNOWN: return "GPUCC_COMPILER_TYPE_UNKNOWN";
-        case GPUCC_COMPILER_TYPE_DXC    : return "GPUCC_COMPILER_TYPE_DXC";
-        case GPUCC_COMPILER_TYPE_FXC    : return "GPUCC_COMPILER_TYPE_FXC";
-        case GPUCC_COMPILER_TYPE_SHADERC: return "GPUCC_COMPILER_TYPE_SHADERC";
-        case GPUCC_COMPILER_TYPE_NVRTC  : return "GPUCC_COMPILER_TYPE_NVRTC";
-        default                         : return "GPUCC_COMPILER_TYPE (unknown)";
-    }
-}
+    struct GPUCC_PROGRAM_BYTECODE *bytecode, 
+    uint32_t                          index
+);
 
-static struct GPUCC_RESULT
-gpuccStartup_Stub
+/* @summary Write a Makefile-style dependency file, as understood by make and Ninja, listing the source file and every dependency recorded in a bytecode container.
+ * The file contains a single rule, "target_path: source_path dependency...", with special characters escaped.
+ * @param bytecode A bytecode container holding the results of a compilation.
+ * @param target_path A nul-terminated UTF-8 string specifying the path of the build output named as the rule target.
+ * @param depfile_path A nul-terminated UTF-8 string specifying the path of the dependency file to write. Any existing file is replaced.
+ * @return A GPUCC_RESULT specifying whether the file was written.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccWriteDependencyFile
 (
-    uint32_t gpucc_usage_mode
-)
-{
-    GPUCC_LOADER_UNUSED(gpucc_usage_mode);
-    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
-}
+    struct GPUCC_PROGRAM_BYTECODE *bytecode, 
+    char const                 *target_path, 
+    char const                *depfile_path
+);
 
-static void
-gpuccShutdown_Stub
+/* @summary Bring a set of build outputs up-to-date, compiling only the items whose source file, included files or configuration changed since they were last built.
+ * The build state file records, for each output, a hash of the compiler configuration and entry point, and a content hash of the source file and every file it included.
+ * An item is compiled if its output is missing, it has no record, or any recorded hash differs. Each file is hashed at most once per call, however many items depend on it.
+ * Items that need compiling are compiled in parallel on the internal worker pool. The calling thread also compiles items, and the function does not return until every item has completed.
+ * If config does not specify an include handler, a private include cache with no search paths is used, so that dependencies can be recorded.
+ * Records for outputs not named in items are retained, so a build state file may be shared by several calls that build different subsets.
+ * @param config The configuration used to create the compiler for all items.
+ * @param state_path A nul-terminated UTF-8 string specifying the path of the build state file. The file is created if it does not exist.
+ * @param items An array of item_count items specifying the outputs to build.
+ * @param o_results An array of item_count locations that receive the result for each item.
+ * @param item_count The number of items.
+ * @return GPUCC_RESULT_CODE_SUCCESS if every item is up-to-date or was rebuilt, GPUCC_RESULT_CODE_COMPILE_FAILED if one or more items failed, or another code if the build could not be performed.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccBuildIncremental
 (
-    void
-)
-{
-    /* empty */
-}
+    struct GPUCC_PROGRAM_COMPILER_INIT const *config, 
+    char const                           *state_path, 
+    struct GPUCC_BUILD_ITEM const             *items, 
+    struct GPUCC_BUILD_ITEM_RESULT        *o_results, 
+    uint32_t                              item_count
+);
 
-static struct GPUCC_RESULT
-gpuccGetLastResult_Stub
+/* @summary Create a reload service, which recompiles programs in the background whenever their source file or any file they include changes on disk.
+ * The service is intended for use with GPUCC_USAGE_MODE_RUNTIME, where shaders are edited while the application is running.
+ * The service watches the directory containing each source file and each included file. Changes are collected until no further change has been seen for the debounce interval, and then only the programs that read a changed file are recompiled, in parallel, on the internal worker pool.
+ * Each result is delivered through the callback on the service thread.
+ * @param init Data used to configure the reload service.
+ * @return A pointer to the reload service, which must be freed with gpuccDeleteReloadService, or NULL if an error occurred.
+ */
+GPUCC_API(struct GPUCC_RELOAD_SERVICE*)
+gpuccCreateReloadService
 (
-    void
-)
-{
-    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
-}
+    struct GPUCC_RELOAD_SERVICE_INIT const *init
+);
 
-static struct GPUCC_PROGRAM_COMPILER*
-gpuccCreateCompiler_Stub
+/* @summary Stop a reload service and free its resources. Pending changes are discarded.
+ * This function blocks the calling thread until any compilation in progress has finished and the service thread has exited. It must not be called from the callback.
+ * @param service The reload service to delete. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccDeleteReloadService
 (
-    struct GPUCC_PROGRAM_COMPILER_INIT *config
-)
-{
-    GPUCC_LOADER_UNUSED(config);
-    return NULL;
-}
+    struct GPUCC_RELOAD_SERVICE *service
+);
 
-static void
-gpuccDeleteCompiler_Stub
+/* @summary Register a program with a reload service. The program is compiled once in the background, and then again each time a file it reads changes.
+ * Included files are only watched if the compiler was created with an include handler, since that is how GpuCC learns which files a program reads. Otherwise only the source file is watched.
+ * The compiler must not be deleted until the program has been removed or the service deleted.
+ * @param service The reload service returned by gpuccCreateReloadService.
+ * @param compiler The compiler used to compile the program.
+ * @param source_path A nul-terminated UTF-8 string specifying the path of the source file.
+ * @param entry_point A nul-terminated string specifying the program entry point.
+ * @param o_program_id On return, stores the non-zero identifier of the program, which is passed to the callback.
+ * @return A GPUCC_RESULT specifying whether the program was registered.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccReloadServiceAddProgram
 (
-    struct GPUCC_PROGRAM_COMPILER *compiler
-)
-{
-    GPUCC_LOADER_UNUSED(compiler);
-}
+    struct GPUCC_RELOAD_SERVICE    *service, 
+    struct GPUCC_PROGRAM_COMPILER *compiler, 
+    char const                 *source_path, 
+    char const                 *entry_point, 
+    uint32_t                  *o_program_id
+);
 
-static int32_t
-gpuccQueryCompilerType_Stub
+/* @summary Unregister a program from a reload service. The callback is not invoked for the program once this function returns.
+ * If the program is being compiled, the result is discarded. If the callback is running for the program on another thread, this function waits for it to return.
+ * @param service The reload service returned by gpuccCreateReloadService.
+ * @param program_id The identifier returned by gpuccReloadServiceAddProgram. Unknown identifiers are ignored.
+ */
+GPUCC_API(void)
+gpuccReloadServiceRemoveProgram
 (
-    struct GPUCC_PROGRAM_COMPILER *compiler
-)
-{
-    GPUCC_LOADER_UNUSED(compiler);
-    return GPUCC_COMPILER_TYPE_UNKNOWN;
-}
+    struct GPUCC_RELOAD_SERVICE *service, 
+    uint32_t                  program_id
+);
 
-static int32_t
-gpuccQueryBytecodeType_Stub
+/* @summary Create a published program, through which threads can read the current bytecode of a program while another thread replaces it.
+ * Reading threads bracket each use of the bytecode with gpuccAcquirePublishedProgram and gpuccReleasePublishedProgram, which never block.
+ * A recompiled container is swapped in with gpuccPublishProgramBytecode, also without blocking. The replaced container is freed once no thread can still be reading it.
+ * @param bytecode The initially published bytecode container, or NULL. Ownership of the container passes to the published program.
+ * @return A pointer to the published program, which must be freed with gpuccDeletePublishedProgram, or NULL if memory allocation failed.
+ */
+GPUCC_API(struct GPUCC_PUBLISHED_PROGRAM*)
+gpuccCreatePublishedProgram
 (
-    struct GPUCC_PROGRAM_COMPILER *compiler
-)
-{
-    GPUCC_LOADER_UNUSED(compiler);
-    return GPUCC_BYTECODE_TYPE_UNKNOWN;
-}
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+);
 
-static struct GPUCC_PROGRAM_BYTECODE*
-gpuccCreateBytecodeContainer_Stub
+/* @summary Delete a published program, freeing the published container and any replaced containers not yet freed.
+ * No thread may hold the program acquired, or acquire it, during or after the call.
+ * @param program The published program to delete. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccDeletePublishedProgram
 (
-    struct GPUCC_PROGRAM_COMPILER *compiler
-)
-{
-    GPUCC_LOADER_UNUSED(compiler);
-    return NULL;
-}
+    struct GPUCC_PUBLISHED_PROGRAM *program
+);
 
-static void
-gpuccDeleteBytecodeContainer_Stub
+/* @summary Replace the bytecode container of a published program. Threads that acquire the program after this call returns see the new container.
+ * The previous container is retired, and freed with gpuccDeleteBytecodeContainer once every thread that might be reading it has released its acquire.
+ * Each call also frees any previously retired containers that are no longer in use. The compiler of a retired container must outlive the published program.
+ * This function may be called from any thread, including from a reload service callback.
+ * @param program The published program to update.
+ * @param bytecode The bytecode container to publish, or NULL. Ownership of the container passes to the published program.
+ * @return A GPUCC_RESULT specifying whether the container was published. On failure, ownership of the container remains with the caller.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccPublishProgramBytecode
 (
+    struct GPUCC_PUBLISHED_PROGRAM *program, 
     struct GPUCC_PROGRAM_BYTECODE *bytecode
-)
-{
-    GPUCC_LOADER_UNUSED(bytecode);
-}
+);
 
-static struct GPUCC_RESULT
-gpuccCompileProgramBytecode_Stub
+/* @summary Begin reading a published program on the calling thread, and retrieve the current bytecode container.
+ * The container remains valid until the matching call to gpuccReleasePublishedProgram, even if it is replaced in the meantime.
+ * Acquires may be nested, including across different published programs. Containers retired while any acquire is held by a thread are not freed until that thread's outermost acquire is released, so keep acquires short - for example, one frame.
+ * This function never blocks, except that the first call on each thread allocates a small per-thread record.
+ * @param program The published program to read.
+ * @return The current bytecode container, or NULL if no container has been published. The container must not be modified.
+ */
+GPUCC_API(struct GPUCC_PROGRAM_BYTECODE*)
+gpuccAcquirePublishedProgram
 (
-    struct GPUCC_PROGRAM_BYTECODE *container, 
-    char const                  *source_code, 
-    uint64_t                     source_size, 
-    char const                  *source_path, 
-    char const                  *entry_point
-)
-{
-    GPUCC_LOADER_UNUSED(container);
-    GPUCC_LOADER_UNUSED(source_code);
-    GPUCC_LOADER_UNUSED(source_size);
-    GPUCC_LOADER_UNUSED(source_path);
-    GPUCC_LOADER_UNUSED(entry_point);
-    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
-}
+    struct GPUCC_PUBLISHED_PROGRAM *program
+);
 
-static struct GPUCC_PROGRAM_COMPILER*
-gpuccQueryBytecodeCompiler_Stub
+/* @summary Finish reading a published program on the calling thread. Each call to gpuccAcquirePublishedProgram must be matched by one call to this function on the same thread.
+ * When the outermost read on the thread ends, replaced containers of the program that no thread can still be reading are freed.
+ * This function never waits on other threads; if another thread is already freeing the program's replaced containers, it returns immediately.
+ * @param program The published program passed to gpuccAcquirePublishedProgram.
+ */
+GPUCC_API(void)
+gpuccReleasePublishedProgram
 (
-    struct GPUCC_PROGRAM_BYTECODE *bytecode
-)
-{
-    GPUCC_LOADER_UNUSED(bytecode);
-    return NULL;
-}
+    struct GPUCC_PUBLISHED_PROGRAM *program
+);
 
-static char const*
-gpuccQueryBytecodeEntryPoint_Stub
+/* @summary Create a tiered compiler, which publishes an unoptimized build of each program as soon as it is available and replaces it with an optimized build later.
+ * Two compilers are created from the configuration: one with GPUCC_COMPILER_FLAG_DISABLE_OPTIMIZATIONS set, and one with it cleared. Any other flags apply to both tiers.
+ * The optimized builds are compiled on the internal worker pool with GPUCC_COMPILE_PRIORITY_BACKGROUND.
+ * @param config Data used to configure both compilers. Data is copied into the compiler storage before the function returns.
+ * @return A pointer to the tiered compiler, which must be freed with gpuccDeleteTieredCompiler, or NULL if an error occurred.
+ */
+GPUCC_API(struct GPUCC_TIERED_COMPILER*)
+gpuccCreateTieredCompiler
 (
-    struct GPUCC_PROGRAM_BYTECODE *bytecode
-)
-{
-    GPUCC_LOADER_UNUSED(bytecode);
-    return "";
-}
+    struct GPUCC_PROGRAM_COMPILER_INIT *config
+);
 
-static char const*
-gpuccQueryBytecodeSourcePath_Stub
+/* @summary Delete a tiered compiler. Optimized builds that have not started are discarded, and the function waits for any that are running to finish.
+ * Published programs may hold containers created by the tiered compiler, so delete them first, after calling gpuccDrainTieredCompiler.
+ * @param tiered The tiered compiler to delete. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccDeleteTieredCompiler
 (
-    struct GPUCC_PROGRAM_BYTECODE *bytecode
-)
-{
-    GPUCC_LOADER_UNUSED(bytecode);
-    return "";
-}
+    struct GPUCC_TIERED_COMPILER *tiered
+);
 
-static struct GPUCC_RESULT
-gpuccQueryBytecodeCompileResult_Stub
+/* @summary Compile a program with optimizations disabled on the calling thread and publish the result, then queue an optimized build of the same source.
+ * When the optimized build completes, it replaces the unoptimized build in the published program, unless another container was published in the meantime, in which case it is discarded.
+ * Failures of the optimized build are discarded, and the unoptimized build remains published.
+ * @param tiered The tiered compiler returned by gpuccCreateTieredCompiler.
+ * @param program The published program that receives both builds.
+ * @param source_code Pointer to a buffer containing UTF-8 encoded GPU program source code. The buffer is copied, and need not outlive the call.
+ * @param source_size The number of bytes of program source code in the source_code buffer.
+ * @param source_path A nul-terminated UTF-8 string specifying the path to the source file, for use in log output. This value may be NULL.
+ * @param entry_point A nul-terminated string specifying the program entry point.
+ * @param o_failed If the unoptimized build fails to compile and this value is non-NULL, on return stores the failed bytecode container so its log can be inspected. The caller must delete the container. Otherwise, set to NULL.
+ * @return The result of the unoptimized build. Nothing is published if the build fails.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccCompileProgramTiered
 (
-    struct GPUCC_PROGRAM_BYTECODE *bytecode
-)
-{
-    GPUCC_LOADER_UNUSED(bytecode);
-    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
-}
+    struct GPUCC_TIERED_COMPILER     *tiered, 
+    struct GPUCC_PUBLISHED_PROGRAM  *program, 
+    char const                  *source_code, 
+    uint64_t                     source_size, 
+    char const                  *source_path, 
+    char const                  *entry_point, 
+    struct GPUCC_PROGRAM_BYTECODE **o_failed
+);
 
-static uint64_t
-gpuccQueryBytecodeSizeBytes_Stub
+/* @summary Discard the optimized builds queued by a tiered compiler that have not started, and wait for any that are running to finish.
+ * Call this function before deleting a published program the tiered compiler has compiled into. The tiered compiler remains usable afterwards.
+ * Queued builds are discarded even if GPUCC_COMPILE_PRIORITY_BACKGROUND is out of budget, so the function never waits for gpuccCompileSchedulerTick.
+ * This function must not be called concurrently with gpuccCompileProgramTiered on the same tiered compiler.
+ * @param tiered The tiered compiler to drain.
+ */
+GPUCC_API(void)
+gpuccDrainTieredCompiler
 (
-    struct GPUCC_PROGRAM_BYTECODE *bytecode
-)
-{
-    GPUCC_LOADER_UNUSED(bytecode);
-    return 0;
-}
+    struct GPUCC_TIERED_COMPILER *tiered
+);
 
-static uint64_t
-gpuccQueryBytecodeLogSizeBytes_Stub
+/* @summary Start compiling GPU program source code into intermediate bytecode on an internal worker thread, in a given priority class.
+ * This function behaves exactly like gpuccCompileProgramBytecodeAsync, which queues jobs with GPUCC_COMPILE_PRIORITY_INTERACTIVE, except for the priority class.
+ * @param container The container that will be used to store the program bytecode.
+ * @param source_code Pointer to a buffer containing UTF-8 encoded GPU program source code.
+ * @param source_size The number of bytes of program source code in the source_code buffer.
+ * @param source_path A nul-terminated UTF-8 string specifying the path to the source file, for use in log output. This value may be NULL.
+ * @param entry_point A nul-terminated string specifying the program entry point.
+ * @param priority One of the values of the GPUCC_COMPILE_PRIORITY enumeration.
+ * @return A handle to the compile job, which must be freed with gpuccDeleteCompileJob, or NULL if the job could not be started. Call gpuccGetLastResult to determine the reason for failure.
+ */
+GPUCC_API(struct GPUCC_COMPILE_JOB*)
+gpuccCompileProgramBytecodeAsyncPriority
 (
-    struct GPUCC_PROGRAM_BYTECODE *bytecode
-)
-{
-    GPUCC_LOADER_UNUSED(bytecode);
-    return 0;
-}
+    struct GPUCC_PROGRAM_BYTECODE *container, 
+    char const                  *source_code, 
+    uint64_t                     source_size, 
+    char const                  *source_path, 
+    char const                  *entry_point, 
+    int32_t                         priority
+);
 
-static uint8_t*
-gpuccQueryBytecodeBuffer_Stub
+/* @summary Configure the scheduler of the internal worker pool. By default there is no budget and the workers run at normal priority.
+ * The new budget takes effect immediately, and the budget of the current tick is reset. Worker threads apply a new thread priority before starting their next job.
+ * On Linux, a worker moved to GPUCC_WORKER_THREAD_PRIORITY_REDUCED or GPUCC_WORKER_THREAD_PRIORITY_IDLE can only return to a higher priority if the process has CAP_SYS_NICE (or a sufficient RLIMIT_NICE). Otherwise the worker keeps its lower priority and reports the failure through the debug output; this function still succeeds.
+ * Jobs in unbudgeted classes also run on the worker threads, so a reduced thread priority delays them too when the application keeps every core busy.
+ * @param config The scheduler configuration.
+ * @return A GPUCC_RESULT specifying whether the configuration was applied.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccConfigureCompileScheduler
 (
-    struct GPUCC_PROGRAM_BYTECODE *bytecode
-)
-{
-    GPUCC_LOADER_UNUSED(bytecode);
-    return NULL;
-}
+    struct GPUCC_COMPILE_SCHEDULER_CONFIG const *config
+);
 
-static char*
-gpuccQueryBytecodeLogBuffer_Stub
+/* @summary Begin a new scheduler tick, refilling the CPU time budget of the budgeted priority classes. Call this function once per frame.
+ * This function never blocks, and does nothing if no budget is configured.
+ */
+GPUCC_API(void)
+gpuccCompileSchedulerTick
 (
-    struct GPUCC_PROGRAM_BYTECODE *bytecode
-)
-{
-    GPUCC_LOADER_UNUSED(bytecode);
-    return NULL;
-}
+    void
+);
 
-/*** LOADER IMPLEMENTATION ***/
-static void
-gpuccLoaderStubDispatch
+/* @summary Retrieve the number of asynchronous jobs of a priority class that are queued and have not yet started.
+ * Items of compile batches and permutation sets are not included, since the calling thread waits for them.
+ * @param priority One of the values of the GPUCC_COMPILE_PRIORITY enumeration.
+ * @return The number of queued jobs, or zero if the priority is invalid.
+ */
+GPUCC_API(uint32_t)
+gpuccQueryCompileQueueDepth
 (
-    struct GPUCC_LOADER_DISPATCH *dispatch
-)
-{
-    dispatch->gpuccVersion                    = gpuccVersion_Stub;
-    dispatch->gpuccFailure                    = gpuccFailure_Stub;
-    dispatch->gpuccSuccess                    = gpuccSuccess_Stub;
-    dispatch->gpuccErrorString                = gpuccErrorString_Stub;
-    dispatch->gpuccBytecodeTypeString         = gpuccBytecodeTypeString_Stub;
-    dispatch->gpuccCompilerTypeString         = gpuccCompilerTypeString_Stub;
-    dispatch->gpuccStartup                    = gpuccStartup_Stub;
-    dispatch->gpuccShutdown                   = gpuccShutdown_Stub;
-    dispatch->gpuccGetLastResult              = gpuccGetLastResult_Stub;
-    dispatch->gpuccCreateCompiler             = gpuccCreateCompiler_Stub;
-    dispatch->gpuccDeleteCompiler             = gpuccDeleteCompiler_Stub;
-    dispatch->gpuccQueryCompilerType          = gpuccQueryCompilerType_Stub;
-    dispatch->gpuccQueryBytecodeType          = gpuccQueryBytecodeType_Stub;
-    dispatch->gpuccCreateBytecodeContainer    = gpuccCreateBytecodeContainer_Stub;
-    dispatch->gpuccDeleteBytecodeContainer    = gpuccDeleteBytecodeContainer_Stub;
-    dispatch->gpuccQueryBytecodeCompiler      = gpuccQueryBytecodeCompiler_Stub;
-    dispatch->gpuccQueryBytecodeEntryPoint    = gpuccQueryBytecodeEntryPoint_Stub;
-    dispatch->gpuccQueryBytecodeSourcePath    = gpuccQueryBytecodeSourcePath_Stub;
-    dispatch->gpuccQueryBytecodeCompileResult = gpuccQueryBytecodeCompileResult_Stub;
-    dispatch->gpuccQueryBytecodeSizeBytes     = gpuccQueryBytecodeSizeBytes_Stub;
-    dispatch->gpuccQueryBytecodeLogSizeBytes  = gpuccQueryBytecodeLogSizeBytes_Stub;
-    dispatch->gpuccQueryBytecodeBuffer        = gpuccQueryBytecodeBuffer_Stub;
-    dispatch->gpuccQueryBytecodeLogBuffer     = gpuccQueryBytecodeLogBuffer_Stub;
-    dispatch->gpuccCompileProgramBytecode     = gpuccCompileProgramBytecode_Stub;
-    dispatch->ModuleHandle_GpuCC              = NULL;
-}
+    int32_t priority
+);
+
+/* @summary Create a cancellation token. A token can be passed to any number of asynchronous compile jobs, and signaling it cancels all of them.
+ * For example, a hot-reload loop can use one token per source file, and signal it when the file changes again so that compiles of the stale source are abandoned.
+ * @return The cancellation token, which must be freed with gpuccDeleteCancelToken, or NULL if memory allocation failed.
+ */
+GPUCC_API(struct GPUCC_CANCEL_TOKEN*)
+gpuccCreateCancelToken
+(
+    void
+);
+
+/* @summary Free a cancellation token. Deleting a token does not signal it.
+ * Jobs hold their own reference to the token, so the token may be deleted while jobs using it are still queued or running.
+ * @param token The cancellation token to delete. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccDeleteCancelToken
+(
+    struct GPUCC_CANCEL_TOKEN *token
+);
+
+/* @summary Cancel every compile job using a cancellation token. A token cannot be reset once signaled.
+ * Queued jobs complete with GPUCC_RESULT_CODE_CANCELLED without starting. Running jobs are abandoned at the next point where the library regains control from the compiler backend.
+ * This function does not block.
+ * @param token The cancellation token to signal.
+ */
+GPUCC_API(void)
+gpuccSignalCancelToken
+(
+    struct GPUCC_CANCEL_TOKEN *token
+);
+
+/* @summary Determine whether a cancellation token has been signaled.
+ * @param token The cancellation token to query.
+ * @return Non-zero if the token has been signaled.
+ */
+GPUCC_API(int32_t)
+gpuccQueryCancelTokenSignaled
+(
+    struct GPUCC_CANCEL_TOKEN *token
+);
+
+/* @summary Start compiling GPU program source code into intermediate bytecode on an internal worker thread, with a cancellation token and a deadline.
+ * This function behaves exactly like gpuccCompileProgramBytecodeAsyncPriority, except that the job completes with GPUCC_RESULT_CODE_CANCELLED if the token is signaled, 
+ * gpuccCancelCompileJob is called or the deadline passes before the job completes. A job that has not started when it is cancelled never starts.
+ * A running job is abandoned before the compiler backend is invoked, when the backend next requests an include file, or when the backend returns.
+ * The library cannot interrupt a backend that does not call back into it, so a job may run past its deadline; its result is then discarded.
+ * If the compiler was created with a worker process pool, the worker running the backend is terminated instead, so the job completes promptly.
+ * The container of a cancelled job holds no usable bytecode, and must be reset before it is reused.
+ * @param container The container that will be used to store the program bytecode.
+ * @param source_code Pointer to a buffer containing UTF-8 encoded GPU program source code.
+ * @param source_size The number of bytes of program source code in the source_code buffer.
+ * @param source_path A nul-terminated UTF-8 string specifying the path to the source file, for use in log output. This value may be NULL.
+ * @param entry_point A nul-terminated string specifying the program entry point.
+ * @param priority One of the values of the GPUCC_COMPILE_PRIORITY enumeration.
+ * @param cancel_token The cancellation token used to cancel the job, or NULL.
+ * @param deadline_ms The time allowed for the job to complete, in milliseconds, measured from the time this function is called. Specify GPUCC_WAIT_INFINITE for no deadline.
+ * @return A handle to the compile job, which must be freed with gpuccDeleteCompileJob, or NULL if the job could not be started. Call gpuccGetLastResult to determine the reason for failure.
+ */
+GPUCC_API(struct GPUCC_COMPILE_JOB*)
+gpuccCompileProgramBytecodeAsyncCancellable
+(
+    struct GPUCC_PROGRAM_BYTECODE *container, 
+    char const                  *source_code, 
+    uint64_t                     source_size, 
+    char const                  *source_path, 
+    char const                  *entry_point, 
+    int32_t                         priority, 
+    struct GPUCC_CANCEL_TOKEN  *cancel_token, 
+    uint32_t                     deadline_ms
+);
+
+/* @summary Cancel a single asynchronous compile job, as if its cancellation token had been signaled. Cancelling a job that has completed has no effect.
+ * This function does not block. Call gpuccWaitCompileJob to wait for the job to complete.
+ * @param job The compile job to cancel.
+ */
+GPUCC_API(void)
+gpuccCancelCompileJob
+(
+    struct GPUCC_COMPILE_JOB *job
+);
+
+/* @summary Create a pool of worker processes that run compiler backends outside of the calling process.
+ * Compilers created with the pool in GPUCC_PROGRAM_COMPILER_INIT::WorkerPool send each compilation to an idle worker. A backend that crashes, hangs or leaks takes down only its worker, which is restarted transparently;
+ * the compilation fails with GPUCC_RESULT_CODE_COMPILE_FAILED, or GPUCC_RESULT_CODE_CANCELLED if the worker was terminated because the compile job was cancelled or its deadline passed.
+ * Source code is passed to the workers, and bytecode returned from them, through shared memory. Include files are resolved in the calling process.
+ * Worker processes are currently supported on Linux only, where they are forked from a zygote process that this call starts by executing the gpucc_worker executable installed next to the GpuCC library.
+ * The zygote does not share the address space of the application, so the pool may be created at any time. A worker that does not respond within GPUCC_WORKER_DEFAULT_REPLY_TIMEOUT_MS is killed.
+ * Call gpuccCreateWorkerProcessPoolEx to use a different host executable or reply timeout.
+ * @param worker_count The number of worker processes. Specify zero to use one worker per hardware thread.
+ * @return The worker process pool, which must be freed with gpuccDeleteWorkerProcessPool, or NULL if the pool could not be created. Call gpuccGetLastResult to determine the reason for failure.
+ */
+GPUCC_API(struct GPUCC_WORKER_PROCESS_POOL*)
+gpuccCreateWorkerProcessPool
+(
+    uint32_t worker_count
+);
+
+/* @summary Terminate the worker processes of a worker process pool and free the pool.
+ * Every compiler created with the pool must be deleted first. Bytecode containers holding results returned by the workers remain valid.
+ * @param pool The worker process pool to delete. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccDeleteWorkerProcessPool
+(
+    struct GPUCC_WORKER_PROCESS_POOL *pool
+);
+
+/* @summary Retrieve the memory usage of the backend objects of a compiler.
+ * Backend memory is tracked only by compiler types that can route backend allocations through GpuCC, currently DXC.
+ * @param compiler The compiler to query.
+ * @param o_stats On return, stores the memory usage. If backend memory is not tracked, all values are zero.
+ * @return Non-zero if the compiler tracks backend memory, or zero if it does not or an argument is invalid.
+ */
+GPUCC_API(int32_t)
+gpuccQueryCompilerBackendMemory
+(
+    struct GPUCC_PROGRAM_COMPILER    *compiler, 
+    struct GPUCC_BACKEND_MEMORY_STATS *o_stats
+);
+
+/* @summary Retrieve the backend memory usage of the most recent compilation into a bytecode container.
+ * The values are zero if the result was taken from the bytecode cache or shared with an identical compilation, or if the backend ran in a worker process.
+ * @param bytecode The bytecode container to query.
+ * @param o_stats On return, stores the memory usage. If backend memory is not tracked, all values are zero.
+ * @return Non-zero if the compiler of the container tracks backend memory, or zero if it does not or an argument is invalid.
+ */
+GPUCC_API(int32_t)
+gpuccQueryBytecodeBackendMemory
+(
+    struct GPUCC_PROGRAM_BYTECODE    *bytecode, 
+    struct GPUCC_BACKEND_MEMORY_STATS *o_stats
+);
+
+/* @summary Retrieve the time spent in each phase of the most recent compilation into a bytecode container.
+ * The timings are cleared when the container is reset.
+ * @param bytecode The bytecode container to query.
+ * @param o_timings On return, stores the phase timings. All values are zero if no compilation has been attempted.
+ * @return Non-zero if the timings were retrieved, or zero if an argument is invalid.
+ */
+GPUCC_API(int32_t)
+gpuccQueryBytecodeTimings
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode, 
+    struct GPUCC_COMPILE_TIMINGS *o_timings
+);
+
+/* @summary Retrieve a snapshot of the process-wide statistics counters.
+ * Counters are updated without locks, so a snapshot taken while compilations complete on other threads may include part of a compilation, for example its count but not yet its time.
+ * @param o_stats On return, stores the current value of each counter.
+ * @return Non-zero if the snapshot was retrieved, or zero if o_stats is NULL.
+ */
+GPUCC_API(int32_t)
+gpuccQueryStatistics
+(
+    struct GPUCC_STATISTICS *o_stats
+);
+
+/* @summary Start recording trace events for compiler creation, compilation, compiler backend loading in gpuccStartup, and time spent waiting in the compile queue or for other compilations.
+ * Each thread records into its own ring buffer. Once a buffer is full, the oldest events are overwritten. Call gpuccWriteTraceFile to write out and discard the recorded events.
+ * This function may be called before gpuccStartup, so that backend loading is traced.
+ * @param events_per_thread The number of events each thread's buffer can hold, or zero to use GPUCC_TRACE_DEFAULT_EVENT_COUNT. The value applies to buffers created after the call; existing buffers keep their size.
+ * @return A GPUCC_RESULT value.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccEnableTracing
+(
+    uint32_t events_per_thread
+);
+
+/* @summary Stop recording trace events. Events already recorded are retained until gpuccWriteTraceFile is called.
+ */
+GPUCC_API(void)
+gpuccDisableTracing
+(
+    void
+);
+
+/* @summary Write the trace events recorded by all threads to a file in the Chrome trace event JSON format, which can be loaded by Perfetto or chrome://tracing, and discard them.
+ * Events are placed on a track for the thread that recorded them. Queue waits are placed on asynchronous tracks, since they overlap the work of the thread that ends them.
+ * Recording may continue on other threads while the file is written. Events recorded during the call may appear in this file or the next.
+ * @param path A nul-terminated UTF-8 string specifying the path of the file to create. An existing file is replaced.
+ * @return A GPUCC_RESULT value.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccWriteTraceFile
+(
+    char const *path
+);
+
+/* @summary Retrieve the compile latency percentiles for each combination of compiler type and target profile that has been compiled with.
+ * Entries are sorted by compiler type, then by target profile. Latencies are recorded without locks, so compilations completing during the call may or may not be included.
+ * @param o_latency An array of max_count entries that on return store the latency distributions. This value may be NULL if max_count is zero.
+ * @param max_count The maximum number of entries to write to o_latency.
+ * @return The total number of distributions available, which may exceed max_count.
+ */
+GPUCC_API(uint32_t)
+gpuccQueryCompileLatency
+(
+    struct GPUCC_COMPILE_LATENCY *o_latency, 
+    uint32_t                      max_count
+);
+
+/* @summary Format the compile latency percentiles as a human-readable table, with one row per compiler type and target profile and times in milliseconds.
+ * @param buffer The buffer that on return stores the nul-terminated report. The report is truncated if the buffer is too small. This value may be NULL if buffer_size is zero.
+ * @param buffer_size The size of the buffer, in bytes.
+ * @return The number of bytes required to store the complete report, including the nul.
+ */
+GPUCC_API(uint64_t)
+gpuccFormatCompileLatencyReport
+(
+    char         *buffer, 
+    uint64_t buffer_size
+);
+
+/* @summary Create a pool of worker processes with a specific configuration. See gpuccCreateWorkerProcessPool.
+ * @param config The pool configuration.
+ * @return The worker process pool, which must be freed with gpuccDeleteWorkerProcessPool, or NULL if the pool could not be created. Call gpuccGetLastResult to determine the reason for failure.
+ */
+GPUCC_API(struct GPUCC_WORKER_PROCESS_POOL*)
+gpuccCreateWorkerProcessPoolEx
+(
+    struct GPUCC_WORKER_PROCESS_POOL_INIT const *config
+);
+
+/* @summary Run the zygote of a worker process pool if the calling process was started as one, and exit without returning. Otherwise, return immediately.
+ * An executable named in GPUCC_WORKER_PROCESS_POOL_INIT::HostPath must call this function at the start of main, before it creates threads or calls gpuccStartup. The zygote calls gpuccStartup itself.
+ * @param argc The argument count passed to main.
+ * @param argv The argument vector passed to main.
+ */
+GPUCC_API(void)
+gpuccRunWorkerProcess
+(
+    int    argc, 
+    char **argv
+);
+
+#endif /* GPUCC_NO_PROTOTYPES */
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_H__ */
+
+#ifdef GPUCC_LOADER_IMPLEMENTATION
+
+/* @summary Define a general signature for a dynamically-loaded function.
+ * Code will have to cast the function pointer to the correct type. The void(void)
+ * signature is used because GCC treats it as compatible with any function type.
+ */
+typedef void (*PFN_GpuCC_Unknown)(void);
+
+/* @summary Helper macro for populating a dispatch table with functions loaded at runtime.
+ * If the function is not found, the entry point is updated to point to a stub implementation provided by the caller.
+ * This macro relies on specific naming conventions:
+ * - The signature must be PFN_BlahBlahBlah where BlahBlahBlah corresponds to the _fn argument.
+ * - The dispatch table field must be BlahBlahBlah where BlahBlahBlah corresponds to the _fn argument.
+ * - The stub function must be named BlahBlahBlah_Stub where BlahBlahBlah corresponds to the _fn argument.
+ * @param _disp A pointer to the dispatch table to populate.
+ * @param _module The GPUCC_RUNTIME_MODULE representing the module loaded into the process address space.
+ * @param _fn The name of the function to dynamically load.
+ */
+#ifndef gpuccResolveRuntimeFunction
+#define gpuccResolveRuntimeFunction(_disp, _module, _fn)                       \
+    for (;;) {                                                                 \
+        (_disp)->_fn=(PFN_##_fn) gpuccRuntimeModuleResolve((_module), #_fn);   \
+        if ((_disp)->_fn == NULL) {                                            \
+            (_disp)->_fn  = _fn##_Stub;                                        \
+        } break;                                                               \
+    }
+#endif
+
+/**
+ * Implement a small shim layer for each platform that the loader can rely on 
+ * for dynamically loading a DLL or shared object library into the process 
+ * address space and resolving entry points.
+ */
+#if   defined(__APPLE__)
+#   if defined(TARGET_OS_IPHONE) || defined(TARGET_OS_IPHONE_SIMULATOR)
+#       error No GpuCC loader implementation for iOS (yet).
+#   else
+#       error No GpuCC loader implementation for macOS (yet).
+#   endif
+#elif defined(_WIN32) || defined(_WIN64)
+/** BEGIN WINDOWS **/
+#   ifndef GPUCC_LOADER_NO_INCLUDES
+#       include <Windows.h>
+#   endif
+
+#   ifndef GPUCC_LOADER_UNUSED
+#       define GPUCC_LOADER_UNUSED(_x) (void)(_x)
+#   endif
+
+    /* @summary Declare the runtime module type. On Windows, this is the type returned by LoadLibraryW.
+     */
+    typedef HMODULE GPUCC_RUNTIME_MODULE;
+
+    /* @summary Resolve a function entry point declared with C linkage.
+     * This function is used by the gpuccResolveRuntimeFunction macro.
+     * @param module The module handle of the DLL.
+     * @param symbol The unmangled symbol name.
+     * @return A pointer to the function loaded into the process address space, or NULL if the entry point is not found.
+     */
+    static PFN_GpuCC_Unknown
+    gpuccRuntimeModuleResolve
+    (
+        GPUCC_RUNTIME_MODULE module, 
+        char const          *symbol
+    )
+    {
+        if (module != NULL) {
+            return (PFN_GpuCC_Unknown) GetProcAddress(module, symbol);
+        } else {
+            return (PFN_GpuCC_Unknown) NULL;
+        }
+    }
+
+    /* @summary Load the GpuCC DLL into the address space of the calling process.
+     * @return The module handle, or NULL if GpuCC.dll could not be loaded.
+     */
+    static GPUCC_RUNTIME_MODULE
+    gpuccRuntimeModuleLoad
+    (
+        void
+    )
+    {
+        return (GPUCC_RUNTIME_MODULE) LoadLibraryW(L"gpucc.dll");
+    }
+
+    /* @summary Unload the GpuCC DLL from the address space of the calling process.
+     */
+    static void
+    gpuccRuntimeModuleUnload
+    (
+        GPUCC_RUNTIME_MODULE module
+    )
+    {
+        if (module != NULL) {
+            FreeLibrary(module);
+        }
+    }
+
+/*** END WINDOWS ***/
+#elif defined(__linux__) || defined(__gnu_linux__)
+/** BEGIN LINUX **/
+#   ifndef GPUCC_LOADER_NO_INCLUDES
+#       include <dlfcn.h>
+#   endif
+
+#   ifndef GPUCC_LOADER_UNUSED
+#       define GPUCC_LOADER_UNUSED(_x) (void)(_x)
+#   endif
+
+    /* @summary Declare the runtime module type. On Linux, this is the handle returned by dlopen.
+     */
+    typedef void* GPUCC_RUNTIME_MODULE;
+
+    /* @summary Resolve a function entry point declared with C linkage.
+     * This function is used by the gpuccResolveRuntimeFunction macro.
+     * @param module The module handle of the shared object.
+     * @param symbol The unmangled symbol name.
+     * @return A pointer to the function loaded into the process address space, or NULL if the entry point is not found.
+     */
+    static PFN_GpuCC_Unknown
+    gpuccRuntimeModuleResolve
+    (
+        GPUCC_RUNTIME_MODULE module, 
+        char const          *symbol
+    )
+    {
+        if (module != NULL) {
+            return (PFN_GpuCC_Unknown) dlsym(module, symbol);
+        } else {
+            return (PFN_GpuCC_Unknown) NULL;
+        }
+    }
+
+    /* @summary Load the GpuCC shared object into the address space of the calling process.
+     * The shared object is located using the standard dynamic linker search path (LD_LIBRARY_PATH, RPATH, etc.)
+     * @return The module handle, or NULL if libgpucc.so could not be loaded.
+     */
+    static GPUCC_RUNTIME_MODULE
+    gpuccRuntimeModuleLoad
+    (
+        void
+    )
+    {
+        return (GPUCC_RUNTIME_MODULE) dlopen("libgpucc.so", RTLD_NOW | RTLD_LOCAL);
+    }
+
+    /* @summary Unload the GpuCC shared object from the address space of the calling process.
+     */
+    static void
+    gpuccRuntimeModuleUnload
+    (
+        GPUCC_RUNTIME_MODULE module
+    )
+    {
+        if (module != NULL) {
+            dlclose(module);
+        }
+    }
+
+/*** END LINUX ***/
+#else
+#   error No GpuCC loader implementation for your platform (yet).
+#endif
+
+/*** FUNCTION POINTER TYPES ***/
+typedef void                           (*PFN_gpuccVersion                   )(int32_t*, int32_t*, int32_t*);
+typedef int32_t                        (*PFN_gpuccFailure                   )(struct GPUCC_RESULT);
+typedef int32_t                        (*PFN_gpuccSuccess                   )(struct GPUCC_RESULT);
+typedef char const*                    (*PFN_gpuccErrorString               )(int32_t);
+typedef char const*                    (*PFN_gpuccBytecodeTypeString        )(int32_t);
+typedef char const*                    (*PFN_gpuccCompilerTypeString        )(int32_t);
+typedef struct GPUCC_RESULT            (*PFN_gpuccStartup                   )(uint32_t gpucc_usage_mode);
+typedef void                           (*PFN_gpuccShutdown                  )(void);
+typedef struct GPUCC_RESULT            (*PFN_gpuccGetLastResult             )(void);
+typedef struct GPUCC_PROGRAM_COMPILER* (*PFN_gpuccCreateCompiler            )(struct GPUCC_PROGRAM_COMPILER_INIT*);
+typedef void                           (*PFN_gpuccDeleteCompiler            )(struct GPUCC_PROGRAM_COMPILER*);
+typedef int32_t                        (*PFN_gpuccQueryCompilerType         )(struct GPUCC_PROGRAM_COMPILER*);
+typedef int32_t                        (*PFN_gpuccQueryBytecodeType         )(struct GPUCC_PROGRAM_COMPILER*);
+typedef struct GPUCC_PROGRAM_BYTECODE* (*PFN_gpuccCreateBytecodeContainer   )(struct GPUCC_PROGRAM_COMPILER*);
+typedef void                           (*PFN_gpuccDeleteBytecodeContainer   )(struct GPUCC_PROGRAM_BYTECODE*);
+typedef struct GPUCC_PROGRAM_COMPILER* (*PFN_gpuccQueryBytecodeCompiler     )(struct GPUCC_PROGRAM_BYTECODE*);
+typedef char const*                    (*PFN_gpuccQueryBytecodeEntryPoint   )(struct GPUCC_PROGRAM_BYTECODE*);
+typedef char const*                    (*PFN_gpuccQueryBytecodeSourcePath   )(struct GPUCC_PROGRAM_BYTECODE*);
+typedef struct GPUCC_RESULT            (*PFN_gpuccQueryBytecodeCompileResult)(struct GPUCC_PROGRAM_BYTECODE*);
+typedef uint64_t                       (*PFN_gpuccQueryBytecodeSizeBytes    )(struct GPUCC_PROGRAM_BYTECODE*);
+typedef uint64_t                       (*PFN_gpuccQueryBytecodeLogSizeBytes )(struct GPUCC_PROGRAM_BYTECODE*);
+typedef uint8_t*                       (*PFN_gpuccQueryBytecodeBuffer       )(struct GPUCC_PROGRAM_BYTECODE*);
+typedef char*                          (*PFN_gpuccQueryBytecodeLogBuffer    )(struct GPUCC_PROGRAM_BYTECODE*);
+typedef struct GPUCC_RESULT            (*PFN_gpuccCompileProgramBytecode    )(struct GPUCC_PROGRAM_BYTECODE*, char const*, uint64_t, char const*, char const*);
+typedef struct GPUCC_RESULT            (*PFN_gpuccEnableBytecodeCache       )(char const*);
+typedef void                           (*PFN_gpuccDisableBytecodeCache      )(void);
+typedef struct GPUCC_COMPILE_JOB*      (*PFN_gpuccCompileProgramBytecodeAsync)(struct GPUCC_PROGRAM_BYTECODE*, char const*, uint64_t, char const*, char const*);
+typedef int32_t                        (*PFN_gpuccPollCompileJob            )(struct GPUCC_COMPILE_JOB*);
+typedef struct GPUCC_RESULT            (*PFN_gpuccWaitCompileJob            )(struct GPUCC_COMPILE_JOB*, uint32_t);
+typedef void                           (*PFN_gpuccDeleteCompileJob          )(struct GPUCC_COMPILE_JOB*);
+typedef struct GPUCC_RESULT            (*PFN_gpuccCompileProgramBatch       )(struct GPUCC_COMPILE_BATCH_ITEM const*, struct GPUCC_RESULT*, uint32_t, struct GPUCC_COMPILE_BATCH_TIMING*);
+typedef void                           (*PFN_gpuccResetBytecodeContainer    )(struct GPUCC_PROGRAM_BYTECODE*);
+typedef struct GPUCC_PERMUTATION_TABLE* (*PFN_gpuccCompilePermutations       )(struct GPUCC_PERMUTATION_SPEC const*, char const*, uint64_t, char const*, char const*);
+typedef void                           (*PFN_gpuccDeletePermutationTable    )(struct GPUCC_PERMUTATION_TABLE*);
+typedef uint32_t                       (*PFN_gpuccQueryPermutationCount     )(struct GPUCC_PERMUTATION_TABLE*);
+typedef uint32_t                       (*PFN_gpuccQueryPermutationBlobCount )(struct GPUCC_PERMUTATION_TABLE*);
+typedef int32_t                        (*PFN_gpuccQueryPermutation          )(struct GPUCC_PERMUTATION_TABLE*, uint32_t, struct GPUCC_PERMUTATION_ENTRY*);
+typedef uint32_t                       (*PFN_gpuccFindPermutation           )(struct GPUCC_PERMUTATION_TABLE*, uint64_t);
+typedef uint8_t const*                 (*PFN_gpuccQueryPermutationBlob      )(struct GPUCC_PERMUTATION_TABLE*, uint32_t, uint64_t*);
+typedef struct GPUCC_INCLUDE_CACHE*    (*PFN_gpuccCreateIncludeCache        )(char const**, uint32_t);
+typedef void                           (*PFN_gpuccDeleteIncludeCache        )(struct GPUCC_INCLUDE_CACHE*);
+typedef void                           (*PFN_gpuccQueryIncludeCacheHandler  )(struct GPUCC_INCLUDE_CACHE*, struct GPUCC_INCLUDE_HANDLER*);
+typedef uint32_t                       (*PFN_gpuccQueryBytecodeDependencyCount)(struct GPUCC_PROGRAM_BYTECODE*);
+typedef char const*                    (*PFN_gpuccQueryBytecodeDependency   )(struct GPUCC_PROGRAM_BYTECODE*, uint32_t);
+typedef struct GPUCC_RESULT            (*PFN_gpuccWriteDependencyFile       )(struct GPUCC_PROGRAM_BYTECODE*, char const*, char const*);
+typedef struct GPUCC_RESULT            (*PFN_gpuccBuildIncremental          )(struct GPUCC_PROGRAM_COMPILER_INIT const*, char const*, struct GPUCC_BUILD_ITEM const*, struct GPUCC_BUILD_ITEM_RESULT*, uint32_t);
+typedef struct GPUCC_RELOAD_SERVICE*   (*PFN_gpuccCreateReloadService       )(struct GPUCC_RELOAD_SERVICE_INIT const*);
+typedef void                           (*PFN_gpuccDeleteReloadService       )(struct GPUCC_RELOAD_SERVICE*);
+typedef struct GPUCC_RESULT            (*PFN_gpuccReloadServiceAddProgram   )(struct GPUCC_RELOAD_SERVICE*, struct GPUCC_PROGRAM_COMPILER*, char const*, char const*, uint32_t*);
+typedef void                           (*PFN_gpuccReloadServiceRemoveProgram)(struct GPUCC_RELOAD_SERVICE*, uint32_t);
+typedef struct GPUCC_PUBLISHED_PROGRAM* (*PFN_gpuccCreatePublishedProgram    )(struct GPUCC_PROGRAM_BYTECODE*);
+typedef void                           (*PFN_gpuccDeletePublishedProgram    )(struct GPUCC_PUBLISHED_PROGRAM*);
+typedef struct GPUCC_RESULT            (*PFN_gpuccPublishProgramBytecode    )(struct GPUCC_PUBLISHED_PROGRAM*, struct GPUCC_PROGRAM_BYTECODE*);
+typedef struct GPUCC_PROGRAM_BYTECODE* (*PFN_gpuccAcquirePublishedProgram   )(struct GPUCC_PUBLISHED_PROGRAM*);
+typedef void                           (*PFN_gpuccReleasePublishedProgram   )(struct GPUCC_PUBLISHED_PROGRAM*);
+typedef struct GPUCC_TIERED_COMPILER*  (*PFN_gpuccCreateTieredCompiler      )(struct GPUCC_PROGRAM_COMPILER_INIT*);
+typedef void                           (*PFN_gpuccDeleteTieredCompiler      )(struct GPUCC_TIERED_COMPILER*);
+typedef struct GPUCC_RESULT            (*PFN_gpuccCompileProgramTiered      )(struct GPUCC_TIERED_COMPILER*, struct GPUCC_PUBLISHED_PROGRAM*, char const*, uint64_t, char const*, char const*, struct GPUCC_PROGRAM_BYTECODE**);
+typedef void                           (*PFN_gpuccDrainTieredCompiler       )(struct GPUCC_TIERED_COMPILER*);
+typedef struct GPUCC_COMPILE_JOB*      (*PFN_gpuccCompileProgramBytecodeAsyncPriority)(struct GPUCC_PROGRAM_BYTECODE*, char const*, uint64_t, char const*, char const*, int32_t);
+typedef struct GPUCC_RESULT            (*PFN_gpuccConfigureCompileScheduler )(struct GPUCC_COMPILE_SCHEDULER_CONFIG const*);
+typedef void                           (*PFN_gpuccCompileSchedulerTick      )(void);
+typedef uint32_t                       (*PFN_gpuccQueryCompileQueueDepth    )(int32_t);
+typedef struct GPUCC_CANCEL_TOKEN*     (*PFN_gpuccCreateCancelToken         )(void);
+typedef void                           (*PFN_gpuccDeleteCancelToken         )(struct GPUCC_CANCEL_TOKEN*);
+typedef void                           (*PFN_gpuccSignalCancelToken         )(struct GPUCC_CANCEL_TOKEN*);
+typedef int32_t                        (*PFN_gpuccQueryCancelTokenSignaled  )(struct GPUCC_CANCEL_TOKEN*);
+typedef struct GPUCC_COMPILE_JOB*      (*PFN_gpuccCompileProgramBytecodeAsyncCancellable)(struct GPUCC_PROGRAM_BYTECODE*, char const*, uint64_t, char const*, char const*, int32_t, struct GPUCC_CANCEL_TOKEN*, uint32_t);
+typedef void                           (*PFN_gpuccCancelCompileJob          )(struct GPUCC_COMPILE_JOB*);
+typedef struct GPUCC_WORKER_PROCESS_POOL* (*PFN_gpuccCreateWorkerProcessPool   )(uint32_t);
+typedef void                           (*PFN_gpuccDeleteWorkerProcessPool   )(struct GPUCC_WORKER_PROCESS_POOL*);
+typedef int32_t                        (*PFN_gpuccQueryCompilerBackendMemory)(struct GPUCC_PROGRAM_COMPILER*, struct GPUCC_BACKEND_MEMORY_STATS*);
+typedef int32_t                        (*PFN_gpuccQueryBytecodeBackendMemory)(struct GPUCC_PROGRAM_BYTECODE*, struct GPUCC_BACKEND_MEMORY_STATS*);
+typedef int32_t                        (*PFN_gpuccQueryBytecodeTimings      )(struct GPUCC_PROGRAM_BYTECODE*, struct GPUCC_COMPILE_TIMINGS*);
+typedef int32_t                        (*PFN_gpuccQueryStatistics           )(struct GPUCC_STATISTICS*);
+typedef struct GPUCC_RESULT            (*PFN_gpuccEnableTracing             )(uint32_t);
+typedef void                           (*PFN_gpuccDisableTracing            )(void);
+typedef struct GPUCC_RESULT            (*PFN_gpuccWriteTraceFile            )(char const*);
+typedef uint32_t                       (*PFN_gpuccQueryCompileLatency       )(struct GPUCC_COMPILE_LATENCY*, uint32_t);
+typedef uint64_t                       (*PFN_gpuccFormatCompileLatencyReport)(char*, uint64_t);
+typedef struct GPUCC_WORKER_PROCESS_POOL* (*PFN_gpuccCreateWorkerProcessPoolEx )(struct GPUCC_WORKER_PROCESS_POOL_INIT const*);
+typedef void                           (*PFN_gpuccRunWorkerProcess          )(int, char**);
+
+/* @summary Define the dispatch table structure used for calling runtime-resolved GpuCC entry points.
+ */
+typedef struct GPUCC_LOADER_DISPATCH {
+    PFN_gpuccVersion                     gpuccVersion;
+    PFN_gpuccFailure                     gpuccFailure;
+    PFN_gpuccSuccess                     gpuccSuccess;
+    PFN_gpuccErrorString                 gpuccErrorString;
+    PFN_gpuccBytecodeTypeString          gpuccBytecodeTypeString;
+    PFN_gpuccCompilerTypeString          gpuccCompilerTypeString;
+    PFN_gpuccStartup                     gpuccStartup;
+    PFN_gpuccShutdown                    gpuccShutdown;
+    PFN_gpuccGetLastResult               gpuccGetLastResult;
+    PFN_gpuccCreateCompiler              gpuccCreateCompiler;
+    PFN_gpuccDeleteCompiler              gpuccDeleteCompiler;
+    PFN_gpuccQueryCompilerType           gpuccQueryCompilerType;
+    PFN_gpuccQueryBytecodeType           gpuccQueryBytecodeType;
+    PFN_gpuccCreateBytecodeContainer     gpuccCreateBytecodeContainer;
+    PFN_gpuccDeleteBytecodeContainer     gpuccDeleteBytecodeContainer;
+    PFN_gpuccQueryBytecodeCompiler       gpuccQueryBytecodeCompiler;
+    PFN_gpuccQueryBytecodeEntryPoint     gpuccQueryBytecodeEntryPoint;
+    PFN_gpuccQueryBytecodeSourcePath     gpuccQueryBytecodeSourcePath;
+    PFN_gpuccQueryBytecodeCompileResult  gpuccQueryBytecodeCompileResult;
+    PFN_gpuccQueryBytecodeSizeBytes      gpuccQueryBytecodeSizeBytes;
+    PFN_gpuccQueryBytecodeLogSizeBytes   gpuccQueryBytecodeLogSizeBytes;
+    PFN_gpuccQueryBytecodeBuffer         gpuccQueryBytecodeBuffer;
+    PFN_gpuccQueryBytecodeLogBuffer      gpuccQueryBytecodeLogBuffer;
+    PFN_gpuccCompileProgramBytecode      gpuccCompileProgramBytecode;
+    PFN_gpuccEnableBytecodeCache         gpuccEnableBytecodeCache;
+    PFN_gpuccDisableBytecodeCache        gpuccDisableBytecodeCache;
+    PFN_gpuccCompileProgramBytecodeAsync gpuccCompileProgramBytecodeAsync;
+    PFN_gpuccPollCompileJob              gpuccPollCompileJob;
+    PFN_gpuccWaitCompileJob              gpuccWaitCompileJob;
+    PFN_gpuccDeleteCompileJob            gpuccDeleteCompileJob;
+    PFN_gpuccCompileProgramBatch         gpuccCompileProgramBatch;
+    PFN_gpuccResetBytecodeContainer      gpuccResetBytecodeContainer;
+    PFN_gpuccCompilePermutations         gpuccCompilePermutations;
+    PFN_gpuccDeletePermutationTable      gpuccDeletePermutationTable;
+    PFN_gpuccQueryPermutationCount       gpuccQueryPermutationCount;
+    PFN_gpuccQueryPermutationBlobCount   gpuccQueryPermutationBlobCount;
+    PFN_gpuccQueryPermutation            gpuccQueryPermutation;
+    PFN_gpuccFindPermutation             gpuccFindPermutation;
+    PFN_gpuccQueryPermutationBlob        gpuccQueryPermutationBlob;
+    PFN_gpuccCreateIncludeCache          gpuccCreateIncludeCache;
+    PFN_gpuccDeleteIncludeCache          gpuccDeleteIncludeCache;
+    PFN_gpuccQueryIncludeCacheHandler    gpuccQueryIncludeCacheHandler;
+    PFN_gpuccQueryBytecodeDependencyCount gpuccQueryBytecodeDependencyCount;
+    PFN_gpuccQueryBytecodeDependency     gpuccQueryBytecodeDependency;
+    PFN_gpuccWriteDependencyFile         gpuccWriteDependencyFile;
+    PFN_gpuccBuildIncremental            gpuccBuildIncremental;
+    PFN_gpuccCreateReloadService         gpuccCreateReloadService;
+    PFN_gpuccDeleteReloadService         gpuccDeleteReloadService;
+    PFN_gpuccReloadServiceAddProgram     gpuccReloadServiceAddProgram;
+    PFN_gpuccReloadServiceRemoveProgram  gpuccReloadServiceRemoveProgram;
+    PFN_gpuccCreatePublishedProgram      gpuccCreatePublishedProgram;
+    PFN_gpuccDeletePublishedProgram      gpuccDeletePublishedProgram;
+    PFN_gpuccPublishProgramBytecode      gpuccPublishProgramBytecode;
+    PFN_gpuccAcquirePublishedProgram     gpuccAcquirePublishedProgram;
+    PFN_gpuccReleasePublishedProgram     gpuccReleasePublishedProgram;
+    PFN_gpuccCreateTieredCompiler        gpuccCreateTieredCompiler;
+    PFN_gpuccDeleteTieredCompiler        gpuccDeleteTieredCompiler;
+    PFN_gpuccCompileProgramTiered        gpuccCompileProgramTiered;
+    PFN_gpuccDrainTieredCompiler         gpuccDrainTieredCompiler;
+    PFN_gpuccCompileProgramBytecodeAsyncPriority gpuccCompileProgramBytecodeAsyncPriority;
+    PFN_gpuccConfigureCompileScheduler   gpuccConfigureCompileScheduler;
+    PFN_gpuccCompileSchedulerTick        gpuccCompileSchedulerTick;
+    PFN_gpuccQueryCompileQueueDepth      gpuccQueryCompileQueueDepth;
+    PFN_gpuccCreateCancelToken           gpuccCreateCancelToken;
+    PFN_gpuccDeleteCancelToken           gpuccDeleteCancelToken;
+    PFN_gpuccSignalCancelToken           gpuccSignalCancelToken;
+    PFN_gpuccQueryCancelTokenSignaled    gpuccQueryCancelTokenSignaled;
+    PFN_gpuccCompileProgramBytecodeAsyncCancellable gpuccCompileProgramBytecodeAsyncCancellable;
+    PFN_gpuccCancelCompileJob            gpuccCancelCompileJob;
+    PFN_gpuccCreateWorkerProcessPool     gpuccCreateWorkerProcessPool;
+    PFN_gpuccDeleteWorkerProcessPool     gpuccDeleteWorkerProcessPool;
+    PFN_gpuccQueryCompilerBackendMemory  gpuccQueryCompilerBackendMemory;
+    PFN_gpuccQueryBytecodeBackendMemory  gpuccQueryBytecodeBackendMemory;
+    PFN_gpuccQueryBytecodeTimings        gpuccQueryBytecodeTimings;
+    PFN_gpuccQueryStatistics             gpuccQueryStatistics;
+    PFN_gpuccEnableTracing               gpuccEnableTracing;
+    PFN_gpuccDisableTracing              gpuccDisableTracing;
+    PFN_gpuccWriteTraceFile              gpuccWriteTraceFile;
+    PFN_gpuccQueryCompileLatency         gpuccQueryCompileLatency;
+    PFN_gpuccFormatCompileLatencyReport  gpuccFormatCompileLatencyReport;
+    PFN_gpuccCreateWorkerProcessPoolEx   gpuccCreateWorkerProcessPoolEx;
+    PFN_gpuccRunWorkerProcess            gpuccRunWorkerProcess;
+    GPUCC_RUNTIME_MODULE                 ModuleHandle_GpuCC;
+} GPUCC_LOADER_DISPATCH;
+
+/*** STUB IMPLEMENTATIONS ***/
+static void
+gpuccVersion_Stub
+(
+    int32_t *o_major, 
+    int32_t *o_minor, 
+    int32_t *o_patch
+)
+{
+    if (o_major) *o_major = 0;
+    if (o_minor) *o_minor = 0;
+    if (o_patch) *o_patch = 0;
+}
+
+static int32_t
+gpuccFailure_Stub
+(
+    struct GPUCC_RESULT r
+)
+{
+    return (r.LibraryResult < 0);
+}
+
+static int32_t
+gpuccSuccess_Stub
+(
+    struct GPUCC_RESULT r
+)
+{
+    return (r.LibraryResult >= 0);
+}
+
+static char const*
+gpuccErrorString_Stub
+(
+    int32_t gpucc_result_code
+)
+{
+    switch (gpucc_result_code) {
+        case GPUCC_RESULT_CODE_SUCCESS                   : return "GPUCC_RESULT_CODE_SUCCESS";
+        case GPUCC_RESULT_CODE_ALREADY_INITIALIZED       : return "GPUCC_RESULT_CODE_ALREADY_INITIALIZED";
+        case GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER  : return "GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER";
+        case GPUCC_RESULT_CODE_NOT_INITIALIZED           : return "GPUCC_RESULT_CODE_NOT_INITIALIZED";
+        case GPUCC_RESULT_CODE_PLATFORM_ERROR            : return "GPUCC_RESULT_CODE_PLATFORM_ERROR";
+        case GPUCC_RESULT_CODE_INVALID_USAGE_MODE        : return "GPUCC_RESULT_CODE_INVALID_USAGE_MODE";
+        case GPUCC_RESULT_CODE_COMPILER_NOT_SUPPORTED    : return "GPUCC_RESULT_CODE_COMPILER_NOT_SUPPORTED";
+        case GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY        : return "GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY";
+        case GPUCC_RESULT_CODE_INVALID_TARGET_PROFILE    : return "GPUCC_RESULT_CODE_INVALID_TARGET_PROFILE";
+        case GPUCC_RESULT_CODE_INVALID_TARGET_RUNTIME    : return "GPUCC_RESULT_CODE_INVALID_TARGET_RUNTIME";
+        case GPUCC_RESULT_CODE_INVALID_BYTECODE_TYPE     : return "GPUCC_RESULT_CODE_INVALID_BYTECODE_TYPE";
+        case GPUCC_RESULT_CODE_INVALID_ARGUMENT          : return "GPUCC_RESULT_CODE_INVALID_ARGUMENT";
+        case GPUCC_RESULT_CODE_CANNOT_LOAD               : return "GPUCC_RESULT_CODE_CANNOT_LOAD";
+        case GPUCC_RESULT_CODE_COMPILE_FAILED            : return "GPUCC_RESULT_CODE_COMPILE_FAILED";
+        case GPUCC_RESULT_CODE_INVALID_BYTECODE_CONTAINER: return "GPUCC_RESULT_CODE_INVALID_BYTECODE_CONTAINER";
+        case GPUCC_RESULT_CODE_TIMEOUT                   : return "GPUCC_RESULT_CODE_TIMEOUT";
+        case GPUCC_RESULT_CODE_CANCELLED                 : return "GPUCC_RESULT_CODE_CANCELLED";
+        default                                          : return "GPUCC_RESULT_CODE (unknown)";
+    }
+}
+
+static char const*
+gpuccBytecodeTypeString_Stub
+(
+    int32_t gpucc_bytecode_type
+)
+{
+    switch (gpucc_bytecode_type) {
+        case GPUCC_BYTECODE_TYPE_UNKNOWN: return "GPUCC_BYTECODE_TYPE_UNKNOWN";
+        case GPUCC_BYTECODE_TYPE_DXIL   : return "GPUCC_BYTECODE_TYPE_DXIL";
+        case GPUCC_BYTECODE_TYPE_DXBC   : return "GPUCC_BYTECODE_TYPE_DXBC";
+        case GPUCC_BYTECODE_TYPE_SPIRV  : return "GPUCC_BYTECODE_TYPE_SPIRV";
+        case GPUCC_BYTECODE_TYPE_PTX    : return "GPUCC_BYTECODE_TYPE_PTX";
+        default                         : return "GPUCC_BYTECODE_TYPE (unknown)";
+    }
+}
+
+static char const*
+gpuccCompilerTypeString_Stub
+(
+    int32_t gpucc_compiler_type
+)
+{
+    switch (gpucc_compiler_type) {
+        case GPUCC_COMPILER_TYPE_UNKNOWN: return "GPUCC_COMPILER_TYPE_UNKNOWN";
+        case GPUCC_COMPILER_TYPE_DXC    : return "GPUCC_COMPILER_TYPE_DXC";
+        case GPUCC_COMPILER_TYPE_FXC    : return "GPUCC_COMPILER_TYPE_FXC";
+        case GPUCC_COMPILER_TYPE_SHADERC: return "GPUCC_COMPILER_TYPE_SHADERC";
+        case GPUCC_COMPILER_TYPE_NVRTC  : return "GPUCC_COMPILER_TYPE_NVRTC";
+        default                         : return "GPUCC_COMPILER_TYPE (unknown)";
+    }
+}
+
+static struct GPUCC_RESULT
+gpuccStartup_Stub
+(
+    uint32_t gpucc_usage_mode
+)
+{
+    GPUCC_LOADER_UNUSED(gpucc_usage_mode);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static void
+gpuccShutdown_Stub
+(
+    void
+)
+{
+    /* empty */
+}
+
+static struct GPUCC_RESULT
+gpuccGetLastResult_Stub
+(
+    void
+)
+{
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static struct GPUCC_PROGRAM_COMPILER*
+gpuccCreateCompiler_Stub
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT *config
+)
+{
+    GPUCC_LOADER_UNUSED(config);
+    return NULL;
+}
+
+static void
+gpuccDeleteCompiler_Stub
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_LOADER_UNUSED(compiler);
+}
+
+static int32_t
+gpuccQueryCompilerType_Stub
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_LOADER_UNUSED(compiler);
+    return GPUCC_COMPILER_TYPE_UNKNOWN;
+}
+
+static int32_t
+gpuccQueryBytecodeType_Stub
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_LOADER_UNUSED(compiler);
+    return GPUCC_BYTECODE_TYPE_UNKNOWN;
+}
+
+static struct GPUCC_PROGRAM_BYTECODE*
+gpuccCreateBytecodeContainer_Stub
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_LOADER_UNUSED(compiler);
+    return NULL;
+}
+
+static void
+gpuccDeleteBytecodeContainer_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+}
+
+static struct GPUCC_RESULT
+gpuccCompileProgramBytecode_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *container, 
+    char const                  *source_code, 
+    uint64_t                     source_size, 
+    char const                  *source_path, 
+    char const                  *entry_point
+)
+{
+    GPUCC_LOADER_UNUSED(container);
+    GPUCC_LOADER_UNUSED(source_code);
+    GPUCC_LOADER_UNUSED(source_size);
+    GPUCC_LOADER_UNUSED(source_path);
+    GPUCC_LOADER_UNUSED(entry_point);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static struct GPUCC_PROGRAM_COMPILER*
+gpuccQueryBytecodeCompiler_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    return NULL;
+}
+
+static char const*
+gpuccQueryBytecodeEntryPoint_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    return "";
+}
+
+static char const*
+gpuccQueryBytecodeSourcePath_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    return "";
+}
+
+static struct GPUCC_RESULT
+gpuccQueryBytecodeCompileResult_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static uint64_t
+gpuccQueryBytecodeSizeBytes_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    return 0;
+}
+
+static uint64_t
+gpuccQueryBytecodeLogSizeBytes_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    return 0;
+}
+
+static uint8_t*
+gpuccQueryBytecodeBuffer_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    return NULL;
+}
+
+static char*
+gpuccQueryBytecodeLogBuffer_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    return NULL;
+}
+
+static struct GPUCC_RESULT
+gpuccEnableBytecodeCache_Stub
+(
+    char const *cache_directory
+)
+{
+    GPUCC_LOADER_UNUSED(cache_directory);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static void
+gpuccDisableBytecodeCache_Stub
+(
+    void
+)
+{
+}
+
+static struct GPUCC_COMPILE_JOB*
+gpuccCompileProgramBytecodeAsync_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *container, 
+    char const                  *source_code, 
+    uint64_t                     source_size, 
+    char const                  *source_path, 
+    char const                  *entry_point
+)
+{
+    GPUCC_LOADER_UNUSED(container);
+    GPUCC_LOADER_UNUSED(source_code);
+    GPUCC_LOADER_UNUSED(source_size);
+    GPUCC_LOADER_UNUSED(source_path);
+    GPUCC_LOADER_UNUSED(entry_point);
+    return NULL;
+}
+
+static int32_t
+gpuccPollCompileJob_Stub
+(
+    struct GPUCC_COMPILE_JOB *job
+)
+{
+    GPUCC_LOADER_UNUSED(job);
+    return 0;
+}
+
+static struct GPUCC_RESULT
+gpuccWaitCompileJob_Stub
+(
+    struct GPUCC_COMPILE_JOB *job, 
+    uint32_t           timeout_ms
+)
+{
+    GPUCC_LOADER_UNUSED(job);
+    GPUCC_LOADER_UNUSED(timeout_ms);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static void
+gpuccDeleteCompileJob_Stub
+(
+    struct GPUCC_COMPILE_JOB *job
+)
+{
+    GPUCC_LOADER_UNUSED(job);
+}
+
+static struct GPUCC_RESULT
+gpuccCompileProgramBatch_Stub
+(
+    struct GPUCC_COMPILE_BATCH_ITEM const *items, 
+    struct GPUCC_RESULT               *o_results, 
+    uint32_t                          item_count, 
+    struct GPUCC_COMPILE_BATCH_TIMING  *o_timing
+)
+{
+    GPUCC_LOADER_UNUSED(items);
+    GPUCC_LOADER_UNUSED(o_results);
+    GPUCC_LOADER_UNUSED(item_count);
+    GPUCC_LOADER_UNUSED(o_timing);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static void
+gpuccResetBytecodeContainer_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+}
+
+static struct GPUCC_PERMUTATION_TABLE*
+gpuccCompilePermutations_Stub
+(
+    struct GPUCC_PERMUTATION_SPEC const *spec, 
+    char const                   *source_code, 
+    uint64_t                      source_size, 
+    char const                   *source_path, 
+    char const                   *entry_point
+)
+{
+    GPUCC_LOADER_UNUSED(spec);
+    GPUCC_LOADER_UNUSED(source_code);
+    GPUCC_LOADER_UNUSED(source_size);
+    GPUCC_LOADER_UNUSED(source_path);
+    GPUCC_LOADER_UNUSED(entry_point);
+    return NULL;
+}
+
+static void
+gpuccDeletePermutationTable_Stub
+(
+    struct GPUCC_PERMUTATION_TABLE *table
+)
+{
+    GPUCC_LOADER_UNUSED(table);
+}
+
+static uint32_t
+gpuccQueryPermutationCount_Stub
+(
+    struct GPUCC_PERMUTATION_TABLE *table
+)
+{
+    GPUCC_LOADER_UNUSED(table);
+    return 0;
+}
+
+static uint32_t
+gpuccQueryPermutationBlobCount_Stub
+(
+    struct GPUCC_PERMUTATION_TABLE *table
+)
+{
+    GPUCC_LOADER_UNUSED(table);
+    return 0;
+}
+
+static int32_t
+gpuccQueryPermutation_Stub
+(
+    struct GPUCC_PERMUTATION_TABLE   *table, 
+    uint32_t                          index, 
+    struct GPUCC_PERMUTATION_ENTRY *o_entry
+)
+{
+    GPUCC_LOADER_UNUSED(table);
+    GPUCC_LOADER_UNUSED(index);
+    GPUCC_LOADER_UNUSED(o_entry);
+    return 0;
+}
+
+static uint32_t
+gpuccFindPermutation_Stub
+(
+    struct GPUCC_PERMUTATION_TABLE *table, 
+    uint64_t                          key
+)
+{
+    GPUCC_LOADER_UNUSED(table);
+    GPUCC_LOADER_UNUSED(key);
+    return GPUCC_PERMUTATION_NOT_FOUND;
+}
+
+static uint8_t const*
+gpuccQueryPermutationBlob_Stub
+(
+    struct GPUCC_PERMUTATION_TABLE *table, 
+    uint32_t                   blob_index, 
+    uint64_t                      *o_size
+)
+{
+    GPUCC_LOADER_UNUSED(table);
+    GPUCC_LOADER_UNUSED(blob_index);
+    GPUCC_LOADER_UNUSED(o_size);
+    return NULL;
+}
+
+static struct GPUCC_INCLUDE_CACHE*
+gpuccCreateIncludeCache_Stub
+(
+    char const  **search_paths, 
+    uint32_t search_path_count
+)
+{
+    GPUCC_LOADER_UNUSED(search_paths);
+    GPUCC_LOADER_UNUSED(search_path_count);
+    return NULL;
+}
+
+static void
+gpuccDeleteIncludeCache_Stub
+(
+    struct GPUCC_INCLUDE_CACHE *cache
+)
+{
+    GPUCC_LOADER_UNUSED(cache);
+}
+
+static void
+gpuccQueryIncludeCacheHandler_Stub
+(
+    struct GPUCC_INCLUDE_CACHE       *cache, 
+    struct GPUCC_INCLUDE_HANDLER *o_handler
+)
+{
+    GPUCC_LOADER_UNUSED(cache);
+    if (o_handler != NULL) {
+        o_handler->Resolve  = NULL;
+        o_handler->Release  = NULL;
+        o_handler->UserData = NULL;
+    }
+}
+
+static uint32_t
+gpuccQueryBytecodeDependencyCount_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    return 0;
+}
+
+static char const*
+gpuccQueryBytecodeDependency_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode, 
+    uint32_t                          index
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    GPUCC_LOADER_UNUSED(index);
+    return NULL;
+}
+
+static struct GPUCC_RESULT
+gpuccWriteDependencyFile_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode, 
+    char const                 *target_path, 
+    char const                *depfile_path
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    GPUCC_LOADER_UNUSED(target_path);
+    GPUCC_LOADER_UNUSED(depfile_path);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static struct GPUCC_RESULT
+gpuccBuildIncremental_Stub
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT const *config, 
+    char const                           *state_path, 
+    struct GPUCC_BUILD_ITEM const             *items, 
+    struct GPUCC_BUILD_ITEM_RESULT        *o_results, 
+    uint32_t                              item_count
+)
+{
+    GPUCC_LOADER_UNUSED(config);
+    GPUCC_LOADER_UNUSED(state_path);
+    GPUCC_LOADER_UNUSED(items);
+    GPUCC_LOADER_UNUSED(o_results);
+    GPUCC_LOADER_UNUSED(item_count);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static struct GPUCC_RELOAD_SERVICE*
+gpuccCreateReloadService_Stub
+(
+    struct GPUCC_RELOAD_SERVICE_INIT const *init
+)
+{
+    GPUCC_LOADER_UNUSED(init);
+    return NULL;
+}
+
+static void
+gpuccDeleteReloadService_Stub
+(
+    struct GPUCC_RELOAD_SERVICE *service
+)
+{
+    GPUCC_LOADER_UNUSED(service);
+}
+
+static struct GPUCC_RESULT
+gpuccReloadServiceAddProgram_Stub
+(
+    struct GPUCC_RELOAD_SERVICE    *service, 
+    struct GPUCC_PROGRAM_COMPILER *compiler, 
+    char const                 *source_path, 
+    char const                 *entry_point, 
+    uint32_t                  *o_program_id
+)
+{
+    GPUCC_LOADER_UNUSED(service);
+    GPUCC_LOADER_UNUSED(compiler);
+    GPUCC_LOADER_UNUSED(source_path);
+    GPUCC_LOADER_UNUSED(entry_point);
+    GPUCC_LOADER_UNUSED(o_program_id);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static void
+gpuccReloadServiceRemoveProgram_Stub
+(
+    struct GPUCC_RELOAD_SERVICE *service, 
+    uint32_t                  program_id
+)
+{
+    GPUCC_LOADER_UNUSED(service);
+    GPUCC_LOADER_UNUSED(program_id);
+}
+
+static struct GPUCC_PUBLISHED_PROGRAM*
+gpuccCreatePublishedProgram_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    return NULL;
+}
+
+static void
+gpuccDeletePublishedProgram_Stub
+(
+    struct GPUCC_PUBLISHED_PROGRAM *program
+)
+{
+    GPUCC_LOADER_UNUSED(program);
+}
+
+static struct GPUCC_RESULT
+gpuccPublishProgramBytecode_Stub
+(
+    struct GPUCC_PUBLISHED_PROGRAM *program, 
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_LOADER_UNUSED(program);
+    GPUCC_LOADER_UNUSED(bytecode);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static struct GPUCC_PROGRAM_BYTECODE*
+gpuccAcquirePublishedProgram_Stub
+(
+    struct GPUCC_PUBLISHED_PROGRAM *program
+)
+{
+    GPUCC_LOADER_UNUSED(program);
+    return NULL;
+}
+
+static void
+gpuccReleasePublishedProgram_Stub
+(
+    struct GPUCC_PUBLISHED_PROGRAM *program
+)
+{
+    GPUCC_LOADER_UNUSED(program);
+}
+
+static struct GPUCC_TIERED_COMPILER*
+gpuccCreateTieredCompiler_Stub
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT *config
+)
+{
+    GPUCC_LOADER_UNUSED(config);
+    return NULL;
+}
+
+static void
+gpuccDeleteTieredCompiler_Stub
+(
+    struct GPUCC_TIERED_COMPILER *tiered
+)
+{
+    GPUCC_LOADER_UNUSED(tiered);
+}
+
+static struct GPUCC_RESULT
+gpuccCompileProgramTiered_Stub
+(
+    struct GPUCC_TIERED_COMPILER     *tiered, 
+    struct GPUCC_PUBLISHED_PROGRAM  *program, 
+    char const                  *source_code, 
+    uint64_t                     source_size, 
+    char const                  *source_path, 
+    char const                  *entry_point, 
+    struct GPUCC_PROGRAM_BYTECODE **o_failed
+)
+{
+    GPUCC_LOADER_UNUSED(tiered);
+    GPUCC_LOADER_UNUSED(program);
+    GPUCC_LOADER_UNUSED(source_code);
+    GPUCC_LOADER_UNUSED(source_size);
+    GPUCC_LOADER_UNUSED(source_path);
+    GPUCC_LOADER_UNUSED(entry_point);
+    GPUCC_LOADER_UNUSED(o_failed);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static void
+gpuccDrainTieredCompiler_Stub
+(
+    struct GPUCC_TIERED_COMPILER *tiered
+)
+{
+    GPUCC_LOADER_UNUSED(tiered);
+}
+
+static struct GPUCC_COMPILE_JOB*
+gpuccCompileProgramBytecodeAsyncPriority_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *container, 
+    char const                  *source_code, 
+    uint64_t                     source_size, 
+    char const                  *source_path, 
+    char const                  *entry_point, 
+    int32_t                         priority
+)
+{
+    GPUCC_LOADER_UNUSED(container);
+    GPUCC_LOADER_UNUSED(source_code);
+    GPUCC_LOADER_UNUSED(source_size);
+    GPUCC_LOADER_UNUSED(source_path);
+    GPUCC_LOADER_UNUSED(entry_point);
+    GPUCC_LOADER_UNUSED(priority);
+    return NULL;
+}
+
+static struct GPUCC_RESULT
+gpuccConfigureCompileScheduler_Stub
+(
+    struct GPUCC_COMPILE_SCHEDULER_CONFIG const *config
+)
+{
+    GPUCC_LOADER_UNUSED(config);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static void
+gpuccCompileSchedulerTick_Stub
+(
+    void
+)
+{
+    /* empty */
+}
+
+static uint32_t
+gpuccQueryCompileQueueDepth_Stub
+(
+    int32_t priority
+)
+{
+    GPUCC_LOADER_UNUSED(priority);
+    return 0;
+}
+
+static struct GPUCC_CANCEL_TOKEN*
+gpuccCreateCancelToken_Stub
+(
+    void
+)
+{
+    return NULL;
+}
+
+static void
+gpuccDeleteCancelToken_Stub
+(
+    struct GPUCC_CANCEL_TOKEN *token
+)
+{
+    GPUCC_LOADER_UNUSED(token);
+}
+
+static void
+gpuccSignalCancelToken_Stub
+(
+    struct GPUCC_CANCEL_TOKEN *token
+)
+{
+    GPUCC_LOADER_UNUSED(token);
+}
+
+static int32_t
+gpuccQueryCancelTokenSignaled_Stub
+(
+    struct GPUCC_CANCEL_TOKEN *token
+)
+{
+    GPUCC_LOADER_UNUSED(token);
+    return 0;
+}
+
+static struct GPUCC_COMPILE_JOB*
+gpuccCompileProgramBytecodeAsyncCancellable_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *container, 
+    char const                  *source_code, 
+    uint64_t                     source_size, 
+    char const                  *source_path, 
+    char const                  *entry_point, 
+    int32_t                         priority, 
+    struct GPUCC_CANCEL_TOKEN  *cancel_token, 
+    uint32_t                     deadline_ms
+)
+{
+    GPUCC_LOADER_UNUSED(container);
+    GPUCC_LOADER_UNUSED(source_code);
+    GPUCC_LOADER_UNUSED(source_size);
+    GPUCC_LOADER_UNUSED(source_path);
+    GPUCC_LOADER_UNUSED(entry_point);
+    GPUCC_LOADER_UNUSED(priority);
+    GPUCC_LOADER_UNUSED(cancel_token);
+    GPUCC_LOADER_UNUSED(deadline_ms);
+    return NULL;
+}
+
+static void
+gpuccCancelCompileJob_Stub
+(
+    struct GPUCC_COMPILE_JOB *job
+)
+{
+    GPUCC_LOADER_UNUSED(job);
+}
+
+static struct GPUCC_WORKER_PROCESS_POOL*
+gpuccCreateWorkerProcessPool_Stub
+(
+    uint32_t worker_count
+)
+{
+    GPUCC_LOADER_UNUSED(worker_count);
+    return NULL;
+}
+
+static void
+gpuccDeleteWorkerProcessPool_Stub
+(
+    struct GPUCC_WORKER_PROCESS_POOL *pool
+)
+{
+    GPUCC_LOADER_UNUSED(pool);
+}
+
+static int32_t
+gpuccQueryCompilerBackendMemory_Stub
+(
+    struct GPUCC_PROGRAM_COMPILER    *compiler, 
+    struct GPUCC_BACKEND_MEMORY_STATS *o_stats
+)
+{
+    GPUCC_LOADER_UNUSED(compiler);
+    GPUCC_LOADER_UNUSED(o_stats);
+    return 0;
+}
+
+static int32_t
+gpuccQueryBytecodeBackendMemory_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE    *bytecode, 
+    struct GPUCC_BACKEND_MEMORY_STATS *o_stats
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    GPUCC_LOADER_UNUSED(o_stats);
+    return 0;
+}
+
+static int32_t
+gpuccQueryBytecodeTimings_Stub
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode, 
+    struct GPUCC_COMPILE_TIMINGS *o_timings
+)
+{
+    GPUCC_LOADER_UNUSED(bytecode);
+    GPUCC_LOADER_UNUSED(o_timings);
+    return 0;
+}
+
+static int32_t
+gpuccQueryStatistics_Stub
+(
+    struct GPUCC_STATISTICS *o_stats
+)
+{
+    GPUCC_LOADER_UNUSED(o_stats);
+    return 0;
+}
+
+static struct GPUCC_RESULT
+gpuccEnableTracing_Stub
+(
+    uint32_t events_per_thread
+)
+{
+    GPUCC_LOADER_UNUSED(events_per_thread);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static void
+gpuccDisableTracing_Stub
+(
+    void
+)
+{
+}
+
+static struct GPUCC_RESULT
+gpuccWriteTraceFile_Stub
+(
+    char const *path
+)
+{
+    GPUCC_LOADER_UNUSED(path);
+    return GPUCC_RESULT{ GPUCC_RESULT_CODE_CANNOT_LOAD, 0 };
+}
+
+static uint32_t
+gpuccQueryCompileLatency_Stub
+(
+    struct GPUCC_COMPILE_LATENCY *o_latency, 
+    uint32_t                      max_count
+)
+{
+    GPUCC_LOADER_UNUSED(o_latency);
+    GPUCC_LOADER_UNUSED(max_count);
+    return 0;
+}
+
+static uint64_t
+gpuccFormatCompileLatencyReport_Stub
+(
+    char         *buffer, 
+    uint64_t buffer_size
+)
+{
+    GPUCC_LOADER_UNUSED(buffer);
+    GPUCC_LOADER_UNUSED(buffer_size);
+    return 0;
+}
+
+static struct GPUCC_WORKER_PROCESS_POOL*
+gpuccCreateWorkerProcessPoolEx_Stub
+(
+    struct GPUCC_WORKER_PROCESS_POOL_INIT const *config
+)
+{
+    GPUCC_LOADER_UNUSED(config);
+    return NULL;
+}
+
+static void
+gpuccRunWorkerProcess_Stub
+(
+    int    argc, 
+    char **argv
+)
+{
+    GPUCC_LOADER_UNUSED(argc);
+    GPUCC_LOADER_UNUSED(argv);
+}
+
+/*** LOADER IMPLEMENTATION ***/
+static void
+gpuccLoaderStubDispatch
+(
+    struct GPUCC_LOADER_DISPATCH *dispatch
+)
+{
+    dispatch->gpuccVersion                    = gpuccVersion_Stub;
+    dispatch->gpuccFailure                    = gpuccFailure_Stub;
+    dispatch->gpuccSuccess                    = gpuccSuccess_Stub;
+    dispatch->gpuccErrorString                = gpuccErrorString_Stub;
+    dispatch->gpuccBytecodeTypeString         = gpuccBytecodeTypeString_Stub;
+    dispatch->gpuccCompilerTypeString         = gpuccCompilerTypeString_Stub;
+    dispatch->gpuccStartup                    = gpuccStartup_Stub;
+    dispatch->gpuccShutdown                   = gpuccShutdown_Stub;
+    dispatch->gpuccGetLastResult              = gpuccGetLastResult_Stub;
+    dispatch->gpuccCreateCompiler             = gpuccCreateCompiler_Stub;
+    dispatch->gpuccDeleteCompiler             = gpuccDeleteCompiler_Stub;
+    dispatch->gpuccQueryCompilerType          = gpuccQueryCompilerType_Stub;
+    dispatch->gpuccQueryBytecodeType          = gpuccQueryBytecodeType_Stub;
+    dispatch->gpuccCreateBytecodeContainer    = gpuccCreateBytecodeContainer_Stub;
+    dispatch->gpuccDeleteBytecodeContainer    = gpuccDeleteBytecodeContainer_Stub;
+    dispatch->gpuccQueryBytecodeCompiler      = gpuccQueryBytecodeCompiler_Stub;
+    dispatch->gpuccQueryBytecodeEntryPoint    = gpuccQueryBytecodeEntryPoint_Stub;
+    dispatch->gpuccQueryBytecodeSourcePath    = gpuccQueryBytecodeSourcePath_Stub;
+    dispatch->gpuccQueryBytecodeCompileResult = gpuccQueryBytecodeCompileResult_Stub;
+    dispatch->gpuccQueryBytecodeSizeBytes     = gpuccQueryBytecodeSizeBytes_Stub;
+    dispatch->gpuccQueryBytecodeLogSizeBytes  = gpuccQueryBytecodeLogSizeBytes_Stub;
+    dispatch->gpuccQueryBytecodeBuffer        = gpuccQueryBytecodeBuffer_Stub;
+    dispatch->gpuccQueryBytecodeLogBuffer     = gpuccQueryBytecodeLogBuffer_Stub;
+    dispatch->gpuccCompileProgramBytecode     = gpuccCompileProgramBytecode_Stub;
+    dispatch->gpuccEnableBytecodeCache        = gpuccEnableBytecodeCache_Stub;
+    dispatch->gpuccDisableBytecodeCache       = gpuccDisableBytecodeCache_Stub;
+    dispatch->gpuccCompileProgramBytecodeAsync = gpuccCompileProgramBytecodeAsync_Stub;
+    dispatch->gpuccPollCompileJob             = gpuccPollCompileJob_Stub;
+    dispatch->gpuccWaitCompileJob             = gpuccWaitCompileJob_Stub;
+    dispatch->gpuccDeleteCompileJob           = gpuccDeleteCompileJob_Stub;
+    dispatch->gpuccCompileProgramBatch        = gpuccCompileProgramBatch_Stub;
+    dispatch->gpuccResetBytecodeContainer     = gpuccResetBytecodeContainer_Stub;
+    dispatch->gpuccCompilePermutations        = gpuccCompilePermutations_Stub;
+    dispatch->gpuccDeletePermutationTable     = gpuccDeletePermutationTable_Stub;
+    dispatch->gpuccQueryPermutationCount      = gpuccQueryPermutationCount_Stub;
+    dispatch->gpuccQueryPermutationBlobCount  = gpuccQueryPermutationBlobCount_Stub;
+    dispatch->gpuccQueryPermutation           = gpuccQueryPermutation_Stub;
+    dispatch->gpuccFindPermutation            = gpuccFindPermutation_Stub;
+    dispatch->gpuccQueryPermutationBlob       = gpuccQueryPermutationBlob_Stub;
+    dispatch->gpuccCreateIncludeCache         = gpuccCreateIncludeCache_Stub;
+    dispatch->gpuccDeleteIncludeCache         = gpuccDeleteIncludeCache_Stub;
+    dispatch->gpuccQueryIncludeCacheHandler   = gpuccQueryIncludeCacheHandler_Stub;
+    dispatch->gpuccQueryBytecodeDependencyCount = gpuccQueryBytecodeDependencyCount_Stub;
+    dispatch->gpuccQueryBytecodeDependency    = gpuccQueryBytecodeDependency_Stub;
+    dispatch->gpuccWriteDependencyFile        = gpuccWriteDependencyFile_Stub;
+    dispatch->gpuccBuildIncremental           = gpuccBuildIncremental_Stub;
+    dispatch->gpuccCreateReloadService        = gpuccCreateReloadService_Stub;
+    dispatch->gpuccDeleteReloadService        = gpuccDeleteReloadService_Stub;
+    dispatch->gpuccReloadServiceAddProgram    = gpuccReloadServiceAddProgram_Stub;
+    dispatch->gpuccReloadServiceRemoveProgram = gpuccReloadServiceRemoveProgram_Stub;
+    dispatch->gpuccCreatePublishedProgram     = gpuccCreatePublishedProgram_Stub;
+    dispatch->gpuccDeletePublishedProgram     = gpuccDeletePublishedProgram_Stub;
+    dispatch->gpuccPublishProgramBytecode     = gpuccPublishProgramBytecode_Stub;
+    dispatch->gpuccAcquirePublishedProgram    = gpuccAcquirePublishedProgram_Stub;
+    dispatch->gpuccReleasePublishedProgram    = gpuccReleasePublishedProgram_Stub;
+    dispatch->gpuccCreateTieredCompiler       = gpuccCreateTieredCompiler_Stub;
+    dispatch->gpuccDeleteTieredCompiler       = gpuccDeleteTieredCompiler_Stub;
+    dispatch->gpuccCompileProgramTiered       = gpuccCompileProgramTiered_Stub;
+    dispatch->gpuccDrainTieredCompiler        = gpuccDrainTieredCompiler_Stub;
+    dispatch->gpuccCompileProgramBytecodeAsyncPriority = gpuccCompileProgramBytecodeAsyncPriority_Stub;
+    dispatch->gpuccConfigureCompileScheduler  = gpuccConfigureCompileScheduler_Stub;
+    dispatch->gpuccCompileSchedulerTick       = gpuccCompileSchedulerTick_Stub;
+    dispatch->gpuccQueryCompileQueueDepth     = gpuccQueryCompileQueueDepth_Stub;
+    dispatch->gpuccCreateCancelToken          = gpuccCreateCancelToken_Stub;
+    dispatch->gpuccDeleteCancelToken          = gpuccDeleteCancelToken_Stub;
+    dispatch->gpuccSignalCancelToken          = gpuccSignalCancelToken_Stub;
+    dispatch->gpuccQueryCancelTokenSignaled   = gpuccQueryCancelTokenSignaled_Stub;
+    dispatch->gpuccCompileProgramBytecodeAsyncCancellable = gpuccCompileProgramBytecodeAsyncCancellable_Stub;
+    dispatch->gpuccCancelCompileJob           = gpuccCancelCompileJob_Stub;
+    dispatch->gpuccCreateWorkerProcessPool    = gpuccCreateWorkerProcessPool_Stub;
+    dispatch->gpuccDeleteWorkerProcessPool    = gpuccDeleteWorkerProcessPool_Stub;
+    dispatch->gpuccQueryCompilerBackendMemory = gpuccQueryCompilerBackendMemory_Stub;
+    dispatch->gpuccQueryBytecodeBackendMemory = gpuccQueryBytecodeBackendMemory_Stub;
+    dispatch->gpuccQueryBytecodeTimings       = gpuccQueryBytecodeTimings_Stub;
+    dispatch->gpuccQueryStatistics            = gpuccQueryStatistics_Stub;
+    dispatch->gpuccEnableTracing              = gpuccEnableTracing_Stub;
+    dispatch->gpuccDisableTracing             = gpuccDisableTracing_Stub;
+    dispatch->gpuccWriteTraceFile             = gpuccWriteTraceFile_Stub;
+    dispatch->gpuccQueryCompileLatency        = gpuccQueryCompileLatency_Stub;
+    dispatch->gpuccFormatCompileLatencyReport = gpuccFormatCompileLatencyReport_Stub;
+    dispatch->gpuccCreateWorkerProcessPoolEx  = gpuccCreateWorkerProcessPoolEx_Stub;
+    dispatch->gpuccRunWorkerProcess           = gpuccRunWorkerProcess_Stub;
+    dispatch->ModuleHandle_GpuCC              = NULL;
+}
+
+static int32_t
+gpuccLoaderPopulateDispatchFrom
+(
+    struct GPUCC_LOADER_DISPATCH *dispatch, 
+    GPUCC_RUNTIME_MODULE            module
+)
+{
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccVersion);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccFailure);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccSuccess);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccErrorString);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccBytecodeTypeString);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCompilerTypeString);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccStartup);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccShutdown);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccGetLastResult);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCreateCompiler);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDeleteCompiler);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryCompilerType);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeType);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCreateBytecodeContainer);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDeleteBytecodeContainer);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeCompiler);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeEntryPoint);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeSourcePath);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeCompileResult);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeSizeBytes);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeLogSizeBytes);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeBuffer);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeLogBuffer);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCompileProgramBytecode);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccEnableBytecodeCache);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDisableBytecodeCache);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCompileProgramBytecodeAsync);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccPollCompileJob);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccWaitCompileJob);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDeleteCompileJob);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCompileProgramBatch);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccResetBytecodeContainer);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCompilePermutations);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDeletePermutationTable);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryPermutationCount);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryPermutationBlobCount);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryPermutation);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccFindPermutation);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryPermutationBlob);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCreateIncludeCache);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDeleteIncludeCache);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryIncludeCacheHandler);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeDependencyCount);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeDependency);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccWriteDependencyFile);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccBuildIncremental);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCreateReloadService);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDeleteReloadService);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccReloadServiceAddProgram);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccReloadServiceRemoveProgram);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCreatePublishedProgram);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDeletePublishedProgram);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccPublishProgramBytecode);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccAcquirePublishedProgram);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccReleasePublishedProgram);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCreateTieredCompiler);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDeleteTieredCompiler);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCompileProgramTiered);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDrainTieredCompiler);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCompileProgramBytecodeAsyncPriority);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccConfigureCompileScheduler);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCompileSchedulerTick);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryCompileQueueDepth);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCreateCancelToken);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDeleteCancelToken);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccSignalCancelToken);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryCancelTokenSignaled);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCompileProgramBytecodeAsyncCancellable);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCancelCompileJob);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCreateWorkerProcessPool);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDeleteWorkerProcessPool);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryCompilerBackendMemory);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeBackendMemory);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeTimings);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryStatistics);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccEnableTracing);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccDisableTracing);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccWriteTraceFile);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryCompileLatency);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccFormatCompileLatencyReport);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccCreateWorkerProcessPoolEx);
+    gpuccResolveRuntimeFunction(dispatch, module, gpuccRunWorkerProcess);
+    dispatch->ModuleHandle_GpuCC        = module;
+    return module != NULL;
+}
+
+static int32_t
+gpuccLoaderPopulateDispatch
+(
+    struct GPUCC_LOADER_DISPATCH *dispatch
+)
+{
+    GPUCC_RUNTIME_MODULE module = gpuccRuntimeModuleLoad();
+    return gpuccLoaderPopulateDispatchFrom(dispatch, module);
+}
+
+static void
+gpuccLoaderInvalidateDispatch
+(
+    struct GPUCC_LOADER_DISPATCH *dispatch
+)
+{
+    GPUCC_RUNTIME_MODULE module = dispatch->ModuleHandle_GpuCC;
+    gpuccLoaderStubDispatch(dispatch);
+    gpuccRuntimeModuleUnload(module);
+}
+
+#ifdef GPUCC_LOCAL_RUNTIME_IMPLEMENTATION
+
+    GPUCC_LOADER_DISPATCH g_gpuccDispatch = {};
+
+    GPUCC_API(struct GPUCC_RESULT)
+    gpuccLocalRuntimeStartup
+    (
+        uint32_t gpucc_usage_mode
+    )
+    {
+        gpuccLoaderPopulateDispatch(&g_gpuccDispatch);
+        return g_gpuccDispatch.gpuccStartup(gpucc_usage_mode);
+    }
+
+    GPUCC_API(void)
+    gpuccLocalRuntimeShutdown
+    (
+        void
+    )
+    {
+        g_gpuccDispatch.gpuccShutdown();
+        gpuccLoaderInvalidateDispatch(&g_gpuccDispatch);
+    }
+
+    GPUCC_API(void)
+    gpuccVersion
+    (
+        int32_t *o_major, 
+        int32_t *o_minor, 
+        int32_t *o_patch
+    )
+    {
+        g_gpuccDispatch.gpuccVersion(o_major, o_minor, o_patch);
+    }
+
+    GPUCC_API(int32_t)
+    gpuccFailure
+    (
+        struct GPUCC_RESULT r
+    )
+    {
+        return g_gpuccDispatch.gpuccFailure(r);
+    }
+
+    GPUCC_API(int32_t)
+    gpuccSuccess
+    (
+        struct GPUCC_RESULT r
+    )
+    {
+        return g_gpuccDispatch.gpuccSuccess(r);
+    }
+
+    GPUCC_API(char const*)
+    gpuccErrorString
+    (
+        int32_t gpucc_result_code
+    )
+    {
+        return g_gpuccDispatch.gpuccErrorString(gpucc_result_code);
+    }
+
+    GPUCC_API(char const*)
+    gpuccBytecodeTypeString
+    (
+        int32_t gpucc_bytecode_type
+    )
+    {
+        return g_gpuccDispatch.gpuccBytecodeTypeString(gpucc_bytecode_type);
+    }
+
+    GPUCC_API(char const*)
+    gpuccCompilerTypeString
+    (
+        int32_t gpucc_compiler_type
+    )
+    {
+        return g_gpuccDispatch.gpuccCompilerTypeString(gpucc_compiler_type);
+    }
+
+    GPUCC_API(struct GPUCC_RESULT)
+    gpuccStartup
+    (
+        uint32_t gpucc_usage_mode
+    )
+    {
+        return g_gpuccDispatch.gpuccStartup(gpucc_usage_mode);
+    }
+
+    GPUCC_API(void)
+    gpuccShutdown
+    (
+        void
+    )
+    {
+        g_gpuccDispatch.gpuccShutdown();
+    }
+
+    GPUCC_API(struct GPUCC_RESULT)
+    gpuccGetLastResult
+    (
+        void
+    )
+    {
+        return g_gpuccDispatch.gpuccGetLastResult();
+    }
+
+    GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
+    gpuccCreateCompiler
+    (
+        struct GPUCC_PROGRAM_COMPILER_INIT *config
+    )
+    {
+        return g_gpuccDispatch.gpuccCreateCompiler(config);
+    }
+
+    GPUCC_API(void)
+    gpuccDeleteCompiler 
+    (
+        struct GPUCC_PROGRAM_COMPILER *compiler
+    )
+    {
+        g_gpuccDispatch.gpuccDeleteCompiler(compiler);
+    }
+
+    GPUCC_API(int32_t)
+    gpuccQueryCompilerType
+    (
+        struct GPUCC_PROGRAM_COMPILER *compiler
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryCompilerType(compiler);
+    }
+
+    GPUCC_API(int32_t)
+    gpuccQueryBytecodeType
+    (
+        struct GPUCC_PROGRAM_COMPILER *compiler
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryBytecodeType(compiler);
+    }
+
+    GPUCC_API(struct GPUCC_PROGRAM_BYTECODE*)
+    gpuccCreateBytecodeContainer
+    (
+        struct GPUCC_PROGRAM_COMPILER *compiler
+    )
+    {
+        return g_gpuccDispatch.gpuccCreateBytecodeContainer(compiler);
+    }
+
+    GPUCC_API(void)
+    gpuccDeleteBytecodeContainer
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
+    )
+    {
+        g_gpuccDispatch.gpuccDeleteBytecodeContainer(bytecode);
+    }
+
+    GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
+    gpuccQueryBytecodeCompiler
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryBytecodeCompiler(bytecode);
+    }
+
+    GPUCC_API(char const*)
+    gpuccQueryBytecodeEntryPoint
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryBytecodeEntryPoint(bytecode);
+    }
+
+    GPUCC_API(char const*)
+    gpuccQueryBytecodeSourcePath
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryBytecodeSourcePath(bytecode);
+    }
+
+    GPUCC_API(struct GPUCC_RESULT)
+    gpuccQueryBytecodeCompileResult
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryBytecodeCompileResult(bytecode);
+    }
+
+    GPUCC_API(uint64_t)
+    gpuccQueryBytecodeSizeBytes
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryBytecodeSizeBytes(bytecode);
+    }
+
+    GPUCC_API(uint64_t)
+    gpuccQueryBytecodeLogSizeBytes
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryBytecodeLogSizeBytes(bytecode);
+    }
+
+    GPUCC_API(uint8_t*)
+    gpuccQueryBytecodeBuffer
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryBytecodeBuffer(bytecode);
+    }
+
+    GPUCC_API(char*)
+    gpuccQueryBytecodeLogBuffer
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryBytecodeLogBuffer(bytecode);
+    }
+
+    GPUCC_API(struct GPUCC_RESULT)
+    gpuccCompileProgramBytecode
+    (
+        struct GPUCC_PROGRAM_BYTECODE *container, 
+        char const                  *source_code, 
+        uint64_t                     source_size, 
+        char const                  *source_path, 
+        char const                  *entry_point
+    )
+    {
+        return g_gpuccDispatch.gpuccCompileProgramBytecode(container, source_code, source_size, source_path, entry_point);
+    }
+
+    GPUCC_API(struct GPUCC_RESULT)
+    gpuccEnableBytecodeCache
+    (
+        char const *cache_directory
+    )
+    {
+        return g_gpuccDispatch.gpuccEnableBytecodeCache(cache_directory);
+    }
+
+    GPUCC_API(void)
+    gpuccDisableBytecodeCache
+    (
+        void
+    )
+    {
+        g_gpuccDispatch.gpuccDisableBytecodeCache();
+    }
+
+    GPUCC_API(struct GPUCC_COMPILE_JOB*)
+    gpuccCompileProgramBytecodeAsync
+    (
+        struct GPUCC_PROGRAM_BYTECODE *container, 
+        char const                  *source_code, 
+        uint64_t                     source_size, 
+        char const                  *source_path, 
+        char const                  *entry_point
+    )
+    {
+        return g_gpuccDispatch.gpuccCompileProgramBytecodeAsync(container, source_code, source_size, source_path, entry_point);
+    }
+
+    GPUCC_API(int32_t)
+    gpuccPollCompileJob
+    (
+        struct GPUCC_COMPILE_JOB *job
+    )
+    {
+        return g_gpuccDispatch.gpuccPollCompileJob(job);
+    }
+
+    GPUCC_API(struct GPUCC_RESULT)
+    gpuccWaitCompileJob
+    (
+        struct GPUCC_COMPILE_JOB *job, 
+        uint32_t           timeout_ms
+    )
+    {
+        return g_gpuccDispatch.gpuccWaitCompileJob(job, timeout_ms);
+    }
+
+    GPUCC_API(void)
+    gpuccDeleteCompileJob
+    (
+        struct GPUCC_COMPILE_JOB *job
+    )
+    {
+        g_gpuccDispatch.gpuccDeleteCompileJob(job);
+    }
+
+    GPUCC_API(struct GPUCC_RESULT)
+    gpuccCompileProgramBatch
+    (
+        struct GPUCC_COMPILE_BATCH_ITEM const *items, 
+        struct GPUCC_RESULT               *o_results, 
+        uint32_t                          item_count, 
+        struct GPUCC_COMPILE_BATCH_TIMING  *o_timing
+    )
+    {
+        return g_gpuccDispatch.gpuccCompileProgramBatch(items, o_results, item_count, o_timing);
+    }
+
+    GPUCC_API(void)
+    gpuccResetBytecodeContainer
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
+    )
+    {
+        g_gpuccDispatch.gpuccResetBytecodeContainer(bytecode);
+    }
+
+    GPUCC_API(struct GPUCC_PERMUTATION_TABLE*)
+    gpuccCompilePermutations
+    (
+        struct GPUCC_PERMUTATION_SPEC const *spec, 
+        char const                   *source_code, 
+        uint64_t                      source_size, 
+        char const                   *source_path, 
+        char const                   *entry_point
+    )
+    {
+        return g_gpuccDispatch.gpuccCompilePermutations(spec, source_code, source_size, source_path, entry_point);
+    }
+
+    GPUCC_API(void)
+    gpuccDeletePermutationTable
+    (
+        struct GPUCC_PERMUTATION_TABLE *table
+    )
+    {
+        g_gpuccDispatch.gpuccDeletePermutationTable(table);
+    }
+
+    GPUCC_API(uint32_t)
+    gpuccQueryPermutationCount
+    (
+        struct GPUCC_PERMUTATION_TABLE *table
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryPermutationCount(table);
+    }
+
+    GPUCC_API(uint32_t)
+    gpuccQueryPermutationBlobCount
+    (
+        struct GPUCC_PERMUTATION_TABLE *table
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryPermutationBlobCount(table);
+    }
+
+    GPUCC_API(int32_t)
+    gpuccQueryPermutation
+    (
+        struct GPUCC_PERMUTATION_TABLE   *table, 
+        uint32_t                          index, 
+        struct GPUCC_PERMUTATION_ENTRY *o_entry
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryPermutation(table, index, o_entry);
+    }
+
+    GPUCC_API(uint32_t)
+    gpuccFindPermutation
+    (
+        struct GPUCC_PERMUTATION_TABLE *table, 
+        uint64_t                          key
+    )
+    {
+        return g_gpuccDispatch.gpuccFindPermutation(table, key);
+    }
+
+    GPUCC_API(uint8_t const*)
+    gpuccQueryPermutationBlob
+    (
+        struct GPUCC_PERMUTATION_TABLE *table, 
+        uint32_t                   blob_index, 
+        uint64_t                      *o_size
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryPermutationBlob(table, blob_index, o_size);
+    }
+
+    GPUCC_API(struct GPUCC_INCLUDE_CACHE*)
+    gpuccCreateIncludeCache
+    (
+        char const  **search_paths, 
+        uint32_t search_path_count
+    )
+    {
+        return g_gpuccDispatch.gpuccCreateIncludeCache(search_paths, search_path_count);
+    }
+
+    GPUCC_API(void)
+    gpuccDeleteIncludeCache
+    (
+        struct GPUCC_INCLUDE_CACHE *cache
+    )
+    {
+        g_gpuccDispatch.gpuccDeleteIncludeCache(cache);
+    }
+
+    GPUCC_API(void)
+    gpuccQueryIncludeCacheHandler
+    (
+        struct GPUCC_INCLUDE_CACHE       *cache, 
+        struct GPUCC_INCLUDE_HANDLER *o_handler
+    )
+    {
+        g_gpuccDispatch.gpuccQueryIncludeCacheHandler(cache, o_handler);
+    }
+
+    GPUCC_API(uint32_t)
+    gpuccQueryBytecodeDependencyCount
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryBytecodeDependencyCount(bytecode);
+    }
 
-static int32_t
-gpuccLoaderPopulateDispatchFrom
-(
-    struct GPUCC_LOADER_DISPATCH *dispatch, 
-    GPUCC_RUNTIME_MODULE            module
-)
-{
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccVersion);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccFailure);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccSuccess);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccErrorString);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccBytecodeTypeString);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccCompilerTypeString);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccStartup);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccShutdown);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccGetLastResult);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccCreateCompiler);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccDeleteCompiler);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryCompilerType);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeType);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccCreateBytecodeContainer);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccDeleteBytecodeContainer);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeCompiler);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeEntryPoint);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeSourcePath);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeCompileResult);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeSizeBytes);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeLogSizeBytes);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeBuffer);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccQueryBytecodeLogBuffer);
-    gpuccResolveRuntimeFunction(dispatch, module, gpuccCompileProgramBytecode);
-    dispatch->ModuleHandle_GpuCC        = module;
-    return module != NULL;
-}
+    GPUCC_API(char const*)
+    gpuccQueryBytecodeDependency
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode, 
+        uint32_t                          index
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryBytecodeDependency(bytecode, index);
+    }
 
-static int32_t
-gpuccLoaderPopulateDispatch
-(
-    struct GPUCC_LOADER_DISPATCH *dispatch
-)
-{
-    GPUCC_RUNTIME_MODULE module = gpuccRuntimeModuleLoad();
-    return gpuccLoaderPopulateDispatchFrom(dispatch, module);
-}
+    GPUCC_API(struct GPUCC_RESULT)
+    gpuccWriteDependencyFile
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode, 
+        char const                 *target_path, 
+        char const                *depfile_path
+    )
+    {
+        return g_gpuccDispatch.gpuccWriteDependencyFile(bytecode, target_path, depfile_path);
+    }
 
-static void
-gpuccLoaderInvalidateDispatch
-(
-    struct GPUCC_LOADER_DISPATCH *dispatch
-)
-{
-    GPUCC_RUNTIME_MODULE module = dispatch->ModuleHandle_GpuCC;
-    gpuccLoaderStubDispatch(dispatch);
-    gpuccRuntimeModuleUnload(module);
-}
+    GPUCC_API(struct GPUCC_RESULT)
+    gpuccBuildIncremental
+    (
+        struct GPUCC_PROGRAM_COMPILER_INIT const *config, 
+        char const                           *state_path, 
+        struct GPUCC_BUILD_ITEM const             *items, 
+        struct GPUCC_BUILD_ITEM_RESULT        *o_results, 
+        uint32_t                              item_count
+    )
+    {
+        return g_gpuccDispatch.gpuccBuildIncremental(config, state_path, items, o_results, item_count);
+    }
 
-#ifdef GPUCC_LOCAL_RUNTIME_IMPLEMENTATION
+    GPUCC_API(struct GPUCC_RELOAD_SERVICE*)
+    gpuccCreateReloadService
+    (
+        struct GPUCC_RELOAD_SERVICE_INIT const *init
+    )
+    {
+        return g_gpuccDispatch.gpuccCreateReloadService(init);
+    }
 
-    GPUCC_LOADER_DISPATCH g_gpuccDispatch = {};
+    GPUCC_API(void)
+    gpuccDeleteReloadService
+    (
+        struct GPUCC_RELOAD_SERVICE *service
+    )
+    {
+        g_gpuccDispatch.gpuccDeleteReloadService(service);
+    }
 
     GPUCC_API(struct GPUCC_RESULT)
-    gpuccLocalRuntimeStartup
+    gpuccReloadServiceAddProgram
     (
-        uint32_t gpucc_usage_mode
+        struct GPUCC_RELOAD_SERVICE    *service, 
+        struct GPUCC_PROGRAM_COMPILER *compiler, 
+        char const                 *source_path, 
+        char const                 *entry_point, 
+        uint32_t                  *o_program_id
     )
     {
-        gpuccLoaderPopulateDispatch(&g_gpuccDispatch);
-        return g_gpuccDispatch.gpuccStartup(gpucc_usage_mode);
+        return g_gpuccDispatch.gpuccReloadServiceAddProgram(service, compiler, source_path, entry_point, o_program_id);
     }
 
     GPUCC_API(void)
-    gpuccLocalRuntimeShutdown
+    gpuccReloadServiceRemoveProgram
     (
-        void
+        struct GPUCC_RELOAD_SERVICE *service, 
+        uint32_t                  program_id
     )
     {
-        g_gpuccDispatch.gpuccShutdown();
-        gpuccLoaderInvalidateDispatch(&g_gpuccDispatch);
+        g_gpuccDispatch.gpuccReloadServiceRemoveProgram(service, program_id);
+    }
+
+    GPUCC_API(struct GPUCC_PUBLISHED_PROGRAM*)
+    gpuccCreatePublishedProgram
+    (
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
+    )
+    {
+        return g_gpuccDispatch.gpuccCreatePublishedProgram(bytecode);
     }
 
     GPUCC_API(void)
-    gpuccVersion
+    gpuccDeletePublishedProgram
     (
-        int32_t *o_major, 
-        int32_t *o_minor, 
-        int32_t *o_patch
+        struct GPUCC_PUBLISHED_PROGRAM *program
     )
     {
-        g_gpuccDispatch.gpuccVersion(o_major, o_minor, o_patch);
+        g_gpuccDispatch.gpuccDeletePublishedProgram(program);
     }
 
-    GPUCC_API(int32_t)
-    gpuccFailure
+    GPUCC_API(struct GPUCC_RESULT)
+    gpuccPublishProgramBytecode
     (
-        struct GPUCC_RESULT r
+        struct GPUCC_PUBLISHED_PROGRAM *program, 
+        struct GPUCC_PROGRAM_BYTECODE *bytecode
     )
     {
-        return g_gpuccDispatch.gpuccFailure(r);
+        return g_gpuccDispatch.gpuccPublishProgramBytecode(program, bytecode);
     }
 
-    GPUCC_API(int32_t)
-    gpuccSuccess
+    GPUCC_API(struct GPUCC_PROGRAM_BYTECODE*)
+    gpuccAcquirePublishedProgram
     (
-        struct GPUCC_RESULT r
+        struct GPUCC_PUBLISHED_PROGRAM *program
     )
     {
-        return g_gpuccDispatch.gpuccSuccess(r);
+        return g_gpuccDispatch.gpuccAcquirePublishedProgram(program);
     }
 
-    GPUCC_API(char const*)
-    gpuccErrorString
+    GPUCC_API(void)
+    gpuccReleasePublishedProgram
     (
-        int32_t gpucc_result_code
+        struct GPUCC_PUBLISHED_PROGRAM *program
     )
     {
-        return g_gpuccDispatch.gpuccErrorString(gpucc_result_code);
+        g_gpuccDispatch.gpuccReleasePublishedProgram(program);
     }
 
-    GPUCC_API(char const*)
-    gpuccBytecodeTypeString
+    GPUCC_API(struct GPUCC_TIERED_COMPILER*)
+    gpuccCreateTieredCompiler
     (
-        int32_t gpucc_bytecode_type
+        struct GPUCC_PROGRAM_COMPILER_INIT *config
     )
     {
-        return g_gpuccDispatch.gpuccBytecodeTypeString(gpucc_bytecode_type);
+        return g_gpuccDispatch.gpuccCreateTieredCompiler(config);
     }
 
-    GPUCC_API(char const*)
-    gpuccCompilerTypeString
+    GPUCC_API(void)
+    gpuccDeleteTieredCompiler
     (
-        int32_t gpucc_compiler_type
+        struct GPUCC_TIERED_COMPILER *tiered
     )
     {
-        return g_gpuccDispatch.gpuccCompilerTypeString(gpucc_compiler_type);
+        g_gpuccDispatch.gpuccDeleteTieredCompiler(tiered);
     }
 
     GPUCC_API(struct GPUCC_RESULT)
-    gpuccStartup
+    gpuccCompileProgramTiered
     (
-        uint32_t gpucc_usage_mode
+        struct GPUCC_TIERED_COMPILER     *tiered, 
+        struct GPUCC_PUBLISHED_PROGRAM  *program, 
+        char const                  *source_code, 
+        uint64_t                     source_size, 
+        char const                  *source_path, 
+        char const                  *entry_point, 
+        struct GPUCC_PROGRAM_BYTECODE **o_failed
     )
     {
-        return g_gpuccDispatch.gpuccStartup(gpucc_usage_mode);
+        return g_gpuccDispatch.gpuccCompileProgramTiered(tiered, program, source_code, source_size, source_path, entry_point, o_failed);
     }
 
     GPUCC_API(void)
-    gpuccShutdown
+    gpuccDrainTieredCompiler
     (
-        void
+        struct GPUCC_TIERED_COMPILER *tiered
     )
     {
-        g_gpuccDispatch.gpuccShutdown();
+        g_gpuccDispatch.gpuccDrainTieredCompiler(tiered);
+    }
+
+    GPUCC_API(struct GPUCC_COMPILE_JOB*)
+    gpuccCompileProgramBytecodeAsyncPriority
+    (
+        struct GPUCC_PROGRAM_BYTECODE *container, 
+        char const                  *source_code, 
+        uint64_t                     source_size, 
+        char const                  *source_path, 
+        char const                  *entry_point, 
+        int32_t                         priority
+    )
+    {
+        return g_gpuccDispatch.gpuccCompileProgramBytecodeAsyncPriority(container, source_code, source_size, source_path, entry_point, priority);
     }
 
     GPUCC_API(struct GPUCC_RESULT)
-    gpuccGetLastResult
+    gpuccConfigureCompileScheduler
+    (
+        struct GPUCC_COMPILE_SCHEDULER_CONFIG const *config
+    )
+    {
+        return g_gpuccDispatch.gpuccConfigureCompileScheduler(config);
+    }
+
+    GPUCC_API(void)
+    gpuccCompileSchedulerTick
     (
         void
     )
     {
-        return g_gpuccDispatch.gpuccGetLastResult();
+        g_gpuccDispatch.gpuccCompileSchedulerTick();
     }
 
-    GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
-    gpuccCreateCompiler
+    GPUCC_API(uint32_t)
+    gpuccQueryCompileQueueDepth
     (
-        struct GPUCC_PROGRAM_COMPILER_INIT *config
+        int32_t priority
     )
     {
-        return g_gpuccDispatch.gpuccCreateCompiler(config);
+        return g_gpuccDispatch.gpuccQueryCompileQueueDepth(priority);
+    }
+
+    GPUCC_API(struct GPUCC_CANCEL_TOKEN*)
+    gpuccCreateCancelToken
+    (
+        void
+    )
+    {
+        return g_gpuccDispatch.gpuccCreateCancelToken();
     }
 
     GPUCC_API(void)
-    gpuccDeleteCompiler 
+    gpuccDeleteCancelToken
     (
-        struct GPUCC_PROGRAM_COMPILER *compiler
+        struct GPUCC_CANCEL_TOKEN *token
     )
     {
-        g_gpuccDispatch.gpuccDeleteCompiler(compiler);
+        g_gpuccDispatch.gpuccDeleteCancelToken(token);
     }
 
-    GPUCC_API(int32_t)
-    gpuccQueryCompilerType
+    GPUCC_API(void)
+    gpuccSignalCancelToken
     (
-        struct GPUCC_PROGRAM_COMPILER *compiler
+        struct GPUCC_CANCEL_TOKEN *token
     )
     {
-        return g_gpuccDispatch.gpuccQueryCompilerType(compiler);
+        g_gpuccDispatch.gpuccSignalCancelToken(token);
     }
 
     GPUCC_API(int32_t)
-    gpuccQueryBytecodeType
+    gpuccQueryCancelTokenSignaled
     (
-        struct GPUCC_PROGRAM_COMPILER *compiler
+        struct GPUCC_CANCEL_TOKEN *token
     )
     {
-        return g_gpuccDispatch.gpuccQueryBytecodeType(compiler);
+        return g_gpuccDispatch.gpuccQueryCancelTokenSignaled(token);
     }
 
-    GPUCC_API(struct GPUCC_PROGRAM_BYTECODE*)
-    gpuccCreateBytecodeContainer
+    GPUCC_API(struct GPUCC_COMPILE_JOB*)
+    gpuccCompileProgramBytecodeAsyncCancellable
     (
-        struct GPUCC_PROGRAM_COMPILER *compiler
+        struct GPUCC_PROGRAM_BYTECODE *container, 
+        char const                  *source_code, 
+        uint64_t                     source_size, 
+        char const                  *source_path, 
+        char const                  *entry_point, 
+        int32_t                         priority, 
+        struct GPUCC_CANCEL_TOKEN  *cancel_token, 
+        uint32_t                     deadline_ms
     )
     {
-        return g_gpuccDispatch.gpuccCreateBytecodeContainer(compiler);
+        return g_gpuccDispatch.gpuccCompileProgramBytecodeAsyncCancellable(container, source_code, source_size, source_path, entry_point, priority, cancel_token, deadline_ms);
     }
 
     GPUCC_API(void)
-    gpuccDeleteBytecodeContainer
+    gpuccCancelCompileJob
     (
-        struct GPUCC_PROGRAM_BYTECODE *bytecode
+        struct GPUCC_COMPILE_JOB *job
     )
     {
-        g_gpuccDispatch.gpuccDeleteBytecodeContainer(bytecode);
+        g_gpuccDispatch.gpuccCancelCompileJob(job);
     }
 
-    GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
-    gpuccQueryBytecodeCompiler
+    GPUCC_API(struct GPUCC_WORKER_PROCESS_POOL*)
+    gpuccCreateWorkerProcessPool
     (
-        struct GPUCC_PROGRAM_BYTECODE *bytecode
+        uint32_t worker_count
     )
     {
-        return g_gpuccDispatch.gpuccQueryBytecodeCompiler(bytecode);
+        return g_gpuccDispatch.gpuccCreateWorkerProcessPool(worker_count);
     }
 
-    GPUCC_API(char const*)
-    gpuccQueryBytecodeEntryPoint
+    GPUCC_API(void)
+    gpuccDeleteWorkerProcessPool
     (
-        struct GPUCC_PROGRAM_BYTECODE *bytecode
+        struct GPUCC_WORKER_PROCESS_POOL *pool
     )
     {
-        return g_gpuccDispatch.gpuccQueryBytecodeEntryPoint(bytecode);
+        g_gpuccDispatch.gpuccDeleteWorkerProcessPool(pool);
     }
 
-    GPUCC_API(char const*)
-    gpuccQueryBytecodeSourcePath
+    GPUCC_API(int32_t)
+    gpuccQueryCompilerBackendMemory
     (
-        struct GPUCC_PROGRAM_BYTECODE *bytecode
+        struct GPUCC_PROGRAM_COMPILER    *compiler, 
+        struct GPUCC_BACKEND_MEMORY_STATS *o_stats
     )
     {
-        return g_gpuccDispatch.gpuccQueryBytecodeSourcePath(bytecode);
+        return g_gpuccDispatch.gpuccQueryCompilerBackendMemory(compiler, o_stats);
     }
 
-    GPUCC_API(struct GPUCC_RESULT)
-    gpuccQueryBytecodeCompileResult
+    GPUCC_API(int32_t)
+    gpuccQueryBytecodeBackendMemory
     (
-        struct GPUCC_PROGRAM_BYTECODE *bytecode
+        struct GPUCC_PROGRAM_BYTECODE    *bytecode, 
+        struct GPUCC_BACKEND_MEMORY_STATS *o_stats
     )
     {
-        return g_gpuccDispatch.gpuccQueryBytecodeCompileResult(bytecode);
+        return g_gpuccDispatch.gpuccQueryBytecodeBackendMemory(bytecode, o_stats);
     }
 
-    GPUCC_API(uint64_t)
-    gpuccQueryBytecodeSizeBytes
+    GPUCC_API(int32_t)
+    gpuccQueryBytecodeTimings
     (
-        struct GPUCC_PROGRAM_BYTECODE *bytecode
+        struct GPUCC_PROGRAM_BYTECODE *bytecode, 
+        struct GPUCC_COMPILE_TIMINGS *o_timings
     )
     {
-        return g_gpuccDispatch.gpuccQueryBytecodeSizeBytes(bytecode);
+        return g_gpuccDispatch.gpuccQueryBytecodeTimings(bytecode, o_timings);
     }
 
-    GPUCC_API(uint64_t)
-    gpuccQueryBytecodeLogSizeBytes
+    GPUCC_API(int32_t)
+    gpuccQueryStatistics
     (
-        struct GPUCC_PROGRAM_BYTECODE *bytecode
+        struct GPUCC_STATISTICS *o_stats
     )
     {
-        return g_gpuccDispatch.gpuccQueryBytecodeLogSizeBytes(bytecode);
+        return g_gpuccDispatch.gpuccQueryStatistics(o_stats);
     }
 
-    GPUCC_API(uint8_t*)
-    gpuccQueryBytecodeBuffer
+    GPUCC_API(struct GPUCC_RESULT)
+    gpuccEnableTracing
     (
-        struct GPUCC_PROGRAM_BYTECODE *bytecode
+        uint32_t events_per_thread
     )
     {
-        return g_gpuccDispatch.gpuccQueryBytecodeBuffer(bytecode);
+        return g_gpuccDispatch.gpuccEnableTracing(events_per_thread);
     }
 
-    GPUCC_API(char*)
-    gpuccQueryBytecodeLogBuffer
+    GPUCC_API(void)
+    gpuccDisableTracing
     (
-        struct GPUCC_PROGRAM_BYTECODE *bytecode
+        void
     )
     {
-        return g_gpuccDispatch.gpuccQueryBytecodeLogBuffer(bytecode);
+        g_gpuccDispatch.gpuccDisableTracing();
     }
 
     GPUCC_API(struct GPUCC_RESULT)
-    gpuccCompileProgramBytecode
+    gpuccWriteTraceFile
     (
-        struct GPUCC_PROGRAM_BYTECODE *container, 
-        char const                  *source_code, 
-        uint64_t                     source_size, 
-        char const                  *source_path, 
-        char const                  *entry_point
+        char const *path
     )
     {
-        return g_gpuccDispatch.gpuccCompileProgramBytecode(container, source_code, source_size, source_path, entry_point);
+        return g_gpuccDispatch.gpuccWriteTraceFile(path);
+    }
+
+    GPUCC_API(uint32_t)
+    gpuccQueryCompileLatency
+    (
+        struct GPUCC_COMPILE_LATENCY *o_latency, 
+        uint32_t                      max_count
+    )
+    {
+        return g_gpuccDispatch.gpuccQueryCompileLatency(o_latency, max_count);
+    }
+
+    GPUCC_API(uint64_t)
+    gpuccFormatCompileLatencyReport
+    (
+        char         *buffer, 
+        uint64_t buffer_size
+    )
+    {
+        return g_gpuccDispatch.gpuccFormatCompileLatencyReport(buffer, buffer_size);
+    }
+
+    GPUCC_API(struct GPUCC_WORKER_PROCESS_POOL*)
+    gpuccCreateWorkerProcessPoolEx
+    (
+        struct GPUCC_WORKER_PROCESS_POOL_INIT const *config
+    )
+    {
+        return g_gpuccDispatch.gpuccCreateWorkerProcessPoolEx(config);
+    }
+
+    GPUCC_API(void)
+    gpuccRunWorkerProcess
+    (
+        int    argc, 
+        char **argv
+    )
+    {
+        g_gpuccDispatch.gpuccRunWorkerProcess(argc, argv);
     }
 
 #endif /* GPUCC_LOCAL_RUNTIME_IMPLEMENTATION */
@@ -0,0 +1,262 @@
+/**
+ * @summary gpucc_async.h: Define the internal interface to the work-stealing
+ * worker pool used to execute asynchronous compile jobs and compile batches.
+ * Each job owns a copy of its source code and strings, and completes by
+ * filling the caller's bytecode container exactly as gpuccCompileProgramBytecode
+ * would.
+ */
+#ifndef __GPUCC_ASYNC_H__
+#define __GPUCC_ASYNC_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   include <atomic>
+#   include <condition_variable>
+#   include <deque>
+#   include <mutex>
+#   include <thread>
+#   include <vector>
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#   ifndef __GPUCC_CANCEL_H__
+#       include "gpucc_cancel.h"
+#   endif
+#endif
+
+/* @summary Define the signature of the function that executes a unit of work on the pool.
+ * @param task The task being executed. The function may free the task.
+ */
+typedef void (*PFN_CompileTaskExecute)(struct GPUCC_COMPILE_TASK *task);
+
+/* @summary Define the states a compile job moves through. States only ever advance.
+ */
+typedef enum GPUCC_COMPILE_JOB_STATE {
+    GPUCC_COMPILE_JOB_STATE_QUEUED                =   0,                       /* The job is waiting in the pool queue. */
+    GPUCC_COMPILE_JOB_STATE_RUNNING               =   1,                       /* A worker thread is compiling the job. */
+    GPUCC_COMPILE_JOB_STATE_COMPLETE              =   2,                       /* The job has finished and the Result field is valid. */
+} GPUCC_COMPILE_JOB_STATE;
+
+/* @summary Define the header shared by every unit of work executed by the pool.
+ * Task types embed this structure as their first field.
+ */
+typedef struct GPUCC_COMPILE_TASK {
+    PFN_CompileTaskExecute         Execute;                                    /* The function that performs the work. */
+    uint64_t                       QueueTime;                                  /* The value of gpuccTraceBegin when the task was submitted to the pool, or zero if tracing was disabled. */
+    struct GPUCC_CANCEL_STATE     *CancelState;                                /* For a task in an injection queue, the cancellation state of the task, or NULL if it cannot be cancelled. Not used for other tasks. */
+} GPUCC_COMPILE_TASK;
+
+/* @summary Define the data associated with a single asynchronous compile job.
+ * The job and copies of all input strings and source code are stored in a single allocation made from the container's host allocator.
+ * The job holds its own completion state, and does not refer to the pool, so that it can be waited for and deleted after gpuccShutdown has deleted the pool.
+ */
+typedef struct GPUCC_COMPILE_JOB {
+    GPUCC_COMPILE_TASK             Task;                                       /* The task header. This must be the first field. */
+    struct GPUCC_PROGRAM_BYTECODE *Container;                                  /* The bytecode container that receives the compilation results. */
+    char const                    *SourceCode;                                 /* The job's private copy of the program source code. */
+    uint64_t                       SourceSize;                                 /* The number of bytes of source code. */
+    char const                    *SourcePath;                                 /* The job's private copy of the source path, or NULL. */
+    char const                    *EntryPoint;                                 /* The job's private copy of the entry point, or NULL. */
+    GPUCC_HOST_ALLOCATOR           HostAllocator;                              /* A copy of the container's host allocator, used to free the job, since the container may be deleted first. */
+    GPUCC_RESULT                   Result;                                     /* The result of the compilation. Valid only once State is GPUCC_COMPILE_JOB_STATE_COMPLETE. */
+    GPUCC_CANCEL_STATE             Cancel;                                     /* The cancellation token, flag and deadline of the job. The token reference is released when the job completes. */
+    std::atomic<int32_t>           State;                                      /* One of the values of the GPUCC_COMPILE_JOB_STATE enumeration. */
+    std::mutex                     CompleteLock;                               /* Protects the transition of the job into the complete state. Held while CompleteSignal is signaled, so that a waiting thread cannot delete the job first. */
+    std::condition_variable        CompleteSignal;                             /* Signaled when the job completes. */
+} GPUCC_COMPILE_JOB;
+
+/* @summary Define the state shared by all of the items in a single call to gpuccCompileProgramBatch.
+ * The structure lives on the stack of the calling thread, which does not return until RemainingCount reaches zero.
+ */
+typedef struct GPUCC_COMPILE_BATCH {
+    std::atomic<uint32_t>          RemainingCount;                             /* The number of items that have not yet completed. */
+    std::atomic<uint32_t>          FailureCount;                               /* The number of items whose compilation failed. */
+    std::atomic<uint64_t>          CompileNanoseconds;                         /* The sum of the time spent compiling each item. */
+    std::atomic<uint64_t>          MaxItemNanoseconds;                         /* The longest time spent compiling any single item. */
+    std::mutex                     DoneLock;                                   /* Held by the calling thread while it sleeps waiting for the batch to complete. */
+    std::condition_variable        DoneSignal;                                 /* Signaled when the last item completes. */
+} GPUCC_COMPILE_BATCH;
+
+/* @summary Define the task used to compile one item of a batch.
+ * The caller's item and result storage are used directly, since the caller blocks until the batch completes.
+ */
+typedef struct GPUCC_COMPILE_BATCH_TASK {
+    GPUCC_COMPILE_TASK             Task;                                       /* The task header. This must be the first field. */
+    GPUCC_COMPILE_BATCH_ITEM const*Item;                                       /* The item to compile. */
+    GPUCC_RESULT                  *Result;                                     /* The location that receives the result of the compilation. */
+    GPUCC_COMPILE_BATCH           *Batch;                                      /* The batch the task belongs to. */
+} GPUCC_COMPILE_BATCH_TASK;
+
+/* @summary Define the double-ended queue of tasks owned by a single worker thread.
+ * The owner pushes and pops at the back, so it works on the most recently queued (and most cache-friendly) task.
+ * Other threads steal from the front, taking the oldest work first.
+ */
+typedef struct GPUCC_COMPILE_WORKER_QUEUE {
+    std::mutex                     Lock;                                       /* Protects the Tasks field. Contention only occurs when a thief and the owner meet. */
+    std::deque<GPUCC_COMPILE_TASK*> Tasks;                                     /* The tasks queued to the worker. */
+} GPUCC_COMPILE_WORKER_QUEUE;
+
+/* @summary Define the data associated with the compile worker pool.
+ * Worker threads are not started until the first task is submitted, so applications that never compile in the background pay nothing.
+ * Tasks submitted from outside the pool one at a time (asynchronous jobs) go to one shared injection queue per priority class.
+ * Batches are spread across the per-worker queues, and idle workers steal from each other to keep every core busy.
+ * A worker takes batch work first, since a thread is blocked waiting for it, and then the oldest task of the highest non-empty priority class.
+ * Tasks of budgeted classes are not started while the tick budget is exhausted, and workers sleep rather than spin while only such tasks remain.
+ */
+typedef struct GPUCC_COMPILE_POOL {
+    std::mutex                     QueueLock;                                  /* Protects the Injection, Workers, budget and ShutdownFlag fields, and is held while idle workers sleep. */
+    std::condition_variable        QueueSignal;                                /* Signaled when work is submitted or the pool is shutting down. */
+    std::deque<GPUCC_COMPILE_TASK*> Injection[GPUCC_COMPILE_PRIORITY_COUNT];   /* The FIFO queues of tasks submitted individually from outside the pool, indexed by GPUCC_COMPILE_PRIORITY. */
+    std::vector<std::thread>       Workers;                                    /* The worker threads, or empty if no task has been submitted yet. */
+    GPUCC_COMPILE_WORKER_QUEUE    *WorkerQueues;                               /* An array of WorkerCount per-worker queues. */
+    std::atomic<uint64_t>          PendingCount;                               /* The number of tasks queued but not yet taken by any thread. */
+    uint64_t                       TickBudget;                                 /* The CPU time, in nanoseconds, that budgeted classes may consume per tick, or zero for no limit. */
+    int64_t                        BudgetRemaining;                            /* The CPU time remaining in the current tick. Negative if the previous ticks overran. */
+    int32_t                        BudgetedPriority;                           /* The highest priority class subject to the budget. */
+    std::atomic<int32_t>           WorkerPriority;                             /* The GPUCC_WORKER_THREAD_PRIORITY requested for the worker threads. Each worker applies a change before taking its next task. */
+    uint32_t                       WorkerCount;                                /* The number of worker threads to start, and the number of entries in WorkerQueues. */
+    bool                           ShutdownFlag;                               /* Set to true when the pool is being deleted. The budget is ignored while the remaining tasks are drained. */
+} GPUCC_COMPILE_POOL;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Create the compile worker pool. Worker threads are started on first use.
+ * @param worker_count The number of worker threads, or zero to use one thread per hardware thread.
+ * @return A pointer to the pool, or NULL if memory allocation failed.
+ */
+GPUCC_API(struct GPUCC_COMPILE_POOL*)
+gpuccCreateCompilePool
+(
+    uint32_t worker_count
+);
+
+/* @summary Delete the compile worker pool. All queued tasks are executed before the worker threads exit, so every asynchronous compile job is complete once this function returns.
+ * This function blocks the calling thread until all worker threads have exited.
+ * @param pool The pool to delete. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccDeleteCompilePool
+(
+    struct GPUCC_COMPILE_POOL *pool
+);
+
+/* @summary Submit a single task to the compile worker pool's injection queue for a priority class, starting the worker threads if necessary.
+ * A task that has been cancelled is started even if its class is out of budget, since it completes without compiling.
+ * @param pool The pool that will execute the task.
+ * @param task The task to execute.
+ * @param priority One of the values of the GPUCC_COMPILE_PRIORITY enumeration.
+ * @param cancel The cancellation state checked by the task before it starts, or NULL if the task cannot be cancelled.
+ * @return Non-zero if the task was queued, or zero if the worker threads could not be started.
+ */
+GPUCC_API(int32_t)
+gpuccCompilePoolSubmit
+(
+    struct GPUCC_COMPILE_POOL *pool,
+    struct GPUCC_COMPILE_TASK  *task,
+    int32_t                 priority,
+    struct GPUCC_CANCEL_STATE *cancel
+);
+
+/* @summary Wake the idle worker threads of a compile pool, so that they start any queued task that was cancelled while its class was out of budget.
+ * This function may be called from any thread.
+ * @param pool The compile pool. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccCompilePoolWake
+(
+    struct GPUCC_COMPILE_POOL *pool
+);
+
+/* @summary Apply a scheduler configuration to the compile worker pool. The budget of the current tick is reset to the new per-tick budget.
+ * @param pool The compile pool.
+ * @param config The validated scheduler configuration.
+ */
+GPUCC_API(void)
+gpuccCompilePoolConfigure
+(
+    struct GPUCC_COMPILE_POOL                  *pool,
+    struct GPUCC_COMPILE_SCHEDULER_CONFIG const *config
+);
+
+/* @summary Begin a new scheduler tick, adding the per-tick budget to the budget remaining and waking workers if budgeted tasks can now start.
+ * Unused budget does not carry over, but an overrun does.
+ * @param pool The compile pool.
+ */
+GPUCC_API(void)
+gpuccCompilePoolTick
+(
+    struct GPUCC_COMPILE_POOL *pool
+);
+
+/* @summary Retrieve the number of tasks of a priority class queued to the compile worker pool and not yet started.
+ * @param pool The compile pool.
+ * @param priority One of the values of the GPUCC_COMPILE_PRIORITY enumeration.
+ * @return The number of queued tasks.
+ */
+GPUCC_API(uint32_t)
+gpuccCompilePoolQueueDepth
+(
+    struct GPUCC_COMPILE_POOL *pool,
+    int32_t                priority
+);
+
+/* @summary Submit a set of tasks to the compile worker pool, dividing them into contiguous runs across the per-worker queues.
+ * @param pool The pool that will execute the tasks.
+ * @param tasks An array of task_count pointers to the tasks to execute.
+ * @param task_count The number of tasks to submit.
+ * @return The number of running worker threads, sampled while the tasks were queued, or zero if the worker threads could not be started.
+ */
+GPUCC_API(uint32_t)
+gpuccCompilePoolSubmitBatch
+(
+    struct GPUCC_COMPILE_POOL  *pool,
+    struct GPUCC_COMPILE_TASK **tasks,
+    uint32_t               task_count
+);
+
+/* @summary Attempt to take one task from any per-worker queue and execute it on the calling thread.
+ * Threads that are waiting for a batch to complete call this function so they contribute to the work rather than sleeping.
+ * @param pool The pool to steal from.
+ * @return Non-zero if a task was executed, or zero if no task was available.
+ */
+GPUCC_API(int32_t)
+gpuccCompilePoolHelp
+(
+    struct GPUCC_COMPILE_POOL *pool
+);
+
+/* @summary Mark one task of a batch as complete, waking the thread waiting in gpuccCompilePoolRunBatch if it was the last one.
+ * Every task submitted through gpuccCompilePoolRunBatch must call this function exactly once, as the last thing it does with the batch.
+ * @param batch The batch the task belongs to.
+ */
+GPUCC_API(void)
+gpuccCompileBatchItemComplete
+(
+    struct GPUCC_COMPILE_BATCH *batch
+);
+
+/* @summary Execute a set of tasks on the compile worker pool and wait for all of them to complete.
+ * The calling thread helps execute tasks while it waits. If the worker threads cannot be started, all tasks run on the calling thread.
+ * @param pool The pool that will execute the tasks.
+ * @param batch The batch shared by the tasks. The RemainingCount field must be initialized to task_count.
+ * @param tasks An array of task_count pointers to the tasks to execute.
+ * @param task_count The number of tasks to execute.
+ * @return The number of worker threads available to the batch, or zero if all tasks ran on the calling thread.
+ */
+GPUCC_API(uint32_t)
+gpuccCompilePoolRunBatch
+(
+    struct GPUCC_COMPILE_POOL   *pool,
+    struct GPUCC_COMPILE_BATCH *batch,
+    struct GPUCC_COMPILE_TASK **tasks,
+    uint32_t               task_count
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_ASYNC_H__ */
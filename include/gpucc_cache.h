@@ -0,0 +1,147 @@
+/**
+ * @summary gpucc_cache.h: Define the internal interface to the persistent,
+ * content-addressed bytecode cache. Each successful compilation is stored in
+ * a file named by the hash of everything that can affect the output, so a
+ * later compilation with the same inputs can skip the backend entirely.
+ */
+#ifndef __GPUCC_CACHE_H__
+#define __GPUCC_CACHE_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#endif
+
+/* @summary Define the value stored in the Magic field of a cache file header ('GPCC').
+ */
+#ifndef GPUCC_BYTECODE_CACHE_MAGIC
+#define GPUCC_BYTECODE_CACHE_MAGIC                                    0x43435047UL
+#endif
+
+/* @summary Define the version of the cache file format.
+ * Increment this value whenever the layout of the cache file or the composition of the cache key changes.
+ */
+#ifndef GPUCC_BYTECODE_CACHE_VERSION
+#define GPUCC_BYTECODE_CACHE_VERSION                                             3
+#endif
+
+/* @summary Define the header written at the start of each cache file.
+ * The header is immediately followed by BytecodeSize bytes of bytecode and LogBufferSize bytes of log text.
+ * These are followed by DependencyCount content hashes, DependencyCount include types, DependencyBytes bytes of nul-terminated resolved paths, one for each file read through the include handler,
+ * and RequestBytes bytes holding the nul-terminated include path and requesting path that produced each file.
+ * Cache files are written in host byte order and are not intended to be shared between hosts of different endianness.
+ */
+typedef struct GPUCC_BYTECODE_CACHE_HEADER {
+    uint32_t                      Magic;                                       /* Set to GPUCC_BYTECODE_CACHE_MAGIC. */
+    uint32_t                      Version;                                     /* Set to GPUCC_BYTECODE_CACHE_VERSION. */
+    GPUCC_HASH128                 Key;                                         /* The cache key, which must match the key derived from the file name. */
+    uint64_t                      BytecodeSize;                                /* The number of bytes of bytecode following the header. */
+    uint64_t                      LogBufferSize;                               /* The number of bytes of log text following the bytecode, including the nul. */
+    int32_t                       CompilerType;                                /* One of the values of the GPUCC_COMPILER_TYPE enumeration specifying the compiler that produced the bytecode. */
+    int32_t                       BytecodeType;                                /* One of the values of the GPUCC_BYTECODE_TYPE enumeration specifying the type of bytecode. */
+    uint32_t                      DependencyCount;                             /* The number of files read through the include handler by the compilation that produced the entry. */
+    uint32_t                      DependencyBytes;                             /* The number of bytes of packed, nul-terminated dependency paths following the include types. */
+    uint32_t                      RequestBytes;                                /* The number of bytes of packed, nul-terminated include requests following the dependency paths. */
+    uint32_t                      Reserved;                                    /* Set to zero. */
+} GPUCC_BYTECODE_CACHE_HEADER;
+
+/* @summary Define the data associated with a bytecode cache.
+ * The cache itself is stateless beyond the directory path; all synchronization is provided by the file system.
+ * Entries are written to a temporary file and renamed into place, so concurrent readers never see a partial entry.
+ */
+typedef struct GPUCC_BYTECODE_CACHE {
+    char                         *CacheDirectory;                              /* A nul-terminated UTF-8 string specifying the directory containing cache files, without a trailing separator. */
+    size_t                        DirectoryLength;                             /* The length of the CacheDirectory string, in bytes, not including the nul. */
+} GPUCC_BYTECODE_CACHE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Create a bytecode cache that stores entries in a given directory.
+ * The directory must already exist. It may be shared by multiple threads and processes.
+ * @param cache_directory A nul-terminated UTF-8 string specifying the path of the cache directory.
+ * @return A pointer to the cache, or NULL if an error occurred.
+ */
+GPUCC_API(struct GPUCC_BYTECODE_CACHE*)
+gpuccCreateBytecodeCache
+(
+    char const *cache_directory
+);
+
+/* @summary Free resources associated with a bytecode cache. Cache files are not deleted.
+ * @param cache The bytecode cache to delete.
+ */
+GPUCC_API(void)
+gpuccDeleteBytecodeCache
+(
+    struct GPUCC_BYTECODE_CACHE *cache
+);
+
+/* @summary Compute the cache key for a compilation.
+ * The key combines the compiler configuration hash (which includes the backend version) with the entry point and source code.
+ * If the compiler has an include handler, the source path is part of the key, since relative includes are resolved against it.
+ * Included files are not part of the key. They are recorded in the entry and checked by gpuccBytecodeCacheLookup.
+ * @param container The bytecode container. The entry point must already have been set by gpuccSetProgramEntryPoint.
+ * @param source_code Pointer to a buffer containing the program source code.
+ * @param source_size The number of bytes of program source code.
+ * @return The 128-bit cache key.
+ */
+GPUCC_API(struct GPUCC_HASH128)
+gpuccBytecodeCacheKey
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size
+);
+
+/* @summary Attempt to load a compilation result from the cache.
+ * On a hit, the bytecode and log are read into a single buffer owned by the container, and the BytecodeBuffer and LogBuffer fields point into it.
+ * If the entry records included files, each recorded include request is resolved again through the include handler of the container's compiler, and the entry
+ * is used only if every request resolves to the same path with the same content. The files are recorded as dependencies of the container, as a compilation would.
+ * @param cache The bytecode cache to search.
+ * @param container The bytecode container to fill.
+ * @param key The cache key returned by gpuccBytecodeCacheKey.
+ * @return Non-zero if the entry was found and loaded, or zero on a cache miss.
+ */
+GPUCC_API(int32_t)
+gpuccBytecodeCacheLookup
+(
+    struct GPUCC_BYTECODE_CACHE       *cache,
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    struct GPUCC_HASH128 const          *key
+);
+
+/* @summary Write the bytecode, log and dependencies of a successful compilation to the cache.
+ * Failures to write are not reported to the caller, since the compilation itself succeeded.
+ * @param cache The bytecode cache to update.
+ * @param container The bytecode container holding a successful compilation result.
+ * @param key The cache key returned by gpuccBytecodeCacheKey.
+ * @return Non-zero if the entry was written, or zero otherwise.
+ */
+GPUCC_API(int32_t)
+gpuccBytecodeCacheStore
+(
+    struct GPUCC_BYTECODE_CACHE       *cache,
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    struct GPUCC_HASH128 const          *key
+);
+
+/* @summary Free the buffer holding bytecode loaded from the cache, if any.
+ * This function is called when a bytecode container is deleted.
+ * @param container The bytecode container.
+ */
+GPUCC_API(void)
+gpuccBytecodeCacheRelease
+(
+    struct GPUCC_PROGRAM_BYTECODE *container
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_CACHE_H__ */
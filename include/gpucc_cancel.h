@@ -0,0 +1,90 @@
+/**
+ * @summary gpucc_cancel.h: Define the internal interface to cancellation
+ * tokens and per-job deadlines. The library cannot interrupt a compiler
+ * backend, so cancellation is observed at safe points: before a job starts,
+ * before the backend is invoked, when the backend requests an include file,
+ * and when the backend returns. A backend running in a worker process is
+ * instead terminated along with the worker.
+ */
+#ifndef __GPUCC_CANCEL_H__
+#define __GPUCC_CANCEL_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   include <atomic>
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#endif
+
+/* @summary Define the value of GPUCC_CANCEL_STATE::Deadline for a job with no deadline.
+ */
+#ifndef GPUCC_CANCEL_NO_DEADLINE
+#define GPUCC_CANCEL_NO_DEADLINE                                 UINT64_MAX
+#endif
+
+/* @summary Define the data associated with a cancellation token.
+ * The application and every job using the token each hold a reference, so the token is freed when the last of them releases it.
+ */
+typedef struct GPUCC_CANCEL_TOKEN {
+    std::atomic<uint32_t>          RefCount;                                   /* The number of references to the token. */
+    std::atomic<int32_t>           SignalFlag;                                 /* Non-zero once the token has been signaled. */
+} GPUCC_CANCEL_TOKEN;
+
+/* @summary Define the cancellation state of a single compile job.
+ * While the job is compiling, the container's CancelState field points at this structure, so that the safe points deep in the compile path can find it.
+ */
+typedef struct GPUCC_CANCEL_STATE {
+    GPUCC_CANCEL_TOKEN            *Token;                                      /* The token shared with other jobs, or NULL. The job holds a reference. */
+    std::atomic<int32_t>           CancelFlag;                                 /* Non-zero once gpuccCancelCompileJob has been called for the job. */
+    uint64_t                       Deadline;                                   /* The steady clock time, in nanoseconds, after which the job is cancelled, or GPUCC_CANCEL_NO_DEADLINE. */
+} GPUCC_CANCEL_STATE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Retrieve the current time of the steady clock used for deadlines.
+ * @return The current time, in nanoseconds.
+ */
+GPUCC_API(uint64_t)
+gpuccCancelClockNanoseconds
+(
+    void
+);
+
+/* @summary Add a reference to a cancellation token.
+ * @param token The cancellation token. This value may be NULL.
+ * @return The token.
+ */
+GPUCC_API(struct GPUCC_CANCEL_TOKEN*)
+gpuccRetainCancelToken
+(
+    struct GPUCC_CANCEL_TOKEN *token
+);
+
+/* @summary Release a reference to a cancellation token, freeing it if this was the last reference.
+ * @param token The cancellation token. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccReleaseCancelToken
+(
+    struct GPUCC_CANCEL_TOKEN *token
+);
+
+/* @summary Determine whether a job has been cancelled or its deadline has passed.
+ * @param state The cancellation state of the job, or NULL for a compile that cannot be cancelled.
+ * @return Non-zero if the compile should be abandoned.
+ */
+GPUCC_API(int32_t)
+gpuccCancelRequested
+(
+    struct GPUCC_CANCEL_STATE const *state
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_CANCEL_H__ */
@@ -0,0 +1,172 @@
+/**
+ * @summary gpucc_depend.h: Define the internal interface used to record the
+ * files read by each compilation, and the build state used by the incremental
+ * build driver to decide which outputs are out-of-date.
+ */
+#ifndef __GPUCC_DEPEND_H__
+#define __GPUCC_DEPEND_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   include <string>
+#   include <unordered_map>
+#   include <vector>
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#   ifndef __GPUCC_ASYNC_H__
+#       include "gpucc_async.h"
+#   endif
+#endif
+
+/* @summary Define the value stored in the Magic field of a build state file header ('GPBS').
+ */
+#ifndef GPUCC_BUILD_STATE_MAGIC
+#define GPUCC_BUILD_STATE_MAGIC                                       0x53425047UL
+#endif
+
+/* @summary Define the version of the build state file format.
+ * Increment this value whenever the layout of the file or the composition of the record hashes changes.
+ */
+#ifndef GPUCC_BUILD_STATE_VERSION
+#define GPUCC_BUILD_STATE_VERSION                                                1
+#endif
+
+/* @summary Define the header written at the start of a build state file.
+ * The header is followed by RecordCount records. Each record is a GPUCC_BUILD_STATE_RECORD_HEADER, followed by the output path,
+ * followed by FileCount entries, each of which is a GPUCC_BUILD_STATE_FILE_HEADER followed by the file path. Paths are not nul-terminated.
+ * Build state files are written in host byte order and are not intended to be shared between hosts of different endianness.
+ */
+typedef struct GPUCC_BUILD_STATE_HEADER {
+    uint32_t                      Magic;                                       /* Set to GPUCC_BUILD_STATE_MAGIC. */
+    uint32_t                      Version;                                     /* Set to GPUCC_BUILD_STATE_VERSION. */
+    uint32_t                      RecordCount;                                 /* The number of output records following the header. */
+    uint32_t                      Reserved;                                    /* Set to zero. */
+} GPUCC_BUILD_STATE_HEADER;
+
+/* @summary Define the fixed-size portion of a single output record in a build state file.
+ */
+typedef struct GPUCC_BUILD_STATE_RECORD_HEADER {
+    GPUCC_HASH128                 ConfigHash;                                  /* The hash of the compiler configuration and entry point used to build the output. */
+    uint32_t                      OutputPathLength;                            /* The number of bytes in the output path that follows. */
+    uint32_t                      FileCount;                                   /* The number of file entries that follow the output path. The first entry is the source file. */
+} GPUCC_BUILD_STATE_RECORD_HEADER;
+
+/* @summary Define the fixed-size portion of a single input file entry in a build state file.
+ */
+typedef struct GPUCC_BUILD_STATE_FILE_HEADER {
+    GPUCC_HASH128                 ContentHash;                                 /* The hash of the file content at the time the output was built. */
+    uint32_t                      PathLength;                                  /* The number of bytes in the file path that follows. */
+    uint32_t                      Reserved;                                    /* Set to zero. */
+} GPUCC_BUILD_STATE_FILE_HEADER;
+
+/* @summary Define an input file and the hash of its content.
+ */
+typedef struct GPUCC_BUILD_FILE {
+    std::string                   Path;                                        /* The path of the file. */
+    GPUCC_HASH128                 ContentHash;                                 /* The hash of the file content. */
+} GPUCC_BUILD_FILE;
+
+/* @summary Define everything known about how a single output was last built.
+ */
+typedef struct GPUCC_BUILD_RECORD {
+    GPUCC_HASH128                 ConfigHash;                                  /* The hash of the compiler configuration and entry point. */
+    std::vector<GPUCC_BUILD_FILE> Files;                                       /* The input files. The first entry is the source file. */
+} GPUCC_BUILD_RECORD;
+
+/* @summary Define the build state loaded from, and written back to, the build state file.
+ */
+typedef std::unordered_map<std::string, GPUCC_BUILD_RECORD> GPUCC_BUILD_STATE;
+
+/* @summary Define the current content hash of a file, as computed at most once per call to gpuccBuildIncremental.
+ */
+typedef struct GPUCC_BUILD_CONTENT {
+    GPUCC_HASH128                 ContentHash;                                 /* The hash of the file content. Valid only if Exists is non-zero. */
+    int32_t                       Exists;                                      /* Non-zero if the file could be read. */
+} GPUCC_BUILD_CONTENT;
+
+/* @summary Define the set of file content hashes computed during a single call to gpuccBuildIncremental, keyed by path.
+ */
+typedef std::unordered_map<std::string, GPUCC_BUILD_CONTENT> GPUCC_BUILD_CONTENT_MAP;
+
+/* @summary Define the state shared by all of the items compiled by a single call to gpuccBuildIncremental.
+ * The structure lives on the stack of the calling thread, which does not return until every item has completed.
+ */
+typedef struct GPUCC_BUILD_RUN {
+    GPUCC_COMPILE_BATCH           Batch;                                       /* Tracks completion of the build tasks. */
+    struct GPUCC_PROGRAM_COMPILER*Compiler;                                    /* The compiler shared by every item. */
+    GPUCC_HASH128                 ConfigHash;                                  /* The hash of the compiler configuration. */
+} GPUCC_BUILD_RUN;
+
+/* @summary Define the task used to compile a single out-of-date item.
+ * On success, the task fills in Record with the files the item read. Content hashes for included files are computed after the batch completes.
+ */
+typedef struct GPUCC_BUILD_TASK {
+    GPUCC_COMPILE_TASK            Task;                                        /* The task header. This must be the first field. */
+    GPUCC_BUILD_RUN              *Run;                                         /* The run the task belongs to. */
+    GPUCC_BUILD_ITEM const       *Item;                                        /* The item to build. */
+    GPUCC_BUILD_ITEM_RESULT      *Result;                                      /* The location that receives the result for the item. */
+    GPUCC_BUILD_RECORD            Record;                                      /* The build record for the item, valid if the item was rebuilt. */
+} GPUCC_BUILD_TASK;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Record that a file was read while compiling into a bytecode container. Paths already recorded are ignored.
+ * The include request that produced the file is recorded with it, so that the bytecode cache can resolve it again.
+ * @param container The bytecode container being compiled into.
+ * @param path A nul-terminated UTF-8 string specifying the resolved path of the file.
+ * @param content_hash The hash of the file content the backend was given, so that an incremental build records exactly what was compiled.
+ * @param include_path The path passed to the include handler, or NULL to record the resolved path.
+ * @param requesting_path The requesting path passed to the include handler. This value may be NULL.
+ * @param include_type One of the values of the GPUCC_INCLUDE_TYPE enumeration passed to the include handler.
+ * @return Non-zero if the path is recorded, or zero if memory allocation failed.
+ */
+GPUCC_API(int32_t)
+gpuccRecordDependency
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                       *path,
+    struct GPUCC_HASH128 const *content_hash,
+    char const               *include_path,
+    char const            *requesting_path,
+    int32_t                   include_type
+);
+
+/* @summary Forget the dependencies recorded in a bytecode container, retaining the storage for reuse.
+ * @param container The bytecode container being reset.
+ */
+GPUCC_API(void)
+gpuccResetDependencies
+(
+    struct GPUCC_PROGRAM_BYTECODE *container
+);
+
+/* @summary Free the storage used to record dependencies in a bytecode container.
+ * @param container The bytecode container being deleted.
+ */
+GPUCC_API(void)
+gpuccFreeDependencies
+(
+    struct GPUCC_PROGRAM_BYTECODE *container
+);
+
+/* @summary Read the entire contents of a file.
+ * @param path A nul-terminated UTF-8 string specifying the path of the file.
+ * @param o_content On return, stores the file content.
+ * @return Non-zero if the file was read.
+ */
+GPUCC_API(int32_t)
+gpuccReadFileToString
+(
+    char const       *path,
+    std::string &o_content
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_DEPEND_H__ */
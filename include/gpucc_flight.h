@@ -0,0 +1,171 @@
+/**
+ * @summary gpucc_flight.h: Define the internal interface used to deduplicate
+ * identical compilations that are in progress at the same time. The first
+ * thread to request a compilation becomes the leader of a flight and runs the
+ * backend; threads requesting the same compilation while the flight is in
+ * progress wait for it and receive a reference to the leader's result.
+ */
+#ifndef __GPUCC_FLIGHT_H__
+#define __GPUCC_FLIGHT_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   include <atomic>
+#   include <condition_variable>
+#   include <mutex>
+#   include <unordered_map>
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#endif
+
+/* @summary Define the interval, in milliseconds, at which a cancellable request waiting for a flight checks whether it has been cancelled.
+ */
+#ifndef GPUCC_FLIGHT_CANCEL_POLL_MS
+#define GPUCC_FLIGHT_CANCEL_POLL_MS                              10
+#endif
+
+/* @summary Define the result of a compilation shared by the bytecode containers of every request in a flight.
+ * The structure, dependency hashes, bytecode, log and dependency paths are allocated as a single block. Containers reference the block rather than copying it.
+ */
+typedef struct GPUCC_SHARED_RESULT {
+    std::atomic<uint32_t>          RefCount;                                   /* The number of bytecode containers referencing the result. */
+    GPUCC_HOST_ALLOCATOR           HostAllocator;                              /* A copy of the leader's host allocator, used to free the block, since the leader's compiler may be deleted first. */
+    GPUCC_RESULT                   CompileResult;                              /* The result of the compilation. */
+    uint8_t                       *BytecodeBuffer;                             /* The compiled bytecode, or NULL. */
+    uint64_t                       BytecodeSize;                               /* The number of bytes of compiled bytecode. */
+    char                          *LogBuffer;                                  /* The nul-terminated compiler output, or NULL. */
+    uint64_t                       LogBufferSize;                              /* The number of bytes of data in the log buffer, including the nul. */
+    char                          *DependencyBuffer;                           /* The nul-terminated paths of the files read through the include handler, packed end-to-end. */
+    GPUCC_HASH128                 *DependencyHashes;                           /* The content hash of each file in DependencyBuffer, as served to the backend. */
+    uint32_t                       DependencyCount;                            /* The number of paths in DependencyBuffer. */
+} GPUCC_SHARED_RESULT;
+
+/* @summary Define the state of a single in-progress compilation and the requests waiting for it.
+ * The flight is freed by whichever of the leader or the last waiter finishes with it last.
+ */
+typedef struct GPUCC_COMPILE_FLIGHT {
+    GPUCC_SHARED_RESULT           *Result;                                     /* The shared result, or NULL if the leader could not copy its result. Valid once Complete is set. The flight holds one reference per waiter. */
+    uint32_t                       WaiterCount;                                /* The number of requests waiting for the leader. Cancelled requests leave before the leader completes. */
+    bool                           Complete;                                   /* Set to true when the leader has finished. */
+    std::condition_variable        DoneSignal;                                 /* Signaled when Complete is set. */
+} GPUCC_COMPILE_FLIGHT;
+
+/* @summary Define a function object that hashes a GPUCC_HASH128 for use as an unordered_map key.
+ */
+struct GPUCC_HASH128_HASHER {
+    size_t operator()(GPUCC_HASH128 const &h) const { return (size_t)(h.Low ^ h.High); }
+};
+
+/* @summary Define a function object that compares two GPUCC_HASH128 values for use as an unordered_map key.
+ */
+struct GPUCC_HASH128_EQUAL {
+    bool operator()(GPUCC_HASH128 const &a, GPUCC_HASH128 const &b) const { return a.Low == b.Low && a.High == b.High; }
+};
+
+/* @summary Define the set of compilations in progress in the process, keyed by flight key.
+ */
+typedef struct GPUCC_COMPILE_FLIGHT_TABLE {
+    std::mutex                     Lock;                                       /* Protects the Flights map and the WaiterCount, Complete and Result fields of every flight. */
+    std::unordered_map<GPUCC_HASH128, GPUCC_COMPILE_FLIGHT*, GPUCC_HASH128_HASHER, GPUCC_HASH128_EQUAL> Flights; /* The flights in progress. */
+} GPUCC_COMPILE_FLIGHT_TABLE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Create an empty flight table.
+ * @return A pointer to the flight table, or NULL if memory allocation failed.
+ */
+GPUCC_API(struct GPUCC_COMPILE_FLIGHT_TABLE*)
+gpuccCreateCompileFlightTable
+(
+    void
+);
+
+/* @summary Free a flight table. No compilation may be in progress.
+ * @param table The flight table to delete. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccDeleteCompileFlightTable
+(
+    struct GPUCC_COMPILE_FLIGHT_TABLE *table
+);
+
+/* @summary Compute the key identifying a compilation for deduplication.
+ * The key extends the bytecode cache key with the source path and the identity of the include handler when one is set, since requests that resolve includes differently must not share a result.
+ * @param container The bytecode container. The entry point must already have been set by gpuccSetProgramEntryPoint.
+ * @param source_code Pointer to a buffer containing the program source code.
+ * @param source_size The number of bytes of program source code.
+ * @return The 128-bit flight key.
+ */
+GPUCC_API(struct GPUCC_HASH128)
+gpuccCompileFlightKey
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size
+);
+
+/* @summary Join the flight for a compilation, starting one if none is in progress.
+ * @param table The flight table.
+ * @param key The flight key returned by gpuccCompileFlightKey.
+ * @param o_leader On return, set to non-zero if the caller started the flight and must compile, then call gpuccCompleteCompileFlight.
+ * Otherwise, the caller must call gpuccWaitCompileFlight.
+ * @return The flight, or NULL if memory allocation failed, in which case the caller compiles without deduplication.
+ */
+GPUCC_API(struct GPUCC_COMPILE_FLIGHT*)
+gpuccJoinCompileFlight
+(
+    struct GPUCC_COMPILE_FLIGHT_TABLE *table,
+    struct GPUCC_HASH128 const          *key,
+    int32_t                         *o_leader
+);
+
+/* @summary Finish a flight started by the calling thread, sharing the result in a bytecode container with any waiting requests.
+ * If no request is waiting, the result is not copied.
+ * @param table The flight table.
+ * @param key The flight key passed to gpuccJoinCompileFlight.
+ * @param flight The flight returned by gpuccJoinCompileFlight.
+ * @param container The bytecode container holding the leader's result, or NULL if the result must not be shared, in which case the waiters compile for themselves.
+ */
+GPUCC_API(void)
+gpuccCompleteCompileFlight
+(
+    struct GPUCC_COMPILE_FLIGHT_TABLE *table,
+    struct GPUCC_HASH128 const          *key,
+    struct GPUCC_COMPILE_FLIGHT        *flight,
+    struct GPUCC_PROGRAM_BYTECODE   *container
+);
+
+/* @summary Wait for the leader of a flight to finish, and attach the shared result to a bytecode container.
+ * @param table The flight table.
+ * @param flight The flight returned by gpuccJoinCompileFlight.
+ * @param container The bytecode container of the waiting request.
+ * If the container's compile is cancellable, the caller leaves the flight when it is cancelled.
+ * @return Non-zero if the result was attached, or zero if the leader could not share its result or the caller was cancelled, in which case the caller must check for cancellation and then compile.
+ */
+GPUCC_API(int32_t)
+gpuccWaitCompileFlight
+(
+    struct GPUCC_COMPILE_FLIGHT_TABLE *table,
+    struct GPUCC_COMPILE_FLIGHT        *flight,
+    struct GPUCC_PROGRAM_BYTECODE   *container
+);
+
+/* @summary Release the shared result referenced by a bytecode container, if any.
+ * This function is called when a bytecode container is reset or deleted.
+ * @param container The bytecode container.
+ */
+GPUCC_API(void)
+gpuccReleaseSharedResult
+(
+    struct GPUCC_PROGRAM_BYTECODE *container
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_FLIGHT_H__ */
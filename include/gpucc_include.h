@@ -0,0 +1,102 @@
+/**
+ * @summary gpucc_include.h: Define the internal interface used to resolve
+ * #include directives. This includes the shared in-memory include cache,
+ * which reads each header once and hands the same immutable copy to every
+ * compile that includes it, and the directive scanner used by backends that
+ * need all headers supplied up front.
+ */
+#ifndef __GPUCC_INCLUDE_H__
+#define __GPUCC_INCLUDE_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   include <atomic>
+#   include <mutex>
+#   include <string>
+#   include <unordered_map>
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#endif
+
+/* @summary Define the maximum nesting depth followed by gpuccCollectIncludes.
+ * Deeper includes are left for the backend to report as missing.
+ */
+#ifndef GPUCC_MAX_INCLUDE_DEPTH
+#define GPUCC_MAX_INCLUDE_DEPTH                                               32
+#endif
+
+/* @summary Define the data associated with a single file held by an include cache.
+ * The record, path and content are stored in a single allocation. The content is immutable once loaded.
+ * A record is freed when the cache drops it (because the file changed) and the last outstanding include result is released.
+ */
+typedef struct GPUCC_INCLUDE_FILE {
+    std::atomic<uint32_t>          RefCount;                                   /* One reference for the cache map, plus one per outstanding include result. */
+    uint64_t                       ModifyTime;                                 /* The modification time of the file at the time it was read. */
+    uint64_t                       FileSize;                                   /* The size of the file at the time it was read. */
+    char                          *Path;                                       /* The nul-terminated resolved path of the file. */
+    char                          *Content;                                    /* The nul-terminated file content. */
+    uint64_t                       ContentSize;                                /* The number of bytes of content, not including the nul. */
+} GPUCC_INCLUDE_FILE;
+
+/* @summary Define the data associated with an include cache.
+ * Lookups take the lock only long enough to find and reference a record; files are read from disk without holding the lock.
+ */
+typedef struct GPUCC_INCLUDE_CACHE {
+    std::mutex                     Lock;                                       /* Protects the Files map. */
+    std::unordered_map<std::string, GPUCC_INCLUDE_FILE*> Files;                /* The loaded files, keyed by resolved path. */
+    char                         **SearchPaths;                                /* An array of SearchPathCount nul-terminated directory paths, each ending in a separator. */
+    uint32_t                       SearchPathCount;                            /* The number of items in the SearchPaths array. */
+} GPUCC_INCLUDE_CACHE;
+
+/* @summary Define the set of headers collected by gpuccCollectIncludes for backends that cannot resolve includes on demand.
+ * Each header is listed once under the name used in the #include directive, which is how such backends match headers.
+ */
+typedef struct GPUCC_INCLUDE_LIST {
+    GPUCC_INCLUDE_RESULT          *Results;                                    /* An array of Count open include results, which must be closed with gpuccReleaseIncludes. */
+    char const                   **Names;                                      /* An array of Count nul-terminated include names, as written in the #include directives. */
+    char const                   **Contents;                                   /* An array of Count pointers to the nul-terminated header contents. */
+    uint32_t                       Count;                                      /* The number of headers in the list. */
+    uint32_t                       Capacity;                                   /* The capacity of the arrays, in items. */
+} GPUCC_INCLUDE_LIST;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Scan program source code for #include directives and resolve each one, recursively, through the include handler of the container's compiler.
+ * The scan is purely lexical, so includes in inactive conditional blocks are also resolved. Directives that cannot be resolved are skipped.
+ * @param container The bytecode container being compiled into.
+ * @param source_code The program source code.
+ * @param source_size The number of bytes of program source code.
+ * @param source_path The path of the source file, or NULL.
+ * @param list The list that receives the headers. The list must be zero-initialized.
+ * @return Non-zero if the scan completed, or zero if memory allocation failed.
+ */
+GPUCC_API(int32_t)
+gpuccCollectIncludes
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const              *source_code,
+    uint64_t                 source_size,
+    char const              *source_path,
+    struct GPUCC_INCLUDE_LIST      *list
+);
+
+/* @summary Close every include result in a list built by gpuccCollectIncludes and free the list storage.
+ * @param container The bytecode container passed to gpuccCollectIncludes.
+ * @param list The list to release. On return, the list is zero-initialized.
+ */
+GPUCC_API(void)
+gpuccReleaseIncludes
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    struct GPUCC_INCLUDE_LIST      *list
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_INCLUDE_H__ */
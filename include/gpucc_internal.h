@@ -43,6 +43,35 @@
     (((GPUCC_PROGRAM_BYTECODE_BASE const*)(_b))->Compiler)
 #endif
 
+/* @summary Retrieve the host allocator used for a compiler.
+ * The caller is responsible for ensuring that _c is non-NULL.
+ * @param _c A pointer to a GPUCC_PROGRAM_COMPILER object.
+ * @return A pointer to the GPUCC_HOST_ALLOCATOR stored in the compiler.
+ */
+#ifndef gpuccQueryCompilerHostAllocator_
+#define gpuccQueryCompilerHostAllocator_(_c)                                   \
+    (&((GPUCC_PROGRAM_COMPILER_BASE*)(_c))->HostAllocator)
+#endif
+
+/* @summary Retrieve the include handler used for a compiler.
+ * The caller is responsible for ensuring that _c is non-NULL.
+ * @param _c A pointer to a GPUCC_PROGRAM_COMPILER object.
+ * @return A pointer to the GPUCC_INCLUDE_HANDLER stored in the compiler. The Resolve field is NULL if no handler was supplied.
+ */
+#ifndef gpuccQueryCompilerIncludeHandler_
+#define gpuccQueryCompilerIncludeHandler_(_c)                                  \
+    (&((GPUCC_PROGRAM_COMPILER_BASE*)(_c))->IncludeHandler)
+#endif
+
+/* @summary Retrieve the host allocator used for a bytecode container.
+ * The caller is responsible for ensuring that _b is non-NULL.
+ * @param _b A pointer to a GPUCC_PROGRAM_BYTECODE object.
+ * @return A pointer to the GPUCC_HOST_ALLOCATOR stored in the compiler that created the container.
+ */
+#ifndef gpuccQueryBytecodeHostAllocator_
+#define gpuccQueryBytecodeHostAllocator_(_b)                                       (&((GPUCC_PROGRAM_COMPILER_BASE*)(((GPUCC_PROGRAM_BYTECODE_BASE const*)(_b))->Compiler))->HostAllocator)
+#endif
+
 /* @summary Define an inlined macro version of gpuccQueryBytecodeEntryPoint.
  * The caller is responsible for ensuring that _b is non-NULL.
  * @param _b A pointer to a GPUCC_PROGRAM_BYTECODE object.
@@ -120,23 +149,60 @@
 struct GPUCC_THREAD_CONTEXT;
 struct GPUCC_PROCESS_CONTEXT;
 
+/* @summary Define a 128-bit hash value. Hash values are used as content-addressed keys for compiled bytecode.
+ */
+typedef struct GPUCC_HASH128 {
+    uint64_t                       Low;                                        /* The low 64 bits of the hash value. */
+    uint64_t                       High;                                       /* The high 64 bits of the hash value. */
+} GPUCC_HASH128;
+
+/* @summary Define the state maintained while computing a 128-bit hash value incrementally.
+ * The hash function is MurmurHash3 (x64, 128-bit), which produces the same value regardless of how the input is split across update calls.
+ */
+typedef struct GPUCC_HASH_STATE {
+    uint64_t                       H1;                                         /* The first half of the running hash state. */
+    uint64_t                       H2;                                         /* The second half of the running hash state. */
+    uint64_t                       TotalSize;                                  /* The total number of bytes supplied to the hash function. */
+    uint32_t                       TailSize;                                   /* The number of bytes of valid data in the Tail buffer. */
+    uint8_t                        Tail[16];                                   /* Storage for input data that does not fill an entire 16-byte block. */
+} GPUCC_HASH_STATE;
+
 /* @summary Define the signatures for the functions that must be provided by each compiler type.
  */
 typedef struct GPUCC_PROGRAM_BYTECODE* (*PFN_CreateBytecode )(struct GPUCC_PROGRAM_COMPILER *);
 typedef struct GPUCC_RESULT            (*PFN_CompileBytecode)(struct GPUCC_PROGRAM_BYTECODE *, char const*, uint64_t, char const*, char const*);
 typedef void                           (*PFN_DeleteBytecode )(struct GPUCC_PROGRAM_BYTECODE *);
+typedef void                           (*PFN_ResetBytecode  )(struct GPUCC_PROGRAM_BYTECODE *);
 typedef void                           (*PFN_CleanupCompiler)(struct GPUCC_PROGRAM_COMPILER *);
 
+/* @summary Define the signatures for the optional functions that may be provided by a compiler type. A NULL pointer indicates that the compiler type does not support the operation.
+ * PFN_RecycleBackend destroys and recreates the backend objects of a compiler, returning non-zero on success. No compilation may be running on the compiler when it is called. On failure, the existing backend objects must be retained.
+ * PFN_QueryBackendMemory retrieves the memory usage of the backend objects of a compiler, returning non-zero if the values were retrieved.
+ */
+typedef int32_t                        (*PFN_RecycleBackend    )(struct GPUCC_PROGRAM_COMPILER *);
+typedef int32_t                        (*PFN_QueryBackendMemory)(struct GPUCC_PROGRAM_COMPILER *, struct GPUCC_BACKEND_MEMORY_STATS *);
+
 /* @summary All GPU program compiler implementations must start with an instance 
  * of GPUCC_PROGRAM_COMPILER_BASE, so that the underying type can be retrieved.
  */
 typedef struct GPUCC_PROGRAM_COMPILER_BASE {
     PFN_CreateBytecode             CreateBytecode;                             /* Function used to create a new bytecode container object. */
     PFN_DeleteBytecode             DeleteBytecode;                             /* Function used to delete a bytecode container object. */
+    PFN_ResetBytecode              ResetBytecode;                              /* Function used to release the compilation results held by a bytecode container object, retaining any reusable buffers. */
     PFN_CompileBytecode            CompileBytecode;                            /* Function used to compile GPU program source code into intermediate bytecode. */
     PFN_CleanupCompiler            CleanupCompiler;                            /* Function used to cleanup internal compiler resources prior to freeing memory for the compiler instance. */
+    PFN_RecycleBackend             RecycleBackend;                             /* Function used to destroy and recreate the backend objects of the compiler, or NULL if the compiler type does not support recycling. */
+    PFN_QueryBackendMemory         QueryBackendMemory;                         /* Function used to retrieve the amount of memory allocated by the backend objects, or NULL if the compiler type does not track backend memory. */
     int32_t                        CompilerType;                               /* One of the values of the GPUCC_COMPILER_TYPE enumeration specifying the compiler type. */
     int32_t                        BytecodeType;                               /* One of the values of the GPUCC_BYTECODE_TYPE enumeration specifying the type of bytecode generated by the compiler. */
+    uint64_t                       BackendVersion;                             /* A value identifying the backend module that generates bytecode, computed by gpuccQueryModuleVersion, or zero if the version is not known. */
+    GPUCC_HASH128                  ConfigHash;                                 /* A hash of the compiler configuration and backend version, computed by gpuccComputeCompilerConfigHash. */
+    GPUCC_HOST_ALLOCATOR           HostAllocator;                              /* The allocator used for the compiler record and all memory owned by its bytecode containers. */
+    GPUCC_INCLUDE_HANDLER          IncludeHandler;                             /* The handler used to resolve #include directives. The Resolve field is NULL if no handler was specified. */
+    struct GPUCC_WORKER_PROCESS_POOL *WorkerPool;                              /* The pool of worker processes that run the backend, or NULL if the backend runs in the calling process. */
+    struct GPUCC_WORKER_CONFIG    *WorkerConfig;                               /* The compiler configuration serialized by gpuccInitWorkerConfig for transmission to a worker process, or NULL. */
+    struct GPUCC_RECYCLE_STATE    *RecycleState;                               /* The state of the backend recycling policy, allocated by gpuccInitRecyclePolicy, or NULL if the backend objects are never recycled in the calling process. */
+    struct GPUCC_LATENCY_HISTOGRAM *LatencyHistogram;                          /* The histogram shared by compilers with the same type and target profile, set by gpuccInitLatencyHistogram, or NULL. */
 } GPUCC_PROGRAM_COMPILER_BASE;
 
 /* @summary All GPU program bytecode implementations must start with an instance
@@ -148,10 +214,32 @@ typedef struct GPUCC_PROGRAM_BYTECODE_BASE {
     struct GPUCC_RESULT            CompileResult;                              /* A GPUCC_RESULT specifying the results of the compilation. */
     char                          *EntryPoint;                                 /* A nul-terminated UTF-8 string specifying the program entry point, or NULL if no compilation has been attempted yet. */
     char                          *SourcePath;                                 /* A nul-terminated UTF-8 string specifying the source file path, if any, or NULL if no compilation has been attempted yet. */
+    char                          *StringBuffer;                               /* The buffer holding the EntryPoint and SourcePath strings. The buffer is retained when the container is reset. */
+    size_t                         StringBufferSize;                           /* The capacity of the StringBuffer, in bytes. */
     char                          *LogBuffer;                                  /* A nul-terminated UTF-8 string containing any output from the compilation process. */
     uint64_t                       LogBufferSize;                              /* The number of bytes of data in the log buffer, including the nul. */
     uint64_t                       BytecodeSize;                               /* The buffer containing the compiled bytecode. */
     uint8_t                       *BytecodeBuffer;                             /* The number of bytes of compiled bytecode. */
+    uint8_t                       *CacheBuffer;                                /* If the bytecode was loaded from the bytecode cache, a single buffer holding the bytecode and log. Otherwise, NULL. */
+    struct GPUCC_SHARED_RESULT    *SharedResult;                               /* If the bytecode was compiled by a concurrent identical request, a reference to its result, which holds the bytecode and log. Otherwise, NULL. */
+    char                          *DependencyBuffer;                           /* The nul-terminated resolved paths of the files opened through the include handler, packed end-to-end. The buffer is retained when the container is reset. */
+    uint32_t                      *DependencyOffsets;                          /* An array of DependencyCount byte offsets of each path within DependencyBuffer. The array is retained when the container is reset. */
+    GPUCC_HASH128                 *DependencyHashes;                           /* An array of DependencyCount content hashes of the bytes served to the backend for each file. The array is retained when the container is reset. */
+    size_t                         DependencyBufferSize;                       /* The number of bytes of DependencyBuffer in use. */
+    size_t                         DependencyBufferCapacity;                   /* The capacity of DependencyBuffer, in bytes. */
+    uint32_t                       DependencyCount;                            /* The number of files recorded in DependencyOffsets. */
+    uint32_t                       DependencyCapacity;                         /* The capacity of the DependencyOffsets, DependencyHashes and DependencyRequestTypes arrays, in items. */
+    char                          *DependencyRequestBuffer;                    /* For each recorded file, the include path and requesting path that were passed to the include handler, each nul-terminated and packed end-to-end. An empty requesting path stands for NULL. The buffer is retained when the container is reset. */
+    int32_t                       *DependencyRequestTypes;                     /* An array of DependencyCount GPUCC_INCLUDE_TYPE values that were passed to the include handler for each file. The array is retained when the container is reset. */
+    size_t                         DependencyRequestBufferSize;                /* The number of bytes of DependencyRequestBuffer in use. */
+    size_t                         DependencyRequestBufferCapacity;            /* The capacity of DependencyRequestBuffer, in bytes. */
+    uint64_t                       PublishSerial;                              /* The serial number assigned when the container was last published to a GPUCC_PUBLISHED_PROGRAM, or zero. */
+    struct GPUCC_CANCEL_STATE     *CancelState;                                /* The cancellation state of the job compiling into the container, or NULL. Set only while the compile is running. */
+    void                          *WorkerResult;                               /* If the bytecode was compiled by a worker process, the mapping of the shared memory holding the bytecode and log. Otherwise, NULL. */
+    uint64_t                       WorkerResultSize;                           /* The size of the WorkerResult mapping, in bytes. */
+    GPUCC_BACKEND_MEMORY_STATS     BackendMemory;                              /* The backend memory usage of the most recent compilation, recorded by compiler types that track backend memory. */
+    GPUCC_COMPILE_TIMINGS          Timings;                                    /* The time spent in each phase of the most recent compilation. See gpuccRecordCompilePhase. */
+    int32_t                        BackendInvoked;                             /* Non-zero if the most recent compilation ran the backend, rather than taking its result from the bytecode cache or an identical compilation. */
 } GPUCC_PROGRAM_BYTECODE_BASE;
 
 /* @summary Define a simple structure for returning information about a string 
@@ -231,6 +319,298 @@ gpuccBytecodeContainerIsEmpty
     struct GPUCC_PROGRAM_BYTECODE *bytecode
 );
 
+/* @summary Compile program source code into a bytecode container, consulting the bytecode cache if it is enabled.
+ * The caller must have validated the arguments and called gpuccSetProgramEntryPoint.
+ * This function sets the CompileResult field of the container.
+ * @param container The destination bytecode container.
+ * @param source_code Pointer to a buffer containing the program source code.
+ * @param source_size The number of bytes of program source code.
+ * @return The result of the compilation.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccExecuteCompile
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size
+);
+
+/* @summary Add the time elapsed since a phase of a compilation started to the timings of a bytecode container.
+ * A phase may be recorded several times during one compilation, in which case the times are summed.
+ * @param container The bytecode container being compiled into.
+ * @param phase One of the values of the GPUCC_COMPILE_PHASE enumeration.
+ * @param start The value returned by gpuccQueryClockNanoseconds when the phase started.
+ * @return The current value returned by gpuccQueryClockNanoseconds, which may be used as the start time of the next phase.
+ */
+GPUCC_API(uint64_t)
+gpuccRecordCompilePhase
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    int32_t                          phase,
+    uint64_t                         start
+);
+
+/* @summary Initialize the state used to compute a 128-bit hash value incrementally.
+ * @param state The hash state to initialize.
+ * @param seed A seed value. Different seeds produce unrelated hash values for the same input.
+ */
+GPUCC_API(void)
+gpuccHashInit
+(
+    struct GPUCC_HASH_STATE *state, 
+    uint64_t                  seed
+);
+
+/* @summary Supply additional data to an incremental hash computation.
+ * @param state The hash state, initialized by gpuccHashInit.
+ * @param data The data to hash. This value may be NULL if size is zero.
+ * @param size The number of bytes of data to hash.
+ */
+GPUCC_API(void)
+gpuccHashUpdate
+(
+    struct GPUCC_HASH_STATE *state, 
+    void const               *data, 
+    size_t                    size
+);
+
+/* @summary Supply a nul-terminated string to an incremental hash computation.
+ * The nul terminator is included, so that adjacent strings cannot alias each other. A NULL string hashes the same as an empty string.
+ * @param state The hash state, initialized by gpuccHashInit.
+ * @param str The nul-terminated string to hash.
+ */
+GPUCC_API(void)
+gpuccHashUpdateString
+(
+    struct GPUCC_HASH_STATE *state, 
+    char const                *str
+);
+
+/* @summary Complete an incremental hash computation and retrieve the resulting hash value.
+ * @param state The hash state. The state should not be updated after this call.
+ * @return The 128-bit hash value.
+ */
+GPUCC_API(struct GPUCC_HASH128)
+gpuccHashFinal
+(
+    struct GPUCC_HASH_STATE *state
+);
+
+/* @summary Initialize a host allocator from the value supplied by the application.
+ * If the application did not supply an allocator, the C runtime heap is used.
+ * @param dst The allocator to initialize.
+ * @param src The allocator supplied in GPUCC_PROGRAM_COMPILER_INIT::HostAllocator, or NULL.
+ * @return Non-zero if the allocator is valid, or zero if src specifies some, but not all, of the callbacks.
+ */
+GPUCC_API(int32_t)
+gpuccInitHostAllocator
+(
+    struct GPUCC_HOST_ALLOCATOR       *dst, 
+    struct GPUCC_HOST_ALLOCATOR const *src
+);
+
+/* @summary Allocate a block of host memory.
+ * @param alloc The allocator to use.
+ * @param size The number of bytes to allocate.
+ * @param alignment The required alignment of the returned address, in bytes. This must be a power of two.
+ * @return A pointer to the memory block, or NULL if the allocation failed.
+ */
+GPUCC_API(void*)
+gpuccHostAlloc
+(
+    struct GPUCC_HOST_ALLOCATOR const *alloc, 
+    size_t                              size, 
+    size_t                         alignment
+);
+
+/* @summary Resize a block of host memory, preserving its contents.
+ * @param alloc The allocator used to allocate the existing block.
+ * @param address The existing memory block, or NULL to allocate a new block.
+ * @param size The new size of the block, in bytes.
+ * @param alignment The required alignment of the returned address, in bytes. This must match the alignment of the existing block.
+ * @return A pointer to the resized memory block, or NULL if the allocation failed, in which case the existing block is unchanged.
+ */
+GPUCC_API(void*)
+gpuccHostRealloc
+(
+    struct GPUCC_HOST_ALLOCATOR const *alloc, 
+    void                            *address, 
+    size_t                              size, 
+    size_t                         alignment
+);
+
+/* @summary Return a block of host memory to the allocator.
+ * @param alloc The allocator used to allocate the block.
+ * @param address The memory block to free. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccHostFree
+(
+    struct GPUCC_HOST_ALLOCATOR const *alloc, 
+    void                            *address
+);
+
+/* @summary Copy the include handler supplied by the application into a compiler.
+ * This function is called after the backend has created the compiler.
+ * @param compiler The compiler returned by the backend.
+ * @param handler The handler supplied in GPUCC_PROGRAM_COMPILER_INIT::IncludeHandler, or NULL.
+ */
+GPUCC_API(void)
+gpuccInitIncludeHandler
+(
+    struct GPUCC_PROGRAM_COMPILER         *compiler, 
+    struct GPUCC_INCLUDE_HANDLER const     *handler
+);
+
+/* @summary Resolve an #include directive encountered while compiling into a bytecode container, using the include handler of the compiler that created the container.
+ * Every successful call must be matched by a call to gpuccCloseInclude.
+ * @param container The bytecode container being compiled into.
+ * @param include_path A nul-terminated UTF-8 string specifying the path as written in the #include directive.
+ * @param requesting_path A nul-terminated UTF-8 string specifying the path of the including file, or NULL if it is not known.
+ * @param include_type One of the values of the GPUCC_INCLUDE_TYPE enumeration.
+ * @param o_result On return, stores the contents of the included file.
+ * @return Non-zero if the include was resolved, or zero if the compiler has no include handler or the file could not be found.
+ */
+GPUCC_API(int32_t)
+gpuccOpenInclude
+(
+    struct GPUCC_PROGRAM_BYTECODE *container, 
+    char const               *include_path, 
+    char const            *requesting_path, 
+    int32_t                   include_type, 
+    struct GPUCC_INCLUDE_RESULT  *o_result
+);
+
+/* @summary Release an include result returned by a successful call to gpuccOpenInclude.
+ * @param container The bytecode container passed to gpuccOpenInclude.
+ * @param result The include result to release.
+ */
+GPUCC_API(void)
+gpuccCloseInclude
+(
+    struct GPUCC_PROGRAM_BYTECODE *container, 
+    struct GPUCC_INCLUDE_RESULT      *result
+);
+
+/* @summary Retrieve the modification time and size of a file.
+ * @param path A nul-terminated UTF-8 string specifying the path of the file.
+ * @param o_modify_time On return, stores a platform-specific value that changes whenever the file is modified.
+ * @param o_file_size On return, stores the size of the file, in bytes.
+ * @return Non-zero if path specifies an existing regular file, or zero otherwise.
+ */
+GPUCC_API(int32_t)
+gpuccQueryFileInfo
+(
+    char const            *path, 
+    uint64_t     *o_modify_time, 
+    uint64_t       *o_file_size
+);
+
+/* @summary Determine whether a path is absolute, rather than relative to some directory.
+ * @param path A nul-terminated UTF-8 string specifying the path.
+ * @return Non-zero if the path is absolute.
+ */
+GPUCC_API(int32_t)
+gpuccPathIsAbsolute
+(
+    char const *path
+);
+
+/* @summary Determine the length of the directory portion of a path.
+ * @param path A nul-terminated UTF-8 string specifying the path of a file.
+ * @return The number of bytes up to and including the last path separator, or zero if the path has no directory portion.
+ */
+GPUCC_API(size_t)
+gpuccPathDirectoryLength
+(
+    char const *path
+);
+
+/* @summary Retrieve the CPU time consumed by the calling thread.
+ * @return The CPU time consumed by the calling thread, in nanoseconds. The resolution is platform-dependent.
+ */
+GPUCC_API(uint64_t)
+gpuccQueryThreadCpuNanoseconds
+(
+    void
+);
+
+/* @summary Retrieve the current value of a monotonic clock, for measuring elapsed time.
+ * @return The current time, in nanoseconds, relative to an unspecified starting point.
+ */
+GPUCC_API(uint64_t)
+gpuccQueryClockNanoseconds
+(
+    void
+);
+
+/* @summary Retrieve the operating system identifier of the calling thread.
+ * @return The thread identifier.
+ */
+GPUCC_API(uint64_t)
+gpuccQueryCurrentThreadId
+(
+    void
+);
+
+/* @summary Retrieve the operating system identifier of the calling process.
+ * @return The process identifier.
+ */
+GPUCC_API(uint64_t)
+gpuccQueryCurrentProcessId
+(
+    void
+);
+
+/* @summary Compute a version identifier for a dynamically loaded compiler backend from the module file itself.
+ * The identifier combines the version reported by the backend API with the path, size and modification time of the module containing the given address, so that replacing the library changes the identifier even if the API version does not.
+ * @param address The address of any function exported by the backend module.
+ * @param api_version The version reported by the backend API, or zero if the backend reports none.
+ * @return The version identifier. If the module file cannot be identified, a hash of api_version alone is returned.
+ */
+GPUCC_API(uint64_t)
+gpuccQueryModuleVersion
+(
+    void const   *address,
+    uint64_t  api_version
+);
+
+/* @summary Change the operating system scheduling priority of the calling thread.
+ * @param priority One of the values of the GPUCC_WORKER_THREAD_PRIORITY enumeration.
+ * @return Non-zero if the priority was changed. Raising the priority back to normal may require privileges the process does not have.
+ */
+GPUCC_API(int32_t)
+gpuccSetCurrentThreadPriority
+(
+    int32_t priority
+);
+
+/* @summary Compute the hash of the configuration used to create a compiler and store it in the ConfigHash field.
+ * The hash covers the compiler and bytecode types, backend version, target profile and runtime, compiler flags and preprocessor defines.
+ * This function must be called after the backend has initialized the GPUCC_PROGRAM_COMPILER_BASE fields.
+ * @param compiler The compiler returned by the backend.
+ * @param config The configuration used to create the compiler.
+ */
+GPUCC_API(void)
+gpuccComputeCompilerConfigHash
+(
+    struct GPUCC_PROGRAM_COMPILER      *compiler, 
+    struct GPUCC_PROGRAM_COMPILER_INIT   *config
+);
+
+/* @summary Perform the setup shared by every compiler once its backend has created it: the include handler, configuration hash, latency histogram, worker configuration and recycling policy.
+ * gpuccCreateCompiler calls this function for every backend. Stand-in backends used by tests and benchmarks must call it too, so that they exercise the same path.
+ * @param compiler The compiler returned by the backend, whose GPUCC_PROGRAM_COMPILER_BASE fields have been initialized.
+ * @param config The configuration used to create the compiler.
+ * @return The compiler, or NULL if memory allocation failed, in which case the compiler has been deleted.
+ */
+GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
+gpuccInitCompilerCommon
+(
+    struct GPUCC_PROGRAM_COMPILER      *compiler,
+    struct GPUCC_PROGRAM_COMPILER_INIT   *config
+);
+
 #ifdef __cplusplus
 }; /* extern "C" */
 #endif
@@ -246,7 +626,7 @@ gpuccBytecodeContainerIsEmpty
 #elif defined(_WIN32) || defined(_WIN64)
 #   include "win32/gpucc_internal_win32.h"
 #elif defined(__linux__) || defined(__gnu_linux__)
-#   error No GpuCC implementation for Linux (yet).
+#   include "linux/gpucc_internal_linux.h"
 #else
 #   error No GpuCC implementation for your platform (yet).
 #endif
@@ -0,0 +1,84 @@
+/**
+ * @summary gpucc_permute.h: Define the internal data used to expand a
+ * preprocessor define space into permutations, compile each permutation on
+ * the worker pool, and store the deduplicated results in a permutation table.
+ */
+#ifndef __GPUCC_PERMUTE_H__
+#define __GPUCC_PERMUTE_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#   ifndef __GPUCC_ASYNC_H__
+#       include "gpucc_async.h"
+#   endif
+#endif
+
+/* @summary Define the alignment, in bytes, of each bytecode blob stored in a permutation table.
+ */
+#ifndef GPUCC_PERMUTATION_BLOB_ALIGNMENT
+#define GPUCC_PERMUTATION_BLOB_ALIGNMENT                                      16
+#endif
+
+/* @summary Define the data stored for a single permutation in a permutation table.
+ * The value indices for the permutation are stored separately, at ValueIndices + (index * AxisCount) in the table.
+ */
+typedef struct GPUCC_PERMUTATION_RECORD {
+    uint64_t                       Key;                                        /* The mixed-radix permutation key. */
+    char const                    *LogBuffer;                                  /* The compiler log if the permutation failed to compile, or NULL. */
+    GPUCC_RESULT                   CompileResult;                              /* The result of compiling the permutation. */
+    uint32_t                       BlobIndex;                                  /* The index of the bytecode blob, or GPUCC_PERMUTATION_NOT_FOUND. */
+} GPUCC_PERMUTATION_RECORD;
+
+/* @summary Define the location and size of a single distinct bytecode blob in a permutation table.
+ */
+typedef struct GPUCC_PERMUTATION_BLOB {
+    uint8_t const                 *Bytecode;                                   /* The bytecode, aligned to GPUCC_PERMUTATION_BLOB_ALIGNMENT. */
+    uint64_t                       BytecodeSize;                               /* The number of bytes of bytecode. */
+} GPUCC_PERMUTATION_BLOB;
+
+/* @summary Define the data associated with a permutation table.
+ * The table, its records, blobs, value indices, bytecode and logs are stored in a single allocation made from the BaseConfig host allocator.
+ */
+typedef struct GPUCC_PERMUTATION_TABLE {
+    GPUCC_HOST_ALLOCATOR           HostAllocator;                              /* The allocator used to allocate the table. */
+    GPUCC_PERMUTATION_RECORD      *Records;                                    /* An array of PermutationCount records, sorted by key. */
+    GPUCC_PERMUTATION_BLOB        *Blobs;                                      /* An array of BlobCount distinct bytecode blobs. */
+    uint32_t                      *ValueIndices;                               /* An array of PermutationCount * AxisCount value indices. */
+    uint32_t                       PermutationCount;                           /* The number of items in the Records array. */
+    uint32_t                       BlobCount;                                  /* The number of items in the Blobs array. */
+    uint32_t                       AxisCount;                                  /* The number of axes in the permutation space. */
+} GPUCC_PERMUTATION_TABLE;
+
+/* @summary Define the state shared by all of the permutations compiled by a single call to gpuccCompilePermutations.
+ * The structure lives on the stack of the calling thread, which does not return until every permutation has completed.
+ */
+typedef struct GPUCC_PERMUTATION_RUN {
+    GPUCC_COMPILE_BATCH            Batch;                                      /* Tracks completion of the permutation tasks. */
+    GPUCC_PROGRAM_COMPILER_INIT const *BaseConfig;                             /* The configuration shared by all permutations. */
+    GPUCC_HOST_ALLOCATOR const    *HostAllocator;                              /* The allocator used for the bytecode and log copies held by each task. */
+    char const                    *SourceCode;                                 /* The program source code. */
+    uint64_t                       SourceSize;                                 /* The number of bytes of program source code. */
+    char const                    *SourcePath;                                 /* The source path, or NULL. */
+    char const                    *EntryPoint;                                 /* The program entry point. */
+} GPUCC_PERMUTATION_RUN;
+
+/* @summary Define the task used to compile a single permutation.
+ * On completion, the task owns a copy of the bytecode (on success) or of the compiler log (on failure), since the transient compiler and container are deleted before the task completes.
+ */
+typedef struct GPUCC_PERMUTATION_TASK {
+    GPUCC_COMPILE_TASK             Task;                                       /* The task header. This must be the first field. */
+    GPUCC_PERMUTATION_RUN         *Run;                                        /* The run the task belongs to. */
+    char const                   **DefineSymbols;                              /* The preprocessor symbols for the permutation, including the BaseConfig symbols. */
+    char const                   **DefineValues;                               /* The preprocessor values for the permutation, including the BaseConfig values. */
+    uint8_t                       *Output;                                     /* The bytecode or log copy, allocated from the run host allocator, or NULL. */
+    uint64_t                       OutputSize;                                 /* The number of bytes of data in the Output buffer. */
+    GPUCC_HASH128                  OutputHash;                                 /* The hash of the bytecode. Valid only if the compilation succeeded. */
+    GPUCC_RESULT                   Result;                                     /* The result of compiling the permutation. */
+    uint32_t                       DefineCount;                                /* The number of items in the DefineSymbols and DefineValues arrays. */
+} GPUCC_PERMUTATION_TASK;
+
+#endif /* __GPUCC_PERMUTE_H__ */
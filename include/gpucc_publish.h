@@ -0,0 +1,97 @@
+/**
+ * @summary gpucc_publish.h: Define the internal interface to published
+ * programs, which let render threads read the current bytecode of a program
+ * while a background recompile replaces it. Replaced bytecode containers are
+ * reclaimed using epochs: a container retired in epoch N is freed once every
+ * thread reading a published program entered its read in an epoch after N.
+ */
+#ifndef __GPUCC_PUBLISH_H__
+#define __GPUCC_PUBLISH_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   include <atomic>
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#endif
+
+/* @summary Define the value stored in GPUCC_EPOCH_RECORD::Epoch while the owning thread is not reading any published program.
+ */
+#ifndef GPUCC_EPOCH_INACTIVE
+#define GPUCC_EPOCH_INACTIVE                                     UINT64_MAX
+#endif
+
+/* @summary Identify a specific publication of a bytecode container.
+ * A container address alone is not sufficient, since a freed container's memory may be reused for a container published later.
+ */
+typedef struct GPUCC_PUBLISH_TICKET {
+    struct GPUCC_PROGRAM_BYTECODE *Container;                                  /* The published container. */
+    uint64_t                       Serial;                                     /* The serial number assigned to the container when it was published. */
+} GPUCC_PUBLISH_TICKET;
+
+/* @summary Define the per-thread record that announces the epoch in which the thread began reading published programs.
+ * Records are linked into a process-wide list the first time a thread acquires a published program. The list only grows;
+ * when a thread exits, its record is marked unused and is taken over by the next thread that needs one.
+ */
+typedef struct GPUCC_EPOCH_RECORD {
+    std::atomic<uint64_t>          Epoch;                                      /* The global epoch observed by the outermost acquire, or GPUCC_EPOCH_INACTIVE. */
+    std::atomic<int32_t>           InUse;                                      /* Non-zero while the record is owned by a thread. */
+    uint32_t                       Depth;                                      /* The number of acquires not yet released. Accessed only by the owning thread. */
+    struct GPUCC_EPOCH_RECORD     *Next;                                       /* The next record in the process-wide list. Immutable once the record is linked. */
+} GPUCC_EPOCH_RECORD;
+
+/* @summary Define a bytecode container that has been replaced, but may still be in use by a reader.
+ */
+typedef struct GPUCC_RETIRED_BYTECODE {
+    struct GPUCC_PROGRAM_BYTECODE *Container;                                  /* The replaced container. */
+    uint64_t                       RetireEpoch;                                /* The global epoch at the time the container was replaced. */
+    struct GPUCC_RETIRED_BYTECODE *Next;                                       /* The next entry in the retired list. */
+} GPUCC_RETIRED_BYTECODE;
+
+/* @summary Define the data associated with a published program.
+ * Readers touch only the Current field. Publishers swap Current and push the previous container onto the Retired list, both without locks.
+ */
+typedef struct GPUCC_PUBLISHED_PROGRAM {
+    std::atomic<struct GPUCC_PROGRAM_BYTECODE*> Current;                       /* The currently published container, or NULL. */
+    std::atomic<GPUCC_RETIRED_BYTECODE*>        Retired;                       /* The list of replaced containers not yet freed. */
+    std::atomic<int32_t>                        ReclaimFlag;                   /* Non-zero while a thread is freeing retired containers. Other publishers skip reclamation rather than wait. */
+} GPUCC_PUBLISHED_PROGRAM;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Return an epoch record to the process-wide list when the thread that owns it exits.
+ * This function is called from the platform thread context destructor.
+ * @param record The record referenced by the thread context. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccReleaseEpochRecord
+(
+    struct GPUCC_EPOCH_RECORD *record
+);
+
+/* @summary Publish a bytecode container, optionally only if a given publication is still current.
+ * @param program The published program to update.
+ * @param bytecode The bytecode container to publish, or NULL.
+ * @param expected The publication that must still be current for the replacement to occur, or NULL to replace unconditionally.
+ * @param o_ticket If non-NULL, on success stores the publication of bytecode.
+ * @return Non-zero if the container was published, in which case ownership passes to the published program.
+ * Zero if the expected publication had been replaced or memory allocation failed, in which case ownership remains with the caller.
+ */
+GPUCC_API(int32_t)
+gpuccReplacePublishedBytecode
+(
+    struct GPUCC_PUBLISHED_PROGRAM   *program,
+    struct GPUCC_PROGRAM_BYTECODE   *bytecode,
+    struct GPUCC_PUBLISH_TICKET const *expected,
+    struct GPUCC_PUBLISH_TICKET      *o_ticket
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_PUBLISH_H__ */
@@ -0,0 +1,87 @@
+/**
+ * @summary gpucc_recycle.h: Define the internal interface to the backend
+ * recycling policy, which periodically destroys and recreates the backend
+ * objects of a long-lived compiler so that memory retained by the backend
+ * between compilations cannot grow without bound. The compiler configuration
+ * held by the library is not affected by recycling.
+ */
+#ifndef __GPUCC_RECYCLE_H__
+#define __GPUCC_RECYCLE_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   include <condition_variable>
+#   include <mutex>
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#endif
+
+/* @summary Define the state of the recycling policy for a single compiler.
+ * Backend objects are shared by all threads compiling with the compiler, so once a limit is reached, new compilations wait until the running compilations have finished and the last of them has recycled the backend.
+ */
+typedef struct GPUCC_RECYCLE_STATE {
+    std::mutex                     Lock;                                       /* Protects all of the remaining fields. */
+    std::condition_variable        IdleSignal;                                 /* Signaled when a pending recycle has completed. */
+    uint64_t                       MemoryLimit;                                /* The growth in backend memory, in bytes, that triggers a recycle, or zero. */
+    uint64_t                       MemoryBaseline;                             /* The backend memory usage, in bytes, at the time the backend objects were last created. */
+    uint32_t                       CompileLimit;                               /* The number of compilations that triggers a recycle, or zero. */
+    uint32_t                       CompileCount;                               /* The number of compilations completed since the backend objects were last created. */
+    uint32_t                       ActiveCount;                                /* The number of compilations currently running in the backend. */
+    uint32_t                       RecyclePending;                             /* Non-zero if a limit has been reached and the backend will be recycled once ActiveCount reaches zero. */
+} GPUCC_RECYCLE_STATE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Initialize the recycling policy of a new compiler.
+ * No state is allocated if neither limit is set, the compiler type does not support recycling, or the backend runs in worker processes, which apply the limits themselves.
+ * This function must be called after gpuccInitWorkerConfig.
+ * @param compiler The compiler being created.
+ * @param config The configuration passed to gpuccCreateCompiler.
+ * @return Non-zero if the policy was initialized, or zero if memory allocation failed.
+ */
+GPUCC_API(int32_t)
+gpuccInitRecyclePolicy
+(
+    struct GPUCC_PROGRAM_COMPILER      *compiler,
+    struct GPUCC_PROGRAM_COMPILER_INIT   *config
+);
+
+/* @summary Free the recycling policy state of a compiler, if any.
+ * This function is called when a compiler is deleted.
+ * @param compiler The compiler.
+ */
+GPUCC_API(void)
+gpuccReleaseRecyclePolicy
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+);
+
+/* @summary Register the start of a compilation in the backend of a compiler.
+ * If a recycle is pending, the calling thread blocks until it has completed.
+ * @param compiler The compiler.
+ */
+GPUCC_API(void)
+gpuccBeginBackendCompile
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+);
+
+/* @summary Register the end of a compilation in the backend of a compiler.
+ * If a limit has been reached and no other compilation is running, the backend objects are recycled before the function returns.
+ * @param compiler The compiler.
+ */
+GPUCC_API(void)
+gpuccEndBackendCompile
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_RECYCLE_H__ */
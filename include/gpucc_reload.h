@@ -0,0 +1,140 @@
+/**
+ * @summary gpucc_reload.h: Define the internal interface to the reload service,
+ * which watches the files read by a set of programs and recompiles affected
+ * programs in the background when those files change, and to the
+ * platform-specific directory watcher it is built on.
+ */
+#ifndef __GPUCC_RELOAD_H__
+#define __GPUCC_RELOAD_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   include <mutex>
+#   include <string>
+#   include <thread>
+#   include <unordered_map>
+#   include <unordered_set>
+#   include <vector>
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#   ifndef __GPUCC_ASYNC_H__
+#       include "gpucc_async.h"
+#   endif
+#endif
+
+/* Forward-declare the platform-specific directory watcher type. */
+struct GPUCC_FILE_WATCHER;
+
+/* @summary Define the data associated with a single program registered with a reload service.
+ */
+typedef struct GPUCC_RELOAD_PROGRAM {
+    struct GPUCC_PROGRAM_COMPILER *Compiler;                                   /* The compiler used to compile the program. Owned by the application. */
+    std::string                    SourcePath;                                 /* The path of the source file, as supplied by the application. */
+    std::string                    EntryPoint;                                 /* The program entry point. */
+    std::vector<std::string>       Files;                                      /* The source file followed by every file read by the most recent compile. */
+    bool                           Dirty;                                      /* Set to true if the program must be compiled on the next pass of the service thread. */
+} GPUCC_RELOAD_PROGRAM;
+
+/* @summary Define the data associated with a reload service.
+ * The service thread spends most of its time blocked in gpuccFileWatcherWait. Only the service thread touches the watcher, other than to wake it.
+ * Each pass compiles every dirty program as one batch on the compile pool, then delivers the results in order, holding PassLock throughout.
+ */
+typedef struct GPUCC_RELOAD_SERVICE {
+    std::mutex                     Lock;                                       /* Protects the Programs, NextProgramId and ShutdownFlag fields. Never held while compiling or invoking the callback. */
+    std::mutex                     PassLock;                                   /* Held by the service thread while compiling and delivering results, so that removing a program can wait for its compiler to go idle. */
+    std::unordered_map<uint32_t, GPUCC_RELOAD_PROGRAM> Programs;               /* The registered programs, keyed by program identifier. */
+    std::unordered_set<std::string> WatchedDirectories;                        /* The directories passed to the watcher, less those it has since dropped. Accessed only by the service thread. */
+    std::unordered_set<std::string> LostDirectories;                           /* The directories the watcher dropped because they were deleted, which are polled for and added again once they exist. Accessed only by the service thread. */
+    std::thread                    Thread;                                     /* The service thread. */
+    struct GPUCC_FILE_WATCHER     *Watcher;                                    /* The platform directory watcher. */
+    PFN_GpuCC_ProgramReloaded      Callback;                                   /* The function invoked each time a program has been compiled. */
+    void                          *UserData;                                   /* Opaque data passed through to the callback. */
+    uint32_t                       DebounceMilliseconds;                       /* The time to wait after the most recent change before recompiling. */
+    uint32_t                       NextProgramId;                              /* The identifier assigned to the next program registered. */
+    bool                           ShutdownFlag;                               /* Set to true when the service is being deleted. */
+} GPUCC_RELOAD_SERVICE;
+
+/* @summary Define the task used to compile a single program during a pass of the reload service thread.
+ */
+typedef struct GPUCC_RELOAD_TASK {
+    GPUCC_COMPILE_TASK             Task;                                       /* The task header. This must be the first field. */
+    GPUCC_COMPILE_BATCH           *Batch;                                      /* The batch the task belongs to. */
+    struct GPUCC_PROGRAM_COMPILER *Compiler;                                   /* The compiler used to compile the program. */
+    std::string                    SourcePath;                                 /* The path of the source file. */
+    std::string                    EntryPoint;                                 /* The program entry point. */
+    std::vector<std::string>       Files;                                      /* On completion, the source file followed by every file read by the compile. */
+    struct GPUCC_PROGRAM_BYTECODE *Container;                                  /* On completion, the container holding the compile results, or NULL. */
+    GPUCC_RESULT                   Result;                                     /* On completion, the result of the compile. */
+    uint32_t                       ProgramId;                                  /* The identifier of the program being compiled. */
+} GPUCC_RELOAD_TASK;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Create a directory watcher. Directories are watched non-recursively.
+ * @return A pointer to the watcher, or NULL if the platform notification facility could not be initialized.
+ */
+GPUCC_API(struct GPUCC_FILE_WATCHER*)
+gpuccCreateFileWatcher
+(
+    void
+);
+
+/* @summary Stop watching all directories and free the resources associated with a directory watcher.
+ * @param watcher The watcher to delete. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccDeleteFileWatcher
+(
+    struct GPUCC_FILE_WATCHER *watcher
+);
+
+/* @summary Begin watching a directory for changes to the files it contains.
+ * The same directory may be added under several spellings. Changes are then reported once per spelling.
+ * @param watcher The watcher returned by gpuccCreateFileWatcher.
+ * @param directory A nul-terminated UTF-8 string specifying the directory, ending in a path separator, or an empty string for the current directory.
+ * @return Non-zero if the directory is being watched.
+ */
+GPUCC_API(int32_t)
+gpuccFileWatcherAddDirectory
+(
+    struct GPUCC_FILE_WATCHER *watcher,
+    char const              *directory
+);
+
+/* @summary Wait for files in any watched directory to change.
+ * The function returns when changes have been seen, gpuccFileWatcherWake is called, or the timeout elapses.
+ * A directory that is deleted or unmounted is no longer watched, and is reported through o_removed so that the caller can add it again if it is recreated.
+ * @param watcher The watcher returned by gpuccCreateFileWatcher.
+ * @param timeout_ms The maximum time to wait, in milliseconds, or GPUCC_WAIT_INFINITE.
+ * @param o_changed On return, the paths of the changed files are appended. Each path is the directory, as passed to gpuccFileWatcherAddDirectory, followed by the file name.
+ * @param o_removed On return, the directories that are no longer watched are appended, once per spelling passed to gpuccFileWatcherAddDirectory.
+ * @return Non-zero if change notifications were lost, in which case the caller must assume that any watched file may have changed.
+ */
+GPUCC_API(int32_t)
+gpuccFileWatcherWait
+(
+    struct GPUCC_FILE_WATCHER      *watcher,
+    uint32_t                     timeout_ms,
+    std::vector<std::string> &o_changed,
+    std::vector<std::string> &o_removed
+);
+
+/* @summary Cause a thread blocked in gpuccFileWatcherWait to return. This function may be called from any thread.
+ * If no thread is waiting, the next call to gpuccFileWatcherWait returns immediately.
+ * @param watcher The watcher returned by gpuccCreateFileWatcher.
+ */
+GPUCC_API(void)
+gpuccFileWatcherWake
+(
+    struct GPUCC_FILE_WATCHER *watcher
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_RELOAD_H__ */
@@ -0,0 +1,117 @@
+/**
+ * @summary gpucc_stats.h: Define the internal interface to the process-wide
+ * statistics counters. Each thread increments counters in a shard that only it
+ * writes, so recording a compilation never contends with other threads; a
+ * snapshot sums the counters of every shard. Compile latencies are recorded
+ * into histograms shared by all compilers with the same type and profile.
+ */
+#ifndef __GPUCC_STATS_H__
+#define __GPUCC_STATS_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   include <atomic>
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#endif
+
+/* @summary Define the per-thread set of statistics counters. The fields correspond to those of GPUCC_STATISTICS.
+ * Shards are linked into a process-wide list the first time a thread records a statistic. The list only grows;
+ * when a thread exits, its shard is marked unused and is taken over, with its counts, by the next thread that needs one.
+ */
+typedef struct GPUCC_STATISTICS_SHARD {
+    std::atomic<uint64_t>          CompileCount[GPUCC_COMPILER_TYPE_COUNT];    /* The number of compilations that ran the backend of each compiler type. */
+    std::atomic<uint64_t>          SuccessCount;                               /* The number of compilations that succeeded. */
+    std::atomic<uint64_t>          FailureCount;                               /* The number of compilations that failed or were cancelled. */
+    std::atomic<uint64_t>          SourceBytes;                                /* The number of bytes of program source code supplied. */
+    std::atomic<uint64_t>          BytecodeBytes;                              /* The number of bytes of bytecode produced by successful compilations. */
+    std::atomic<uint64_t>          CacheHitCount;                              /* The number of bytecode cache lookups that found a result. */
+    std::atomic<uint64_t>          CacheMissCount;                             /* The number of bytecode cache lookups that did not find a result. */
+    std::atomic<uint64_t>          CompileNanoseconds;                         /* The cumulative value of GPUCC_COMPILE_TIMINGS::TotalNanoseconds. */
+    std::atomic<uint64_t>          BackendNanoseconds;                         /* The cumulative time spent in GPUCC_COMPILE_PHASE_COMPILE. */
+    std::atomic<int32_t>           InUse;                                      /* Non-zero while the shard is owned by a thread. */
+    struct GPUCC_STATISTICS_SHARD *Next;                                       /* The next shard in the process-wide list. Immutable once the shard is linked. */
+} GPUCC_STATISTICS_SHARD;
+
+/* @summary Define the number of bits of each latency value, below the most significant bit, used to select a histogram bucket.
+ * Each power of two is divided into 1 << GPUCC_LATENCY_SUB_BUCKET_BITS buckets, bounding the relative error of a bucket to 1 / (1 << GPUCC_LATENCY_SUB_BUCKET_BITS).
+ */
+#ifndef GPUCC_LATENCY_SUB_BUCKET_BITS
+#   define GPUCC_LATENCY_SUB_BUCKET_BITS                                       4
+#endif
+
+/* @summary Define the number of buckets in a latency histogram, which covers the full range of a 64-bit nanosecond value.
+ * Values below 1 << GPUCC_LATENCY_SUB_BUCKET_BITS have a bucket each; each higher power of two has 1 << GPUCC_LATENCY_SUB_BUCKET_BITS buckets.
+ */
+#ifndef GPUCC_LATENCY_BUCKET_COUNT
+#   define GPUCC_LATENCY_BUCKET_COUNT                                          ((64 - GPUCC_LATENCY_SUB_BUCKET_BITS + 1) << GPUCC_LATENCY_SUB_BUCKET_BITS)
+#endif
+
+/* @summary Define the latency histogram for one combination of compiler type and target profile.
+ * Histograms are created by gpuccCreateCompiler and linked into a process-wide list that only grows, so compilers can record into them without locks and without any reference counting.
+ */
+typedef struct GPUCC_LATENCY_HISTOGRAM {
+    std::atomic<uint64_t>          Buckets[GPUCC_LATENCY_BUCKET_COUNT];        /* The number of compilations whose latency fell into each bucket. */
+    std::atomic<uint64_t>          MaxNanoseconds;                             /* The highest latency recorded, in nanoseconds. */
+    struct GPUCC_LATENCY_HISTOGRAM *Next;                                      /* The next histogram in the process-wide list. Immutable once the histogram is linked. */
+    char                          *TargetProfile;                              /* A nul-terminated copy of the target profile, or an empty string. */
+    int32_t                        CompilerType;                               /* One of the values of the GPUCC_COMPILER_TYPE enumeration. */
+} GPUCC_LATENCY_HISTOGRAM;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Attach a new compiler to the latency histogram for its compiler type and target profile, creating the histogram if necessary.
+ * If the histogram cannot be allocated, the compiler's latencies are not recorded.
+ * @param compiler The compiler being created.
+ * @param config The configuration passed to gpuccCreateCompiler.
+ */
+GPUCC_API(void)
+gpuccInitLatencyHistogram
+(
+    struct GPUCC_PROGRAM_COMPILER      *compiler,
+    struct GPUCC_PROGRAM_COMPILER_INIT   *config
+);
+
+/* @summary Add a completed call to gpuccCompileProgramBytecode to the statistics of the calling thread, and its latency to the histogram of the compiler.
+ * The compile count and latency are recorded only if the backend ran, so that cache hits and shared results do not skew them.
+ * This function must be called after the TotalNanoseconds field of the container timings has been set.
+ * @param container The bytecode container that was compiled into.
+ * @param source_size The number of bytes of program source code supplied.
+ * @param result The result returned to the caller.
+ */
+GPUCC_API(void)
+gpuccRecordCompileStatistics
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    uint64_t                     source_size,
+    struct GPUCC_RESULT               result
+);
+
+/* @summary Add a bytecode cache lookup to the statistics of the calling thread.
+ * @param hit Non-zero if the lookup found a result, or zero if it did not.
+ */
+GPUCC_API(void)
+gpuccRecordCacheLookup
+(
+    int32_t hit
+);
+
+/* @summary Return a statistics shard to the process-wide list when the thread that owns it exits. The counts are retained.
+ * This function is called from the platform thread context destructor.
+ * @param shard The shard referenced by the thread context. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccReleaseStatisticsShard
+(
+    struct GPUCC_STATISTICS_SHARD *shard
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_STATS_H__ */
@@ -0,0 +1,75 @@
+/**
+ * @summary gpucc_tiered.h: Define the internal interface to tiered compilers,
+ * which publish an unoptimized build of a program as soon as it is available
+ * and then replace it with an optimized build compiled at low priority on the
+ * compile pool.
+ */
+#ifndef __GPUCC_TIERED_H__
+#define __GPUCC_TIERED_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   include <condition_variable>
+#   include <mutex>
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#   ifndef __GPUCC_ASYNC_H__
+#       include "gpucc_async.h"
+#   endif
+#   ifndef __GPUCC_PUBLISH_H__
+#       include "gpucc_publish.h"
+#   endif
+#   ifndef __GPUCC_CANCEL_H__
+#       include "gpucc_cancel.h"
+#   endif
+#endif
+
+/* @summary Define the data associated with a tiered compiler.
+ * Compiler flags are fixed when a compiler is created, so each tier has its own compiler, created from the same configuration.
+ */
+typedef struct GPUCC_TIERED_COMPILER {
+    struct GPUCC_PROGRAM_COMPILER *FastCompiler;                               /* The compiler used for the first tier, created with GPUCC_COMPILER_FLAG_DISABLE_OPTIMIZATIONS. */
+    struct GPUCC_PROGRAM_COMPILER *OptimizedCompiler;                          /* The compiler used for the second tier, created without GPUCC_COMPILER_FLAG_DISABLE_OPTIMIZATIONS. */
+    std::mutex                     Lock;                                       /* Protects the OutstandingCount field. */
+    std::condition_variable        IdleSignal;                                 /* Signaled when OutstandingCount drops to zero. */
+    uint32_t                       OutstandingCount;                           /* The number of optimized compiles queued or running. */
+    GPUCC_CANCEL_STATE             Discard;                                    /* The cancellation state shared by every queued optimized compile. Cancelled while the tiered compiler is being drained, so that queued compiles are skipped, and may start even if the background class is out of budget. */
+} GPUCC_TIERED_COMPILER;
+
+/* @summary Define a queued optimized compile. The job and its copies of the source code and strings are allocated as a single block.
+ */
+typedef struct GPUCC_TIERED_JOB {
+    GPUCC_COMPILE_TASK             Task;                                       /* The task header. This must be the first field. */
+    GPUCC_TIERED_COMPILER         *Tiered;                                     /* The tiered compiler that queued the job. */
+    struct GPUCC_PUBLISHED_PROGRAM *Program;                                   /* The published program that receives the optimized build. */
+    GPUCC_PUBLISH_TICKET           Expected;                                   /* The publication of the unoptimized build. The optimized build replaces only this publication. */
+    char const                    *SourceCode;                                 /* The job's private copy of the program source code. */
+    uint64_t                       SourceSize;                                 /* The number of bytes of source code. */
+    char const                    *SourcePath;                                 /* The job's private copy of the source path, or NULL. */
+    char const                    *EntryPoint;                                 /* The job's private copy of the entry point, or NULL. */
+} GPUCC_TIERED_JOB;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Create a tiered compiler from the compilers used for each tier.
+ * The tiered compiler takes ownership of both compilers, and deletes them if it cannot be created.
+ * @param fast The compiler used for the first tier, created with GPUCC_COMPILER_FLAG_DISABLE_OPTIMIZATIONS.
+ * @param optimized The compiler used for the second tier.
+ * @return The tiered compiler, or NULL if memory allocation failed.
+ */
+GPUCC_API(struct GPUCC_TIERED_COMPILER*)
+gpuccInitTieredCompiler
+(
+    struct GPUCC_PROGRAM_COMPILER      *fast,
+    struct GPUCC_PROGRAM_COMPILER *optimized
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_TIERED_H__ */
@@ -0,0 +1,107 @@
+/**
+ * @summary gpucc_trace.h: Define the internal interface to the compile tracer,
+ * which records timed events into per-thread ring buffers while tracing is
+ * enabled, and writes them out in the Chrome trace event format.
+ */
+#ifndef __GPUCC_TRACE_H__
+#define __GPUCC_TRACE_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   include <atomic>
+#   include <mutex>
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#endif
+
+/* @summary Define the maximum number of bytes of descriptive text stored with a trace event, including the nul. Longer text is truncated.
+ */
+#ifndef GPUCC_TRACE_DETAIL_SIZE
+#define GPUCC_TRACE_DETAIL_SIZE                                  96
+#endif
+
+/* @summary Define the data recorded for a single trace event.
+ * Events are written as a complete event on the track of the recording thread, unless AsyncId is non-zero, in which case they are written as a begin/end pair on an asynchronous track so that they may overlap other events.
+ */
+typedef struct GPUCC_TRACE_EVENT {
+    char const                    *Name;                                       /* A string literal naming the operation. */
+    uint64_t                       StartTime;                                  /* The value of gpuccQueryClockNanoseconds when the operation started. */
+    uint64_t                       Duration;                                   /* The duration of the operation, in nanoseconds. */
+    uint64_t                       AsyncId;                                    /* The identifier of an asynchronous event, or zero for an event on the thread track. */
+    uint64_t                       ThreadId;                                   /* The operating system identifier of the recording thread. */
+    char                           Detail[GPUCC_TRACE_DETAIL_SIZE];            /* Nul-terminated UTF-8 text appended to the name, for example the program being compiled. May be empty. */
+} GPUCC_TRACE_EVENT;
+
+/* @summary Define the per-thread ring buffer into which trace events are recorded.
+ * Buffers are linked into a process-wide list the first time a thread records an event while tracing is enabled. The list only grows;
+ * when a thread exits, its buffer is marked unused and is taken over, with any events not yet written, by the next thread that needs one.
+ */
+typedef struct GPUCC_TRACE_BUFFER {
+    std::mutex                     Lock;                                       /* Held by the owning thread while it records an event, and by gpuccWriteTraceFile while it drains the buffer. */
+    GPUCC_TRACE_EVENT             *Events;                                     /* The ring of Capacity event records. */
+    uint32_t                       Capacity;                                   /* The number of events the ring can hold. */
+    uint64_t                       ThreadId;                                   /* The operating system identifier of the thread that owns the buffer, set each time the buffer is acquired. */
+    uint64_t                       RecordCount;                                /* The number of events recorded since the buffer was last drained. If this exceeds Capacity, the oldest events were overwritten. */
+    std::atomic<int32_t>           InUse;                                      /* Non-zero while the buffer is owned by a thread. */
+    struct GPUCC_TRACE_BUFFER     *Next;                                       /* The next buffer in the process-wide list. Immutable once the buffer is linked. */
+} GPUCC_TRACE_BUFFER;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Retrieve the start time of a traced operation.
+ * @return The current value of gpuccQueryClockNanoseconds if tracing is enabled, or zero if it is not.
+ */
+GPUCC_API(uint64_t)
+gpuccTraceBegin
+(
+    void
+);
+
+/* @summary Record an operation that started on the calling thread and has just completed.
+ * Nothing is recorded if start is zero or tracing has since been disabled.
+ * @param name A string literal naming the operation.
+ * @param start The start time of the operation, returned by gpuccTraceBegin or gpuccQueryClockNanoseconds.
+ * @param detail Optional nul-terminated UTF-8 text describing the operation, or NULL.
+ * @param detail2 Optional nul-terminated UTF-8 text, shown in parentheses after detail, or NULL.
+ */
+GPUCC_API(void)
+gpuccTraceEnd
+(
+    char const    *name,
+    uint64_t      start,
+    char const  *detail,
+    char const *detail2
+);
+
+/* @summary Record an operation that started at some earlier time, possibly on another thread, and has just completed.
+ * The event is placed on an asynchronous track, since it may overlap other events recorded by the calling thread.
+ * Nothing is recorded if start is zero or tracing has since been disabled.
+ * @param name A string literal naming the operation.
+ * @param start The start time of the operation, returned by gpuccTraceBegin.
+ */
+GPUCC_API(void)
+gpuccTraceEndAsync
+(
+    char const *name,
+    uint64_t   start
+);
+
+/* @summary Return a trace buffer to the process-wide list when the thread that owns it exits. Events not yet written are retained.
+ * This function is called from the platform thread context destructor.
+ * @param buffer The buffer referenced by the thread context. This value may be NULL.
+ */
+GPUCC_API(void)
+gpuccReleaseTraceBuffer
+(
+    struct GPUCC_TRACE_BUFFER *buffer
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_TRACE_H__ */
@@ -0,0 +1,135 @@
+/**
+ * @summary gpucc_worker.h: Define the internal interface to worker process
+ * pools, which run compiler backends in separate processes so that a backend
+ * crash cannot take down the application, and to the serialized form of the
+ * compiler configuration sent to the workers.
+ */
+#ifndef __GPUCC_WORKER_H__
+#define __GPUCC_WORKER_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   ifndef __GPUCC_INTERNAL_H__
+#       include "gpucc_internal.h"
+#   endif
+#endif
+
+/* @summary Define the header of a compiler configuration serialized for transmission to a worker process.
+ * The header is followed by the target profile, then the symbol and value of each define. Each string is preceded by a byte that is zero if the string is NULL, in which case no characters follow.
+ */
+typedef struct GPUCC_WORKER_CONFIG {
+    GPUCC_HASH128                  ConfigHash;                                 /* The configuration hash of the compiler in the calling process, used by the worker to reuse compilers. */
+    uint64_t                       CompilerFlags;                              /* One or more bitwise OR'd values of the GPUCC_COMPILER_FLAGS enumeration. */
+    uint64_t                       TotalSize;                                  /* The size of the serialized configuration, in bytes, including the header. */
+    uint64_t                       RecycleMemoryBytes;                         /* The growth in the resident set size of the worker, in bytes, after which the worker exits once its compile completes, or zero. */
+    int32_t                        TargetRuntime;                              /* One of the values of the GPUCC_TARGET_RUNTIME enumeration. */
+    int32_t                        BytecodeType;                               /* One of the values of the GPUCC_BYTECODE_TYPE enumeration. */
+    uint32_t                       DefineCount;                                /* The number of defines following the target profile. */
+    uint32_t                       IncludeFlag;                                /* Non-zero if the compiler has an include handler, in which case the worker forwards include requests to the calling process. */
+    uint32_t                       RecycleCompileCount;                        /* The number of compiles after which the worker exits once its compile completes, or zero. */
+} GPUCC_WORKER_CONFIG;
+
+/* @summary Define the signature of a function that creates the compilers used by worker processes.
+ * A stand-in backend, such as the one used by the compile throughput benchmark, registers a factory so that its compilers can run in workers; the factory may call gpuccCreateCompiler for configurations it does not handle.
+ * @param config The configuration reconstructed from the request, whose IncludeHandler forwards include requests to the application.
+ * @return The compiler, or NULL if it could not be created, in which case the factory should call gpuccSetLastResult.
+ */
+typedef struct GPUCC_PROGRAM_COMPILER* (*PFN_gpuccCreateWorkerCompiler)
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT *config
+);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Record the worker process pool of a new compiler and serialize its configuration for transmission to the workers.
+ * This function must be called after gpuccComputeCompilerConfigHash.
+ * @param compiler The compiler being created.
+ * @param config The configuration passed to gpuccCreateCompiler.
+ * @return Non-zero if the compiler does not use a worker process pool or the configuration was serialized, or zero if memory allocation failed.
+ */
+GPUCC_API(int32_t)
+gpuccInitWorkerConfig
+(
+    struct GPUCC_PROGRAM_COMPILER      *compiler,
+    struct GPUCC_PROGRAM_COMPILER_INIT   *config
+);
+
+/* @summary Free the serialized configuration of a compiler, if any.
+ * This function is called when a compiler is deleted.
+ * @param compiler The compiler.
+ */
+GPUCC_API(void)
+gpuccReleaseWorkerConfig
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+);
+
+/* @summary Reconstruct the compiler configuration serialized by gpuccInitWorkerConfig. The HostAllocator, IncludeHandler and WorkerPool fields are set to NULL.
+ * The recycling limits are set to zero, since a worker process applies them by exiting rather than by recycling its compilers.
+ * @param config The serialized configuration.
+ * @param config_size The number of bytes of serialized configuration data available.
+ * @param o_init On return, the compiler configuration, whose strings point into the serialized data. If DefineCount is non-zero, the caller must free the DefineSymbols array with free(), which also frees DefineValues.
+ * @return Non-zero if the configuration was reconstructed, or zero if the data is malformed or memory allocation failed.
+ */
+GPUCC_API(int32_t)
+gpuccParseWorkerConfig
+(
+    struct GPUCC_WORKER_CONFIG const *config,
+    uint64_t                     config_size,
+    struct GPUCC_PROGRAM_COMPILER_INIT *o_init
+);
+
+/* @summary Set the function used by worker processes to create compilers. By default, workers call gpuccCreateCompiler.
+ * The worker host executable must call this function before gpuccRunWorkerProcess, since workers are started from a separate process image.
+ * @param factory The factory function, or NULL to restore the default.
+ */
+GPUCC_API(void)
+gpuccSetWorkerCompilerFactory
+(
+    PFN_gpuccCreateWorkerCompiler factory
+);
+
+/* @summary Create a compiler in a worker process, using the factory set by gpuccSetWorkerCompilerFactory if any.
+ * @param config The configuration reconstructed by gpuccParseWorkerConfig.
+ * @return The compiler, or NULL if it could not be created.
+ */
+GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
+gpuccCreateWorkerCompiler
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT *config
+);
+
+/* @summary Compile program source code in a worker process of the pool associated with the container's compiler.
+ * The bytecode and log are returned in shared memory, which is mapped into the calling process and referenced by the container until it is reset or deleted.
+ * The caller must have called gpuccSetProgramEntryPoint.
+ * @param container The destination bytecode container.
+ * @param source_code Pointer to a buffer containing the program source code.
+ * @param source_size The number of bytes of program source code.
+ * @return The result of the compilation.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccWorkerPoolCompile
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size
+);
+
+/* @summary Release the shared memory holding a result returned by a worker process, if any.
+ * This function is called when a bytecode container is reset or deleted.
+ * @param container The bytecode container.
+ */
+GPUCC_API(void)
+gpuccReleaseWorkerResult
+(
+    struct GPUCC_PROGRAM_BYTECODE *container
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_WORKER_H__ */
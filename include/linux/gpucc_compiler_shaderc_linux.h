@@ -0,0 +1,117 @@
+#ifndef __GPUCC_COMPILER_SHADERC_LINUX_H__
+#define __GPUCC_COMPILER_SHADERC_LINUX_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   ifndef __GPUCC_SHADERCCOMPILERAPI_LINUX_H__
+#       include "linux/shadercompilerapi_linux.h"
+#   endif
+#endif
+
+/* @summary Cast a GPUCC_PROGRAM_COMPILER* to a GPUCC_COMPILER_SHADERC_LINUX*.
+ */
+#ifndef gpuccCompilerShaderc_
+#define gpuccCompilerShaderc_(_c)                                              \
+    ((GPUCC_COMPILER_SHADERC_LINUX*)(_c))
+#endif
+
+/* @summary Cast a GPUCC_PROGRAM_BYTECODE* to a GPUCC_BYTECODE_SHADERC_LINUX*.
+ */
+#ifndef gpuccBytecodeShaderc_
+#define gpuccBytecodeShaderc_(_b)                                              \
+    ((GPUCC_BYTECODE_SHADERC_LINUX*)(_b))
+#endif
+
+/* @summary Define the data maintained by an instance of the shaderc compiler.
+ * This compiler type can emit SPIR-V bytecode (Vulkan and OpenGL 4.5+) from either GLSL or HLSL source code.
+ * The shaderc_compiler_t and the base shaderc_compile_options_t are created once, when the compiler is created.
+ * Each compilation clones the base options, so the per-compile setup cost is a single copy.
+ */
+typedef struct GPUCC_COMPILER_SHADERC_LINUX {
+    GPUCC_PROGRAM_COMPILER_BASE   CommonFields;                                /* This must be the first field of any compiler type. */
+    SHADERCCOMPILERAPI_DISPATCH  *DispatchTable;                               /* A pointer to the libshaderc_shared dispatch table maintained by the process context. */
+    shaderc_compiler_t            ShadercCompiler;                             /* The shaderc compiler instance. shaderc_compile_into_spv may be called concurrently on a single instance. */
+    shaderc_compile_options_t     CompileOptions;                              /* The base compile options, with defines, flags and target environment applied. Cloned for each compilation. */
+    int32_t                       TargetRuntime;                               /* One of the values of the GPUCC_TARGET_RUNTIME enumeration specifying the target runtime for shaders built by the compiler. */
+    int32_t                       SourceLanguage;                              /* One of the values of the shaderc_source_language enumeration, derived from the target profile. */
+    int32_t                       ShaderKind;                                  /* One of the values of the shaderc_shader_kind enumeration, derived from the target profile. */
+    char                         *TargetProfile;                               /* A nul-terminated string specifying the target profile, for example "ps_6_0" or "frag". */
+} GPUCC_COMPILER_SHADERC_LINUX;
+
+/* @summary Define the data maintained by a single SPIR-V program bytecode container generated by the shaderc compiler.
+ */
+typedef struct GPUCC_BYTECODE_SHADERC_LINUX {
+    GPUCC_PROGRAM_BYTECODE_BASE   CommonFields;                                /* This must be the first field of any bytecode container type. */
+    shaderc_compilation_result_t  ShadercResult;                               /* The compilation result object, which owns both the bytecode and the compilation log. */
+} GPUCC_BYTECODE_SHADERC_LINUX;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Allocate and initialize a bytecode container for SPIR-V bytecode generated by the shaderc compiler.
+ * @param compiler A pointer to an instance of GPUCC_COMPILER_SHADERC_LINUX.
+ * @return A pointer to the bytecode container, of type GPUCC_BYTECODE_SHADERC_LINUX, or NULL if the allocation failed.
+ */
+GPUCC_API(struct GPUCC_PROGRAM_BYTECODE*)
+gpuccCreateProgramBytecodeShaderc
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+);
+
+/* @summary Release the compilation results held by a shaderc program bytecode container, so that the container can be reused.
+ * Buffers that can be reused by a subsequent compilation are retained.
+ * @param bytecode A pointer to an instance of GPUCC_BYTECODE_SHADERC_LINUX.
+ */
+GPUCC_API(void)
+gpuccResetProgramBytecodeShaderc
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+);
+
+/* @summary Release all resources associated with a shaderc program bytecode container.
+ * @param bytecode A pointer to an instance of GPUCC_BYTECODE_SHADERC_LINUX.
+ */
+GPUCC_API(void)
+gpuccDeleteProgramBytecodeShaderc
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+);
+
+/* @summary Compile GPU program source code into SPIR-V bytecode using the shaderc compiler.
+ * Any #include directives are resolved through the GPUCC_PROGRAM_COMPILER_INIT::IncludeHandler specified when the compiler was created. If the compiler has no include handler, the source code must not include other files, and the caller must supply the fully preprocessed source code in the source_code buffer.
+ * The function blocks the calling thread until compilation has completed.
+ * @param container The container that will be used to store the program bytecode, of type GPUCC_BYTECODE_SHADERC_LINUX.
+ * @param source_code Pointer to a buffer containing UTF-8 encoded GPU program source code.
+ * @param source_size The number of bytes of program source code in the spurce_code buffer.
+ * @oaram source_path A nul-terminated UTF-8 string specifying the path to the source file, for use in log output. This value may be NULL.
+ * @param entry_point A nul-terminated string specifying the program entry point.
+ * @return The result of the compilation. Use the gpuccSuccess and gpuccFailure macros to determine whether compilation was successful.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccCompileBytecodeShaderc
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size,
+    char const                  *source_path,
+    char const                  *entry_point
+);
+
+/* @summary Allocate and initialize a new compiler record for accessing the shaderc compiler.
+ * The target profile selects the source language. A Direct3D-style profile ("ps_6_0") selects HLSL, while a glslc-style stage name ("frag") selects GLSL.
+ * @param config Data used to configure the compiler instance.
+ * @return A pointer to the compiler, or NULL if an error occurred.
+ */
+GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
+gpuccCreateCompilerShaderc
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT *config
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * @summary gpucc_internal_linux.h: Define Linux-specific types and helper
+ * functions made available to other internal modules.
+ */
+#ifndef __GPUCC_INTERNAL_LINUX_H__
+#define __GPUCC_INTERNAL_LINUX_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   include <errno.h>
+#   include <pthread.h>
+#   include <stdlib.h>
+#   include <string.h>
+#   ifndef __GPUCC_PTXCOMPILERAPI_LINUX_H__
+#       include "linux/ptxcompilerapi_linux.h"
+#   endif
+#   ifndef __GPUCC_SHADERCCOMPILERAPI_LINUX_H__
+#       include "linux/shadercompilerapi_linux.h"
+#   endif
+#endif
+
+#ifndef __GPUCC_INTERNAL_H__
+#   error Do not include this file directly - include gpucc_internal.h instead.
+#endif
+
+/* @summary Mark a function parameter or local variable as intentionally unused.
+ * This mirrors the macro of the same name provided by the Windows SDK.
+ * @param _x The parameter or variable name.
+ */
+#ifndef UNREFERENCED_PARAMETER
+#define UNREFERENCED_PARAMETER(_x)                                             \
+    (void)(_x)
+#endif
+
+/* @summary Retrieve the process-global data.
+ * @return A pointer to GPUCC_PROCESS_CONTEXT_LINUX.
+ */
+#ifndef gpuccGetProcessContext_
+#define gpuccGetProcessContext_()                                              \
+    ((GPUCC_PROCESS_CONTEXT_LINUX*) gpuccGetProcessContext())
+#endif
+
+/* @summary Retrieve the per-thread global data.
+ * @return A pointer to GPUCC_THREAD_CONTEXT_LINUX.
+ */
+#ifndef gpuccGetThreadContext_
+#define gpuccGetThreadContext_()                                               \
+    ((GPUCC_THREAD_CONTEXT_LINUX *) gpuccGetThreadContext())
+#endif
+
+/* @summary Define the platform-specific GPUCC_PROCESS_CONTEXT structure.
+ * There's one process context that's global to the application.
+ * The process context is managed by the shared object constructor and destructor.
+ */
+typedef struct GPUCC_PROCESS_CONTEXT_LINUX {
+    pthread_key_t                 TlsKey_ThreadContext;                        /* The pthread key used for storing each thread's GPUCC_THREAD_CONTEXT_LINUX pointer. */
+    uint32_t                      CompilerSupport;                             /* One or more bitwise-OR'd GPUCC_COMPILER_SUPPORT flags indicating which compilers are supported. */
+    int                           InitializationFlag;                          /* Set to non-zero when the process context has been initialized, or zero otherwise. */
+    int                           StartupFlag;                                 /* Set to non-zero when gpuccStartup completes successfully, or zero otherwise. */
+    int                           DebugOutputFlag;                             /* Set to non-zero if the GPUCC_DEBUG_OUTPUT environment variable was set when the library was loaded. */
+    PTXCOMPILERAPI_DISPATCH       PtxCompiler_Dispatch;                        /* The dispatch table for the nVidia RTC (runtime CUDA) compiler, loaded from libnvrtc.so. */
+    SHADERCCOMPILERAPI_DISPATCH   ShadercCompiler_Dispatch;                    /* The dispatch table for the Google shaderc compiler, loaded from libshaderc_shared.so. */
+    struct GPUCC_BYTECODE_CACHE  *BytecodeCache;                               /* The persistent bytecode cache enabled by gpuccEnableBytecodeCache, or NULL if caching is disabled. */
+    struct GPUCC_COMPILE_POOL    *CompilePool;                                 /* The worker pool used to execute asynchronous compile jobs. Created by gpuccStartup. */
+    struct GPUCC_COMPILE_FLIGHT_TABLE *CompileFlights;                         /* The compilations in progress, used to deduplicate identical concurrent requests. Created by gpuccStartup. */
+} GPUCC_PROCESS_CONTEXT_LINUX;
+
+/* @summary Alias the platform-specific process context type for use by platform-independent code.
+ */
+typedef GPUCC_PROCESS_CONTEXT_LINUX GPUCC_PROCESS_CONTEXT_PLATFORM;
+
+/* @summary Define the platform-specific GPUCC_THREAD_CONTEXT structure.
+ * There's one thread context for each thread that calls into the library.
+ * The thread context is created on first use and freed by the pthread key destructor when the thread exits.
+ */
+typedef struct GPUCC_THREAD_CONTEXT_LINUX {
+    GPUCC_RESULT                  LastResult;                                  /* The result code returned by the most recent GpuCC operation on the thread. */
+    struct GPUCC_EPOCH_RECORD    *EpochRecord;                                 /* The record used to read published programs, or NULL if the thread has never acquired one. */
+    struct GPUCC_STATISTICS_SHARD *StatisticsShard;                            /* The shard holding the statistics counters recorded by the thread, or NULL if the thread has never recorded a statistic. */
+    struct GPUCC_TRACE_BUFFER     *TraceBuffer;                                /* The buffer into which the thread records trace events, or NULL if the thread has never recorded one. */
+} GPUCC_THREAD_CONTEXT_LINUX;
+
+/* @summary Alias the platform-specific thread context type for use by platform-independent code.
+ */
+typedef GPUCC_THREAD_CONTEXT_LINUX GPUCC_THREAD_CONTEXT_PLATFORM;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Helper function to emit printf-style output to stderr.
+ * Output is only generated if the GPUCC_DEBUG_OUTPUT environment variable is set when GpuCC is loaded.
+ * GpuCC pipes debug output from startup and loading functions to this endpoint.
+ * @param format A nul-terminated UTF-8 string following printf formatting conventions.
+ * @param ... Substitution arguments for the format string.
+ */
+GPUCC_API(void)
+gpuccDebugPrintf
+(
+    char const *format,
+    ...
+) __attribute__((format(printf, 1, 2)));
+
+/* @summary Validate a UTF-8 encoded string and calculate the number of bytes and codepoints it contains.
+ * @param o_info Pointer to the GPUCC_STRING_INFO structure to populate. Required. The returned counts include the trailing nul.
+ * @param str Pointer to a nul-terminated UTF-8 encoded string to measure.
+ * @return Zero if the string is valid UTF-8, or non-zero if str contains one or more invalid codepoints.
+ */
+GPUCC_API(int32_t)
+gpuccStringInfoUtf8
+(
+    GPUCC_STRING_INFO *o_info,
+    char const           *str
+);
+
+/* @summary Write a nul-terminated UTF-8 encoded string to a buffer.
+ * @param dst A pointer to the address where the string should be written. On return, points to one-past the nul codepoint in the buffer.
+ * @param src A pointer to the start of the nul-terminated source string to copy.
+ * @return A pointer to the start of the string in the destination buffer.
+ */
+GPUCC_API(char*)
+gpuccPutStringUtf8
+(
+    uint8_t   *&dst,
+    char const *src
+);
+
+/* @summary Parse a Direct3D shader model target profile of the format "ss_j_i", where ss indicates the shader stage, j indicates the shader model major version, and i indicates the shader model minor version.
+ * @param target A nul-terminated string specifying the Direct3D shader model.
+ * @param o_stage Pointer to a three-byte buffer that on return stores the nul-terminated shader stage string, for example "cs", "vs", "gs" or "fs".
+ * @param o_sm_major On return, stores the major version component of the shader model target profile.
+ * @param o_sm_minor On return, stores the minor version component of the shader model target profile.
+ * @return Zero if the shader model was successfully parsed, or non-zero if the target string could not be parsed.
+ */
+GPUCC_API(int32_t)
+gpuccExtractDirect3DShaderModel
+(
+    char const *target,
+    char    o_stage[3],
+    int    *o_sm_major,
+    int    *o_sm_minor
+);
+
+/* @summary Construct a GPUCC_RESULT value specifying the GpuCC result code and taking the platform result code from errno.
+ * This function is used when an error occurs after calling a standard C library or POSIX function.
+ * @param library_result One of the values of the GPUCC_RESULT_CODE enumeration.
+ * @return The GPUCC_RESULT structure.
+ */
+GPUCC_API(struct GPUCC_RESULT)
+gpuccMakeResult_errno
+(
+    int32_t library_result
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_INTERNAL_LINUX_H__ */
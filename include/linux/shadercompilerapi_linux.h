@@ -0,0 +1,115 @@
+/**
+ * @summary shadercompilerapi_linux.h: Define an interface used for dynamically
+ * loading libshaderc_shared.so into the process address space and resolving
+ * the available entry points. This is needed so that GLSL and HLSL source
+ * code can be compiled into SPIR-V bytecode without the dxcompiler.
+ */
+#ifndef __GPUCC_SHADERCCOMPILERAPI_LINUX_H__
+#define __GPUCC_SHADERCCOMPILERAPI_LINUX_H__
+
+#pragma once
+
+#ifndef GPUCC_NO_INCLUDES
+#   ifndef __GPUCC_H__
+#       include "gpucc.h"
+#   endif
+#   include <dlfcn.h>
+#   include "shaderc/shaderc.h"
+#endif
+
+/**
+ * Function pointer types.
+ */
+typedef shaderc_compiler_t           (*PFN_shaderc_compiler_initialize                )(void);
+typedef void                         (*PFN_shaderc_compiler_release                   )(shaderc_compiler_t);
+typedef shaderc_compile_options_t    (*PFN_shaderc_compile_options_initialize         )(void);
+typedef shaderc_compile_options_t    (*PFN_shaderc_compile_options_clone              )(const shaderc_compile_options_t);
+typedef void                         (*PFN_shaderc_compile_options_release            )(shaderc_compile_options_t);
+typedef void                         (*PFN_shaderc_compile_options_add_macro_definition)(shaderc_compile_options_t, const char*, size_t, const char*, size_t);
+typedef void                         (*PFN_shaderc_compile_options_set_source_language)(shaderc_compile_options_t, shaderc_source_language);
+typedef void                         (*PFN_shaderc_compile_options_set_generate_debug_info)(shaderc_compile_options_t);
+typedef void                         (*PFN_shaderc_compile_options_set_optimization_level)(shaderc_compile_options_t, shaderc_optimization_level);
+typedef void                         (*PFN_shaderc_compile_options_set_target_env     )(shaderc_compile_options_t, shaderc_target_env, uint32_t);
+typedef void                         (*PFN_shaderc_compile_options_set_warnings_as_errors)(shaderc_compile_options_t);
+typedef void                         (*PFN_shaderc_compile_options_set_include_callbacks)(shaderc_compile_options_t, shaderc_include_resolve_fn, shaderc_include_result_release_fn, void*);
+typedef shaderc_compilation_result_t (*PFN_shaderc_compile_into_spv                   )(const shaderc_compiler_t, const char*, size_t, shaderc_shader_kind, const char*, const char*, const shaderc_compile_options_t);
+typedef void                         (*PFN_shaderc_result_release                     )(shaderc_compilation_result_t);
+typedef size_t                       (*PFN_shaderc_result_get_length                  )(const shaderc_compilation_result_t);
+typedef shaderc_compilation_status   (*PFN_shaderc_result_get_compilation_status      )(const shaderc_compilation_result_t);
+typedef const char*                  (*PFN_shaderc_result_get_bytes                   )(const shaderc_compilation_result_t);
+typedef const char*                  (*PFN_shaderc_result_get_error_message           )(const shaderc_compilation_result_t);
+typedef void                         (*PFN_shaderc_get_spv_version                    )(unsigned int*, unsigned int*);
+
+/* @summary Define the data associated with the dispatch table used to call functions from libshaderc_shared.so.
+ */
+typedef struct SHADERCCOMPILERAPI_DISPATCH {
+    PFN_shaderc_compiler_initialize                      shaderc_compiler_initialize;
+    PFN_shaderc_compiler_release                         shaderc_compiler_release;
+    PFN_shaderc_compile_options_initialize               shaderc_compile_options_initialize;
+    PFN_shaderc_compile_options_clone                    shaderc_compile_options_clone;
+    PFN_shaderc_compile_options_release                  shaderc_compile_options_release;
+    PFN_shaderc_compile_options_add_macro_definition     shaderc_compile_options_add_macro_definition;
+    PFN_shaderc_compile_options_set_source_language      shaderc_compile_options_set_source_language;
+    PFN_shaderc_compile_options_set_generate_debug_info  shaderc_compile_options_set_generate_debug_info;
+    PFN_shaderc_compile_options_set_optimization_level   shaderc_compile_options_set_optimization_level;
+    PFN_shaderc_compile_options_set_target_env           shaderc_compile_options_set_target_env;
+    PFN_shaderc_compile_options_set_warnings_as_errors   shaderc_compile_options_set_warnings_as_errors;
+    PFN_shaderc_compile_options_set_include_callbacks    shaderc_compile_options_set_include_callbacks;
+    PFN_shaderc_compile_into_spv                         shaderc_compile_into_spv;
+    PFN_shaderc_result_release                           shaderc_result_release;
+    PFN_shaderc_result_get_length                        shaderc_result_get_length;
+    PFN_shaderc_result_get_compilation_status            shaderc_result_get_compilation_status;
+    PFN_shaderc_result_get_bytes                         shaderc_result_get_bytes;
+    PFN_shaderc_result_get_error_message                 shaderc_result_get_error_message;
+    PFN_shaderc_get_spv_version                          shaderc_get_spv_version;
+    void                                                *ModuleHandle_shaderc;
+} SHADERCCOMPILERAPI_DISPATCH;
+
+/* @summary Define a series of flags that can be bitwise OR'd together to control loader behavior.
+ */
+typedef enum SHADERCCOMPILERAPI_LOADER_FLAGS {
+    SHADERCCOMPILERAPI_LOADER_FLAGS_NONE = (0UL << 0),                         /* No special behavior is requested. */
+} SHADERCCOMPILERAPI_LOADER_FLAGS;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* @summary Load libshaderc_shared.so into the process address space and resolve entry points.
+ * Any missing entry points are set to stub functions, so none of the function pointers will be NULL.
+ * @param dispatch The dispatch table to populate.
+ * @param loader_flags One or more values of the SHADERCCOMPILERAPI_LOADER_FLAGS enumeration.
+ * @return Non-zero if libshaderc_shared.so was loaded, or zero if the shaderc API is not available on the host.
+ */
+GPUCC_API(int)
+ShadercCompilerApiPopulateDispatch
+(
+    struct SHADERCCOMPILERAPI_DISPATCH *dispatch,
+    uint32_t                        loader_flags
+);
+
+/* @summary Determine whether the shaderc API is supported on the host.
+ * @param dispatch The dispatch table to query.
+ * @return Non-zero if the shaderc API is supported on the host, or zero otherwise.
+ */
+GPUCC_API(int)
+ShadercCompilerApiQuerySupport
+(
+    struct SHADERCCOMPILERAPI_DISPATCH *dispatch
+);
+
+/* @summary Free resources associated with a dispatch table.
+ * This function invalidates the entry points associated with the dispatch table.
+ * @param dispatch The dispatch table to invalidate.
+ */
+GPUCC_API(void)
+ShadercCompilerApiInvalidateDispatch
+(
+    struct SHADERCCOMPILERAPI_DISPATCH *dispatch
+);
+
+#ifdef __cplusplus
+}; /* extern "C" */
+#endif
+
+#endif /* __GPUCC_SHADERCCOMPILERAPI_LINUX_H__ */
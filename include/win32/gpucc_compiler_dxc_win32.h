@@ -30,17 +30,89 @@
 #define GPUCC_COMPILER_DXC_WIN32_MAX_ARGS                                     32 
 #endif
 
+/* @summary Define the maximum number of IDxcCompiler instances maintained by a single compiler record.
+ * Compilations running when all instances are busy use a temporary instance that is released afterwards.
+ */
+#ifndef GPUCC_COMPILER_DXC_WIN32_MAX_INSTANCES
+#define GPUCC_COMPILER_DXC_WIN32_MAX_INSTANCES                                64
+#endif
+
+/* @summary Define the size of the header stored in front of each block allocated through GPUCC_DXC_MALLOC_WIN32.
+ * The header is a GPUCC_DXC_MALLOC_BLOCK_WIN32, which records the size of the block that IMalloc::GetSize must be able to report. The value also defines the alignment of returned blocks.
+ */
+#ifndef GPUCC_DXC_MALLOC_HEADER_SIZE
+#define GPUCC_DXC_MALLOC_HEADER_SIZE                                          16
+#endif
+
 // TODO: Good example code here:
 // https://blogs.msdn.microsoft.com/marcelolr/2017/03/27/directx-compiler-apis/
 
+/* @summary Define a bump allocator that backs the DXC allocations made during a compilation.
+ * Only the thread holding the owning instance allocates from the arena, but blocks may be freed by any thread, so only LiveCount is shared.
+ * The arena is reset after a compilation if no block allocated from it is still live; otherwise, allocations fall back to the heap until it drains.
+ */
+typedef struct GPUCC_DXC_ARENA_WIN32 {
+    uint8_t                      *BaseAddress;                                 /* The start of the arena memory, or NULL if the arena has not been allocated. */
+    SIZE_T                        Capacity;                                    /* The size of the arena memory, in bytes. */
+    SIZE_T                        Offset;                                      /* The offset of the first free byte. */
+    LONG volatile                 LiveCount;                                   /* The number of blocks allocated from the arena that have not been freed. */
+} GPUCC_DXC_ARENA_WIN32;
+
+/* @summary Define the header stored in front of each block allocated through GPUCC_DXC_MALLOC_WIN32.
+ */
+typedef struct GPUCC_DXC_MALLOC_BLOCK_WIN32 {
+    SIZE_T                        Size;                                        /* The size of the block requested by DXC, in bytes. */
+    GPUCC_DXC_ARENA_WIN32        *Arena;                                       /* The arena the block was allocated from, or NULL if the block was allocated from the heap. */
+} GPUCC_DXC_MALLOC_BLOCK_WIN32;
+
+/* @summary Define a single set of DXC interfaces that can be used by one compilation at a time.
+ * DXC objects must not be used by concurrent compilations, so each compiler record keeps an array of these.
+ * A thread claims an instance by atomically changing InUse from zero to one, so acquiring an instance never blocks.
+ */
+typedef struct GPUCC_DXC_INSTANCE_WIN32 {
+    IDxcLibrary                  *DxcLibrary;                                  /* The IDxcLibrary interface used to create blobs for specifying source code, etc. NULL until first use. */
+    IDxcCompiler                 *DxcCompiler;                                 /* The IDxcCompiler interface instance used to compile code. NULL until first use. */
+    LONG volatile                 InUse;                                       /* Set to 1 while a compilation is using the instance, or 0 if the instance is available. */
+    GPUCC_DXC_ARENA_WIN32         Arena;                                       /* The arena backing allocations made by compilations using the instance. The arena outlives the interfaces. */
+} GPUCC_DXC_INSTANCE_WIN32;
+
+/* @summary Implement the COM IMalloc interface on top of a GPUCC_HOST_ALLOCATOR.
+ * DXC interfaces created with DxcCreateInstance2 allocate all of their memory, including blobs returned to GpuCC, through this object, which counts the bytes allocated.
+ * During a compilation, allocations made on the compiling thread are also counted against the compilation and served from the arena of its instance, if any.
+ * The object is stored in the compiler's memory block and lives exactly as long as the compiler; reference counts are tracked but never free the object.
+ */
+struct GPUCC_DXC_MALLOC_WIN32 : public IMalloc {
+    GPUCC_HOST_ALLOCATOR const   *HostAllocator;                               /* The allocator stored in the compiler record. */
+    LONG volatile                 RefCount;                                    /* The number of outstanding references held by DXC objects. */
+    LONG64 volatile               CurrentBytes;                                /* The number of bytes currently allocated through the object, excluding block headers. */
+    LONG64 volatile               PeakBytes;                                   /* The largest value of CurrentBytes observed. */
+    LONG64 volatile               TotalBytes;                                  /* The total number of bytes allocated through the object. */
+    LONG64 volatile               ArenaBytes;                                  /* The portion of TotalBytes allocated from arenas. */
+    LONG64 volatile               AllocationCount;                             /* The number of allocations made through the object. */
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void **ppv) override;
+    ULONG   STDMETHODCALLTYPE AddRef        (void) override;
+    ULONG   STDMETHODCALLTYPE Release       (void) override;
+    void*   STDMETHODCALLTYPE Alloc         (SIZE_T cb) override;
+    void*   STDMETHODCALLTYPE Realloc       (void *pv, SIZE_T cb) override;
+    void    STDMETHODCALLTYPE Free          (void *pv) override;
+    SIZE_T  STDMETHODCALLTYPE GetSize       (void *pv) override;
+    int     STDMETHODCALLTYPE DidAlloc      (void *pv) override;
+    void    STDMETHODCALLTYPE HeapMinimize  (void) override;
+};
+
 /* @summary Define the data maintained by an instance of the dxc compiler.
  * This compiler type can emit both DXIL (Direct3D) and SPIR-V (Vulkan and OpenGL 4.5+) bytecode.
+ * The interned configuration is immutable after creation, so a single compiler record may be used by any number of threads.
+ * DXC interfaces are created lazily, one set per concurrently compiling thread, up to InstanceCount.
  */
 typedef struct GPUCC_COMPILER_DXC_WIN32 {
     GPUCC_PROGRAM_COMPILER_BASE   CommonFields;                                /* This must be the first field of any compiler type. */
     DXCCOMPILERAPI_DISPATCH      *DispatchTable;                               /* A pointer to the dxcompiler dispatch table maintained by the process context. */
-    IDxcLibrary                  *DxcLibrary;                                  /* The IDxcLibrary interface used to create blobs for specifying source code, etc. */
-    IDxcCompiler                 *DxcCompiler;                                 /* The IDxcCompiler interface instance used to compile code. */
+    GPUCC_DXC_INSTANCE_WIN32     *Instances;                                   /* An array of InstanceCount sets of DXC interfaces. The first entry is created along with the compiler. */
+    uint32_t                      InstanceCount;                               /* The number of entries in the Instances array, based on the number of hardware threads. */
+    IMalloc                      *DxcMalloc;                                   /* The IMalloc passed to DxcCreateInstance2, of type GPUCC_DXC_MALLOC_WIN32. */
+    SIZE_T                        ArenaSize;                                   /* The size of the arena allocated for each instance slot, in bytes, or zero if arenas are disabled. */
     DxcDefine                    *DefineArray;                                 /* An array of DxcDefine (WCHAR versions of D3D_SHADER_MACRO) specifying the symbols and values defined for the compiler. */
     uint32_t                      DefineCount;                                 /* The number of valid elements in the DxcDefine array. */
     int32_t                       TargetRuntime;                               /* One of the values of the GPUCC_TARGET_RUNTIME enumeration specifying the target runtime for shaders built by the compiler. */
@@ -56,6 +128,7 @@ typedef struct GPUCC_BYTECODE_DXC_WIN32 {
     GPUCC_PROGRAM_BYTECODE_BASE   CommonFields;                                /* This must be the first field of any bytecode container type. */
     IDxcBlob                     *CodeBuffer;                                  /* The buffer for storing the compiled bytecode. This is NULL unless the compilation succeeds. */
     IDxcBlobEncoding             *ErrorLog;                                    /* The blob containing the output from the compilation. */
+    uint8_t                      *OutputBuffer;                                /* If the compiler uses arenas, a host allocation holding a copy of the bytecode followed by the log, so that no result blob holds arena memory. Otherwise, NULL. */
 } GPUCC_BYTECODE_DXC_WIN32;
 
 #ifdef __cplusplus
@@ -72,6 +145,16 @@ gpuccCreateProgramBytecodeDxc
     struct GPUCC_PROGRAM_COMPILER *compiler
 );
 
+/* @summary Release the compilation results held by a dxc program bytecode container, so that the container can be reused.
+ * Buffers that can be reused by a subsequent compilation are retained.
+ * @param bytecode A pointer to an instance of GPUCC_BYTECODE_DXC_WIN32.
+ */
+GPUCC_API(void)
+gpuccResetProgramBytecodeDxc
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+);
+
 /* @summary Release all resources associated with a dxc program bytecode container.
  * @param bytecode A pointer to an instance of GPUCC_BYTECODE_DXC_WIN32.
  */
@@ -82,7 +165,7 @@ gpuccDeleteProgramBytecodeDxc
 );
 
 /* @summary Compile GPU program source code into intermediate bytecode using the dxc compiler.
- * The caller is responsible for processing any source code includes and supplying the full resulting source code in the source_code buffer.
+ * Any #include directives are resolved through the GPUCC_PROGRAM_COMPILER_INIT::IncludeHandler specified when the compiler was created. If the compiler has no include handler, the source code must not include other files, and the caller must supply the fully preprocessed source code in the source_code buffer.
  * The function blocks the calling thread until compilation has completed.
  * The resulting bytecode will be DXIL by default, unless the caller specified GPUCC_BYTECODE_TYPE_SPIRV when the compiler was created.
  * @param container The container that will be used to store the program bytecode, of type GPUCC_BYTECODE_FXC_WIN32.
@@ -53,6 +53,16 @@ gpuccCreateProgramBytecodeFxc
     struct GPUCC_PROGRAM_COMPILER *compiler
 );
 
+/* @summary Release the compilation results held by a fxc program bytecode container, so that the container can be reused.
+ * Buffers that can be reused by a subsequent compilation are retained.
+ * @param bytecode A pointer to an instance of GPUCC_BYTECODE_FXC_WIN32.
+ */
+GPUCC_API(void)
+gpuccResetProgramBytecodeFxc
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+);
+
 /* @summary Release all resources associated with a fxc program bytecode container.
  * @param bytecode A pointer to an instance of GPUCC_BYTECODE_FXC_WIN32.
  */
@@ -63,7 +73,7 @@ gpuccDeleteProgramBytecodeFxc
 );
 
 /* @summary Compile GPU program source code into intermediate bytecode.
- * The caller is responsible for processing any source code includes and supplying the full resulting source code in the source_code buffer.
+ * Any #include directives are resolved through the GPUCC_PROGRAM_COMPILER_INIT::IncludeHandler specified when the compiler was created. If the compiler has no include handler, the source code must not include other files, and the caller must supply the fully preprocessed source code in the source_code buffer.
  * The function blocks the calling thread until compilation has completed.
  * @param container The container that will be used to store the program bytecode, of type GPUCC_BYTECODE_FXC_WIN32.
  * @param source_code Pointer to a buffer containing UTF-8 encoded GPU program source code.
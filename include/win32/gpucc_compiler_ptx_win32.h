@@ -51,6 +51,8 @@ typedef struct GPUCC_BYTECODE_PTX_WIN32 {
     GPUCC_PROGRAM_BYTECODE_BASE   CommonFields;                                /* This must be the first field of any bytecode container type. */
     uint8_t                      *CodeBuffer;                                  /* A buffer, separate from the program object, containing the compiled bytecode. */
     char                         *LogBuffer;                                   /* A buffer, separate from the program object, containing the compilation log. */
+    size_t                        CodeBufferCapacity;                          /* The capacity of the CodeBuffer, in bytes. The buffer is retained when the container is reset. */
+    size_t                        LogBufferCapacity;                           /* The capacity of the LogBuffer, in bytes. The buffer is retained when the container is reset. */
 } GPUCC_BYTECODE_PTX_WIN32;
 
 #ifdef __cplusplus
@@ -67,6 +69,16 @@ gpuccCreateProgramBytecodePtx
     struct GPUCC_PROGRAM_COMPILER *compiler
 );
 
+/* @summary Release the compilation results held by a PTX program bytecode container, so that the container can be reused.
+ * Buffers that can be reused by a subsequent compilation are retained.
+ * @param bytecode A pointer to an instance of GPUCC_BYTECODE_PTX_WIN32.
+ */
+GPUCC_API(void)
+gpuccResetProgramBytecodePtx
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+);
+
 /* @summary Release all resources associated with a PTX program bytecode container.
  * @param bytecode A pointer to an instance of GPUCC_BYTECODE_PTX_WIN32.
  */
@@ -77,7 +89,7 @@ gpuccDeleteProgramBytecodePtx
 );
 
 /* @summary Compile GPU program source code into intermediate bytecode using the PTX compiler.
- * The caller is responsible for processing any source code includes and supplying the full resulting source code in the source_code buffer.
+ * Any #include directives are resolved through the GPUCC_PROGRAM_COMPILER_INIT::IncludeHandler specified when the compiler was created. If the compiler has no include handler, the source code must not include other files, and the caller must supply the fully preprocessed source code in the source_code buffer.
  * The function blocks the calling thread until compilation has completed.
  * @param container The container that will be used to store the program bytecode, of type GPUCC_BYTECODE_PTX_WIN32.
  * @param source_code Pointer to a buffer containing UTF-8 encoded GPU program source code.
@@ -17,6 +17,9 @@
 #   ifndef __GPUCC_PTXCOMPILERAPI_WIN32_H__
 #       include "win32/ptxcompilerapi_win32.h"
 #   endif
+#   ifndef __GPUCC_SHADERCCOMPILERAPI_WIN32_H__
+#       include "win32/shadercompilerapi_win32.h"
+#   endif
 #endif
 
 #ifndef __GPUCC_INTERNAL_H__
@@ -51,16 +54,31 @@ typedef struct GPUCC_PROCESS_CONTEXT_WIN32 {
     FXCCOMPILERAPI_DISPATCH       FxcCompiler_Dispatch;                        /* The dispatch table for the legacy Direct3D compiler, loaded from d3dcompiler_47.dll. */
     DXCCOMPILERAPI_DISPATCH       DxcCompiler_Dispatch;                        /* The dispatch table for the newer Clang/LLVM-based Direct3D compiler, loaded from dxcompiler.dll. */
     PTXCOMPILERAPI_DISPATCH       PtxCompiler_Dispatch;                        /* The dispatch table for the nVidia RTC (runtime CUDA) compiler, loaded from nvrtc64_###_#.dll. */
+    SHADERCCOMPILERAPI_DISPATCH   ShadercCompiler_Dispatch;                    /* The dispatch table for the Google shaderc compiler, loaded from shaderc_shared.dll. */
+    struct GPUCC_BYTECODE_CACHE  *BytecodeCache;                               /* The persistent bytecode cache enabled by gpuccEnableBytecodeCache, or NULL if caching is disabled. */
+    struct GPUCC_COMPILE_POOL    *CompilePool;                                 /* The worker pool used to execute asynchronous compile jobs. Created by gpuccStartup. */
+    struct GPUCC_COMPILE_FLIGHT_TABLE *CompileFlights;                         /* The compilations in progress, used to deduplicate identical concurrent requests. Created by gpuccStartup. */
 } GPUCC_PROCESS_CONTEXT_WIN32;
 
+/* @summary Alias the platform-specific process context type for use by platform-independent code.
+ */
+typedef GPUCC_PROCESS_CONTEXT_WIN32 GPUCC_PROCESS_CONTEXT_PLATFORM;
+
 /* @summary Define the platform-specific GPUCC_THREAD_CONTEXT structure.
  * There's one thread context for each thread that attaches to the library.
  * The thread context is managed in the DllMain function.
  */
 typedef struct GPUCC_THREAD_CONTEXT_WIN32 {
     GPUCC_RESULT                  LastResult;                                  /* The result code returned by the most recent GpuCC operation on the thread. */
+    struct GPUCC_EPOCH_RECORD    *EpochRecord;                                 /* The record used to read published programs, or NULL if the thread has never acquired one. */
+    struct GPUCC_STATISTICS_SHARD *StatisticsShard;                            /* The shard holding the statistics counters recorded by the thread, or NULL if the thread has never recorded a statistic. */
+    struct GPUCC_TRACE_BUFFER     *TraceBuffer;                                /* The buffer into which the thread records trace events, or NULL if the thread has never recorded one. */
 } GPUCC_THREAD_CONTEXT_WIN32;
 
+/* @summary Alias the platform-specific thread context type for use by platform-independent code.
+ */
+typedef GPUCC_THREAD_CONTEXT_WIN32 GPUCC_THREAD_CONTEXT_PLATFORM;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -132,6 +150,7 @@ gpuccInternUtf8ToUtf16
 
 /* @summary Convert a nul-terminated UTF-8 string to UTF-16.
  * If the conversion cannot be performed, this function calls gpuccSetLastResult and returns NULL.
+ * @param alloc The host allocator used to allocate the returned buffer.
  * @param str A nul-terminated UTF-8 string.
  * @return A pointer to the newly allocated buffer containing the UTF-16 string data, or NULL.
  * Free the returned buffer using the gpuccFreeStringBuffer function.
@@ -139,16 +158,33 @@ gpuccInternUtf8ToUtf16
 GPUCC_API(WCHAR*)
 gpuccConvertUtf8ToUtf16
 (
-    char const *str
+    struct GPUCC_HOST_ALLOCATOR const *alloc, 
+    char const                          *str
+);
+
+/* @summary Convert a nul-terminated UTF-16 string to UTF-8.
+ * If the conversion cannot be performed, this function calls gpuccSetLastResult and returns NULL.
+ * @param alloc The host allocator used to allocate the returned buffer.
+ * @param str A nul-terminated UTF-16 string.
+ * @return A pointer to the newly allocated buffer containing the UTF-8 string data, or NULL.
+ * Free the returned buffer using the gpuccFreeStringBuffer function.
+ */
+GPUCC_API(char*)
+gpuccConvertUtf16ToUtf8
+(
+    struct GPUCC_HOST_ALLOCATOR const *alloc, 
+    WCHAR const                         *str
 );
 
 /* @summary Releases memory associated with a string buffer allocated by GpuCC.
+ * @param alloc The host allocator passed to the function that allocated the string buffer.
  * @param buf A pointer to the string buffer.
  */
 GPUCC_API(void)
 gpuccFreeStringBuffer
 (
-    void *buf
+    struct GPUCC_HOST_ALLOCATOR const *alloc, 
+    void                                *buf
 );
 
 /* @summary Parse a Direct3D shader model target profile of the format "ss_j_i", where ss indicates the shader stage, j indicates the shader model major version, and i indicates the shader model minor version.
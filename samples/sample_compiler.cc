@@ -9,6 +9,7 @@
 // You can safely call any public API function. If it is not present, or GpuCC could not be loaded, 
 // it will fall back to a stub function.
 #include <stdio.h>
+#include <string.h>
 
 #define   GPUCC_LOADER_IMPLEMENTATION
 #define   GPUCC_LOCAL_RUNTIME_IMPLEMENTATION
@@ -27,7 +28,7 @@ int main
     if (gpuccSuccess((r = gpuccLocalRuntimeStartup(GPUCC_USAGE_MODE_OFFLINE)))) {
         gpuccVersion(&mj, &mi, &pa);
         printf("Hello from gpucc %d.%d.%d!\n", mj, mi, pa);
-        GPUCC_PROGRAM_COMPILER_INIT config;
+        GPUCC_PROGRAM_COMPILER_INIT config = {};
         char const                *symbols[3] = {"Symbol1", "Symbol2", "Symbol3"};
         char const                 *values[3] = {"A", "B", "C"};
         config.DefineSymbols = symbols;
@@ -51,14 +52,16 @@ int main
             printf("\r\n");
         } else {
             printf("BUILD SUCCEEDED.\r\n");
-            FILE *fp = nullptr; fopen_s(&fp, "compiled.spv", "w");
-            fwrite(gpuccQueryBytecodeBuffer(b), sizeof(uint8_t), gpuccQueryBytecodeSizeBytes(b), fp);
-            fclose(fp);
+            FILE *fp = fopen("compiled.spv", "wb");
+            if (fp != nullptr) {
+                fwrite(gpuccQueryBytecodeBuffer(b), sizeof(uint8_t), gpuccQueryBytecodeSizeBytes(b), fp);
+                fclose(fp);
+            }
         }
         gpuccDeleteBytecodeContainer(b);
         gpuccDeleteCompiler(c);
 
-        GPUCC_PROGRAM_COMPILER_INIT ptxcfg;
+        GPUCC_PROGRAM_COMPILER_INIT ptxcfg = {};
         ptxcfg.DefineSymbols = symbols;
         ptxcfg.DefineValues  = values;
         ptxcfg.DefineCount   = 3;
@@ -83,9 +86,11 @@ int main
             printf("\r\n");
         } else {
             printf("BUILD SUCCEEDED.\r\n");
-            FILE *fp = nullptr; fopen_s(&fp, "compiled.ptx", "w");
-            fwrite(gpuccQueryBytecodeBuffer(ptxbc), sizeof(uint8_t), gpuccQueryBytecodeSizeBytes(ptxbc), fp);
-            fclose(fp);
+            FILE *fp = fopen("compiled.ptx", "wb");
+            if (fp != nullptr) {
+                fwrite(gpuccQueryBytecodeBuffer(ptxbc), sizeof(uint8_t), gpuccQueryBytecodeSizeBytes(ptxbc), fp);
+                fclose(fp);
+            }
         }
         gpuccDeleteBytecodeContainer(ptxbc);
         gpuccDeleteCompiler(cudac);
@@ -1,6 +1,7 @@
 /**
  * @summary Implements the platform-independent portion of the public GpuCC API.
  */
+#include <string.h>
 #include "gpucc.h"
 #include "gpucc_internal.h"
 
@@ -59,6 +60,8 @@ gpuccErrorString
         case GPUCC_RESULT_CODE_CANNOT_LOAD               : return "GPUCC_RESULT_CODE_CANNOT_LOAD";
         case GPUCC_RESULT_CODE_COMPILE_FAILED            : return "GPUCC_RESULT_CODE_COMPILE_FAILED";
         case GPUCC_RESULT_CODE_INVALID_BYTECODE_CONTAINER: return "GPUCC_RESULT_CODE_INVALID_BYTECODE_CONTAINER";
+        case GPUCC_RESULT_CODE_TIMEOUT                   : return "GPUCC_RESULT_CODE_TIMEOUT";
+        case GPUCC_RESULT_CODE_CANCELLED                 : return "GPUCC_RESULT_CODE_CANCELLED";
         default                                          : return "GPUCC_RESULT_CODE (unknown)";
     }
 }
@@ -251,3 +254,76 @@ gpuccQueryBytecodeLogBuffer
     }
 }
 
+GPUCC_API(int32_t)
+gpuccQueryCompilerBackendMemory
+(
+    struct GPUCC_PROGRAM_COMPILER     *compiler,
+    struct GPUCC_BACKEND_MEMORY_STATS  *o_stats
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+
+    if (o_stats == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+    memset(o_stats, 0, sizeof(GPUCC_BACKEND_MEMORY_STATS));
+    if (compiler == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    if (compiler_->QueryBackendMemory != nullptr && compiler_->QueryBackendMemory(compiler, o_stats)) {
+        return 1;
+    }
+    memset(o_stats, 0, sizeof(GPUCC_BACKEND_MEMORY_STATS));
+    return 0;
+}
+
+GPUCC_API(int32_t)
+gpuccQueryBytecodeBackendMemory
+(
+    struct GPUCC_PROGRAM_BYTECODE     *bytecode,
+    struct GPUCC_BACKEND_MEMORY_STATS  *o_stats
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) bytecode;
+    GPUCC_PROGRAM_COMPILER_BASE  *compiler_ = nullptr;
+
+    if (o_stats == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+    if (bytecode == nullptr) {
+        memset(o_stats, 0, sizeof(GPUCC_BACKEND_MEMORY_STATS));
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) container_->Compiler;
+   *o_stats   = container_->BackendMemory;
+    return (compiler_->QueryBackendMemory != nullptr) ? 1 : 0;
+}
+
+GPUCC_API(int32_t)
+gpuccQueryBytecodeTimings
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode,
+    struct GPUCC_COMPILE_TIMINGS *o_timings
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) bytecode;
+
+    if (o_timings == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+    if (bytecode == nullptr) {
+        memset(o_timings, 0, sizeof(GPUCC_COMPILE_TIMINGS));
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+   *o_timings = container_->Timings;
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return 1;
+}
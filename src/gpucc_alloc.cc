@@ -0,0 +1,114 @@
+/**
+ * @summary gpucc_alloc.cc: Implement the routing of host memory allocations
+ * through the application-supplied GPUCC_HOST_ALLOCATOR callbacks, falling
+ * back to the C runtime heap when no allocator is supplied.
+ */
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+
+/* @summary Define the largest alignment guaranteed by the C runtime heap.
+ * GpuCC never requests a larger alignment from the default allocator.
+ */
+#ifndef GPUCC_DEFAULT_HEAP_ALIGNMENT
+#define GPUCC_DEFAULT_HEAP_ALIGNMENT                                           \
+    (alignof(max_align_t))
+#endif
+
+static void*
+gpuccDefaultHostAllocate
+(
+    void *user_data,
+    size_t     size,
+    size_t alignment
+)
+{
+    assert(alignment <= GPUCC_DEFAULT_HEAP_ALIGNMENT);
+    UNREFERENCED_PARAMETER(user_data);
+    UNREFERENCED_PARAMETER(alignment);
+    return malloc(size);
+}
+
+static void*
+gpuccDefaultHostReallocate
+(
+    void *user_data,
+    void   *address,
+    size_t     size,
+    size_t alignment
+)
+{
+    assert(alignment <= GPUCC_DEFAULT_HEAP_ALIGNMENT);
+    UNREFERENCED_PARAMETER(user_data);
+    UNREFERENCED_PARAMETER(alignment);
+    return realloc(address, size);
+}
+
+static void
+gpuccDefaultHostFree
+(
+    void *user_data,
+    void   *address
+)
+{
+    UNREFERENCED_PARAMETER(user_data);
+    free(address);
+}
+
+GPUCC_API(int32_t)
+gpuccInitHostAllocator
+(
+    struct GPUCC_HOST_ALLOCATOR       *dst,
+    struct GPUCC_HOST_ALLOCATOR const *src
+)
+{
+    if (src == nullptr) {
+        dst->Allocate   = gpuccDefaultHostAllocate;
+        dst->Reallocate = gpuccDefaultHostReallocate;
+        dst->Free       = gpuccDefaultHostFree;
+        dst->UserData   = nullptr;
+        return 1;
+    }
+    if (src->Allocate == nullptr || src->Reallocate == nullptr || src->Free == nullptr) {
+        return 0;
+    }
+    *dst = *src;
+    return 1;
+}
+
+GPUCC_API(void*)
+gpuccHostAlloc
+(
+    struct GPUCC_HOST_ALLOCATOR const *alloc,
+    size_t                              size,
+    size_t                         alignment
+)
+{
+    return alloc->Allocate(alloc->UserData, size, alignment);
+}
+
+GPUCC_API(void*)
+gpuccHostRealloc
+(
+    struct GPUCC_HOST_ALLOCATOR const *alloc,
+    void                            *address,
+    size_t                              size,
+    size_t                         alignment
+)
+{
+    return alloc->Reallocate(alloc->UserData, address, size, alignment);
+}
+
+GPUCC_API(void)
+gpuccHostFree
+(
+    struct GPUCC_HOST_ALLOCATOR const *alloc,
+    void                            *address
+)
+{
+    if (address != nullptr) {
+        alloc->Free(alloc->UserData, address);
+    }
+}
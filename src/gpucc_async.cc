@@ -0,0 +1,855 @@
+/**
+ * @summary gpucc_async.cc: Implement asynchronous and batch compilation on
+ * top of a work-stealing pool of worker threads. Each task simply calls the
+ * synchronous gpuccCompileProgramBytecode, so background and foreground
+ * compilation produce identical container contents.
+ */
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <new>
+#include <system_error>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_async.h"
+#include "gpucc_cancel.h"
+#include "gpucc_trace.h"
+
+/* @summary Take the most recently queued task from a worker's own queue.
+ * @param pool The compile pool.
+ * @param index The zero-based index of the worker queue.
+ * @return The task, or NULL if the queue is empty.
+ */
+static GPUCC_COMPILE_TASK*
+gpuccCompilePoolTakeLocal
+(
+    GPUCC_COMPILE_POOL *pool,
+    uint32_t           index
+)
+{
+    GPUCC_COMPILE_WORKER_QUEUE *queue =&pool->WorkerQueues[index];
+    GPUCC_COMPILE_TASK          *task = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(queue->Lock);
+        if (queue->Tasks.empty()) {
+            return nullptr;
+        }
+        task = queue->Tasks.back();
+        queue->Tasks.pop_back();
+    }
+    pool->PendingCount.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+}
+
+/* @summary Determine whether tasks of a priority class may be started.
+ * The caller must hold the pool's QueueLock.
+ * @param pool The compile pool.
+ * @param priority One of the values of the GPUCC_COMPILE_PRIORITY enumeration.
+ * @return Non-zero if tasks of the class may be started.
+ */
+static int32_t
+gpuccCompilePoolCanStart
+(
+    GPUCC_COMPILE_POOL *pool,
+    int32_t         priority
+)
+{
+    return priority < pool->BudgetedPriority || pool->TickBudget == 0 || pool->BudgetRemaining > 0 || pool->ShutdownFlag;
+}
+
+/* @summary Determine whether any queued task may be started.
+ * Cancelled tasks in a class that is out of budget may be started, since they complete without compiling.
+ * The caller must hold the pool's QueueLock.
+ * @param pool The compile pool.
+ * @return Non-zero if a worker should look for work.
+ */
+static int32_t
+gpuccCompilePoolHasRunnable
+(
+    GPUCC_COMPILE_POOL *pool
+)
+{
+    uint64_t blocked = 0;
+    for (int32_t c = 0; c < GPUCC_COMPILE_PRIORITY_COUNT; ++c) {
+        if (gpuccCompilePoolCanStart(pool, c) == 0) {
+            for (GPUCC_COMPILE_TASK *task : pool->Injection[c]) {
+                if (gpuccCancelRequested(task->CancelState) == 0) {
+                    blocked++;
+                }
+            }
+        }
+    }
+    return pool->PendingCount.load(std::memory_order_relaxed) > blocked;
+}
+
+/* @summary Take the oldest task from the highest-priority injection queue whose tasks may be started.
+ * From a class that is out of budget, only a cancelled task may be taken.
+ * @param pool The compile pool.
+ * @param o_priority On return, stores the priority class of the task.
+ * @return The task, or NULL if no task may be started.
+ */
+static GPUCC_COMPILE_TASK*
+gpuccCompilePoolTakeInjected
+(
+    GPUCC_COMPILE_POOL *pool,
+    int32_t      &o_priority
+)
+{
+    GPUCC_COMPILE_TASK *task = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(pool->QueueLock);
+        for (int32_t c = 0; c < GPUCC_COMPILE_PRIORITY_COUNT && task == nullptr; ++c) {
+            std::deque<GPUCC_COMPILE_TASK*> &queue = pool->Injection[c];
+            if (queue.empty()) {
+                continue;
+            }
+            if (gpuccCompilePoolCanStart(pool, c)) {
+                task = queue.front();
+                queue.pop_front();
+                o_priority = c;
+                continue;
+            }
+            for (auto iter = queue.begin(); iter != queue.end(); ++iter) {
+                if (gpuccCancelRequested((*iter)->CancelState)) {
+                    task = *iter;
+                    queue.erase(iter);
+                    o_priority = c;
+                    break;
+                }
+            }
+        }
+        if (task == nullptr) {
+            return nullptr;
+        }
+    }
+    pool->PendingCount.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+}
+
+/* @summary Steal the oldest task from another thread's queue.
+ * Victims are visited in order starting after the thief's own index, so concurrent thieves spread out rather than all hitting the same queue.
+ * @param pool The compile pool.
+ * @param index The zero-based index of the stealing worker. Non-worker threads may pass any value less than WorkerCount.
+ * @return The task, or NULL if every queue was empty.
+ */
+static GPUCC_COMPILE_TASK*
+gpuccCompilePoolSteal
+(
+    GPUCC_COMPILE_POOL *pool,
+    uint32_t           index
+)
+{
+    for (uint32_t i = 1; i <= pool->WorkerCount; ++i) {
+        GPUCC_COMPILE_WORKER_QUEUE *victim =&pool->WorkerQueues[(index + i) % pool->WorkerCount];
+        GPUCC_COMPILE_TASK           *task = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(victim->Lock);
+            if (victim->Tasks.empty()) {
+                continue;
+            }
+            task = victim->Tasks.front();
+            victim->Tasks.pop_front();
+        }
+        pool->PendingCount.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+    return nullptr;
+}
+
+/* @summary Execute a task taken from one of the pool queues, recording the time it spent queued.
+ * @param task The task to execute. The task may be freed before the function returns.
+ */
+static void
+gpuccCompileTaskRun
+(
+    GPUCC_COMPILE_TASK *task
+)
+{
+    gpuccTraceEndAsync("Queue wait", task->QueueTime);
+    task->Execute(task);
+}
+
+/* @summary Implement the main loop of a compile worker thread.
+ * The worker exits once the pool is shutting down and no queued work remains.
+ * @param pool The pool that owns the worker thread.
+ * @param index The zero-based index of the worker, which is also the index of its queue.
+ */
+static void
+gpuccCompileWorkerMain
+(
+    GPUCC_COMPILE_POOL *pool,
+    uint32_t           index
+)
+{
+    int32_t thread_priority = GPUCC_WORKER_THREAD_PRIORITY_NORMAL;
+
+    for ( ; ; ) {
+        GPUCC_COMPILE_TASK *task = nullptr;
+        int32_t         priority = GPUCC_COMPILE_PRIORITY_INTERACTIVE;
+
+        if (pool->WorkerPriority.load(std::memory_order_relaxed) != thread_priority) {
+            thread_priority = pool->WorkerPriority.load(std::memory_order_relaxed);
+            if (gpuccSetCurrentThreadPriority(thread_priority) == 0) {
+                /* The request is not retried; the worker keeps whatever priority it had. */
+                gpuccDebugPrintf("GpuCC: Compile worker %u could not change to thread priority %d. Raising the priority of a worker requires CAP_SYS_NICE on Linux.\n", index, thread_priority);
+            }
+        }
+        if ((task = gpuccCompilePoolTakeLocal(pool, index)) != nullptr ||
+            (task = gpuccCompilePoolSteal(pool, index))     != nullptr) {
+            gpuccCompileTaskRun(task);
+            continue;
+        }
+        if ((task = gpuccCompilePoolTakeInjected(pool, priority)) != nullptr) {
+            uint64_t t0 = gpuccQueryThreadCpuNanoseconds();
+            gpuccCompileTaskRun(task);
+            uint64_t ns = gpuccQueryThreadCpuNanoseconds() - t0;
+            std::lock_guard<std::mutex> lock(pool->QueueLock);
+            if (priority >= pool->BudgetedPriority && pool->TickBudget != 0) {
+                pool->BudgetRemaining -= (int64_t) ns;
+            }
+            continue;
+        }
+
+        /* No work was found, so sleep until some is submitted, the budget is
+         * refilled or the priority changes. Submitters increment PendingCount
+         * before signaling under QueueLock, so the wakeup cannot be missed. */
+        std::unique_lock<std::mutex> lock(pool->QueueLock);
+        pool->QueueSignal.wait(lock, [pool, thread_priority] { return gpuccCompilePoolHasRunnable(pool) || pool->ShutdownFlag || pool->WorkerPriority.load(std::memory_order_relaxed) != thread_priority; });
+        if (pool->ShutdownFlag && pool->PendingCount.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+    }
+}
+
+/* @summary Start the worker threads, if they have not already been started.
+ * The caller must hold the pool's QueueLock.
+ * @param pool The compile pool.
+ * @return The number of running worker threads, which is zero if no thread could be started.
+ */
+static size_t
+gpuccCompilePoolStartWorkers
+(
+    GPUCC_COMPILE_POOL *pool
+)
+{
+    if (pool->Workers.empty()) {
+        try {
+            for (uint32_t i = 0; i < pool->WorkerCount; ++i) {
+                pool->Workers.emplace_back(gpuccCompileWorkerMain, pool, i);
+            }
+        } catch (std::system_error const&) {
+            /* Continue with however many workers were started. Queues
+             * without an owner are still drained by thieves. */
+        }
+    }
+    return pool->Workers.size();
+}
+
+/* @summary Execute an asynchronous compile job and mark it complete.
+ * @param task The GPUCC_COMPILE_JOB to execute.
+ */
+static void
+gpuccCompileJobExecute
+(
+    GPUCC_COMPILE_TASK *task
+)
+{
+    GPUCC_COMPILE_JOB                 *job =(GPUCC_COMPILE_JOB*) task;
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) job->Container;
+    GPUCC_RESULT                     result;
+
+    if (gpuccCancelRequested(&job->Cancel)) {
+        /* The job was cancelled while queued, so it never starts, and the container is left empty. */
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_CANCELLED);
+    } else {
+        job->State.store(GPUCC_COMPILE_JOB_STATE_RUNNING, std::memory_order_relaxed);
+        container_->CancelState = &job->Cancel;
+        result = gpuccCompileProgramBytecode(job->Container, job->SourceCode, job->SourceSize, job->SourcePath, job->EntryPoint);
+        container_->CancelState = nullptr;
+    }
+    gpuccReleaseCancelToken(job->Cancel.Token);
+    job->Cancel.Token = nullptr;
+    /* Signal under the lock. Once it is released, the job may be deleted. */
+    std::lock_guard<std::mutex> lock(job->CompleteLock);
+    job->Result = result;
+    job->State.store(GPUCC_COMPILE_JOB_STATE_COMPLETE, std::memory_order_release);
+    job->CompleteSignal.notify_all();
+}
+
+/* @summary Execute one item of a compile batch and update the batch totals.
+ * @param task The GPUCC_COMPILE_BATCH_TASK to execute.
+ */
+static void
+gpuccCompileBatchExecute
+(
+    GPUCC_COMPILE_TASK *task
+)
+{
+    GPUCC_COMPILE_BATCH_TASK *item_task =(GPUCC_COMPILE_BATCH_TASK*) task;
+    GPUCC_COMPILE_BATCH_ITEM const *item = item_task->Item;
+    GPUCC_COMPILE_BATCH          *batch = item_task->Batch;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    GPUCC_RESULT                  result = gpuccCompileProgramBytecode(item->Container, item->SourceCode, item->SourceSize, item->SourcePath, item->EntryPoint);
+    uint64_t                          ns =(uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    uint64_t                     max_ns = batch->MaxItemNanoseconds.load(std::memory_order_relaxed);
+
+    *item_task->Result = result;
+    if (gpuccFailure(result)) {
+        batch->FailureCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    batch->CompileNanoseconds.fetch_add(ns, std::memory_order_relaxed);
+    while (ns > max_ns && !batch->MaxItemNanoseconds.compare_exchange_weak(max_ns, ns, std::memory_order_relaxed)) {
+        /* max_ns was reloaded by compare_exchange_weak */
+    }
+
+    gpuccCompileBatchItemComplete(batch);
+}
+
+GPUCC_API(struct GPUCC_COMPILE_POOL*)
+gpuccCreateCompilePool
+(
+    uint32_t worker_count
+)
+{
+    GPUCC_COMPILE_POOL *pool = nullptr;
+
+    if (worker_count == 0) {
+        if ((worker_count = std::thread::hardware_concurrency()) == 0) {
+            worker_count = 1;
+        }
+    }
+    if ((pool = new (std::nothrow) GPUCC_COMPILE_POOL()) == nullptr) {
+        return nullptr;
+    }
+    if ((pool->WorkerQueues = new (std::nothrow) GPUCC_COMPILE_WORKER_QUEUE[worker_count]) == nullptr) {
+        delete pool;
+        return nullptr;
+    }
+    pool->PendingCount.store(0, std::memory_order_relaxed);
+    pool->WorkerPriority.store(GPUCC_WORKER_THREAD_PRIORITY_NORMAL, std::memory_order_relaxed);
+    pool->TickBudget       = 0;
+    pool->BudgetRemaining  = 0;
+    pool->BudgetedPriority = GPUCC_COMPILE_PRIORITY_COUNT;
+    pool->WorkerCount      = worker_count;
+    pool->ShutdownFlag     = false;
+    return pool;
+}
+
+GPUCC_API(void)
+gpuccDeleteCompilePool
+(
+    struct GPUCC_COMPILE_POOL *pool
+)
+{
+    if (pool != nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(pool->QueueLock);
+            pool->ShutdownFlag = true;
+        }
+        pool->QueueSignal.notify_all();
+        for (size_t i = 0, n = pool->Workers.size(); i < n; ++i) {
+            pool->Workers[i].join();
+        }
+        delete [] pool->WorkerQueues;
+        delete pool;
+    }
+}
+
+GPUCC_API(int32_t)
+gpuccCompilePoolSubmit
+(
+    struct GPUCC_COMPILE_POOL *pool,
+    struct GPUCC_COMPILE_TASK  *task,
+    int32_t                 priority,
+    struct GPUCC_CANCEL_STATE *cancel
+)
+{
+    task->QueueTime   = gpuccTraceBegin();
+    task->CancelState = cancel;
+    {
+        std::lock_guard<std::mutex> lock(pool->QueueLock);
+        if (pool->ShutdownFlag || gpuccCompilePoolStartWorkers(pool) == 0) {
+            return 0;
+        }
+        pool->Injection[priority].push_back(task);
+        pool->PendingCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    pool->QueueSignal.notify_one();
+    return 1;
+}
+
+GPUCC_API(void)
+gpuccCompilePoolWake
+(
+    struct GPUCC_COMPILE_POOL *pool
+)
+{
+    if (pool != nullptr) {
+        /* Taking the lock orders this with a worker that is evaluating its wait predicate. */
+        {
+            std::lock_guard<std::mutex> lock(pool->QueueLock);
+        }
+        pool->QueueSignal.notify_all();
+    }
+}
+
+GPUCC_API(void)
+gpuccCompilePoolConfigure
+(
+    struct GPUCC_COMPILE_POOL                  *pool,
+    struct GPUCC_COMPILE_SCHEDULER_CONFIG const *config
+)
+{
+    {
+        std::lock_guard<std::mutex> lock(pool->QueueLock);
+        pool->TickBudget       = config->TickBudgetNanoseconds;
+        pool->BudgetRemaining  =(int64_t) config->TickBudgetNanoseconds;
+        pool->BudgetedPriority = config->BudgetedPriority;
+        pool->WorkerPriority.store(config->WorkerThreadPriority, std::memory_order_relaxed);
+    }
+    /* Wake every worker, so that sleeping workers apply the new thread priority and budget. */
+    pool->QueueSignal.notify_all();
+}
+
+GPUCC_API(void)
+gpuccCompilePoolTick
+(
+    struct GPUCC_COMPILE_POOL *pool
+)
+{
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(pool->QueueLock);
+        if (pool->TickBudget != 0) {
+            wake = pool->BudgetRemaining <= 0;
+            pool->BudgetRemaining = ((pool->BudgetRemaining < 0) ? pool->BudgetRemaining : 0) + (int64_t) pool->TickBudget;
+            wake = wake && pool->BudgetRemaining > 0;
+        }
+    }
+    if (wake) {
+        pool->QueueSignal.notify_all();
+    }
+}
+
+GPUCC_API(uint32_t)
+gpuccCompilePoolQueueDepth
+(
+    struct GPUCC_COMPILE_POOL *pool,
+    int32_t                priority
+)
+{
+    std::lock_guard<std::mutex> lock(pool->QueueLock);
+    return (uint32_t) pool->Injection[priority].size();
+}
+
+GPUCC_API(uint32_t)
+gpuccCompilePoolSubmitBatch
+(
+    struct GPUCC_COMPILE_POOL  *pool,
+    struct GPUCC_COMPILE_TASK **tasks,
+    uint32_t               task_count
+)
+{
+    uint64_t queue_time = gpuccTraceBegin();
+    uint32_t     running = 0;
+
+    for (uint32_t i = 0; i < task_count; ++i) {
+        tasks[i]->QueueTime = queue_time;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool->QueueLock);
+        if (pool->ShutdownFlag || (running =(uint32_t) gpuccCompilePoolStartWorkers(pool)) == 0) {
+            return 0;
+        }
+        /* Give each worker a contiguous run of tasks. Runs are pushed in
+         * reverse so that the owner, which pops from the back, works
+         * forward through its run while thieves take from the far end. */
+        for (uint32_t w = 0, n = pool->WorkerCount; w < n; ++w) {
+            GPUCC_COMPILE_WORKER_QUEUE *queue =&pool->WorkerQueues[w];
+            uint32_t                    begin =(uint32_t)(((uint64_t) task_count *  w     ) / n);
+            uint32_t                      end =(uint32_t)(((uint64_t) task_count * (w + 1)) / n);
+            std::lock_guard<std::mutex>  qlock(queue->Lock);
+            for (uint32_t i = end; i > begin; --i) {
+                queue->Tasks.push_back(tasks[i - 1]);
+            }
+        }
+        pool->PendingCount.fetch_add(task_count, std::memory_order_relaxed);
+    }
+    pool->QueueSignal.notify_all();
+    return running;
+}
+
+GPUCC_API(int32_t)
+gpuccCompilePoolHelp
+(
+    struct GPUCC_COMPILE_POOL *pool
+)
+{
+    GPUCC_COMPILE_TASK *task = gpuccCompilePoolSteal(pool, pool->WorkerCount - 1);
+
+    if (task != nullptr) {
+        gpuccCompileTaskRun(task);
+        return 1;
+    }
+    return 0;
+}
+
+GPUCC_API(void)
+gpuccCompileBatchItemComplete
+(
+    struct GPUCC_COMPILE_BATCH *batch
+)
+{
+    /* Decrement under the lock, so that the waiting thread cannot return
+     * (and destroy the batch) until this thread has finished with it. */
+    std::lock_guard<std::mutex> lock(batch->DoneLock);
+    if (batch->RemainingCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        batch->DoneSignal.notify_all();
+    }
+}
+
+GPUCC_API(uint32_t)
+gpuccCompilePoolRunBatch
+(
+    struct GPUCC_COMPILE_POOL   *pool,
+    struct GPUCC_COMPILE_BATCH *batch,
+    struct GPUCC_COMPILE_TASK **tasks,
+    uint32_t               task_count
+)
+{
+    uint32_t running = gpuccCompilePoolSubmitBatch(pool, tasks, task_count);
+
+    if (running != 0) {
+        /* Help with the batch rather than sleeping. Once nothing is left to
+         * steal, the remaining items are already running on workers. */
+        while (batch->RemainingCount.load(std::memory_order_acquire) != 0) {
+            if (gpuccCompilePoolHelp(pool) == 0) {
+                uint64_t trace = gpuccTraceBegin();
+                {
+                    std::unique_lock<std::mutex> lock(batch->DoneLock);
+                    batch->DoneSignal.wait(lock, [batch] { return batch->RemainingCount.load(std::memory_order_acquire) == 0; });
+                }
+                gpuccTraceEnd("Wait for compile batch", trace, nullptr, nullptr);
+            }
+        }
+        /* Synchronize with the thread that completed the last item before the batch goes out of scope. */
+        std::lock_guard<std::mutex> lock(batch->DoneLock);
+    } else {
+        /* No worker threads could be started, so run everything on the calling thread. */
+        for (uint32_t i = 0; i < task_count; ++i) {
+            tasks[i]->Execute(tasks[i]);
+        }
+    }
+    return running;
+}
+
+GPUCC_API(struct GPUCC_COMPILE_JOB*)
+gpuccCompileProgramBytecodeAsync
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size,
+    char const                  *source_path,
+    char const                  *entry_point
+)
+{
+    return gpuccCompileProgramBytecodeAsyncCancellable(container, source_code, source_size, source_path, entry_point, GPUCC_COMPILE_PRIORITY_INTERACTIVE, nullptr, GPUCC_WAIT_INFINITE);
+}
+
+GPUCC_API(struct GPUCC_COMPILE_JOB*)
+gpuccCompileProgramBytecodeAsyncPriority
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size,
+    char const                  *source_path,
+    char const                  *entry_point,
+    int32_t                         priority
+)
+{
+    return gpuccCompileProgramBytecodeAsyncCancellable(container, source_code, source_size, source_path, entry_point, priority, nullptr, GPUCC_WAIT_INFINITE);
+}
+
+GPUCC_API(struct GPUCC_COMPILE_JOB*)
+gpuccCompileProgramBytecodeAsyncCancellable
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size,
+    char const                  *source_path,
+    char const                  *entry_point,
+    int32_t                         priority,
+    struct GPUCC_CANCEL_TOKEN  *cancel_token,
+    uint32_t                     deadline_ms
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    GPUCC_COMPILE_JOB                *job = nullptr;
+    uint8_t                         *base = nullptr;
+    uint8_t                          *ptr = nullptr;
+    size_t                         nbneed = 0;
+
+    if (pctx->StartupFlag == 0 || pctx->CompilePool == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_NOT_INITIALIZED));
+        return nullptr;
+    }
+    if (container == nullptr || source_code == nullptr || source_size == 0 || priority < 0 || priority >= GPUCC_COMPILE_PRIORITY_COUNT) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+    if (gpuccBytecodeContainerIsEmpty(container) == 0) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_BYTECODE_CONTAINER));
+        return nullptr;
+    }
+    if (source_size > (uint64_t) SIZE_MAX - sizeof(GPUCC_COMPILE_JOB)) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+
+    /* The caller's buffers need not outlive this call, so copy everything into the job's memory block. */
+    nbneed  = sizeof(GPUCC_COMPILE_JOB) + (size_t) source_size;
+    nbneed += (source_path != nullptr) ? strlen(source_path) + 1 : 0;
+    nbneed += (entry_point != nullptr) ? strlen(entry_point) + 1 : 0;
+    if ((base = (uint8_t*) gpuccHostAlloc(gpuccQueryBytecodeHostAllocator_(container), nbneed, alignof(GPUCC_COMPILE_JOB))) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    job = new (base) GPUCC_COMPILE_JOB();
+    job->HostAllocator = *gpuccQueryBytecodeHostAllocator_(container);
+    ptr = base + sizeof(GPUCC_COMPILE_JOB);
+    job->Task.Execute = gpuccCompileJobExecute;
+    memcpy(ptr, source_code, (size_t) source_size);
+    job->SourceCode =(char const*) ptr;
+    job->SourceSize = source_size;
+    ptr += (size_t) source_size;
+    job->SourcePath = (source_path != nullptr) ? gpuccPutStringUtf8(ptr, source_path) : nullptr;
+    job->EntryPoint = (entry_point != nullptr) ? gpuccPutStringUtf8(ptr, entry_point) : nullptr;
+    job->Container  = container;
+    job->Result     = gpuccMakeResult(GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER);
+    job->Cancel.Token    = gpuccRetainCancelToken(cancel_token);
+    job->Cancel.Deadline =(deadline_ms != GPUCC_WAIT_INFINITE) ? gpuccCancelClockNanoseconds() + (uint64_t) deadline_ms * 1000000ULL : GPUCC_CANCEL_NO_DEADLINE;
+    job->Cancel.CancelFlag.store(0, std::memory_order_relaxed);
+    job->State.store(GPUCC_COMPILE_JOB_STATE_QUEUED, std::memory_order_relaxed);
+
+    if (gpuccCompilePoolSubmit(pctx->CompilePool, &job->Task, priority, &job->Cancel) == 0) {
+        gpuccReleaseCancelToken(job->Cancel.Token);
+        job->~GPUCC_COMPILE_JOB();
+        gpuccHostFree(gpuccQueryBytecodeHostAllocator_(container), base);
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_PLATFORM_ERROR));
+        return nullptr;
+    }
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return job;
+}
+
+GPUCC_API(int32_t)
+gpuccPollCompileJob
+(
+    struct GPUCC_COMPILE_JOB *job
+)
+{
+    if (job == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+    return job->State.load(std::memory_order_acquire) == GPUCC_COMPILE_JOB_STATE_COMPLETE;
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccWaitCompileJob
+(
+    struct GPUCC_COMPILE_JOB *job,
+    uint32_t           timeout_ms
+)
+{
+    GPUCC_RESULT result;
+
+    if (job == nullptr) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    if (job->State.load(std::memory_order_acquire) != GPUCC_COMPILE_JOB_STATE_COMPLETE && timeout_ms != 0) {
+        uint64_t                    trace = gpuccTraceBegin();
+        {
+            std::unique_lock<std::mutex> lock(job->CompleteLock);
+            auto is_complete = [job] { return job->State.load(std::memory_order_acquire) == GPUCC_COMPILE_JOB_STATE_COMPLETE; };
+            if (timeout_ms == GPUCC_WAIT_INFINITE) {
+                job->CompleteSignal.wait(lock, is_complete);
+            } else {
+                job->CompleteSignal.wait_for(lock, std::chrono::milliseconds(timeout_ms), is_complete);
+            }
+        }
+        gpuccTraceEnd("gpuccWaitCompileJob", trace, job->SourcePath, job->EntryPoint);
+    }
+    if (job->State.load(std::memory_order_acquire) != GPUCC_COMPILE_JOB_STATE_COMPLETE) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_TIMEOUT);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return job->Result;
+}
+
+GPUCC_API(void)
+gpuccCancelCompileJob
+(
+    struct GPUCC_COMPILE_JOB *job
+)
+{
+    if (job != nullptr) {
+        job->Cancel.CancelFlag.store(1, std::memory_order_relaxed);
+        /* A queued job in a class that is out of budget can now complete. The
+         * pool is reached through the process context, which gpuccShutdown
+         * clears, since the job may outlive it. */
+        gpuccCompilePoolWake(gpuccGetProcessContext_()->CompilePool);
+    }
+}
+
+GPUCC_API(void)
+gpuccDeleteCompileJob
+(
+    struct GPUCC_COMPILE_JOB *job
+)
+{
+    if (job != nullptr) {
+        GPUCC_HOST_ALLOCATOR alloc;
+        gpuccWaitCompileJob(job, GPUCC_WAIT_INFINITE);
+        {   /* The worker that completed the job may still hold the lock. */
+            std::lock_guard<std::mutex> lock(job->CompleteLock);
+        }
+        alloc = job->HostAllocator;
+        job->~GPUCC_COMPILE_JOB();
+        gpuccHostFree(&alloc, job);
+    }
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccCompileProgramBatch
+(
+    struct GPUCC_COMPILE_BATCH_ITEM const *items,
+    struct GPUCC_RESULT              *o_results,
+    uint32_t                         item_count,
+    struct GPUCC_COMPILE_BATCH_TIMING *o_timing
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    GPUCC_COMPILE_POOL              *pool = pctx->CompilePool;
+    GPUCC_COMPILE_BATCH_TASK   *item_tasks = nullptr;
+    GPUCC_COMPILE_TASK             **tasks = nullptr;
+    uint8_t                          *base = nullptr;
+    uint32_t                       running = 0;
+    GPUCC_RESULT                    result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    GPUCC_HOST_ALLOCATOR             alloc;
+    GPUCC_COMPILE_BATCH              batch;
+
+    if (o_timing != nullptr) {
+        memset(o_timing, 0, sizeof(GPUCC_COMPILE_BATCH_TIMING));
+    }
+    if (pctx->StartupFlag == 0 || pool == nullptr) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_NOT_INITIALIZED);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    if (item_count == 0) {
+        gpuccSetLastResult(result);
+        return result;
+    }
+    if (items == nullptr || o_results == nullptr) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccSetLastResult(result);
+        return result;
+    }
+
+    /* Allocate the task records and the array of task pointers as a single block,
+     * using the allocator of the first container, or the C runtime heap if it has none. */
+    if (items[0].Container != nullptr) {
+        alloc = *gpuccQueryBytecodeHostAllocator_(items[0].Container);
+    } else {
+        gpuccInitHostAllocator(&alloc, nullptr);
+    }
+    if ((base = (uint8_t*) gpuccHostAlloc(&alloc, item_count * (sizeof(GPUCC_COMPILE_BATCH_TASK) + sizeof(GPUCC_COMPILE_TASK*)), alignof(GPUCC_COMPILE_BATCH_TASK))) == nullptr) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    item_tasks =(GPUCC_COMPILE_BATCH_TASK*) base;
+    tasks      =(GPUCC_COMPILE_TASK     **)(base + item_count * sizeof(GPUCC_COMPILE_BATCH_TASK));
+
+    batch.RemainingCount.store(item_count, std::memory_order_relaxed);
+    batch.FailureCount.store(0, std::memory_order_relaxed);
+    batch.CompileNanoseconds.store(0, std::memory_order_relaxed);
+    batch.MaxItemNanoseconds.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < item_count; ++i) {
+        item_tasks[i].Task.Execute = gpuccCompileBatchExecute;
+        item_tasks[i].Item         =&items[i];
+        item_tasks[i].Result       =&o_results[i];
+        item_tasks[i].Batch        =&batch;
+        tasks[i]                   =&item_tasks[i].Task;
+    }
+
+    running = gpuccCompilePoolRunBatch(pool, &batch, tasks, item_count);
+    gpuccHostFree(&alloc, base);
+
+    if (o_timing != nullptr) {
+        o_timing->ElapsedNanoseconds =(uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+        o_timing->CompileNanoseconds = batch.CompileNanoseconds.load(std::memory_order_relaxed);
+        o_timing->MaxItemNanoseconds = batch.MaxItemNanoseconds.load(std::memory_order_relaxed);
+        o_timing->ItemCount          = item_count;
+        o_timing->FailureCount       = batch.FailureCount.load(std::memory_order_relaxed);
+        o_timing->WorkerCount        = running;
+    }
+    if (batch.FailureCount.load(std::memory_order_relaxed) != 0) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
+    }
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return result;
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccConfigureCompileScheduler
+(
+    struct GPUCC_COMPILE_SCHEDULER_CONFIG const *config
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    GPUCC_RESULT                  result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+
+    if (pctx->StartupFlag == 0 || pctx->CompilePool == nullptr) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_NOT_INITIALIZED);
+    } else if (config == nullptr || config->BudgetedPriority < 0 || config->BudgetedPriority > GPUCC_COMPILE_PRIORITY_COUNT ||
+               config->WorkerThreadPriority < GPUCC_WORKER_THREAD_PRIORITY_NORMAL || config->WorkerThreadPriority > GPUCC_WORKER_THREAD_PRIORITY_IDLE) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+    } else {
+        gpuccCompilePoolConfigure(pctx->CompilePool, config);
+    }
+    gpuccSetLastResult(result);
+    return result;
+}
+
+GPUCC_API(void)
+gpuccCompileSchedulerTick
+(
+    void
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    if (pctx->StartupFlag != 0 && pctx->CompilePool != nullptr) {
+        gpuccCompilePoolTick(pctx->CompilePool);
+    }
+}
+
+GPUCC_API(uint32_t)
+gpuccQueryCompileQueueDepth
+(
+    int32_t priority
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    if (pctx->StartupFlag == 0 || pctx->CompilePool == nullptr || priority < 0 || priority >= GPUCC_COMPILE_PRIORITY_COUNT) {
+        return 0;
+    }
+    return gpuccCompilePoolQueueDepth(pctx->CompilePool, priority);
+}
@@ -0,0 +1,459 @@
+/**
+ * @summary gpucc_cache.cc: Implement the persistent, content-addressed
+ * bytecode cache. Cache files are accessed with the C standard library so
+ * that the same implementation is shared by all platforms.
+ */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <atomic>
+#include <random>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_cache.h"
+#include "gpucc_depend.h"
+
+/* @summary Define the maximum length of a cache file name, including the nul.
+ * File names have the form <32 hex digits>.gpucc, or <32 hex digits>.<16 hex digits>.tmp for files being written.
+ */
+#ifndef GPUCC_BYTECODE_CACHE_MAX_NAME
+#define GPUCC_BYTECODE_CACHE_MAX_NAME                                           64
+#endif
+
+/* A per-process random value and counter used to generate unique temporary file names.
+ * Multiple processes may write the same entry at the same time, so the process ID alone is not sufficient on all platforms. */
+static std::atomic<uint64_t> g_CacheTempCounter(0);
+static uint64_t              g_CacheTempNonce = 0;
+
+/* @summary Build the full path of a cache file.
+ * @param alloc The host allocator used to allocate the returned string.
+ * @param cache The bytecode cache.
+ * @param key The cache key.
+ * @param suffix A nul-terminated string appended after the hex digits of the key, for example ".gpucc".
+ * @return A pointer to the path string, which must be freed with gpuccHostFree, or NULL if memory allocation failed.
+ */
+static char*
+gpuccBytecodeCachePath
+(
+    struct GPUCC_HOST_ALLOCATOR const *alloc,
+    struct GPUCC_BYTECODE_CACHE       *cache,
+    struct GPUCC_HASH128 const          *key,
+    char const                       *suffix
+)
+{
+    size_t  nbneed = cache->DirectoryLength + 1 + GPUCC_BYTECODE_CACHE_MAX_NAME;
+    char     *path = nullptr;
+
+    if ((path = (char*) gpuccHostAlloc(alloc, nbneed, 1)) == nullptr) {
+        return nullptr;
+    }
+    snprintf(path, nbneed, "%s/%016llx%016llx%s", cache->CacheDirectory, (unsigned long long) key->High, (unsigned long long) key->Low, suffix);
+    return path;
+}
+
+/* @summary Check that every include request recorded in a cache entry still resolves to the recorded file with the recorded content, recording each file as a dependency of the container.
+ * Each request is passed to the include handler of the container's compiler exactly as the compilation passed it, so that a handler which would now resolve it to a different file causes a miss.
+ * @param container The bytecode container being filled from the cache. It must not have any dependencies recorded.
+ * @param hashes The DependencyCount content hashes stored in the entry. The array need not be aligned.
+ * @param types The DependencyCount include types stored in the entry. The array need not be aligned.
+ * @param paths The packed, nul-terminated resolved paths stored in the entry, which have been validated.
+ * @param requests The packed, nul-terminated include path and requesting path pairs stored in the entry, which have been validated.
+ * @param count The number of files recorded in the entry.
+ * @return Non-zero if every file matches, or zero if any file differs or cannot be opened, in which case no dependencies remain recorded.
+ */
+static int32_t
+gpuccBytecodeCacheCheckDependencies
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    uint8_t const                   *hashes,
+    uint8_t const                    *types,
+    char const                       *paths,
+    char const                    *requests,
+    uint32_t                          count
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_INCLUDE_RESULT             result;
+    GPUCC_HASH128                    stored;
+    int32_t                     include_type;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        char const *include_path    = requests;
+        char const *requesting_path = requests + strlen(requests) + 1;
+        int32_t     match           = 0;
+        memcpy(&stored      , hashes + i * sizeof(GPUCC_HASH128), sizeof(GPUCC_HASH128));
+        memcpy(&include_type, types  + i * sizeof(int32_t)      , sizeof(int32_t));
+        if (gpuccOpenInclude(container, include_path, (requesting_path[0] != 0) ? requesting_path : nullptr, include_type, &result) == 0) {
+            gpuccResetDependencies(container);
+            return 0;
+        }
+        /* Paths in an entry are unique, so a request that still resolves to the recorded file was recorded at index i. */
+        if (container_->DependencyCount == i + 1 && strcmp(result.ResolvedPath, paths) == 0 &&
+            container_->DependencyHashes[i].Low  == stored.Low &&
+            container_->DependencyHashes[i].High == stored.High) {
+            match = 1;
+        }
+        gpuccCloseInclude(container, &result);
+        if (match == 0) {
+            gpuccResetDependencies(container);
+            return 0;
+        }
+        paths    += strlen(paths) + 1;
+        requests  = requesting_path + strlen(requesting_path) + 1;
+    }
+    return 1;
+}
+
+/* @summary Count the nul-terminated strings in a packed block, and check that the block ends with a nul.
+ * @param strings The packed strings.
+ * @param nbytes The size of the block, in bytes.
+ * @return The number of strings, or UINT32_MAX if the block is not terminated.
+ */
+static uint32_t
+gpuccBytecodeCacheCountStrings
+(
+    char const *strings,
+    uint32_t     nbytes
+)
+{
+    uint32_t count = 0;
+
+    if (nbytes != 0 && strings[nbytes - 1] != 0) {
+        return UINT32_MAX;
+    }
+    for (uint32_t i = 0; i < nbytes; ++i) {
+        if (strings[i] == 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+GPUCC_API(struct GPUCC_BYTECODE_CACHE*)
+gpuccCreateBytecodeCache
+(
+    char const *cache_directory
+)
+{
+    GPUCC_BYTECODE_CACHE *cache = nullptr;
+    uint8_t               *base = nullptr;
+    uint8_t                *ptr = nullptr;
+    size_t               nbneed = 0;
+    size_t               dirlen = 0;
+
+    if (cache_directory == nullptr || cache_directory[0] == 0) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+
+    /* Strip any trailing path separators; one is added when building file paths. */
+    dirlen = strlen(cache_directory);
+    while (dirlen > 1 && (cache_directory[dirlen - 1] == '/' || cache_directory[dirlen - 1] == '\\')) {
+        dirlen--;
+    }
+
+    /* Allocate as a single block. */
+    nbneed = sizeof(GPUCC_BYTECODE_CACHE) + dirlen + 1;
+    if ((base = (uint8_t*) malloc(nbneed)) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    cache =(GPUCC_BYTECODE_CACHE*) base;
+    ptr   = base + sizeof(GPUCC_BYTECODE_CACHE);
+    memcpy(ptr, cache_directory, dirlen);
+    ptr[dirlen] = 0;
+
+    cache->CacheDirectory  =(char*) ptr;
+    cache->DirectoryLength = dirlen;
+
+    if (g_CacheTempNonce == 0) {
+        std::random_device rd;
+        g_CacheTempNonce = ((uint64_t) rd() << 32) | (uint64_t) rd();
+    }
+    return cache;
+}
+
+GPUCC_API(void)
+gpuccDeleteBytecodeCache
+(
+    struct GPUCC_BYTECODE_CACHE *cache
+)
+{
+    free(cache);
+}
+
+GPUCC_API(struct GPUCC_HASH128)
+gpuccBytecodeCacheKey
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_PROGRAM_COMPILER_BASE  *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) container_->Compiler;
+    uint32_t                  cache_version = GPUCC_BYTECODE_CACHE_VERSION;
+    GPUCC_HASH_STATE                  state;
+
+    gpuccHashInit(&state, 0);
+    gpuccHashUpdate(&state, &cache_version, sizeof(cache_version));
+    gpuccHashUpdate(&state, &compiler_->ConfigHash, sizeof(compiler_->ConfigHash));
+    gpuccHashUpdateString(&state, container_->EntryPoint);
+    if (compiler_->IncludeHandler.Resolve != nullptr) {
+        /* Relative includes resolve against the source path, so the same text in another directory can include different files. */
+        gpuccHashUpdateString(&state, container_->SourcePath);
+    }
+    gpuccHashUpdate(&state, &source_size, sizeof(source_size));
+    gpuccHashUpdate(&state, source_code, (size_t) source_size);
+    return gpuccHashFinal(&state);
+}
+
+GPUCC_API(int32_t)
+gpuccBytecodeCacheLookup
+(
+    struct GPUCC_BYTECODE_CACHE       *cache,
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    struct GPUCC_HASH128 const          *key
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_PROGRAM_COMPILER_BASE  *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) container_->Compiler;
+    GPUCC_HOST_ALLOCATOR const       *alloc =&compiler_->HostAllocator;
+    GPUCC_BYTECODE_CACHE_HEADER      header;
+    FILE                               *fp = nullptr;
+    char                             *path = nullptr;
+    uint8_t                          *data = nullptr;
+    char const                       *deps = nullptr;
+    char const                       *reqs = nullptr;
+    size_t                          nbdata = 0;
+    size_t                          nbhash = 0;
+    size_t                          nbtype = 0;
+    size_t                           nbdep = 0;
+
+    if ((path = gpuccBytecodeCachePath(alloc, cache, key, ".gpucc")) == nullptr) {
+        return 0;
+    }
+    fp = fopen(path, "rb");
+    gpuccHostFree(alloc, path);
+    if (fp == nullptr) { /* Cache miss */
+        return 0;
+    }
+    if (fread(&header, sizeof(header), 1, fp) != 1) {
+        goto cleanup_and_miss;
+    }
+
+    /* Validate the header. Any mismatch is treated as a miss, and the entry will be overwritten by the next store. */
+    if (header.Magic        != GPUCC_BYTECODE_CACHE_MAGIC   ||
+        header.Version      != GPUCC_BYTECODE_CACHE_VERSION ||
+        header.Key.Low      != key->Low                     ||
+        header.Key.High     != key->High                    ||
+        header.CompilerType != compiler_->CompilerType      ||
+        header.BytecodeType != compiler_->BytecodeType      ||
+        header.BytecodeSize == 0) {
+        goto cleanup_and_miss;
+    }
+    /* Included files can only be checked through the include handler. */
+    if (header.DependencyCount != 0 && compiler_->IncludeHandler.Resolve == nullptr) {
+        goto cleanup_and_miss;
+    }
+    nbhash = (size_t) header.DependencyCount * sizeof(GPUCC_HASH128);
+    nbtype = (size_t) header.DependencyCount * sizeof(int32_t);
+    nbdep  = nbhash + nbtype + header.DependencyBytes + header.RequestBytes;
+    if (header.LogBufferSize > (uint64_t) SIZE_MAX - nbdep ||
+        header.BytecodeSize  > (uint64_t) SIZE_MAX - nbdep - header.LogBufferSize) {
+        goto cleanup_and_miss;
+    }
+
+    /* Read the bytecode, log and dependencies into a single buffer owned by the container. */
+    nbdata = (size_t)(header.BytecodeSize + header.LogBufferSize) + nbdep;
+    if ((data = (uint8_t*) gpuccHostAlloc(alloc, nbdata, 1)) == nullptr) {
+        goto cleanup_and_miss;
+    }
+    if (fread(data, 1, nbdata, fp) != nbdata) {
+        goto cleanup_and_miss;
+    }
+    fclose(fp); fp = nullptr;
+
+    /* There must be exactly DependencyCount resolved paths, and an include path and requesting path for each. */
+    reqs = (char const*)(data + nbdata - header.RequestBytes);
+    deps = reqs - header.DependencyBytes;
+    if (gpuccBytecodeCacheCountStrings(deps, header.DependencyBytes) != header.DependencyCount ||
+        gpuccBytecodeCacheCountStrings(reqs, header.RequestBytes   ) != (uint64_t) header.DependencyCount * 2) {
+        goto cleanup_and_miss;
+    }
+    if (gpuccBytecodeCacheCheckDependencies(container, (uint8_t const*) deps - nbtype - nbhash, (uint8_t const*) deps - nbtype, deps, reqs, header.DependencyCount) == 0) {
+        goto cleanup_and_miss;
+    }
+
+    container_->CacheBuffer    = data;
+    container_->BytecodeBuffer = data;
+    container_->BytecodeSize   = header.BytecodeSize;
+    if (header.LogBufferSize != 0) {
+        container_->LogBuffer     =(char*)(data + header.BytecodeSize);
+        container_->LogBufferSize = header.LogBufferSize;
+        container_->LogBuffer[header.LogBufferSize - 1] = 0;
+    } else {
+        container_->LogBuffer     = nullptr;
+        container_->LogBufferSize = 0;
+    }
+    return 1;
+
+cleanup_and_miss:
+    gpuccHostFree(alloc, data);
+    if (fp != nullptr) {
+        fclose(fp);
+    }
+    return 0;
+}
+
+GPUCC_API(int32_t)
+gpuccBytecodeCacheStore
+(
+    struct GPUCC_BYTECODE_CACHE       *cache,
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    struct GPUCC_HASH128 const          *key
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_PROGRAM_COMPILER_BASE  *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) container_->Compiler;
+    GPUCC_HOST_ALLOCATOR const       *alloc =&compiler_->HostAllocator;
+    GPUCC_BYTECODE_CACHE_HEADER      header;
+    FILE                               *fp = nullptr;
+    char                        *tmp_path = nullptr;
+    char                        *dst_path = nullptr;
+    size_t                          nbcode = 0;
+    size_t                           nblog = 0;
+    size_t                          nbhash = 0;
+    size_t                          nbtype = 0;
+    int                                 ok = 1;
+    char    suffix[GPUCC_BYTECODE_CACHE_MAX_NAME];
+
+    if (container_->BytecodeBuffer == nullptr || container_->BytecodeSize == 0) {
+        return 0;
+    }
+    nbcode = (size_t) container_->BytecodeSize;
+    nblog  = (container_->LogBuffer != nullptr) ? (size_t) container_->LogBufferSize : 0;
+    nbhash = (size_t) container_->DependencyCount * sizeof(GPUCC_HASH128);
+    nbtype = (size_t) container_->DependencyCount * sizeof(int32_t);
+
+    /* Write to a uniquely-named temporary file, then rename it into place. */
+    snprintf(suffix, sizeof(suffix), ".%016llx.tmp", (unsigned long long)(g_CacheTempNonce + g_CacheTempCounter.fetch_add(1, std::memory_order_relaxed)));
+    if ((tmp_path = gpuccBytecodeCachePath(alloc, cache, key, suffix)) == nullptr) {
+        return 0;
+    }
+    if ((dst_path = gpuccBytecodeCachePath(alloc, cache, key, ".gpucc")) == nullptr) {
+        gpuccHostFree(alloc, tmp_path);
+        return 0;
+    }
+    if ((fp = fopen(tmp_path, "wb")) == nullptr) {
+        gpuccHostFree(alloc, dst_path);
+        gpuccHostFree(alloc, tmp_path);
+        return 0;
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.Magic         = GPUCC_BYTECODE_CACHE_MAGIC;
+    header.Version       = GPUCC_BYTECODE_CACHE_VERSION;
+    header.Key           =*key;
+    header.BytecodeSize  =(uint64_t) nbcode;
+    header.LogBufferSize =(uint64_t) nblog;
+    header.CompilerType  = compiler_->CompilerType;
+    header.BytecodeType  = compiler_->BytecodeType;
+    header.DependencyCount = container_->DependencyCount;
+    header.DependencyBytes =(uint32_t) container_->DependencyBufferSize;
+    header.RequestBytes    =(uint32_t) container_->DependencyRequestBufferSize;
+
+    if (fwrite(&header, sizeof(header), 1, fp) != 1) {
+        ok = 0;
+    }
+    if (ok && fwrite(container_->BytecodeBuffer, 1, nbcode, fp) != nbcode) {
+        ok = 0;
+    }
+    if (ok && nblog != 0 && fwrite(container_->LogBuffer, 1, nblog, fp) != nblog) {
+        ok = 0;
+    }
+    if (ok && nbhash != 0 && fwrite(container_->DependencyHashes, 1, nbhash, fp) != nbhash) {
+        ok = 0;
+    }
+    if (ok && nbtype != 0 && fwrite(container_->DependencyRequestTypes, 1, nbtype, fp) != nbtype) {
+        ok = 0;
+    }
+    if (ok && header.DependencyBytes != 0 && fwrite(container_->DependencyBuffer, 1, header.DependencyBytes, fp) != header.DependencyBytes) {
+        ok = 0;
+    }
+    if (ok && header.RequestBytes != 0 && fwrite(container_->DependencyRequestBuffer, 1, header.RequestBytes, fp) != header.RequestBytes) {
+        ok = 0;
+    }
+    if (fclose(fp) != 0) {
+        ok = 0;
+    }
+
+    /* rename() fails on some platforms if the destination exists. Since the
+     * cache is content-addressed, an existing entry has the same contents,
+     * so losing the race is not an error. */
+    if (ok == 0 || rename(tmp_path, dst_path) != 0) {
+        remove(tmp_path);
+        ok = 0;
+    }
+    gpuccHostFree(alloc, dst_path);
+    gpuccHostFree(alloc, tmp_path);
+    return ok;
+}
+
+GPUCC_API(void)
+gpuccBytecodeCacheRelease
+(
+    struct GPUCC_PROGRAM_BYTECODE *container
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+
+    if (container_->CacheBuffer != nullptr) {
+        uint8_t *buf = container_->CacheBuffer;
+        container_->BytecodeBuffer = nullptr;
+        container_->BytecodeSize   = 0;
+        container_->LogBuffer      = nullptr;
+        container_->LogBufferSize  = 0;
+        container_->CacheBuffer    = nullptr;
+        gpuccHostFree(gpuccQueryBytecodeHostAllocator_(container), buf);
+    }
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccEnableBytecodeCache
+(
+    char const *cache_directory
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    GPUCC_BYTECODE_CACHE          *cache = nullptr;
+    GPUCC_RESULT                  result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+
+    if (pctx->StartupFlag == 0) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_NOT_INITIALIZED);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    if ((cache = gpuccCreateBytecodeCache(cache_directory)) == nullptr) {
+        /* gpuccCreateBytecodeCache called gpuccSetLastResult. */
+        return gpuccGetLastResult();
+    }
+    gpuccDeleteBytecodeCache(pctx->BytecodeCache);
+    pctx->BytecodeCache = cache;
+    gpuccSetLastResult(result);
+    return result;
+}
+
+GPUCC_API(void)
+gpuccDisableBytecodeCache
+(
+    void
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+
+    gpuccDeleteBytecodeCache(pctx->BytecodeCache);
+    pctx->BytecodeCache = nullptr;
+}
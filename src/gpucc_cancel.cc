@@ -0,0 +1,115 @@
+/**
+ * @summary gpucc_cancel.cc: Implement cancellation tokens and the check made
+ * at each safe point in the compile path.
+ */
+#include <chrono>
+#include <new>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_cancel.h"
+#include "gpucc_async.h"
+
+GPUCC_API(uint64_t)
+gpuccCancelClockNanoseconds
+(
+    void
+)
+{
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+GPUCC_API(struct GPUCC_CANCEL_TOKEN*)
+gpuccRetainCancelToken
+(
+    struct GPUCC_CANCEL_TOKEN *token
+)
+{
+    if (token != nullptr) {
+        token->RefCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return token;
+}
+
+GPUCC_API(void)
+gpuccReleaseCancelToken
+(
+    struct GPUCC_CANCEL_TOKEN *token
+)
+{
+    if (token != nullptr && token->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete token;
+    }
+}
+
+GPUCC_API(int32_t)
+gpuccCancelRequested
+(
+    struct GPUCC_CANCEL_STATE const *state
+)
+{
+    if (state == nullptr) {
+        return 0;
+    }
+    if (state->CancelFlag.load(std::memory_order_relaxed) != 0) {
+        return 1;
+    }
+    if (state->Token != nullptr && state->Token->SignalFlag.load(std::memory_order_relaxed) != 0) {
+        return 1;
+    }
+    if (state->Deadline != GPUCC_CANCEL_NO_DEADLINE && gpuccCancelClockNanoseconds() >= state->Deadline) {
+        return 1;
+    }
+    return 0;
+}
+
+GPUCC_API(struct GPUCC_CANCEL_TOKEN*)
+gpuccCreateCancelToken
+(
+    void
+)
+{
+    GPUCC_CANCEL_TOKEN *token = nullptr;
+
+    if ((token = new (std::nothrow) GPUCC_CANCEL_TOKEN()) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    token->RefCount.store(1, std::memory_order_relaxed);
+    token->SignalFlag.store(0, std::memory_order_relaxed);
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return token;
+}
+
+GPUCC_API(void)
+gpuccDeleteCancelToken
+(
+    struct GPUCC_CANCEL_TOKEN *token
+)
+{
+    gpuccReleaseCancelToken(token);
+}
+
+GPUCC_API(void)
+gpuccSignalCancelToken
+(
+    struct GPUCC_CANCEL_TOKEN *token
+)
+{
+    if (token != nullptr) {
+        token->SignalFlag.store(1, std::memory_order_relaxed);
+        /* Queued jobs using the token in a class that is out of budget can now complete. */
+        gpuccCompilePoolWake(gpuccGetProcessContext_()->CompilePool);
+    }
+}
+
+GPUCC_API(int32_t)
+gpuccQueryCancelTokenSignaled
+(
+    struct GPUCC_CANCEL_TOKEN *token
+)
+{
+    if (token != nullptr) {
+        return token->SignalFlag.load(std::memory_order_relaxed);
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+/**
+ * @summary gpucc_compile.cc: Implement the platform-independent portion of
+ * program compilation, which sits between the public gpuccCompileProgramBytecode
+ * entry point and the compiler backend.
+ */
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_cache.h"
+#include "gpucc_flight.h"
+#include "gpucc_cancel.h"
+#include "gpucc_recycle.h"
+#include "gpucc_stats.h"
+#include "gpucc_trace.h"
+#include "gpucc_worker.h"
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccExecuteCompile
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_PROGRAM_COMPILER_BASE  *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) container_->Compiler;
+    GPUCC_BYTECODE_CACHE             *cache = pctx->BytecodeCache;
+    GPUCC_COMPILE_FLIGHT_TABLE     *flights = pctx->CompileFlights;
+    GPUCC_COMPILE_FLIGHT            *flight = nullptr;
+    GPUCC_RESULT                     result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+    GPUCC_HASH128                       key = {0, 0};
+    GPUCC_HASH128                flight_key = {0, 0};
+    int32_t                          leader = 0;
+    int32_t                       cancelled = 0;
+    uint64_t                          start = gpuccQueryClockNanoseconds();
+
+    container_->BackendInvoked = 0;
+    /* The cache key covers only the main source file and its path. Included files are checked against the entry by the lookup. */
+    if (cache != nullptr) {
+        key = gpuccBytecodeCacheKey(container, source_code, source_size);
+        if (gpuccBytecodeCacheLookup(cache, container, &key)) {
+            gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_CACHE_LOOKUP, start);
+            gpuccRecordCacheLookup(1);
+            container_->CompileResult = result;
+            return result;
+        }
+        gpuccRecordCacheLookup(0);
+    }
+
+    /* If an identical compilation is already in progress, wait for it and share its result rather than compiling again. */
+    if (flights != nullptr) {
+        flight_key = gpuccCompileFlightKey(container, source_code, source_size);
+        flight     = gpuccJoinCompileFlight(flights, &flight_key, &leader);
+        if (flight != nullptr && leader == 0) {
+            uint64_t trace = gpuccTraceBegin();
+            int32_t shared = gpuccWaitCompileFlight(flights, flight, container);
+            gpuccTraceEnd("Wait for identical compilation", trace, nullptr, nullptr);
+            if (shared) {
+                gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_CACHE_LOOKUP, start);
+                return container_->CompileResult;
+            }
+            flight = nullptr; /* The leader could not share its result, or the wait was cancelled */
+        }
+    }
+
+    start = gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_CACHE_LOOKUP, start);
+
+    /* The backend cannot be interrupted once it starts, so this is the last point at which a cancelled job costs nothing. */
+    if (gpuccCancelRequested(container_->CancelState)) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_CANCELLED);
+        container_->CompileResult = result;
+        if (flight != nullptr) {
+            gpuccCompleteCompileFlight(flights, &flight_key, flight, nullptr);
+        }
+        return result;
+    }
+
+    /* Backends record their own phases. Waiting for, or performing, a recycle of the backend objects counts as backend setup. */
+    if (compiler_->WorkerPool != nullptr) {
+        result = gpuccWorkerPoolCompile(container, source_code, source_size);
+        gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_COMPILE, start);
+    } else {
+        gpuccBeginBackendCompile(container_->Compiler);
+        gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_BACKEND_SETUP, start);
+        result = compiler_->CompileBytecode(container, source_code, source_size, container_->SourcePath, container_->EntryPoint);
+        start  = gpuccQueryClockNanoseconds();
+        gpuccEndBackendCompile(container_->Compiler);
+        gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_BACKEND_SETUP, start);
+    }
+    cancelled = gpuccCancelRequested(container_->CancelState);
+    container_->CompileResult  = result;
+    container_->BackendInvoked = 1;
+
+    /* Only successful compilations are cached, so that fixing an external cause of failure does not require clearing the cache.
+     * A compile that succeeded is cached even if the job was cancelled while it ran, since the work is already done. */
+    if (cache != nullptr && gpuccSuccess(result)) {
+        gpuccBytecodeCacheStore(cache, container, &key);
+    }
+    /* Failures are shared too, since the waiters would fail the same way, unless the failure may have been caused by cancellation. */
+    if (flight != nullptr) {
+        gpuccCompleteCompileFlight(flights, &flight_key, flight, (cancelled == 0 || gpuccSuccess(result)) ? container : nullptr);
+    }
+    if (cancelled) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_CANCELLED);
+        container_->CompileResult = result;
+    }
+    return result;
+}
+
+GPUCC_API(uint64_t)
+gpuccRecordCompilePhase
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    int32_t                          phase,
+    uint64_t                         start
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    uint64_t                            now = gpuccQueryClockNanoseconds();
+
+    container_->Timings.PhaseNanoseconds[phase] += now - start;
+    return now;
+}
+
+GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
+gpuccInitCompilerCommon
+(
+    struct GPUCC_PROGRAM_COMPILER      *compiler,
+    struct GPUCC_PROGRAM_COMPILER_INIT   *config
+)
+{
+    int32_t  worker_ok = 0;
+    int32_t recycle_ok = 0;
+
+    gpuccInitIncludeHandler(compiler, config->IncludeHandler);
+    gpuccComputeCompilerConfigHash(compiler, config);
+    gpuccInitLatencyHistogram(compiler, config);
+    /* Both functions always run, so that the fields they initialize are valid when the compiler is deleted. */
+    worker_ok  = gpuccInitWorkerConfig (compiler, config);
+    recycle_ok = gpuccInitRecyclePolicy(compiler, config);
+    if (worker_ok == 0 || recycle_ok == 0) {
+        gpuccDeleteCompiler(compiler);
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    return compiler;
+}
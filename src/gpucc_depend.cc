@@ -0,0 +1,738 @@
+/**
+ * @summary gpucc_depend.cc: Implement dependency tracking. Every file opened
+ * through the include handler is recorded on the bytecode container, and can
+ * be written out as a Makefile-style depfile. The incremental build driver
+ * uses the same information, together with content hashes, to recompile only
+ * the outputs affected by a change.
+ */
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_async.h"
+#include "gpucc_depend.h"
+
+/* @summary Define the number of bytes read at a time when hashing a file.
+ */
+#ifndef GPUCC_BUILD_HASH_CHUNK_SIZE
+#define GPUCC_BUILD_HASH_CHUNK_SIZE                                          65536
+#endif
+
+/* @summary Define the limits used to reject a corrupt build state file before allocating storage for it.
+ */
+#ifndef GPUCC_BUILD_STATE_MAX_PATH
+#define GPUCC_BUILD_STATE_MAX_PATH                                           32768
+#endif
+#ifndef GPUCC_BUILD_STATE_MAX_FILES
+#define GPUCC_BUILD_STATE_MAX_FILES                                          65536
+#endif
+
+/* @summary Compare two 128-bit hash values.
+ * @return Non-zero if the hash values are equal.
+ */
+static inline int32_t
+gpuccHashEqual
+(
+    GPUCC_HASH128 const &a,
+    GPUCC_HASH128 const &b
+)
+{
+    return (a.Low == b.Low && a.High == b.High) ? 1 : 0;
+}
+
+/* @summary Write a path to a depfile, escaping the characters that make and Ninja treat specially.
+ * @param fp The depfile.
+ * @param path A nul-terminated UTF-8 string specifying the path.
+ */
+static void
+gpuccWriteDepfilePath
+(
+    FILE         *fp,
+    char const *path
+)
+{
+    for (char const *p = path; *p != 0; ++p) {
+        switch (*p) {
+            case ' ':
+            case '#':
+                fputc('\\', fp);
+                fputc(*p, fp);
+                break;
+            case '$':
+                fputs("$$", fp);
+                break;
+            default:
+                fputc(*p, fp);
+                break;
+        }
+    }
+}
+
+/* @summary Write a buffer to a file, replacing any existing file.
+ * @param path A nul-terminated UTF-8 string specifying the path of the file.
+ * @param data The data to write. This value may be NULL if size is zero.
+ * @param size The number of bytes to write.
+ * @return Non-zero if the file was written.
+ */
+static int32_t
+gpuccWriteBufferToFile
+(
+    char const *path,
+    void const *data,
+    size_t      size
+)
+{
+    FILE *fp = nullptr;
+    int   ok = 1;
+
+    if ((fp = fopen(path, "wb")) == nullptr) {
+        return 0;
+    }
+    if (size != 0 && fwrite(data, 1, size, fp) != size) {
+        ok = 0;
+    }
+    if (fclose(fp) != 0) {
+        ok = 0;
+    }
+    return ok;
+}
+
+GPUCC_API(int32_t)
+gpuccReadFileToString
+(
+    char const       *path,
+    std::string &o_content
+)
+{
+    FILE      *fp = nullptr;
+    size_t nbread = 0;
+    char    chunk[GPUCC_BUILD_HASH_CHUNK_SIZE];
+
+    o_content.clear();
+    if ((fp = fopen(path, "rb")) == nullptr) {
+        return 0;
+    }
+    while ((nbread = fread(chunk, 1, sizeof(chunk), fp)) != 0) {
+        o_content.append(chunk, nbread);
+    }
+    if (ferror(fp)) {
+        fclose(fp);
+        return 0;
+    }
+    fclose(fp);
+    return 1;
+}
+
+/* @summary Compute the content hash of a file, or retrieve it if it was already computed during the current build.
+ * @param content_map The content hashes computed so far.
+ * @param path The path of the file.
+ * @return The content hash record for the file.
+ */
+static GPUCC_BUILD_CONTENT const&
+gpuccBuildQueryContent
+(
+    GPUCC_BUILD_CONTENT_MAP &content_map,
+    std::string const              &path
+)
+{
+    auto iter = content_map.find(path);
+    if (iter == content_map.end()) {
+        GPUCC_BUILD_CONTENT content;
+        GPUCC_HASH_STATE       hash;
+        FILE                    *fp = nullptr;
+        size_t               nbread = 0;
+        char    chunk[GPUCC_BUILD_HASH_CHUNK_SIZE];
+
+        content.ContentHash.Low  = 0;
+        content.ContentHash.High = 0;
+        content.Exists           = 0;
+        if ((fp = fopen(path.c_str(), "rb")) != nullptr) {
+            gpuccHashInit(&hash, 0);
+            while ((nbread = fread(chunk, 1, sizeof(chunk), fp)) != 0) {
+                gpuccHashUpdate(&hash, chunk, nbread);
+            }
+            if (ferror(fp) == 0) {
+                content.ContentHash = gpuccHashFinal(&hash);
+                content.Exists      = 1;
+            }
+            fclose(fp);
+        }
+        iter = content_map.emplace(path, content).first;
+    }
+    return iter->second;
+}
+
+/* @summary Compute the hash identifying the configuration used to build a single item.
+ * @param config_hash The hash of the compiler configuration.
+ * @param item The item being built.
+ * @return The hash of the compiler configuration and the item entry point.
+ */
+static GPUCC_HASH128
+gpuccBuildItemConfigHash
+(
+    GPUCC_HASH128 const &config_hash,
+    GPUCC_BUILD_ITEM const    *item
+)
+{
+    GPUCC_HASH_STATE hash;
+    gpuccHashInit(&hash, 0);
+    gpuccHashUpdate(&hash, &config_hash.Low , sizeof(config_hash.Low));
+    gpuccHashUpdate(&hash, &config_hash.High, sizeof(config_hash.High));
+    gpuccHashUpdateString(&hash, item->EntryPoint);
+    return gpuccHashFinal(&hash);
+}
+
+/* @summary Load the build state file. A missing, truncated or incompatible file produces an empty state, so every item is rebuilt.
+ * @param state_path A nul-terminated UTF-8 string specifying the path of the build state file.
+ * @param o_state On return, stores the records loaded from the file.
+ */
+static void
+gpuccBuildStateLoad
+(
+    char const        *state_path,
+    GPUCC_BUILD_STATE    &o_state
+)
+{
+    GPUCC_BUILD_STATE_HEADER header;
+    FILE                        *fp = nullptr;
+    std::string                path;
+
+    o_state.clear();
+    if ((fp = fopen(state_path, "rb")) == nullptr) {
+        return;
+    }
+    if (fread(&header, sizeof(header), 1, fp) != 1 || header.Magic != GPUCC_BUILD_STATE_MAGIC || header.Version != GPUCC_BUILD_STATE_VERSION) {
+        fclose(fp);
+        return;
+    }
+    for (uint32_t i = 0; i < header.RecordCount; ++i) {
+        GPUCC_BUILD_STATE_RECORD_HEADER rh;
+        GPUCC_BUILD_RECORD          record;
+        if (fread(&rh, sizeof(rh), 1, fp) != 1 || rh.OutputPathLength > GPUCC_BUILD_STATE_MAX_PATH || rh.FileCount > GPUCC_BUILD_STATE_MAX_FILES) {
+            goto corrupt;
+        }
+        path.resize(rh.OutputPathLength);
+        if (rh.OutputPathLength != 0 && fread(&path[0], 1, rh.OutputPathLength, fp) != rh.OutputPathLength) {
+            goto corrupt;
+        }
+        record.ConfigHash = rh.ConfigHash;
+        record.Files.resize(rh.FileCount);
+        for (uint32_t j = 0; j < rh.FileCount; ++j) {
+            GPUCC_BUILD_STATE_FILE_HEADER fh;
+            if (fread(&fh, sizeof(fh), 1, fp) != 1 || fh.PathLength > GPUCC_BUILD_STATE_MAX_PATH) {
+                goto corrupt;
+            }
+            record.Files[j].ContentHash = fh.ContentHash;
+            record.Files[j].Path.resize(fh.PathLength);
+            if (fh.PathLength != 0 && fread(&record.Files[j].Path[0], 1, fh.PathLength, fp) != fh.PathLength) {
+                goto corrupt;
+            }
+        }
+        o_state[path] = std::move(record);
+    }
+    fclose(fp);
+    return;
+
+corrupt:
+    o_state.clear();
+    fclose(fp);
+}
+
+/* @summary Write the build state file. The state is written to a temporary file, which then replaces the existing file.
+ * @param state_path A nul-terminated UTF-8 string specifying the path of the build state file.
+ * @param state The records to write.
+ * @return Non-zero if the file was written.
+ */
+static int32_t
+gpuccBuildStateSave
+(
+    char const              *state_path,
+    GPUCC_BUILD_STATE const      &state
+)
+{
+    GPUCC_BUILD_STATE_HEADER header;
+    std::string            tmp_path(state_path);
+    FILE                        *fp = nullptr;
+    int                          ok = 1;
+
+    tmp_path.append(".tmp");
+    if ((fp = fopen(tmp_path.c_str(), "wb")) == nullptr) {
+        return 0;
+    }
+    header.Magic       = GPUCC_BUILD_STATE_MAGIC;
+    header.Version     = GPUCC_BUILD_STATE_VERSION;
+    header.RecordCount =(uint32_t) state.size();
+    header.Reserved    = 0;
+    if (fwrite(&header, sizeof(header), 1, fp) != 1) {
+        ok = 0;
+    }
+    for (auto iter = state.begin(); ok && iter != state.end(); ++iter) {
+        GPUCC_BUILD_STATE_RECORD_HEADER rh;
+        rh.ConfigHash       = iter->second.ConfigHash;
+        rh.OutputPathLength =(uint32_t) iter->first.size();
+        rh.FileCount        =(uint32_t) iter->second.Files.size();
+        if (fwrite(&rh, sizeof(rh), 1, fp) != 1 || fwrite(iter->first.data(), 1, iter->first.size(), fp) != iter->first.size()) {
+            ok = 0;
+        }
+        for (size_t j = 0; ok && j < iter->second.Files.size(); ++j) {
+            GPUCC_BUILD_FILE const &file = iter->second.Files[j];
+            GPUCC_BUILD_STATE_FILE_HEADER fh;
+            fh.ContentHash = file.ContentHash;
+            fh.PathLength  =(uint32_t) file.Path.size();
+            fh.Reserved    = 0;
+            if (fwrite(&fh, sizeof(fh), 1, fp) != 1 || fwrite(file.Path.data(), 1, file.Path.size(), fp) != file.Path.size()) {
+                ok = 0;
+            }
+        }
+    }
+    if (fclose(fp) != 0) {
+        ok = 0;
+    }
+
+    /* rename() fails on some platforms if the destination exists. */
+    if (ok && rename(tmp_path.c_str(), state_path) != 0) {
+        remove(state_path);
+        if (rename(tmp_path.c_str(), state_path) != 0) {
+            ok = 0;
+        }
+    }
+    if (ok == 0) {
+        remove(tmp_path.c_str());
+    }
+    return ok;
+}
+
+/* @summary Determine whether an item can be skipped because its output and every file recorded for it are unchanged.
+ * @param state The build state loaded from the build state file.
+ * @param content_map The content hashes computed so far during this build.
+ * @param item The item to check.
+ * @param item_hash The configuration hash for the item, as returned by gpuccBuildItemConfigHash.
+ * @return Non-zero if the item is up-to-date.
+ */
+static int32_t
+gpuccBuildItemIsUpToDate
+(
+    GPUCC_BUILD_STATE const       &state,
+    GPUCC_BUILD_CONTENT_MAP &content_map,
+    GPUCC_BUILD_ITEM const         *item,
+    GPUCC_HASH128 const       &item_hash
+)
+{
+    uint64_t modify_time = 0;
+    uint64_t   file_size = 0;
+    auto            iter = state.find(item->OutputPath);
+
+    if (iter == state.end() || gpuccHashEqual(iter->second.ConfigHash, item_hash) == 0) {
+        return 0;
+    }
+    if (iter->second.Files.empty() || iter->second.Files[0].Path != item->SourcePath) {
+        return 0;
+    }
+    if (gpuccQueryFileInfo(item->OutputPath, &modify_time, &file_size) == 0) {
+        return 0;
+    }
+    if (item->DepfilePath != nullptr && gpuccQueryFileInfo(item->DepfilePath, &modify_time, &file_size) == 0) {
+        return 0;
+    }
+    for (GPUCC_BUILD_FILE const &file : iter->second.Files) {
+        GPUCC_BUILD_CONTENT const &content = gpuccBuildQueryContent(content_map, file.Path);
+        if (content.Exists == 0 || gpuccHashEqual(content.ContentHash, file.ContentHash) == 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* @summary Compile a single out-of-date item and write its output, log and depfile.
+ * @param task The GPUCC_BUILD_TASK to execute.
+ */
+static void
+gpuccBuildTaskExecute
+(
+    GPUCC_COMPILE_TASK *task
+)
+{
+    GPUCC_BUILD_TASK     *build_task =(GPUCC_BUILD_TASK*) task;
+    GPUCC_BUILD_RUN             *run = build_task->Run;
+    GPUCC_BUILD_ITEM const     *item = build_task->Item;
+    GPUCC_PROGRAM_BYTECODE *container = nullptr;
+    GPUCC_RESULT              result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+    std::string               source;
+
+    if (gpuccReadFileToString(item->SourcePath, source) == 0) {
+        result = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+        goto complete;
+    }
+    if ((container = gpuccCreateBytecodeContainer(run->Compiler)) == nullptr) {
+        result = gpuccGetLastResult();
+        goto complete;
+    }
+    result = gpuccCompileProgramBytecode(container, source.data(), (uint64_t) source.size(), item->SourcePath, item->EntryPoint);
+
+    if (item->LogPath != nullptr) {
+        char const *log = gpuccQueryBytecodeLogBuffer(container);
+        size_t    nblog =(size_t) gpuccQueryBytecodeLogSizeBytes(container);
+        if (log == nullptr) {
+            nblog = 0;
+        } else if (nblog != 0 && log[nblog - 1] == 0) {
+            nblog--;
+        }
+        gpuccWriteBufferToFile(item->LogPath, log, nblog);
+    }
+    if (gpuccFailure(result)) {
+        goto complete;
+    }
+    if (gpuccWriteBufferToFile(item->OutputPath, gpuccQueryBytecodeBuffer(container), (size_t) gpuccQueryBytecodeSizeBytes(container)) == 0) {
+        result = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+        goto complete;
+    }
+    if (item->DepfilePath != nullptr && gpuccFailure((result = gpuccWriteDependencyFile(container, item->OutputPath, item->DepfilePath)))) {
+        goto complete;
+    }
+
+    /* Record the hash of the source and of each included file as the backend
+     * saw them, rather than re-reading the files, which may have changed
+     * since they were compiled. */
+    {
+        GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+        GPUCC_HASH_STATE hash;
+        GPUCC_BUILD_FILE file;
+        uint32_t    dep_count = gpuccQueryBytecodeDependencyCount(container);
+        gpuccHashInit(&hash, 0);
+        gpuccHashUpdate(&hash, source.data(), source.size());
+        file.Path        = item->SourcePath;
+        file.ContentHash = gpuccHashFinal(&hash);
+        build_task->Record.ConfigHash = gpuccBuildItemConfigHash(run->ConfigHash, item);
+        build_task->Record.Files.reserve(dep_count + 1);
+        build_task->Record.Files.push_back(file);
+        for (uint32_t i = 0; i < dep_count; ++i) {
+            file.Path        = gpuccQueryBytecodeDependency(container, i);
+            file.ContentHash = container_->DependencyHashes[i];
+            build_task->Record.Files.push_back(file);
+        }
+    }
+
+complete:
+    gpuccDeleteBytecodeContainer(container);
+    build_task->Result->CompileResult = result;
+    build_task->Result->Status        = gpuccSuccess(result) ? GPUCC_BUILD_STATUS_REBUILT : GPUCC_BUILD_STATUS_FAILED;
+    if (gpuccFailure(result)) {
+        run->Batch.FailureCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    gpuccCompileBatchItemComplete(&run->Batch);
+}
+
+GPUCC_API(int32_t)
+gpuccRecordDependency
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                       *path,
+    struct GPUCC_HASH128 const *content_hash,
+    char const               *include_path,
+    char const            *requesting_path,
+    int32_t                   include_type
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_HOST_ALLOCATOR const       *alloc = gpuccQueryBytecodeHostAllocator_(container);
+    size_t                           nbpath = strlen(path) + 1;
+    size_t                            nbinc = 0;
+    size_t                            nbreq = 0;
+
+    if (include_path == nullptr) {
+        include_path = path;
+    }
+    if (requesting_path == nullptr) {
+        requesting_path = "";
+    }
+    nbinc = strlen(include_path) + 1;
+    nbreq = strlen(requesting_path) + 1;
+
+    for (uint32_t i = 0; i < container_->DependencyCount; ++i) {
+        if (strcmp(container_->DependencyBuffer + container_->DependencyOffsets[i], path) == 0) {
+            return 1;
+        }
+    }
+    if (container_->DependencyBufferSize + nbpath > UINT32_MAX || container_->DependencyRequestBufferSize + nbinc + nbreq > UINT32_MAX) {
+        return 0;
+    }
+    if (container_->DependencyCount == container_->DependencyCapacity) {
+        uint32_t     new_cap = (container_->DependencyCapacity != 0) ? container_->DependencyCapacity * 2 : 16;
+        uint32_t       *offs = nullptr;
+        GPUCC_HASH128 *hashes = nullptr;
+        int32_t       *types = nullptr;
+        if ((offs = (uint32_t*) gpuccHostRealloc(alloc, container_->DependencyOffsets, new_cap * sizeof(uint32_t), alignof(uint32_t))) == nullptr) {
+            return 0;
+        }
+        container_->DependencyOffsets  = offs;
+        if ((hashes = (GPUCC_HASH128*) gpuccHostRealloc(alloc, container_->DependencyHashes, new_cap * sizeof(GPUCC_HASH128), alignof(GPUCC_HASH128))) == nullptr) {
+            return 0;
+        }
+        container_->DependencyHashes   = hashes;
+        if ((types = (int32_t*) gpuccHostRealloc(alloc, container_->DependencyRequestTypes, new_cap * sizeof(int32_t), alignof(int32_t))) == nullptr) {
+            return 0;
+        }
+        container_->DependencyRequestTypes = types;
+        container_->DependencyCapacity     = new_cap;
+    }
+    if (container_->DependencyBufferSize + nbpath > container_->DependencyBufferCapacity) {
+        size_t new_cap = (container_->DependencyBufferCapacity != 0) ? container_->DependencyBufferCapacity * 2 : 1024;
+        char      *buf = nullptr;
+        while (new_cap < container_->DependencyBufferSize + nbpath) {
+            new_cap *= 2;
+        }
+        if ((buf = (char*) gpuccHostRealloc(alloc, container_->DependencyBuffer, new_cap, 1)) == nullptr) {
+            return 0;
+        }
+        container_->DependencyBuffer         = buf;
+        container_->DependencyBufferCapacity = new_cap;
+    }
+    if (container_->DependencyRequestBufferSize + nbinc + nbreq > container_->DependencyRequestBufferCapacity) {
+        size_t new_cap = (container_->DependencyRequestBufferCapacity != 0) ? container_->DependencyRequestBufferCapacity * 2 : 1024;
+        char      *buf = nullptr;
+        while (new_cap < container_->DependencyRequestBufferSize + nbinc + nbreq) {
+            new_cap *= 2;
+        }
+        if ((buf = (char*) gpuccHostRealloc(alloc, container_->DependencyRequestBuffer, new_cap, 1)) == nullptr) {
+            return 0;
+        }
+        container_->DependencyRequestBuffer         = buf;
+        container_->DependencyRequestBufferCapacity = new_cap;
+    }
+    memcpy(container_->DependencyBuffer + container_->DependencyBufferSize, path, nbpath);
+    memcpy(container_->DependencyRequestBuffer + container_->DependencyRequestBufferSize, include_path, nbinc);
+    memcpy(container_->DependencyRequestBuffer + container_->DependencyRequestBufferSize + nbinc, requesting_path, nbreq);
+    container_->DependencyHashes      [container_->DependencyCount  ] =*content_hash;
+    container_->DependencyRequestTypes[container_->DependencyCount  ] = include_type;
+    container_->DependencyOffsets     [container_->DependencyCount++] =(uint32_t) container_->DependencyBufferSize;
+    container_->DependencyBufferSize        += nbpath;
+    container_->DependencyRequestBufferSize += nbinc + nbreq;
+    return 1;
+}
+
+GPUCC_API(void)
+gpuccResetDependencies
+(
+    struct GPUCC_PROGRAM_BYTECODE *container
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+
+    container_->DependencyBufferSize        = 0;
+    container_->DependencyRequestBufferSize = 0;
+    container_->DependencyCount             = 0;
+}
+
+GPUCC_API(void)
+gpuccFreeDependencies
+(
+    struct GPUCC_PROGRAM_BYTECODE *container
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_HOST_ALLOCATOR const       *alloc = gpuccQueryBytecodeHostAllocator_(container);
+
+    gpuccHostFree(alloc, container_->DependencyOffsets);
+    gpuccHostFree(alloc, container_->DependencyHashes);
+    gpuccHostFree(alloc, container_->DependencyBuffer);
+    gpuccHostFree(alloc, container_->DependencyRequestTypes);
+    gpuccHostFree(alloc, container_->DependencyRequestBuffer);
+    container_->DependencyOffsets               = nullptr;
+    container_->DependencyHashes                = nullptr;
+    container_->DependencyBuffer                = nullptr;
+    container_->DependencyRequestTypes          = nullptr;
+    container_->DependencyRequestBuffer         = nullptr;
+    container_->DependencyBufferSize            = 0;
+    container_->DependencyBufferCapacity        = 0;
+    container_->DependencyRequestBufferSize     = 0;
+    container_->DependencyRequestBufferCapacity = 0;
+    container_->DependencyCount                 = 0;
+    container_->DependencyCapacity              = 0;
+}
+
+GPUCC_API(uint32_t)
+gpuccQueryBytecodeDependencyCount
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    if (bytecode != nullptr) {
+        return ((GPUCC_PROGRAM_BYTECODE_BASE*) bytecode)->DependencyCount;
+    }
+    return 0;
+}
+
+GPUCC_API(char const*)
+gpuccQueryBytecodeDependency
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode,
+    uint32_t                          index
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *bytecode_ =(GPUCC_PROGRAM_BYTECODE_BASE*) bytecode;
+
+    if (bytecode_ != nullptr && index < bytecode_->DependencyCount) {
+        return bytecode_->DependencyBuffer + bytecode_->DependencyOffsets[index];
+    }
+    return nullptr;
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccWriteDependencyFile
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode,
+    char const                *target_path,
+    char const               *depfile_path
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *bytecode_ =(GPUCC_PROGRAM_BYTECODE_BASE*) bytecode;
+    GPUCC_RESULT                    result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+    FILE                               *fp = nullptr;
+    int                                 ok = 1;
+
+    if (bytecode_ == nullptr || target_path == nullptr || depfile_path == nullptr) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    if (gpuccBytecodeContainerIsEmpty(bytecode)) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    if ((fp = fopen(depfile_path, "wb")) == nullptr) {
+        result = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    gpuccWriteDepfilePath(fp, target_path);
+    fputc(':', fp);
+    if (bytecode_->SourcePath != nullptr && bytecode_->SourcePath[0] != 0) {
+        fputs(" \\\n  ", fp);
+        gpuccWriteDepfilePath(fp, bytecode_->SourcePath);
+    }
+    for (uint32_t i = 0; i < bytecode_->DependencyCount; ++i) {
+        fputs(" \\\n  ", fp);
+        gpuccWriteDepfilePath(fp, bytecode_->DependencyBuffer + bytecode_->DependencyOffsets[i]);
+    }
+    fputc('\n', fp);
+    ok = (ferror(fp) == 0) ? 1 : 0;
+    if (fclose(fp) != 0) {
+        ok = 0;
+    }
+    if (ok == 0) {
+        result = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+        remove(depfile_path);
+    }
+    gpuccSetLastResult(result);
+    return result;
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccBuildIncremental
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT const *config,
+    char const                           *state_path,
+    struct GPUCC_BUILD_ITEM const             *items,
+    struct GPUCC_BUILD_ITEM_RESULT        *o_results,
+    uint32_t                              item_count
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    GPUCC_INCLUDE_CACHE   *include_cache = nullptr;
+    GPUCC_RESULT                  result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+    GPUCC_PROGRAM_COMPILER_INIT   cfg;
+    GPUCC_INCLUDE_HANDLER         handler;
+    GPUCC_BUILD_STATE             state;
+    GPUCC_BUILD_CONTENT_MAP       content_map;
+    std::vector<GPUCC_BUILD_TASK> tasks;
+    std::vector<GPUCC_COMPILE_TASK*> task_list;
+    GPUCC_BUILD_RUN               run;
+
+    if (pctx->StartupFlag == 0 || pctx->CompilePool == nullptr) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_NOT_INITIALIZED);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    if (config == nullptr || state_path == nullptr || (item_count != 0 && (items == nullptr || o_results == nullptr))) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    for (uint32_t i = 0; i < item_count; ++i) {
+        if (items[i].SourcePath == nullptr || items[i].EntryPoint == nullptr || items[i].OutputPath == nullptr) {
+            result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+            gpuccSetLastResult(result);
+            return result;
+        }
+    }
+
+    /* Dependencies are only known for files opened through an include
+     * handler, so supply one if the application did not. */
+    cfg = *config;
+    if (cfg.IncludeHandler == nullptr) {
+        if ((include_cache = gpuccCreateIncludeCache(nullptr, 0)) == nullptr) {
+            return gpuccGetLastResult();
+        }
+        gpuccQueryIncludeCacheHandler(include_cache, &handler);
+        cfg.IncludeHandler =&handler;
+    }
+    if ((run.Compiler = gpuccCreateCompiler(&cfg)) == nullptr) {
+        result = gpuccGetLastResult();
+        gpuccDeleteIncludeCache(include_cache);
+        return result;
+    }
+    run.ConfigHash = ((GPUCC_PROGRAM_COMPILER_BASE*) run.Compiler)->ConfigHash;
+
+    /* Check every item on the calling thread. Each file is hashed at most
+     * once, however many items include it. */
+    gpuccBuildStateLoad(state_path, state);
+    tasks.reserve(item_count);
+    for (uint32_t i = 0; i < item_count; ++i) {
+        GPUCC_HASH128 item_hash = gpuccBuildItemConfigHash(run.ConfigHash, &items[i]);
+        if (gpuccBuildItemIsUpToDate(state, content_map, &items[i], item_hash)) {
+            o_results[i].CompileResult = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+            o_results[i].Status        = GPUCC_BUILD_STATUS_UP_TO_DATE;
+            continue;
+        }
+        tasks.emplace_back();
+        tasks.back().Task.Execute = gpuccBuildTaskExecute;
+        tasks.back().Run          =&run;
+        tasks.back().Item         =&items[i];
+        tasks.back().Result       =&o_results[i];
+    }
+    for (GPUCC_BUILD_TASK &t : tasks) {
+        task_list.push_back(&t.Task);
+    }
+
+    if (tasks.empty() == false) {
+        run.Batch.RemainingCount.store((uint32_t) tasks.size(), std::memory_order_relaxed);
+        run.Batch.FailureCount.store(0, std::memory_order_relaxed);
+        run.Batch.CompileNanoseconds.store(0, std::memory_order_relaxed);
+        run.Batch.MaxItemNanoseconds.store(0, std::memory_order_relaxed);
+        gpuccCompilePoolRunBatch(pctx->CompilePool, &run.Batch, task_list.data(), (uint32_t) tasks.size());
+
+        /* Record what each rebuilt output depends on. Failed items lose their
+         * record, so they are compiled again on the next build. */
+        for (GPUCC_BUILD_TASK &t : tasks) {
+            if (t.Result->Status != GPUCC_BUILD_STATUS_REBUILT) {
+                state.erase(t.Item->OutputPath);
+                continue;
+            }
+            state[t.Item->OutputPath] = std::move(t.Record);
+        }
+        if (gpuccBuildStateSave(state_path, state) == 0) {
+            result = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+        }
+        if (gpuccSuccess(result) && run.Batch.FailureCount.load(std::memory_order_relaxed) != 0) {
+            result = gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
+        }
+    }
+    gpuccDeleteCompiler(run.Compiler);
+    gpuccDeleteIncludeCache(include_cache);
+    gpuccSetLastResult(result);
+    return result;
+}
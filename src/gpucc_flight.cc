@@ -0,0 +1,258 @@
+/**
+ * @summary gpucc_flight.cc: Implement deduplication of identical compilations
+ * that are in progress at the same time. Requests join a flight keyed by the
+ * compilation inputs; the leader compiles, and copies its result into a single
+ * reference-counted block that is attached to the container of every waiter.
+ */
+#include <string.h>
+#include <chrono>
+#include <new>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_cache.h"
+#include "gpucc_depend.h"
+#include "gpucc_cancel.h"
+#include "gpucc_flight.h"
+
+/* @summary Copy the result of a compilation into a new shared result block. The reference count is set when the block is published to the waiters.
+ * @param container The bytecode container holding the result.
+ * @return The shared result, or NULL if memory allocation failed.
+ */
+static GPUCC_SHARED_RESULT*
+gpuccCreateSharedResult
+(
+    GPUCC_PROGRAM_BYTECODE *container
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_HOST_ALLOCATOR const       *alloc = gpuccQueryBytecodeHostAllocator_(container);
+    GPUCC_SHARED_RESULT             *shared = nullptr;
+    uint8_t                            *ptr = nullptr;
+    size_t                           nbcode = 0;
+    size_t                            nblog = 0;
+    size_t                            nbdep = 0;
+    size_t                           nbhash = 0;
+
+    nbcode = (container_->BytecodeBuffer != nullptr) ? (size_t) container_->BytecodeSize  : 0;
+    nblog  = (container_->LogBuffer      != nullptr) ? (size_t) container_->LogBufferSize : 0;
+    nbdep  = container_->DependencyBufferSize;
+    nbhash = container_->DependencyCount * sizeof(GPUCC_HASH128);
+    if ((shared = (GPUCC_SHARED_RESULT*) gpuccHostAlloc(alloc, sizeof(GPUCC_SHARED_RESULT) + nbhash + nbcode + nblog + nbdep, alignof(GPUCC_SHARED_RESULT))) == nullptr) {
+        return nullptr;
+    }
+    ptr = (uint8_t*) shared + sizeof(GPUCC_SHARED_RESULT);
+    new (&shared->RefCount) std::atomic<uint32_t>(0);
+    shared->HostAllocator    =*alloc;
+    shared->CompileResult    = container_->CompileResult;
+    /* The hashes come first, since they need the alignment of the structure. */
+    shared->DependencyHashes = (nbhash != 0) ?(GPUCC_HASH128*) ptr : nullptr;
+    memcpy(ptr, container_->DependencyHashes, nbhash); ptr += nbhash;
+    shared->BytecodeBuffer   = (nbcode != 0) ? ptr : nullptr;
+    shared->BytecodeSize     = nbcode;
+    memcpy(ptr, container_->BytecodeBuffer, nbcode); ptr += nbcode;
+    shared->LogBuffer        = (nblog  != 0) ? (char*) ptr : nullptr;
+    shared->LogBufferSize    = nblog;
+    memcpy(ptr, container_->LogBuffer, nblog); ptr += nblog;
+    shared->DependencyBuffer = (nbdep  != 0) ? (char*) ptr : nullptr;
+    shared->DependencyCount  = container_->DependencyCount;
+    memcpy(ptr, container_->DependencyBuffer, nbdep);
+    return shared;
+}
+
+GPUCC_API(struct GPUCC_COMPILE_FLIGHT_TABLE*)
+gpuccCreateCompileFlightTable
+(
+    void
+)
+{
+    return new (std::nothrow) GPUCC_COMPILE_FLIGHT_TABLE();
+}
+
+GPUCC_API(void)
+gpuccDeleteCompileFlightTable
+(
+    struct GPUCC_COMPILE_FLIGHT_TABLE *table
+)
+{
+    delete table;
+}
+
+GPUCC_API(struct GPUCC_HASH128)
+gpuccCompileFlightKey
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_PROGRAM_COMPILER_BASE  *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) container_->Compiler;
+    GPUCC_INCLUDE_HANDLER const   *handler =&compiler_->IncludeHandler;
+    GPUCC_HASH128                      key = gpuccBytecodeCacheKey(container, source_code, source_size);
+    GPUCC_HASH_STATE                 state;
+
+    if (handler->Resolve == nullptr) {
+        return key;
+    }
+    /* Includes are resolved relative to the source path, and the handler may map the same path to different content. */
+    gpuccHashInit(&state, 1);
+    gpuccHashUpdate(&state, &key, sizeof(key));
+    gpuccHashUpdateString(&state, container_->SourcePath);
+    gpuccHashUpdate(&state, &handler->Resolve , sizeof(handler->Resolve));
+    gpuccHashUpdate(&state, &handler->Release , sizeof(handler->Release));
+    gpuccHashUpdate(&state, &handler->UserData, sizeof(handler->UserData));
+    return gpuccHashFinal(&state);
+}
+
+GPUCC_API(struct GPUCC_COMPILE_FLIGHT*)
+gpuccJoinCompileFlight
+(
+    struct GPUCC_COMPILE_FLIGHT_TABLE *table,
+    struct GPUCC_HASH128 const          *key,
+    int32_t                         *o_leader
+)
+{
+    std::lock_guard<std::mutex> lock(table->Lock);
+    GPUCC_COMPILE_FLIGHT      *flight = nullptr;
+
+    auto iter = table->Flights.find(*key);
+    if (iter != table->Flights.end()) {
+        flight = iter->second;
+        flight->WaiterCount++;
+       *o_leader = 0;
+        return flight;
+    }
+    if ((flight = new (std::nothrow) GPUCC_COMPILE_FLIGHT()) == nullptr) {
+       *o_leader = 0;
+        return nullptr;
+    }
+    flight->Result      = nullptr;
+    flight->WaiterCount = 0;
+    flight->Complete    = false;
+    try {
+        table->Flights.emplace(*key, flight);
+    } catch (std::bad_alloc const&) {
+        delete flight;
+       *o_leader = 0;
+        return nullptr;
+    }
+   *o_leader = 1;
+    return flight;
+}
+
+GPUCC_API(void)
+gpuccCompleteCompileFlight
+(
+    struct GPUCC_COMPILE_FLIGHT_TABLE *table,
+    struct GPUCC_HASH128 const          *key,
+    struct GPUCC_COMPILE_FLIGHT        *flight,
+    struct GPUCC_PROGRAM_BYTECODE   *container
+)
+{
+    GPUCC_SHARED_RESULT *shared = nullptr;
+
+    /* Close the flight, so that no new waiters can join. Later requests start a new flight, or find the result in the bytecode cache. */
+    {
+        std::lock_guard<std::mutex> lock(table->Lock);
+        table->Flights.erase(*key);
+        if (flight->WaiterCount == 0) {
+            delete flight;
+            return;
+        }
+    }
+    /* Copy outside of the lock. */
+    if (container != nullptr) {
+        shared = gpuccCreateSharedResult(container);
+    }
+    {
+        std::lock_guard<std::mutex> lock(table->Lock);
+        /* Waiters that were cancelled have left the flight, possibly all of them. Each remaining waiter receives one reference. */
+        if (flight->WaiterCount == 0) {
+            if (shared != nullptr) {
+                GPUCC_HOST_ALLOCATOR alloc = shared->HostAllocator;
+                gpuccHostFree(&alloc, shared);
+            }
+            delete flight;
+            return;
+        }
+        if (shared != nullptr) {
+            shared->RefCount.store(flight->WaiterCount, std::memory_order_relaxed);
+        }
+        flight->Result   = shared;
+        flight->Complete = true;
+        flight->DoneSignal.notify_all();
+    }
+}
+
+GPUCC_API(int32_t)
+gpuccWaitCompileFlight
+(
+    struct GPUCC_COMPILE_FLIGHT_TABLE *table,
+    struct GPUCC_COMPILE_FLIGHT        *flight,
+    struct GPUCC_PROGRAM_BYTECODE   *container
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_SHARED_RESULT             *shared = nullptr;
+    bool                               last = false;
+    char const                        *path = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(table->Lock);
+        if (container_->CancelState == nullptr) {
+            flight->DoneSignal.wait(lock, [flight] { return flight->Complete; });
+        } else {
+            /* Cancellation is not signaled, so poll for it while waiting. The leader frees the flight if every waiter leaves. */
+            while (!flight->Complete) {
+                if (gpuccCancelRequested(container_->CancelState)) {
+                    flight->WaiterCount--;
+                    return 0;
+                }
+                flight->DoneSignal.wait_for(lock, std::chrono::milliseconds(GPUCC_FLIGHT_CANCEL_POLL_MS));
+            }
+        }
+        shared = flight->Result;
+        last   =(--flight->WaiterCount == 0);
+    }
+    if (last) {
+        delete flight;
+    }
+    if (shared == nullptr) {
+        return 0;
+    }
+    container_->SharedResult   = shared;
+    container_->CompileResult  = shared->CompileResult;
+    container_->BytecodeBuffer = shared->BytecodeBuffer;
+    container_->BytecodeSize   = shared->BytecodeSize;
+    container_->LogBuffer      = shared->LogBuffer;
+    container_->LogBufferSize  = shared->LogBufferSize;
+    /* Dependencies are copied, since the container owns its dependency list and may record more. */
+    path = shared->DependencyBuffer;
+    for (uint32_t i = 0; i < shared->DependencyCount; ++i) {
+        gpuccRecordDependency(container, path, &shared->DependencyHashes[i], nullptr, nullptr, GPUCC_INCLUDE_TYPE_LOCAL);
+        path += strlen(path) + 1;
+    }
+    return 1;
+}
+
+GPUCC_API(void)
+gpuccReleaseSharedResult
+(
+    struct GPUCC_PROGRAM_BYTECODE *container
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+
+    if (container_->SharedResult != nullptr) {
+        GPUCC_SHARED_RESULT *shared = container_->SharedResult;
+        container_->BytecodeBuffer = nullptr;
+        container_->BytecodeSize   = 0;
+        container_->LogBuffer      = nullptr;
+        container_->LogBufferSize  = 0;
+        container_->SharedResult   = nullptr;
+        if (shared->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            GPUCC_HOST_ALLOCATOR alloc = shared->HostAllocator;
+            gpuccHostFree(&alloc, shared);
+        }
+    }
+}
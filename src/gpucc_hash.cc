@@ -0,0 +1,210 @@
+/**
+ * @summary gpucc_hash.cc: Implement the 128-bit hash function used to build
+ * content-addressed keys for compiled bytecode. The hash function is the
+ * x64 128-bit variant of MurmurHash3, restructured so that input can be
+ * supplied incrementally.
+ */
+#include <string.h>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+
+/* @summary Rotate a 64-bit value left by a given number of bits.
+ * @param _x The 64-bit value to rotate.
+ * @param _r The number of bits to rotate by, in [1, 63].
+ */
+#ifndef GPUCC_ROTL64
+#define GPUCC_ROTL64(_x, _r)                                                   \
+    (((_x) << (_r)) | ((_x) >> (64 - (_r))))
+#endif
+
+static uint64_t const GPUCC_HASH_C1 = 0x87C37B91114253D5ULL;
+static uint64_t const GPUCC_HASH_C2 = 0x4CF5AD432745937FULL;
+
+/* @summary Perform the final avalanche step for one half of the hash state.
+ * @param k The 64-bit value to mix.
+ * @return The mixed value.
+ */
+static inline uint64_t
+gpuccHashFmix64
+(
+    uint64_t k
+)
+{
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33;
+    k *= 0xC4CEB9FE1A85EC53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+/* @summary Mix one complete 16-byte block into the hash state.
+ * Blocks are read as two little-endian 64-bit values, matching the reference implementation on little-endian hosts.
+ * @param state The hash state to update.
+ * @param block A pointer to 16 bytes of input data.
+ */
+static inline void
+gpuccHashBlock
+(
+    struct GPUCC_HASH_STATE *state,
+    uint8_t const            *block
+)
+{
+    uint64_t h1 = state->H1;
+    uint64_t h2 = state->H2;
+    uint64_t k1;
+    uint64_t k2;
+
+    memcpy(&k1, block + 0, sizeof(uint64_t));
+    memcpy(&k2, block + 8, sizeof(uint64_t));
+
+    k1 *= GPUCC_HASH_C1; k1 = GPUCC_ROTL64(k1, 31); k1 *= GPUCC_HASH_C2; h1 ^= k1;
+    h1  = GPUCC_ROTL64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52DCE729;
+    k2 *= GPUCC_HASH_C2; k2 = GPUCC_ROTL64(k2, 33); k2 *= GPUCC_HASH_C1; h2 ^= k2;
+    h2  = GPUCC_ROTL64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495AB5;
+
+    state->H1 = h1;
+    state->H2 = h2;
+}
+
+GPUCC_API(void)
+gpuccHashInit
+(
+    struct GPUCC_HASH_STATE *state,
+    uint64_t                  seed
+)
+{
+    state->H1        = seed;
+    state->H2        = seed;
+    state->TotalSize = 0;
+    state->TailSize  = 0;
+    memset(state->Tail, 0, sizeof(state->Tail));
+}
+
+GPUCC_API(void)
+gpuccHashUpdate
+(
+    struct GPUCC_HASH_STATE *state,
+    void const               *data,
+    size_t                    size
+)
+{
+    uint8_t const *p =(uint8_t const*) data;
+
+    if (size == 0) {
+        return;
+    } state->TotalSize += size;
+
+    /* Complete any partial block left over from the previous update. */
+    if (state->TailSize != 0) {
+        size_t nb = sizeof(state->Tail) - state->TailSize;
+        if (nb > size) {
+            nb = size;
+        }
+        memcpy(state->Tail + state->TailSize, p, nb);
+        state->TailSize += (uint32_t) nb;
+        p    += nb;
+        size -= nb;
+        if (state->TailSize < sizeof(state->Tail)) {
+            return;
+        }
+        gpuccHashBlock(state, state->Tail);
+        state->TailSize = 0;
+    }
+    /* Process complete blocks directly from the input buffer. */
+    while (size >= sizeof(state->Tail)) {
+        gpuccHashBlock(state, p);
+        p    += sizeof(state->Tail);
+        size -= sizeof(state->Tail);
+    }
+    /* Save any remainder for the next update or finalization. */
+    if (size != 0) {
+        memcpy(state->Tail, p, size);
+        state->TailSize = (uint32_t) size;
+    }
+}
+
+GPUCC_API(void)
+gpuccHashUpdateString
+(
+    struct GPUCC_HASH_STATE *state,
+    char const                *str
+)
+{
+    if (str != nullptr) {
+        gpuccHashUpdate(state, str, strlen(str) + 1);
+    } else {
+        gpuccHashUpdate(state, "", 1);
+    }
+}
+
+GPUCC_API(struct GPUCC_HASH128)
+gpuccHashFinal
+(
+    struct GPUCC_HASH_STATE *state
+)
+{
+    uint8_t const *tail = state->Tail;
+    uint64_t         h1 = state->H1;
+    uint64_t         h2 = state->H2;
+    uint64_t         k1 = 0;
+    uint64_t         k2 = 0;
+    GPUCC_HASH128     r;
+
+    for (uint32_t i = state->TailSize; i > 8; --i) {
+        k2 ^= (uint64_t) tail[i - 1] << ((i - 9) * 8);
+    }
+    if (state->TailSize > 8) {
+        k2 *= GPUCC_HASH_C2; k2 = GPUCC_ROTL64(k2, 33); k2 *= GPUCC_HASH_C1; h2 ^= k2;
+    }
+    for (uint32_t i = state->TailSize < 8 ? state->TailSize : 8; i > 0; --i) {
+        k1 ^= (uint64_t) tail[i - 1] << ((i - 1) * 8);
+    }
+    if (state->TailSize > 0) {
+        k1 *= GPUCC_HASH_C1; k1 = GPUCC_ROTL64(k1, 31); k1 *= GPUCC_HASH_C2; h1 ^= k1;
+    }
+
+    h1 ^= state->TotalSize;
+    h2 ^= state->TotalSize;
+    h1 += h2;
+    h2 += h1;
+    h1  = gpuccHashFmix64(h1);
+    h2  = gpuccHashFmix64(h2);
+    h1 += h2;
+    h2 += h1;
+
+    r.Low  = h1;
+    r.High = h2;
+    return r;
+}
+
+GPUCC_API(void)
+gpuccComputeCompilerConfigHash
+(
+    struct GPUCC_PROGRAM_COMPILER      *compiler,
+    struct GPUCC_PROGRAM_COMPILER_INIT   *config
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+    GPUCC_HASH_STATE                 state;
+    int32_t                      version[3] ={GPUCC_VERSION_MAJOR, GPUCC_VERSION_MINOR, GPUCC_VERSION_PATCH};
+
+    /* Each field is hashed at a fixed width so that the hash does not depend on structure padding. */
+    gpuccHashInit(&state, 0);
+    gpuccHashUpdate(&state, version, sizeof(version));
+    gpuccHashUpdate(&state, &compiler_->CompilerType  , sizeof(compiler_->CompilerType));
+    gpuccHashUpdate(&state, &compiler_->BytecodeType  , sizeof(compiler_->BytecodeType));
+    gpuccHashUpdate(&state, &compiler_->BackendVersion, sizeof(compiler_->BackendVersion));
+    gpuccHashUpdate(&state, &config->TargetRuntime    , sizeof(config->TargetRuntime));
+    gpuccHashUpdate(&state, &config->CompilerFlags    , sizeof(config->CompilerFlags));
+    gpuccHashUpdateString(&state, config->TargetProfile);
+    gpuccHashUpdate(&state, &config->DefineCount      , sizeof(config->DefineCount));
+    for (uint32_t i = 0, n = config->DefineCount; i < n; ++i) {
+        /* A NULL value and an empty value may define the symbol differently, so a presence byte keeps them from hashing the same. */
+        uint8_t present = (config->DefineValues[i] != nullptr) ? 1 : 0;
+        gpuccHashUpdateString(&state, config->DefineSymbols[i]);
+        gpuccHashUpdate(&state, &present, sizeof(present));
+        gpuccHashUpdateString(&state, config->DefineValues [i]);
+    }
+    compiler_->ConfigHash = gpuccHashFinal(&state);
+}
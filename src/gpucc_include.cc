@@ -0,0 +1,517 @@
+/**
+ * @summary gpucc_include.cc: Implement #include resolution. Backends call
+ * gpuccOpenInclude from their native include callbacks, and the built-in
+ * include cache shares one copy of each header across every compile in the
+ * process, re-reading a file only when its modification time or size changes.
+ */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_include.h"
+#include "gpucc_depend.h"
+#include "gpucc_cancel.h"
+
+/* @summary Drop a reference to a cached include file, freeing it when the last reference is released.
+ * @param file The include file record.
+ */
+static void
+gpuccIncludeFileRelease
+(
+    GPUCC_INCLUDE_FILE *file
+)
+{
+    if (file->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        file->~GPUCC_INCLUDE_FILE();
+        free(file);
+    }
+}
+
+/* @summary Read a file from disk into a new include file record.
+ * @param path A nul-terminated UTF-8 string specifying the path of the file.
+ * @param modify_time The modification time of the file, as returned by gpuccQueryFileInfo.
+ * @param file_size The size of the file, as returned by gpuccQueryFileInfo.
+ * @return The new record, with a reference count of one, or NULL if the file could not be read.
+ */
+static GPUCC_INCLUDE_FILE*
+gpuccIncludeFileLoad
+(
+    char const       *path,
+    uint64_t   modify_time,
+    uint64_t     file_size
+)
+{
+    GPUCC_INCLUDE_FILE *file = nullptr;
+    FILE                 *fp = nullptr;
+    uint8_t            *base = nullptr;
+    uint8_t             *ptr = nullptr;
+    size_t            nbread = 0;
+    size_t            nbpath = strlen(path) + 1;
+
+    if (file_size > (uint64_t) SIZE_MAX - sizeof(GPUCC_INCLUDE_FILE) - nbpath - 1) {
+        return nullptr;
+    }
+    if ((fp = fopen(path, "rb")) == nullptr) {
+        return nullptr;
+    }
+    if ((base = (uint8_t*) malloc(sizeof(GPUCC_INCLUDE_FILE) + nbpath + (size_t) file_size + 1)) == nullptr) {
+        fclose(fp);
+        return nullptr;
+    }
+    file = new (base) GPUCC_INCLUDE_FILE();
+    ptr  = base + sizeof(GPUCC_INCLUDE_FILE);
+    file->Path    =(char*) ptr; memcpy(ptr, path, nbpath); ptr += nbpath;
+    file->Content =(char*) ptr;
+
+    /* The file may have been truncated since it was examined, in which
+     * case the shorter content is kept. The mismatched size forces a reload
+     * on the next lookup. */
+    nbread = fread(file->Content, 1, (size_t) file_size, fp);
+    fclose(fp);
+    file->Content[nbread] = 0;
+    file->ContentSize     = nbread;
+    file->ModifyTime      = modify_time;
+    file->FileSize        = file_size;
+    file->RefCount.store(1, std::memory_order_relaxed);
+    return file;
+}
+
+/* @summary Retrieve the current version of a file from an include cache, loading it if it is not present or has changed on disk.
+ * @param cache The include cache.
+ * @param path A nul-terminated UTF-8 string specifying the candidate path.
+ * @return The file record, with a reference held on behalf of the caller, or NULL if the path does not specify a readable file.
+ */
+static GPUCC_INCLUDE_FILE*
+gpuccIncludeCacheAcquire
+(
+    GPUCC_INCLUDE_CACHE *cache,
+    char const           *path
+)
+{
+    GPUCC_INCLUDE_FILE *file = nullptr;
+    uint64_t      modify_time = 0;
+    uint64_t        file_size = 0;
+
+    if (gpuccQueryFileInfo(path, &modify_time, &file_size) == 0) {
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(cache->Lock);
+        auto iter = cache->Files.find(path);
+        if (iter != cache->Files.end() && iter->second->ModifyTime == modify_time && iter->second->FileSize == file_size) {
+            iter->second->RefCount.fetch_add(1, std::memory_order_relaxed);
+            return iter->second;
+        }
+    }
+
+    /* Read the file without holding the lock. If another thread loaded the
+     * same version in the meantime, its copy wins and this one is dropped. */
+    if ((file = gpuccIncludeFileLoad(path, modify_time, file_size)) == nullptr) {
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(cache->Lock);
+        GPUCC_INCLUDE_FILE *&slot = cache->Files[path];
+        if (slot != nullptr && slot->ModifyTime == modify_time && slot->FileSize == file_size) {
+            slot->RefCount.fetch_add(1, std::memory_order_relaxed);
+            gpuccIncludeFileRelease(file);
+            return slot;
+        }
+        if (slot != nullptr) {
+            gpuccIncludeFileRelease(slot);
+        }
+        file->RefCount.fetch_add(1, std::memory_order_relaxed);
+        slot = file;
+    }
+    return file;
+}
+
+/* @summary Implement PFN_GpuCC_ResolveInclude for an include cache.
+ * Quoted includes search the directory of the including file first. Absolute paths are used as-is.
+ */
+static int32_t
+gpuccIncludeCacheResolve
+(
+    void                         *user_data,
+    char const                *include_path,
+    char const             *requesting_path,
+    int32_t                    include_type,
+    struct GPUCC_INCLUDE_RESULT   *o_result
+)
+{
+    GPUCC_INCLUDE_CACHE *cache =(GPUCC_INCLUDE_CACHE*) user_data;
+    GPUCC_INCLUDE_FILE   *file = nullptr;
+    std::string      candidate;
+
+    if (gpuccPathIsAbsolute(include_path)) {
+        file = gpuccIncludeCacheAcquire(cache, include_path);
+    } else if (include_type == GPUCC_INCLUDE_TYPE_LOCAL) {
+        /* Without a requesting path, the backend has already joined the
+         * path to the including directory, or it is relative to the working directory. */
+        if (requesting_path != nullptr) {
+            candidate.assign(requesting_path, gpuccPathDirectoryLength(requesting_path));
+        }
+        candidate.append(include_path);
+        file = gpuccIncludeCacheAcquire(cache, candidate.c_str());
+    }
+    for (uint32_t i = 0, n = cache->SearchPathCount; file == nullptr && i < n && gpuccPathIsAbsolute(include_path) == 0; ++i) {
+        candidate.assign(cache->SearchPaths[i]);
+        candidate.append(include_path);
+        file = gpuccIncludeCacheAcquire(cache, candidate.c_str());
+    }
+    if (file == nullptr) {
+        return 0;
+    }
+    o_result->ResolvedPath = file->Path;
+    o_result->Content      = file->Content;
+    o_result->ContentSize  = file->ContentSize;
+    o_result->Context      = file;
+    return 1;
+}
+
+/* @summary Implement PFN_GpuCC_ReleaseInclude for an include cache.
+ */
+static void
+gpuccIncludeCacheRelease
+(
+    void                     *user_data,
+    struct GPUCC_INCLUDE_RESULT *result
+)
+{
+    UNREFERENCED_PARAMETER(user_data);
+    gpuccIncludeFileRelease((GPUCC_INCLUDE_FILE*) result->Context);
+}
+
+/* @summary Find the next #include directive in a buffer of source code.
+ * @param ptr The position at which to start scanning. This must be the start of a line.
+ * @param end The end of the source code buffer.
+ * @param o_name On return, points to the first character of the include name, which is not nul-terminated.
+ * @param o_name_len On return, stores the number of bytes in the include name.
+ * @param o_type On return, stores one of the values of the GPUCC_INCLUDE_TYPE enumeration.
+ * @return The start of the line following the directive, or NULL if no more directives were found.
+ */
+static char const*
+gpuccScanIncludeDirective
+(
+    char const        *ptr,
+    char const        *end,
+    char const   **o_name,
+    size_t    *o_name_len,
+    int32_t       *o_type
+)
+{
+    while (ptr < end) {
+        char const *eol = (char const*) memchr(ptr, '\n', (size_t)(end - ptr));
+        char const  *p  = ptr;
+        char        term;
+        if (eol == nullptr) {
+            eol = end;
+        }
+        ptr = (eol < end) ? eol + 1 : end;
+        while (p < eol && (*p == ' ' || *p == '\t')) ++p;
+        if (p >= eol || *p++ != '#') {
+            continue;
+        }
+        while (p < eol && (*p == ' ' || *p == '\t')) ++p;
+        if ((size_t)(eol - p) < 7 || memcmp(p, "include", 7) != 0) {
+            continue;
+        }
+        p += 7;
+        while (p < eol && (*p == ' ' || *p == '\t')) ++p;
+        if (p >= eol || (*p != '"' && *p != '<')) {
+            continue;
+        }
+        term    = (*p == '"') ? '"' : '>';
+       *o_type  = (*p == '"') ? GPUCC_INCLUDE_TYPE_LOCAL : GPUCC_INCLUDE_TYPE_SYSTEM;
+       *o_name  = ++p;
+        while (p < eol && *p != term) ++p;
+        if (p >= eol || p == *o_name) {
+            continue;
+        }
+       *o_name_len = (size_t)(p - *o_name);
+        return ptr;
+    }
+    return nullptr;
+}
+
+/* @summary Resolve the #include directives in one file and append the results to an include list, recursing into each newly added header.
+ * @return Non-zero if the scan completed, or zero if memory allocation failed.
+ */
+static int32_t
+gpuccCollectIncludesRecursive
+(
+    GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *code,
+    size_t                     nbcode,
+    char const        *requesting_path,
+    GPUCC_INCLUDE_LIST           *list,
+    uint32_t                    depth
+)
+{
+    GPUCC_HOST_ALLOCATOR const *alloc = gpuccQueryBytecodeHostAllocator_(container);
+    char const                   *ptr = code;
+    char const                   *end = code + nbcode;
+    char const                  *name = nullptr;
+    size_t                   name_len = 0;
+    int32_t                      type = GPUCC_INCLUDE_TYPE_LOCAL;
+
+    if (depth >= GPUCC_MAX_INCLUDE_DEPTH) {
+        return 1;
+    }
+    while ((ptr = gpuccScanIncludeDirective(ptr, end, &name, &name_len, &type)) != nullptr) {
+        GPUCC_INCLUDE_RESULT result;
+        char                 *copy = nullptr;
+        uint32_t                 i = 0;
+
+        for (i = 0; i < list->Count; ++i) {
+            if (strncmp(list->Names[i], name, name_len) == 0 && list->Names[i][name_len] == 0) {
+                break;
+            }
+        }
+        if (i != list->Count) {
+            continue;
+        }
+        if (list->Count == list->Capacity) {
+            uint32_t          new_cap = (list->Capacity != 0) ? list->Capacity * 2 : 8;
+            GPUCC_INCLUDE_RESULT *res = nullptr;
+            char const        **names = nullptr;
+            char const     **contents = nullptr;
+            if ((res = (GPUCC_INCLUDE_RESULT*) gpuccHostRealloc(alloc, list->Results, new_cap * sizeof(GPUCC_INCLUDE_RESULT), alignof(GPUCC_INCLUDE_RESULT))) == nullptr) {
+                return 0;
+            } list->Results = res;
+            if ((names = (char const**) gpuccHostRealloc(alloc, list->Names, new_cap * sizeof(char const*), alignof(char const*))) == nullptr) {
+                return 0;
+            } list->Names = names;
+            if ((contents = (char const**) gpuccHostRealloc(alloc, list->Contents, new_cap * sizeof(char const*), alignof(char const*))) == nullptr) {
+                return 0;
+            } list->Contents = contents;
+            list->Capacity = new_cap;
+        }
+        if ((copy = (char*) gpuccHostAlloc(alloc, name_len + 1, 1)) == nullptr) {
+            return 0;
+        }
+        memcpy(copy, name, name_len);
+        copy[name_len] = 0;
+        if (gpuccOpenInclude(container, copy, requesting_path, type, &result) == 0) {
+            /* Leave the directive for the backend to report. */
+            gpuccHostFree(alloc, copy);
+            continue;
+        }
+        list->Results [list->Count] = result;
+        list->Names   [list->Count] = copy;
+        list->Contents[list->Count] = result.Content;
+        list->Count++;
+        if (gpuccCollectIncludesRecursive(container, result.Content, (size_t) result.ContentSize, result.ResolvedPath, list, depth + 1) == 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+GPUCC_API(void)
+gpuccInitIncludeHandler
+(
+    struct GPUCC_PROGRAM_COMPILER     *compiler,
+    struct GPUCC_INCLUDE_HANDLER const *handler
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+
+    if (handler != nullptr) {
+        compiler_->IncludeHandler = *handler;
+    } else {
+        compiler_->IncludeHandler.Resolve  = nullptr;
+        compiler_->IncludeHandler.Release  = nullptr;
+        compiler_->IncludeHandler.UserData = nullptr;
+    }
+}
+
+GPUCC_API(int32_t)
+gpuccOpenInclude
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const               *include_path,
+    char const            *requesting_path,
+    int32_t                   include_type,
+    struct GPUCC_INCLUDE_RESULT  *o_result
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) gpuccQueryBytecodeCompiler_(container);
+    GPUCC_INCLUDE_HANDLER const   *handler =&compiler_->IncludeHandler;
+    GPUCC_HASH_STATE                  state;
+    GPUCC_HASH128                      hash;
+
+    memset(o_result, 0, sizeof(GPUCC_INCLUDE_RESULT));
+    if (handler->Resolve == nullptr || include_path == nullptr) {
+        return 0;
+    }
+    /* Failing the include is the only way to make the backend stop early when the job is cancelled. */
+    if (gpuccCancelRequested(((GPUCC_PROGRAM_BYTECODE_BASE*) container)->CancelState)) {
+        return 0;
+    }
+    if (handler->Resolve(handler->UserData, include_path, requesting_path, include_type, o_result) == 0) {
+        return 0;
+    }
+    if (o_result->ResolvedPath == nullptr) {
+        o_result->ResolvedPath = include_path;
+    }
+    /* An unrecorded dependency would let an incremental build miss a change, so treat failure as an unresolved include.
+     * The content is hashed as served, so the record matches what the backend compiled even if the file changes afterwards. */
+    gpuccHashInit(&state, 0);
+    gpuccHashUpdate(&state, o_result->Content, (size_t) o_result->ContentSize);
+    hash = gpuccHashFinal(&state);
+    if (gpuccRecordDependency(container, o_result->ResolvedPath, &hash, include_path, requesting_path, include_type) == 0) {
+        gpuccCloseInclude(container, o_result);
+        memset(o_result, 0, sizeof(GPUCC_INCLUDE_RESULT));
+        return 0;
+    }
+    return 1;
+}
+
+GPUCC_API(void)
+gpuccCloseInclude
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    struct GPUCC_INCLUDE_RESULT      *result
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) gpuccQueryBytecodeCompiler_(container);
+    GPUCC_INCLUDE_HANDLER const   *handler =&compiler_->IncludeHandler;
+
+    if (handler->Release != nullptr) {
+        handler->Release(handler->UserData, result);
+    }
+}
+
+GPUCC_API(int32_t)
+gpuccCollectIncludes
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const              *source_code,
+    uint64_t                 source_size,
+    char const              *source_path,
+    struct GPUCC_INCLUDE_LIST      *list
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) gpuccQueryBytecodeCompiler_(container);
+
+    if (compiler_->IncludeHandler.Resolve == nullptr) {
+        return 1;
+    }
+    return gpuccCollectIncludesRecursive(container, source_code, (size_t) source_size, source_path, list, 0);
+}
+
+GPUCC_API(void)
+gpuccReleaseIncludes
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    struct GPUCC_INCLUDE_LIST      *list
+)
+{
+    GPUCC_HOST_ALLOCATOR const *alloc = gpuccQueryBytecodeHostAllocator_(container);
+
+    for (uint32_t i = 0; i < list->Count; ++i) {
+        gpuccCloseInclude(container, &list->Results[i]);
+        gpuccHostFree(alloc, (void*) list->Names[i]);
+    }
+    gpuccHostFree(alloc, list->Contents);
+    gpuccHostFree(alloc, (void*) list->Names);
+    gpuccHostFree(alloc, list->Results);
+    memset(list, 0, sizeof(GPUCC_INCLUDE_LIST));
+}
+
+GPUCC_API(struct GPUCC_INCLUDE_CACHE*)
+gpuccCreateIncludeCache
+(
+    char const      **search_paths,
+    uint32_t     search_path_count
+)
+{
+    GPUCC_INCLUDE_CACHE *cache = nullptr;
+    uint8_t              *base = nullptr;
+    uint8_t               *ptr = nullptr;
+    size_t              nbneed = 0;
+
+    if (search_path_count != 0 && search_paths == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < search_path_count; ++i) {
+        if (search_paths[i] == nullptr) {
+            gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+            return nullptr;
+        }
+    }
+
+    /* Allocate the search path array and strings as a single block.
+     * Each path is stored with a trailing separator, so candidates are formed by simple concatenation. */
+    nbneed = search_path_count * sizeof(char*);
+    for (uint32_t i = 0; i < search_path_count; ++i) {
+        nbneed += strlen(search_paths[i]) + 2;
+    }
+    if ((cache = new (std::nothrow) GPUCC_INCLUDE_CACHE()) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    if (nbneed != 0 && (base = (uint8_t*) malloc(nbneed)) == nullptr) {
+        delete cache;
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    cache->SearchPaths     =(char**) base;
+    cache->SearchPathCount = search_path_count;
+    ptr = base + search_path_count * sizeof(char*);
+    for (uint32_t i = 0; i < search_path_count; ++i) {
+        size_t len = strlen(search_paths[i]);
+        cache->SearchPaths[i] =(char*) ptr;
+        memcpy(ptr, search_paths[i], len);
+        if (len != 0 && gpuccPathDirectoryLength(search_paths[i]) != len) {
+            ptr[len++] = '/';
+        }
+        ptr[len] = 0;
+        ptr += len + 1;
+    }
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return cache;
+}
+
+GPUCC_API(void)
+gpuccDeleteIncludeCache
+(
+    struct GPUCC_INCLUDE_CACHE *cache
+)
+{
+    if (cache != nullptr) {
+        for (auto &entry : cache->Files) {
+            gpuccIncludeFileRelease(entry.second);
+        }
+        free(cache->SearchPaths);
+        delete cache;
+    }
+}
+
+GPUCC_API(void)
+gpuccQueryIncludeCacheHandler
+(
+    struct GPUCC_INCLUDE_CACHE       *cache,
+    struct GPUCC_INCLUDE_HANDLER *o_handler
+)
+{
+    if (o_handler == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return;
+    }
+    if (cache == nullptr) {
+        o_handler->Resolve  = nullptr;
+        o_handler->Release  = nullptr;
+        o_handler->UserData = nullptr;
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return;
+    }
+    o_handler->Resolve  = gpuccIncludeCacheResolve;
+    o_handler->Release  = gpuccIncludeCacheRelease;
+    o_handler->UserData = cache;
+}
@@ -0,0 +1,591 @@
+/**
+ * @summary gpucc_permute.cc: Implement permutation expansion. Every
+ * combination of axis values that is not excluded is compiled on the worker
+ * pool with a transient compiler, and byte-identical outputs are merged so
+ * that each distinct blob is stored only once.
+ */
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_async.h"
+#include "gpucc_permute.h"
+
+/* @summary Determine whether a permutation is matched by any of the exclusion rules in a permutation spec.
+ * @param spec The permutation spec.
+ * @param indices An array of spec->AxisCount value indices specifying the permutation.
+ * @return Non-zero if the permutation is excluded.
+ */
+static int32_t
+gpuccPermutationIsExcluded
+(
+    GPUCC_PERMUTATION_SPEC const *spec,
+    uint32_t const            *indices
+)
+{
+    for (uint32_t r = 0, nr = spec->ExclusionCount; r < nr; ++r) {
+        uint32_t const *rule = &spec->ExclusionRules[(size_t) r * spec->AxisCount];
+        uint32_t           a = 0;
+        for (uint32_t na = spec->AxisCount; a < na; ++a) {
+            if (rule[a] != GPUCC_PERMUTATION_ANY && rule[a] != indices[a]) {
+                break;
+            }
+        }
+        if (a == spec->AxisCount) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* @summary Advance to the next permutation, with axis zero varying fastest, so that keys are visited in increasing order.
+ * @param spec The permutation spec.
+ * @param indices An array of spec->AxisCount value indices, updated in place.
+ * @return Non-zero if indices specifies the next permutation, or zero if every permutation has been visited.
+ */
+static int32_t
+gpuccPermutationAdvance
+(
+    GPUCC_PERMUTATION_SPEC const *spec,
+    uint32_t                  *indices
+)
+{
+    for (uint32_t a = 0, na = spec->AxisCount; a < na; ++a) {
+        if (++indices[a] < spec->Axes[a].ValueCount) {
+            return 1;
+        }
+        indices[a] = 0;
+    }
+    return 0;
+}
+
+/* @summary Compile a single permutation with a transient compiler and retain a copy of the output.
+ * @param task The GPUCC_PERMUTATION_TASK to execute.
+ */
+static void
+gpuccPermutationTaskExecute
+(
+    GPUCC_COMPILE_TASK *task
+)
+{
+    GPUCC_PERMUTATION_TASK   *perm_task =(GPUCC_PERMUTATION_TASK*) task;
+    GPUCC_PERMUTATION_RUN          *run = perm_task->Run;
+    GPUCC_PROGRAM_COMPILER    *compiler = nullptr;
+    GPUCC_PROGRAM_BYTECODE   *container = nullptr;
+    uint8_t const                  *src = nullptr;
+    uint64_t                     nbsrc = 0;
+    GPUCC_PROGRAM_COMPILER_INIT  config = *run->BaseConfig;
+    GPUCC_RESULT                 result;
+
+    config.DefineSymbols = perm_task->DefineSymbols;
+    config.DefineValues  = perm_task->DefineValues;
+    config.DefineCount   = perm_task->DefineCount;
+    if ((compiler = gpuccCreateCompiler(&config)) == nullptr) {
+        result = gpuccGetLastResult();
+        goto complete;
+    }
+    if ((container = gpuccCreateBytecodeContainer(compiler)) == nullptr) {
+        result = gpuccGetLastResult();
+        goto complete;
+    }
+    result = gpuccCompileProgramBytecode(container, run->SourceCode, run->SourceSize, run->SourcePath, run->EntryPoint);
+
+    /* The compiler and container are deleted below, so keep a copy of
+     * the bytecode on success, or of the log on failure. */
+    if (gpuccSuccess(result)) {
+        src   =(uint8_t const*) gpuccQueryBytecodeBuffer(container);
+        nbsrc = gpuccQueryBytecodeSizeBytes(container);
+    } else {
+        src   =(uint8_t const*) gpuccQueryBytecodeLogBuffer(container);
+        nbsrc = gpuccQueryBytecodeLogSizeBytes(container);
+    }
+    if (src != nullptr && nbsrc != 0) {
+        if ((perm_task->Output = (uint8_t*) gpuccHostAlloc(run->HostAllocator, (size_t) nbsrc, 1)) != nullptr) {
+            memcpy(perm_task->Output, src, (size_t) nbsrc);
+            perm_task->OutputSize = nbsrc;
+        } else if (gpuccSuccess(result)) {
+            result = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+        }
+    }
+    if (gpuccSuccess(result)) {
+        GPUCC_HASH_STATE hash;
+        gpuccHashInit(&hash, 0);
+        gpuccHashUpdate(&hash, perm_task->Output, (size_t) perm_task->OutputSize);
+        perm_task->OutputHash = gpuccHashFinal(&hash);
+    }
+
+complete:
+    gpuccDeleteBytecodeContainer(container);
+    gpuccDeleteCompiler(compiler);
+    perm_task->Result = result;
+    if (gpuccFailure(result)) {
+        run->Batch.FailureCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    gpuccCompileBatchItemComplete(&run->Batch);
+}
+
+/* @summary Assign each successfully compiled permutation to a distinct bytecode blob, merging permutations whose bytecode is byte-identical.
+ * Blobs are numbered in order of the first permutation that uses them, so the result does not depend on the order in which tasks completed.
+ * @param tasks The array of task_count completed permutation tasks.
+ * @param task_count The number of permutation tasks.
+ * @param order Scratch storage for task_count indices.
+ * @param o_blob_index An array of task_count values that on return store the blob index for each task, or GPUCC_PERMUTATION_NOT_FOUND.
+ * @param o_blob_bytes On return, stores the number of bytes required to store every distinct blob, including alignment padding.
+ * @return The number of distinct blobs.
+ */
+static uint32_t
+gpuccPermutationDeduplicate
+(
+    GPUCC_PERMUTATION_TASK const *tasks,
+    uint32_t                 task_count,
+    uint32_t                     *order,
+    uint32_t              *o_blob_index,
+    size_t                *o_blob_bytes
+)
+{
+    uint32_t order_count = 0;
+    uint32_t  blob_count = 0;
+    size_t    blob_bytes = 0;
+
+    for (uint32_t i = 0; i < task_count; ++i) {
+        o_blob_index[i] = GPUCC_PERMUTATION_NOT_FOUND;
+        if (gpuccSuccess(tasks[i].Result)) {
+            order[order_count++] = i;
+        }
+    }
+
+    /* Sort by content hash, then by task index, so that each group of
+     * candidate duplicates is contiguous and begins with its lowest index. */
+    std::sort(order, order + order_count, [tasks](uint32_t a, uint32_t b) {
+        GPUCC_PERMUTATION_TASK const &ta = tasks[a];
+        GPUCC_PERMUTATION_TASK const &tb = tasks[b];
+        if (ta.OutputHash.High != tb.OutputHash.High) return ta.OutputHash.High < tb.OutputHash.High;
+        if (ta.OutputHash.Low  != tb.OutputHash.Low ) return ta.OutputHash.Low  < tb.OutputHash.Low;
+        if (ta.OutputSize      != tb.OutputSize     ) return ta.OutputSize      < tb.OutputSize;
+        return a < b;
+    });
+
+    /* Within a group, o_blob_index temporarily holds the index of the
+     * task whose bytecode is canonical. The contents are compared to
+     * guard against hash collisions. */
+    for (uint32_t i = 0; i < order_count; ) {
+        uint32_t first = i;
+        uint32_t  last = i + 1;
+        while (last < order_count &&
+               tasks[order[last]].OutputHash.High == tasks[order[first]].OutputHash.High &&
+               tasks[order[last]].OutputHash.Low  == tasks[order[first]].OutputHash.Low  &&
+               tasks[order[last]].OutputSize      == tasks[order[first]].OutputSize) {
+            ++last;
+        }
+        for (uint32_t j = first; j < last; ++j) {
+            GPUCC_PERMUTATION_TASK const *tj = &tasks[order[j]];
+            o_blob_index[order[j]] = order[j];
+            for (uint32_t k = first; k < j; ++k) {
+                GPUCC_PERMUTATION_TASK const *tk = &tasks[order[k]];
+                if (o_blob_index[order[k]] == order[k] && (tj->OutputSize == 0 || memcmp(tj->Output, tk->Output, (size_t) tj->OutputSize) == 0)) {
+                    o_blob_index[order[j]] = order[k];
+                    break;
+                }
+            }
+        }
+        i = last;
+    }
+
+    /* Canonical tasks always precede their duplicates, so a single pass
+     * in task order converts canonical task indices into blob indices. */
+    for (uint32_t i = 0; i < task_count; ++i) {
+        if (o_blob_index[i] == i) {
+            o_blob_index[i] = blob_count++;
+            blob_bytes     +=(size_t) tasks[i].OutputSize + (GPUCC_PERMUTATION_BLOB_ALIGNMENT - 1);
+            blob_bytes     &=~((size_t) GPUCC_PERMUTATION_BLOB_ALIGNMENT - 1);
+        } else if (o_blob_index[i] != GPUCC_PERMUTATION_NOT_FOUND) {
+            o_blob_index[i] = o_blob_index[o_blob_index[i]];
+        }
+    }
+    *o_blob_bytes = blob_bytes;
+    return blob_count;
+}
+
+/* @summary Add the size of an array to a running allocation size, failing rather than wrapping if the result is not representable.
+ * @param io_size The running allocation size, in bytes, which is updated on success.
+ * @param count The number of items in the array.
+ * @param item_size The size of each item, in bytes.
+ * @return Non-zero if the size was added, or zero if the result would overflow a size_t.
+ */
+static int32_t
+gpuccPermutationAddArraySize
+(
+    size_t    &io_size,
+    size_t      count,
+    size_t  item_size
+)
+{
+    if (item_size != 0 && count > (SIZE_MAX - io_size) / item_size) {
+        return 0;
+    }
+    io_size += count * item_size;
+    return 1;
+}
+
+GPUCC_API(struct GPUCC_PERMUTATION_TABLE*)
+gpuccCompilePermutations
+(
+    struct GPUCC_PERMUTATION_SPEC const *spec,
+    char const                   *source_code,
+    uint64_t                      source_size,
+    char const                   *source_path,
+    char const                   *entry_point
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    GPUCC_PERMUTATION_TABLE        *table = nullptr;
+    GPUCC_PERMUTATION_TASK         *tasks = nullptr;
+    GPUCC_COMPILE_TASK        **task_list = nullptr;
+    uint32_t                     *indices = nullptr;
+    uint32_t                  *blob_index = nullptr;
+    uint32_t                       *order = nullptr;
+    char const                  **symbols = nullptr;
+    char const                   **values = nullptr;
+    uint8_t                       *scratch = nullptr;
+    uint8_t                          *ptr = nullptr;
+    uint64_t                    key_count = 1;
+    uint32_t                   perm_count = 0;
+    uint32_t                   blob_count = 0;
+    uint32_t                   axis_count = 0;
+    uint32_t                   base_count = 0;
+    size_t                     blob_bytes = 0;
+    size_t                      log_bytes = 0;
+    size_t                       nbdefine = 0;
+    size_t                        nbindex = 0;
+    size_t                         nbneed = 0;
+    GPUCC_HOST_ALLOCATOR            alloc;
+    GPUCC_PERMUTATION_RUN             run;
+
+    if (pctx->StartupFlag == 0 || pctx->CompilePool == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_NOT_INITIALIZED));
+        return nullptr;
+    }
+    if (spec == nullptr || spec->BaseConfig == nullptr || source_code == nullptr || source_size == 0) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+    if ((spec->AxisCount != 0 && spec->Axes == nullptr) || (spec->ExclusionCount != 0 && spec->ExclusionRules == nullptr)) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+    if (spec->BaseConfig->DefineCount != 0 && (spec->BaseConfig->DefineSymbols == nullptr || spec->BaseConfig->DefineValues == nullptr)) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+    if (gpuccInitHostAllocator(&alloc, spec->BaseConfig->HostAllocator) == 0) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+    axis_count = spec->AxisCount;
+    base_count = spec->BaseConfig->DefineCount;
+    for (uint32_t a = 0; a < axis_count; ++a) {
+        GPUCC_PERMUTATION_AXIS const *axis = &spec->Axes[a];
+        if (axis->Symbol == nullptr || axis->Values == nullptr || axis->ValueCount == 0) {
+            gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+            return nullptr;
+        }
+        /* Keys are returned to the application, so the whole space must be addressable with a 32-bit index. */
+        if ((key_count *= axis->ValueCount) > UINT32_MAX) {
+            gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+            return nullptr;
+        }
+    }
+
+    /* Count the permutations that survive the exclusion rules, so that
+     * the task storage can be allocated as a single block. */
+    if ((indices = (uint32_t*) gpuccHostAlloc(&alloc, (axis_count + 1) * sizeof(uint32_t), alignof(uint32_t))) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    memset(indices, 0, (axis_count + 1) * sizeof(uint32_t));
+    do {
+        if (gpuccPermutationIsExcluded(spec, indices) == 0) {
+            perm_count++;
+        }
+    } while (gpuccPermutationAdvance(spec, indices));
+    gpuccHostFree(&alloc, indices);
+    if (perm_count == 0) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+
+    /* Allocate the task records, task pointers, value indices, dedup scratch
+     * and per-permutation define arrays as a single block. A space near the
+     * 32-bit limit may not be addressable, so every size is computed in
+     * size_t and checked, and nbdefine and nbindex are the per-permutation
+     * row sizes of the define and value index arrays. */
+    if (gpuccPermutationAddArraySize(nbdefine, (size_t) base_count + axis_count, sizeof(char const*)) == 0 ||
+        gpuccPermutationAddArraySize(nbindex , axis_count                      , sizeof(uint32_t))    == 0 ||
+        gpuccPermutationAddArraySize(nbneed  , perm_count, sizeof(GPUCC_PERMUTATION_TASK))           == 0 ||
+        gpuccPermutationAddArraySize(nbneed  , perm_count, sizeof(GPUCC_COMPILE_TASK*))              == 0 ||
+        gpuccPermutationAddArraySize(nbneed  , perm_count, nbdefine)                                 == 0 ||
+        gpuccPermutationAddArraySize(nbneed  , perm_count, nbdefine)                                 == 0 ||
+        gpuccPermutationAddArraySize(nbneed  , perm_count, nbindex)                                  == 0 ||
+        gpuccPermutationAddArraySize(nbneed  , perm_count, sizeof(uint32_t) * 2)                     == 0 ||
+        gpuccPermutationAddArraySize(nbneed  , 1         , nbindex)                                  == 0) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    if ((scratch = (uint8_t*) gpuccHostAlloc(&alloc, nbneed, alignof(GPUCC_PERMUTATION_TASK))) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    ptr        = scratch;
+    tasks      =(GPUCC_PERMUTATION_TASK*) ptr; ptr += (size_t) perm_count * sizeof(GPUCC_PERMUTATION_TASK);
+    task_list  =(GPUCC_COMPILE_TASK   **) ptr; ptr += (size_t) perm_count * sizeof(GPUCC_COMPILE_TASK*);
+    symbols    =(char const           **) ptr; ptr += (size_t) perm_count * nbdefine;
+    values     =(char const           **) ptr; ptr += (size_t) perm_count * nbdefine;
+    indices    =(uint32_t              *) ptr; ptr += (size_t) perm_count * nbindex;
+    blob_index =(uint32_t              *) ptr; ptr += (size_t) perm_count * sizeof(uint32_t);
+    order      =(uint32_t              *) ptr; ptr += (size_t) perm_count * sizeof(uint32_t);
+
+    run.BaseConfig    = spec->BaseConfig;
+    run.HostAllocator =&alloc;
+    run.SourceCode    = source_code;
+    run.SourceSize    = source_size;
+    run.SourcePath    = source_path;
+    run.EntryPoint    = entry_point;
+    run.Batch.RemainingCount.store(perm_count, std::memory_order_relaxed);
+    run.Batch.FailureCount.store(0, std::memory_order_relaxed);
+    run.Batch.CompileNanoseconds.store(0, std::memory_order_relaxed);
+    run.Batch.MaxItemNanoseconds.store(0, std::memory_order_relaxed);
+
+    /* The odometer for the second pass lives after the per-permutation value indices. */
+    {
+        uint32_t *odometer =(uint32_t*) ptr;
+        uint32_t         n = 0;
+        memset(odometer, 0, axis_count * sizeof(uint32_t));
+        do {
+            GPUCC_PERMUTATION_TASK *t;
+            char const      **t_syms;
+            char const      **t_vals;
+            uint32_t       define_n;
+            if (gpuccPermutationIsExcluded(spec, odometer)) {
+                continue;
+            }
+            t        =&tasks  [n];
+            t_syms   =&symbols[(size_t) n * ((size_t) base_count + axis_count)];
+            t_vals   =&values [(size_t) n * ((size_t) base_count + axis_count)];
+            define_n = base_count;
+            for (uint32_t i = 0; i < base_count; ++i) {
+                t_syms[i] = spec->BaseConfig->DefineSymbols[i];
+                t_vals[i] = spec->BaseConfig->DefineValues [i];
+            }
+            for (uint32_t a = 0; a < axis_count; ++a) {
+                char const *value = spec->Axes[a].Values[odometer[a]];
+                if (value != nullptr) {
+                    t_syms[define_n] = spec->Axes[a].Symbol;
+                    t_vals[define_n] = value;
+                    define_n++;
+                }
+            }
+            memcpy(&indices[(size_t) n * axis_count], odometer, nbindex);
+            memset(t, 0, sizeof(GPUCC_PERMUTATION_TASK));
+            t->Task.Execute  = gpuccPermutationTaskExecute;
+            t->Run           =&run;
+            t->DefineSymbols = t_syms;
+            t->DefineValues  = t_vals;
+            t->DefineCount   = define_n;
+            t->Result        = gpuccMakeResult(GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER);
+            task_list[n]     =&t->Task;
+            n++;
+        } while (gpuccPermutationAdvance(spec, odometer));
+        assert(n == perm_count);
+    }
+
+    gpuccCompilePoolRunBatch(pctx->CompilePool, &run.Batch, task_list, perm_count);
+
+    /* Build the table. Logs are only retained for failed permutations. */
+    blob_count = gpuccPermutationDeduplicate(tasks, perm_count, order, blob_index, &blob_bytes);
+    for (uint32_t i = 0; i < perm_count; ++i) {
+        if (gpuccFailure(tasks[i].Result) && tasks[i].Output != nullptr) {
+            log_bytes += (size_t) tasks[i].OutputSize;
+        }
+    }
+    nbneed  = sizeof(GPUCC_PERMUTATION_TABLE) + GPUCC_PERMUTATION_BLOB_ALIGNMENT - 1;
+    if (gpuccPermutationAddArraySize(nbneed, perm_count, sizeof(GPUCC_PERMUTATION_RECORD)) == 0 ||
+        gpuccPermutationAddArraySize(nbneed, blob_count, sizeof(GPUCC_PERMUTATION_BLOB))   == 0 ||
+        gpuccPermutationAddArraySize(nbneed, perm_count, nbindex)                          == 0 ||
+        gpuccPermutationAddArraySize(nbneed, 1         , blob_bytes)                       == 0 ||
+        gpuccPermutationAddArraySize(nbneed, 1         , log_bytes)                        == 0) {
+        nbneed = SIZE_MAX; /* Fails the allocation below, which releases the task outputs. */
+    }
+    if (nbneed != SIZE_MAX && (table = (GPUCC_PERMUTATION_TABLE*) gpuccHostAlloc(&alloc, nbneed, GPUCC_PERMUTATION_BLOB_ALIGNMENT)) != nullptr) {
+        uint8_t      *data;
+        uint8_t      *logs;
+        uint64_t    stride;
+        uint32_t next_blob = 0;
+        ptr                     =(uint8_t*) table + sizeof(GPUCC_PERMUTATION_TABLE);
+        table->HostAllocator    = alloc;
+        table->Records          =(GPUCC_PERMUTATION_RECORD*) ptr; ptr += perm_count * sizeof(GPUCC_PERMUTATION_RECORD);
+        table->Blobs            =(GPUCC_PERMUTATION_BLOB  *) ptr; ptr += blob_count * sizeof(GPUCC_PERMUTATION_BLOB);
+        table->ValueIndices     =(uint32_t                *) ptr; ptr += (size_t) perm_count * nbindex;
+        table->PermutationCount = perm_count;
+        table->BlobCount        = blob_count;
+        table->AxisCount        = axis_count;
+        data                    =(uint8_t*)(((uintptr_t) ptr + (GPUCC_PERMUTATION_BLOB_ALIGNMENT - 1)) & ~((uintptr_t) GPUCC_PERMUTATION_BLOB_ALIGNMENT - 1));
+        logs                    = data + blob_bytes;
+        memcpy(table->ValueIndices, indices, (size_t) perm_count * nbindex);
+        for (uint32_t i = 0; i < perm_count; ++i) {
+            GPUCC_PERMUTATION_RECORD *record = &table->Records[i];
+            GPUCC_PERMUTATION_TASK const  *t = &tasks[i];
+            record->Key           = 0;
+            record->LogBuffer     = nullptr;
+            record->CompileResult = t->Result;
+            record->BlobIndex     = blob_index[i];
+            stride = 1;
+            for (uint32_t a = 0; a < axis_count; ++a) {
+                record->Key += stride * indices[(size_t) i * axis_count + a];
+                stride      *= spec->Axes[a].ValueCount;
+            }
+            if (gpuccFailure(t->Result) && t->Output != nullptr) {
+                memcpy(logs, t->Output, (size_t) t->OutputSize);
+                record->LogBuffer =(char const*) logs;
+                logs += (size_t) t->OutputSize;
+            }
+            /* Blobs are numbered in order of first use, so the first permutation mapped to each blob is the one whose bytecode is stored. */
+            if (blob_index[i] == next_blob) {
+                if (t->OutputSize != 0) {
+                    memcpy(data, t->Output, (size_t) t->OutputSize);
+                }
+                table->Blobs[blob_index[i]].Bytecode     = data;
+                table->Blobs[blob_index[i]].BytecodeSize = t->OutputSize;
+                data += ((size_t) t->OutputSize + (GPUCC_PERMUTATION_BLOB_ALIGNMENT - 1)) & ~((size_t) GPUCC_PERMUTATION_BLOB_ALIGNMENT - 1);
+                next_blob++;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < perm_count; ++i) {
+        gpuccHostFree(&alloc, tasks[i].Output);
+    }
+    gpuccHostFree(&alloc, scratch);
+
+    if (table == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    if (run.Batch.FailureCount.load(std::memory_order_relaxed) != 0) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED));
+    } else {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    }
+    return table;
+}
+
+GPUCC_API(void)
+gpuccDeletePermutationTable
+(
+    struct GPUCC_PERMUTATION_TABLE *table
+)
+{
+    if (table != nullptr) {
+        GPUCC_HOST_ALLOCATOR alloc = table->HostAllocator;
+        gpuccHostFree(&alloc, table);
+    }
+}
+
+GPUCC_API(uint32_t)
+gpuccQueryPermutationCount
+(
+    struct GPUCC_PERMUTATION_TABLE *table
+)
+{
+    if (table == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+    return table->PermutationCount;
+}
+
+GPUCC_API(uint32_t)
+gpuccQueryPermutationBlobCount
+(
+    struct GPUCC_PERMUTATION_TABLE *table
+)
+{
+    if (table == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+    return table->BlobCount;
+}
+
+GPUCC_API(int32_t)
+gpuccQueryPermutation
+(
+    struct GPUCC_PERMUTATION_TABLE   *table,
+    uint32_t                          index,
+    struct GPUCC_PERMUTATION_ENTRY *o_entry
+)
+{
+    GPUCC_PERMUTATION_RECORD const *record;
+
+    if (table == nullptr || o_entry == nullptr || index >= table->PermutationCount) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+    record                 = &table->Records[index];
+    o_entry->Key           = record->Key;
+    o_entry->ValueIndices  = &table->ValueIndices[(size_t) index * table->AxisCount];
+    o_entry->LogBuffer     = record->LogBuffer;
+    o_entry->CompileResult = record->CompileResult;
+    o_entry->BlobIndex     = record->BlobIndex;
+    return 1;
+}
+
+GPUCC_API(uint32_t)
+gpuccFindPermutation
+(
+    struct GPUCC_PERMUTATION_TABLE *table,
+    uint64_t                          key
+)
+{
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+
+    if (table == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return GPUCC_PERMUTATION_NOT_FOUND;
+    }
+    hi = table->PermutationCount;
+    while (lo < hi) {
+        uint32_t mid = lo + ((hi - lo) >> 1);
+        if (table->Records[mid].Key < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < table->PermutationCount && table->Records[lo].Key == key) {
+        return lo;
+    }
+    return GPUCC_PERMUTATION_NOT_FOUND;
+}
+
+GPUCC_API(uint8_t const*)
+gpuccQueryPermutationBlob
+(
+    struct GPUCC_PERMUTATION_TABLE *table,
+    uint32_t                   blob_index,
+    uint64_t                      *o_size
+)
+{
+    if (o_size != nullptr) {
+        *o_size = 0;
+    }
+    if (table == nullptr || blob_index >= table->BlobCount) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+    if (o_size != nullptr) {
+        *o_size = table->Blobs[blob_index].BytecodeSize;
+    }
+    return table->Blobs[blob_index].Bytecode;
+}
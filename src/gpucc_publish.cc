@@ -0,0 +1,301 @@
+/**
+ * @summary gpucc_publish.cc: Implement published programs. Readers announce
+ * the global epoch in a per-thread record and then load the current container;
+ * publishers swap the container, advance the epoch and retire the previous
+ * container, which is freed once every active reader announced a later epoch.
+ */
+#include <stdlib.h>
+#include <new>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_publish.h"
+
+/* @summary The global epoch, advanced each time a container is retired.
+ */
+static std::atomic<uint64_t>            g_GlobalEpoch(0);
+
+/* @summary The source of serial numbers assigned to published containers. Zero is never assigned.
+ */
+static std::atomic<uint64_t>            g_PublishSerial(0);
+
+/* @summary The head of the process-wide list of per-thread epoch records.
+ */
+static std::atomic<GPUCC_EPOCH_RECORD*> g_EpochRecords(nullptr);
+
+/* @summary Obtain an epoch record for the calling thread, reusing one released by an exited thread if possible.
+ * @return The epoch record, or NULL if memory allocation failed.
+ */
+static GPUCC_EPOCH_RECORD*
+gpuccAcquireEpochRecord
+(
+    void
+)
+{
+    GPUCC_EPOCH_RECORD *record = nullptr;
+    GPUCC_EPOCH_RECORD   *head = nullptr;
+
+    for (record = g_EpochRecords.load(std::memory_order_acquire); record != nullptr; record = record->Next) {
+        int32_t expected = 0;
+        if (record->InUse.load(std::memory_order_relaxed) == 0 && record->InUse.compare_exchange_strong(expected, 1, std::memory_order_acquire)) {
+            record->Depth = 0;
+            return record;
+        }
+    }
+    if ((record = (GPUCC_EPOCH_RECORD*) malloc(sizeof(GPUCC_EPOCH_RECORD))) == nullptr) {
+        return nullptr;
+    }
+    record->Epoch.store(GPUCC_EPOCH_INACTIVE, std::memory_order_relaxed);
+    record->InUse.store(1, std::memory_order_relaxed);
+    record->Depth = 0;
+    head = g_EpochRecords.load(std::memory_order_relaxed);
+    do {
+        record->Next = head;
+    } while (!g_EpochRecords.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+    return record;
+}
+
+/* @summary Determine the oldest epoch announced by any thread currently reading a published program.
+ * @return The oldest announced epoch, or GPUCC_EPOCH_INACTIVE if no thread is reading.
+ */
+static uint64_t
+gpuccOldestActiveEpoch
+(
+    void
+)
+{
+    uint64_t oldest = GPUCC_EPOCH_INACTIVE;
+    for (GPUCC_EPOCH_RECORD *record = g_EpochRecords.load(std::memory_order_acquire); record != nullptr; record = record->Next) {
+        uint64_t epoch = record->Epoch.load(std::memory_order_seq_cst);
+        if (epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+    return oldest;
+}
+
+/* @summary Push a chain of retired containers onto the retired list of a published program.
+ * @param program The published program.
+ * @param first The first entry in the chain.
+ * @param last The last entry in the chain.
+ */
+static void
+gpuccPushRetiredBytecode
+(
+    GPUCC_PUBLISHED_PROGRAM *program,
+    GPUCC_RETIRED_BYTECODE    *first,
+    GPUCC_RETIRED_BYTECODE     *last
+)
+{
+    GPUCC_RETIRED_BYTECODE *head = program->Retired.load(std::memory_order_relaxed);
+    do {
+        last->Next = head;
+    } while (!program->Retired.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+/* @summary Free the retired containers of a published program that no reader can still hold.
+ * If another thread is already reclaiming for the same program, this function returns immediately.
+ * @param program The published program.
+ */
+static void
+gpuccReclaimRetiredBytecode
+(
+    GPUCC_PUBLISHED_PROGRAM *program
+)
+{
+    GPUCC_RETIRED_BYTECODE *list = nullptr;
+    GPUCC_RETIRED_BYTECODE *keep = nullptr;
+    GPUCC_RETIRED_BYTECODE *tail = nullptr;
+    uint64_t              oldest = 0;
+
+    if (program->ReclaimFlag.exchange(1, std::memory_order_acquire) != 0) {
+        return;
+    }
+    if ((list = program->Retired.exchange(nullptr, std::memory_order_acquire)) != nullptr) {
+        /* A reader that might hold a container retired in epoch N announced
+         * an epoch no later than N before loading it. */
+        oldest = gpuccOldestActiveEpoch();
+        while (list != nullptr) {
+            GPUCC_RETIRED_BYTECODE *next = list->Next;
+            if (list->RetireEpoch < oldest) {
+                gpuccDeleteBytecodeContainer(list->Container);
+                free(list);
+            } else {
+                if (keep == nullptr) {
+                    tail = list;
+                }
+                list->Next = keep;
+                keep = list;
+            }
+            list = next;
+        }
+        if (keep != nullptr) {
+            gpuccPushRetiredBytecode(program, keep, tail);
+        }
+    }
+    program->ReclaimFlag.store(0, std::memory_order_release);
+}
+
+GPUCC_API(void)
+gpuccReleaseEpochRecord
+(
+    struct GPUCC_EPOCH_RECORD *record
+)
+{
+    if (record != nullptr) {
+        record->Depth = 0;
+        record->Epoch.store(GPUCC_EPOCH_INACTIVE, std::memory_order_release);
+        record->InUse.store(0, std::memory_order_release);
+    }
+}
+
+GPUCC_API(struct GPUCC_PUBLISHED_PROGRAM*)
+gpuccCreatePublishedProgram
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_PUBLISHED_PROGRAM *program = nullptr;
+
+    if ((program = new (std::nothrow) GPUCC_PUBLISHED_PROGRAM()) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    if (bytecode != nullptr) {
+        ((GPUCC_PROGRAM_BYTECODE_BASE*) bytecode)->PublishSerial = g_PublishSerial.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    program->Current.store(bytecode, std::memory_order_relaxed);
+    program->Retired.store(nullptr, std::memory_order_relaxed);
+    program->ReclaimFlag.store(0, std::memory_order_relaxed);
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return program;
+}
+
+GPUCC_API(void)
+gpuccDeletePublishedProgram
+(
+    struct GPUCC_PUBLISHED_PROGRAM *program
+)
+{
+    if (program != nullptr) {
+        GPUCC_RETIRED_BYTECODE *list = program->Retired.exchange(nullptr, std::memory_order_acquire);
+        while (list != nullptr) {
+            GPUCC_RETIRED_BYTECODE *next = list->Next;
+            gpuccDeleteBytecodeContainer(list->Container);
+            free(list);
+            list = next;
+        }
+        gpuccDeleteBytecodeContainer(program->Current.load(std::memory_order_acquire));
+        delete program;
+    }
+}
+
+GPUCC_API(int32_t)
+gpuccReplacePublishedBytecode
+(
+    struct GPUCC_PUBLISHED_PROGRAM   *program,
+    struct GPUCC_PROGRAM_BYTECODE   *bytecode,
+    struct GPUCC_PUBLISH_TICKET const *expected,
+    struct GPUCC_PUBLISH_TICKET      *o_ticket
+)
+{
+    GPUCC_RETIRED_BYTECODE *retire = nullptr;
+    GPUCC_PROGRAM_BYTECODE    *old = nullptr;
+    uint64_t                serial = g_PublishSerial.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    /* Allocate the retired list entry up front, so that failure leaves the program unchanged. */
+    if ((retire = (GPUCC_RETIRED_BYTECODE*) malloc(sizeof(GPUCC_RETIRED_BYTECODE))) == nullptr) {
+        return 0;
+    }
+    if (expected != nullptr) {
+        /* Pin the current epoch so the current container cannot be freed while its serial is compared. */
+        old = gpuccAcquirePublishedProgram(program);
+        if (old != expected->Container || old == nullptr || ((GPUCC_PROGRAM_BYTECODE_BASE*) old)->PublishSerial != expected->Serial || 
+           !program->Current.compare_exchange_strong(old, bytecode, std::memory_order_seq_cst)) {
+            gpuccReleasePublishedProgram(program);
+            free(retire);
+            return 0;
+        }
+        gpuccReleasePublishedProgram(program);
+    } else {
+        old = program->Current.exchange(bytecode, std::memory_order_seq_cst);
+    }
+    /* The serial is assigned only once the container is published, so a failed replacement leaves the caller's container untouched.
+     * Until then a concurrent publisher sees the container's previous serial, which was zero and matches no ticket. */
+    if (bytecode != nullptr) {
+        ((GPUCC_PROGRAM_BYTECODE_BASE*) bytecode)->PublishSerial = serial;
+    }
+    if (old != nullptr) {
+        /* Readers that announce an epoch after this increment load the new container. */
+        retire->Container   = old;
+        retire->RetireEpoch = g_GlobalEpoch.fetch_add(1, std::memory_order_seq_cst);
+        gpuccPushRetiredBytecode(program, retire, retire);
+    } else {
+        free(retire);
+    }
+    if (o_ticket != nullptr) {
+        o_ticket->Container = bytecode;
+        o_ticket->Serial    = serial;
+    }
+    gpuccReclaimRetiredBytecode(program);
+    return 1;
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccPublishProgramBytecode
+(
+    struct GPUCC_PUBLISHED_PROGRAM *program,
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_RESULT result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+
+    if (program == nullptr) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+    } else if (gpuccReplacePublishedBytecode(program, bytecode, nullptr, nullptr) == 0) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+    }
+    gpuccSetLastResult(result);
+    return result;
+}
+
+GPUCC_API(struct GPUCC_PROGRAM_BYTECODE*)
+gpuccAcquirePublishedProgram
+(
+    struct GPUCC_PUBLISHED_PROGRAM *program
+)
+{
+    GPUCC_THREAD_CONTEXT_PLATFORM *tctx = gpuccGetThreadContext_();
+    GPUCC_EPOCH_RECORD          *record = tctx->EpochRecord;
+
+    if (program == nullptr) {
+        return nullptr;
+    }
+    if (record == nullptr) {
+        if ((record = gpuccAcquireEpochRecord()) == nullptr) {
+            return nullptr;
+        }
+        tctx->EpochRecord = record;
+    }
+    if (record->Depth++ == 0) {
+        record->Epoch.store(g_GlobalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    }
+    return program->Current.load(std::memory_order_seq_cst);
+}
+
+GPUCC_API(void)
+gpuccReleasePublishedProgram
+(
+    struct GPUCC_PUBLISHED_PROGRAM *program
+)
+{
+    GPUCC_THREAD_CONTEXT_PLATFORM *tctx = gpuccGetThreadContext_();
+    GPUCC_EPOCH_RECORD          *record = tctx->EpochRecord;
+
+    if (program != nullptr && record != nullptr && record->Depth != 0 && --record->Depth == 0) {
+        record->Epoch.store(GPUCC_EPOCH_INACTIVE, std::memory_order_release);
+        /* Without this, containers retired while this thread was reading stay allocated until the next publish. */
+        if (program->Retired.load(std::memory_order_relaxed) != nullptr) {
+            gpuccReclaimRetiredBytecode(program);
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/**
+ * @summary gpucc_recycle.cc: Implement the policy that destroys and recreates
+ * the backend objects of a compiler after a number of compilations, or once
+ * the memory allocated by the backend has grown past a limit.
+ */
+#include <new>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_recycle.h"
+
+/* @summary Retrieve the amount of memory currently allocated by the backend objects of a compiler.
+ * @param compiler_ The compiler.
+ * @return The number of bytes allocated, or zero if the compiler type does not track backend memory.
+ */
+static uint64_t
+gpuccRecycleQueryMemory
+(
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_
+)
+{
+    GPUCC_BACKEND_MEMORY_STATS stats;
+
+    if (compiler_->QueryBackendMemory != nullptr && compiler_->QueryBackendMemory((struct GPUCC_PROGRAM_COMPILER*) compiler_, &stats)) {
+        return stats.CurrentBytes;
+    }
+    return 0;
+}
+
+GPUCC_API(int32_t)
+gpuccInitRecyclePolicy
+(
+    struct GPUCC_PROGRAM_COMPILER      *compiler,
+    struct GPUCC_PROGRAM_COMPILER_INIT   *config
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+    GPUCC_RECYCLE_STATE             *state = nullptr;
+
+    compiler_->RecycleState = nullptr;
+    if (config->RecycleCompileCount == 0 && config->RecycleMemoryBytes == 0) {
+        return 1;
+    }
+    if (compiler_->RecycleBackend == nullptr || compiler_->WorkerPool != nullptr) {
+        return 1;
+    }
+    if ((state = new (std::nothrow) GPUCC_RECYCLE_STATE()) == nullptr) {
+        return 0;
+    }
+    state->MemoryLimit    = config->RecycleMemoryBytes;
+    state->MemoryBaseline = gpuccRecycleQueryMemory(compiler_);
+    state->CompileLimit   = config->RecycleCompileCount;
+    state->CompileCount   = 0;
+    state->ActiveCount    = 0;
+    state->RecyclePending = 0;
+    compiler_->RecycleState = state;
+    return 1;
+}
+
+GPUCC_API(void)
+gpuccReleaseRecyclePolicy
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+
+    if (compiler_->RecycleState != nullptr) {
+        delete compiler_->RecycleState;
+        compiler_->RecycleState = nullptr;
+    }
+}
+
+GPUCC_API(void)
+gpuccBeginBackendCompile
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+    GPUCC_RECYCLE_STATE             *state = compiler_->RecycleState;
+
+    if (state != nullptr) {
+        std::unique_lock<std::mutex> lock(state->Lock);
+        state->IdleSignal.wait(lock, [state] { return state->RecyclePending == 0; });
+        state->ActiveCount++;
+    }
+}
+
+GPUCC_API(void)
+gpuccEndBackendCompile
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+    GPUCC_RECYCLE_STATE             *state = compiler_->RecycleState;
+    uint64_t                        memory = 0;
+
+    if (state == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(state->Lock);
+    state->ActiveCount--;
+    state->CompileCount++;
+    if (state->RecyclePending == 0) {
+        if (state->CompileLimit != 0 && state->CompileCount >= state->CompileLimit) {
+            state->RecyclePending = 1;
+        }
+        if (state->MemoryLimit != 0) {
+            memory = gpuccRecycleQueryMemory(compiler_);
+            if (memory > state->MemoryBaseline && memory - state->MemoryBaseline >= state->MemoryLimit) {
+                state->RecyclePending = 1;
+            }
+        }
+    }
+    if (state->RecyclePending != 0 && state->ActiveCount == 0) {
+        /* The lock is held so that no compilation can start while the backend objects are replaced.
+         * If they cannot be recreated, the backend retains the existing objects and the limits are applied again from zero.
+         */
+        compiler_->RecycleBackend(compiler);
+        state->MemoryBaseline = gpuccRecycleQueryMemory(compiler_);
+        state->CompileCount   = 0;
+        state->RecyclePending = 0;
+        state->IdleSignal.notify_all();
+    }
+}
@@ -0,0 +1,393 @@
+/**
+ * @summary gpucc_reload.cc: Implement the reload service, which recompiles
+ * programs in the background when their source file or any file they include
+ * changes on disk. The service thread collects change notifications from the
+ * platform directory watcher, waits for saves to settle, and then compiles
+ * the affected programs as a batch on the compile pool.
+ */
+#include <assert.h>
+#include <algorithm>
+#include <chrono>
+#include <system_error>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_async.h"
+#include "gpucc_depend.h"
+#include "gpucc_reload.h"
+
+/* @summary Define the interval, in milliseconds, at which the reload service tries to watch again the directories that were deleted.
+ * The parent of a deleted directory is usually not watched, so its recreation produces no notification and must be polled for.
+ */
+#ifndef GPUCC_RELOAD_LOST_RETRY_MS
+#define GPUCC_RELOAD_LOST_RETRY_MS                                            500
+#endif
+
+/* @summary Compile a single program on behalf of the reload service thread.
+ * @param task The GPUCC_RELOAD_TASK to execute.
+ */
+static void
+gpuccReloadTaskExecute
+(
+    GPUCC_COMPILE_TASK *task
+)
+{
+    GPUCC_RELOAD_TASK *reload_task =(GPUCC_RELOAD_TASK*) task;
+    std::string             source;
+
+    reload_task->Container = nullptr;
+    reload_task->Files.clear();
+    reload_task->Files.push_back(reload_task->SourcePath);
+    if (gpuccReadFileToString(reload_task->SourcePath.c_str(), source) == 0) {
+        reload_task->Result = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+        goto complete;
+    }
+    if ((reload_task->Container = gpuccCreateBytecodeContainer(reload_task->Compiler)) == nullptr) {
+        reload_task->Result = gpuccGetLastResult();
+        goto complete;
+    }
+    reload_task->Result = gpuccCompileProgramBytecode(reload_task->Container, source.data(), (uint64_t) source.size(), reload_task->SourcePath.c_str(), reload_task->EntryPoint.c_str());
+    for (uint32_t i = 0, n = gpuccQueryBytecodeDependencyCount(reload_task->Container); i < n; ++i) {
+        reload_task->Files.push_back(gpuccQueryBytecodeDependency(reload_task->Container, i));
+    }
+
+complete:
+    if (gpuccFailure(reload_task->Result)) {
+        reload_task->Batch->FailureCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    gpuccCompileBatchItemComplete(reload_task->Batch);
+}
+
+/* @summary Begin watching the directory containing each of a set of files, if it is not already watched.
+ * This function is called only on the service thread.
+ * @param service The reload service.
+ * @param files The paths of the files.
+ */
+static void
+gpuccReloadServiceWatchFiles
+(
+    GPUCC_RELOAD_SERVICE        *service,
+    std::vector<std::string> const &files
+)
+{
+    for (std::string const &path : files) {
+        std::string directory(path, 0, gpuccPathDirectoryLength(path.c_str()));
+        if (service->WatchedDirectories.count(directory) != 0 || service->LostDirectories.count(directory) != 0) {
+            continue;
+        }
+        if (gpuccFileWatcherAddDirectory(service->Watcher, directory.c_str()) == 0) {
+            gpuccDebugPrintf("GpuCC: Reload service cannot watch directory \"%s\".\n", directory.c_str());
+        }
+        /* Directories that cannot be watched are not retried on every pass. */
+        service->WatchedDirectories.insert(std::move(directory));
+    }
+}
+
+/* @summary Try to watch again each directory that the watcher dropped because it was deleted.
+ * This function is called only on the service thread, each time the watcher returns while any directory is lost, which is at least every GPUCC_RELOAD_LOST_RETRY_MS.
+ * @param service The reload service.
+ * @param o_restored On return, the directories that are watched again are inserted. Files in them may have changed while they were not watched.
+ * @return The number of directories that are watched again.
+ */
+static uint32_t
+gpuccReloadServiceRetryLostDirectories
+(
+    GPUCC_RELOAD_SERVICE             *service,
+    std::unordered_set<std::string> &o_restored
+)
+{
+    uint32_t restored = 0;
+
+    for (auto iter = service->LostDirectories.begin(); iter != service->LostDirectories.end(); ) {
+        if (gpuccFileWatcherAddDirectory(service->Watcher, iter->c_str()) == 0) {
+            ++iter;
+            continue;
+        }
+        service->WatchedDirectories.insert(*iter);
+        o_restored.insert(*iter);
+        iter = service->LostDirectories.erase(iter);
+        restored++;
+    }
+    return restored;
+}
+
+/* @summary Compile every dirty program and deliver the results through the callback.
+ * This function is called only on the service thread, with the service Lock held. The lock is released while compiling and delivering.
+ * @param service The reload service.
+ * @param lock The held service lock.
+ */
+static void
+gpuccReloadServiceRunPass
+(
+    GPUCC_RELOAD_SERVICE         *service,
+    std::unique_lock<std::mutex>    &lock
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    std::vector<GPUCC_RELOAD_TASK>  tasks;
+    std::vector<GPUCC_COMPILE_TASK*> task_list;
+    GPUCC_COMPILE_BATCH             batch;
+
+    for (auto &program : service->Programs) {
+        if (program.second.Dirty == false) {
+            continue;
+        }
+        tasks.emplace_back();
+        tasks.back().Task.Execute = gpuccReloadTaskExecute;
+        tasks.back().Batch        =&batch;
+        tasks.back().Compiler     = program.second.Compiler;
+        tasks.back().SourcePath   = program.second.SourcePath;
+        tasks.back().EntryPoint   = program.second.EntryPoint;
+        tasks.back().Container    = nullptr;
+        tasks.back().ProgramId    = program.first;
+        program.second.Dirty      = false;
+    }
+    if (tasks.empty()) {
+        return;
+    }
+    for (GPUCC_RELOAD_TASK &t : tasks) {
+        task_list.push_back(&t.Task);
+    }
+
+    /* PassLock is taken before Lock is released, so a program removed from
+     * here on waits for the pass to finish before its compiler is deleted. */
+    std::lock_guard<std::mutex> pass_guard(service->PassLock);
+    lock.unlock();
+
+    batch.RemainingCount.store((uint32_t) tasks.size(), std::memory_order_relaxed);
+    batch.FailureCount.store(0, std::memory_order_relaxed);
+    batch.CompileNanoseconds.store(0, std::memory_order_relaxed);
+    batch.MaxItemNanoseconds.store(0, std::memory_order_relaxed);
+    gpuccCompilePoolRunBatch(pctx->CompilePool, &batch, task_list.data(), (uint32_t) tasks.size());
+
+    for (GPUCC_RELOAD_TASK &t : tasks) {
+        std::vector<std::string> watch_files;
+        bool                      registered = false;
+        lock.lock();
+        auto iter = service->Programs.find(t.ProgramId);
+        if (iter != service->Programs.end()) {
+            /* A failed compile may have stopped before reaching some of the
+             * includes, so keep watching whatever the last compile read. */
+            std::vector<std::string> &files = iter->second.Files;
+            if (t.Container != nullptr && gpuccFailure(t.Result)) {
+                for (std::string &path : files) {
+                    if (std::find(t.Files.begin(), t.Files.end(), path) == t.Files.end()) {
+                        t.Files.push_back(std::move(path));
+                    }
+                }
+            }
+            if (t.Container != nullptr || files.empty()) {
+                files.swap(t.Files);
+            }
+            watch_files = files;
+            registered  = true;
+        }
+        lock.unlock();
+
+        if (registered) {
+            gpuccReloadServiceWatchFiles(service, watch_files);
+            service->Callback(service->UserData, t.ProgramId, t.Result, t.Container);
+        } else {
+            gpuccDeleteBytecodeContainer(t.Container);
+        }
+    }
+    lock.lock();
+}
+
+/* @summary Implement the entry point of the reload service thread.
+ * @param service The reload service.
+ */
+static void
+gpuccReloadServiceMain
+(
+    GPUCC_RELOAD_SERVICE *service
+)
+{
+    std::unique_lock<std::mutex>          lock(service->Lock, std::defer_lock);
+    std::unordered_set<std::string>       pending;
+    std::unordered_set<std::string>       removed;
+    std::vector<std::string>              changed;
+    std::vector<std::string>              dropped;
+    std::chrono::steady_clock::time_point deadline;
+    bool                                  have_pending = false;
+    bool                                  lost_changes = false;
+
+    for ( ; ; ) {
+        uint32_t timeout_ms = GPUCC_WAIT_INFINITE;
+        uint32_t restored   = 0;
+        int32_t  lost       = 0;
+        if (have_pending) {
+            auto remain = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            timeout_ms = (remain > 0) ? (uint32_t) remain : 0;
+        }
+        if (service->LostDirectories.empty() == false && timeout_ms > GPUCC_RELOAD_LOST_RETRY_MS) {
+            timeout_ms = GPUCC_RELOAD_LOST_RETRY_MS;
+        }
+        changed.clear();
+        dropped.clear();
+        if ((lost = gpuccFileWatcherWait(service->Watcher, timeout_ms, changed, dropped)) != 0) {
+            lost_changes = true;
+        }
+        /* A deleted directory is no longer watched. Recompile the programs
+         * that use it, and add it again once it has been recreated. Its
+         * parent is usually not watched, so the service polls for it. */
+        for (std::string &directory : dropped) {
+            service->WatchedDirectories.erase(directory);
+            service->LostDirectories.insert(directory);
+            removed.insert(std::move(directory));
+        }
+        if (service->LostDirectories.empty() == false) {
+            restored = gpuccReloadServiceRetryLostDirectories(service, removed);
+        }
+
+        /* Every notification restarts the debounce interval, so a burst of
+         * writes and renames from one save produces a single recompile. */
+        if (changed.empty() == false || dropped.empty() == false || restored != 0 || lost != 0) {
+            for (std::string &path : changed) {
+                pending.insert(std::move(path));
+            }
+            deadline     = std::chrono::steady_clock::now() + std::chrono::milliseconds(service->DebounceMilliseconds);
+            have_pending = true;
+        }
+
+        lock.lock();
+        if (service->ShutdownFlag) {
+            lock.unlock();
+            break;
+        }
+        if (have_pending && std::chrono::steady_clock::now() >= deadline) {
+            for (auto &program : service->Programs) {
+                if (lost_changes) {
+                    program.second.Dirty = true;
+                    continue;
+                }
+                for (std::string const &path : program.second.Files) {
+                    if (pending.count(path) != 0 || removed.count(std::string(path, 0, gpuccPathDirectoryLength(path.c_str()))) != 0) {
+                        program.second.Dirty = true;
+                        break;
+                    }
+                }
+            }
+            pending.clear();
+            removed.clear();
+            have_pending = false;
+            lost_changes = false;
+        }
+        /* Newly registered programs are also dirty, and are compiled without waiting. */
+        gpuccReloadServiceRunPass(service, lock);
+        lock.unlock();
+    }
+}
+
+GPUCC_API(struct GPUCC_RELOAD_SERVICE*)
+gpuccCreateReloadService
+(
+    struct GPUCC_RELOAD_SERVICE_INIT const *init
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    GPUCC_RELOAD_SERVICE        *service = nullptr;
+
+    if (pctx->StartupFlag == 0 || pctx->CompilePool == nullptr) {
+        gpuccDebugPrintf("GpuCC: Cannot create reload service. Call gpuccStartup() first.\n");
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_NOT_INITIALIZED));
+        return nullptr;
+    }
+    if (init == nullptr || init->Callback == nullptr) {
+        assert(init != nullptr);
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+    if ((service = new (std::nothrow) GPUCC_RELOAD_SERVICE()) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    if ((service->Watcher = gpuccCreateFileWatcher()) == nullptr) {
+        delete service;
+        return nullptr;
+    }
+    service->Callback             = init->Callback;
+    service->UserData             = init->UserData;
+    service->DebounceMilliseconds = (init->DebounceMilliseconds != 0) ? init->DebounceMilliseconds : GPUCC_RELOAD_DEFAULT_DEBOUNCE_MS;
+    service->NextProgramId        = 1;
+    service->ShutdownFlag         = false;
+    try {
+        service->Thread = std::thread(gpuccReloadServiceMain, service);
+    } catch (std::system_error const&) {
+        gpuccDeleteFileWatcher(service->Watcher);
+        delete service;
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_PLATFORM_ERROR));
+        return nullptr;
+    }
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return service;
+}
+
+GPUCC_API(void)
+gpuccDeleteReloadService
+(
+    struct GPUCC_RELOAD_SERVICE *service
+)
+{
+    if (service != nullptr) {
+        {
+            std::lock_guard<std::mutex> guard(service->Lock);
+            service->ShutdownFlag = true;
+        }
+        gpuccFileWatcherWake(service->Watcher);
+        service->Thread.join();
+        gpuccDeleteFileWatcher(service->Watcher);
+        delete service;
+    }
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccReloadServiceAddProgram
+(
+    struct GPUCC_RELOAD_SERVICE    *service,
+    struct GPUCC_PROGRAM_COMPILER *compiler,
+    char const                 *source_path,
+    char const                 *entry_point,
+    uint32_t                  *o_program_id
+)
+{
+    GPUCC_RESULT result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+
+    if (service == nullptr || compiler == nullptr || source_path == nullptr || entry_point == nullptr || o_program_id == nullptr) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    {
+        std::lock_guard<std::mutex> guard(service->Lock);
+        uint32_t                       id = service->NextProgramId++;
+        GPUCC_RELOAD_PROGRAM     &program = service->Programs[id];
+        program.Compiler   = compiler;
+        program.SourcePath = source_path;
+        program.EntryPoint = entry_point;
+        program.Dirty      = true;
+        *o_program_id      = id;
+    }
+    gpuccFileWatcherWake(service->Watcher);
+    gpuccSetLastResult(result);
+    return result;
+}
+
+GPUCC_API(void)
+gpuccReloadServiceRemoveProgram
+(
+    struct GPUCC_RELOAD_SERVICE *service,
+    uint32_t                  program_id
+)
+{
+    if (service != nullptr) {
+        {
+            std::lock_guard<std::mutex> guard(service->Lock);
+            service->Programs.erase(program_id);
+        }
+        /* Wait for any pass in progress, which may be compiling the program or
+         * invoking its callback. The callback itself runs inside the pass. */
+        if (std::this_thread::get_id() != service->Thread.get_id()) {
+            std::lock_guard<std::mutex> pass_guard(service->PassLock);
+        }
+    }
+}
@@ -0,0 +1,416 @@
+/**
+ * @summary gpucc_stats.cc: Implement the process-wide statistics counters.
+ * Each thread owns a shard of counters, found through its thread context, and
+ * increments them with relaxed atomic operations on memory no other thread
+ * writes. Snapshots walk the list of shards and sum the counters. Compile
+ * latencies are recorded into log-bucketed histograms with atomic increments.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_stats.h"
+
+/* @summary The head of the process-wide list of per-thread statistics shards.
+ */
+static std::atomic<GPUCC_STATISTICS_SHARD*> g_StatisticsShards(nullptr);
+
+/* @summary The shard shared by threads for which a shard could not be allocated.
+ */
+static GPUCC_STATISTICS_SHARD               g_FallbackShard;
+
+/* @summary The head of the process-wide list of latency histograms.
+ */
+static std::atomic<GPUCC_LATENCY_HISTOGRAM*> g_LatencyHistograms(nullptr);
+
+/* @summary Serializes the creation of latency histograms, so that each combination of compiler type and target profile has exactly one.
+ */
+static std::mutex                           g_LatencyHistogramLock;
+
+/* @summary Obtain a statistics shard for the calling thread, reusing one released by an exited thread if possible.
+ * @return The statistics shard, or NULL if memory allocation failed.
+ */
+static GPUCC_STATISTICS_SHARD*
+gpuccAcquireStatisticsShard
+(
+    void
+)
+{
+    GPUCC_STATISTICS_SHARD *shard = nullptr;
+    GPUCC_STATISTICS_SHARD  *head = nullptr;
+
+    for (shard = g_StatisticsShards.load(std::memory_order_acquire); shard != nullptr; shard = shard->Next) {
+        int32_t expected = 0;
+        if (shard->InUse.load(std::memory_order_relaxed) == 0 && shard->InUse.compare_exchange_strong(expected, 1, std::memory_order_acquire)) {
+            return shard;
+        }
+    }
+    /* Value-initialization zeroes the counters. */
+    if ((shard = new (std::nothrow) GPUCC_STATISTICS_SHARD()) == nullptr) {
+        return nullptr;
+    }
+    shard->InUse.store(1, std::memory_order_relaxed);
+    head = g_StatisticsShards.load(std::memory_order_relaxed);
+    do {
+        shard->Next = head;
+    } while (!g_StatisticsShards.compare_exchange_weak(head, shard, std::memory_order_release, std::memory_order_relaxed));
+    return shard;
+}
+
+/* @summary Retrieve the statistics shard owned by the calling thread, acquiring one on first use.
+ * @return The statistics shard. If no shard could be allocated, the shared fallback shard is returned.
+ */
+static GPUCC_STATISTICS_SHARD*
+gpuccThreadStatisticsShard
+(
+    void
+)
+{
+    GPUCC_THREAD_CONTEXT_PLATFORM *tctx = gpuccGetThreadContext_();
+    GPUCC_STATISTICS_SHARD       *shard = tctx->StatisticsShard;
+
+    if (shard == nullptr) {
+        if ((shard = gpuccAcquireStatisticsShard()) == nullptr) {
+            return &g_FallbackShard;
+        }
+        tctx->StatisticsShard = shard;
+    }
+    return shard;
+}
+
+/* @summary Add the counters of a statistics shard to a snapshot.
+ * @param stats The snapshot to update.
+ * @param shard The shard to read.
+ */
+static void
+gpuccAccumulateStatisticsShard
+(
+    GPUCC_STATISTICS             *stats,
+    GPUCC_STATISTICS_SHARD const *shard
+)
+{
+    for (uint32_t i = 0; i < GPUCC_COMPILER_TYPE_COUNT; ++i) {
+        stats->CompileCount[i] += shard->CompileCount[i].load(std::memory_order_relaxed);
+    }
+    stats->SuccessCount       += shard->SuccessCount.load(std::memory_order_relaxed);
+    stats->FailureCount       += shard->FailureCount.load(std::memory_order_relaxed);
+    stats->SourceBytes        += shard->SourceBytes.load(std::memory_order_relaxed);
+    stats->BytecodeBytes      += shard->BytecodeBytes.load(std::memory_order_relaxed);
+    stats->CacheHitCount      += shard->CacheHitCount.load(std::memory_order_relaxed);
+    stats->CacheMissCount     += shard->CacheMissCount.load(std::memory_order_relaxed);
+    stats->CompileNanoseconds += shard->CompileNanoseconds.load(std::memory_order_relaxed);
+    stats->BackendNanoseconds += shard->BackendNanoseconds.load(std::memory_order_relaxed);
+}
+
+/* @summary Compute the index of the latency histogram bucket holding a value.
+ * @param ns The latency, in nanoseconds.
+ * @return The bucket index, less than GPUCC_LATENCY_BUCKET_COUNT.
+ */
+static uint32_t
+gpuccLatencyBucketIndex
+(
+    uint64_t ns
+)
+{
+    uint64_t   v = ns;
+    uint32_t msb = 0;
+
+    if (ns < (1ULL << GPUCC_LATENCY_SUB_BUCKET_BITS)) {
+        return (uint32_t) ns;
+    }
+    if (v >> 32) { v >>= 32; msb += 32; }
+    if (v >> 16) { v >>= 16; msb += 16; }
+    if (v >>  8) { v >>=  8; msb +=  8; }
+    if (v >>  4) { v >>=  4; msb +=  4; }
+    if (v >>  2) { v >>=  2; msb +=  2; }
+    if (v >>  1) {           msb +=  1; }
+    /* The bits below the most significant bit select one of the buckets for its power of two. */
+    return ((msb - GPUCC_LATENCY_SUB_BUCKET_BITS + 1) << GPUCC_LATENCY_SUB_BUCKET_BITS) + (uint32_t)((ns >> (msb - GPUCC_LATENCY_SUB_BUCKET_BITS)) & ((1ULL << GPUCC_LATENCY_SUB_BUCKET_BITS) - 1));
+}
+
+/* @summary Compute the highest value that falls into a latency histogram bucket.
+ * @param index The bucket index.
+ * @return The highest value of the bucket, in nanoseconds.
+ */
+static uint64_t
+gpuccLatencyBucketLimit
+(
+    uint32_t index
+)
+{
+    uint32_t const count = 1U << GPUCC_LATENCY_SUB_BUCKET_BITS;
+    uint32_t       shift = 0;
+
+    if (index < count) {
+        return index;
+    }
+    shift = (index >> GPUCC_LATENCY_SUB_BUCKET_BITS) - 1;
+    return (((uint64_t)(count + (index & (count - 1))) + 1) << shift) - 1;
+}
+
+/* @summary Compute the latency percentiles of a histogram.
+ * The buckets are read once, so that the percentiles are consistent with the sample count even while other threads record.
+ * @param o_latency On return, stores the latency distribution.
+ * @param histogram The histogram to read.
+ */
+static void
+gpuccQueryLatencyHistogram
+(
+    GPUCC_COMPILE_LATENCY         *o_latency,
+    GPUCC_LATENCY_HISTOGRAM const *histogram
+)
+{
+    uint64_t       counts[GPUCC_LATENCY_BUCKET_COUNT];
+    uint64_t const percent[3] = { 50, 90, 99 };
+    uint64_t      *o_values[3]= { &o_latency->P50Nanoseconds, &o_latency->P90Nanoseconds, &o_latency->P99Nanoseconds };
+    uint64_t           total  = 0;
+    uint64_t          maxval  = histogram->MaxNanoseconds.load(std::memory_order_relaxed);
+
+    for (uint32_t i = 0; i < GPUCC_LATENCY_BUCKET_COUNT; ++i) {
+        counts[i] = histogram->Buckets[i].load(std::memory_order_relaxed);
+        total    += counts[i];
+    }
+    o_latency->CompilerType   = histogram->CompilerType;
+    o_latency->TargetProfile  = histogram->TargetProfile;
+    o_latency->SampleCount    = total;
+    o_latency->MaxNanoseconds = maxval;
+    for (uint32_t p = 0; p < 3; ++p) {
+        uint64_t rank = (total * percent[p] + 99) / 100;
+        uint64_t  sum = 0;
+        uint32_t    i = 0;
+       *o_values[p]   = 0;
+        if (total == 0) {
+            continue;
+        }
+        for (i = 0; i < GPUCC_LATENCY_BUCKET_COUNT - 1; ++i) {
+            if ((sum += counts[i]) >= rank) {
+                break;
+            }
+        }
+        /* Report the bucket limit, but never more than the exact maximum, which may lag a concurrent increment of the bucket. */
+       *o_values[p] = gpuccLatencyBucketLimit(i);
+        if (maxval != 0 && *o_values[p] > maxval) {
+           *o_values[p] = maxval;
+        }
+    }
+}
+
+/* @summary Retrieve the latency distributions of every histogram, sorted by compiler type and then by target profile.
+ * @param o_latency On return, stores one entry per histogram.
+ */
+static void
+gpuccQueryLatencyHistograms
+(
+    std::vector<GPUCC_COMPILE_LATENCY> &o_latency
+)
+{
+    GPUCC_LATENCY_HISTOGRAM *histogram = nullptr;
+
+    for (histogram = g_LatencyHistograms.load(std::memory_order_acquire); histogram != nullptr; histogram = histogram->Next) {
+        GPUCC_COMPILE_LATENCY latency;
+        gpuccQueryLatencyHistogram(&latency, histogram);
+        o_latency.push_back(latency);
+    }
+    std::sort(o_latency.begin(), o_latency.end(), [] (GPUCC_COMPILE_LATENCY const &a, GPUCC_COMPILE_LATENCY const &b) {
+        return (a.CompilerType != b.CompilerType) ? (a.CompilerType < b.CompilerType) : (strcmp(a.TargetProfile, b.TargetProfile) < 0);
+    });
+}
+
+/* @summary Add a compile latency to a histogram.
+ * @param histogram The histogram of the compiler. This value may be NULL.
+ * @param ns The latency, in nanoseconds.
+ */
+static void
+gpuccRecordCompileLatency
+(
+    GPUCC_LATENCY_HISTOGRAM *histogram,
+    uint64_t                        ns
+)
+{
+    uint64_t maxval = 0;
+
+    if (histogram == nullptr) {
+        return;
+    }
+    histogram->Buckets[gpuccLatencyBucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+    maxval = histogram->MaxNanoseconds.load(std::memory_order_relaxed);
+    while (ns > maxval && !histogram->MaxNanoseconds.compare_exchange_weak(maxval, ns, std::memory_order_relaxed)) {
+        /* maxval was reloaded by the failed exchange. */
+    }
+}
+
+GPUCC_API(void)
+gpuccInitLatencyHistogram
+(
+    struct GPUCC_PROGRAM_COMPILER      *compiler,
+    struct GPUCC_PROGRAM_COMPILER_INIT   *config
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+    GPUCC_LATENCY_HISTOGRAM     *histogram = nullptr;
+    char const                    *profile = (config->TargetProfile != nullptr) ? config->TargetProfile : "";
+    size_t                              nb = strlen(profile) + 1;
+
+    std::lock_guard<std::mutex> lock(g_LatencyHistogramLock);
+    for (histogram = g_LatencyHistograms.load(std::memory_order_relaxed); histogram != nullptr; histogram = histogram->Next) {
+        if (histogram->CompilerType == compiler_->CompilerType && strcmp(histogram->TargetProfile, profile) == 0) {
+            compiler_->LatencyHistogram = histogram;
+            return;
+        }
+    }
+    /* Value-initialization zeroes the buckets. */
+    if ((histogram = new (std::nothrow) GPUCC_LATENCY_HISTOGRAM()) == nullptr) {
+        compiler_->LatencyHistogram = nullptr;
+        return;
+    }
+    if ((histogram->TargetProfile = new (std::nothrow) char[nb]) == nullptr) {
+        delete histogram;
+        compiler_->LatencyHistogram = nullptr;
+        return;
+    }
+    memcpy(histogram->TargetProfile, profile, nb);
+    histogram->CompilerType = compiler_->CompilerType;
+    histogram->Next         = g_LatencyHistograms.load(std::memory_order_relaxed);
+    g_LatencyHistograms.store(histogram, std::memory_order_release);
+    compiler_->LatencyHistogram = histogram;
+}
+
+GPUCC_API(void)
+gpuccRecordCompileStatistics
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    uint64_t                     source_size,
+    struct GPUCC_RESULT               result
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_PROGRAM_COMPILER_BASE  *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) container_->Compiler;
+    GPUCC_STATISTICS_SHARD           *shard = gpuccThreadStatisticsShard();
+    int32_t                           ctype = compiler_->CompilerType;
+
+    if (container_->BackendInvoked && ctype >= 0 && ctype < GPUCC_COMPILER_TYPE_COUNT) {
+        shard->CompileCount[ctype].fetch_add(1, std::memory_order_relaxed);
+    }
+    if (gpuccSuccess(result)) {
+        shard->SuccessCount.fetch_add(1, std::memory_order_relaxed);
+        shard->BytecodeBytes.fetch_add(container_->BytecodeSize, std::memory_order_relaxed);
+    } else {
+        shard->FailureCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard->SourceBytes.fetch_add(source_size, std::memory_order_relaxed);
+    shard->CompileNanoseconds.fetch_add(container_->Timings.TotalNanoseconds, std::memory_order_relaxed);
+    shard->BackendNanoseconds.fetch_add(container_->Timings.PhaseNanoseconds[GPUCC_COMPILE_PHASE_COMPILE], std::memory_order_relaxed);
+    if (container_->BackendInvoked) {
+        gpuccRecordCompileLatency(compiler_->LatencyHistogram, container_->Timings.TotalNanoseconds);
+    }
+}
+
+GPUCC_API(void)
+gpuccRecordCacheLookup
+(
+    int32_t hit
+)
+{
+    GPUCC_STATISTICS_SHARD *shard = gpuccThreadStatisticsShard();
+
+    if (hit) {
+        shard->CacheHitCount.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        shard->CacheMissCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+GPUCC_API(void)
+gpuccReleaseStatisticsShard
+(
+    struct GPUCC_STATISTICS_SHARD *shard
+)
+{
+    if (shard != nullptr) {
+        shard->InUse.store(0, std::memory_order_release);
+    }
+}
+
+GPUCC_API(int32_t)
+gpuccQueryStatistics
+(
+    struct GPUCC_STATISTICS *o_stats
+)
+{
+    GPUCC_STATISTICS_SHARD *shard = nullptr;
+
+    if (o_stats == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+    memset(o_stats, 0, sizeof(GPUCC_STATISTICS));
+
+    for (shard = g_StatisticsShards.load(std::memory_order_acquire); shard != nullptr; shard = shard->Next) {
+        gpuccAccumulateStatisticsShard(o_stats, shard);
+    }
+    gpuccAccumulateStatisticsShard(o_stats, &g_FallbackShard);
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return 1;
+}
+
+GPUCC_API(uint32_t)
+gpuccQueryCompileLatency
+(
+    struct GPUCC_COMPILE_LATENCY *o_latency,
+    uint32_t                      max_count
+)
+{
+    std::vector<GPUCC_COMPILE_LATENCY> latency;
+
+    if (o_latency == nullptr && max_count != 0) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+    gpuccQueryLatencyHistograms(latency);
+    for (uint32_t i = 0, n = (uint32_t) latency.size(); i < n && i < max_count; ++i) {
+        o_latency[i] = latency[i];
+    }
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return (uint32_t) latency.size();
+}
+
+GPUCC_API(uint64_t)
+gpuccFormatCompileLatencyReport
+(
+    char       *buffer,
+    uint64_t    buffer_size
+)
+{
+    std::vector<GPUCC_COMPILE_LATENCY> latency;
+    std::vector<char>                   report;
+    char                                  line[256];
+    int                                     nc = 0;
+
+    if (buffer == nullptr && buffer_size != 0) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return 0;
+    }
+    gpuccQueryLatencyHistograms(latency);
+    nc = snprintf(line, sizeof(line), "%-30s %-16s %10s %12s %12s %12s %12s\n", "Compiler", "Profile", "Count", "p50 (ms)", "p90 (ms)", "p99 (ms)", "Max (ms)");
+    report.insert(report.end(), line, line + nc);
+    for (size_t i = 0, n = latency.size(); i < n; ++i) {
+        GPUCC_COMPILE_LATENCY const &l = latency[i];
+        nc = snprintf(line, sizeof(line), "%-30s %-16s %10llu %12.3f %12.3f %12.3f %12.3f\n", 
+            gpuccCompilerTypeString(l.CompilerType), l.TargetProfile, (unsigned long long) l.SampleCount, 
+            l.P50Nanoseconds / 1000000.0, l.P90Nanoseconds / 1000000.0, l.P99Nanoseconds / 1000000.0, l.MaxNanoseconds / 1000000.0);
+        /* A long target profile can be truncated by snprintf, which returns the untruncated length. */
+        report.insert(report.end(), line, line + std::min((size_t) nc, sizeof(line) - 1));
+    }
+    report.push_back('\0');
+    if (buffer_size != 0) {
+        size_t nb = (size_t) std::min((uint64_t) report.size(), buffer_size);
+        memcpy(buffer, report.data(), nb);
+        buffer[nb - 1] = '\0';
+    }
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return (uint64_t) report.size();
+}
@@ -0,0 +1,256 @@
+/**
+ * @summary gpucc_tiered.cc: Implement tiered compilation. The unoptimized
+ * build is compiled on the calling thread and published immediately; the
+ * optimized build is queued as a background task on the compile pool and
+ * replaces the unoptimized build only if nothing newer was published first.
+ */
+#include <assert.h>
+#include <string.h>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_async.h"
+#include "gpucc_cancel.h"
+#include "gpucc_publish.h"
+#include "gpucc_tiered.h"
+
+/* @summary Determine whether a publication is still the current container of a published program.
+ * @param program The published program.
+ * @param expected The publication to check.
+ * @return Non-zero if the publication is current.
+ */
+static int32_t
+gpuccTieredPublicationIsCurrent
+(
+    GPUCC_PUBLISHED_PROGRAM    *program,
+    GPUCC_PUBLISH_TICKET const *expected
+)
+{
+    GPUCC_PROGRAM_BYTECODE *current = gpuccAcquirePublishedProgram(program);
+    int32_t                  result = 0;
+
+    if (current != nullptr && current == expected->Container && ((GPUCC_PROGRAM_BYTECODE_BASE*) current)->PublishSerial == expected->Serial) {
+        result = 1;
+    }
+    gpuccReleasePublishedProgram(program);
+    return result;
+}
+
+/* @summary Compile the optimized build of a program and publish it if the unoptimized build is still current, then free the job.
+ * @param task The GPUCC_TIERED_JOB to execute.
+ */
+static void
+gpuccTieredJobExecute
+(
+    GPUCC_COMPILE_TASK *task
+)
+{
+    GPUCC_TIERED_JOB           *job =(GPUCC_TIERED_JOB*) task;
+    GPUCC_TIERED_COMPILER   *tiered = job->Tiered;
+    GPUCC_PROGRAM_BYTECODE *container = nullptr;
+
+    /* Skip the compile if the tiered compiler is being drained, or the program was republished while the job was queued. */
+    if (gpuccCancelRequested(&tiered->Discard) == 0 && gpuccTieredPublicationIsCurrent(job->Program, &job->Expected) != 0) {
+        if ((container = gpuccCreateBytecodeContainer(tiered->OptimizedCompiler)) != nullptr) {
+            GPUCC_RESULT result = gpuccCompileProgramBytecode(container, job->SourceCode, job->SourceSize, job->SourcePath, job->EntryPoint);
+            if (gpuccFailure(result) || gpuccReplacePublishedBytecode(job->Program, container, &job->Expected, nullptr) == 0) {
+                gpuccDeleteBytecodeContainer(container);
+            }
+        }
+    }
+    /* The tiered compiler, and so the allocator, may be freed as soon as the count is decremented. */
+    gpuccHostFree(gpuccQueryCompilerHostAllocator_(tiered->OptimizedCompiler), job);
+    {
+        std::lock_guard<std::mutex> lock(tiered->Lock);
+        if (--tiered->OutstandingCount == 0) {
+            tiered->IdleSignal.notify_all();
+        }
+    }
+}
+
+GPUCC_API(struct GPUCC_TIERED_COMPILER*)
+gpuccInitTieredCompiler
+(
+    struct GPUCC_PROGRAM_COMPILER      *fast,
+    struct GPUCC_PROGRAM_COMPILER *optimized
+)
+{
+    GPUCC_TIERED_COMPILER *tiered = nullptr;
+
+    if ((tiered = new (std::nothrow) GPUCC_TIERED_COMPILER()) == nullptr) {
+        gpuccDeleteCompiler(optimized);
+        gpuccDeleteCompiler(fast);
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    tiered->FastCompiler      = fast;
+    tiered->OptimizedCompiler = optimized;
+    tiered->OutstandingCount  = 0;
+    tiered->Discard.Token     = nullptr;
+    tiered->Discard.Deadline  = GPUCC_CANCEL_NO_DEADLINE;
+    tiered->Discard.CancelFlag.store(0, std::memory_order_relaxed);
+    return tiered;
+}
+
+GPUCC_API(struct GPUCC_TIERED_COMPILER*)
+gpuccCreateTieredCompiler
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT *config
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    GPUCC_TIERED_COMPILER        *tiered = nullptr;
+    GPUCC_PROGRAM_COMPILER         *fast = nullptr;
+    GPUCC_PROGRAM_COMPILER    *optimized = nullptr;
+    GPUCC_PROGRAM_COMPILER_INIT     tier;
+
+    if (pctx->StartupFlag == 0 || pctx->CompilePool == nullptr) {
+        gpuccDebugPrintf("GpuCC: Cannot create tiered compiler. Call gpuccStartup() first.\n");
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_NOT_INITIALIZED));
+        return nullptr;
+    }
+    if (config == nullptr) {
+        assert(config != nullptr);
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+    tier = *config;
+    tier.CompilerFlags = config->CompilerFlags | GPUCC_COMPILER_FLAG_DISABLE_OPTIMIZATIONS;
+    if ((fast = gpuccCreateCompiler(&tier)) == nullptr) {
+        return nullptr;
+    }
+    tier.CompilerFlags = config->CompilerFlags & ~(uint64_t) GPUCC_COMPILER_FLAG_DISABLE_OPTIMIZATIONS;
+    if ((optimized = gpuccCreateCompiler(&tier)) == nullptr) {
+        gpuccDeleteCompiler(fast);
+        return nullptr;
+    }
+    if ((tiered = gpuccInitTieredCompiler(fast, optimized)) == nullptr) {
+        return nullptr;
+    }
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return tiered;
+}
+
+GPUCC_API(void)
+gpuccDrainTieredCompiler
+(
+    struct GPUCC_TIERED_COMPILER *tiered
+)
+{
+    if (tiered != nullptr) {
+        /* Queued jobs are cancelled rather than merely flagged, since a job in a class that is out of budget
+         * is only started once cancelled. Otherwise the drain would wait for the next scheduler tick. */
+        tiered->Discard.CancelFlag.store(1, std::memory_order_release);
+        gpuccCompilePoolWake(gpuccGetProcessContext_()->CompilePool);
+        {
+            std::unique_lock<std::mutex> lock(tiered->Lock);
+            tiered->IdleSignal.wait(lock, [tiered] { return tiered->OutstandingCount == 0; });
+            tiered->Discard.CancelFlag.store(0, std::memory_order_release);
+        }
+    }
+}
+
+GPUCC_API(void)
+gpuccDeleteTieredCompiler
+(
+    struct GPUCC_TIERED_COMPILER *tiered
+)
+{
+    if (tiered != nullptr) {
+        gpuccDrainTieredCompiler(tiered);
+        gpuccDeleteCompiler(tiered->OptimizedCompiler);
+        gpuccDeleteCompiler(tiered->FastCompiler);
+        delete tiered;
+    }
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccCompileProgramTiered
+(
+    struct GPUCC_TIERED_COMPILER     *tiered,
+    struct GPUCC_PUBLISHED_PROGRAM  *program,
+    char const                  *source_code,
+    uint64_t                     source_size,
+    char const                  *source_path,
+    char const                  *entry_point,
+    struct GPUCC_PROGRAM_BYTECODE **o_failed
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+    GPUCC_HOST_ALLOCATOR          *alloc = nullptr;
+    GPUCC_PROGRAM_BYTECODE    *container = nullptr;
+    GPUCC_TIERED_JOB                *job = nullptr;
+    uint8_t                         *ptr = nullptr;
+    size_t                        nbneed = 0;
+    GPUCC_PUBLISH_TICKET          ticket;
+    GPUCC_RESULT                  result;
+
+    if (o_failed != nullptr) {
+        *o_failed = nullptr;
+    }
+    if (pctx->StartupFlag == 0 || pctx->CompilePool == nullptr) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_NOT_INITIALIZED);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    if (tiered == nullptr || program == nullptr || source_code == nullptr || source_size == 0 || source_size > (uint64_t) SIZE_MAX - sizeof(GPUCC_TIERED_JOB)) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccSetLastResult(result);
+        return result;
+    }
+
+    /* First tier: compile without optimizations on the calling thread. */
+    if ((container = gpuccCreateBytecodeContainer(tiered->FastCompiler)) == nullptr) {
+        return gpuccGetLastResult();
+    }
+    result = gpuccCompileProgramBytecode(container, source_code, source_size, source_path, entry_point);
+    if (gpuccFailure(result)) {
+        if (o_failed != nullptr) {
+            *o_failed = container;
+        } else {
+            gpuccDeleteBytecodeContainer(container);
+        }
+        gpuccSetLastResult(result);
+        return result;
+    }
+    if (gpuccReplacePublishedBytecode(program, container, nullptr, &ticket) == 0) {
+        gpuccDeleteBytecodeContainer(container);
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+        gpuccSetLastResult(result);
+        return result;
+    }
+
+    /* Second tier: queue the optimized compile. The caller's buffers need not outlive this call, so copy everything into the job's memory block.
+     * If the job cannot be queued, the unoptimized build remains published and the call still succeeds. */
+    alloc   = gpuccQueryCompilerHostAllocator_(tiered->OptimizedCompiler);
+    nbneed  = sizeof(GPUCC_TIERED_JOB) + (size_t) source_size;
+    nbneed += (source_path != nullptr) ? strlen(source_path) + 1 : 0;
+    nbneed += (entry_point != nullptr) ? strlen(entry_point) + 1 : 0;
+    if ((job = (GPUCC_TIERED_JOB*) gpuccHostAlloc(alloc, nbneed, alignof(GPUCC_TIERED_JOB))) == nullptr) {
+        gpuccSetLastResult(result);
+        return result;
+    }
+    ptr = (uint8_t*) job + sizeof(GPUCC_TIERED_JOB);
+    job->Task.Execute = gpuccTieredJobExecute;
+    job->Tiered       = tiered;
+    job->Program      = program;
+    job->Expected     = ticket;
+    memcpy(ptr, source_code, (size_t) source_size);
+    job->SourceCode   =(char const*) ptr;
+    job->SourceSize   = source_size;
+    ptr += (size_t) source_size;
+    job->SourcePath   = (source_path != nullptr) ? gpuccPutStringUtf8(ptr, source_path) : nullptr;
+    job->EntryPoint   = (entry_point != nullptr) ? gpuccPutStringUtf8(ptr, entry_point) : nullptr;
+    {
+        std::lock_guard<std::mutex> lock(tiered->Lock);
+        tiered->OutstandingCount++;
+    }
+    if (gpuccCompilePoolSubmit(pctx->CompilePool, &job->Task, GPUCC_COMPILE_PRIORITY_BACKGROUND, &tiered->Discard) == 0) {
+        std::lock_guard<std::mutex> lock(tiered->Lock);
+        gpuccHostFree(alloc, job);
+        if (--tiered->OutstandingCount == 0) {
+            tiered->IdleSignal.notify_all();
+        }
+    }
+    gpuccSetLastResult(result);
+    return result;
+}
@@ -0,0 +1,357 @@
+/**
+ * @summary gpucc_trace.cc: Implement the compile tracer. While tracing is
+ * enabled, each thread records events into a ring buffer found through its
+ * thread context. gpuccWriteTraceFile drains every buffer and writes the
+ * events as Chrome trace event JSON.
+ */
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <new>
+#include <vector>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_trace.h"
+
+/* @summary Non-zero while trace events are being recorded.
+ */
+static std::atomic<int32_t>             g_TraceEnabled(0);
+
+/* @summary The number of events held by trace buffers created from now on.
+ */
+static std::atomic<uint32_t>            g_TraceCapacity(GPUCC_TRACE_DEFAULT_EVENT_COUNT);
+
+/* @summary The source of identifiers for asynchronous events. Zero is never assigned.
+ */
+static std::atomic<uint64_t>            g_TraceAsyncId(0);
+
+/* @summary The head of the process-wide list of per-thread trace buffers.
+ */
+static std::atomic<GPUCC_TRACE_BUFFER*> g_TraceBuffers(nullptr);
+
+/* @summary Obtain a trace buffer for the calling thread, reusing one released by an exited thread if possible.
+ * @return The trace buffer, or NULL if memory allocation failed.
+ */
+static GPUCC_TRACE_BUFFER*
+gpuccAcquireTraceBuffer
+(
+    void
+)
+{
+    GPUCC_TRACE_BUFFER *buffer = nullptr;
+    GPUCC_TRACE_BUFFER   *head = nullptr;
+    uint32_t         capacity = g_TraceCapacity.load(std::memory_order_relaxed);
+
+    for (buffer = g_TraceBuffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->Next) {
+        int32_t expected = 0;
+        if (buffer->InUse.load(std::memory_order_relaxed) == 0 && buffer->InUse.compare_exchange_strong(expected, 1, std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(buffer->Lock);
+            buffer->ThreadId = gpuccQueryCurrentThreadId();
+            return buffer;
+        }
+    }
+    if ((buffer = new (std::nothrow) GPUCC_TRACE_BUFFER()) == nullptr) {
+        return nullptr;
+    }
+    if ((buffer->Events = new (std::nothrow) GPUCC_TRACE_EVENT[capacity]) == nullptr) {
+        delete buffer;
+        return nullptr;
+    }
+    buffer->Capacity    = capacity;
+    buffer->ThreadId    = gpuccQueryCurrentThreadId();
+    buffer->RecordCount = 0;
+    buffer->InUse.store(1, std::memory_order_relaxed);
+    head = g_TraceBuffers.load(std::memory_order_relaxed);
+    do {
+        buffer->Next = head;
+    } while (!g_TraceBuffers.compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
+    return buffer;
+}
+
+/* @summary Copy descriptive text into the detail field of a trace event, truncating it if necessary.
+ * @param dst The destination buffer, of GPUCC_TRACE_DETAIL_SIZE bytes.
+ * @param detail Nul-terminated UTF-8 text, or NULL.
+ * @param detail2 Nul-terminated UTF-8 text shown in parentheses after detail, or NULL.
+ */
+static void
+gpuccTraceSetDetail
+(
+    char          *dst,
+    char const *detail,
+    char const *detail2
+)
+{
+    size_t n = 0;
+
+    if (detail != nullptr && detail2 != nullptr) {
+        n = (size_t) snprintf(dst, GPUCC_TRACE_DETAIL_SIZE, "%s (%s)", detail, detail2);
+    } else if (detail != nullptr || detail2 != nullptr) {
+        n = (size_t) snprintf(dst, GPUCC_TRACE_DETAIL_SIZE, "%s", (detail != nullptr) ? detail : detail2);
+    } else {
+        dst[0] = 0;
+    }
+    if (n >= GPUCC_TRACE_DETAIL_SIZE) {
+        /* The text was truncated. Drop any partial UTF-8 sequence so that the output remains valid UTF-8. */
+        size_t end = GPUCC_TRACE_DETAIL_SIZE - 1;
+        size_t pos = end;
+        while (pos > 0 && ((uint8_t) dst[pos - 1] & 0xC0) == 0x80) {
+            pos--;
+        }
+        if (pos > 0 && ((uint8_t) dst[pos - 1] & 0x80) != 0) {
+            uint8_t lead = (uint8_t) dst[pos - 1];
+            size_t  need = (lead >= 0xF0) ? 4 : (lead >= 0xE0) ? 3 : (lead >= 0xC0) ? 2 : 1;
+            if (end - (pos - 1) < need) {
+                end = pos - 1;
+            }
+        }
+        dst[end] = 0;
+    }
+}
+
+/* @summary Record an event in the trace buffer of the calling thread.
+ * @param name A string literal naming the operation.
+ * @param start The start time of the operation.
+ * @param async_id The identifier of an asynchronous event, or zero.
+ * @param detail Optional descriptive text, or NULL.
+ * @param detail2 Optional descriptive text shown in parentheses, or NULL.
+ */
+static void
+gpuccTraceRecord
+(
+    char const    *name,
+    uint64_t      start,
+    uint64_t   async_id,
+    char const  *detail,
+    char const *detail2
+)
+{
+    GPUCC_THREAD_CONTEXT_PLATFORM *tctx = gpuccGetThreadContext_();
+    GPUCC_TRACE_BUFFER          *buffer = tctx->TraceBuffer;
+    uint64_t                        now = gpuccQueryClockNanoseconds();
+    GPUCC_TRACE_EVENT               *ev = nullptr;
+
+    if (buffer == nullptr) {
+        if ((buffer = gpuccAcquireTraceBuffer()) == nullptr) {
+            return;
+        }
+        tctx->TraceBuffer = buffer;
+    }
+    std::lock_guard<std::mutex> lock(buffer->Lock);
+    ev = &buffer->Events[buffer->RecordCount % buffer->Capacity];
+    ev->Name      = name;
+    ev->StartTime = start;
+    ev->Duration  = (now > start) ? now - start : 0;
+    ev->AsyncId   = async_id;
+    ev->ThreadId  = buffer->ThreadId;
+    gpuccTraceSetDetail(ev->Detail, detail, detail2);
+    buffer->RecordCount++;
+}
+
+/* @summary Write a string to a JSON file as the body of a quoted string, escaping characters as required.
+ * @param fp The output file.
+ * @param str The nul-terminated UTF-8 string.
+ */
+static void
+gpuccTraceWriteString
+(
+    FILE        *fp,
+    char const *str
+)
+{
+    for (uint8_t const *p = (uint8_t const*) str; *p != 0; ++p) {
+        if (*p == '"' || *p == '\\') {
+            fputc('\\', fp);
+            fputc(*p, fp);
+        } else if (*p < 0x20) {
+            fprintf(fp, "\\u%04x", (unsigned) *p);
+        } else {
+            fputc(*p, fp);
+        }
+    }
+}
+
+/* @summary Write a time value, in nanoseconds, as a JSON number of microseconds.
+ * @param fp The output file.
+ * @param key The name of the JSON field.
+ * @param ns The time value, in nanoseconds.
+ */
+static void
+gpuccTraceWriteTime
+(
+    FILE        *fp,
+    char const *key,
+    uint64_t     ns
+)
+{
+    fprintf(fp, ",\"%s\":%" PRIu64 ".%03u", key, (uint64_t)(ns / 1000U), (unsigned)(ns % 1000U));
+}
+
+/* @summary Write a single trace event as one or two Chrome trace event records.
+ * @param fp The output file.
+ * @param ev The event to write.
+ * @param pid The identifier of the current process.
+ * @param first Non-zero if this is the first record in the traceEvents array.
+ */
+static void
+gpuccTraceWriteEvent
+(
+    FILE                     *fp,
+    GPUCC_TRACE_EVENT const  *ev,
+    uint64_t                 pid,
+    int32_t                first
+)
+{
+    char const *phases[2] = { "b", "e" };
+    uint64_t     times[2] = { ev->StartTime, ev->StartTime + ev->Duration };
+    int32_t        count  = (ev->AsyncId != 0) ? 2 : 1;
+
+    for (int32_t i = 0; i < count; ++i) {
+        fputs((first && i == 0) ? "\n{\"name\":\"" : ",\n{\"name\":\"", fp);
+        gpuccTraceWriteString(fp, ev->Name);
+        if (ev->Detail[0] != 0) {
+            fputc(' ', fp);
+            gpuccTraceWriteString(fp, ev->Detail);
+        }
+        if (ev->AsyncId != 0) {
+            fprintf(fp, "\",\"cat\":\"gpucc\",\"ph\":\"%s\",\"id\":\"0x%" PRIx64 "\"", phases[i], ev->AsyncId);
+            gpuccTraceWriteTime(fp, "ts", times[i]);
+        } else {
+            fputs("\",\"cat\":\"gpucc\",\"ph\":\"X\"", fp);
+            gpuccTraceWriteTime(fp, "ts" , ev->StartTime);
+            gpuccTraceWriteTime(fp, "dur", ev->Duration);
+        }
+        fprintf(fp, ",\"pid\":%" PRIu64 ",\"tid\":%" PRIu64 "}", pid, ev->ThreadId);
+    }
+}
+
+GPUCC_API(uint64_t)
+gpuccTraceBegin
+(
+    void
+)
+{
+    return g_TraceEnabled.load(std::memory_order_relaxed) ? gpuccQueryClockNanoseconds() : 0;
+}
+
+GPUCC_API(void)
+gpuccTraceEnd
+(
+    char const    *name,
+    uint64_t      start,
+    char const  *detail,
+    char const *detail2
+)
+{
+    if (start != 0 && g_TraceEnabled.load(std::memory_order_relaxed)) {
+        gpuccTraceRecord(name, start, 0, detail, detail2);
+    }
+}
+
+GPUCC_API(void)
+gpuccTraceEndAsync
+(
+    char const *name,
+    uint64_t   start
+)
+{
+    if (start != 0 && g_TraceEnabled.load(std::memory_order_relaxed)) {
+        gpuccTraceRecord(name, start, g_TraceAsyncId.fetch_add(1, std::memory_order_relaxed) + 1, nullptr, nullptr);
+    }
+}
+
+GPUCC_API(void)
+gpuccReleaseTraceBuffer
+(
+    struct GPUCC_TRACE_BUFFER *buffer
+)
+{
+    if (buffer != nullptr) {
+        buffer->InUse.store(0, std::memory_order_release);
+    }
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccEnableTracing
+(
+    uint32_t events_per_thread
+)
+{
+    GPUCC_RESULT result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+
+    if (events_per_thread > UINT32_MAX / sizeof(GPUCC_TRACE_EVENT)) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    g_TraceCapacity.store((events_per_thread != 0) ? events_per_thread : GPUCC_TRACE_DEFAULT_EVENT_COUNT, std::memory_order_relaxed);
+    g_TraceEnabled.store(1, std::memory_order_relaxed);
+    gpuccSetLastResult(result);
+    return result;
+}
+
+GPUCC_API(void)
+gpuccDisableTracing
+(
+    void
+)
+{
+    g_TraceEnabled.store(0, std::memory_order_relaxed);
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccWriteTraceFile
+(
+    char const *path
+)
+{
+    GPUCC_RESULT                 result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+    std::vector<GPUCC_TRACE_EVENT> events;
+    uint64_t                    dropped = 0;
+    uint64_t                        pid = gpuccQueryCurrentProcessId();
+    FILE                            *fp = nullptr;
+
+    if (path == nullptr) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccSetLastResult(result);
+        return result;
+    }
+    /* Open the file first, so that the events are not discarded if it cannot be created. */
+    if ((fp = fopen(path, "wb")) == nullptr) {
+        result = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+        gpuccSetLastResult(result);
+        return result;
+    }
+
+    /* Copy out and reset each buffer in turn, holding its lock only for the copy. */
+    try {
+        for (GPUCC_TRACE_BUFFER *buffer = g_TraceBuffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->Next) {
+            std::lock_guard<std::mutex> lock(buffer->Lock);
+            uint64_t count = (buffer->RecordCount < buffer->Capacity) ? buffer->RecordCount : buffer->Capacity;
+            uint64_t first = (buffer->RecordCount - count) % buffer->Capacity;
+            for (uint64_t i = 0; i < count; ++i) {
+                events.push_back(buffer->Events[(first + i) % buffer->Capacity]);
+            }
+            dropped += buffer->RecordCount - count;
+            buffer->RecordCount = 0;
+        }
+    } catch (std::bad_alloc const&) {
+        fclose(fp);
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+        gpuccSetLastResult(result);
+        return result;
+    }
+
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":\"%" PRIu64 "\"},\"traceEvents\":[", dropped);
+    for (size_t i = 0, n = events.size(); i < n; ++i) {
+        gpuccTraceWriteEvent(fp, &events[i], pid, i == 0);
+    }
+    fputs("\n]}\n", fp);
+    if (ferror(fp) != 0) {
+        result = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+    }
+    if (fclose(fp) != 0 && gpuccSuccess(result)) {
+        result = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+    }
+    gpuccSetLastResult(result);
+    return result;
+}
@@ -0,0 +1,201 @@
+/**
+ * @summary gpucc_worker.cc: Implement the platform-independent portion of
+ * worker process pools, which serializes a compiler configuration so that a
+ * worker process can create an equivalent compiler.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_worker.h"
+
+/* @summary The function used by worker processes to create compilers, or NULL to use gpuccCreateCompiler. Set by the worker host before any worker starts.
+ */
+static PFN_gpuccCreateWorkerCompiler g_WorkerCompilerFactory = nullptr;
+
+/* @summary Compute the number of bytes required to serialize a string.
+ * @param str A nul-terminated UTF-8 string, or NULL.
+ * @return The number of bytes required.
+ */
+static size_t
+gpuccWorkerConfigStringSize
+(
+    char const *str
+)
+{
+    return (str != nullptr) ? strlen(str) + 2 : 1;
+}
+
+/* @summary Serialize a string into a configuration buffer.
+ * @param ptr The position at which to write the string.
+ * @param str A nul-terminated UTF-8 string, or NULL.
+ * @return The position following the string.
+ */
+static uint8_t*
+gpuccWorkerConfigPutString
+(
+    uint8_t    *ptr,
+    char const *str
+)
+{
+    if (str != nullptr) {
+        size_t nb = strlen(str) + 1;
+       *ptr++ = 1;
+        memcpy(ptr, str, nb);
+        return ptr + nb;
+    }
+   *ptr++ = 0;
+    return ptr;
+}
+
+/* @summary Retrieve a string from a configuration buffer.
+ * @param ptr The position of the string. On return, the position following the string.
+ * @param end The end of the configuration buffer.
+ * @param o_str On return, points to the nul-terminated string within the buffer, or NULL.
+ * @return Non-zero if the string was retrieved, or zero if it extends past the end of the buffer.
+ */
+static int32_t
+gpuccWorkerConfigGetString
+(
+    uint8_t const **ptr,
+    uint8_t const   *end,
+    char const   **o_str
+)
+{
+    uint8_t const *nul = nullptr;
+
+    if (*ptr >= end) {
+        return 0;
+    }
+    if (*(*ptr)++ == 0) {
+       *o_str = nullptr;
+        return 1;
+    }
+    if ((nul = (uint8_t const*) memchr(*ptr, 0, (size_t)(end - *ptr))) == nullptr) {
+        return 0;
+    }
+   *o_str =(char const*) *ptr;
+   *ptr   = nul + 1;
+    return 1;
+}
+
+GPUCC_API(int32_t)
+gpuccInitWorkerConfig
+(
+    struct GPUCC_PROGRAM_COMPILER      *compiler,
+    struct GPUCC_PROGRAM_COMPILER_INIT   *config
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+    GPUCC_WORKER_CONFIG            *worker = nullptr;
+    uint8_t                           *ptr = nullptr;
+    size_t                          nbneed = sizeof(GPUCC_WORKER_CONFIG);
+
+    compiler_->WorkerPool   = config->WorkerPool;
+    compiler_->WorkerConfig = nullptr;
+    if (config->WorkerPool == nullptr) {
+        return 1;
+    }
+    nbneed += gpuccWorkerConfigStringSize(config->TargetProfile);
+    for (uint32_t i = 0, n = config->DefineCount; i < n; ++i) {
+        nbneed += gpuccWorkerConfigStringSize(config->DefineSymbols[i]);
+        nbneed += gpuccWorkerConfigStringSize(config->DefineValues [i]);
+    }
+    if ((worker = (GPUCC_WORKER_CONFIG*) gpuccHostAlloc(&compiler_->HostAllocator, nbneed, alignof(GPUCC_WORKER_CONFIG))) == nullptr) {
+        return 0;
+    }
+    worker->ConfigHash          = compiler_->ConfigHash;
+    worker->CompilerFlags       = config->CompilerFlags;
+    worker->TotalSize           =(uint64_t) nbneed;
+    worker->RecycleMemoryBytes  = config->RecycleMemoryBytes;
+    worker->RecycleCompileCount = config->RecycleCompileCount;
+    worker->TargetRuntime       = config->TargetRuntime;
+    worker->BytecodeType        = config->BytecodeType;
+    worker->DefineCount         = config->DefineCount;
+    worker->IncludeFlag         = (compiler_->IncludeHandler.Resolve != nullptr) ? 1 : 0;
+    ptr = (uint8_t*) worker + sizeof(GPUCC_WORKER_CONFIG);
+    ptr = gpuccWorkerConfigPutString(ptr, config->TargetProfile);
+    for (uint32_t i = 0, n = config->DefineCount; i < n; ++i) {
+        ptr = gpuccWorkerConfigPutString(ptr, config->DefineSymbols[i]);
+        ptr = gpuccWorkerConfigPutString(ptr, config->DefineValues [i]);
+    }
+    compiler_->WorkerConfig = worker;
+    return 1;
+}
+
+GPUCC_API(void)
+gpuccReleaseWorkerConfig
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+
+    if (compiler_->WorkerConfig != nullptr) {
+        gpuccHostFree(&compiler_->HostAllocator, compiler_->WorkerConfig);
+        compiler_->WorkerConfig = nullptr;
+    }
+}
+
+GPUCC_API(int32_t)
+gpuccParseWorkerConfig
+(
+    struct GPUCC_WORKER_CONFIG const *config,
+    uint64_t                     config_size,
+    struct GPUCC_PROGRAM_COMPILER_INIT *o_init
+)
+{
+    uint8_t const  *ptr = (uint8_t const*) config + sizeof(GPUCC_WORKER_CONFIG);
+    uint8_t const  *end = (uint8_t const*) config + config_size;
+    char const **strings = nullptr;
+
+    memset(o_init, 0, sizeof(GPUCC_PROGRAM_COMPILER_INIT));
+    if (config_size < sizeof(GPUCC_WORKER_CONFIG) || config->TotalSize != config_size) {
+        return 0;
+    }
+    /* Each string occupies at least one byte, which bounds the allocation below. */
+    if (config->DefineCount > (config_size - sizeof(GPUCC_WORKER_CONFIG)) / 2) {
+        return 0;
+    }
+    if (config->DefineCount > 0 && (strings = (char const**) malloc(2 * config->DefineCount * sizeof(char const*))) == nullptr) {
+        return 0;
+    }
+    if (gpuccWorkerConfigGetString(&ptr, end, &o_init->TargetProfile) == 0) {
+        free(strings);
+        return 0;
+    }
+    for (uint32_t i = 0, n = config->DefineCount; i < n; ++i) {
+        if (gpuccWorkerConfigGetString(&ptr, end, &strings[i]) == 0 || gpuccWorkerConfigGetString(&ptr, end, &strings[n + i]) == 0) {
+            free(strings);
+            return 0;
+        }
+    }
+    o_init->DefineSymbols = strings;
+    o_init->DefineValues  = (strings != nullptr) ? strings + config->DefineCount : nullptr;
+    o_init->TargetRuntime = config->TargetRuntime;
+    o_init->BytecodeType  = config->BytecodeType;
+    o_init->CompilerFlags = config->CompilerFlags;
+    o_init->DefineCount   = config->DefineCount;
+    return 1;
+}
+
+GPUCC_API(void)
+gpuccSetWorkerCompilerFactory
+(
+    PFN_gpuccCreateWorkerCompiler factory
+)
+{
+    g_WorkerCompilerFactory = factory;
+}
+
+GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
+gpuccCreateWorkerCompiler
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT *config
+)
+{
+    if (g_WorkerCompilerFactory != nullptr) {
+        return g_WorkerCompilerFactory(config);
+    }
+    return gpuccCreateCompiler(config);
+}
@@ -0,0 +1,377 @@
+/**
+ * gpucc_internal_linux.cc: Implement the platform-specific portions of the
+ * internal library interface from gpucc_internal.h and gpucc_internal_linux.h.
+ */
+#include <assert.h>
+#include <dlfcn.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+
+/* @summary Define the nice value applied to threads running at GPUCC_WORKER_THREAD_PRIORITY_REDUCED or GPUCC_WORKER_THREAD_PRIORITY_IDLE.
+ */
+#ifndef GPUCC_WORKER_THREAD_REDUCED_NICE
+#define GPUCC_WORKER_THREAD_REDUCED_NICE                                         10
+#endif
+
+GPUCC_API(void)
+gpuccDebugPrintf
+(
+    char const *format,
+    ...
+)
+{
+    GPUCC_PROCESS_CONTEXT_LINUX *pctx = gpuccGetProcessContext_();
+    char                 buffer[2048];
+    va_list                      args;
+    int                        nchars;
+
+    if (pctx->DebugOutputFlag == 0) {
+        return;
+    }
+    va_start(args, format);
+    nchars = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (nchars < 0) {
+        assert(0 && "Error formatting debug output");
+        fputs("GpuCC: Error formatting debug output.\n", stderr);
+        return;
+    }
+    assert(nchars  <  (int) sizeof(buffer) && "Increase gpuccDebugPrintf buffer size");
+    fputs(buffer, stderr);
+}
+
+GPUCC_API(int32_t)
+gpuccStringInfoUtf8
+(
+    GPUCC_STRING_INFO *o_info,
+    char const           *str
+)
+{
+    uint8_t const *p =(uint8_t const*) str;
+    size_t    nchars = 0;
+
+    assert(o_info != nullptr);
+
+    if (str == nullptr) { /* Only output a nul. */
+        o_info->ByteCount = 1;
+        o_info->CharCount = 1;
+        return 0;
+    }
+    while (*p != 0) {
+        uint32_t cp = 0;
+        size_t   nb = 0;
+        if ((p[0] & 0x80) == 0x00) {
+            cp = p[0]; nb = 1;
+        } else if ((p[0] & 0xE0) == 0xC0) {
+            cp = p[0] & 0x1F; nb = 2;
+        } else if ((p[0] & 0xF0) == 0xE0) {
+            cp = p[0] & 0x0F; nb = 3;
+        } else if ((p[0] & 0xF8) == 0xF0) {
+            cp = p[0] & 0x07; nb = 4;
+        } else { /* Invalid lead byte. */
+            goto invalid_codepoint;
+        }
+        for (size_t i = 1; i < nb; ++i) {
+            if ((p[i] & 0xC0) != 0x80) {
+                goto invalid_codepoint; /* Truncated sequence or invalid continuation byte. */
+            } cp = (cp << 6) | (p[i] & 0x3F);
+        }
+        if ((nb == 2 && cp < 0x80) || (nb == 3 && cp < 0x800) || (nb == 4 && cp < 0x10000)) {
+            goto invalid_codepoint; /* Overlong encoding. */
+        }
+        if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+            goto invalid_codepoint; /* Out of range, or a UTF-16 surrogate. */
+        }
+        p += nb; nchars++;
+    }
+    o_info->ByteCount = (size_t)(p - (uint8_t const*) str) + 1;
+    o_info->CharCount = nchars + 1;
+    return 0;
+
+invalid_codepoint:
+    o_info->ByteCount = 1;
+    o_info->CharCount = 1;
+    return -1;
+}
+
+GPUCC_API(char*)
+gpuccPutStringUtf8
+(
+    uint8_t   *&dst,
+    char const *src
+)
+{
+    char *p  =(char*) dst;
+    if (src != nullptr) {
+        size_t nb = strlen(src);
+        memcpy(dst, src, nb);
+        dst += nb; /* string data */
+    }
+   *dst  = 0;  /* put nul */
+    dst += 1;  /* nul */
+    return p;
+}
+
+GPUCC_API(int32_t)
+gpuccExtractDirect3DShaderModel
+(
+    char const *target,
+    char    o_stage[3],
+    int    *o_sm_major,
+    int    *o_sm_minor
+)
+{
+    unsigned int level_major = 0;
+    unsigned int level_minor = 0;
+    char                 st0 = 0;
+    char                 st1 = 0;
+    int              nbmatch = 0;
+
+    if ((nbmatch = sscanf(target, "%c%c_%u_%u", &st0, &st1, &level_major, &level_minor)) == 4) {
+        o_stage[0] = st0;
+        o_stage[1] = st1;
+        o_stage[2] = 0;
+       *o_sm_major =(int) level_major;
+       *o_sm_minor =(int) level_minor;
+        return  0;
+    } else { /* The target profile string doesn't match the expected format. */
+        o_stage[0] = 0;
+        o_stage[1] = 0;
+        o_stage[2] = 0;
+       *o_sm_major = 0;
+       *o_sm_minor = 0;
+        return -1;
+    }
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccMakeResult
+(
+    int32_t library_result
+)
+{
+    return GPUCC_RESULT { library_result, 0 };
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccMakeResult_errno
+(
+    int32_t library_result
+)
+{
+    return GPUCC_RESULT { library_result, (int32_t) errno };
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccSetLastResult
+(
+    struct GPUCC_RESULT result
+)
+{
+    GPUCC_THREAD_CONTEXT_LINUX *tctx = gpuccGetThreadContext_();
+    GPUCC_RESULT                prev = tctx->LastResult;
+    tctx->LastResult = result;
+    return prev;
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccSetProgramEntryPoint
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode,
+    char const                 *entry_point,
+    char const                 *source_path
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *bytecode_ =(GPUCC_PROGRAM_BYTECODE_BASE*) bytecode;
+    GPUCC_RESULT                    result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+    uint8_t                        *buffer = nullptr;
+    uint8_t                           *ptr = nullptr;
+    size_t                          nbneed = 0;
+    size_t                          nbpath = 0;
+    size_t                         nbentry = 0;
+
+    /* Determine the amount of memory required to store copies of the strings. */
+    nbentry = (entry_point != nullptr) ? (strlen(entry_point) + 1) : 1;
+    nbpath  = (source_path != nullptr) ? (strlen(source_path) + 1) : 1;
+    nbneed  = nbentry + nbpath;
+
+    /* Allocate memory for all string data in one buffer, reusing the buffer from a previous compilation if it is large enough. */
+    if (nbneed > bytecode_->StringBufferSize) {
+        if ((buffer = (uint8_t*) gpuccHostAlloc(gpuccQueryBytecodeHostAllocator_(bytecode), nbneed, 1)) == nullptr) {
+            result  = gpuccMakeResult_errno(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+            gpuccDebugPrintf("GpuCC: Failed to allocate %zu bytes for storing program entry point.\n", nbneed);
+            gpuccSetLastResult(result);
+            return result;
+        }
+        gpuccHostFree(gpuccQueryBytecodeHostAllocator_(bytecode), bytecode_->StringBuffer);
+        bytecode_->StringBuffer     =(char*) buffer;
+        bytecode_->StringBufferSize = nbneed;
+    } ptr = (uint8_t*) bytecode_->StringBuffer;
+
+    /* Write the string data to the buffer. */
+    bytecode_->EntryPoint = gpuccPutStringUtf8(ptr, entry_point);
+    bytecode_->SourcePath = gpuccPutStringUtf8(ptr, source_path);
+    return result;
+}
+
+GPUCC_API(int32_t)
+gpuccBytecodeContainerIsEmpty
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    if (bytecode != nullptr) {
+        GPUCC_RESULT r = gpuccQueryBytecodeCompileResult_(bytecode);
+        return r.LibraryResult == GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER;
+    } else {
+        assert(0 && "Invalid bytecode container");
+        return 0;
+    }
+}
+
+GPUCC_API(int32_t)
+gpuccQueryFileInfo
+(
+    char const            *path, 
+    uint64_t     *o_modify_time, 
+    uint64_t       *o_file_size
+)
+{
+    struct stat st;
+
+    if (stat(path, &st) != 0 || S_ISREG(st.st_mode) == 0) {
+       *o_modify_time = 0;
+       *o_file_size   = 0;
+        return 0;
+    }
+    /* Nanosecond resolution, so that two saves within one second are distinguished. */
+   *o_modify_time =((uint64_t) st.st_mtim.tv_sec * 1000000000ULL) + (uint64_t) st.st_mtim.tv_nsec;
+   *o_file_size   = (uint64_t) st.st_size;
+    return 1;
+}
+
+GPUCC_API(int32_t)
+gpuccPathIsAbsolute
+(
+    char const *path
+)
+{
+    return path[0] == '/';
+}
+
+GPUCC_API(size_t)
+gpuccPathDirectoryLength
+(
+    char const *path
+)
+{
+    char const *sep = strrchr(path, '/');
+    return (sep != nullptr) ? (size_t)(sep - path) + 1 : 0;
+}
+
+GPUCC_API(uint64_t)
+gpuccQueryThreadCpuNanoseconds
+(
+    void
+)
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+GPUCC_API(uint64_t)
+gpuccQueryClockNanoseconds
+(
+    void
+)
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        return 0;
+    }
+    return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+GPUCC_API(uint64_t)
+gpuccQueryCurrentThreadId
+(
+    void
+)
+{
+    return (uint64_t) syscall(SYS_gettid);
+}
+
+GPUCC_API(uint64_t)
+gpuccQueryCurrentProcessId
+(
+    void
+)
+{
+    return (uint64_t) getpid();
+}
+
+GPUCC_API(uint64_t)
+gpuccQueryModuleVersion
+(
+    void const   *address,
+    uint64_t  api_version
+)
+{
+    GPUCC_HASH_STATE state;
+    GPUCC_HASH128     hash;
+    Dl_info           info;
+    struct stat         st;
+
+    gpuccHashInit  (&state, 0);
+    gpuccHashUpdate(&state, &api_version, sizeof(api_version));
+    if (dladdr(address, &info) != 0 && info.dli_fname != nullptr && stat(info.dli_fname, &st) == 0) {
+        uint64_t size  =(uint64_t) st.st_size;
+        uint64_t mtime =(uint64_t) st.st_mtim.tv_sec * 1000000000ULL + (uint64_t) st.st_mtim.tv_nsec;
+        gpuccHashUpdateString(&state, info.dli_fname);
+        gpuccHashUpdate(&state, &size , sizeof(size));
+        gpuccHashUpdate(&state, &mtime, sizeof(mtime));
+    }
+    hash = gpuccHashFinal(&state);
+    return hash.Low;
+}
+
+GPUCC_API(int32_t)
+gpuccSetCurrentThreadPriority
+(
+    int32_t priority
+)
+{
+    struct sched_param param;
+    pid_t                tid = (pid_t) syscall(SYS_gettid);
+    int               policy = (priority == GPUCC_WORKER_THREAD_PRIORITY_IDLE) ? SCHED_IDLE : SCHED_OTHER;
+    int                 nice = (priority == GPUCC_WORKER_THREAD_PRIORITY_NORMAL) ? 0 : GPUCC_WORKER_THREAD_REDUCED_NICE;
+    int32_t               ok = 1;
+
+    /* On Linux, the policy and nice value of each thread are independent, so
+     * both are set. If SCHED_IDLE is unavailable the nice value still applies.
+     * Leaving SCHED_IDLE and lowering the nice value both require CAP_SYS_NICE
+     * (or a sufficient RLIMIT_NICE), so raising the priority usually fails. */
+    param.sched_priority = 0;
+    if (sched_setscheduler(0, policy, &param) != 0) {
+        gpuccDebugPrintf("GpuCC: sched_setscheduler(%s) failed with errno %d.\n", (policy == SCHED_IDLE) ? "SCHED_IDLE" : "SCHED_OTHER", errno);
+        ok = 0;
+    }
+    if (setpriority(PRIO_PROCESS, (id_t) tid, nice) != 0) {
+        gpuccDebugPrintf("GpuCC: setpriority(%d) failed with errno %d.\n", nice, errno);
+        ok = 0;
+    }
+    return ok;
+}
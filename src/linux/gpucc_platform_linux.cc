@@ -0,0 +1,330 @@
+#include <assert.h>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_async.h"
+#include "gpucc_cache.h"
+#include "gpucc_depend.h"
+#include "gpucc_flight.h"
+#include "gpucc_recycle.h"
+#include "gpucc_stats.h"
+#include "gpucc_trace.h"
+#include "gpucc_worker.h"
+#include "linux/gpucc_compiler_ptx_linux.h"
+#include "linux/gpucc_compiler_shaderc_linux.h"
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccGetLastResult
+(
+    void
+)
+{
+    GPUCC_THREAD_CONTEXT_LINUX *tctx = gpuccGetThreadContext_();
+    return tctx->LastResult;
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccStartup
+(
+    uint32_t gpucc_usage_mode
+)
+{
+    GPUCC_PROCESS_CONTEXT_LINUX *pctx = gpuccGetProcessContext_();
+    GPUCC_RESULT               result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+    uint32_t        ptxcompiler_flags = PTXCOMPILERAPI_LOADER_FLAGS_NONE;
+    uint32_t         shcompiler_flags = SHADERCCOMPILERAPI_LOADER_FLAGS_NONE;
+    uint64_t                  startup = gpuccTraceBegin();
+    uint64_t                    trace = 0;
+
+    if (gpucc_usage_mode != GPUCC_USAGE_MODE_OFFLINE &&
+        gpucc_usage_mode != GPUCC_USAGE_MODE_RUNTIME) {
+        return gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_USAGE_MODE);
+    }
+    if (pctx->InitializationFlag == 0) {
+        /* The shared object constructor failed to set up the process context. */
+        return gpuccMakeResult(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+    }
+    if (pctx->StartupFlag != 0) {
+        return gpuccMakeResult(GPUCC_RESULT_CODE_ALREADY_INITIALIZED);
+    }
+
+    /* Create the worker pool used for asynchronous compilation. Worker threads are started on first use. */
+    if ((pctx->CompilePool = gpuccCreateCompilePool(0)) == nullptr) {
+        return gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+    }
+    /* Create the table used to deduplicate identical compilations that are in progress at the same time. */
+    if ((pctx->CompileFlights = gpuccCreateCompileFlightTable()) == nullptr) {
+        gpuccDeleteCompilePool(pctx->CompilePool);
+        pctx->CompilePool = nullptr;
+        return gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+    }
+
+    /* Populate dispatch tables for any available compilers.
+     * The Direct3D compilers (FXC and DXC) are not available on Linux. */
+    pctx->CompilerSupport = GPUCC_COMPILER_SUPPORT_NONE;
+    trace = gpuccTraceBegin();
+    if (PtxCompilerApiPopulateDispatch(&pctx->PtxCompiler_Dispatch, ptxcompiler_flags) != 0) {
+        pctx->CompilerSupport |= GPUCC_COMPILER_SUPPORT_NVRTC;
+    }
+    gpuccTraceEnd("Load compiler backend", trace, "NVRTC", nullptr);
+    trace = gpuccTraceBegin();
+    if (ShadercCompilerApiPopulateDispatch(&pctx->ShadercCompiler_Dispatch, shcompiler_flags) != 0) {
+        pctx->CompilerSupport |= GPUCC_COMPILER_SUPPORT_SHADERC;
+    }
+    gpuccTraceEnd("Load compiler backend", trace, "shaderc", nullptr);
+    /* ... */
+    pctx->StartupFlag = 1;
+    gpuccTraceEnd("gpuccStartup", startup, nullptr, nullptr);
+    return result;
+}
+
+GPUCC_API(void)
+gpuccShutdown
+(
+    void
+)
+{
+    GPUCC_PROCESS_CONTEXT_LINUX *pctx = gpuccGetProcessContext_();
+
+    /* Finish any outstanding asynchronous compile jobs before the compilers are unloaded. */
+    gpuccDeleteCompilePool(pctx->CompilePool);
+    pctx->CompilePool = nullptr;
+    gpuccDeleteCompileFlightTable(pctx->CompileFlights);
+    pctx->CompileFlights = nullptr;
+
+    /* Invalidate the dispatch tables for any available compilers. */
+    PtxCompilerApiInvalidateDispatch(&pctx->PtxCompiler_Dispatch);
+    ShadercCompilerApiInvalidateDispatch(&pctx->ShadercCompiler_Dispatch);
+    /* ... */
+
+    gpuccDisableBytecodeCache();
+    pctx->CompilerSupport = GPUCC_COMPILER_SUPPORT_NONE;
+    pctx->StartupFlag     = 0;
+}
+
+GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
+gpuccCreateCompiler
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT *config
+)
+{
+    GPUCC_PROCESS_CONTEXT_LINUX   *pctx = gpuccGetProcessContext_();
+    GPUCC_COMPILER_TYPE   compiler_type = GPUCC_COMPILER_TYPE_UNKNOWN;
+    GPUCC_COMPILER_SUPPORT need_support = GPUCC_COMPILER_SUPPORT_NONE;
+    struct GPUCC_PROGRAM_COMPILER    *c = nullptr;
+    uint64_t                      trace = gpuccTraceBegin();
+    GPUCC_HOST_ALLOCATOR          alloc;
+
+    if (pctx->StartupFlag == 0) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_NOT_INITIALIZED);
+        gpuccDebugPrintf("GpuCC: Cannot create compiler. Call gpuccStartup() first.\n");
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+    if (config == nullptr) {
+        assert(config != nullptr);
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccDebugPrintf("GpuCC: No compliler configuration was specified.\n");
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+    if (config->DefineCount > 0 && (config->DefineSymbols == nullptr || config->DefineValues == nullptr)) {
+        assert(config->DefineSymbols != nullptr);
+        assert(config->DefineValues  != nullptr);
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccDebugPrintf("GpuCC: DefineCount is non-zero, but symbols or values array is not specified.\n");
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+    if (config->HostAllocator != nullptr && gpuccInitHostAllocator(&alloc, config->HostAllocator) == 0) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccDebugPrintf("GpuCC: A GPUCC_HOST_ALLOCATOR must specify the Allocate, Reallocate and Free callbacks.\n");
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+    if (config->IncludeHandler != nullptr && (config->IncludeHandler->Resolve == nullptr || config->IncludeHandler->Release == nullptr)) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccDebugPrintf("GpuCC: A GPUCC_INCLUDE_HANDLER must specify the Resolve and Release callbacks.\n");
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+    switch (config->BytecodeType) {
+        case GPUCC_BYTECODE_TYPE_UNKNOWN:
+            break;
+        case GPUCC_BYTECODE_TYPE_DXIL:
+            compiler_type = GPUCC_COMPILER_TYPE_DXC;
+            need_support  = GPUCC_COMPILER_SUPPORT_DXC;
+            break;
+        case GPUCC_BYTECODE_TYPE_DXBC:
+            compiler_type = GPUCC_COMPILER_TYPE_FXC;
+            need_support  = GPUCC_COMPILER_SUPPORT_FXC;
+            break;
+        case GPUCC_BYTECODE_TYPE_SPIRV:
+            compiler_type = GPUCC_COMPILER_TYPE_SHADERC;
+            need_support  = GPUCC_COMPILER_SUPPORT_SHADERC;
+            break;
+        case GPUCC_BYTECODE_TYPE_PTX:
+            compiler_type = GPUCC_COMPILER_TYPE_NVRTC;
+            need_support  = GPUCC_COMPILER_SUPPORT_NVRTC;
+            break;
+        default:
+            break;
+    }
+    if (compiler_type == GPUCC_COMPILER_TYPE_UNKNOWN) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_BYTECODE_TYPE);
+        gpuccDebugPrintf("GpuCC: Unable to determine compiler type from bytecode type %s.\n", gpuccBytecodeTypeString(config->BytecodeType));
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+    if ((pctx->CompilerSupport & need_support) == 0) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_COMPILER_NOT_SUPPORTED);
+        gpuccDebugPrintf("GpuCC: The required compiler type %s is not supported on this host platform.\n", gpuccCompilerTypeString(compiler_type));
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+
+    switch (compiler_type) {
+        case GPUCC_COMPILER_TYPE_NVRTC:
+            c = gpuccCreateCompilerPtx(config);
+            break;
+        case GPUCC_COMPILER_TYPE_SHADERC:
+            c = gpuccCreateCompilerShaderc(config);
+            break;
+        default:
+            c = nullptr;
+            break;
+    }
+    if (c != nullptr && (c = gpuccInitCompilerCommon(c, config)) == nullptr) {
+        return nullptr;
+    }
+    gpuccTraceEnd("gpuccCreateCompiler", trace, gpuccCompilerTypeString(compiler_type), config->TargetProfile);
+    return c;
+}
+
+GPUCC_API(void)
+gpuccDeleteCompiler
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    if (compiler) {
+        GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+        GPUCC_HOST_ALLOCATOR             alloc = compiler_->HostAllocator;
+        gpuccReleaseWorkerConfig(compiler);
+        gpuccReleaseRecyclePolicy(compiler);
+        compiler_->CleanupCompiler(compiler);
+        gpuccHostFree(&alloc, compiler);
+    }
+}
+
+GPUCC_API(struct GPUCC_PROGRAM_BYTECODE*)
+gpuccCreateBytecodeContainer
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    struct GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+
+    if (compiler == nullptr) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccDebugPrintf("GpuCC: A valid GPUCC_PROGRAM_COMPILER must be specified to gpuccCreateBytecodeContainer.\n");
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+
+    return compiler_->CreateBytecode(compiler);
+}
+
+GPUCC_API(void)
+gpuccDeleteBytecodeContainer
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    if (bytecode) {
+        struct GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) gpuccQueryBytecodeCompiler_(bytecode);
+        assert(compiler_ != nullptr);
+        gpuccBytecodeCacheRelease(bytecode);
+        gpuccReleaseSharedResult(bytecode);
+        gpuccReleaseWorkerResult(bytecode);
+        gpuccFreeDependencies(bytecode);
+        compiler_->DeleteBytecode(bytecode);
+    }
+}
+
+GPUCC_API(void)
+gpuccResetBytecodeContainer
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    if (bytecode) {
+        struct GPUCC_PROGRAM_BYTECODE_BASE *bytecode_ =(GPUCC_PROGRAM_BYTECODE_BASE*) bytecode;
+        struct GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) gpuccQueryBytecodeCompiler_(bytecode);
+        assert(compiler_ != nullptr);
+        gpuccBytecodeCacheRelease(bytecode);
+        gpuccReleaseSharedResult(bytecode);
+        gpuccReleaseWorkerResult(bytecode);
+        gpuccResetDependencies(bytecode);
+        compiler_->ResetBytecode(bytecode);
+        /* The string buffer is retained; gpuccSetProgramEntryPoint reuses it. */
+        bytecode_->CompileResult  = gpuccMakeResult(GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER);
+        bytecode_->EntryPoint     = nullptr;
+        bytecode_->SourcePath     = nullptr;
+        bytecode_->LogBuffer      = nullptr;
+        bytecode_->LogBufferSize  = 0;
+        bytecode_->BytecodeSize   = 0;
+        bytecode_->BytecodeBuffer = nullptr;
+        memset(&bytecode_->BackendMemory, 0, sizeof(GPUCC_BACKEND_MEMORY_STATS));
+        memset(&bytecode_->Timings      , 0, sizeof(GPUCC_COMPILE_TIMINGS));
+    }
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccCompileProgramBytecode
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size,
+    char const                  *source_path,
+    char const                  *entry_point
+)
+{
+    GPUCC_RESULT result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+    uint64_t      start = 0;
+
+    if (container == nullptr) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccDebugPrintf("GpuCC: No bytecode container was supplied.\n");
+        gpuccSetLastResult(result);
+        return result;
+    }
+    if (source_code == nullptr || source_size == 0) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccDebugPrintf("GpuCC: No program source code was supplied.\n");
+        gpuccSetLastResult(result);
+        return result;
+    }
+    if (gpuccBytecodeContainerIsEmpty(container) == 0) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_BYTECODE_CONTAINER);
+        gpuccDebugPrintf("GpuCC: The supplied bytecode container has already been used to compile a program. Call gpuccResetBytecodeContainer to reuse it.\n");
+        gpuccSetLastResult(result);
+        return result;
+    }
+
+    /* Intern strings used for debug output. */
+    start = gpuccQueryClockNanoseconds();
+    if (gpuccFailure((result = gpuccSetProgramEntryPoint(container, entry_point, source_path)))) {
+        /* gpuccSetProgramEntryPoint called gpuccSetLastResult  */
+        gpuccDebugPrintf("GpuCC: Cannot copy program entry point and source path. Compilation cannot proceed.\n");
+        return result;
+    }
+    gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_STRING_INTERN, start);
+
+    /* Finally, perform the actual compilation, or load the result from the bytecode cache. */
+    result = gpuccExecuteCompile(container, source_code, source_size);
+    ((GPUCC_PROGRAM_BYTECODE_BASE*) container)->Timings.TotalNanoseconds = gpuccQueryClockNanoseconds() - start;
+    gpuccRecordCompileStatistics(container, source_size, result);
+    gpuccTraceEnd("gpuccCompileProgramBytecode", start, source_path, entry_point);
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return result;
+}
@@ -0,0 +1,157 @@
+/**
+ * @summary gpucc_watch_linux.cc: Implement the directory watcher used by the
+ * reload service on Linux, using inotify. An eventfd allows other threads to
+ * wake the service thread while it is blocked waiting for changes.
+ */
+#include <limits.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_reload.h"
+
+/* @summary Define the inotify events that indicate a file in a watched directory may have new content.
+ * Editors commonly save by writing a temporary file and renaming it over the original, which is reported as IN_MOVED_TO.
+ */
+#ifndef GPUCC_WATCH_INOTIFY_MASK
+#define GPUCC_WATCH_INOTIFY_MASK                                               \
+    (IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_ATTRIB | IN_ONLYDIR)
+#endif
+
+/* @summary Define the data associated with a directory watcher on Linux.
+ * inotify returns the same watch descriptor when a directory is added under a second spelling, so each descriptor maps to every spelling.
+ */
+typedef struct GPUCC_FILE_WATCHER {
+    int                            NotifyFd;                                   /* The inotify file descriptor, opened in non-blocking mode. */
+    int                            WakeFd;                                     /* The eventfd signaled by gpuccFileWatcherWake. */
+    std::unordered_map<int, std::vector<std::string>> Directories;             /* The directory spellings associated with each watch descriptor. */
+} GPUCC_FILE_WATCHER;
+
+GPUCC_API(struct GPUCC_FILE_WATCHER*)
+gpuccCreateFileWatcher
+(
+    void
+)
+{
+    GPUCC_FILE_WATCHER *watcher = nullptr;
+
+    if ((watcher = new (std::nothrow) GPUCC_FILE_WATCHER()) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    if ((watcher->NotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) == -1) {
+        gpuccDebugPrintf("GpuCC: inotify_init1 failed with errno %d.\n", errno);
+        gpuccSetLastResult(gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR));
+        delete watcher;
+        return nullptr;
+    }
+    if ((watcher->WakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) == -1) {
+        gpuccSetLastResult(gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR));
+        close(watcher->NotifyFd);
+        delete watcher;
+        return nullptr;
+    }
+    return watcher;
+}
+
+GPUCC_API(void)
+gpuccDeleteFileWatcher
+(
+    struct GPUCC_FILE_WATCHER *watcher
+)
+{
+    if (watcher != nullptr) {
+        close(watcher->WakeFd);
+        close(watcher->NotifyFd);
+        delete watcher;
+    }
+}
+
+GPUCC_API(int32_t)
+gpuccFileWatcherAddDirectory
+(
+    struct GPUCC_FILE_WATCHER *watcher,
+    char const              *directory
+)
+{
+    int wd = inotify_add_watch(watcher->NotifyFd, (directory[0] != 0) ? directory : ".", GPUCC_WATCH_INOTIFY_MASK);
+    if (wd == -1) {
+        return 0;
+    }
+    watcher->Directories[wd].push_back(directory);
+    return 1;
+}
+
+GPUCC_API(int32_t)
+gpuccFileWatcherWait
+(
+    struct GPUCC_FILE_WATCHER      *watcher,
+    uint32_t                     timeout_ms,
+    std::vector<std::string> &o_changed,
+    std::vector<std::string> &o_removed
+)
+{
+    struct pollfd fds[2];
+    int32_t        lost = 0;
+    uint64_t      count = 0;
+    alignas(struct inotify_event) char buffer[16 * (sizeof(struct inotify_event) + NAME_MAX + 1)];
+
+    fds[0].fd      = watcher->NotifyFd;
+    fds[0].events  = POLLIN;
+    fds[0].revents = 0;
+    fds[1].fd      = watcher->WakeFd;
+    fds[1].events  = POLLIN;
+    fds[1].revents = 0;
+    if (poll(fds, 2, (timeout_ms == GPUCC_WAIT_INFINITE) ? -1 : (int) timeout_ms) <= 0) {
+        /* Timed out, or interrupted by a signal. */
+        return 0;
+    }
+    if (fds[1].revents & POLLIN) {
+        while (read(watcher->WakeFd, &count, sizeof(count)) > 0) {
+            /* Reset the eventfd counter. */
+        }
+    }
+    for ( ; ; ) {
+        ssize_t nbread = read(watcher->NotifyFd, buffer, sizeof(buffer));
+        if (nbread <= 0) {
+            break;
+        }
+        for (char *p = buffer; p < buffer + nbread; ) {
+            struct inotify_event const *ev =(struct inotify_event const*) p;
+            if (ev->mask & IN_Q_OVERFLOW) {
+                lost = 1;
+            } else if (ev->mask & IN_IGNORED) {
+                /* The directory was deleted or unmounted, and the kernel has removed the watch. */
+                auto iter = watcher->Directories.find(ev->wd);
+                if (iter != watcher->Directories.end()) {
+                    for (std::string &directory : iter->second) {
+                        o_removed.push_back(std::move(directory));
+                    }
+                    watcher->Directories.erase(iter);
+                }
+            } else if (ev->len != 0) {
+                auto iter = watcher->Directories.find(ev->wd);
+                if (iter != watcher->Directories.end()) {
+                    for (std::string const &directory : iter->second) {
+                        o_changed.push_back(directory + ev->name);
+                    }
+                }
+            }
+            p += sizeof(struct inotify_event) + ev->len;
+        }
+    }
+    return lost;
+}
+
+GPUCC_API(void)
+gpuccFileWatcherWake
+(
+    struct GPUCC_FILE_WATCHER *watcher
+)
+{
+    uint64_t one = 1;
+    ssize_t   nb = write(watcher->WakeFd, &one, sizeof(one));
+    UNREFERENCED_PARAMETER(nb);
+}
@@ -0,0 +1,1380 @@
+/**
+ * @summary gpucc_worker_linux.cc: Implement worker process pools on Linux.
+ * Forking a multithreaded process is unsafe, since the child inherits locks
+ * held by threads that do not exist in it, so the pool starts its zygote by
+ * executing a host executable with posix_spawn. The zygote begins with a clean
+ * address space, stays single-threaded, and forks each worker. A compile waits
+ * for its worker for a bounded time, after which the worker is killed. The
+ * zygote hands the application a pidfd for each worker, so that the signal
+ * cannot reach an unrelated process that reused the worker's ID. Every
+ * worker is connected to the application by a sequenced-packet
+ * socket. Requests, include files and results are written to memfd objects,
+ * whose descriptors are passed over the socket; results are sealed against
+ * modification and mapped directly into the bytecode container.
+ */
+#include <dirent.h>
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_cancel.h"
+#include "gpucc_include.h"
+#include "gpucc_worker.h"
+
+/* @summary Define the interval, in milliseconds, at which a cancellable request waiting for a worker checks whether it has been cancelled.
+ */
+#ifndef GPUCC_WORKER_CANCEL_POLL_MS
+#define GPUCC_WORKER_CANCEL_POLL_MS                                            10
+#endif
+
+/* @summary Define the maximum number of bytes, including the nul, of a path sent with an include request.
+ */
+#ifndef GPUCC_WORKER_MAX_PATH
+#define GPUCC_WORKER_MAX_PATH                                                4096
+#endif
+
+/* @summary Define the number of compilers a worker process keeps, so that requests from a few compiler configurations do not recreate the backend each time.
+ */
+#ifndef GPUCC_WORKER_COMPILER_CACHE_SIZE
+#define GPUCC_WORKER_COMPILER_CACHE_SIZE                                        4
+#endif
+
+/* @summary Define the file name of the default worker host executable, which is installed in the same directory as the GpuCC library.
+ */
+#ifndef GPUCC_WORKER_HOST_NAME
+#define GPUCC_WORKER_HOST_NAME                                     "gpucc_worker"
+#endif
+
+/* @summary Define the command line argument that tells gpuccRunWorkerProcess that the process was started as the zygote of a worker process pool.
+ */
+#ifndef GPUCC_WORKER_HOST_ARGUMENT
+#define GPUCC_WORKER_HOST_ARGUMENT                          "--gpucc-worker-zygote"
+#endif
+
+/* @summary Define the descriptor number at which the zygote receives its end of the socket connected to the application.
+ */
+#ifndef GPUCC_WORKER_HOST_SOCKET
+#define GPUCC_WORKER_HOST_SOCKET                                                3
+#endif
+
+/* @summary Define the seals applied to every memfd object before its descriptor is sent. F_SEAL_SHRINK guarantees that a mapping of the object cannot fault.
+ */
+#ifndef GPUCC_WORKER_SEALS
+#define GPUCC_WORKER_SEALS                                                     \
+    (F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL)
+#endif
+
+/* @summary Define the types of message sent between the application, the zygote and the workers.
+ */
+typedef enum GPUCC_WORKER_MESSAGE_TYPE {
+    GPUCC_WORKER_MESSAGE_TYPE_SPAWN                      =  1,                 /* Application to zygote. Fork a new worker. */
+    GPUCC_WORKER_MESSAGE_TYPE_SPAWNED                    =  2,                 /* Zygote to application. Value is the process ID of the worker, or -1, and the descriptor is the worker's socket. */
+    GPUCC_WORKER_MESSAGE_TYPE_REQUEST                    =  3,                 /* Application to worker. Compile the configuration, source code, path and entry point in the attached memfd, whose sizes are Size[0..3]. */
+    GPUCC_WORKER_MESSAGE_TYPE_INCLUDE                    =  4,                 /* Worker to application. Resolve the include path and requesting path that follow the message, whose sizes are Size[0..1]. Value is the include type. */
+    GPUCC_WORKER_MESSAGE_TYPE_INCLUDE_REPLY              =  5,                 /* Application to worker. Value is non-zero if the include was resolved, in which case the attached memfd holds the resolved path and content, whose sizes are Size[0..1]. */
+    GPUCC_WORKER_MESSAGE_TYPE_RESULT                     =  6,                 /* Worker to application. Result is the compile result, and the attached memfd, if any, holds the bytecode and log, whose sizes are Size[0..1]. Value is non-zero if the worker has reached a recycling limit and exits after sending the message. */
+    GPUCC_WORKER_MESSAGE_TYPE_PROCESS                    =  7,                 /* Zygote to application, following a successful SPAWNED. The descriptor is a pidfd referring to the worker, or is absent if the kernel does not support pidfds. */
+} GPUCC_WORKER_MESSAGE_TYPE;
+
+/* @summary Define the possible outcomes of waiting for a message from a worker or the zygote.
+ */
+typedef enum GPUCC_WORKER_WAIT_RESULT {
+    GPUCC_WORKER_WAIT_RESULT_READABLE                    =  0,                 /* A message, or the end of the stream, can be read. */
+    GPUCC_WORKER_WAIT_RESULT_CANCELLED                   =  1,                 /* The compile was cancelled first. */
+    GPUCC_WORKER_WAIT_RESULT_TIMEOUT                     =  2,                 /* The reply timeout of the pool elapsed first. */
+} GPUCC_WORKER_WAIT_RESULT;
+
+/* @summary Define the fixed-size header of every message. Some messages are followed by a variable-length payload in the same packet.
+ */
+typedef struct GPUCC_WORKER_MESSAGE {
+    uint32_t                       Type;                                       /* One of the values of the GPUCC_WORKER_MESSAGE_TYPE enumeration. */
+    int32_t                        Value;                                      /* A value whose meaning depends on the message type. */
+    GPUCC_RESULT                   Result;                                     /* The compile result, for GPUCC_WORKER_MESSAGE_TYPE_RESULT. */
+    uint64_t                       Size[4];                                    /* Sizes of the data attached to the message, whose meaning depends on the message type. */
+} GPUCC_WORKER_MESSAGE;
+
+/* @summary Define the data associated with a single worker process, as seen from the application.
+ */
+typedef struct GPUCC_WORKER_PROCESS {
+    int                            Socket;                                     /* The application end of the socket connected to the worker, or -1 if the worker must be started. */
+    int                            ProcessHandle;                              /* A pidfd referring to the worker, or -1 if the kernel does not support pidfds. */
+    pid_t                          ProcessId;                                  /* The process ID of the worker. */
+} GPUCC_WORKER_PROCESS;
+
+/* @summary Define the data associated with a worker process pool on Linux.
+ * Each worker is used by one compile at a time. A worker that dies, or is killed because its compile was cancelled, is restarted when it is next acquired.
+ */
+typedef struct GPUCC_WORKER_PROCESS_POOL {
+    std::mutex                     Lock;                                       /* Protects the IdleList and IdleCount fields. */
+    std::condition_variable        IdleSignal;                                 /* Signaled when a worker is returned to the idle list. */
+    std::mutex                     ZygoteLock;                                 /* Serializes requests to the zygote, and protects the ZygoteSocket and ZygoteProcessId fields. */
+    GPUCC_WORKER_PROCESS          *Workers;                                    /* An array of WorkerCount worker process records. */
+    uint32_t                      *IdleList;                                   /* The indices of the idle workers. */
+    uint32_t                       IdleCount;                                  /* The number of items in IdleList. */
+    uint32_t                       WorkerCount;                                /* The number of worker processes. */
+    uint32_t                       ReplyTimeout;                               /* The time to wait for each message from a worker or the zygote, in milliseconds, or GPUCC_WAIT_INFINITE. */
+    char                          *HostPath;                                   /* The nul-terminated path of the executable started as the zygote. */
+    int                            ZygoteSocket;                               /* The application end of the socket connected to the zygote, or -1. */
+    pid_t                          ZygoteProcessId;                            /* The process ID of the zygote, which is a child of the application process. */
+} GPUCC_WORKER_PROCESS_POOL;
+
+/* @summary Define the data associated with a compiler kept by a worker process.
+ */
+typedef struct GPUCC_WORKER_COMPILER_SLOT {
+    struct GPUCC_PROGRAM_COMPILER *Compiler;                                   /* The compiler, or NULL if the slot is unused. */
+    GPUCC_HASH128                  ConfigHash;                                 /* The configuration hash sent by the application. */
+    uint32_t                       IncludeFlag;                                /* Non-zero if the compiler forwards include requests to the application. */
+} GPUCC_WORKER_COMPILER_SLOT;
+
+/* @summary Define the state of a worker process. Worker processes are single-threaded.
+ */
+typedef struct GPUCC_WORKER_CHILD {
+    int                            Socket;                                     /* The worker end of the socket connected to the application. */
+    uint32_t                       NextSlot;                                   /* The index of the slot replaced when no compiler matches a request. */
+    uint32_t                       CompileCount;                               /* The number of requests served by the worker. */
+    uint64_t                       BaselineBytes;                              /* The resident set size of the worker, in bytes, when it started. */
+    GPUCC_WORKER_COMPILER_SLOT     Compilers[GPUCC_WORKER_COMPILER_CACHE_SIZE];/* The compilers kept by the worker. */
+} GPUCC_WORKER_CHILD;
+
+/* @summary Open a pidfd referring to a process. The process must be a child of the caller that has not been waited for, so that its ID cannot have been reused.
+ * @param pid The process ID.
+ * @return The close-on-exec pidfd, or -1 if the kernel does not support pidfds.
+ */
+static int
+gpuccWorkerOpenProcessHandle
+(
+    pid_t pid
+)
+{
+#ifdef SYS_pidfd_open
+    return (int) syscall(SYS_pidfd_open, pid, 0);
+#else
+    (void) pid;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/* @summary Send SIGKILL to a process through a pidfd. The signal is not delivered if the process has already exited, even if its ID has been reused.
+ * @param handle The pidfd referring to the process.
+ */
+static void
+gpuccWorkerKillProcessHandle
+(
+    int handle
+)
+{
+#ifdef SYS_pidfd_send_signal
+    syscall(SYS_pidfd_send_signal, handle, SIGKILL, nullptr, 0);
+#else
+    (void) handle;
+#endif
+}
+
+/* @summary Send a message, with an optional payload and an optional file descriptor.
+ * @param sock The socket.
+ * @param msg The message header.
+ * @param payload The data following the header in the packet, or NULL.
+ * @param payload_size The number of bytes of payload.
+ * @param fd The file descriptor to pass, or -1.
+ * @return Non-zero if the message was sent, or zero if the peer has exited.
+ */
+static int32_t
+gpuccWorkerSend
+(
+    int                              sock,
+    GPUCC_WORKER_MESSAGE const       *msg,
+    void const                   *payload,
+    size_t                   payload_size,
+    int                                fd
+)
+{
+    union {
+        struct cmsghdr Header;
+        char           Buffer[CMSG_SPACE(sizeof(int))];
+    }                 control;
+    struct iovec       iov[2];
+    struct msghdr       mh;
+    ssize_t              n = 0;
+
+    memset(&mh, 0, sizeof(mh));
+    memset(&control, 0, sizeof(control));
+    iov[0].iov_base = (void*) msg;
+    iov[0].iov_len  = sizeof(GPUCC_WORKER_MESSAGE);
+    iov[1].iov_base = (void*) payload;
+    iov[1].iov_len  = payload_size;
+    mh.msg_iov      = iov;
+    mh.msg_iovlen   = (payload_size != 0) ? 2 : 1;
+    if (fd != -1) {
+        struct cmsghdr *cm = nullptr;
+        mh.msg_control     = control.Buffer;
+        mh.msg_controllen  = sizeof(control.Buffer);
+        cm                 = CMSG_FIRSTHDR(&mh);
+        cm->cmsg_level     = SOL_SOCKET;
+        cm->cmsg_type      = SCM_RIGHTS;
+        cm->cmsg_len       = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cm), &fd, sizeof(int));
+    }
+    do {
+        n = sendmsg(sock, &mh, MSG_NOSIGNAL);
+    } while (n == -1 && errno == EINTR);
+    return (n == (ssize_t)(sizeof(GPUCC_WORKER_MESSAGE) + payload_size)) ? 1 : 0;
+}
+
+/* @summary Receive a message, with an optional payload and an optional file descriptor.
+ * @param sock The socket.
+ * @param msg On return, the message header.
+ * @param payload The buffer that receives the payload, or NULL.
+ * @param payload_max The capacity of the payload buffer, in bytes.
+ * @param o_payload_size On return, the number of bytes of payload received. This value may be NULL.
+ * @param o_fd On return, the file descriptor passed with the message, or -1. The caller must close the descriptor.
+ * @return Non-zero if a message was received, or zero if the peer has exited or sent a malformed packet.
+ */
+static int32_t
+gpuccWorkerRecv
+(
+    int                              sock,
+    GPUCC_WORKER_MESSAGE             *msg,
+    void                         *payload,
+    size_t                    payload_max,
+    size_t                *o_payload_size,
+    int                             *o_fd
+)
+{
+    union {
+        struct cmsghdr Header;
+        char           Buffer[CMSG_SPACE(sizeof(int))];
+    }                 control;
+    struct iovec       iov[2];
+    struct msghdr       mh;
+    struct cmsghdr     *cm = nullptr;
+    ssize_t              n = 0;
+
+   *o_fd = -1;
+    memset(&mh, 0, sizeof(mh));
+    iov[0].iov_base   = (void*) msg;
+    iov[0].iov_len    = sizeof(GPUCC_WORKER_MESSAGE);
+    iov[1].iov_base   = payload;
+    iov[1].iov_len    = payload_max;
+    mh.msg_iov        = iov;
+    mh.msg_iovlen     = (payload_max != 0) ? 2 : 1;
+    mh.msg_control    = control.Buffer;
+    mh.msg_controllen = sizeof(control.Buffer);
+    do {
+        n = recvmsg(sock, &mh, MSG_CMSG_CLOEXEC);
+    } while (n == -1 && errno == EINTR);
+    if (n <= 0) {
+        return 0;
+    }
+    for (cm = CMSG_FIRSTHDR(&mh); cm != nullptr; cm = CMSG_NXTHDR(&mh, cm)) {
+        if (cm->cmsg_level == SOL_SOCKET && cm->cmsg_type == SCM_RIGHTS && cm->cmsg_len == CMSG_LEN(sizeof(int))) {
+            memcpy(o_fd, CMSG_DATA(cm), sizeof(int));
+        }
+    }
+    if ((size_t) n < sizeof(GPUCC_WORKER_MESSAGE) || (mh.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) != 0) {
+        if (*o_fd != -1) {
+            close(*o_fd);
+           *o_fd = -1;
+        }
+        return 0;
+    }
+    if (o_payload_size != nullptr) {
+       *o_payload_size = (size_t) n - sizeof(GPUCC_WORKER_MESSAGE);
+    }
+    return 1;
+}
+
+/* @summary Create a sealed memfd object holding the concatenation of one or more buffers.
+ * @param name A nul-terminated string used to identify the object in /proc.
+ * @param iov The buffers to write.
+ * @param count The number of items in the iov array.
+ * @return The file descriptor of the memfd object, or -1.
+ */
+static int
+gpuccWorkerCreateSharedMemory
+(
+    char const       *name,
+    struct iovec const *iov,
+    int               count
+)
+{
+    int fd = -1;
+
+    if ((fd = memfd_create(name, MFD_CLOEXEC | MFD_ALLOW_SEALING)) == -1) {
+        return -1;
+    }
+    for (int i = 0; i < count; ++i) {
+        uint8_t const *ptr = (uint8_t const*) iov[i].iov_base;
+        size_t          nb = iov[i].iov_len;
+        while (nb > 0) {
+            ssize_t n = write(fd, ptr, nb);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                close(fd);
+                return -1;
+            }
+            ptr += n;
+            nb  -= (size_t) n;
+        }
+    }
+    if (fcntl(fd, F_ADD_SEALS, GPUCC_WORKER_SEALS) == -1) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* @summary Map a memfd object received from another process for reading.
+ * The object must be sealed against shrinking, so that a process that dies or misbehaves cannot cause accesses to the mapping to fault.
+ * @param fd The file descriptor of the memfd object. The caller retains ownership of the descriptor.
+ * @param size The number of bytes expected. This value must be non-zero.
+ * @return The address of the mapping, or NULL if the object is too small, not sealed, or could not be mapped.
+ */
+static void*
+gpuccWorkerMapSharedMemory
+(
+    int       fd,
+    uint64_t size
+)
+{
+    struct stat st;
+    void     *base = nullptr;
+    int       seals = 0;
+
+    if (size == 0 || size > (uint64_t) SIZE_MAX) {
+        return nullptr;
+    }
+    if ((seals = fcntl(fd, F_GET_SEALS)) == -1 || (seals & F_SEAL_SHRINK) == 0) {
+        return nullptr;
+    }
+    if (fstat(fd, &st) == -1 || (uint64_t) st.st_size < size) {
+        return nullptr;
+    }
+    if ((base = mmap(nullptr, (size_t) size, PROT_READ, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+        return nullptr;
+    }
+    return base;
+}
+
+/* @summary Close every file descriptor inherited from the application other than the standard streams and one socket.
+ * Descriptors created by GpuCC are close-on-exec, but the application may have others, such as the sockets of its own child processes.
+ * This function runs in the zygote after it has been executed, so it may allocate memory.
+ * @param keep The descriptor to keep open.
+ */
+static void
+gpuccWorkerCloseInheritedFiles
+(
+    int keep
+)
+{
+    DIR           *dir = nullptr;
+    struct dirent *ent = nullptr;
+
+    if ((dir = opendir("/proc/self/fd")) == nullptr) {
+        return;
+    }
+    while ((ent = readdir(dir)) != nullptr) {
+        int fd = atoi(ent->d_name);
+        if (ent->d_name[0] >= '0' && ent->d_name[0] <= '9' && fd > STDERR_FILENO && fd != keep && fd != dirfd(dir)) {
+            close(fd);
+        }
+    }
+    closedir(dir);
+}
+
+/* @summary Implement PFN_GpuCC_ResolveInclude in a worker process by forwarding the request to the application, which resolves it with the compiler's include handler.
+ */
+static int32_t
+gpuccWorkerResolveInclude
+(
+    void                         *user_data,
+    char const                *include_path,
+    char const             *requesting_path,
+    int32_t                    include_type,
+    struct GPUCC_INCLUDE_RESULT   *o_result
+)
+{
+    GPUCC_WORKER_CHILD *child =(GPUCC_WORKER_CHILD*) user_data;
+    char                payload[2 * GPUCC_WORKER_MAX_PATH];
+    GPUCC_WORKER_MESSAGE    msg;
+    size_t              nbinc = strlen(include_path) + 1;
+    size_t              nbreq = (requesting_path != nullptr) ? strlen(requesting_path) + 1 : 0;
+    char               *base = nullptr;
+    int                    fd = -1;
+
+    if (nbinc > GPUCC_WORKER_MAX_PATH || nbreq > GPUCC_WORKER_MAX_PATH) {
+        return 0;
+    }
+    memcpy(payload, include_path, nbinc);
+    memcpy(payload + nbinc, requesting_path, nbreq);
+    memset(&msg, 0, sizeof(msg));
+    msg.Type    = GPUCC_WORKER_MESSAGE_TYPE_INCLUDE;
+    msg.Value   = include_type;
+    msg.Size[0] = nbinc;
+    msg.Size[1] = nbreq;
+    if (gpuccWorkerSend(child->Socket, &msg, payload, nbinc + nbreq, -1) == 0) {
+        return 0;
+    }
+    if (gpuccWorkerRecv(child->Socket, &msg, nullptr, 0, nullptr, &fd) == 0) {
+        return 0;
+    }
+    if (msg.Type != GPUCC_WORKER_MESSAGE_TYPE_INCLUDE_REPLY || msg.Value == 0 || fd == -1 || msg.Size[0] == 0 || msg.Size[0] > GPUCC_WORKER_MAX_PATH || msg.Size[1] > UINT32_MAX) {
+        if (fd != -1) {
+            close(fd);
+        }
+        return 0;
+    }
+    /* The content is followed by a nul, which some backends require. */
+    base = (char*) gpuccWorkerMapSharedMemory(fd, msg.Size[0] + msg.Size[1] + 1);
+    close(fd);
+    if (base == nullptr || base[msg.Size[0] - 1] != 0) {
+        if (base != nullptr) {
+            munmap(base, (size_t)(msg.Size[0] + msg.Size[1] + 1));
+        }
+        return 0;
+    }
+    o_result->ResolvedPath = base;
+    o_result->Content      = base + msg.Size[0];
+    o_result->ContentSize  = msg.Size[1];
+    o_result->Context      = base;
+    return 1;
+}
+
+/* @summary Implement PFN_GpuCC_ReleaseInclude in a worker process.
+ */
+static void
+gpuccWorkerReleaseInclude
+(
+    void                     *user_data,
+    struct GPUCC_INCLUDE_RESULT *result
+)
+{
+    UNREFERENCED_PARAMETER(user_data);
+    munmap(result->Context, (size_t)((char const*) result->Content - (char const*) result->Context) + (size_t) result->ContentSize + 1);
+}
+
+/* @summary Retrieve a compiler matching a serialized configuration, creating it if the worker does not already have one.
+ * @param child The worker state.
+ * @param config The serialized configuration.
+ * @param config_size The number of bytes of serialized configuration data.
+ * @return The compiler, or NULL if it could not be created.
+ */
+static struct GPUCC_PROGRAM_COMPILER*
+gpuccWorkerChildCompiler
+(
+    GPUCC_WORKER_CHILD          *child,
+    GPUCC_WORKER_CONFIG const  *config,
+    uint64_t               config_size
+)
+{
+    GPUCC_WORKER_COMPILER_SLOT *slot = nullptr;
+    GPUCC_PROGRAM_COMPILER_INIT init;
+    GPUCC_INCLUDE_HANDLER    handler;
+
+    if (config_size < sizeof(GPUCC_WORKER_CONFIG)) {
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < GPUCC_WORKER_COMPILER_CACHE_SIZE; ++i) {
+        slot = &child->Compilers[i];
+        if (slot->Compiler != nullptr && slot->IncludeFlag == config->IncludeFlag && slot->ConfigHash.Low == config->ConfigHash.Low && slot->ConfigHash.High == config->ConfigHash.High) {
+            return slot->Compiler;
+        }
+    }
+    if (gpuccParseWorkerConfig(config, config_size, &init) == 0) {
+        return nullptr;
+    }
+    handler.Resolve  = gpuccWorkerResolveInclude;
+    handler.Release  = gpuccWorkerReleaseInclude;
+    handler.UserData = child;
+    init.IncludeHandler = (config->IncludeFlag != 0) ? &handler : nullptr;
+    slot = &child->Compilers[child->NextSlot];
+    child->NextSlot = (child->NextSlot + 1) % GPUCC_WORKER_COMPILER_CACHE_SIZE;
+    if (slot->Compiler != nullptr) {
+        gpuccDeleteCompiler(slot->Compiler);
+    }
+    slot->Compiler    = gpuccCreateWorkerCompiler(&init);
+    slot->ConfigHash  = config->ConfigHash;
+    slot->IncludeFlag = config->IncludeFlag;
+    free((void*) init.DefineSymbols);
+    return slot->Compiler;
+}
+
+/* @summary Retrieve the resident set size of the calling process.
+ * @return The number of bytes of resident memory, or zero if the value could not be read.
+ */
+static uint64_t
+gpuccWorkerResidentBytes
+(
+    void
+)
+{
+    FILE             *fp = nullptr;
+    unsigned long  pages = 0;
+    unsigned long    res = 0;
+    long        pagesize = sysconf(_SC_PAGESIZE);
+
+    if ((fp = fopen("/proc/self/statm", "r")) == nullptr) {
+        return 0;
+    }
+    if (fscanf(fp, "%lu %lu", &pages, &res) != 2 || pagesize <= 0) {
+        res = 0;
+    }
+    fclose(fp);
+    return (uint64_t) res * (uint64_t) pagesize;
+}
+
+/* @summary Determine whether a worker process has reached the recycling limits of the compiler whose request it just served.
+ * @param child The worker state.
+ * @param config The serialized configuration of the compiler.
+ * @return Non-zero if the worker should exit, so that the application replaces it with a fresh process.
+ */
+static int32_t
+gpuccWorkerShouldRetire
+(
+    GPUCC_WORKER_CHILD          *child,
+    GPUCC_WORKER_CONFIG const  *config
+)
+{
+    uint64_t rss = 0;
+
+    if (config->RecycleCompileCount != 0 && child->CompileCount >= config->RecycleCompileCount) {
+        return 1;
+    }
+    if (config->RecycleMemoryBytes != 0) {
+        rss = gpuccWorkerResidentBytes();
+        if (rss > child->BaselineBytes && rss - child->BaselineBytes >= config->RecycleMemoryBytes) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* @summary Compile a single request in a worker process and send the result to the application.
+ * The compile bypasses the bytecode cache and compile deduplication, which the application has already consulted.
+ * @param child The worker state.
+ * @param req The request message.
+ * @param fd The memfd object holding the request data.
+ * @return Non-zero if the worker has reached a recycling limit and must exit.
+ */
+static int32_t
+gpuccWorkerServeRequest
+(
+    GPUCC_WORKER_CHILD         *child,
+    GPUCC_WORKER_MESSAGE const   *req,
+    int                           fd
+)
+{
+    GPUCC_PROGRAM_BYTECODE   *container = nullptr;
+    struct GPUCC_PROGRAM_COMPILER *compiler = nullptr;
+    uint8_t                      *base = nullptr;
+    char const            *source_path = nullptr;
+    char const            *entry_point = nullptr;
+    uint64_t                     total = req->Size[0] + req->Size[1] + req->Size[2] + req->Size[3];
+    int                          outfd = -1;
+    GPUCC_WORKER_MESSAGE         reply;
+    GPUCC_RESULT                result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+
+    memset(&reply, 0, sizeof(reply));
+    reply.Type = GPUCC_WORKER_MESSAGE_TYPE_RESULT;
+    if (req->Size[0] <= total && req->Size[1] <= total && (base = (uint8_t*) gpuccWorkerMapSharedMemory(fd, total)) != nullptr) {
+        source_path = (req->Size[2] != 0) ? (char const*)(base + req->Size[0] + req->Size[1]) : nullptr;
+        entry_point = (req->Size[3] != 0) ? (char const*)(base + req->Size[0] + req->Size[1] + req->Size[2]) : nullptr;
+        if ((req->Size[2] == 0 || source_path[req->Size[2] - 1] == 0) && (req->Size[3] == 0 || entry_point[req->Size[3] - 1] == 0)) {
+            gpuccSetLastResult(result);
+            compiler = gpuccWorkerChildCompiler(child, (GPUCC_WORKER_CONFIG const*) base, req->Size[0]);
+        }
+    }
+    if (compiler == nullptr || (container = gpuccCreateBytecodeContainer(compiler)) == nullptr) {
+        result = gpuccGetLastResult();
+    } else {
+        GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+        GPUCC_PROGRAM_COMPILER_BASE  *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+        if (gpuccSuccess((result = gpuccSetProgramEntryPoint(container, entry_point, source_path)))) {
+            result = compiler_->CompileBytecode(container, (char const*)(base + req->Size[0]), req->Size[1], container_->SourcePath, container_->EntryPoint);
+        }
+        container_->CompileResult = result;
+        child->CompileCount++;
+        reply.Value   = gpuccWorkerShouldRetire(child, (GPUCC_WORKER_CONFIG const*) base);
+        reply.Size[0] = (container_->BytecodeBuffer != nullptr) ? container_->BytecodeSize  : 0;
+        reply.Size[1] = (container_->LogBuffer      != nullptr) ? container_->LogBufferSize : 0;
+        if (reply.Size[0] + reply.Size[1] != 0) {
+            struct iovec iov[2];
+            iov[0].iov_base = container_->BytecodeBuffer;
+            iov[0].iov_len  = (size_t) reply.Size[0];
+            iov[1].iov_base = container_->LogBuffer;
+            iov[1].iov_len  = (size_t) reply.Size[1];
+            if ((outfd = gpuccWorkerCreateSharedMemory("gpucc-result", iov, 2)) == -1) {
+                result = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+                reply.Size[0] = 0;
+                reply.Size[1] = 0;
+            }
+        }
+    }
+    reply.Result = result;
+    gpuccWorkerSend(child->Socket, &reply, nullptr, 0, outfd);
+    if (outfd != -1) {
+        close(outfd);
+    }
+    if (container != nullptr) {
+        gpuccDeleteBytecodeContainer(container);
+    }
+    if (base != nullptr) {
+        munmap(base, (size_t) total);
+    }
+    return reply.Value;
+}
+
+/* @summary Implement the main loop of a worker process, which serves requests until the application closes its end of the socket.
+ * @param sock The worker end of the socket connected to the application.
+ */
+static void
+gpuccWorkerProcessMain
+(
+    int sock
+)
+{
+    GPUCC_WORKER_CHILD  *child = new (std::nothrow) GPUCC_WORKER_CHILD();
+    GPUCC_WORKER_MESSAGE   msg;
+    int                     fd = -1;
+
+    if (child == nullptr) {
+        _exit(1);
+    }
+    signal(SIGCHLD, SIG_DFL);
+    child->Socket        = sock;
+    child->BaselineBytes = gpuccWorkerResidentBytes();
+    while (gpuccWorkerRecv(sock, &msg, nullptr, 0, nullptr, &fd)) {
+        int32_t retire = 0;
+        if (msg.Type == GPUCC_WORKER_MESSAGE_TYPE_REQUEST && fd != -1) {
+            retire = gpuccWorkerServeRequest(child, &msg, fd);
+        }
+        if (fd != -1) {
+            close(fd);
+        }
+        if (retire) {
+            break;
+        }
+    }
+    _exit(0);
+}
+
+/* @summary Implement the main loop of the zygote process, which forks a worker each time the application asks for one, until the application closes its end of the socket.
+ * @param sock The zygote end of the socket connected to the application.
+ */
+static void
+gpuccWorkerZygoteMain
+(
+    int sock
+)
+{
+    GPUCC_WORKER_MESSAGE msg;
+    int                   fd = -1;
+
+    /* Workers are reaped explicitly rather than by ignoring SIGCHLD, so that
+     * the ID of a worker cannot be reused before its pidfd has been opened. */
+    signal(SIGCHLD, SIG_DFL);
+    while (gpuccWorkerRecv(sock, &msg, nullptr, 0, nullptr, &fd)) {
+        GPUCC_WORKER_MESSAGE reply;
+        int                 pair[2];
+        pid_t                   pid = -1;
+
+        if (fd != -1) {
+            close(fd);
+        }
+        if (msg.Type != GPUCC_WORKER_MESSAGE_TYPE_SPAWN) {
+            continue;
+        }
+        /* Workers that exited since the last request are waiting to be reaped. */
+        while (waitpid(-1, nullptr, WNOHANG) > 0) {
+            /* empty */
+        }
+        memset(&reply, 0, sizeof(reply));
+        reply.Type  = GPUCC_WORKER_MESSAGE_TYPE_SPAWNED;
+        reply.Value = -1;
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, pair) == -1) {
+            gpuccWorkerSend(sock, &reply, nullptr, 0, -1);
+            continue;
+        }
+        if ((pid = fork()) == 0) {
+            close(sock);
+            close(pair[0]);
+            gpuccWorkerProcessMain(pair[1]);
+        }
+        close(pair[1]);
+        if (pid > 0) {
+            int handle = gpuccWorkerOpenProcessHandle(pid);
+            reply.Value = (int32_t) pid;
+            gpuccWorkerSend(sock, &reply, nullptr, 0, pair[0]);
+            memset(&reply, 0, sizeof(reply));
+            reply.Type = GPUCC_WORKER_MESSAGE_TYPE_PROCESS;
+            gpuccWorkerSend(sock, &reply, nullptr, 0, handle);
+            if (handle != -1) {
+                close(handle);
+            }
+        } else {
+            gpuccWorkerSend(sock, &reply, nullptr, 0, -1);
+        }
+        close(pair[0]);
+    }
+    /* Wait for the workers to see their sockets close, so that the pool is gone when gpuccDeleteWorkerProcessPool returns. */
+    while (wait(nullptr) != -1 || errno == EINTR) {
+        /* empty */
+    }
+    _exit(0);
+}
+
+/* @summary Wait until a worker or zygote socket has a message to read.
+ * @param sock The socket.
+ * @param cancel The cancellation state of the compile, or NULL.
+ * @param timeout_ms The maximum time to wait, in milliseconds, or GPUCC_WAIT_INFINITE.
+ * @return One of the values of the GPUCC_WORKER_WAIT_RESULT enumeration.
+ */
+static int32_t
+gpuccWorkerWaitReadable
+(
+    int                       sock,
+    GPUCC_CANCEL_STATE const *cancel,
+    uint32_t              timeout_ms
+)
+{
+    uint64_t   deadline = UINT64_MAX;
+    struct pollfd   pfd;
+
+    if (timeout_ms != GPUCC_WAIT_INFINITE) {
+        deadline = gpuccQueryClockNanoseconds() + (uint64_t) timeout_ms * 1000000ULL;
+    }
+    for ( ; ; ) {
+        int wait_ms = (cancel != nullptr) ? GPUCC_WORKER_CANCEL_POLL_MS : -1;
+        if (deadline != UINT64_MAX) {
+            uint64_t now = gpuccQueryClockNanoseconds();
+            uint64_t rem = 0;
+            if (now >= deadline) {
+                return GPUCC_WORKER_WAIT_RESULT_TIMEOUT;
+            }
+            rem = (deadline - now + 999999) / 1000000;
+            if (wait_ms == -1 || rem < (uint64_t) wait_ms) {
+                wait_ms = (rem < INT_MAX) ? (int) rem : INT_MAX;
+            }
+        }
+        pfd.fd      = sock;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, wait_ms) > 0) {
+            return GPUCC_WORKER_WAIT_RESULT_READABLE;
+        }
+        if (gpuccCancelRequested(cancel)) {
+            return GPUCC_WORKER_WAIT_RESULT_CANCELLED;
+        }
+    }
+}
+
+/* @summary Start the zygote process of a worker process pool by executing the host executable. The caller must hold the ZygoteLock, and there must be no running zygote.
+ * posix_spawn runs no application code between fork and exec, so this function may be called from any thread, at any time.
+ * @param pool The worker process pool.
+ * @return Non-zero if the zygote was started.
+ */
+static int32_t
+gpuccWorkerStartZygote
+(
+    GPUCC_WORKER_PROCESS_POOL *pool
+)
+{
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t             attr;
+    sigset_t                   sigmask;
+    sigset_t                    sigdef;
+    char                       arg0[] = GPUCC_WORKER_HOST_NAME;
+    char                       arg1[] = GPUCC_WORKER_HOST_ARGUMENT;
+    char                      *argv[] = { arg0, arg1, nullptr };
+    int                        pair[2];
+    int                           src = -1;
+    int                           err = 0;
+    pid_t                         pid = -1;
+
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, pair) == -1) {
+        gpuccDebugPrintf("GpuCC: socketpair failed with errno %d.\n", errno);
+        return 0;
+    }
+    /* dup2 onto itself would leave the close-on-exec flag set, so move the descriptor out of the way first. */
+    src = pair[1];
+    if (src == GPUCC_WORKER_HOST_SOCKET && (src = fcntl(pair[1], F_DUPFD_CLOEXEC, GPUCC_WORKER_HOST_SOCKET + 1)) == -1) {
+        gpuccDebugPrintf("GpuCC: fcntl failed with errno %d.\n", errno);
+        close(pair[0]);
+        close(pair[1]);
+        return 0;
+    }
+    /* The zygote starts with default signal dispositions and nothing blocked, whatever the calling thread has set. */
+    sigemptyset(&sigmask);
+    sigfillset(&sigdef);
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, src, GPUCC_WORKER_HOST_SOCKET);
+    posix_spawnattr_init(&attr);
+    posix_spawnattr_setsigmask(&attr, &sigmask);
+    posix_spawnattr_setsigdefault(&attr, &sigdef);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+    err = posix_spawn(&pid, pool->HostPath, &actions, &attr, argv, environ);
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    if (src != pair[1]) {
+        close(src);
+    }
+    close(pair[1]);
+    if (err != 0) {
+        gpuccDebugPrintf("GpuCC: Unable to start worker host %s (errno %d).\n", pool->HostPath, err);
+        close(pair[0]);
+        errno = err;
+        return 0;
+    }
+    pool->ZygoteSocket    = pair[0];
+    pool->ZygoteProcessId = pid;
+    return 1;
+}
+
+/* @summary Stop the zygote process of a worker process pool, if it is running. The caller must hold the ZygoteLock.
+ * Workers already started are unaffected.
+ * @param pool The worker process pool.
+ * @param kill_flag Set to true to kill the zygote rather than waiting for it to see the socket close.
+ */
+static void
+gpuccWorkerStopZygote
+(
+    GPUCC_WORKER_PROCESS_POOL *pool,
+    bool                  kill_flag
+)
+{
+    if (pool->ZygoteSocket != -1) {
+        if (kill_flag) {
+            kill(pool->ZygoteProcessId, SIGKILL);
+        }
+        close(pool->ZygoteSocket);
+        while (waitpid(pool->ZygoteProcessId, nullptr, 0) == -1 && errno == EINTR) {
+            /* empty */
+        }
+        pool->ZygoteSocket    = -1;
+        pool->ZygoteProcessId = 0;
+    }
+}
+
+/* @summary Stop a worker process. The worker is restarted when it is next acquired.
+ * @param worker The worker record.
+ * @param kill_flag Set to true to kill a worker that is known to be running a compile, after a timeout or cancellation, rather than letting it exit when it sees the socket close.
+ * Without a pidfd the signal is sent to the process ID, which is only safe while the worker is known to be alive; the zygote reaps a worker that has exited, after which its ID may be reused.
+ */
+static void
+gpuccWorkerTerminate
+(
+    GPUCC_WORKER_PROCESS *worker,
+    bool               kill_flag
+)
+{
+    if (worker->Socket != -1) {
+        if (kill_flag) {
+            if (worker->ProcessHandle != -1) {
+                gpuccWorkerKillProcessHandle(worker->ProcessHandle);
+            } else {
+                kill(worker->ProcessId, SIGKILL);
+            }
+        }
+        if (worker->ProcessHandle != -1) {
+            close(worker->ProcessHandle);
+        }
+        close(worker->Socket);
+        worker->Socket        = -1;
+        worker->ProcessHandle = -1;
+        worker->ProcessId     = 0;
+    }
+}
+
+/* @summary Start a worker process. If the zygote exits or does not respond within the reply timeout, it is restarted once.
+ * @param pool The worker process pool.
+ * @param worker The worker record, whose Socket field must be -1.
+ * @return Non-zero if the worker was started.
+ */
+static int32_t
+gpuccWorkerSpawn
+(
+    GPUCC_WORKER_PROCESS_POOL *pool,
+    GPUCC_WORKER_PROCESS    *worker
+)
+{
+    std::lock_guard<std::mutex> lock(pool->ZygoteLock);
+    GPUCC_WORKER_MESSAGE         msg;
+    int                           fd = -1;
+    int                       handle = -1;
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (pool->ZygoteSocket == -1 && gpuccWorkerStartZygote(pool) == 0) {
+            return 0;
+        }
+        memset(&msg, 0, sizeof(msg));
+        msg.Type = GPUCC_WORKER_MESSAGE_TYPE_SPAWN;
+        if (gpuccWorkerSend(pool->ZygoteSocket, &msg, nullptr, 0, -1) &&
+            gpuccWorkerWaitReadable(pool->ZygoteSocket, nullptr, pool->ReplyTimeout) == GPUCC_WORKER_WAIT_RESULT_READABLE &&
+            gpuccWorkerRecv(pool->ZygoteSocket, &msg, nullptr, 0, nullptr, &fd)) {
+            if (msg.Type != GPUCC_WORKER_MESSAGE_TYPE_SPAWNED || msg.Value <= 0 || fd == -1) {
+                /* The zygote is alive, but could not fork. */
+                if (fd != -1) {
+                    close(fd);
+                }
+                return 0;
+            }
+            worker->Socket    = fd;
+            worker->ProcessId =(pid_t) msg.Value;
+            if (gpuccWorkerWaitReadable(pool->ZygoteSocket, nullptr, pool->ReplyTimeout) == GPUCC_WORKER_WAIT_RESULT_READABLE &&
+                gpuccWorkerRecv(pool->ZygoteSocket, &msg, nullptr, 0, nullptr, &handle) && msg.Type == GPUCC_WORKER_MESSAGE_TYPE_PROCESS) {
+                worker->ProcessHandle = handle;
+                return 1;
+            }
+            /* The new worker exits when it sees its socket close. */
+            if (handle != -1) {
+                close(handle);
+            }
+            gpuccWorkerTerminate(worker, false);
+        }
+        gpuccDebugPrintf("GpuCC: The worker process pool zygote exited or stopped responding. Restarting it.\n");
+        gpuccWorkerStopZygote(pool, true);
+    }
+    return 0;
+}
+
+/* @summary Wait for a worker to become idle and remove it from the idle list.
+ * @param pool The worker process pool.
+ * @param cancel The cancellation state of the compile, or NULL.
+ * @return The index of the worker, or UINT32_MAX if the compile was cancelled while waiting.
+ */
+static uint32_t
+gpuccWorkerAcquire
+(
+    GPUCC_WORKER_PROCESS_POOL *pool,
+    GPUCC_CANCEL_STATE const *cancel
+)
+{
+    std::unique_lock<std::mutex> lock(pool->Lock);
+
+    while (pool->IdleCount == 0) {
+        if (cancel == nullptr) {
+            pool->IdleSignal.wait(lock);
+        } else if (gpuccCancelRequested(cancel)) {
+            return UINT32_MAX;
+        } else {
+            pool->IdleSignal.wait_for(lock, std::chrono::milliseconds(GPUCC_WORKER_CANCEL_POLL_MS));
+        }
+    }
+    return pool->IdleList[--pool->IdleCount];
+}
+
+/* @summary Return a worker to the idle list.
+ * @param pool The worker process pool.
+ * @param index The index of the worker returned by gpuccWorkerAcquire.
+ */
+static void
+gpuccWorkerRelease
+(
+    GPUCC_WORKER_PROCESS_POOL *pool,
+    uint32_t                  index
+)
+{
+    std::lock_guard<std::mutex> lock(pool->Lock);
+    pool->IdleList[pool->IdleCount++] = index;
+    pool->IdleSignal.notify_one();
+}
+
+/* @summary Resolve an include request sent by a worker and send the reply.
+ * @param sock The application end of the worker socket.
+ * @param container The bytecode container being compiled, whose compiler holds the include handler.
+ * @param msg The include request.
+ * @param payload The include path and requesting path following the request.
+ * @param payload_size The number of bytes of payload.
+ * @return Non-zero if the reply was sent, or zero if the request was malformed or the worker has exited.
+ */
+static int32_t
+gpuccWorkerServeInclude
+(
+    int                              sock,
+    GPUCC_PROGRAM_BYTECODE     *container,
+    GPUCC_WORKER_MESSAGE const       *msg,
+    char const                   *payload,
+    size_t                   payload_size
+)
+{
+    GPUCC_WORKER_MESSAGE reply;
+    GPUCC_INCLUDE_RESULT result;
+    char const  *requesting_path = nullptr;
+    int                       fd = -1;
+    int32_t                   ok = 0;
+
+    if (msg->Size[0] == 0 || msg->Size[0] + msg->Size[1] != payload_size || payload[msg->Size[0] - 1] != 0 || (msg->Size[1] != 0 && payload[payload_size - 1] != 0)) {
+        return 0;
+    }
+    requesting_path = (msg->Size[1] != 0) ? payload + msg->Size[0] : nullptr;
+    memset(&reply, 0, sizeof(reply));
+    reply.Type = GPUCC_WORKER_MESSAGE_TYPE_INCLUDE_REPLY;
+    if (gpuccOpenInclude(container, payload, requesting_path, msg->Value, &result)) {
+        struct iovec iov[3];
+        char          nul = 0;
+        iov[0].iov_base = (void*) result.ResolvedPath;
+        iov[0].iov_len  = strlen(result.ResolvedPath) + 1;
+        iov[1].iov_base = (void*) result.Content;
+        iov[1].iov_len  = (size_t) result.ContentSize;
+        iov[2].iov_base = &nul;
+        iov[2].iov_len  = 1;
+        if (iov[0].iov_len <= GPUCC_WORKER_MAX_PATH && (fd = gpuccWorkerCreateSharedMemory("gpucc-include", iov, 3)) != -1) {
+            reply.Value   = 1;
+            reply.Size[0] = iov[0].iov_len;
+            reply.Size[1] = iov[1].iov_len;
+        }
+        gpuccCloseInclude(container, &result);
+    }
+    ok = gpuccWorkerSend(sock, &reply, nullptr, 0, fd);
+    if (fd != -1) {
+        close(fd);
+    }
+    return ok;
+}
+
+/* @summary Store a log message in a bytecode container for a compile whose worker process failed.
+ * The message is held in an anonymous mapping, so that it is released like a result returned by a worker.
+ * @param container The bytecode container.
+ * @param message A nul-terminated UTF-8 string specifying the message.
+ */
+static void
+gpuccWorkerSetFailureLog
+(
+    GPUCC_PROGRAM_BYTECODE *container,
+    char const               *message
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    size_t                               nb = strlen(message) + 1;
+    void                              *base = nullptr;
+
+    if ((base = mmap(nullptr, nb, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED) {
+        return;
+    }
+    memcpy(base, message, nb);
+    container_->WorkerResult     = base;
+    container_->WorkerResultSize = nb;
+    container_->LogBuffer        =(char*) base;
+    container_->LogBufferSize    = nb;
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccWorkerPoolCompile
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_PROGRAM_COMPILER_BASE  *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) container_->Compiler;
+    GPUCC_WORKER_PROCESS_POOL         *pool = compiler_->WorkerPool;
+    GPUCC_WORKER_CONFIG             *config = compiler_->WorkerConfig;
+    GPUCC_CANCEL_STATE const        *cancel = container_->CancelState;
+    GPUCC_WORKER_PROCESS            *worker = nullptr;
+    char const                        *path = (container_->SourcePath != nullptr) ? container_->SourcePath : "<unnamed>";
+    uint32_t                          index = 0;
+    int                                  fd = -1;
+    bool                               dead = false;
+    bool                             retire = false;
+    bool                            timeout = false;
+    char                            payload[2 * GPUCC_WORKER_MAX_PATH];
+    char                            message[GPUCC_WORKER_MAX_PATH + 128];
+    GPUCC_WORKER_MESSAGE                msg;
+    GPUCC_RESULT                     result = gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
+    struct iovec                     iov[4];
+
+    if ((index = gpuccWorkerAcquire(pool, cancel)) == UINT32_MAX) {
+        return gpuccMakeResult(GPUCC_RESULT_CODE_CANCELLED);
+    }
+    worker = &pool->Workers[index];
+    if (worker->Socket == -1 && gpuccWorkerSpawn(pool, worker) == 0) {
+        gpuccWorkerRelease(pool, index);
+        snprintf(message, sizeof(message), "GpuCC: Unable to start a worker process to compile %s.\n", path);
+        gpuccWorkerSetFailureLog(container, message);
+        return gpuccMakeResult(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+    }
+
+    /* Send the request. The source code is copied once, into the memfd object. */
+    iov[0].iov_base = config;
+    iov[0].iov_len  = (size_t) config->TotalSize;
+    iov[1].iov_base = (void*) source_code;
+    iov[1].iov_len  = (size_t) source_size;
+    iov[2].iov_base = container_->SourcePath;
+    iov[2].iov_len  = (container_->SourcePath != nullptr) ? strlen(container_->SourcePath) + 1 : 0;
+    iov[3].iov_base = container_->EntryPoint;
+    iov[3].iov_len  = (container_->EntryPoint != nullptr) ? strlen(container_->EntryPoint) + 1 : 0;
+    if ((fd = gpuccWorkerCreateSharedMemory("gpucc-request", iov, 4)) == -1) {
+        result = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+        gpuccWorkerRelease(pool, index);
+        return result;
+    }
+    memset(&msg, 0, sizeof(msg));
+    msg.Type = GPUCC_WORKER_MESSAGE_TYPE_REQUEST;
+    for (int i = 0; i < 4; ++i) {
+        msg.Size[i] = iov[i].iov_len;
+    }
+    dead = (gpuccWorkerSend(worker->Socket, &msg, nullptr, 0, fd) == 0);
+    close(fd);
+
+    /* Serve include requests until the worker returns the result, exits, stops responding, or the compile is cancelled. */
+    while (!dead) {
+        size_t payload_size = 0;
+        int32_t        wait = gpuccWorkerWaitReadable(worker->Socket, cancel, pool->ReplyTimeout);
+        if (wait == GPUCC_WORKER_WAIT_RESULT_CANCELLED) {
+            result = gpuccMakeResult(GPUCC_RESULT_CODE_CANCELLED);
+            gpuccWorkerTerminate(worker, true);
+            break;
+        }
+        if (wait == GPUCC_WORKER_WAIT_RESULT_TIMEOUT) {
+            timeout = true;
+            dead    = true;
+            break;
+        }
+        if (gpuccWorkerRecv(worker->Socket, &msg, payload, sizeof(payload), &payload_size, &fd) == 0) {
+            dead = true;
+            break;
+        }
+        if (msg.Type == GPUCC_WORKER_MESSAGE_TYPE_INCLUDE && fd == -1) {
+            dead = (gpuccWorkerServeInclude(worker->Socket, container, &msg, payload, payload_size) == 0);
+            continue;
+        }
+        if (msg.Type == GPUCC_WORKER_MESSAGE_TYPE_RESULT && payload_size == 0) {
+            uint64_t nbcode = msg.Size[0];
+            uint64_t nblog  = msg.Size[1];
+            uint8_t *base   = nullptr;
+            if (nbcode + nblog != 0) {
+                if (fd == -1 || nbcode > UINT64_MAX - nblog || (base = (uint8_t*) gpuccWorkerMapSharedMemory(fd, nbcode + nblog)) == nullptr) {
+                    dead = true;
+                } else if (nblog != 0 && base[nbcode + nblog - 1] != 0) {
+                    munmap(base, (size_t)(nbcode + nblog));
+                    dead = true;
+                } else {
+                    container_->WorkerResult     = base;
+                    container_->WorkerResultSize = nbcode + nblog;
+                    container_->BytecodeBuffer   = (nbcode != 0) ? base : nullptr;
+                    container_->BytecodeSize     = nbcode;
+                    container_->LogBuffer        = (nblog  != 0) ?(char*)(base + nbcode) : nullptr;
+                    container_->LogBufferSize    = nblog;
+                }
+            }
+            if (fd != -1) {
+                close(fd);
+            }
+            if (!dead) {
+                result = msg.Result;
+                retire = (msg.Value != 0);
+            }
+            break;
+        }
+        /* A message the application does not expect means the worker cannot be trusted. */
+        if (fd != -1) {
+            close(fd);
+        }
+        dead = true;
+    }
+    if (dead) {
+        /* A worker that closed its socket has exited and may already have been reaped, so only a worker that stopped responding is killed. */
+        gpuccWorkerTerminate(worker, timeout);
+        if (timeout) {
+            snprintf(message, sizeof(message), "GpuCC: The worker process compiling %s did not respond within %u ms and was terminated. The compiler backend may have hung.\n", path, pool->ReplyTimeout);
+        } else {
+            snprintf(message, sizeof(message), "GpuCC: The worker process compiling %s exited unexpectedly. The compiler backend may have crashed.\n", path);
+        }
+        gpuccWorkerSetFailureLog(container, message);
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
+    } else if (retire) {
+        /* The worker reached a recycling limit and is exiting; a fresh process is started when it is next acquired. */
+        gpuccWorkerTerminate(worker, false);
+    }
+    gpuccWorkerRelease(pool, index);
+    return result;
+}
+
+GPUCC_API(void)
+gpuccReleaseWorkerResult
+(
+    struct GPUCC_PROGRAM_BYTECODE *container
+)
+{
+    GPUCC_PROGRAM_BYTECODE_BASE *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+
+    if (container_->WorkerResult != nullptr) {
+        munmap(container_->WorkerResult, (size_t) container_->WorkerResultSize);
+        container_->BytecodeBuffer   = nullptr;
+        container_->BytecodeSize     = 0;
+        container_->LogBuffer        = nullptr;
+        container_->LogBufferSize    = 0;
+        container_->WorkerResult     = nullptr;
+        container_->WorkerResultSize = 0;
+    }
+}
+
+/* @summary Build the path of the default worker host executable, which is installed in the same directory as the GpuCC library.
+ * @return The path, which the caller must free with free(), or NULL if the library path could not be determined.
+ */
+static char*
+gpuccWorkerDefaultHostPath
+(
+    void
+)
+{
+    Dl_info     info;
+    char const *base = nullptr;
+    char       *path = nullptr;
+    size_t      ndir = 0;
+
+    if (dladdr((void*) &gpuccRunWorkerProcess, &info) == 0 || info.dli_fname == nullptr) {
+        return nullptr;
+    }
+    if ((base = strrchr(info.dli_fname, '/')) != nullptr) {
+        ndir = (size_t)(base - info.dli_fname) + 1;
+    }
+    if ((path = (char*) malloc(ndir + sizeof(GPUCC_WORKER_HOST_NAME))) == nullptr) {
+        return nullptr;
+    }
+    memcpy(path, info.dli_fname, ndir);
+    memcpy(path + ndir, GPUCC_WORKER_HOST_NAME, sizeof(GPUCC_WORKER_HOST_NAME));
+    return path;
+}
+
+GPUCC_API(void)
+gpuccRunWorkerProcess
+(
+    int    argc,
+    char **argv
+)
+{
+    if (argc < 2 || argv == nullptr || argv[1] == nullptr || strcmp(argv[1], GPUCC_WORKER_HOST_ARGUMENT) != 0) {
+        return;
+    }
+    gpuccWorkerCloseInheritedFiles(GPUCC_WORKER_HOST_SOCKET);
+    /* The backends are loaded once, here, and inherited by every worker. The zygote starts no threads, so forking it is safe. */
+    if (!gpuccSuccess(gpuccStartup(GPUCC_USAGE_MODE_OFFLINE))) {
+        _exit(1);
+    }
+    gpuccWorkerZygoteMain(GPUCC_WORKER_HOST_SOCKET);
+}
+
+GPUCC_API(struct GPUCC_WORKER_PROCESS_POOL*)
+gpuccCreateWorkerProcessPool
+(
+    uint32_t worker_count
+)
+{
+    GPUCC_WORKER_PROCESS_POOL_INIT config;
+
+    memset(&config, 0, sizeof(config));
+    config.WorkerCount = worker_count;
+    return gpuccCreateWorkerProcessPoolEx(&config);
+}
+
+GPUCC_API(struct GPUCC_WORKER_PROCESS_POOL*)
+gpuccCreateWorkerProcessPoolEx
+(
+    struct GPUCC_WORKER_PROCESS_POOL_INIT const *config
+)
+{
+    GPUCC_PROCESS_CONTEXT_LINUX *pctx = gpuccGetProcessContext_();
+    GPUCC_WORKER_PROCESS_POOL   *pool = nullptr;
+    uint32_t             worker_count = 0;
+
+    if (config == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        return nullptr;
+    }
+    if (pctx->StartupFlag == 0) {
+        gpuccDebugPrintf("GpuCC: Cannot create worker process pool. Call gpuccStartup() first.\n");
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_NOT_INITIALIZED));
+        return nullptr;
+    }
+    if ((worker_count = config->WorkerCount) == 0) {
+        if ((worker_count = std::thread::hardware_concurrency()) == 0) {
+            worker_count = 1;
+        }
+    }
+    if ((pool = new (std::nothrow) GPUCC_WORKER_PROCESS_POOL()) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    pool->Workers         = new (std::nothrow) GPUCC_WORKER_PROCESS[worker_count];
+    pool->IdleList        = new (std::nothrow) uint32_t[worker_count];
+    pool->IdleCount       = 0;
+    pool->WorkerCount     = 0;
+    pool->ReplyTimeout    = (config->ReplyTimeoutMilliseconds != 0) ? config->ReplyTimeoutMilliseconds : GPUCC_WORKER_DEFAULT_REPLY_TIMEOUT_MS;
+    pool->HostPath        = (config->HostPath != nullptr) ? strdup(config->HostPath) : gpuccWorkerDefaultHostPath();
+    pool->ZygoteSocket    = -1;
+    pool->ZygoteProcessId = 0;
+    if (pool->Workers == nullptr || pool->IdleList == nullptr || pool->HostPath == nullptr) {
+        gpuccDeleteWorkerProcessPool(pool);
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    if (access(pool->HostPath, X_OK) != 0) {
+        GPUCC_RESULT r = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+        gpuccDebugPrintf("GpuCC: The worker host executable %s cannot be executed (errno %d).\n", pool->HostPath, errno);
+        gpuccDeleteWorkerProcessPool(pool);
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+    /* Start every worker now, so that workers that cannot be started are reported here rather than on the first compile. */
+    for (uint32_t i = 0; i < worker_count; ++i) {
+        pool->Workers[i].Socket        = -1;
+        pool->Workers[i].ProcessHandle = -1;
+        pool->Workers[i].ProcessId     = 0;
+        pool->WorkerCount++;
+        if (gpuccWorkerSpawn(pool, &pool->Workers[i]) == 0) {
+            GPUCC_RESULT r = gpuccMakeResult_errno(GPUCC_RESULT_CODE_PLATFORM_ERROR);
+            gpuccDeleteWorkerProcessPool(pool);
+            gpuccSetLastResult(r);
+            return nullptr;
+        }
+        pool->IdleList[pool->IdleCount++] = i;
+    }
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
+    return pool;
+}
+
+GPUCC_API(void)
+gpuccDeleteWorkerProcessPool
+(
+    struct GPUCC_WORKER_PROCESS_POOL *pool
+)
+{
+    if (pool != nullptr) {
+        /* Idle workers exit when they see the socket close, and the zygote waits for them before it exits. */
+        for (uint32_t i = 0; i < pool->WorkerCount; ++i) {
+            gpuccWorkerTerminate(&pool->Workers[i], false);
+        }
+        {
+            std::lock_guard<std::mutex> lock(pool->ZygoteLock);
+            gpuccWorkerStopZygote(pool, false);
+        }
+        free(pool->HostPath);
+        delete[] pool->IdleList;
+        delete[] pool->Workers;
+        delete pool;
+    }
+}
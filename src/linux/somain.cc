@@ -0,0 +1,140 @@
+/**
+ * @summary somain.cc: Perform per-process and per-thread setup and teardown
+ * when the shared object is loaded into or unloaded from a process. As with
+ * DllMain on Windows, the work done here is kept to a minimum - most of the
+ * actual work is deferred to gpuccStartup and gpuccShutdown, which must be
+ * called by the application.
+ */
+#include <assert.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_publish.h"
+#include "gpucc_stats.h"
+#include "gpucc_trace.h"
+
+static GPUCC_PROCESS_CONTEXT_LINUX  g_ProcessContextData = {};
+
+static GPUCC_PROCESS_CONTEXT_LINUX *g_ProcessContext     = &g_ProcessContextData;
+
+/* @summary Free resources associated with a per-thread context.
+ * This function is registered as the destructor for the thread context pthread key, and runs when a thread that called into GpuCC exits.
+ * @param value The GPUCC_THREAD_CONTEXT_LINUX associated with the exiting thread.
+ */
+static void
+SoMain_DeleteThreadContext
+(
+    void *value
+)
+{
+    GPUCC_THREAD_CONTEXT_LINUX *tctx =(GPUCC_THREAD_CONTEXT_LINUX*) value;
+    if (tctx != nullptr) {
+        gpuccReleaseEpochRecord(tctx->EpochRecord);
+        gpuccReleaseStatisticsShard(tctx->StatisticsShard);
+        gpuccReleaseTraceBuffer(tctx->TraceBuffer);
+    }
+    free(tctx);
+}
+
+/* @summary Create the per-thread context object for the calling thread.
+ * Unlike Windows, there is no notification when a thread is created, so this is called the first time a thread calls into GpuCC.
+ * @return A pointer to the thread context, or NULL if the context could not be created.
+ */
+static GPUCC_THREAD_CONTEXT_LINUX*
+SoMain_CreateThreadContext
+(
+    void
+)
+{
+    GPUCC_PROCESS_CONTEXT_LINUX *pctx = g_ProcessContext;
+    GPUCC_THREAD_CONTEXT_LINUX  *tctx = nullptr;
+    int                           res = 0;
+
+    assert(pctx->InitializationFlag != 0);
+    if ((tctx = (GPUCC_THREAD_CONTEXT_LINUX*) malloc(sizeof(GPUCC_THREAD_CONTEXT_LINUX))) == nullptr) {
+        fprintf(stderr, "GpuCC: Allocating thread context failed with errno = %d.\n", errno);
+        return nullptr;
+    }
+    memset(tctx, 0, sizeof(GPUCC_THREAD_CONTEXT_LINUX));
+    if ((res = pthread_setspecific(pctx->TlsKey_ThreadContext, tctx)) != 0) {
+        fprintf(stderr, "GpuCC: Setting thread context failed with error %d.\n", res);
+        free(tctx);
+        return nullptr;
+    }
+    return tctx;
+}
+
+/* @summary Perform initialization required when a process loads the shared object into its address space.
+ * This function runs as a shared object constructor, before dlopen returns or before main is entered.
+ */
+__attribute__((constructor)) static void
+SoMain_InitializeProcessContext
+(
+    void
+)
+{
+    GPUCC_PROCESS_CONTEXT_LINUX *pctx = g_ProcessContext;
+    int                           res = 0;
+
+    assert(pctx->InitializationFlag == 0);
+    if ((res = pthread_key_create(&pctx->TlsKey_ThreadContext, SoMain_DeleteThreadContext)) != 0) {
+        fprintf(stderr, "GpuCC: Failed to allocate thread context key with error %d. Loading cannot proceed.\n", res);
+        return;
+    }
+    pctx->DebugOutputFlag    = getenv("GPUCC_DEBUG_OUTPUT") != nullptr;
+    pctx->InitializationFlag = 1;
+    pctx->StartupFlag        = 0;
+}
+
+/* @summary Perform cleanup required when a process unloads the shared object from its address space.
+ * This function runs as a shared object destructor, during dlclose or after main returns.
+ */
+__attribute__((destructor)) static void
+SoMain_ReleaseProcessContext
+(
+    void
+)
+{
+    GPUCC_PROCESS_CONTEXT_LINUX *pctx = g_ProcessContext;
+
+    if (pctx->InitializationFlag != 0) {
+        /* Free the context of the unloading thread; the key destructor
+         * will never run for it once the key has been deleted. */
+        SoMain_DeleteThreadContext(pthread_getspecific(pctx->TlsKey_ThreadContext));
+        pthread_setspecific(pctx->TlsKey_ThreadContext, nullptr);
+        pthread_key_delete(pctx->TlsKey_ThreadContext);
+    }
+    pctx->InitializationFlag = 0;
+    pctx->StartupFlag        = 0;
+}
+
+GPUCC_API(struct GPUCC_PROCESS_CONTEXT*)
+gpuccGetProcessContext
+(
+    void
+)
+{
+    return (struct GPUCC_PROCESS_CONTEXT*) g_ProcessContext;
+}
+
+GPUCC_API(struct GPUCC_THREAD_CONTEXT *)
+gpuccGetThreadContext
+(
+    void
+)
+{
+    GPUCC_PROCESS_CONTEXT_LINUX *pctx = g_ProcessContext;
+    GPUCC_THREAD_CONTEXT_LINUX  *tctx =(GPUCC_THREAD_CONTEXT_LINUX*) pthread_getspecific(pctx->TlsKey_ThreadContext);
+    if (tctx != nullptr) {
+        return (struct GPUCC_THREAD_CONTEXT*) tctx;
+    } else {
+        /* This is the first call into GpuCC from the calling thread. */
+        if ((tctx = SoMain_CreateThreadContext()) != nullptr) {
+            return (struct GPUCC_THREAD_CONTEXT*) tctx;
+        } else {
+            /* Debug output was generated by SoMain_CreateThreadContext */
+            abort();
+        }
+    }
+}
@@ -9,6 +9,9 @@
 #include <wchar.h>
 #include "gpucc.h"
 #include "gpucc_internal.h"
+#include "gpucc_publish.h"
+#include "gpucc_stats.h"
+#include "gpucc_trace.h"
 
 static GPUCC_PROCESS_CONTEXT_WIN32  g_ProcessContextData = {
     TLS_OUT_OF_INDEXES, /* TlsSlot_ThreadContext */
@@ -149,7 +152,9 @@ DllMain_DeleteThreadContext
 
     assert(pctx->InitializationFlag != FALSE);
     if ((tctx = (GPUCC_THREAD_CONTEXT_WIN32*) TlsGetValue(tctx_slot)) != nullptr) {
-        /* TODO: Clean up any resources referenced by the thread context */
+        gpuccReleaseEpochRecord(tctx->EpochRecord);
+        gpuccReleaseStatisticsShard(tctx->StatisticsShard);
+        gpuccReleaseTraceBuffer(tctx->TraceBuffer);
         TlsSetValue(tctx_slot, nullptr);
         free(tctx);
     }
@@ -1,4 +1,6 @@
 #include <assert.h>
+#include <string.h>
+#include <new>
 #include "gpucc.h"
 #include "gpucc_internal.h"
 #include "win32/gpucc_compiler_dxc_win32.h"
@@ -57,6 +59,502 @@ gpuccDxcStoreArg
     }
 }
 
+/* @summary Define the state of a compilation in progress on the calling thread, used to attribute DXC allocations to the compilation.
+ */
+typedef struct GPUCC_DXC_COMPILE_SCOPE_WIN32 {
+    GPUCC_DXC_MALLOC_WIN32       *Malloc;                                      /* The IMalloc of the compiler performing the compilation. */
+    GPUCC_DXC_ARENA_WIN32        *Arena;                                       /* The arena backing allocations made by the compilation, or NULL. */
+    GPUCC_BACKEND_MEMORY_STATS   *Stats;                                       /* The statistics of the compilation, stored in the bytecode container. */
+    int64_t                       NetBytes;                                    /* The number of bytes allocated less the number of bytes freed on the thread during the compilation. */
+} GPUCC_DXC_COMPILE_SCOPE_WIN32;
+
+/* @summary The compilation in progress on the calling thread, or NULL. A thread runs at most one DXC compilation at a time.
+ */
+static thread_local GPUCC_DXC_COMPILE_SCOPE_WIN32 *DxcCompileScope = nullptr;
+
+/* @summary Retrieve the compilation in progress on the calling thread, if it belongs to a given compiler.
+ * @param malloc The IMalloc of the compiler making an allocation.
+ * @return The compilation scope, or NULL if the calling thread is not compiling with the compiler.
+ */
+static GPUCC_DXC_COMPILE_SCOPE_WIN32*
+gpuccDxcCurrentCompileScope
+(
+    GPUCC_DXC_MALLOC_WIN32 *malloc
+)
+{
+    GPUCC_DXC_COMPILE_SCOPE_WIN32 *scope = DxcCompileScope;
+    return (scope != nullptr && scope->Malloc == malloc) ? scope : nullptr;
+}
+
+/* @summary Atomically raise a peak value to at least a given value.
+ * @param peak The peak value to update.
+ * @param value The value just observed.
+ */
+static void
+gpuccDxcUpdatePeak
+(
+    LONG64 volatile *peak,
+    LONG64          value
+)
+{
+    LONG64 prev = *peak;
+    while (value > prev) {
+        LONG64 seen = InterlockedCompareExchange64(peak, value, prev);
+        if (seen == prev) {
+            break;
+        } prev = seen;
+    }
+}
+
+/* @summary Count an allocation against a compiler and, if the calling thread is compiling with it, against the compilation.
+ * @param malloc The IMalloc of the compiler.
+ * @param scope The compilation in progress on the calling thread, or NULL.
+ * @param cb The size of the allocation, in bytes.
+ * @param arena_flag Set to true if the block was allocated from an arena.
+ */
+static void
+gpuccDxcCountAlloc
+(
+    GPUCC_DXC_MALLOC_WIN32        *malloc,
+    GPUCC_DXC_COMPILE_SCOPE_WIN32  *scope,
+    SIZE_T                            cb,
+    bool                      arena_flag
+)
+{
+    gpuccDxcUpdatePeak(&malloc->PeakBytes, InterlockedExchangeAdd64(&malloc->CurrentBytes, (LONG64) cb) + (LONG64) cb);
+    InterlockedExchangeAdd64(&malloc->TotalBytes, (LONG64) cb);
+    InterlockedIncrement64(&malloc->AllocationCount);
+    if (arena_flag) {
+        InterlockedExchangeAdd64(&malloc->ArenaBytes, (LONG64) cb);
+    }
+    if (scope != nullptr) {
+        scope->NetBytes += (int64_t) cb;
+        scope->Stats->TotalBytes += cb;
+        scope->Stats->AllocationCount++;
+        if (arena_flag) {
+            scope->Stats->ArenaBytes += cb;
+        }
+        if (scope->NetBytes > 0 && (uint64_t) scope->NetBytes > scope->Stats->PeakBytes) {
+            scope->Stats->PeakBytes = (uint64_t) scope->NetBytes;
+        }
+    }
+}
+
+/* @summary Count a free against a compiler and, if the calling thread is compiling with it, against the compilation.
+ * @param malloc The IMalloc of the compiler.
+ * @param scope The compilation in progress on the calling thread, or NULL.
+ * @param cb The size of the block being freed, in bytes.
+ */
+static void
+gpuccDxcCountFree
+(
+    GPUCC_DXC_MALLOC_WIN32        *malloc,
+    GPUCC_DXC_COMPILE_SCOPE_WIN32  *scope,
+    SIZE_T                            cb
+)
+{
+    InterlockedExchangeAdd64(&malloc->CurrentBytes, -(LONG64) cb);
+    if (scope != nullptr) {
+        scope->NetBytes -= (int64_t) cb;
+    }
+}
+
+HRESULT STDMETHODCALLTYPE
+GPUCC_DXC_MALLOC_WIN32::QueryInterface
+(
+    REFIID riid, 
+    void   **ppv
+)
+{
+    if (ppv == nullptr) {
+        return E_POINTER;
+    }
+    if (riid == __uuidof(IUnknown) || riid == __uuidof(IMalloc)) {
+        *ppv = static_cast<IMalloc*>(this);
+        AddRef();
+        return S_OK;
+    }
+    *ppv = nullptr;
+    return E_NOINTERFACE;
+}
+
+ULONG STDMETHODCALLTYPE
+GPUCC_DXC_MALLOC_WIN32::AddRef
+(
+    void
+)
+{
+    return (ULONG) InterlockedIncrement(&RefCount);
+}
+
+ULONG STDMETHODCALLTYPE
+GPUCC_DXC_MALLOC_WIN32::Release
+(
+    void
+)
+{   /* The object is owned by the compiler record, so it is never deleted here. */
+    return (ULONG) InterlockedDecrement(&RefCount);
+}
+
+void* STDMETHODCALLTYPE
+GPUCC_DXC_MALLOC_WIN32::Alloc
+(
+    SIZE_T cb
+)
+{
+    GPUCC_DXC_COMPILE_SCOPE_WIN32 *scope = gpuccDxcCurrentCompileScope(this);
+    GPUCC_DXC_ARENA_WIN32         *arena = (scope != nullptr) ? scope->Arena : nullptr;
+    GPUCC_DXC_MALLOC_BLOCK_WIN32  *block = nullptr;
+    uint8_t                        *base = nullptr;
+    SIZE_T                           nb = 0;
+
+    if (cb > (SIZE_T) -1 - 2 * GPUCC_DXC_MALLOC_HEADER_SIZE) {
+        return nullptr;
+    }
+    /* Round up so that every block in the arena starts at the header alignment. */
+    nb = (cb + GPUCC_DXC_MALLOC_HEADER_SIZE + (GPUCC_DXC_MALLOC_HEADER_SIZE - 1)) & ~(SIZE_T)(GPUCC_DXC_MALLOC_HEADER_SIZE - 1);
+    if (arena != nullptr && arena->BaseAddress != nullptr && nb <= arena->Capacity - arena->Offset) {
+        base = arena->BaseAddress + arena->Offset;
+        arena->Offset += nb;
+        InterlockedIncrement(&arena->LiveCount);
+    } else if ((base = (uint8_t*) gpuccHostAlloc(HostAllocator, cb + GPUCC_DXC_MALLOC_HEADER_SIZE, GPUCC_DXC_MALLOC_HEADER_SIZE)) != nullptr) {
+        arena = nullptr;
+    } else {
+        return nullptr;
+    }
+    block = (GPUCC_DXC_MALLOC_BLOCK_WIN32*) base;
+    block->Size  = cb;
+    block->Arena = arena;
+    gpuccDxcCountAlloc(this, scope, cb, arena != nullptr);
+    return base + GPUCC_DXC_MALLOC_HEADER_SIZE;
+}
+
+void* STDMETHODCALLTYPE
+GPUCC_DXC_MALLOC_WIN32::Realloc
+(
+    void *pv, 
+    SIZE_T cb
+)
+{
+    GPUCC_DXC_MALLOC_BLOCK_WIN32 *block = nullptr;
+    uint8_t                       *base = nullptr;
+    void                          *copy = nullptr;
+    SIZE_T                          old = 0;
+
+    if (pv == nullptr) {
+        return Alloc(cb);
+    }
+    if (cb == 0) {
+        Free(pv);
+        return nullptr;
+    }
+    if (cb > (SIZE_T) -1 - 2 * GPUCC_DXC_MALLOC_HEADER_SIZE) {
+        return nullptr;
+    }
+    block = (GPUCC_DXC_MALLOC_BLOCK_WIN32*)((uint8_t*) pv - GPUCC_DXC_MALLOC_HEADER_SIZE);
+    old   = block->Size;
+    if (block->Arena != nullptr) {
+        /* Arena blocks cannot grow in place, so move the data to a new block. */
+        if ((copy = Alloc(cb)) == nullptr) {
+            return nullptr;
+        }
+        memcpy(copy, pv, (old < cb) ? old : cb);
+        Free(pv);
+        return copy;
+    }
+    if ((base = (uint8_t*) gpuccHostRealloc(HostAllocator, block, cb + GPUCC_DXC_MALLOC_HEADER_SIZE, GPUCC_DXC_MALLOC_HEADER_SIZE)) == nullptr) {
+        return nullptr;
+    }
+    block = (GPUCC_DXC_MALLOC_BLOCK_WIN32*) base;
+    block->Size = cb;
+    gpuccDxcCountFree (this, gpuccDxcCurrentCompileScope(this), old);
+    gpuccDxcCountAlloc(this, gpuccDxcCurrentCompileScope(this), cb, false);
+    return base + GPUCC_DXC_MALLOC_HEADER_SIZE;
+}
+
+void STDMETHODCALLTYPE
+GPUCC_DXC_MALLOC_WIN32::Free
+(
+    void *pv
+)
+{
+    if (pv != nullptr) {
+        GPUCC_DXC_MALLOC_BLOCK_WIN32 *block = (GPUCC_DXC_MALLOC_BLOCK_WIN32*)((uint8_t*) pv - GPUCC_DXC_MALLOC_HEADER_SIZE);
+        gpuccDxcCountFree(this, gpuccDxcCurrentCompileScope(this), block->Size);
+        if (block->Arena != nullptr) {
+            /* Arena memory is reclaimed when the arena is reset. */
+            InterlockedDecrement(&block->Arena->LiveCount);
+        } else {
+            gpuccHostFree(HostAllocator, block);
+        }
+    }
+}
+
+SIZE_T STDMETHODCALLTYPE
+GPUCC_DXC_MALLOC_WIN32::GetSize
+(
+    void *pv
+)
+{
+    if (pv != nullptr) {
+        return ((GPUCC_DXC_MALLOC_BLOCK_WIN32 const*)((uint8_t const*) pv - GPUCC_DXC_MALLOC_HEADER_SIZE))->Size;
+    } else {
+        return (SIZE_T) -1;
+    }
+}
+
+int STDMETHODCALLTYPE
+GPUCC_DXC_MALLOC_WIN32::DidAlloc
+(
+    void *pv
+)
+{   /* The host allocator cannot answer this question. */
+    UNREFERENCED_PARAMETER(pv);
+    return -1;
+}
+
+void STDMETHODCALLTYPE
+GPUCC_DXC_MALLOC_WIN32::HeapMinimize
+(
+    void
+)
+{   /* Nothing to do; the host allocator manages its own memory. */
+}
+
+/* @summary Create a single DXC object, routing its memory through the compiler's IMalloc if one was supplied.
+ * If the loaded dxcompiler.dll does not export DxcCreateInstance2, the object is created with DxcCreateInstance instead.
+ * @param dispatch The DXC dispatch table.
+ * @param malloc The IMalloc to pass to DxcCreateInstance2, or NULL to use DxcCreateInstance.
+ * @param clsid The class identifier of the object to create.
+ * @param iid The interface identifier of the interface to return.
+ * @param ppv On return, stores the interface pointer.
+ * @return The HRESULT returned by DxcCreateInstance2 or DxcCreateInstance.
+ */
+static HRESULT
+gpuccDxcCreateObject
+(
+    DXCCOMPILERAPI_DISPATCH *dispatch, 
+    IMalloc                   *malloc, 
+    REFCLSID                    clsid, 
+    REFIID                        iid, 
+    LPVOID                       *ppv
+)
+{
+    if (malloc != nullptr) {
+        HRESULT res = dispatch->DxcCreateInstance2(malloc, clsid, iid, ppv);
+        if (res != E_NOTIMPL) {
+            return res;
+        }
+    }
+    return dispatch->DxcCreateInstance(clsid, iid, ppv);
+}
+
+/* @summary Create the DXC interfaces for an instance slot.
+ * @param dispatch The DXC dispatch table.
+ * @param malloc The IMalloc used for all DXC allocations, or NULL to use the DXC default allocator.
+ * @param instance The instance to initialize. On failure, both interface pointers are NULL.
+ * @return S_OK, or the HRESULT returned by DxcCreateInstance.
+ */
+static HRESULT
+gpuccDxcCreateInstance
+(
+    DXCCOMPILERAPI_DISPATCH   *dispatch, 
+    IMalloc                     *malloc, 
+    GPUCC_DXC_INSTANCE_WIN32  *instance
+)
+{
+    HRESULT res = S_OK;
+
+    if (FAILED((res = gpuccDxcCreateObject(dispatch, malloc, CLSID_DxcLibrary, IID_PPV_ARGS(&instance->DxcLibrary))))) {
+        instance->DxcLibrary  = nullptr;
+        instance->DxcCompiler = nullptr;
+        return res;
+    }
+    if (FAILED((res = gpuccDxcCreateObject(dispatch, malloc, CLSID_DxcCompiler, IID_PPV_ARGS(&instance->DxcCompiler))))) {
+        instance->DxcLibrary->Release();
+        instance->DxcLibrary  = nullptr;
+        instance->DxcCompiler = nullptr;
+        return res;
+    }
+    return S_OK;
+}
+
+/* @summary Release the DXC interfaces held by an instance slot.
+ * @param instance The instance to release.
+ */
+static void
+gpuccDxcReleaseInstance
+(
+    GPUCC_DXC_INSTANCE_WIN32 *instance
+)
+{
+    if (instance->DxcCompiler) {
+        IDxcCompiler *cc = instance->DxcCompiler;
+        instance->DxcCompiler = nullptr;
+        cc->Release();
+    }
+    if (instance->DxcLibrary) {
+        IDxcLibrary *lib = instance->DxcLibrary;
+        instance->DxcLibrary = nullptr;
+        lib->Release();
+    }
+}
+
+/* @summary Claim a set of DXC interfaces for the duration of one compilation.
+ * The search starts at a slot derived from the calling thread ID, so each thread tends to reuse the same instance.
+ * If every slot is busy, a temporary instance is created in the caller-supplied overflow storage.
+ * @param compiler The DXC compiler record.
+ * @param overflow Storage for a temporary instance, used only if every slot is busy.
+ * @param o_result On return, stores the HRESULT of any failed attempt to create DXC interfaces.
+ * @return A pointer to the claimed instance, or NULL if DXC interfaces could not be created.
+ */
+static GPUCC_DXC_INSTANCE_WIN32*
+gpuccDxcAcquireInstance
+(
+    GPUCC_COMPILER_DXC_WIN32 *compiler, 
+    GPUCC_DXC_INSTANCE_WIN32 *overflow, 
+    HRESULT                  *o_result
+)
+{
+    uint32_t start = (uint32_t)(GetCurrentThreadId() % compiler->InstanceCount);
+
+    *o_result = S_OK;
+    for (uint32_t i = 0, n = compiler->InstanceCount; i < n; ++i) {
+        GPUCC_DXC_INSTANCE_WIN32 *instance =&compiler->Instances[(start + i) % n];
+        if (InterlockedCompareExchange(&instance->InUse, 1, 0) == 0) {
+            if (instance->DxcCompiler == nullptr) {
+                if (FAILED((*o_result = gpuccDxcCreateInstance(compiler->DispatchTable, compiler->DxcMalloc, instance)))) {
+                    InterlockedExchange(&instance->InUse, 0);
+                    return nullptr;
+                }
+            }
+            return instance;
+        }
+    }
+    /* Every slot is busy; fall back to a temporary instance. */
+    overflow->InUse = 1;
+    if (FAILED((*o_result = gpuccDxcCreateInstance(compiler->DispatchTable, compiler->DxcMalloc, overflow)))) {
+        return nullptr;
+    }
+    return overflow;
+}
+
+/* @summary Return a set of DXC interfaces claimed by gpuccDxcAcquireInstance.
+ * @param instance The instance returned by gpuccDxcAcquireInstance.
+ * @param overflow The overflow storage passed to gpuccDxcAcquireInstance.
+ */
+static void
+gpuccDxcReturnInstance
+(
+    GPUCC_DXC_INSTANCE_WIN32 *instance, 
+    GPUCC_DXC_INSTANCE_WIN32 *overflow
+)
+{
+    if (instance == overflow) {
+        gpuccDxcReleaseInstance(overflow);
+        overflow->InUse = 0;
+    } else {
+        InterlockedExchange(&instance->InUse, 0);
+    }
+}
+
+/* @summary Retrieve the arena backing allocations made by a compilation, allocating the arena memory on first use.
+ * @param compiler The DXC compiler record.
+ * @param instance The instance claimed by the compilation.
+ * @param overflow The overflow storage passed to gpuccDxcAcquireInstance. Temporary instances have no arena.
+ * @return The arena, or NULL if the compiler does not use arenas or the arena memory could not be allocated.
+ */
+static GPUCC_DXC_ARENA_WIN32*
+gpuccDxcPrepareArena
+(
+    GPUCC_COMPILER_DXC_WIN32 *compiler, 
+    GPUCC_DXC_INSTANCE_WIN32 *instance, 
+    GPUCC_DXC_INSTANCE_WIN32 *overflow
+)
+{
+    GPUCC_DXC_ARENA_WIN32 *arena =&instance->Arena;
+
+    if (compiler->ArenaSize == 0 || instance == overflow) {
+        return nullptr;
+    }
+    if (arena->BaseAddress == nullptr) {
+        if ((arena->BaseAddress = (uint8_t*) gpuccHostAlloc(&compiler->CommonFields.HostAllocator, compiler->ArenaSize, GPUCC_DXC_MALLOC_HEADER_SIZE)) == nullptr) {
+            return nullptr;
+        }
+        arena->Capacity  = compiler->ArenaSize;
+        arena->Offset    = 0;
+        arena->LiveCount = 0;
+    }
+    return arena;
+}
+
+/* @summary Finish attributing allocations to a compilation, and reset its arena if no block allocated from the arena is still live.
+ * @param scope The compilation scope installed by gpuccCompileBytecodeDxc.
+ */
+static void
+gpuccDxcEndCompileScope
+(
+    GPUCC_DXC_COMPILE_SCOPE_WIN32 *scope
+)
+{
+    if (scope->Malloc == nullptr) {
+        return;
+    }
+    /* Only the thread holding the instance allocates from the arena, so LiveCount cannot rise while it is checked. */
+    if (scope->Arena != nullptr && scope->Arena->LiveCount == 0) {
+        scope->Arena->Offset = 0;
+    }
+    scope->Stats->CurrentBytes = (scope->NetBytes > 0) ? (uint64_t) scope->NetBytes : 0;
+    DxcCompileScope = nullptr;
+    scope->Malloc   = nullptr;
+}
+
+/* @summary Copy the bytecode and log out of the result blobs of a compilation into a single host allocation owned by the container, and release the blobs.
+ * This is done when the compilation allocated from an arena, since blobs held by the container would keep the arena from being reset.
+ * @param container The destination bytecode container.
+ * @param code_blob The blob containing the bytecode, or NULL.
+ * @param log_blob The blob containing the UTF-8 log, or NULL.
+ * @return Non-zero if the results were copied and the blobs released, or zero if memory allocation failed, in which case the blobs are unchanged.
+ */
+static int32_t
+gpuccDxcCopyOutput
+(
+    GPUCC_BYTECODE_DXC_WIN32 *container, 
+    IDxcBlob                 *code_blob, 
+    IDxcBlobEncoding          *log_blob
+)
+{
+    GPUCC_HOST_ALLOCATOR const *alloc = gpuccQueryBytecodeHostAllocator_(container);
+    SIZE_T                     nbcode = (code_blob != nullptr) ? code_blob->GetBufferSize() : 0;
+    SIZE_T                      nblog = (log_blob  != nullptr) ? log_blob ->GetBufferSize() : 0;
+    uint8_t                      *buf = nullptr;
+
+    if ((buf = (uint8_t*) gpuccHostAlloc(alloc, nbcode + nblog + 1, GPUCC_DXC_MALLOC_HEADER_SIZE)) == nullptr) {
+        return 0;
+    }
+    if (nbcode != 0) {
+        memcpy(buf, code_blob->GetBufferPointer(), nbcode);
+    }
+    if (nblog != 0) {
+        memcpy(buf + nbcode, log_blob->GetBufferPointer(), nblog);
+    }
+    buf[nbcode + nblog] = 0;
+    container->OutputBuffer                 = buf;
+    container->CommonFields.BytecodeSize    =(uint64_t) nbcode;
+    container->CommonFields.BytecodeBuffer  =(code_blob != nullptr) ? buf : nullptr;
+    container->CommonFields.LogBufferSize   =(uint64_t) nblog;
+    container->CommonFields.LogBuffer       =(log_blob  != nullptr) ?(char*)(buf + nbcode) : nullptr;
+    container->CodeBuffer                   = nullptr;
+    container->ErrorLog                     = nullptr;
+    if (code_blob != nullptr) {
+        code_blob->Release();
+    }
+    if (log_blob != nullptr) {
+        log_blob->Release();
+    }
+    return 1;
+}
+
 GPUCC_API(struct GPUCC_PROGRAM_BYTECODE*)
 gpuccCreateProgramBytecodeDxc
 (
@@ -65,7 +563,7 @@ gpuccCreateProgramBytecodeDxc
 {
     GPUCC_BYTECODE_DXC_WIN32 *code = nullptr;
 
-    if ((code = (GPUCC_BYTECODE_DXC_WIN32*) malloc(sizeof(GPUCC_BYTECODE_DXC_WIN32))) == nullptr) {
+    if ((code = (GPUCC_BYTECODE_DXC_WIN32*) gpuccHostAlloc(gpuccQueryCompilerHostAllocator_(compiler), sizeof(GPUCC_BYTECODE_DXC_WIN32), alignof(GPUCC_BYTECODE_DXC_WIN32))) == nullptr) {
         GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
         gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes to create DXC bytecode.\n", sizeof(GPUCC_BYTECODE_DXC_WIN32));
         gpuccSetLastResult(r);
@@ -78,17 +576,19 @@ gpuccCreateProgramBytecodeDxc
     code->CommonFields.CompileResult   = gpuccMakeResult(GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER);
     code->CommonFields.EntryPoint      = nullptr; /* Set on compile */
     code->CommonFields.SourcePath      = nullptr; /* Set on compile */
+    code->CommonFields.StringBuffer    = nullptr; /* Set on compile */
     code->CommonFields.LogBuffer       = nullptr; /* Set on compile */
     code->CommonFields.LogBufferSize   = 0;       /* Set on compile */
     code->CommonFields.BytecodeSize    = 0;       /* Set on compile */
     code->CommonFields.BytecodeBuffer  = nullptr; /* Set on compile */
     code->CodeBuffer                   = nullptr; /* Set on compile */
     code->ErrorLog                     = nullptr; /* Set on compile */
+    code->OutputBuffer                 = nullptr; /* Set on compile */
     return (struct GPUCC_PROGRAM_BYTECODE*) code;
 }
 
 GPUCC_API(void)
-gpuccDeleteProgramBytecodeDxc
+gpuccResetProgramBytecodeDxc
 (
     struct GPUCC_PROGRAM_BYTECODE *bytecode
 )
@@ -109,14 +609,82 @@ gpuccDeleteProgramBytecodeDxc
         container_->ErrorLog                    = nullptr;
         buf->Release();
     }
-    if (container_->CommonFields.EntryPoint != nullptr) {
-        free(container_->CommonFields.EntryPoint);
-        container_->CommonFields.EntryPoint  = nullptr;
-        container_->CommonFields.SourcePath  = nullptr;
+    if (container_->OutputBuffer != nullptr) {
+        uint8_t *buf = container_->OutputBuffer;
+        container_->CommonFields.BytecodeSize   = 0;
+        container_->CommonFields.BytecodeBuffer = nullptr;
+        container_->CommonFields.LogBufferSize  = 0;
+        container_->CommonFields.LogBuffer      = nullptr;
+        container_->OutputBuffer                = nullptr;
+        gpuccHostFree(gpuccQueryBytecodeHostAllocator_(bytecode), buf);
+    }
+}
+
+GPUCC_API(void)
+gpuccDeleteProgramBytecodeDxc
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_BYTECODE_DXC_WIN32  *container_ = gpuccBytecodeDxc_(bytecode);
+    GPUCC_HOST_ALLOCATOR const     *alloc = gpuccQueryBytecodeHostAllocator_(bytecode);
+
+    gpuccResetProgramBytecodeDxc(bytecode);
+    if (container_->CommonFields.StringBuffer != nullptr) {
+        gpuccHostFree(alloc, container_->CommonFields.StringBuffer);
+        container_->CommonFields.StringBuffer     = nullptr;
+        container_->CommonFields.StringBufferSize = 0;
+        container_->CommonFields.EntryPoint       = nullptr;
+        container_->CommonFields.SourcePath       = nullptr;
     }
     /* TODO: Decrement ref count on compiler object? */
+    gpuccHostFree(alloc, container_);
 }
 
+/* @summary Implement IDxcIncludeHandler by forwarding to the include handler of the compiler.
+ * The object lives on the stack of gpuccCompileBytecodeDxc for the duration of a single Compile call, so reference counting is a no-op.
+ * DXC has already joined quoted include names to the directory of the including file, so each name is resolved as a local include.
+ */
+struct GPUCC_DXC_INCLUDE_HANDLER_WIN32 : public IDxcIncludeHandler {
+    GPUCC_PROGRAM_BYTECODE        *Container;                                  /* The bytecode container being compiled into. */
+    IDxcLibrary                   *DxcLibrary;                                 /* The library used to create the source blobs. */
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void **ppv) override {
+        if (riid == __uuidof(IDxcIncludeHandler) || riid == __uuidof(IUnknown)) {
+           *ppv = static_cast<IDxcIncludeHandler*>(this);
+            return S_OK;
+        }
+       *ppv = nullptr;
+        return E_NOINTERFACE;
+    }
+    ULONG STDMETHODCALLTYPE AddRef (void) override { return 1; }
+    ULONG STDMETHODCALLTYPE Release(void) override { return 1; }
+
+    HRESULT STDMETHODCALLTYPE LoadSource(LPCWSTR filename, IDxcBlob **include_source) override {
+        GPUCC_HOST_ALLOCATOR const *alloc = gpuccQueryBytecodeHostAllocator_(Container);
+        IDxcBlobEncoding            *blob = nullptr;
+        char                        *path = nullptr;
+        GPUCC_INCLUDE_RESULT       result;
+        HRESULT                       res = S_OK;
+
+       *include_source = nullptr;
+        if ((path = gpuccConvertUtf16ToUtf8(alloc, filename)) == nullptr) {
+            return E_OUTOFMEMORY;
+        }
+        if (gpuccOpenInclude(Container, path, nullptr, GPUCC_INCLUDE_TYPE_LOCAL, &result) == 0) {
+            gpuccFreeStringBuffer(alloc, path);
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+        /* DXC may hold the blob after LoadSource returns, so it gets a private copy. */
+        res = DxcLibrary->CreateBlobWithEncodingOnHeapCopy(result.Content, (UINT32) result.ContentSize, CP_UTF8, &blob);
+        gpuccCloseInclude(Container, &result);
+        gpuccFreeStringBuffer(alloc, path);
+        if (SUCCEEDED(res)) {
+           *include_source = blob;
+        } return res;
+    }
+};
+
 GPUCC_API(struct GPUCC_RESULT)
 gpuccCompileBytecodeDxc
 (
@@ -129,31 +697,63 @@ gpuccCompileBytecodeDxc
 {
     GPUCC_COMPILER_DXC_WIN32  *compiler_ = gpuccCompilerDxc_(gpuccQueryBytecodeCompiler_(container));
     GPUCC_BYTECODE_DXC_WIN32 *container_ = gpuccBytecodeDxc_(container);
+    GPUCC_HOST_ALLOCATOR const    *alloc = gpuccQueryBytecodeHostAllocator_(container);
     IDxcOperationResult       *op_result = nullptr;
     IDxcBlobEncoding           *src_blob = nullptr;
     IDxcBlobEncoding           *log_blob = nullptr;
     IDxcBlob                  *code_blob = nullptr;
-    IDxcLibrary                     *lib = compiler_->DxcLibrary;
-    IDxcCompiler                    *dxc = compiler_->DxcCompiler;
+    GPUCC_DXC_INSTANCE_WIN32   *instance = nullptr;
+    IDxcLibrary                     *lib = nullptr;
+    IDxcCompiler                    *dxc = nullptr;
+    GPUCC_DXC_INSTANCE_WIN32    overflow = {};
+    GPUCC_DXC_COMPILE_SCOPE_WIN32  scope = {};
+    GPUCC_DXC_INCLUDE_HANDLER_WIN32 include_handler;
+    IDxcIncludeHandler      *include_ptr = nullptr;
     WCHAR                  *wsource_path = nullptr;
     WCHAR                  *wentry_point = nullptr;
     GPUCC_RESULT                  result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
     HRESULT                          res = S_OK;
     HRESULT                  compile_res = S_OK;
+    uint64_t                       start = gpuccQueryClockNanoseconds();
 
     UNREFERENCED_PARAMETER(source_path);
     UNREFERENCED_PARAMETER(entry_point);
 
     /* dxc expects UTF-16 strings; perform conversions. */
-    if ((wsource_path = gpuccConvertUtf8ToUtf16(container_->CommonFields.SourcePath)) == nullptr) {
+    if ((wsource_path = gpuccConvertUtf8ToUtf16(alloc, container_->CommonFields.SourcePath)) == nullptr) {
         /* gpuccUtf8ToUtf16 called gpuccSetLastResult for us. */
         goto cleanup_and_fail;
     }
-    if ((wentry_point = gpuccConvertUtf8ToUtf16(container_->CommonFields.EntryPoint)) == nullptr) {
+    if ((wentry_point = gpuccConvertUtf8ToUtf16(alloc, container_->CommonFields.EntryPoint)) == nullptr) {
         /* gpuccUtf8ToUtf16 called gpuccSetLastResult for us. */
         goto cleanup_and_fail;
     }
 
+    start = gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_STRING_INTERN, start);
+
+    /* Claim a set of DXC interfaces that no other thread is using. */
+    if ((instance = gpuccDxcAcquireInstance(compiler_, &overflow, &res)) == nullptr) {
+        GPUCC_RESULT r = gpuccMakeResult_HRESULT(res);
+        gpuccDebugPrintf(L"GpuCC: Failed to create DXC compiler instance with HRESULT %08X.\n", res);
+        gpuccSetLastResult(r);
+        goto cleanup_and_fail;
+    }
+    lib = instance->DxcLibrary;
+    dxc = instance->DxcCompiler;
+
+    /* Attribute the DXC allocations made on this thread to the compilation, serving them from the instance's arena if enabled. */
+    scope.Malloc   = static_cast<GPUCC_DXC_MALLOC_WIN32*>(compiler_->DxcMalloc);
+    scope.Arena    = gpuccDxcPrepareArena(compiler_, instance, &overflow);
+    scope.Stats    =&container_->CommonFields.BackendMemory;
+    scope.NetBytes = 0;
+    memset(scope.Stats, 0, sizeof(GPUCC_BACKEND_MEMORY_STATS));
+    DxcCompileScope =&scope;
+    if (gpuccQueryCompilerIncludeHandler_(compiler_)->Resolve != nullptr) {
+        include_handler.Container  = container;
+        include_handler.DxcLibrary = lib;
+        include_ptr =&include_handler;
+    }
+
     /* Create a blob around the caller-supplied code buffer. */
     res = lib->CreateBlobWithEncodingFromPinned(source_code, (UINT32) source_size, CP_UTF8, &src_blob);
     if (FAILED(res)) {
@@ -164,6 +764,7 @@ gpuccCompileBytecodeDxc
     }
 
     /* Pass the code buffer to the compiler. */
+    start = gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_BACKEND_SETUP, start);
     res = dxc->Compile
     (
         src_blob, 
@@ -174,9 +775,10 @@ gpuccCompileBytecodeDxc
         compiler_->ArgumentCount, 
         compiler_->DefineArray, 
         compiler_->DefineCount, 
-        nullptr, /* include handler */
+        include_ptr, 
         &op_result
     );
+    start = gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_COMPILE, start);
 
     if (op_result != nullptr) {
         /* Retrieve the compilation log. */
@@ -213,38 +815,47 @@ gpuccCompileBytecodeDxc
             gpuccSetLastResult(r);
         }
 
-        if (code_blob != nullptr) {
-            container_->CommonFields.BytecodeSize   =(uint64_t) code_blob->GetBufferSize();
-            container_->CommonFields.BytecodeBuffer =(uint8_t*) code_blob->GetBufferPointer();
-        } else { /* Failed to get the code blob. */
-            container_->CommonFields.BytecodeSize   = 0;
-            container_->CommonFields.BytecodeBuffer = nullptr;
-        } container_->CodeBuffer = code_blob;
-
-        if (log_blob != nullptr) {
-            container_->CommonFields.LogBufferSize =(uint64_t) log_blob->GetBufferSize();
-            container_->CommonFields.LogBuffer     =(char   *) log_blob->GetBufferPointer();
-        } else { /* Failed to get the log blob. */
-            container_->CommonFields.LogBufferSize = 0;
-            container_->CommonFields.LogBuffer     = nullptr;
-        } container_->ErrorLog = log_blob;
+        if (scope.Arena == nullptr || gpuccDxcCopyOutput(container_, code_blob, log_blob) == 0) {
+            if (code_blob != nullptr) {
+                container_->CommonFields.BytecodeSize   =(uint64_t) code_blob->GetBufferSize();
+                container_->CommonFields.BytecodeBuffer =(uint8_t*) code_blob->GetBufferPointer();
+            } else { /* Failed to get the code blob. */
+                container_->CommonFields.BytecodeSize   = 0;
+                container_->CommonFields.BytecodeBuffer = nullptr;
+            } container_->CodeBuffer = code_blob;
+
+            if (log_blob != nullptr) {
+                container_->CommonFields.LogBufferSize =(uint64_t) log_blob->GetBufferSize();
+                container_->CommonFields.LogBuffer     =(char   *) log_blob->GetBufferPointer();
+            } else { /* Failed to get the log blob. */
+                container_->CommonFields.LogBufferSize = 0;
+                container_->CommonFields.LogBuffer     = nullptr;
+            } container_->ErrorLog = log_blob;
+        }
     } else { /* The attempt to compile failed (ie. compilation was not performed) */
         GPUCC_RESULT r = gpuccMakeResult_HRESULT(res);
         gpuccDebugPrintf(L"GpuCC: A compilation attempt aborted with HRESULT %08X.\n", res);
         gpuccSetLastResult(r);
     }
+    gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_OUTPUT, start);
 
     /* Clean up temporary memory. */
-    gpuccFreeStringBuffer(wentry_point);
-    gpuccFreeStringBuffer(wsource_path);
+    gpuccFreeStringBuffer(alloc, wentry_point);
+    gpuccFreeStringBuffer(alloc, wsource_path);
     src_blob->Release();
+    gpuccDxcEndCompileScope(&scope);
+    gpuccDxcReturnInstance(instance, &overflow);
     return result;
 
 cleanup_and_fail:
-    gpuccFreeStringBuffer(wentry_point);
-    gpuccFreeStringBuffer(wsource_path);
+    gpuccFreeStringBuffer(alloc, wentry_point);
+    gpuccFreeStringBuffer(alloc, wsource_path);
     if (src_blob) {
         src_blob->Release();
+    }
+    gpuccDxcEndCompileScope(&scope);
+    if (instance) {
+        gpuccDxcReturnInstance(instance, &overflow);
     } return gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
 }
 
@@ -256,16 +867,56 @@ gpuccCleanupCompilerDxc
 {
     GPUCC_COMPILER_DXC_WIN32 *compiler_ = gpuccCompilerDxc_(compiler);
 
-    if (compiler_->DxcCompiler) {
-        IDxcCompiler *cc = compiler_->DxcCompiler;
-        compiler_->DxcCompiler = nullptr;
-        cc->Release();
+    for (uint32_t i = 0, n = compiler_->InstanceCount; i < n; ++i) {
+        gpuccDxcReleaseInstance(&compiler_->Instances[i]);
+        if (compiler_->Instances[i].Arena.BaseAddress != nullptr) {
+            gpuccHostFree(&compiler_->CommonFields.HostAllocator, compiler_->Instances[i].Arena.BaseAddress);
+            compiler_->Instances[i].Arena.BaseAddress = nullptr;
+        }
     }
-    if (compiler_->DxcLibrary) {
-        IDxcLibrary *lib = compiler_->DxcLibrary;
-        compiler_->DxcLibrary = nullptr;
-        lib->Release();
+}
+
+/* @summary Release every set of DXC interfaces held by a compiler, along with any memory retained by them.
+ * The instance slots are recreated on demand by gpuccDxcAcquireInstance. The arenas are retained.
+ * @param compiler The compiler. No compilation may be running on the compiler.
+ * @return This function always returns non-zero.
+ */
+static int32_t
+gpuccRecycleBackendDxc
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_COMPILER_DXC_WIN32 *compiler_ = gpuccCompilerDxc_(compiler);
+
+    for (uint32_t i = 0, n = compiler_->InstanceCount; i < n; ++i) {
+        gpuccDxcReleaseInstance(&compiler_->Instances[i]);
     }
+    return 1;
+}
+
+/* @summary Retrieve the memory usage of the DXC interfaces of a compiler, as counted by its IMalloc.
+ * @param compiler The compiler.
+ * @param o_stats On return, stores the memory usage.
+ * @return This function always returns non-zero.
+ */
+static int32_t
+gpuccQueryBackendMemoryDxc
+(
+    struct GPUCC_PROGRAM_COMPILER     *compiler, 
+    struct GPUCC_BACKEND_MEMORY_STATS  *o_stats
+)
+{
+    GPUCC_COMPILER_DXC_WIN32 *compiler_ = gpuccCompilerDxc_(compiler);
+    GPUCC_DXC_MALLOC_WIN32      *malloc = static_cast<GPUCC_DXC_MALLOC_WIN32*>(compiler_->DxcMalloc);
+    LONG64                      current = malloc->CurrentBytes;
+
+    o_stats->CurrentBytes    = (current > 0) ? (uint64_t) current : 0;
+    o_stats->PeakBytes       = (uint64_t) malloc->PeakBytes;
+    o_stats->TotalBytes      = (uint64_t) malloc->TotalBytes;
+    o_stats->ArenaBytes      = (uint64_t) malloc->ArenaBytes;
+    o_stats->AllocationCount = (uint64_t) malloc->AllocationCount;
+    return 1;
 }
 
 GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
@@ -278,17 +929,23 @@ gpuccCreateCompilerDxc
     GPUCC_COMPILER_DXC_WIN32     *dxc = nullptr;
     DXCCOMPILERAPI_DISPATCH *dispatch =&pctx->DxcCompiler_Dispatch;
     DxcDefine                 *macros = nullptr;
-    IDxcLibrary                  *lib = nullptr;
-    IDxcCompiler                *dxcc = nullptr;
+    GPUCC_DXC_INSTANCE_WIN32   *insts = nullptr;
+    GPUCC_DXC_MALLOC_WIN32   *dmalloc = nullptr;
+    IDxcVersionInfo             *dxcv = nullptr;
+    UINT32                     dxc_mj = 0;
+    UINT32                     dxc_mi = 0;
     uint8_t                     *base = nullptr;
     uint8_t                      *ptr = nullptr;
     uint8_t                      *end = nullptr;
     HRESULT                       res = S_OK;
     size_t                     nbneed = 0;
+    GPUCC_HOST_ALLOCATOR        alloc;
     int                    version_mj = 0;
     int                    version_mi = 0;
+    uint32_t               inst_count = 0;
     char               shader_type[3] ={0, 0, 0};
     GPUCC_STRING_INFO              si;
+    SYSTEM_INFO               sysinfo;
 
     /* Validate the target profile. */
     if (config->TargetProfile == nullptr) {
@@ -324,8 +981,17 @@ gpuccCreateCompilerDxc
         return nullptr;
     }
 
+    /* Keep one set of DXC interfaces per hardware thread, plus one for a thread waiting on a batch. */
+    GetSystemInfo(&sysinfo);
+    inst_count = (uint32_t) sysinfo.dwNumberOfProcessors + 1;
+    if (inst_count > GPUCC_COMPILER_DXC_WIN32_MAX_INSTANCES) {
+        inst_count = GPUCC_COMPILER_DXC_WIN32_MAX_INSTANCES;
+    }
+
     /* Determine the amount of memory required. */
     nbneed += sizeof(GPUCC_COMPILER_DXC_WIN32);
+    nbneed += sizeof(GPUCC_DXC_INSTANCE_WIN32) * inst_count;
+    nbneed += sizeof(GPUCC_DXC_MALLOC_WIN32);
     nbneed += sizeof(DxcDefine) * config->DefineCount;
     nbneed += sizeof(WCHAR   *) * GPUCC_COMPILER_DXC_WIN32_MAX_ARGS;
 
@@ -356,7 +1022,8 @@ gpuccCreateCompilerDxc
     }
 
     /* Allocate as a single block. */
-    if ((base = (uint8_t*) malloc(nbneed)) == nullptr) {
+    gpuccInitHostAllocator(&alloc, config->HostAllocator);
+    if ((base = (uint8_t*) gpuccHostAlloc(&alloc, nbneed, alignof(GPUCC_COMPILER_DXC_WIN32))) == nullptr) {
         GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
         gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes to create DXC compiler.\n", nbneed);
         gpuccSetLastResult(r);
@@ -366,6 +1033,29 @@ gpuccCreateCompilerDxc
     ptr = base + sizeof(GPUCC_COMPILER_DXC_WIN32);
     end = base + nbneed;
 
+    /* The array of instance slots immediately follows the compiler record.
+     * Slots are empty until first use, except for the first, created below.
+     */
+    insts =(GPUCC_DXC_INSTANCE_WIN32*) ptr;
+    ptr  += sizeof(GPUCC_DXC_INSTANCE_WIN32) * inst_count;
+    memset(insts, 0, sizeof(GPUCC_DXC_INSTANCE_WIN32) * inst_count);
+
+    /* DXC allocates through an IMalloc wrapper stored next, after the 
+     * instance slots, which counts the bytes allocated by the backend.
+     */
+    dmalloc = new (ptr) GPUCC_DXC_MALLOC_WIN32();
+    ptr    += sizeof(GPUCC_DXC_MALLOC_WIN32);
+    dmalloc->HostAllocator   =&dxc->CommonFields.HostAllocator;
+    dmalloc->RefCount        = 0;
+    dmalloc->CurrentBytes    = 0;
+    dmalloc->PeakBytes       = 0;
+    dmalloc->TotalBytes      = 0;
+    dmalloc->ArenaBytes      = 0;
+    dmalloc->AllocationCount = 0;
+    dxc->CommonFields.HostAllocator = alloc; /* Needed by the IMalloc before the first instance is created. */
+    dxc->DxcMalloc                  = dmalloc;
+    dxc->ArenaSize                  =(config->BackendArenaSize <= (uint64_t)(SIZE_T) -1) ? (SIZE_T) config->BackendArenaSize : 0;
+
     /* The array of DxcDefine structures immediately follows the compiler 
      * record. The entries are initialized when interning the strings below.
      */
@@ -436,36 +1126,37 @@ gpuccCreateCompilerDxc
         }
     }
 
-    /* Finally, initialize an IDxcLibrary instance for creating blobs, etc. 
-     * as well as the IDxcCompiler instance for actually compiling the code.
-     * TODO: Need to figure out how to clean these up.
+    /* Finally, create the first set of DXC interfaces. This verifies that
+     * DXC is usable, and the instance is available to the first compile.
      */
-    if (FAILED((res = dispatch->DxcCreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&lib))))) {
+    if (FAILED((res = gpuccDxcCreateInstance(dispatch, dxc->DxcMalloc, &insts[0])))) {
         GPUCC_RESULT r = gpuccMakeResult_HRESULT(res);
-        gpuccDebugPrintf(L"");
+        gpuccDebugPrintf(L"GpuCC: Failed to create DXC compiler instance with HRESULT %08X.\n", res);
         gpuccSetLastResult(r);
-        free(base);
+        gpuccHostFree(&alloc, base);
         return nullptr;
     }
-    if (FAILED((res = dispatch->DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxcc))))) {
-        GPUCC_RESULT r = gpuccMakeResult_HRESULT(res);
-        gpuccDebugPrintf(L"");
-        gpuccSetLastResult(r);
-        lib->Release();
-        free(base);
-        return nullptr;
+
+    /* Query the compiler version, which forms part of the bytecode cache key along with the identity of the loaded module file. */
+    if (SUCCEEDED(insts[0].DxcCompiler->QueryInterface(IID_PPV_ARGS(&dxcv)))) {
+        dxcv->GetVersion(&dxc_mj, &dxc_mi);
+        dxcv->Release();
     }
 
     /* Finish initializing the compiler structure. */
     dxc->CommonFields.CompilerType        = GPUCC_COMPILER_TYPE_DXC;
     dxc->CommonFields.BytecodeType        = config->BytecodeType;
+    dxc->CommonFields.BackendVersion      = gpuccQueryModuleVersion((void const*) dispatch->DxcCreateInstance, ((uint64_t) dxc_mj << 32) | (uint64_t) dxc_mi);
     dxc->CommonFields.CreateBytecode      = gpuccCreateProgramBytecodeDxc;
     dxc->CommonFields.DeleteBytecode      = gpuccDeleteProgramBytecodeDxc;
+    dxc->CommonFields.ResetBytecode       = gpuccResetProgramBytecodeDxc;
     dxc->CommonFields.CompileBytecode     = gpuccCompileBytecodeDxc;
     dxc->CommonFields.CleanupCompiler     = gpuccCleanupCompilerDxc;
+    dxc->CommonFields.RecycleBackend      = gpuccRecycleBackendDxc;
+    dxc->CommonFields.QueryBackendMemory  = gpuccQueryBackendMemoryDxc;
     dxc->DispatchTable                    =&pctx->DxcCompiler_Dispatch;
-    dxc->DxcLibrary                       = lib;
-    dxc->DxcCompiler                      = dxcc;
+    dxc->Instances                        = insts;
+    dxc->InstanceCount                    = inst_count;
     dxc->DefineArray                      = macros;
     dxc->DefineCount                      = config->DefineCount;
     dxc->TargetRuntime                    = config->TargetRuntime;
@@ -1,5 +1,6 @@
 #include "gpucc.h"
 #include "gpucc_internal.h"
+#include "gpucc_include.h"
 #include "win32/gpucc_compiler_fxc_win32.h"
 
 GPUCC_API(struct GPUCC_PROGRAM_BYTECODE*)
@@ -10,7 +11,7 @@ gpuccCreateProgramBytecodeFxc
 {
     GPUCC_BYTECODE_FXC_WIN32 *code = nullptr;
 
-    if ((code = (GPUCC_BYTECODE_FXC_WIN32*) malloc(sizeof(GPUCC_BYTECODE_FXC_WIN32))) == nullptr) {
+    if ((code = (GPUCC_BYTECODE_FXC_WIN32*) gpuccHostAlloc(gpuccQueryCompilerHostAllocator_(compiler), sizeof(GPUCC_BYTECODE_FXC_WIN32), alignof(GPUCC_BYTECODE_FXC_WIN32))) == nullptr) {
         GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
         gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes to create FXC bytecode.\n", sizeof(GPUCC_BYTECODE_FXC_WIN32));
         gpuccSetLastResult(r);
@@ -23,6 +24,7 @@ gpuccCreateProgramBytecodeFxc
     code->CommonFields.CompileResult   = gpuccMakeResult(GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER);
     code->CommonFields.EntryPoint      = nullptr; /* Set on compile */
     code->CommonFields.SourcePath      = nullptr; /* Set on compile */
+    code->CommonFields.StringBuffer    = nullptr; /* Set on compile */
     code->CommonFields.LogBuffer       = nullptr; /* Set on compile */
     code->CommonFields.LogBufferSize   = 0;       /* Set on compile */
     code->CommonFields.BytecodeSize    = 0;       /* Set on compile */
@@ -33,7 +35,7 @@ gpuccCreateProgramBytecodeFxc
 }
 
 GPUCC_API(void)
-gpuccDeleteProgramBytecodeFxc
+gpuccResetProgramBytecodeFxc
 (
     struct GPUCC_PROGRAM_BYTECODE *bytecode
 )
@@ -54,14 +56,75 @@ gpuccDeleteProgramBytecodeFxc
         code->CodeBuffer                  = nullptr;
         buf->Release();
     }
-    if (code->CommonFields.EntryPoint != nullptr) {
-        free(code->CommonFields.EntryPoint);
-        code->CommonFields.EntryPoint  = nullptr;
-        code->CommonFields.SourcePath  = nullptr;
+}
+
+GPUCC_API(void)
+gpuccDeleteProgramBytecodeFxc
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_BYTECODE_FXC_WIN32     *code = gpuccBytecodeFxc_(bytecode);
+    GPUCC_HOST_ALLOCATOR const  *alloc = gpuccQueryBytecodeHostAllocator_(bytecode);
+
+    gpuccResetProgramBytecodeFxc(bytecode);
+    if (code->CommonFields.StringBuffer != nullptr) {
+        gpuccHostFree(alloc, code->CommonFields.StringBuffer);
+        code->CommonFields.StringBuffer     = nullptr;
+        code->CommonFields.StringBufferSize = 0;
+        code->CommonFields.EntryPoint       = nullptr;
+        code->CommonFields.SourcePath       = nullptr;
     }
     /* TODO: Decrement ref count on compiler object? */
+    gpuccHostFree(alloc, code);
 }
 
+/* @summary Implement ID3DInclude by forwarding to the include handler of the compiler.
+ * FXC identifies the including file by its content pointer, so the handler tracks the includes that are currently open in order to recover the requesting path.
+ * FXC closes each include before opening its next sibling, so at most GPUCC_MAX_INCLUDE_DEPTH includes are open at once.
+ */
+struct GPUCC_FXC_INCLUDE_HANDLER_WIN32 : public ID3DInclude {
+    GPUCC_PROGRAM_BYTECODE        *Container;                                  /* The bytecode container being compiled into. */
+    char const                    *SourcePath;                                 /* The path of the main source file, or NULL. */
+    GPUCC_INCLUDE_RESULT           OpenIncludes[GPUCC_MAX_INCLUDE_DEPTH];      /* The includes that are currently open. */
+    uint32_t                       OpenCount;                                  /* The number of valid items in the OpenIncludes array. */
+
+    HRESULT STDMETHODCALLTYPE Open(D3D_INCLUDE_TYPE type, LPCSTR filename, LPCVOID parent_data, LPCVOID *o_data, UINT *o_bytes) override {
+        char const *requesting_path = SourcePath;
+        int32_t            inc_type =(type == D3D_INCLUDE_SYSTEM) ? GPUCC_INCLUDE_TYPE_SYSTEM : GPUCC_INCLUDE_TYPE_LOCAL;
+
+       *o_data  = nullptr;
+       *o_bytes = 0;
+        if (OpenCount == GPUCC_MAX_INCLUDE_DEPTH) {
+            return E_FAIL;
+        }
+        for (uint32_t i = 0; i < OpenCount; ++i) {
+            if (OpenIncludes[i].Content == parent_data) {
+                requesting_path = OpenIncludes[i].ResolvedPath;
+                break;
+            }
+        }
+        if (gpuccOpenInclude(Container, filename, requesting_path, inc_type, &OpenIncludes[OpenCount]) == 0) {
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+       *o_data  = OpenIncludes[OpenCount].Content;
+       *o_bytes =(UINT) OpenIncludes[OpenCount].ContentSize;
+        OpenCount++;
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE Close(LPCVOID data) override {
+        for (uint32_t i = 0; i < OpenCount; ++i) {
+            if (OpenIncludes[i].Content == data) {
+                gpuccCloseInclude(Container, &OpenIncludes[i]);
+                OpenIncludes[i] = OpenIncludes[--OpenCount];
+                return S_OK;
+            }
+        }
+        return E_INVALIDARG;
+    }
+};
+
 GPUCC_API(struct GPUCC_RESULT)
 gpuccCompileBytecodeFxc
 (
@@ -81,14 +144,24 @@ gpuccCompileBytecodeFxc
     HRESULT                          res = S_OK;
     DWORD                         flags1 = compiler_->FxcCompileFlags;
     DWORD                         flags2 = 0;
+    GPUCC_FXC_INCLUDE_HANDLER_WIN32 include_handler;
+    ID3DInclude             *include_ptr = nullptr;
+    uint64_t                       start = gpuccQueryClockNanoseconds();
 
+    if (gpuccQueryCompilerIncludeHandler_(compiler_)->Resolve != nullptr) {
+        include_handler.Container  = container;
+        include_handler.SourcePath = source_path;
+        include_handler.OpenCount  = 0;
+        include_ptr =&include_handler;
+    }
+    start = gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_BACKEND_SETUP, start);
     res = dispatch->D3DCompile
     (
         source_code, 
         source_size, 
         source_path, 
         compiler_->DefineArray, 
-        nullptr, /* ID3DInclude* pInclude */
+        include_ptr, 
         entry_point, 
         compiler_->ShaderModel, 
         flags1, 
@@ -96,6 +169,7 @@ gpuccCompileBytecodeFxc
         &code, 
         &log
     );
+    start = gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_COMPILE, start);
     if (FAILED(res)) {
         result = gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
     }
@@ -116,6 +190,7 @@ gpuccCompileBytecodeFxc
         container_->CommonFields.LogBuffer      = nullptr;
     } container_->ErrorLog = log;
 
+    gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_OUTPUT, start);
     return result;
 }
 
@@ -140,6 +215,7 @@ gpuccCreateCompilerFxc
     uint8_t                     *base = nullptr;
     uint8_t                      *ptr = nullptr;
     size_t                     nbneed = 0;
+    GPUCC_HOST_ALLOCATOR        alloc;
     int                    version_mj = 0;
     int                    version_mi = 0;
     char               shader_type[3] ={0, 0, 0};
@@ -219,7 +295,8 @@ gpuccCreateCompilerFxc
     }
 
     /* Allocate as a single block. */
-    if ((base = (uint8_t*) malloc(nbneed)) == nullptr) {
+    gpuccInitHostAllocator(&alloc, config->HostAllocator);
+    if ((base = (uint8_t*) gpuccHostAlloc(&alloc, nbneed, alignof(GPUCC_COMPILER_FXC_WIN32))) == nullptr) {
         GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
         gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes to create FXC compiler.\n", nbneed);
         gpuccSetLastResult(r);
@@ -244,13 +321,19 @@ gpuccCreateCompilerFxc
     /* The macro array is always terminated with a null entry. */
     macros[config->DefineCount] = D3D_SHADER_MACRO { nullptr, nullptr };
 
-    /* Finish initializing the compiler structure. */
+    /* Finish initializing the compiler structure.
+     * D3D_COMPILER_VERSION is the version of the SDK headers, not of the loaded d3dcompiler module, so the module file is identified as well. */
     fxc->CommonFields.CompilerType        = GPUCC_COMPILER_TYPE_FXC;
     fxc->CommonFields.BytecodeType        = GPUCC_BYTECODE_TYPE_DXBC;
+    fxc->CommonFields.BackendVersion      = gpuccQueryModuleVersion((void const*) pctx->FxcCompiler_Dispatch.D3DCompile, D3D_COMPILER_VERSION);
     fxc->CommonFields.CreateBytecode      = gpuccCreateProgramBytecodeFxc;
     fxc->CommonFields.DeleteBytecode      = gpuccDeleteProgramBytecodeFxc;
+    fxc->CommonFields.ResetBytecode       = gpuccResetProgramBytecodeFxc;
     fxc->CommonFields.CompileBytecode     = gpuccCompileBytecodeFxc;
     fxc->CommonFields.CleanupCompiler     = gpuccCleanupCompilerFxc;
+    fxc->CommonFields.RecycleBackend      = nullptr;
+    fxc->CommonFields.QueryBackendMemory  = nullptr;
+    fxc->CommonFields.HostAllocator       = alloc;
     fxc->DispatchTable                    =&pctx->FxcCompiler_Dispatch;
     fxc->DefineArray                      = macros;
     fxc->DefineCount                      = config->DefineCount;
@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include "gpucc.h"
 #include "gpucc_internal.h"
+#include "gpucc_include.h"
 #include "win32/gpucc_compiler_ptx_win32.h"
 
 static char const *PtxArg_GpuArchitecture   = "--gpu-architecture";
@@ -64,7 +65,7 @@ gpuccCreateProgramBytecodePtx
 {
     GPUCC_BYTECODE_PTX_WIN32 *code = nullptr;
 
-    if ((code = (GPUCC_BYTECODE_PTX_WIN32*) malloc(sizeof(GPUCC_BYTECODE_PTX_WIN32))) == nullptr) {
+    if ((code = (GPUCC_BYTECODE_PTX_WIN32*) gpuccHostAlloc(gpuccQueryCompilerHostAllocator_(compiler), sizeof(GPUCC_BYTECODE_PTX_WIN32), alignof(GPUCC_BYTECODE_PTX_WIN32))) == nullptr) {
         GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
         gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes to create PTX bytecode.\n", sizeof(GPUCC_BYTECODE_PTX_WIN32));
         gpuccSetLastResult(r);
@@ -77,43 +78,64 @@ gpuccCreateProgramBytecodePtx
     code->CommonFields.CompileResult   = gpuccMakeResult(GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER);
     code->CommonFields.EntryPoint      = nullptr; /* Set on compile */
     code->CommonFields.SourcePath      = nullptr; /* Set on compile */
+    code->CommonFields.StringBuffer    = nullptr; /* Set on compile */
     code->CommonFields.LogBuffer       = nullptr; /* Set on compile */
     code->CommonFields.LogBufferSize   = 0;       /* Set on compile */
     code->CommonFields.BytecodeSize    = 0;       /* Set on compile */
     code->CommonFields.BytecodeBuffer  = nullptr; /* Set on compile */
     code->CodeBuffer                   = nullptr; /* Set on compile */
     code->LogBuffer                    = nullptr; /* Set on compile */
+    code->CodeBufferCapacity           = 0;       /* Set on compile */
+    code->LogBufferCapacity            = 0;       /* Set on compile */
     return (struct GPUCC_PROGRAM_BYTECODE*) code;
 }
 
+GPUCC_API(void)
+gpuccResetProgramBytecodePtx
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{   /* The NVRTC program object is destroyed after each compilation, so there
+     * are no backend objects to release. The code and log buffers are kept 
+     * so that the next compilation into the container can reuse them.
+     */
+    UNREFERENCED_PARAMETER(bytecode);
+}
+
 GPUCC_API(void)
 gpuccDeleteProgramBytecodePtx
 (
     struct GPUCC_PROGRAM_BYTECODE *bytecode
 )
 {
-    GPUCC_BYTECODE_PTX_WIN32 *code = gpuccBytecodePtx_(bytecode);
+    GPUCC_BYTECODE_PTX_WIN32     *code = gpuccBytecodePtx_(bytecode);
+    GPUCC_HOST_ALLOCATOR const  *alloc = gpuccQueryBytecodeHostAllocator_(bytecode);
 
     if (code->LogBuffer != nullptr) {
         char       *buf  = code->LogBuffer;
         code->CommonFields.LogBufferSize = 0;
         code->CommonFields.LogBuffer     = nullptr;
         code->LogBuffer                  = nullptr;
-        free(buf);
+        code->LogBufferCapacity          = 0;
+        gpuccHostFree(alloc, buf);
     }
     if (code->CodeBuffer != nullptr) {
         uint8_t     *buf  = code->CodeBuffer;
         code->CommonFields.BytecodeBuffer = nullptr;
         code->CommonFields.BytecodeSize   = 0;
         code->CodeBuffer                  = nullptr;
-        free(buf);
+        code->CodeBufferCapacity          = 0;
+        gpuccHostFree(alloc, buf);
     }
-    if (code->CommonFields.EntryPoint != nullptr) {
-        free(code->CommonFields.EntryPoint);
-        code->CommonFields.EntryPoint  = nullptr;
-        code->CommonFields.SourcePath  = nullptr;
+    if (code->CommonFields.StringBuffer != nullptr) {
+        gpuccHostFree(alloc, code->CommonFields.StringBuffer);
+        code->CommonFields.StringBuffer     = nullptr;
+        code->CommonFields.StringBufferSize = 0;
+        code->CommonFields.EntryPoint       = nullptr;
+        code->CommonFields.SourcePath       = nullptr;
     }
     /* TODO: Decrement ref count on compiler object? */
+    gpuccHostFree(alloc, code);
 }
 
 GPUCC_API(struct GPUCC_RESULT)
@@ -129,6 +151,7 @@ gpuccCompileBytecodePtx
     GPUCC_COMPILER_PTX_WIN32  *compiler_ = gpuccCompilerPtx_(gpuccQueryBytecodeCompiler_(container));
     GPUCC_BYTECODE_PTX_WIN32 *container_ = gpuccBytecodePtx_(container);
     PTXCOMPILERAPI_DISPATCH    *dispatch = compiler_->DispatchTable;
+    GPUCC_HOST_ALLOCATOR const    *alloc = gpuccQueryBytecodeHostAllocator_(container);
     GPUCC_RESULT                  result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
     GPUCC_RESULT                  failed = gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
     uint8_t                        *code = nullptr;
@@ -137,23 +160,37 @@ gpuccCompileBytecodePtx
     size_t                      log_size = 0;
     nvrtcProgram                 program = nullptr;
     nvrtcResult                      res = NVRTC_SUCCESS;
+    GPUCC_INCLUDE_LIST          includes = {};
+    uint64_t                       start = gpuccQueryClockNanoseconds();
 
     UNREFERENCED_PARAMETER(entry_point);
-    UNREFERENCED_PARAMETER(source_size);
 
-    if ((res = dispatch->nvrtcCreateProgram(&program, source_code, source_path, 0, NULL, NULL)) != NVRTC_SUCCESS) {
+    /* NVRTC has no include callback; every header must be supplied when the program is created.
+     * NVRTC copies the header contents, so the includes are released as soon as the program exists. */
+    if (gpuccCollectIncludes(container, source_code, source_size, source_path, &includes) == 0) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+        gpuccDebugPrintf(L"GpuCC: Failed to allocate memory for the program include list.\n");
+        gpuccReleaseIncludes(container, &includes);
+        gpuccSetLastResult(r);
+        return failed;
+    }
+    res = dispatch->nvrtcCreateProgram(&program, source_code, source_path, (int) includes.Count, includes.Contents, includes.Names);
+    gpuccReleaseIncludes(container, &includes);
+    if (res != NVRTC_SUCCESS) {
         GPUCC_RESULT r = gpuccMakeResult_nvrtc(res);
         gpuccDebugPrintf(L"GpuCC: nvrtcCreateProgram failed with %s.\n", dispatch->nvrtcGetErrorString(res));
         failed.PlatformResult = res;
         gpuccSetLastResult(r);
         return failed;
     }
+    start = gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_BACKEND_SETUP, start);
     if ((res = dispatch->nvrtcCompileProgram(program, compiler_->ArgumentCount, compiler_->ClArguments)) != NVRTC_SUCCESS) {
         GPUCC_RESULT r = gpuccMakeResult_nvrtc(res);
         gpuccDebugPrintf(L"GpuCC: nvrtcCompileProgram failed with %s.\n", dispatch->nvrtcGetErrorString(res));
         failed.PlatformResult = res;
         gpuccSetLastResult(r);
     }
+    start = gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_COMPILE, start);
     if ((res = dispatch->nvrtcGetPTXSize(program, &code_size)) != NVRTC_SUCCESS) {
         gpuccDebugPrintf(L"GpuCC: nvrtcGetPTXSize failed with %s.\n", dispatch->nvrtcGetErrorString(res));
     }
@@ -161,26 +198,35 @@ gpuccCompileBytecodePtx
         gpuccDebugPrintf(L"GpuCC: nvrtcGetProgramLogSize failed with %s.\n", dispatch->nvrtcGetErrorString(res));
     }
 
-    /* Allocate buffers to hold the code and/or program log.
+    /* Make sure the container's buffers can hold the code and/or program log.
+     * The buffers are retained when the container is reset, so a recycled 
+     * container only allocates when the output is larger than any before it.
      * Once the PTX code and program log are retrieved, the nvrtcProgram 
      * could theoretically be re-used to re-compile the source code with 
      * different options, but there's no need for that in this case.
      */
-    if (log_size  != 0 && ((log  = (char   *) malloc( log_size))) == nullptr) {
-        GPUCC_RESULT r = gpuccMakeResult_errno(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
-        gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes for program log buffer.\n", log_size);
-        failed.PlatformResult = errno;
-        gpuccSetLastResult(r);
-        return failed;
-    }
-    if (code_size != 0 && ((code = (uint8_t*) malloc(code_size))) == nullptr) {
-        GPUCC_RESULT r = gpuccMakeResult_errno(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
-        gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes for PTX bytecode buffer.\n", code_size);
-        failed.PlatformResult = errno;
-        gpuccSetLastResult(r);
-        free(log);
-        return failed;
-    }
+    if (log_size  > container_->LogBufferCapacity) {
+        if ((log  = (char   *) gpuccHostRealloc(alloc, container_->LogBuffer , log_size , 1)) == nullptr) {
+            GPUCC_RESULT r = gpuccMakeResult_errno(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+            gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes for program log buffer.\n", log_size);
+            failed.PlatformResult = errno;
+            gpuccSetLastResult(r);
+            return failed;
+        }
+        container_->LogBuffer          = log;
+        container_->LogBufferCapacity  = log_size;
+    } log  = container_->LogBuffer;
+    if (code_size > container_->CodeBufferCapacity) {
+        if ((code = (uint8_t*) gpuccHostRealloc(alloc, container_->CodeBuffer, code_size, 1)) == nullptr) {
+            GPUCC_RESULT r = gpuccMakeResult_errno(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+            gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes for PTX bytecode buffer.\n", code_size);
+            failed.PlatformResult = errno;
+            gpuccSetLastResult(r);
+            return failed;
+        }
+        container_->CodeBuffer         = code;
+        container_->CodeBufferCapacity = code_size;
+    } code = container_->CodeBuffer;
     if (code_size != 0 && ((res  = dispatch->nvrtcGetPTX(program, (char*)code))) != NVRTC_SUCCESS) {
         GPUCC_RESULT r = gpuccMakeResult_nvrtc(res);
         gpuccDebugPrintf(L"GpuCC: nvrtcGetPTX failed with %s.\n", dispatch->nvrtcGetErrorString(res));
@@ -203,7 +249,7 @@ gpuccCompileBytecodePtx
     } else {
         container_->CommonFields.BytecodeSize   = 0;
         container_->CommonFields.BytecodeBuffer = nullptr;
-    } container_->CodeBuffer = code;
+    }
 
     if (log_size != 0 && log != nullptr) {
         container_->CommonFields.LogBufferSize  =(uint64_t) log_size;
@@ -211,13 +257,11 @@ gpuccCompileBytecodePtx
     } else {
         container_->CommonFields.LogBufferSize  = 0;
         container_->CommonFields.LogBuffer      = nullptr;
-    } container_->LogBuffer = log;
-
+    }
+    gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_OUTPUT, start);
     return result;
 
 cleanup_and_fail:
-    free(log);
-    free(code);
     if (program && dispatch) {
         dispatch->nvrtcDestroyProgram(&program);
     }
@@ -246,7 +290,10 @@ gpuccCreateCompilerPtx
     char                    **defines = nullptr;
     char                     **clargs = nullptr;
     size_t                     nbneed = 0;
+    GPUCC_HOST_ALLOCATOR        alloc;
     char                  argbuf[256] = {};
+    int                      nvrtc_mj = 0;
+    int                      nvrtc_mi = 0;
 
     /* Validate the target profile. */
     if (config->TargetProfile == nullptr) {
@@ -274,7 +321,8 @@ gpuccCreateCompilerPtx
     }
 
     /* Allocate as a single block. */
-    if ((base = (uint8_t*) malloc(nbneed)) == nullptr) {
+    gpuccInitHostAllocator(&alloc, config->HostAllocator);
+    if ((base = (uint8_t*) gpuccHostAlloc(&alloc, nbneed, alignof(GPUCC_COMPILER_PTX_WIN32))) == nullptr) {
         GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
         gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes to create PTX compiler.\n", nbneed);
         gpuccSetLastResult(r);
@@ -351,13 +399,21 @@ gpuccCreateCompilerPtx
         gpuccPtxStoreArg(ptx, defines[i]);
     }
 
+    /* Query the NVRTC version, which forms part of the bytecode cache key along with the identity of the loaded module file. */
+    pctx->PtxCompiler_Dispatch.nvrtcVersion(&nvrtc_mj, &nvrtc_mi);
+
     /* Finish initializing the compiler structure. */
     ptx->CommonFields.CompilerType        = GPUCC_COMPILER_TYPE_NVRTC;
     ptx->CommonFields.BytecodeType        = GPUCC_BYTECODE_TYPE_PTX;
+    ptx->CommonFields.BackendVersion      = gpuccQueryModuleVersion((void const*) pctx->PtxCompiler_Dispatch.nvrtcVersion, ((uint64_t)(uint32_t) nvrtc_mj << 32) | (uint64_t)(uint32_t) nvrtc_mi);
     ptx->CommonFields.CreateBytecode      = gpuccCreateProgramBytecodePtx;
     ptx->CommonFields.DeleteBytecode      = gpuccDeleteProgramBytecodePtx;
+    ptx->CommonFields.ResetBytecode       = gpuccResetProgramBytecodePtx;
     ptx->CommonFields.CompileBytecode     = gpuccCompileBytecodePtx;
     ptx->CommonFields.CleanupCompiler     = gpuccCleanupCompilerPtx;
+    ptx->CommonFields.RecycleBackend      = nullptr;
+    ptx->CommonFields.QueryBackendMemory  = nullptr;
+    ptx->CommonFields.HostAllocator       = alloc;
     ptx->TargetRuntime                    = config->TargetRuntime;
     ptx->DispatchTable                    =&pctx->PtxCompiler_Dispatch;
     ptx->DefineCount                      = config->DefineCount;
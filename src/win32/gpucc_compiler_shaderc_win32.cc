@@ -0,0 +1,459 @@
+#include <assert.h>
+#include <stdio.h>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "win32/gpucc_compiler_shaderc_win32.h"
+
+/* @summary Define the mapping from a target profile stage name to a shaderc shader kind.
+ */
+typedef struct GPUCC_SHADERC_STAGE_MAPPING {
+    char const                   *StageName;                                   /* The shader stage name as it appears in the target profile. */
+    shaderc_shader_kind           ShaderKind;                                  /* The corresponding shaderc shader kind. */
+} GPUCC_SHADERC_STAGE_MAPPING;
+
+/* Direct3D shader model stage prefixes, used for HLSL source ("ps_6_0"). */
+static GPUCC_SHADERC_STAGE_MAPPING const ShadercStages_Hlsl[] = {
+    { "vs"  , shaderc_vertex_shader          },
+    { "ps"  , shaderc_fragment_shader        },
+    { "cs"  , shaderc_compute_shader         },
+    { "gs"  , shaderc_geometry_shader        },
+    { "hs"  , shaderc_tess_control_shader    },
+    { "ds"  , shaderc_tess_evaluation_shader }
+};
+
+/* glslc stage names, used for GLSL source ("frag"). */
+static GPUCC_SHADERC_STAGE_MAPPING const ShadercStages_Glsl[] = {
+    { "vert", shaderc_vertex_shader          },
+    { "frag", shaderc_fragment_shader        },
+    { "comp", shaderc_compute_shader         },
+    { "geom", shaderc_geometry_shader        },
+    { "tesc", shaderc_tess_control_shader    },
+    { "tese", shaderc_tess_evaluation_shader }
+};
+
+/* @summary Determine the source language and shader kind from a target profile string.
+ * @param target The nul-terminated target profile string, for example "ps_6_0" or "frag".
+ * @param o_lang On return, stores one of the values of the shaderc_source_language enumeration.
+ * @param o_kind On return, stores one of the values of the shaderc_shader_kind enumeration.
+ * @return Zero if the target profile was recognized, or non-zero otherwise.
+ */
+static int32_t
+gpuccShadercParseTargetProfile
+(
+    char const *target,
+    int32_t    *o_lang,
+    int32_t    *o_kind
+)
+{
+    int  version_mj = 0;
+    int  version_mi = 0;
+    char  stage[3]  ={0, 0, 0};
+
+    if (gpuccExtractDirect3DShaderModel(target, stage, &version_mj, &version_mi) == 0) {
+        for (size_t i = 0, n = sizeof(ShadercStages_Hlsl) / sizeof(ShadercStages_Hlsl[0]); i < n; ++i) {
+            if (_stricmp(stage, ShadercStages_Hlsl[i].StageName) == 0) {
+               *o_lang =(int32_t) shaderc_source_language_hlsl;
+               *o_kind =(int32_t) ShadercStages_Hlsl[i].ShaderKind;
+                return  0;
+            }
+        }
+    } else {
+        for (size_t i = 0, n = sizeof(ShadercStages_Glsl) / sizeof(ShadercStages_Glsl[0]); i < n; ++i) {
+            if (_stricmp(target, ShadercStages_Glsl[i].StageName) == 0) {
+               *o_lang =(int32_t) shaderc_source_language_glsl;
+               *o_kind =(int32_t) ShadercStages_Glsl[i].ShaderKind;
+                return  0;
+            }
+        }
+    }
+   *o_lang = 0;
+   *o_kind = 0;
+    return -1;
+}
+
+GPUCC_API(struct GPUCC_PROGRAM_BYTECODE*)
+gpuccCreateProgramBytecodeShaderc
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_BYTECODE_SHADERC_WIN32 *code = nullptr;
+
+    if ((code = (GPUCC_BYTECODE_SHADERC_WIN32*) gpuccHostAlloc(gpuccQueryCompilerHostAllocator_(compiler), sizeof(GPUCC_BYTECODE_SHADERC_WIN32), alignof(GPUCC_BYTECODE_SHADERC_WIN32))) == nullptr) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+        gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes to create shaderc bytecode.\n", sizeof(GPUCC_BYTECODE_SHADERC_WIN32));
+        gpuccSetLastResult(r);
+        return nullptr;
+    } memset(code, 0, sizeof(GPUCC_BYTECODE_SHADERC_WIN32));
+
+    code->CommonFields.Compiler        = compiler;
+    code->CommonFields.CompileResult   = gpuccMakeResult(GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER);
+    code->CommonFields.EntryPoint      = nullptr; /* Set on compile */
+    code->CommonFields.SourcePath      = nullptr; /* Set on compile */
+    code->CommonFields.StringBuffer    = nullptr; /* Set on compile */
+    code->CommonFields.LogBuffer       = nullptr; /* Set on compile */
+    code->CommonFields.LogBufferSize   = 0;       /* Set on compile */
+    code->CommonFields.BytecodeSize    = 0;       /* Set on compile */
+    code->CommonFields.BytecodeBuffer  = nullptr; /* Set on compile */
+    code->ShadercResult                = nullptr; /* Set on compile */
+    return (struct GPUCC_PROGRAM_BYTECODE*) code;
+}
+
+GPUCC_API(void)
+gpuccResetProgramBytecodeShaderc
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_COMPILER_SHADERC_WIN32  *compiler_ = gpuccCompilerShaderc_(gpuccQueryBytecodeCompiler_(bytecode));
+    GPUCC_BYTECODE_SHADERC_WIN32 *container_ = gpuccBytecodeShaderc_(bytecode);
+
+    if (container_->ShadercResult != nullptr) {
+        shaderc_compilation_result_t res = container_->ShadercResult;
+        container_->CommonFields.BytecodeSize   = 0;
+        container_->CommonFields.BytecodeBuffer = nullptr;
+        container_->CommonFields.LogBufferSize  = 0;
+        container_->CommonFields.LogBuffer      = nullptr;
+        container_->ShadercResult               = nullptr;
+        compiler_->DispatchTable->shaderc_result_release(res);
+    }
+}
+
+GPUCC_API(void)
+gpuccDeleteProgramBytecodeShaderc
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_BYTECODE_SHADERC_WIN32  *container_ = gpuccBytecodeShaderc_(bytecode);
+    GPUCC_HOST_ALLOCATOR const         *alloc = gpuccQueryBytecodeHostAllocator_(bytecode);
+
+    gpuccResetProgramBytecodeShaderc(bytecode);
+    if (container_->CommonFields.StringBuffer != nullptr) {
+        gpuccHostFree(alloc, container_->CommonFields.StringBuffer);
+        container_->CommonFields.StringBuffer     = nullptr;
+        container_->CommonFields.StringBufferSize = 0;
+        container_->CommonFields.EntryPoint       = nullptr;
+        container_->CommonFields.SourcePath       = nullptr;
+    }
+    gpuccHostFree(alloc, container_);
+}
+
+/* @summary Define the data allocated for each #include resolved on behalf of shaderc.
+ */
+typedef struct GPUCC_SHADERC_INCLUDE {
+    shaderc_include_result        ShadercResult;                               /* The result returned to shaderc. This must be the first field. */
+    GPUCC_INCLUDE_RESULT          IncludeResult;                               /* The result returned by the include handler. */
+} GPUCC_SHADERC_INCLUDE;
+
+/* The result returned when an include cannot be resolved. shaderc reports the content as the error message. */
+static char const ShadercIncludeNotFound[] = "Cannot find or open include file.";
+static shaderc_include_result ShadercIncludeFailed = { "", 0, ShadercIncludeNotFound, sizeof(ShadercIncludeNotFound) - 1, nullptr };
+
+/* @summary Implement shaderc_include_resolve_fn by forwarding to the include handler of the compiler.
+ * @param user_data The GPUCC_PROGRAM_BYTECODE being compiled into.
+ */
+static shaderc_include_result*
+gpuccShadercResolveInclude
+(
+    void                   *user_data,
+    char const     *requested_source,
+    int                         type,
+    char const    *requesting_source,
+    size_t             include_depth
+)
+{
+    GPUCC_PROGRAM_BYTECODE *container =(GPUCC_PROGRAM_BYTECODE*) user_data;
+    GPUCC_SHADERC_INCLUDE        *inc = nullptr;
+    GPUCC_INCLUDE_RESULT       result;
+    int32_t                  inc_type =(type == shaderc_include_type_standard) ? GPUCC_INCLUDE_TYPE_SYSTEM : GPUCC_INCLUDE_TYPE_LOCAL;
+
+    UNREFERENCED_PARAMETER(include_depth);
+
+    if (gpuccOpenInclude(container, requested_source, requesting_source, inc_type, &result) == 0) {
+        return &ShadercIncludeFailed;
+    }
+    if ((inc = (GPUCC_SHADERC_INCLUDE*) gpuccHostAlloc(gpuccQueryBytecodeHostAllocator_(container), sizeof(GPUCC_SHADERC_INCLUDE), alignof(GPUCC_SHADERC_INCLUDE))) == nullptr) {
+        gpuccCloseInclude(container, &result);
+        return &ShadercIncludeFailed;
+    }
+    inc->ShadercResult.source_name        = result.ResolvedPath;
+    inc->ShadercResult.source_name_length = strlen(result.ResolvedPath);
+    inc->ShadercResult.content            = result.Content;
+    inc->ShadercResult.content_length     =(size_t) result.ContentSize;
+    inc->ShadercResult.user_data          = nullptr;
+    inc->IncludeResult                    = result;
+    return &inc->ShadercResult;
+}
+
+/* @summary Implement shaderc_include_result_release_fn for results returned by gpuccShadercResolveInclude.
+ * @param user_data The GPUCC_PROGRAM_BYTECODE being compiled into.
+ */
+static void
+gpuccShadercReleaseInclude
+(
+    void                     *user_data,
+    shaderc_include_result *include_result
+)
+{
+    GPUCC_PROGRAM_BYTECODE *container =(GPUCC_PROGRAM_BYTECODE*) user_data;
+    GPUCC_SHADERC_INCLUDE        *inc =(GPUCC_SHADERC_INCLUDE*) include_result;
+
+    if (include_result != &ShadercIncludeFailed) {
+        gpuccCloseInclude(container, &inc->IncludeResult);
+        gpuccHostFree(gpuccQueryBytecodeHostAllocator_(container), inc);
+    }
+}
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccCompileBytecodeShaderc
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size,
+    char const                  *source_path,
+    char const                  *entry_point
+)
+{
+    GPUCC_COMPILER_SHADERC_WIN32  *compiler_ = gpuccCompilerShaderc_(gpuccQueryBytecodeCompiler_(container));
+    GPUCC_BYTECODE_SHADERC_WIN32 *container_ = gpuccBytecodeShaderc_(container);
+    SHADERCCOMPILERAPI_DISPATCH    *dispatch = compiler_->DispatchTable;
+    shaderc_compile_options_t        options = nullptr;
+    shaderc_compilation_result_t         res = nullptr;
+    shaderc_compilation_status        status = shaderc_compilation_status_success;
+    char const                          *log = nullptr;
+    GPUCC_RESULT                      result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+    uint64_t                           start = gpuccQueryClockNanoseconds();
+
+    /* The base options are shared by all compilations using this compiler.
+     * Clone them so that per-compilation state never touches the shared copy. */
+    if ((options = dispatch->shaderc_compile_options_clone(compiler_->CompileOptions)) == nullptr) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+        gpuccDebugPrintf(L"GpuCC: Failed to clone shaderc compile options.\n");
+        gpuccSetLastResult(r);
+        return gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
+    }
+    if (gpuccQueryCompilerIncludeHandler_(compiler_)->Resolve != nullptr) {
+        dispatch->shaderc_compile_options_set_include_callbacks(options, gpuccShadercResolveInclude, gpuccShadercReleaseInclude, container);
+    }
+    start = gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_BACKEND_SETUP, start);
+    res = dispatch->shaderc_compile_into_spv
+    (
+        compiler_->ShadercCompiler,
+        source_code,
+        (size_t) source_size,
+        (shaderc_shader_kind) compiler_->ShaderKind,
+        source_path,
+        entry_point,
+        options
+    );
+    dispatch->shaderc_compile_options_release(options);
+    start = gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_COMPILE, start);
+
+    if (res == nullptr) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+        gpuccDebugPrintf(L"GpuCC: shaderc_compile_into_spv failed to allocate a result object.\n");
+        gpuccSetLastResult(r);
+        return gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
+    }
+
+    /* The result object owns both the bytecode and the log. */
+    if ((status = dispatch->shaderc_result_get_compilation_status(res)) != shaderc_compilation_status_success) {
+        result = gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
+        result.PlatformResult = (int32_t) status;
+        container_->CommonFields.BytecodeSize   = 0;
+        container_->CommonFields.BytecodeBuffer = nullptr;
+    } else {
+        container_->CommonFields.BytecodeSize   =(uint64_t) dispatch->shaderc_result_get_length(res);
+        container_->CommonFields.BytecodeBuffer =(uint8_t*) dispatch->shaderc_result_get_bytes (res);
+    }
+    if ((log = dispatch->shaderc_result_get_error_message(res)) != nullptr && log[0] != 0) {
+        container_->CommonFields.LogBufferSize  =(uint64_t) strlen(log) + 1;
+        container_->CommonFields.LogBuffer      =(char   *) log;
+    } else {
+        container_->CommonFields.LogBufferSize  = 0;
+        container_->CommonFields.LogBuffer      = nullptr;
+    }
+    container_->ShadercResult = res;
+    gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_OUTPUT, start);
+    return result;
+}
+
+static void
+gpuccCleanupCompilerShaderc
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_COMPILER_SHADERC_WIN32 *compiler_ = gpuccCompilerShaderc_(compiler);
+    SHADERCCOMPILERAPI_DISPATCH   *dispatch = compiler_->DispatchTable;
+
+    if (compiler_->CompileOptions) {
+        shaderc_compile_options_t opts = compiler_->CompileOptions;
+        compiler_->CompileOptions = nullptr;
+        dispatch->shaderc_compile_options_release(opts);
+    }
+    if (compiler_->ShadercCompiler) {
+        shaderc_compiler_t cc = compiler_->ShadercCompiler;
+        compiler_->ShadercCompiler = nullptr;
+        dispatch->shaderc_compiler_release(cc);
+    }
+}
+
+/* @summary Replace the shaderc compiler object of a compiler with a new instance, releasing any memory retained by the old instance.
+ * The compile options hold the configuration of the GpuCC compiler and are kept.
+ * @param compiler The compiler. No compilation may be running on the compiler.
+ * @return Non-zero if the compiler object was replaced, or zero if the existing object was retained.
+ */
+static int32_t
+gpuccRecycleBackendShaderc
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_COMPILER_SHADERC_WIN32 *compiler_ = gpuccCompilerShaderc_(compiler);
+    SHADERCCOMPILERAPI_DISPATCH   *dispatch = compiler_->DispatchTable;
+    shaderc_compiler_t                   cc = nullptr;
+
+    if ((cc = dispatch->shaderc_compiler_initialize()) == nullptr) {
+        gpuccDebugPrintf(L"GpuCC: shaderc_compiler_initialize failed; the existing shaderc compiler is retained.\n");
+        return 0;
+    }
+    dispatch->shaderc_compiler_release(compiler_->ShadercCompiler);
+    compiler_->ShadercCompiler = cc;
+    return 1;
+}
+
+GPUCC_API(struct GPUCC_PROGRAM_COMPILER*)
+gpuccCreateCompilerShaderc
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT *config
+)
+{   // Assume that config has been validated by gpuccCreateCompiler.
+    GPUCC_PROCESS_CONTEXT_WIN32    *pctx = gpuccGetProcessContext_();
+    SHADERCCOMPILERAPI_DISPATCH *dispatch =&pctx->ShadercCompiler_Dispatch;
+    GPUCC_COMPILER_SHADERC_WIN32    *shc = nullptr;
+    shaderc_compiler_t                cc = nullptr;
+    shaderc_compile_options_t       opts = nullptr;
+    uint8_t                        *base = nullptr;
+    uint8_t                         *ptr = nullptr;
+    size_t                        nbneed = 0;
+    GPUCC_HOST_ALLOCATOR           alloc;
+    int32_t                         lang = 0;
+    int32_t                         kind = 0;
+    unsigned int                 spv_ver = 0;
+    unsigned int                 spv_rev = 0;
+
+    /* Validate the target profile. */
+    if (config->TargetProfile == nullptr) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_TARGET_PROFILE);
+        gpuccDebugPrintf(L"GpuCC: A target profile, for example, \"ps_6_0\" or \"frag\", is required by the shaderc compiler.\n");
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+    if (gpuccShadercParseTargetProfile(config->TargetProfile, &lang, &kind) != 0) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_TARGET_PROFILE);
+        gpuccDebugPrintf(L"GpuCC: Invalid target profile \"%S\" for the shaderc compiler.\n", config->TargetProfile);
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+
+    /* Determine the amount of memory required. */
+    nbneed += sizeof(GPUCC_COMPILER_SHADERC_WIN32);
+    nbneed += strlen(config->TargetProfile) + 1;
+
+    /* Allocate as a single block. */
+    gpuccInitHostAllocator(&alloc, config->HostAllocator);
+    if ((base = (uint8_t*) gpuccHostAlloc(&alloc, nbneed, alignof(GPUCC_COMPILER_SHADERC_WIN32))) == nullptr) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+        gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes to create shaderc compiler.\n", nbneed);
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+    shc =(GPUCC_COMPILER_SHADERC_WIN32*) base;
+    ptr = base + sizeof(GPUCC_COMPILER_SHADERC_WIN32);
+    shc->TargetProfile = gpuccPutStringUtf8(ptr, config->TargetProfile);
+
+    /* Create the compiler and the base set of options. Both live as long
+     * as the GpuCC compiler, so none of this setup is repeated per compile. */
+    if ((cc = dispatch->shaderc_compiler_initialize()) == nullptr) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+        gpuccDebugPrintf(L"GpuCC: shaderc_compiler_initialize failed.\n");
+        gpuccSetLastResult(r);
+        gpuccHostFree(&alloc, base);
+        return nullptr;
+    }
+    if ((opts = dispatch->shaderc_compile_options_initialize()) == nullptr) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+        gpuccDebugPrintf(L"GpuCC: shaderc_compile_options_initialize failed.\n");
+        gpuccSetLastResult(r);
+        dispatch->shaderc_compiler_release(cc);
+        gpuccHostFree(&alloc, base);
+        return nullptr;
+    }
+    dispatch->shaderc_compile_options_set_source_language(opts, (shaderc_source_language) lang);
+    for (uint32_t i = 0, n = config->DefineCount; i < n; ++i) {
+        char const *sym = config->DefineSymbols[i];
+        char const *val = config->DefineValues [i];
+        dispatch->shaderc_compile_options_add_macro_definition(opts, sym, strlen(sym), val, val != nullptr ? strlen(val) : 0);
+    }
+    if (config->CompilerFlags & GPUCC_COMPILER_FLAG_DEBUG) {
+        dispatch->shaderc_compile_options_set_generate_debug_info(opts);
+    }
+    if (config->CompilerFlags & GPUCC_COMPILER_FLAG_DISABLE_OPTIMIZATIONS) {
+        dispatch->shaderc_compile_options_set_optimization_level(opts, shaderc_optimization_level_zero);
+    } else {
+        dispatch->shaderc_compile_options_set_optimization_level(opts, shaderc_optimization_level_performance);
+    }
+    if (config->CompilerFlags & GPUCC_COMPILER_FLAG_WARNINGS_AS_ERRORS) {
+        dispatch->shaderc_compile_options_set_warnings_as_errors(opts);
+    }
+    if (config->CompilerFlags & GPUCC_COMPILER_FLAG_ROW_MAJOR_MATRICES) {
+        gpuccDebugPrintf(L"GpuCC: shaderc does not support specifying matrix storage order.\n");
+    }
+    if (config->CompilerFlags & GPUCC_COMPILER_FLAG_ENABLE_16BIT_TYPES) {
+        gpuccDebugPrintf(L"GpuCC: shaderc does not support native 16-bit types. Native support will be disabled.\n");
+    }
+    if (config->CompilerFlags & GPUCC_COMPILER_FLAG_AVOID_FLOW_CONTROL) {
+        gpuccDebugPrintf(L"GpuCC: shaderc does not support flow-control avoidance.\n");
+    }
+    if (config->CompilerFlags & GPUCC_COMPILER_FLAG_ENABLE_IEEE_STRICT) {
+        gpuccDebugPrintf(L"GpuCC: shaderc does not support forcing IEEE strictness.\n");
+    }
+    switch (config->TargetRuntime) {
+        case GPUCC_TARGET_RUNTIME_VULKAN_1_0:
+            dispatch->shaderc_compile_options_set_target_env(opts, shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_0);
+            break;
+        case GPUCC_TARGET_RUNTIME_VULKAN_1_1:
+            dispatch->shaderc_compile_options_set_target_env(opts, shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_1);
+            break;
+        case GPUCC_TARGET_RUNTIME_OPENGL:
+            dispatch->shaderc_compile_options_set_target_env(opts, shaderc_target_env_opengl, shaderc_env_version_opengl_4_5);
+            break;
+        default:
+            break;
+    }
+
+    /* shaderc does not expose a library version, so identify the loaded module file, together with the SPIR-V version and revision it targets. */
+    dispatch->shaderc_get_spv_version(&spv_ver, &spv_rev);
+
+    /* Finish initializing the compiler structure. */
+    shc->CommonFields.CompilerType        = GPUCC_COMPILER_TYPE_SHADERC;
+    shc->CommonFields.BytecodeType        = GPUCC_BYTECODE_TYPE_SPIRV;
+    shc->CommonFields.BackendVersion      = gpuccQueryModuleVersion((void const*) dispatch->shaderc_get_spv_version, ((uint64_t) spv_ver << 32) | (uint64_t) spv_rev);
+    shc->CommonFields.CreateBytecode      = gpuccCreateProgramBytecodeShaderc;
+    shc->CommonFields.DeleteBytecode      = gpuccDeleteProgramBytecodeShaderc;
+    shc->CommonFields.ResetBytecode       = gpuccResetProgramBytecodeShaderc;
+    shc->CommonFields.CompileBytecode     = gpuccCompileBytecodeShaderc;
+    shc->CommonFields.CleanupCompiler     = gpuccCleanupCompilerShaderc;
+    shc->CommonFields.RecycleBackend      = gpuccRecycleBackendShaderc;
+    shc->CommonFields.QueryBackendMemory  = nullptr;
+    shc->CommonFields.HostAllocator       = alloc;
+    shc->DispatchTable                    = dispatch;
+    shc->ShadercCompiler                  = cc;
+    shc->CompileOptions                   = opts;
+    shc->TargetRuntime                    = config->TargetRuntime;
+    shc->SourceLanguage                   = lang;
+    shc->ShaderKind                       = kind;
+    return (struct GPUCC_PROGRAM_COMPILER*) shc;
+}
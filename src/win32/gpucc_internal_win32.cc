@@ -144,7 +144,8 @@ gpuccInternUtf8ToUtf16
 GPUCC_API(WCHAR*)
 gpuccConvertUtf8ToUtf16
 (
-    char const *str
+    struct GPUCC_HOST_ALLOCATOR const *alloc, 
+    char const                          *str
 )
 {
     int       res = 0;
@@ -167,7 +168,7 @@ gpuccConvertUtf8ToUtf16
     }
 
     /* Allocate a buffer to hold the UTF-16 string data. */
-    if ((buf = (WCHAR*) malloc(nbytes)) == nullptr) {
+    if ((buf = (WCHAR*) gpuccHostAlloc(alloc, nbytes, sizeof(WCHAR))) == nullptr) {
         GPUCC_RESULT r = gpuccMakeResult_errno(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
         gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes of memory for UTF-16 string buffer.\n", nbytes);
         gpuccSetLastResult(r);
@@ -181,7 +182,7 @@ gpuccConvertUtf8ToUtf16
             GPUCC_RESULT r = gpuccMakeResult_Win32(GPUCC_RESULT_CODE_PLATFORM_ERROR, p);
             gpuccDebugPrintf(L"GpuCC: Attempting to convert UTF-8 to UTF-16 failed with error %08X.\n", p);
             gpuccSetLastResult(r);
-            free(buf);
+            gpuccHostFree(alloc, buf);
             return nullptr;
         }
     } else { /* Only output a nul. */
@@ -189,13 +190,61 @@ gpuccConvertUtf8ToUtf16
     } return buf;
 }
 
+GPUCC_API(char*)
+gpuccConvertUtf16ToUtf8
+(
+    struct GPUCC_HOST_ALLOCATOR const *alloc, 
+    WCHAR const                         *str
+)
+{
+    int       res = 0;
+    int    nbytes = 0;
+    char     *buf = nullptr;
+
+    /* Determine the number of bytes of UTF-8 string data. */
+    if (str != nullptr) {
+        if ((nbytes = WideCharToMultiByte(CP_UTF8, WC_ERR_INVALID_CHARS, str, -1, NULL, 0, NULL, NULL)) <= 0) {
+            DWORD        p = GetLastError();
+            GPUCC_RESULT r = gpuccMakeResult_Win32(GPUCC_RESULT_CODE_PLATFORM_ERROR, p);
+            gpuccDebugPrintf(L"GpuCC: Attempting to convert UTF-16 to UTF-8 failed with error %08X.\n", p);
+            gpuccSetLastResult(r);
+            return nullptr;
+        }
+    } else { /* Only output a nul. */
+        nbytes = 1;
+    }
+
+    /* Allocate a buffer to hold the UTF-8 string data. */
+    if ((buf = (char*) gpuccHostAlloc(alloc, (size_t) nbytes, 1)) == nullptr) {
+        GPUCC_RESULT r = gpuccMakeResult_errno(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+        gpuccDebugPrintf(L"GpuCC: Failed to allocate %d bytes of memory for UTF-8 string buffer.\n", nbytes);
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+
+    /* Perform the conversion into the destination buffer. */
+    if (str != nullptr) {
+        if ((res = WideCharToMultiByte(CP_UTF8, WC_ERR_INVALID_CHARS, str, -1, buf, nbytes, NULL, NULL)) <= 0) {
+            DWORD        p = GetLastError();
+            GPUCC_RESULT r = gpuccMakeResult_Win32(GPUCC_RESULT_CODE_PLATFORM_ERROR, p);
+            gpuccDebugPrintf(L"GpuCC: Attempting to convert UTF-16 to UTF-8 failed with error %08X.\n", p);
+            gpuccSetLastResult(r);
+            gpuccHostFree(alloc, buf);
+            return nullptr;
+        }
+    } else { /* Only output a nul. */
+        buf[0] = '\0';
+    } return buf;
+}
+
 GPUCC_API(void)
 gpuccFreeStringBuffer
 (
-    void *str
+    struct GPUCC_HOST_ALLOCATOR const *alloc, 
+    void                                *str
 )
 {
-    free(str);
+    gpuccHostFree(alloc, str);
 }
 
 GPUCC_API(int32_t)
@@ -307,13 +356,18 @@ gpuccSetProgramEntryPoint
     nbpath  = (source_path != nullptr) ? (strlen(source_path) + 1) : 1;
     nbneed  = nbentry + nbpath;
 
-    /* Allocate memory for all string data in one buffer. */
-    if ((buffer = (uint8_t*) malloc(nbneed)) == nullptr) {
-        result  = gpuccMakeResult_errno(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
-        gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes for storing program entry point.\n", nbneed);
-        gpuccSetLastResult(result);
-        return result;
-    } ptr = buffer;
+    /* Allocate memory for all string data in one buffer, reusing the buffer from a previous compilation if it is large enough. */
+    if (nbneed > bytecode_->StringBufferSize) {
+        if ((buffer = (uint8_t*) gpuccHostAlloc(gpuccQueryBytecodeHostAllocator_(bytecode), nbneed, 1)) == nullptr) {
+            result  = gpuccMakeResult_errno(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+            gpuccDebugPrintf(L"GpuCC: Failed to allocate %Iu bytes for storing program entry point.\n", nbneed);
+            gpuccSetLastResult(result);
+            return result;
+        }
+        gpuccHostFree(gpuccQueryBytecodeHostAllocator_(bytecode), bytecode_->StringBuffer);
+        bytecode_->StringBuffer     =(char*) buffer;
+        bytecode_->StringBufferSize = nbneed;
+    } ptr = (uint8_t*) bytecode_->StringBuffer;
 
     /* Write the string data to the buffer. */
     bytecode_->EntryPoint = gpuccPutStringUtf8(ptr, entry_point);
@@ -336,3 +390,157 @@ gpuccBytecodeContainerIsEmpty
     }
 }
 
+
+GPUCC_API(int32_t)
+gpuccQueryFileInfo
+(
+    char const            *path, 
+    uint64_t     *o_modify_time, 
+    uint64_t       *o_file_size
+)
+{
+    GPUCC_HOST_ALLOCATOR           alloc;
+    WIN32_FILE_ATTRIBUTE_DATA       attr;
+    WCHAR                         *pathw = nullptr;
+    BOOL                             res = FALSE;
+
+   *o_modify_time = 0;
+   *o_file_size   = 0;
+    gpuccInitHostAllocator(&alloc, nullptr);
+    if ((pathw = gpuccConvertUtf8ToUtf16(&alloc, path)) == nullptr) {
+        return 0;
+    }
+    res = GetFileAttributesExW(pathw, GetFileExInfoStandard, &attr);
+    gpuccFreeStringBuffer(&alloc, pathw);
+    if (res == FALSE || (attr.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) {
+        return 0;
+    }
+   *o_modify_time =((uint64_t) attr.ftLastWriteTime.dwHighDateTime << 32) | (uint64_t) attr.ftLastWriteTime.dwLowDateTime;
+   *o_file_size   =((uint64_t) attr.nFileSizeHigh << 32) | (uint64_t) attr.nFileSizeLow;
+    return 1;
+}
+
+GPUCC_API(int32_t)
+gpuccPathIsAbsolute
+(
+    char const *path
+)
+{
+    /* Drive-qualified (C:\ or C:/), UNC (\\server) or rooted (\dir) paths. */
+    if (path[0] == '\\' || path[0] == '/') {
+        return 1;
+    }
+    return ((path[0] >= 'A' && path[0] <= 'Z') || (path[0] >= 'a' && path[0] <= 'z')) && path[1] == ':' && (path[2] == '\\' || path[2] == '/');
+}
+
+GPUCC_API(size_t)
+gpuccPathDirectoryLength
+(
+    char const *path
+)
+{
+    size_t   len = 0;
+    for (size_t i = 0; path[i] != 0; ++i) {
+        if (path[i] == '\\' || path[i] == '/' || (i == 1 && path[i] == ':')) {
+            len = i + 1;
+        }
+    }
+    return len;
+}
+
+GPUCC_API(uint64_t)
+gpuccQueryThreadCpuNanoseconds
+(
+    void
+)
+{
+    FILETIME create_time, exit_time, kernel_time, user_time;
+    uint64_t kernel_100ns, user_100ns;
+
+    if (GetThreadTimes(GetCurrentThread(), &create_time, &exit_time, &kernel_time, &user_time) == FALSE) {
+        return 0;
+    }
+    kernel_100ns = ((uint64_t) kernel_time.dwHighDateTime << 32) | (uint64_t) kernel_time.dwLowDateTime;
+    user_100ns   = ((uint64_t) user_time.dwHighDateTime   << 32) | (uint64_t) user_time.dwLowDateTime;
+    return (kernel_100ns + user_100ns) * 100ULL;
+}
+
+GPUCC_API(uint64_t)
+gpuccQueryClockNanoseconds
+(
+    void
+)
+{
+    LARGE_INTEGER frequency, counter;
+    uint64_t freq, ticks;
+
+    if (QueryPerformanceFrequency(&frequency) == FALSE || QueryPerformanceCounter(&counter) == FALSE) {
+        return 0;
+    }
+    freq  = (uint64_t) frequency.QuadPart;
+    ticks = (uint64_t) counter.QuadPart;
+    /* Split the conversion so that the multiplication cannot overflow. */
+    return ((ticks / freq) * 1000000000ULL) + (((ticks % freq) * 1000000000ULL) / freq);
+}
+
+GPUCC_API(uint64_t)
+gpuccQueryCurrentThreadId
+(
+    void
+)
+{
+    return (uint64_t) GetCurrentThreadId();
+}
+
+GPUCC_API(uint64_t)
+gpuccQueryCurrentProcessId
+(
+    void
+)
+{
+    return (uint64_t) GetCurrentProcessId();
+}
+
+GPUCC_API(uint64_t)
+gpuccQueryModuleVersion
+(
+    void const   *address,
+    uint64_t  api_version
+)
+{
+    GPUCC_HASH_STATE            state;
+    GPUCC_HASH128                hash;
+    HMODULE                    module = NULL;
+    WIN32_FILE_ATTRIBUTE_DATA    attr;
+    WCHAR                   path[MAX_PATH + 1];
+    DWORD                      nchars = 0;
+
+    gpuccHashInit  (&state, 0);
+    gpuccHashUpdate(&state, &api_version, sizeof(api_version));
+    if (GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, (LPCWSTR) address, &module) &&
+       (nchars = GetModuleFileNameW(module, path, MAX_PATH)) != 0 && nchars < MAX_PATH &&
+        GetFileAttributesExW(path, GetFileExInfoStandard, &attr)) {
+        uint64_t size  =((uint64_t) attr.nFileSizeHigh << 32) | (uint64_t) attr.nFileSizeLow;
+        uint64_t mtime =((uint64_t) attr.ftLastWriteTime.dwHighDateTime << 32) | (uint64_t) attr.ftLastWriteTime.dwLowDateTime;
+        gpuccHashUpdate(&state, path  , nchars * sizeof(WCHAR));
+        gpuccHashUpdate(&state, &size , sizeof(size));
+        gpuccHashUpdate(&state, &mtime, sizeof(mtime));
+    }
+    hash = gpuccHashFinal(&state);
+    return hash.Low;
+}
+
+GPUCC_API(int32_t)
+gpuccSetCurrentThreadPriority
+(
+    int32_t priority
+)
+{
+    int level = THREAD_PRIORITY_NORMAL;
+    switch (priority) {
+        case GPUCC_WORKER_THREAD_PRIORITY_REDUCED: level = THREAD_PRIORITY_BELOW_NORMAL; break;
+        case GPUCC_WORKER_THREAD_PRIORITY_IDLE   : level = THREAD_PRIORITY_IDLE;         break;
+        default                                  : level = THREAD_PRIORITY_NORMAL;       break;
+    }
+    return SetThreadPriority(GetCurrentThread(), level) ? 1 : 0;
+}
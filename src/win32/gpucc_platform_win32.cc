@@ -1,9 +1,18 @@
 #include <assert.h>
 #include "gpucc.h"
 #include "gpucc_internal.h"
+#include "gpucc_async.h"
+#include "gpucc_cache.h"
+#include "gpucc_depend.h"
+#include "gpucc_flight.h"
+#include "gpucc_recycle.h"
+#include "gpucc_stats.h"
+#include "gpucc_trace.h"
+#include "gpucc_worker.h"
 #include "win32/gpucc_compiler_fxc_win32.h"
 #include "win32/gpucc_compiler_dxc_win32.h"
 #include "win32/gpucc_compiler_ptx_win32.h"
+#include "win32/gpucc_compiler_shaderc_win32.h"
 
 GPUCC_API(struct GPUCC_RESULT)
 gpuccGetLastResult
@@ -26,6 +35,9 @@ gpuccStartup
     uint32_t        fxccompiler_flags = FXCCOMPILERAPI_LOADER_FLAGS_NONE;
     uint32_t        dxccompiler_flags = DXCCOMPILERAPI_LOADER_FLAGS_NONE;
     uint32_t        ptxcompiler_flags = PTXCOMPILERAPI_LOADER_FLAGS_NONE;
+    uint32_t         shcompiler_flags = SHADERCCOMPILERAPI_LOADER_FLAGS_NONE;
+    uint64_t                  startup = gpuccTraceBegin();
+    uint64_t                    trace = 0;
 
     if (gpucc_usage_mode != GPUCC_USAGE_MODE_OFFLINE && 
         gpucc_usage_mode != GPUCC_USAGE_MODE_RUNTIME) {
@@ -35,6 +47,17 @@ gpuccStartup
         return gpuccMakeResult(GPUCC_RESULT_CODE_ALREADY_INITIALIZED);
     }
 
+    /* Create the worker pool used for asynchronous compilation. Worker threads are started on first use. */
+    if ((pctx->CompilePool = gpuccCreateCompilePool(0)) == nullptr) {
+        return gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+    }
+    /* Create the table used to deduplicate identical compilations that are in progress at the same time. */
+    if ((pctx->CompileFlights = gpuccCreateCompileFlightTable()) == nullptr) {
+        gpuccDeleteCompilePool(pctx->CompilePool);
+        pctx->CompilePool = nullptr;
+        return gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+    }
+
     /* When being used in offline mode, enable development-only features. */
     if (gpucc_usage_mode  == GPUCC_USAGE_MODE_OFFLINE) {
         fxccompiler_flags |= FXCCOMPILERAPI_LOADER_FLAG_DEVELOPMENT;
@@ -42,17 +65,29 @@ gpuccStartup
 
     /* Populate dispatch tables for any available compilers. */
     pctx->CompilerSupport = GPUCC_COMPILER_SUPPORT_NONE;
+    trace = gpuccTraceBegin();
     if (FxcCompilerApiPopulateDispatch(&pctx->FxcCompiler_Dispatch, fxccompiler_flags) != 0) {
         pctx->CompilerSupport |= GPUCC_COMPILER_SUPPORT_FXC;
     }
+    gpuccTraceEnd("Load compiler backend", trace, "FXC", nullptr);
+    trace = gpuccTraceBegin();
     if (DxcCompilerApiPopulateDispatch(&pctx->DxcCompiler_Dispatch, dxccompiler_flags) != 0) {
         pctx->CompilerSupport |= GPUCC_COMPILER_SUPPORT_DXC;
     }
+    gpuccTraceEnd("Load compiler backend", trace, "DXC", nullptr);
+    trace = gpuccTraceBegin();
     if (PtxCompilerApiPopulateDispatch(&pctx->PtxCompiler_Dispatch, ptxcompiler_flags) != 0) {
         pctx->CompilerSupport |= GPUCC_COMPILER_SUPPORT_NVRTC;
     }
+    gpuccTraceEnd("Load compiler backend", trace, "NVRTC", nullptr);
+    trace = gpuccTraceBegin();
+    if (ShadercCompilerApiPopulateDispatch(&pctx->ShadercCompiler_Dispatch, shcompiler_flags) != 0) {
+        pctx->CompilerSupport |= GPUCC_COMPILER_SUPPORT_SHADERC;
+    }
+    gpuccTraceEnd("Load compiler backend", trace, "shaderc", nullptr);
     /* ... */
     pctx->StartupFlag = TRUE;
+    gpuccTraceEnd("gpuccStartup", startup, nullptr, nullptr);
     return result;
 }
 
@@ -64,12 +99,20 @@ gpuccShutdown
 {
     GPUCC_PROCESS_CONTEXT_WIN32 *pctx = gpuccGetProcessContext_();
 
+    /* Finish any outstanding asynchronous compile jobs before the compilers are unloaded. */
+    gpuccDeleteCompilePool(pctx->CompilePool);
+    pctx->CompilePool = nullptr;
+    gpuccDeleteCompileFlightTable(pctx->CompileFlights);
+    pctx->CompileFlights = nullptr;
+
     /* Invalidate the dispatch tables for any available compilers. */
+    ShadercCompilerApiInvalidateDispatch(&pctx->ShadercCompiler_Dispatch);
     PtxCompilerApiInvalidateDispatch(&pctx->PtxCompiler_Dispatch);
     DxcCompilerApiInvalidateDispatch(&pctx->DxcCompiler_Dispatch);
     FxcCompilerApiInvalidateDispatch(&pctx->FxcCompiler_Dispatch);
     /* ... */
 
+    gpuccDisableBytecodeCache();
     pctx->CompilerSupport = GPUCC_COMPILER_SUPPORT_NONE;
     pctx->StartupFlag     = FALSE;
 }
@@ -84,6 +127,8 @@ gpuccCreateCompiler
     GPUCC_COMPILER_TYPE   compiler_type = GPUCC_COMPILER_TYPE_UNKNOWN;
     GPUCC_COMPILER_SUPPORT need_support = GPUCC_COMPILER_SUPPORT_NONE;
     struct GPUCC_PROGRAM_COMPILER    *c = nullptr;
+    uint64_t                      trace = gpuccTraceBegin();
+    GPUCC_HOST_ALLOCATOR          alloc;
 
     if (pctx->StartupFlag == FALSE) {
         GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_NOT_INITIALIZED);
@@ -106,6 +151,18 @@ gpuccCreateCompiler
         gpuccSetLastResult(r);
         return nullptr;
     }
+    if (config->HostAllocator != nullptr && gpuccInitHostAllocator(&alloc, config->HostAllocator) == 0) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccDebugPrintf(L"GpuCC: A GPUCC_HOST_ALLOCATOR must specify the Allocate, Reallocate and Free callbacks.\n");
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
+    if (config->IncludeHandler != nullptr && (config->IncludeHandler->Resolve == nullptr || config->IncludeHandler->Release == nullptr)) {
+        GPUCC_RESULT r = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+        gpuccDebugPrintf(L"GpuCC: A GPUCC_INCLUDE_HANDLER must specify the Resolve and Release callbacks.\n");
+        gpuccSetLastResult(r);
+        return nullptr;
+    }
     switch (config->BytecodeType) {
         case GPUCC_BYTECODE_TYPE_UNKNOWN:
             break;
@@ -118,8 +175,14 @@ gpuccCreateCompiler
             need_support  = GPUCC_COMPILER_SUPPORT_FXC;
             break;
         case GPUCC_BYTECODE_TYPE_SPIRV:
-            compiler_type = GPUCC_COMPILER_TYPE_DXC;
-            need_support  = GPUCC_COMPILER_SUPPORT_DXC;
+            /* Prefer DXC for SPIR-V, but fall back to shaderc if dxcompiler.dll is unavailable. */
+            if (pctx->CompilerSupport & GPUCC_COMPILER_SUPPORT_DXC) {
+                compiler_type = GPUCC_COMPILER_TYPE_DXC;
+                need_support  = GPUCC_COMPILER_SUPPORT_DXC;
+            } else {
+                compiler_type = GPUCC_COMPILER_TYPE_SHADERC;
+                need_support  = GPUCC_COMPILER_SUPPORT_SHADERC;
+            }
             break;
         case GPUCC_BYTECODE_TYPE_PTX:
             compiler_type = GPUCC_COMPILER_TYPE_NVRTC;
@@ -152,7 +215,7 @@ gpuccCreateCompiler
             c = gpuccCreateCompilerFxc(config);
             break;
         case GPUCC_COMPILER_TYPE_SHADERC:
-            c = nullptr;
+            c = gpuccCreateCompilerShaderc(config);
             break;
         case GPUCC_COMPILER_TYPE_NVRTC:
             c = gpuccCreateCompilerPtx(config);
@@ -161,6 +224,10 @@ gpuccCreateCompiler
             c = nullptr;
             break;
     }
+    if (c != nullptr && (c = gpuccInitCompilerCommon(c, config)) == nullptr) {
+        return nullptr;
+    }
+    gpuccTraceEnd("gpuccCreateCompiler", trace, gpuccCompilerTypeString(compiler_type), config->TargetProfile);
     return c;
 }
 
@@ -172,8 +239,12 @@ gpuccDeleteCompiler
 {
     if (compiler) {
         GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) compiler;
+        GPUCC_HOST_ALLOCATOR             alloc = compiler_->HostAllocator;
+        gpuccReleaseWorkerConfig(compiler);
+        gpuccReleaseRecyclePolicy(compiler);
         compiler_->CleanupCompiler(compiler);
-    } free(compiler);
+        gpuccHostFree(&alloc, compiler);
+    }
 }
 
 GPUCC_API(struct GPUCC_PROGRAM_BYTECODE*)
@@ -203,10 +274,42 @@ gpuccDeleteBytecodeContainer
     if (bytecode) {
         struct GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) gpuccQueryBytecodeCompiler_(bytecode);
         assert(compiler_ != nullptr);
+        gpuccBytecodeCacheRelease(bytecode);
+        gpuccReleaseSharedResult(bytecode);
+        gpuccReleaseWorkerResult(bytecode);
+        gpuccFreeDependencies(bytecode);
         compiler_->DeleteBytecode(bytecode);
     }
 }
 
+GPUCC_API(void)
+gpuccResetBytecodeContainer
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    if (bytecode) {
+        struct GPUCC_PROGRAM_BYTECODE_BASE *bytecode_ =(GPUCC_PROGRAM_BYTECODE_BASE*) bytecode;
+        struct GPUCC_PROGRAM_COMPILER_BASE *compiler_ =(GPUCC_PROGRAM_COMPILER_BASE*) gpuccQueryBytecodeCompiler_(bytecode);
+        assert(compiler_ != nullptr);
+        gpuccBytecodeCacheRelease(bytecode);
+        gpuccReleaseSharedResult(bytecode);
+        gpuccReleaseWorkerResult(bytecode);
+        gpuccResetDependencies(bytecode);
+        compiler_->ResetBytecode(bytecode);
+        /* The string buffer is retained; gpuccSetProgramEntryPoint reuses it. */
+        bytecode_->CompileResult  = gpuccMakeResult(GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER);
+        bytecode_->EntryPoint     = nullptr;
+        bytecode_->SourcePath     = nullptr;
+        bytecode_->LogBuffer      = nullptr;
+        bytecode_->LogBufferSize  = 0;
+        bytecode_->BytecodeSize   = 0;
+        bytecode_->BytecodeBuffer = nullptr;
+        memset(&bytecode_->BackendMemory, 0, sizeof(GPUCC_BACKEND_MEMORY_STATS));
+        memset(&bytecode_->Timings      , 0, sizeof(GPUCC_COMPILE_TIMINGS));
+    }
+}
+
 GPUCC_API(struct GPUCC_RESULT)
 gpuccCompileProgramBytecode
 (
@@ -217,9 +320,8 @@ gpuccCompileProgramBytecode
     char const                  *entry_point
 )
 {
-    GPUCC_PROGRAM_BYTECODE_BASE *container_ = nullptr;
-    GPUCC_PROGRAM_COMPILER_BASE  *compiler_ = nullptr;
-    GPUCC_RESULT                     result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+    GPUCC_RESULT result = gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+    uint64_t      start = 0;
 
     if (container == nullptr) {
         result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT);
@@ -235,22 +337,25 @@ gpuccCompileProgramBytecode
     }
     if (gpuccBytecodeContainerIsEmpty(container) == 0) {
         result = gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_BYTECODE_CONTAINER);
-        gpuccDebugPrintf(L"GpuCC: The supplied bytecode container has already been used to compile a program and cannot be reused.\n");
+        gpuccDebugPrintf(L"GpuCC: The supplied bytecode container has already been used to compile a program. Call gpuccResetBytecodeContainer to reuse it.\n");
         gpuccSetLastResult(result);
         return result;
     }
 
     /* Intern strings used for debug output. */
-    container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
-    compiler_  =(GPUCC_PROGRAM_COMPILER_BASE*) gpuccQueryBytecodeCompiler(container);
+    start = gpuccQueryClockNanoseconds();
     if (gpuccFailure((result = gpuccSetProgramEntryPoint(container, entry_point, source_path)))) {
         /* gpuccSetProgramEntryPoint called gpuccSetLastResult  */
         gpuccDebugPrintf(L"GpuCC: Cannot copy program entry point and source path. Compilation cannot proceed.\n");
         return result;
     }
+    gpuccRecordCompilePhase(container, GPUCC_COMPILE_PHASE_STRING_INTERN, start);
 
-    /* Finally, perform the actual compilation. */
-    result = compiler_->CompileBytecode(container, source_code, source_size, container_->SourcePath, container_->EntryPoint);
+    /* Finally, perform the actual compilation, or load the result from the bytecode cache. */
+    result = gpuccExecuteCompile(container, source_code, source_size);
+    ((GPUCC_PROGRAM_BYTECODE_BASE*) container)->Timings.TotalNanoseconds = gpuccQueryClockNanoseconds() - start;
+    gpuccRecordCompileStatistics(container, source_size, result);
+    gpuccTraceEnd("gpuccCompileProgramBytecode", start, source_path, entry_point);
     gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS));
     return result;
 }
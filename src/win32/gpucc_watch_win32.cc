@@ -0,0 +1,234 @@
+/**
+ * @summary gpucc_watch_win32.cc: Implement the directory watcher used by the
+ * reload service on Windows, using ReadDirectoryChangesW with completions
+ * delivered to an I/O completion port, which has no limit on the number of
+ * directories watched. Other threads wake the service thread by posting an
+ * empty completion to the port.
+ */
+#include <algorithm>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_reload.h"
+
+/* @summary Define the size, in bytes, of the buffer that receives change notifications for a single directory.
+ * If more changes occur between two reads than fit in the buffer, the read completes with zero bytes and the changes are reported as lost.
+ */
+#ifndef GPUCC_WATCH_BUFFER_SIZE
+#define GPUCC_WATCH_BUFFER_SIZE                                              16384
+#endif
+
+/* @summary Define the completion key posted by gpuccFileWatcherWake. Directory completions use the address of the directory record.
+ */
+#ifndef GPUCC_WATCH_WAKE_KEY
+#define GPUCC_WATCH_WAKE_KEY                                                     0
+#endif
+
+/* @summary Define the change notifications requested for each watched directory.
+ */
+#ifndef GPUCC_WATCH_NOTIFY_FILTER
+#define GPUCC_WATCH_NOTIFY_FILTER                                              \
+    (FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE)
+#endif
+
+/* @summary Define the data associated with a single watched directory.
+ * The Overlapped field and Buffer are in use by the kernel whenever a read is outstanding.
+ */
+typedef struct GPUCC_WATCH_DIRECTORY_WIN32 {
+    OVERLAPPED                     Overlapped;                                 /* The overlapped structure for the outstanding read. */
+    HANDLE                         Handle;                                     /* The directory handle, opened for overlapped I/O. */
+    BOOL                           Pending;                                    /* Set to TRUE while a read is outstanding. */
+    std::string                    Directory;                                  /* The directory, as passed to gpuccFileWatcherAddDirectory. */
+    DWORD                          Buffer[GPUCC_WATCH_BUFFER_SIZE / sizeof(DWORD)]; /* The buffer that receives FILE_NOTIFY_INFORMATION records. */
+} GPUCC_WATCH_DIRECTORY_WIN32;
+
+/* @summary Define the data associated with a directory watcher on Windows.
+ */
+typedef struct GPUCC_FILE_WATCHER {
+    HANDLE                         Port;                                       /* The I/O completion port that receives directory read completions. */
+    std::vector<GPUCC_WATCH_DIRECTORY_WIN32*> Directories;                     /* The watched directories. */
+} GPUCC_FILE_WATCHER;
+
+/* @summary Issue an overlapped read for changes to a watched directory.
+ * @param dir The watched directory.
+ * @return Non-zero if the read was issued.
+ */
+static int32_t
+gpuccWatchDirectoryRead
+(
+    GPUCC_WATCH_DIRECTORY_WIN32 *dir
+)
+{
+    ZeroMemory(&dir->Overlapped, sizeof(OVERLAPPED));
+    dir->Pending = ReadDirectoryChangesW(dir->Handle, dir->Buffer, sizeof(dir->Buffer), FALSE, GPUCC_WATCH_NOTIFY_FILTER, NULL, &dir->Overlapped, NULL);
+    return dir->Pending ? 1 : 0;
+}
+
+/* @summary Append the paths named in a completed directory read to a list of changed files.
+ * @param dir The watched directory whose read completed.
+ * @param nbread The number of bytes written to the directory buffer.
+ * @param o_changed The list of changed file paths.
+ */
+static void
+gpuccWatchDirectoryParse
+(
+    GPUCC_WATCH_DIRECTORY_WIN32 *dir,
+    DWORD                     nbread,
+    std::vector<std::string> &o_changed
+)
+{
+    uint8_t const *p =(uint8_t const*) dir->Buffer;
+    char        name[MAX_PATH * 4];
+
+    for ( ; ; ) {
+        FILE_NOTIFY_INFORMATION const *info =(FILE_NOTIFY_INFORMATION const*) p;
+        int nbname = WideCharToMultiByte(CP_UTF8, 0, info->FileName, (int)(info->FileNameLength / sizeof(WCHAR)), name, (int) sizeof(name), NULL, NULL);
+        if (nbname > 0) {
+            o_changed.push_back(dir->Directory + std::string(name, (size_t) nbname));
+        }
+        if (info->NextEntryOffset == 0 || (DWORD)(p + info->NextEntryOffset - (uint8_t const*) dir->Buffer) >= nbread) {
+            break;
+        }
+        p += info->NextEntryOffset;
+    }
+}
+
+/* @summary Cancel any outstanding read on a watched directory, wait for the kernel to release the buffer, and free the record.
+ * @param dir The watched directory.
+ */
+static void
+gpuccWatchDirectoryClose
+(
+    GPUCC_WATCH_DIRECTORY_WIN32 *dir
+)
+{
+    DWORD nb = 0;
+    if (dir->Pending) {
+        CancelIoEx(dir->Handle, &dir->Overlapped);
+        GetOverlappedResult(dir->Handle, &dir->Overlapped, &nb, TRUE);
+    }
+    CloseHandle(dir->Handle);
+    delete dir;
+}
+
+GPUCC_API(struct GPUCC_FILE_WATCHER*)
+gpuccCreateFileWatcher
+(
+    void
+)
+{
+    GPUCC_FILE_WATCHER *watcher = nullptr;
+
+    if ((watcher = new (std::nothrow) GPUCC_FILE_WATCHER()) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    }
+    if ((watcher->Port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1)) == NULL) {
+        DWORD        p = GetLastError();
+        GPUCC_RESULT r = gpuccMakeResult_Win32(GPUCC_RESULT_CODE_PLATFORM_ERROR, p);
+        gpuccDebugPrintf(L"GpuCC: CreateIoCompletionPort failed with error %08X.\n", p);
+        gpuccSetLastResult(r);
+        delete watcher;
+        return nullptr;
+    }
+    return watcher;
+}
+
+GPUCC_API(void)
+gpuccDeleteFileWatcher
+(
+    struct GPUCC_FILE_WATCHER *watcher
+)
+{
+    if (watcher != nullptr) {
+        for (GPUCC_WATCH_DIRECTORY_WIN32 *dir : watcher->Directories) {
+            gpuccWatchDirectoryClose(dir);
+        }
+        CloseHandle(watcher->Port);
+        delete watcher;
+    }
+}
+
+GPUCC_API(int32_t)
+gpuccFileWatcherAddDirectory
+(
+    struct GPUCC_FILE_WATCHER *watcher,
+    char const              *directory
+)
+{
+    GPUCC_WATCH_DIRECTORY_WIN32 *dir = nullptr;
+    GPUCC_HOST_ALLOCATOR       alloc;
+    WCHAR                     *pathw = nullptr;
+
+    gpuccInitHostAllocator(&alloc, nullptr);
+    if ((pathw = gpuccConvertUtf8ToUtf16(&alloc, (directory[0] != 0) ? directory : ".")) == nullptr) {
+        return 0;
+    }
+    if ((dir = new (std::nothrow) GPUCC_WATCH_DIRECTORY_WIN32()) == nullptr) {
+        gpuccFreeStringBuffer(&alloc, pathw);
+        return 0;
+    }
+    dir->Handle    = CreateFileW(pathw, FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+    dir->Pending   = FALSE;
+    dir->Directory = directory;
+    gpuccFreeStringBuffer(&alloc, pathw);
+    if (dir->Handle == INVALID_HANDLE_VALUE) {
+        delete dir;
+        return 0;
+    }
+    if (CreateIoCompletionPort(dir->Handle, watcher->Port, (ULONG_PTR) dir, 0) == NULL || gpuccWatchDirectoryRead(dir) == 0) {
+        gpuccWatchDirectoryClose(dir);
+        return 0;
+    }
+    watcher->Directories.push_back(dir);
+    return 1;
+}
+
+GPUCC_API(int32_t)
+gpuccFileWatcherWait
+(
+    struct GPUCC_FILE_WATCHER      *watcher,
+    uint32_t                     timeout_ms,
+    std::vector<std::string> &o_changed,
+    std::vector<std::string> &o_removed
+)
+{
+    DWORD      timeout = (timeout_ms == GPUCC_WAIT_INFINITE) ? INFINITE : (DWORD) timeout_ms;
+    int32_t       lost = 0;
+
+    /* Wait for the first completion, then drain any others already queued. */
+    for ( ; ; ) {
+        OVERLAPPED     *ov = nullptr;
+        ULONG_PTR       key = GPUCC_WATCH_WAKE_KEY;
+        DWORD        nbread = 0;
+        BOOL            res = GetQueuedCompletionStatus(watcher->Port, &nbread, &key, &ov, timeout);
+        if (ov == nullptr) {
+            /* Timed out, or woken by gpuccFileWatcherWake. */
+            break;
+        }
+        GPUCC_WATCH_DIRECTORY_WIN32 *dir =(GPUCC_WATCH_DIRECTORY_WIN32*) key;
+        dir->Pending = FALSE;
+        if (res && nbread == 0) {
+            /* The notification buffer overflowed. */
+            lost = 1;
+        } else if (res) {
+            gpuccWatchDirectoryParse(dir, nbread, o_changed);
+        }
+        /* A failed read (for example, because the directory was deleted) is not re-issued, and the directory is dropped. */
+        if (res == FALSE || gpuccWatchDirectoryRead(dir) == 0) {
+            o_removed.push_back(dir->Directory);
+            watcher->Directories.erase(std::find(watcher->Directories.begin(), watcher->Directories.end(), dir));
+            gpuccWatchDirectoryClose(dir);
+        }
+        timeout = 0;
+    }
+    return lost;
+}
+
+GPUCC_API(void)
+gpuccFileWatcherWake
+(
+    struct GPUCC_FILE_WATCHER *watcher
+)
+{
+    PostQueuedCompletionStatus(watcher->Port, 0, GPUCC_WATCH_WAKE_KEY, NULL);
+}
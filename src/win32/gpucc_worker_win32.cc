@@ -0,0 +1,76 @@
+/**
+ * @summary gpucc_worker_win32.cc: Implement worker process pools on Windows.
+ * Worker processes are not yet supported on Windows, where the library would
+ * need a host executable to launch, so pool creation fails and compilers run
+ * their backends in the calling process.
+ */
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_worker.h"
+
+GPUCC_API(struct GPUCC_RESULT)
+gpuccWorkerPoolCompile
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size
+)
+{
+    UNREFERENCED_PARAMETER(container);
+    UNREFERENCED_PARAMETER(source_code);
+    UNREFERENCED_PARAMETER(source_size);
+    return gpuccMakeResult(GPUCC_RESULT_CODE_COMPILER_NOT_SUPPORTED);
+}
+
+GPUCC_API(void)
+gpuccReleaseWorkerResult
+(
+    struct GPUCC_PROGRAM_BYTECODE *container
+)
+{
+    UNREFERENCED_PARAMETER(container);
+}
+
+GPUCC_API(struct GPUCC_WORKER_PROCESS_POOL*)
+gpuccCreateWorkerProcessPool
+(
+    uint32_t worker_count
+)
+{
+    UNREFERENCED_PARAMETER(worker_count);
+    gpuccDebugPrintf(L"GpuCC: Worker process pools are not supported on this platform.\n");
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_COMPILER_NOT_SUPPORTED));
+    return nullptr;
+}
+
+GPUCC_API(struct GPUCC_WORKER_PROCESS_POOL*)
+gpuccCreateWorkerProcessPoolEx
+(
+    struct GPUCC_WORKER_PROCESS_POOL_INIT const *config
+)
+{
+    UNREFERENCED_PARAMETER(config);
+    gpuccDebugPrintf(L"GpuCC: Worker process pools are not supported on this platform.\n");
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_COMPILER_NOT_SUPPORTED));
+    return nullptr;
+}
+
+GPUCC_API(void)
+gpuccRunWorkerProcess
+(
+    int    argc,
+    char **argv
+)
+{
+    UNREFERENCED_PARAMETER(argc);
+    UNREFERENCED_PARAMETER(argv);
+}
+
+GPUCC_API(void)
+gpuccDeleteWorkerProcessPool
+(
+    struct GPUCC_WORKER_PROCESS_POOL *pool
+)
+{
+    UNREFERENCED_PARAMETER(pool);
+}
@@ -0,0 +1,334 @@
+/**
+ * @summary shadercompilerapi_win32.cc: Implement the shaderc compiler runtime
+ * loader for Windows platforms.
+ */
+#include <assert.h>
+#include "win32/shadercompilerapi_win32.h"
+
+/* @summary Define a general signature for a dynamically loaded function. 
+ * Code will have to case the function pointer to the specific type.
+ */
+typedef int (*PFN_Unknown)(void);
+
+/* @summary Helper macro for populating a dispatch table with functions loaded at runtime.
+ * If the function is not found, the entry point is updated to point to a stub implementation provided by the caller.
+ * This macro relies on specific naming conventions:
+ * - The signature must be PFN_BlahBlahBlah where BlahBlahBlah corresponds to the _func argument.
+ * - The dispatch table field must be BlahBlahBlah where BlahBlahBlah corresponds to the _func argument.
+ * - The stub function must be named BlahBlahBlah_Stub where BlahBlahBlah corresponds to the _func argument.
+ * @param _disp A pointer to the dispatch table to populate.
+ * @param _module The HMODULE representing the module loaded into the process address space.
+ * @param _func The name of the function to dynamically load.
+ */
+#ifndef RuntimeFunctionResolve
+#define RuntimeFunctionResolve(_disp, _module, _func)                          \
+    for (;;) {                                                                 \
+        (_disp)->_func=(PFN_##_func) RuntimeModuleResolve((_module), #_func);  \
+        if ((_disp)->_func == NULL) {                                          \
+            (_disp)->_func  = _func##_Stub;                                    \
+        } break;                                                               \
+    }
+#endif
+
+static PFN_Unknown
+RuntimeModuleResolve
+(
+    HMODULE     module, 
+    char const *symbol
+)
+{
+    if (module != NULL) {
+        return (PFN_Unknown) GetProcAddress(module, symbol);
+    } else {
+        return (PFN_Unknown) NULL;
+    }
+}
+
+static shaderc_compiler_t
+shaderc_compiler_initialize_Stub
+(
+    void
+)
+{
+    return NULL;
+}
+
+static void
+shaderc_compiler_release_Stub
+(
+    shaderc_compiler_t compiler
+)
+{
+    UNREFERENCED_PARAMETER(compiler);
+}
+
+static shaderc_compile_options_t
+shaderc_compile_options_initialize_Stub
+(
+    void
+)
+{
+    return NULL;
+}
+
+static shaderc_compile_options_t
+shaderc_compile_options_clone_Stub
+(
+    const shaderc_compile_options_t options
+)
+{
+    UNREFERENCED_PARAMETER(options);
+    return NULL;
+}
+
+static void
+shaderc_compile_options_release_Stub
+(
+    shaderc_compile_options_t options
+)
+{
+    UNREFERENCED_PARAMETER(options);
+}
+
+static void
+shaderc_compile_options_add_macro_definition_Stub
+(
+    shaderc_compile_options_t options, 
+    const char                  *name, 
+    size_t                name_length, 
+    const char                 *value, 
+    size_t               value_length
+)
+{
+    UNREFERENCED_PARAMETER(options);
+    UNREFERENCED_PARAMETER(name);
+    UNREFERENCED_PARAMETER(name_length);
+    UNREFERENCED_PARAMETER(value);
+    UNREFERENCED_PARAMETER(value_length);
+}
+
+static void
+shaderc_compile_options_set_source_language_Stub
+(
+    shaderc_compile_options_t options, 
+    shaderc_source_language      lang
+)
+{
+    UNREFERENCED_PARAMETER(options);
+    UNREFERENCED_PARAMETER(lang);
+}
+
+static void
+shaderc_compile_options_set_generate_debug_info_Stub
+(
+    shaderc_compile_options_t options
+)
+{
+    UNREFERENCED_PARAMETER(options);
+}
+
+static void
+shaderc_compile_options_set_optimization_level_Stub
+(
+    shaderc_compile_options_t options, 
+    shaderc_optimization_level  level
+)
+{
+    UNREFERENCED_PARAMETER(options);
+    UNREFERENCED_PARAMETER(level);
+}
+
+static void
+shaderc_compile_options_set_target_env_Stub
+(
+    shaderc_compile_options_t options, 
+    shaderc_target_env         target, 
+    uint32_t                  version
+)
+{
+    UNREFERENCED_PARAMETER(options);
+    UNREFERENCED_PARAMETER(target);
+    UNREFERENCED_PARAMETER(version);
+}
+
+static void
+shaderc_compile_options_set_warnings_as_errors_Stub
+(
+    shaderc_compile_options_t options
+)
+{
+    UNREFERENCED_PARAMETER(options);
+}
+
+static void
+shaderc_compile_options_set_include_callbacks_Stub
+(
+    shaderc_compile_options_t                   options, 
+    shaderc_include_resolve_fn                 resolver, 
+    shaderc_include_result_release_fn   result_releaser, 
+    void                                     *user_data
+)
+{
+    UNREFERENCED_PARAMETER(options);
+    UNREFERENCED_PARAMETER(resolver);
+    UNREFERENCED_PARAMETER(result_releaser);
+    UNREFERENCED_PARAMETER(user_data);
+}
+
+static shaderc_compilation_result_t
+shaderc_compile_into_spv_Stub
+(
+    const shaderc_compiler_t           compiler, 
+    const char                     *source_text, 
+    size_t                     source_text_size, 
+    shaderc_shader_kind             shader_kind, 
+    const char                 *input_file_name, 
+    const char                *entry_point_name, 
+    const shaderc_compile_options_t     options
+)
+{
+    UNREFERENCED_PARAMETER(compiler);
+    UNREFERENCED_PARAMETER(source_text);
+    UNREFERENCED_PARAMETER(source_text_size);
+    UNREFERENCED_PARAMETER(shader_kind);
+    UNREFERENCED_PARAMETER(input_file_name);
+    UNREFERENCED_PARAMETER(entry_point_name);
+    UNREFERENCED_PARAMETER(options);
+    return NULL;
+}
+
+static void
+shaderc_result_release_Stub
+(
+    shaderc_compilation_result_t result
+)
+{
+    UNREFERENCED_PARAMETER(result);
+}
+
+static size_t
+shaderc_result_get_length_Stub
+(
+    const shaderc_compilation_result_t result
+)
+{
+    UNREFERENCED_PARAMETER(result);
+    return 0;
+}
+
+static shaderc_compilation_status
+shaderc_result_get_compilation_status_Stub
+(
+    const shaderc_compilation_result_t result
+)
+{
+    UNREFERENCED_PARAMETER(result);
+    return shaderc_compilation_status_internal_error;
+}
+
+static const char*
+shaderc_result_get_bytes_Stub
+(
+    const shaderc_compilation_result_t result
+)
+{
+    UNREFERENCED_PARAMETER(result);
+    return NULL;
+}
+
+static const char*
+shaderc_result_get_error_message_Stub
+(
+    const shaderc_compilation_result_t result
+)
+{
+    UNREFERENCED_PARAMETER(result);
+    return "";
+}
+
+static void
+shaderc_get_spv_version_Stub
+(
+    unsigned int *version,
+    unsigned int *revision
+)
+{
+    if (version ) *version  = 0;
+    if (revision) *revision = 0;
+}
+
+GPUCC_API(int)
+ShadercCompilerApiPopulateDispatch
+(
+    struct SHADERCCOMPILERAPI_DISPATCH *dispatch, 
+    uint32_t                        loader_flags
+)
+{
+    HMODULE shaderc_mod = NULL;
+
+    assert(dispatch != NULL);
+    UNREFERENCED_PARAMETER(loader_flags);
+
+    shaderc_mod = LoadLibraryW(L"shaderc_shared.dll");
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compiler_initialize);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compiler_release);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compile_options_initialize);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compile_options_clone);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compile_options_release);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compile_options_add_macro_definition);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compile_options_set_source_language);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compile_options_set_generate_debug_info);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compile_options_set_optimization_level);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compile_options_set_target_env);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compile_options_set_warnings_as_errors);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compile_options_set_include_callbacks);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_compile_into_spv);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_result_release);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_result_get_length);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_result_get_compilation_status);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_result_get_bytes);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_result_get_error_message);
+    RuntimeFunctionResolve(dispatch, shaderc_mod, shaderc_get_spv_version);
+    dispatch->ModuleHandle_shaderc = shaderc_mod;
+    return shaderc_mod != NULL;
+}
+
+GPUCC_API(int)
+ShadercCompilerApiQuerySupport
+(
+    struct SHADERCCOMPILERAPI_DISPATCH *dispatch
+)
+{
+    return dispatch->ModuleHandle_shaderc != NULL;
+}
+
+GPUCC_API(void)
+ShadercCompilerApiInvalidateDispatch
+(
+    struct SHADERCCOMPILERAPI_DISPATCH *dispatch
+)
+{
+    dispatch->shaderc_compiler_initialize                     = shaderc_compiler_initialize_Stub;
+    dispatch->shaderc_compiler_release                        = shaderc_compiler_release_Stub;
+    dispatch->shaderc_compile_options_initialize              = shaderc_compile_options_initialize_Stub;
+    dispatch->shaderc_compile_options_clone                   = shaderc_compile_options_clone_Stub;
+    dispatch->shaderc_compile_options_release                 = shaderc_compile_options_release_Stub;
+    dispatch->shaderc_compile_options_add_macro_definition    = shaderc_compile_options_add_macro_definition_Stub;
+    dispatch->shaderc_compile_options_set_source_language     = shaderc_compile_options_set_source_language_Stub;
+    dispatch->shaderc_compile_options_set_generate_debug_info = shaderc_compile_options_set_generate_debug_info_Stub;
+    dispatch->shaderc_compile_options_set_optimization_level  = shaderc_compile_options_set_optimization_level_Stub;
+    dispatch->shaderc_compile_options_set_target_env          = shaderc_compile_options_set_target_env_Stub;
+    dispatch->shaderc_compile_options_set_warnings_as_errors  = shaderc_compile_options_set_warnings_as_errors_Stub;
+    dispatch->shaderc_compile_options_set_include_callbacks   = shaderc_compile_options_set_include_callbacks_Stub;
+    dispatch->shaderc_compile_into_spv                        = shaderc_compile_into_spv_Stub;
+    dispatch->shaderc_result_release                          = shaderc_result_release_Stub;
+    dispatch->shaderc_result_get_length                       = shaderc_result_get_length_Stub;
+    dispatch->shaderc_result_get_compilation_status           = shaderc_result_get_compilation_status_Stub;
+    dispatch->shaderc_result_get_bytes                        = shaderc_result_get_bytes_Stub;
+    dispatch->shaderc_result_get_error_message                = shaderc_result_get_error_message_Stub;
+    dispatch->shaderc_get_spv_version                         = shaderc_get_spv_version_Stub;
+    if (dispatch->ModuleHandle_shaderc) {
+        FreeLibrary(dispatch->ModuleHandle_shaderc);
+        dispatch->ModuleHandle_shaderc = NULL;
+    }
+}
@@ -0,0 +1,199 @@
+/**
+ * @summary test_backend.h: Define a stand-in compiler backend shared by the
+ * tests, so that the library can be exercised on build nodes that have no
+ * real backend installed. Each test is a single translation unit, so the
+ * definitions are static.
+ */
+#ifndef __GPUCC_TEST_BACKEND_H__
+#define __GPUCC_TEST_BACKEND_H__
+
+#pragma once
+
+#include <stdio.h>
+#include <string.h>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_include.h"
+
+/* @summary Define the value stored in GPUCC_PROGRAM_COMPILER_BASE::BackendVersion by the stand-in backend.
+ */
+#ifndef GPUCC_TEST_BACKEND_VERSION
+#   define GPUCC_TEST_BACKEND_VERSION                                          0x0000504C41540000ULL
+#endif
+
+/* @summary Define the size of the output buffer held by each bytecode container of the stand-in backend.
+ */
+#ifndef GPUCC_TEST_OUTPUT_SIZE
+#   define GPUCC_TEST_OUTPUT_SIZE                                                256
+#endif
+
+/* @summary Check a condition, reporting the line and counting the failure if it does not hold.
+ */
+#define GPUCC_TEST_CHECK(_cond)                                                \
+    do {                                                                       \
+        if (!(_cond)) {                                                        \
+            fprintf(stderr, "%s(%d): check failed: %s\n", __FILE__, __LINE__, #_cond); \
+            g_FailureCount++;                                                  \
+        }                                                                      \
+    } while (0)
+
+/* @summary Define the compiler record of the stand-in backend.
+ */
+typedef struct GPUCC_COMPILER_TEST {
+    GPUCC_PROGRAM_COMPILER_BASE    CommonFields;                               /* The fields common to all compiler types. Must be the first field. */
+} GPUCC_COMPILER_TEST;
+
+/* @summary Define the bytecode container of the stand-in backend.
+ */
+typedef struct GPUCC_BYTECODE_TEST {
+    GPUCC_PROGRAM_BYTECODE_BASE    CommonFields;                               /* The fields common to all bytecode types. Must be the first field. */
+    char                           Output[GPUCC_TEST_OUTPUT_SIZE];             /* The bytecode produced by the most recent compile. */
+} GPUCC_BYTECODE_TEST;
+
+/* @summary The number of failed checks.
+ */
+static int g_FailureCount = 0;
+
+/* @summary Implement PFN_CreateBytecode for the stand-in backend.
+ */
+static struct GPUCC_PROGRAM_BYTECODE*
+gpuccCreateProgramBytecodeTest
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_BYTECODE_TEST *code = nullptr;
+
+    if ((code = (GPUCC_BYTECODE_TEST*) gpuccHostAlloc(gpuccQueryCompilerHostAllocator_(compiler), sizeof(GPUCC_BYTECODE_TEST), alignof(GPUCC_BYTECODE_TEST))) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    } memset(code, 0, sizeof(GPUCC_BYTECODE_TEST));
+
+    code->CommonFields.Compiler      = compiler;
+    code->CommonFields.CompileResult = gpuccMakeResult(GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER);
+    return (struct GPUCC_PROGRAM_BYTECODE*) code;
+}
+
+/* @summary Implement PFN_ResetBytecode for the stand-in backend.
+ */
+static void
+gpuccResetProgramBytecodeTest
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_BYTECODE_TEST *container_ =(GPUCC_BYTECODE_TEST*) bytecode;
+
+    container_->CommonFields.BytecodeSize   = 0;
+    container_->CommonFields.BytecodeBuffer = nullptr;
+    container_->CommonFields.LogBufferSize  = 0;
+    container_->CommonFields.LogBuffer      = nullptr;
+}
+
+/* @summary Implement PFN_DeleteBytecode for the stand-in backend.
+ */
+static void
+gpuccDeleteProgramBytecodeTest
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_BYTECODE_TEST    *container_ =(GPUCC_BYTECODE_TEST*) bytecode;
+    GPUCC_HOST_ALLOCATOR const  *alloc = gpuccQueryBytecodeHostAllocator_(bytecode);
+
+    gpuccResetProgramBytecodeTest(bytecode);
+    gpuccHostFree(alloc, container_->CommonFields.StringBuffer);
+    gpuccHostFree(alloc, container_);
+}
+
+/* @summary Implement PFN_CompileBytecode for the stand-in backend.
+ * The bytecode is the entry point, followed by the content of each file included through the include handler, followed by the source code.
+ * A source containing "error" fails with a log.
+ */
+static struct GPUCC_RESULT
+gpuccCompileBytecodeTest
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size,
+    char const                  *source_path,
+    char const                  *entry_point
+)
+{
+    static char       error_log[] = "test.glsl(1): error: stand-in failure";
+    GPUCC_BYTECODE_TEST *container_ =(GPUCC_BYTECODE_TEST*) container;
+    GPUCC_INCLUDE_LIST      includes = {};
+    size_t                        nb = 0;
+
+    if (strstr(source_code, "error") != nullptr) {
+        container_->CommonFields.LogBuffer     = error_log;
+        container_->CommonFields.LogBufferSize = sizeof(error_log);
+        return gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
+    }
+    if (gpuccCollectIncludes(container, source_code, source_size, source_path, &includes) == 0) {
+        gpuccReleaseIncludes(container, &includes);
+        return gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY);
+    }
+    nb = (size_t) snprintf(container_->Output, sizeof(container_->Output), "%s:", entry_point);
+    for (uint32_t i = 0; i < includes.Count && nb < sizeof(container_->Output); ++i) {
+        nb += (size_t) snprintf(container_->Output + nb, sizeof(container_->Output) - nb, "%s", includes.Contents[i]);
+    }
+    if (nb < sizeof(container_->Output)) {
+        nb += (size_t) snprintf(container_->Output + nb, sizeof(container_->Output) - nb, "%.*s", (int) source_size, source_code);
+    }
+    gpuccReleaseIncludes(container, &includes);
+    if (nb >= sizeof(container_->Output)) {
+        return gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
+    }
+    container_->CommonFields.BytecodeBuffer =(uint8_t*) container_->Output;
+    container_->CommonFields.BytecodeSize   =(uint64_t) nb + 1;
+    return gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+}
+
+/* @summary Implement PFN_CleanupCompiler for the stand-in backend, which holds no backend objects.
+ */
+static void
+gpuccCleanupCompilerTest
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    (void) compiler;
+}
+
+/* @summary Create a compiler that uses the stand-in backend, and run the setup gpuccCreateCompiler runs for a real backend through gpuccInitCompilerCommon.
+ * @param config The compiler configuration.
+ * @return The new compiler, or NULL if it could not be created.
+ */
+static struct GPUCC_PROGRAM_COMPILER*
+gpuccCreateCompilerTest
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT *config
+)
+{
+    GPUCC_COMPILER_TEST         *tc = nullptr;
+    struct GPUCC_PROGRAM_COMPILER *c = nullptr;
+    GPUCC_HOST_ALLOCATOR       alloc;
+
+    if (gpuccInitHostAllocator(&alloc, config->HostAllocator) == 0) {
+        return nullptr;
+    }
+    if ((tc = (GPUCC_COMPILER_TEST*) gpuccHostAlloc(&alloc, sizeof(GPUCC_COMPILER_TEST), alignof(GPUCC_COMPILER_TEST))) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    } memset(tc, 0, sizeof(GPUCC_COMPILER_TEST));
+
+    tc->CommonFields.CreateBytecode  = gpuccCreateProgramBytecodeTest;
+    tc->CommonFields.DeleteBytecode  = gpuccDeleteProgramBytecodeTest;
+    tc->CommonFields.ResetBytecode   = gpuccResetProgramBytecodeTest;
+    tc->CommonFields.CompileBytecode = gpuccCompileBytecodeTest;
+    tc->CommonFields.CleanupCompiler = gpuccCleanupCompilerTest;
+    tc->CommonFields.CompilerType    = GPUCC_COMPILER_TYPE_SHADERC;
+    tc->CommonFields.BytecodeType    = GPUCC_BYTECODE_TYPE_SPIRV;
+    tc->CommonFields.BackendVersion  = GPUCC_TEST_BACKEND_VERSION;
+    tc->CommonFields.HostAllocator   = alloc;
+    c = (struct GPUCC_PROGRAM_COMPILER*) tc;
+    return gpuccInitCompilerCommon(c, config);
+}
+
+#endif /* __GPUCC_TEST_BACKEND_H__ */
@@ -0,0 +1,494 @@
+/**
+ * @summary test_cache.cc: Exercises the persistent bytecode cache through the
+ * stand-in compiler backend, checking the cache key, that entries are reused
+ * and that damaged entries are not, and that an entry is only reused when
+ * every include request of the compilation that produced it resolves to the
+ * same file with the same content.
+ */
+#include <dirent.h>
+#include <ftw.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <string>
+
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_cache.h"
+#include "test_backend.h"
+
+/* @summary Implement the nftw callback used to delete the test directory.
+ */
+static int
+gpuccTestRemoveEntry
+(
+    char const        *path,
+    struct stat const   *sb,
+    int               flags,
+    struct FTW         *ftw
+)
+{
+    (void) sb;
+    (void) flags;
+    (void) ftw;
+    return remove(path);
+}
+
+/* @summary Write a file, replacing any existing file.
+ * @param path The path of the file to write.
+ * @param content The nul-terminated file content.
+ * @return Non-zero if the file was written.
+ */
+static int
+gpuccTestWriteFile
+(
+    std::string const &path,
+    char const     *content
+)
+{
+    FILE  *fp = nullptr;
+    size_t nb = strlen(content);
+    int    ok = 0;
+
+    if ((fp = fopen(path.c_str(), "wb")) != nullptr) {
+        ok = (fwrite(content, 1, nb, fp) == nb) ? 1 : 0;
+        ok = (fclose(fp) == 0) ? ok : 0;
+    }
+    return ok;
+}
+
+/* @summary Find the entry written to a cache directory.
+ * @param directory The cache directory.
+ * @param o_path On return, stores the path of the last entry found.
+ * @return The number of entries in the directory.
+ */
+static int32_t
+gpuccTestFindEntry
+(
+    std::string const &directory,
+    std::string          &o_path
+)
+{
+    DIR            *dir = nullptr;
+    struct dirent  *ent = nullptr;
+    int32_t       count = 0;
+
+    if ((dir = opendir(directory.c_str())) == nullptr) {
+        return 0;
+    }
+    while ((ent = readdir(dir)) != nullptr) {
+        size_t nb = strlen(ent->d_name);
+        if (nb > 6 && strcmp(ent->d_name + nb - 6, ".gpucc") == 0) {
+            o_path = directory + "/" + ent->d_name;
+            count++;
+        }
+    }
+    closedir(dir);
+    return count;
+}
+
+/* @summary Overwrite part of a file in place.
+ * @param path The path of the file to modify.
+ * @param offset The byte offset at which to write.
+ * @param data The bytes to write.
+ * @param size The number of bytes to write.
+ * @return Non-zero if the bytes were written.
+ */
+static int
+gpuccTestPatchFile
+(
+    std::string const &path,
+    long             offset,
+    void const        *data,
+    size_t             size
+)
+{
+    FILE  *fp = nullptr;
+    int    ok = 0;
+
+    if ((fp = fopen(path.c_str(), "r+b")) != nullptr) {
+        ok = (fseek(fp, offset, SEEK_SET) == 0 && fwrite(data, 1, size, fp) == size) ? 1 : 0;
+        ok = (fclose(fp) == 0) ? ok : 0;
+    }
+    return ok;
+}
+
+/* @summary Compile a source file through a compiler, and report whether the result came from the backend.
+ * @param compiler The compiler to use.
+ * @param source The nul-terminated source code.
+ * @param source_path The path reported as the path of the source file.
+ * @param o_output On return, stores the bytecode produced by the stand-in backend, or an empty string if the compile failed.
+ * @return Non-zero if the backend ran, or zero if the result came from the bytecode cache.
+ */
+static int32_t
+gpuccTestCompileFile
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler,
+    char const                      *source,
+    std::string const          &source_path,
+    std::string                   &o_output
+)
+{
+    struct GPUCC_PROGRAM_BYTECODE *container = gpuccCreateBytecodeContainer(compiler);
+    int32_t                           backend = 0;
+
+    o_output.clear();
+    GPUCC_TEST_CHECK(container != nullptr);
+    if (container == nullptr) {
+        return 0;
+    }
+    if (gpuccSuccess(gpuccCompileProgramBytecode(container, source, strlen(source), source_path.c_str(), "main"))) {
+        o_output.assign((char const*) gpuccQueryBytecodeBuffer(container));
+    }
+    backend = ((GPUCC_PROGRAM_BYTECODE_BASE*) container)->BackendInvoked;
+    gpuccDeleteBytecodeContainer(container);
+    return backend;
+}
+
+/* @summary Create a stand-in compiler whose includes are resolved through an include cache.
+ * @param includes The include cache.
+ * @return The compiler, or NULL if it could not be created.
+ */
+static struct GPUCC_PROGRAM_COMPILER*
+gpuccTestCreateIncludeCompiler
+(
+    struct GPUCC_INCLUDE_CACHE *includes
+)
+{
+    GPUCC_PROGRAM_COMPILER_INIT config = {};
+    GPUCC_INCLUDE_HANDLER      handler;
+
+    gpuccQueryIncludeCacheHandler(includes, &handler);
+    config.BytecodeType   = GPUCC_BYTECODE_TYPE_SPIRV;
+    config.TargetRuntime  = GPUCC_TARGET_RUNTIME_VULKAN_1_1;
+    config.TargetProfile  = "test";
+    config.IncludeHandler =&handler;
+    return gpuccCreateCompilerTest(&config);
+}
+
+/* @summary Check that identical source in two directories does not share an entry when each directory has its own copy of a quoted include.
+ * @param root The test directory.
+ */
+static void
+gpuccTestSourceDirectory
+(
+    std::string const &root
+)
+{
+    static char const       source[] = "#include \"common.h\"\n";
+    struct GPUCC_INCLUDE_CACHE *includes = gpuccCreateIncludeCache(nullptr, 0);
+    struct GPUCC_PROGRAM_COMPILER *compiler = nullptr;
+    std::string                    output;
+
+    GPUCC_TEST_CHECK(mkdir((root + "/a").c_str(), 0700) == 0);
+    GPUCC_TEST_CHECK(mkdir((root + "/b").c_str(), 0700) == 0);
+    GPUCC_TEST_CHECK(gpuccTestWriteFile(root + "/a/common.h", "AAA"));
+    GPUCC_TEST_CHECK(gpuccTestWriteFile(root + "/b/common.h", "BBB"));
+    if ((compiler = gpuccTestCreateIncludeCompiler(includes)) == nullptr) {
+        GPUCC_TEST_CHECK(compiler != nullptr);
+        gpuccDeleteIncludeCache(includes);
+        return;
+    }
+
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/a/s.glsl", output) != 0);
+    GPUCC_TEST_CHECK(output.compare(0, 8, "main:AAA") == 0);
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/b/s.glsl", output) != 0);
+    GPUCC_TEST_CHECK(output.compare(0, 8, "main:BBB") == 0);
+    /* Each directory now has an entry of its own. */
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/a/s.glsl", output) == 0);
+    GPUCC_TEST_CHECK(output.compare(0, 8, "main:AAA") == 0);
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/b/s.glsl", output) == 0);
+    GPUCC_TEST_CHECK(output.compare(0, 8, "main:BBB") == 0);
+
+    gpuccDeleteCompiler(compiler);
+    gpuccDeleteIncludeCache(includes);
+}
+
+/* @summary Check that an entry is not reused when the include handler would now resolve a recorded include to a different file, even though the file it recorded is unchanged.
+ * @param root The test directory.
+ */
+static void
+gpuccTestSearchPath
+(
+    std::string const &root
+)
+{
+    static char const             source[] = "#include <config.h>\n";
+    std::string                  path_one = root + "/one/";
+    std::string                  path_two = root + "/two/";
+    char const                *search_one[] = { path_one.c_str() };
+    char const                *search_two[] = { path_two.c_str(), path_one.c_str() };
+    struct GPUCC_INCLUDE_CACHE *includes_one = gpuccCreateIncludeCache(search_one, 1);
+    struct GPUCC_INCLUDE_CACHE *includes_two = gpuccCreateIncludeCache(search_two, 2);
+    struct GPUCC_PROGRAM_COMPILER *compiler_one = gpuccTestCreateIncludeCompiler(includes_one);
+    struct GPUCC_PROGRAM_COMPILER *compiler_two = gpuccTestCreateIncludeCompiler(includes_two);
+    std::string                    output;
+
+    GPUCC_TEST_CHECK(mkdir(path_one.c_str(), 0700) == 0);
+    GPUCC_TEST_CHECK(mkdir(path_two.c_str(), 0700) == 0);
+    GPUCC_TEST_CHECK(gpuccTestWriteFile(path_one + "config.h", "ONE"));
+    GPUCC_TEST_CHECK(gpuccTestWriteFile(path_two + "config.h", "TWO"));
+    GPUCC_TEST_CHECK(compiler_one != nullptr && compiler_two != nullptr);
+    if (compiler_one != nullptr && compiler_two != nullptr) {
+        GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler_one, source, root + "/s.glsl", output) != 0);
+        GPUCC_TEST_CHECK(output.compare(0, 8, "main:ONE") == 0);
+        GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler_two, source, root + "/s.glsl", output) != 0);
+        GPUCC_TEST_CHECK(output.compare(0, 8, "main:TWO") == 0);
+    }
+    gpuccDeleteCompiler(compiler_two);
+    gpuccDeleteCompiler(compiler_one);
+    gpuccDeleteIncludeCache(includes_two);
+    gpuccDeleteIncludeCache(includes_one);
+}
+
+/* @summary Compute the cache key of a compilation without compiling.
+ * @param compiler The compiler to use.
+ * @param source The nul-terminated source code.
+ * @param source_path The path of the source file.
+ * @param entry_point The program entry point.
+ * @return The cache key.
+ */
+static GPUCC_HASH128
+gpuccTestComputeKey
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler,
+    char const                      *source,
+    char const                 *source_path,
+    char const                 *entry_point
+)
+{
+    struct GPUCC_PROGRAM_BYTECODE *container = gpuccCreateBytecodeContainer(compiler);
+    GPUCC_PROGRAM_BYTECODE_BASE  *container_ =(GPUCC_PROGRAM_BYTECODE_BASE*) container;
+    GPUCC_HASH128                        key = {};
+
+    GPUCC_TEST_CHECK(container != nullptr);
+    if (container != nullptr) {
+        container_->EntryPoint =(char*) entry_point;
+        container_->SourcePath =(char*) source_path;
+        key = gpuccBytecodeCacheKey(container, source, strlen(source));
+        container_->EntryPoint = nullptr;
+        container_->SourcePath = nullptr;
+        gpuccDeleteBytecodeContainer(container);
+    }
+    return key;
+}
+
+/* @summary Check that the cache key covers the compiler configuration, entry point and source code, and covers the source path only when includes are resolved against it.
+ */
+static void
+gpuccTestKey
+(
+    void
+)
+{
+    GPUCC_PROGRAM_COMPILER_INIT config = {};
+    struct GPUCC_INCLUDE_CACHE *includes = gpuccCreateIncludeCache(nullptr, 0);
+    struct GPUCC_PROGRAM_COMPILER  *plain = nullptr;
+    struct GPUCC_PROGRAM_COMPILER  *other = nullptr;
+    struct GPUCC_PROGRAM_COMPILER   *incl = gpuccTestCreateIncludeCompiler(includes);
+    GPUCC_HASH128                    base;
+    GPUCC_HASH128                     key;
+
+    config.BytecodeType  = GPUCC_BYTECODE_TYPE_SPIRV;
+    config.TargetRuntime = GPUCC_TARGET_RUNTIME_VULKAN_1_1;
+    config.TargetProfile = "test";
+    plain = gpuccCreateCompilerTest(&config);
+    config.TargetProfile = "other";
+    other = gpuccCreateCompilerTest(&config);
+    GPUCC_TEST_CHECK(plain != nullptr && other != nullptr && incl != nullptr);
+    if (plain != nullptr && other != nullptr && incl != nullptr) {
+        base = gpuccTestComputeKey(plain, "void main() {}", "a/s.glsl", "main");
+        key  = gpuccTestComputeKey(plain, "void main() {}", "a/s.glsl", "main");
+        GPUCC_TEST_CHECK(key.Low == base.Low && key.High == base.High);
+        key  = gpuccTestComputeKey(plain, "void main() { }", "a/s.glsl", "main");
+        GPUCC_TEST_CHECK(key.Low != base.Low || key.High != base.High);
+        key  = gpuccTestComputeKey(plain, "void main() {}", "a/s.glsl", "other");
+        GPUCC_TEST_CHECK(key.Low != base.Low || key.High != base.High);
+        key  = gpuccTestComputeKey(other, "void main() {}", "a/s.glsl", "main");
+        GPUCC_TEST_CHECK(key.Low != base.Low || key.High != base.High);
+        /* Without an include handler the source path cannot change the output, so moving a file keeps its entry. */
+        key  = gpuccTestComputeKey(plain, "void main() {}", "b/s.glsl", "main");
+        GPUCC_TEST_CHECK(key.Low == base.Low && key.High == base.High);
+        base = gpuccTestComputeKey(incl , "void main() {}", "a/s.glsl", "main");
+        key  = gpuccTestComputeKey(incl , "void main() {}", "b/s.glsl", "main");
+        GPUCC_TEST_CHECK(key.Low != base.Low || key.High != base.High);
+    }
+    gpuccDeleteCompiler(incl);
+    gpuccDeleteCompiler(other);
+    gpuccDeleteCompiler(plain);
+    gpuccDeleteIncludeCache(includes);
+}
+
+/* @summary Check that a second identical compilation is served from the cache with the same output, and that changed source misses.
+ * @param root The test directory.
+ */
+static void
+gpuccTestHitMiss
+(
+    std::string const &root
+)
+{
+    GPUCC_PROGRAM_COMPILER_INIT    config = {};
+    struct GPUCC_PROGRAM_COMPILER *compiler = nullptr;
+    std::string                    output;
+
+    config.BytecodeType  = GPUCC_BYTECODE_TYPE_SPIRV;
+    config.TargetRuntime = GPUCC_TARGET_RUNTIME_VULKAN_1_1;
+    config.TargetProfile = "test";
+    if ((compiler = gpuccCreateCompilerTest(&config)) == nullptr) {
+        GPUCC_TEST_CHECK(compiler != nullptr);
+        return;
+    }
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, "void hit() {}", root + "/hit.glsl", output) != 0);
+    GPUCC_TEST_CHECK(output == "main:void hit() {}");
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, "void hit() {}", root + "/hit.glsl", output) == 0);
+    GPUCC_TEST_CHECK(output == "main:void hit() {}");
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, "void miss() {}", root + "/hit.glsl", output) != 0);
+    GPUCC_TEST_CHECK(output == "main:void miss() {}");
+    /* Failed compilations are not stored. */
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, "error", root + "/hit.glsl", output) != 0);
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, "error", root + "/hit.glsl", output) != 0);
+    gpuccDeleteCompiler(compiler);
+}
+
+/* @summary Check that an entry is not reused once the content of a file it included changes, and that the recompiled entry is reused afterwards.
+ * @param root The test directory.
+ */
+static void
+gpuccTestDependencyChange
+(
+    std::string const &root
+)
+{
+    static char const       source[] = "#include \"dep.h\"\n";
+    struct GPUCC_INCLUDE_CACHE *includes = gpuccCreateIncludeCache(nullptr, 0);
+    struct GPUCC_PROGRAM_COMPILER *compiler = nullptr;
+    std::string                    output;
+
+    GPUCC_TEST_CHECK(mkdir((root + "/dep").c_str(), 0700) == 0);
+    GPUCC_TEST_CHECK(gpuccTestWriteFile(root + "/dep/dep.h", "OLD"));
+    if ((compiler = gpuccTestCreateIncludeCompiler(includes)) == nullptr) {
+        GPUCC_TEST_CHECK(compiler != nullptr);
+        gpuccDeleteIncludeCache(includes);
+        return;
+    }
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/dep/s.glsl", output) != 0);
+    GPUCC_TEST_CHECK(output.compare(0, 8, "main:OLD") == 0);
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/dep/s.glsl", output) == 0);
+    GPUCC_TEST_CHECK(output.compare(0, 8, "main:OLD") == 0);
+    /* The new content has a different size, so the include cache cannot mistake it for the old content within one timestamp tick. */
+    GPUCC_TEST_CHECK(gpuccTestWriteFile(root + "/dep/dep.h", "NEWER"));
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/dep/s.glsl", output) != 0);
+    GPUCC_TEST_CHECK(output.compare(0, 10, "main:NEWER") == 0);
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/dep/s.glsl", output) == 0);
+    GPUCC_TEST_CHECK(output.compare(0, 10, "main:NEWER") == 0);
+
+    gpuccDeleteCompiler(compiler);
+    gpuccDeleteIncludeCache(includes);
+}
+
+/* @summary Check that a truncated or damaged entry is treated as a miss, and is replaced by the recompiled result.
+ * The test switches the process to a cache directory of its own, so that it can find the single entry written.
+ * @param root The test directory.
+ */
+static void
+gpuccTestCorruptEntry
+(
+    std::string const &root
+)
+{
+    static char const             source[] = "void corrupt() {}";
+    static uint32_t const      bad_magic = 0;
+    static uint32_t const    bad_version = GPUCC_BYTECODE_CACHE_VERSION + 1;
+    static uint64_t const   bad_bytecode = 1ULL << 40;
+    std::string                directory = root + "/corrupt";
+    std::string                    entry;
+    std::string                   output;
+    GPUCC_PROGRAM_COMPILER_INIT   config = {};
+    struct GPUCC_PROGRAM_COMPILER *compiler = nullptr;
+
+    GPUCC_TEST_CHECK(mkdir(directory.c_str(), 0700) == 0);
+    GPUCC_TEST_CHECK(gpuccSuccess(gpuccEnableBytecodeCache(directory.c_str())));
+    config.BytecodeType  = GPUCC_BYTECODE_TYPE_SPIRV;
+    config.TargetRuntime = GPUCC_TARGET_RUNTIME_VULKAN_1_1;
+    config.TargetProfile = "test";
+    if ((compiler = gpuccCreateCompilerTest(&config)) == nullptr) {
+        GPUCC_TEST_CHECK(compiler != nullptr);
+        return;
+    }
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/corrupt.glsl", output) != 0);
+    GPUCC_TEST_CHECK(gpuccTestFindEntry(directory, entry) == 1);
+
+    /* Each damaged entry misses, and the store that follows the miss repairs it. */
+    GPUCC_TEST_CHECK(truncate(entry.c_str(), sizeof(GPUCC_BYTECODE_CACHE_HEADER) + 4) == 0);
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/corrupt.glsl", output) != 0);
+    GPUCC_TEST_CHECK(output == "main:void corrupt() {}");
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/corrupt.glsl", output) == 0);
+    GPUCC_TEST_CHECK(output == "main:void corrupt() {}");
+
+    GPUCC_TEST_CHECK(truncate(entry.c_str(), sizeof(GPUCC_BYTECODE_CACHE_HEADER) / 2) == 0);
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/corrupt.glsl", output) != 0);
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/corrupt.glsl", output) == 0);
+
+    GPUCC_TEST_CHECK(gpuccTestPatchFile(entry, (long) offsetof(GPUCC_BYTECODE_CACHE_HEADER, Magic), &bad_magic, sizeof(bad_magic)));
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/corrupt.glsl", output) != 0);
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/corrupt.glsl", output) == 0);
+
+    GPUCC_TEST_CHECK(gpuccTestPatchFile(entry, (long) offsetof(GPUCC_BYTECODE_CACHE_HEADER, Version), &bad_version, sizeof(bad_version)));
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/corrupt.glsl", output) != 0);
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/corrupt.glsl", output) == 0);
+
+    /* A size larger than the file must fail the read rather than return short data. */
+    GPUCC_TEST_CHECK(gpuccTestPatchFile(entry, (long) offsetof(GPUCC_BYTECODE_CACHE_HEADER, BytecodeSize), &bad_bytecode, sizeof(bad_bytecode)));
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/corrupt.glsl", output) != 0);
+    GPUCC_TEST_CHECK(output == "main:void corrupt() {}");
+    GPUCC_TEST_CHECK(gpuccTestCompileFile(compiler, source, root + "/corrupt.glsl", output) == 0);
+    GPUCC_TEST_CHECK(output == "main:void corrupt() {}");
+    GPUCC_TEST_CHECK(gpuccTestFindEntry(directory, entry) == 1);
+
+    gpuccDeleteCompiler(compiler);
+}
+
+int main
+(
+    int    argc,
+    char **argv
+)
+{
+    char        root_buf[] = "/tmp/gpucc_test_cache.XXXXXX";
+    std::string root;
+
+    (void) argc;
+    (void) argv;
+
+    if (mkdtemp(root_buf) == nullptr) {
+        fprintf(stderr, "test_cache: Failed to create a temporary directory.\n");
+        return 1;
+    }
+    root.assign(root_buf);
+    if (gpuccFailure(gpuccStartup(GPUCC_USAGE_MODE_OFFLINE))) {
+        fprintf(stderr, "test_cache: gpuccStartup failed.\n");
+        rmdir(root_buf);
+        return 1;
+    }
+    GPUCC_TEST_CHECK(mkdir((root + "/cache").c_str(), 0700) == 0);
+    GPUCC_TEST_CHECK(gpuccSuccess(gpuccEnableBytecodeCache((root + "/cache").c_str())));
+    gpuccTestKey();
+    gpuccTestHitMiss(root);
+    gpuccTestDependencyChange(root);
+    gpuccTestSourceDirectory(root);
+    gpuccTestSearchPath(root);
+    gpuccTestCorruptEntry(root);
+    gpuccShutdown();
+    nftw(root_buf, gpuccTestRemoveEntry, 16, FTW_DEPTH | FTW_PHYS);
+
+    if (g_FailureCount != 0) {
+        fprintf(stderr, "test_cache: %d check(s) failed.\n", g_FailureCount);
+        return 1;
+    }
+    printf("test_cache: all checks passed.\n");
+    return 0;
+}
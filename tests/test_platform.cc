@@ -0,0 +1,192 @@
+/**
+ * @summary test_platform.cc: Exercises the Linux platform layer: the dlopen
+ * loader, the process and per-thread contexts, the UTF-8 string helpers, and
+ * a compile through a stand-in compiler backend, so that the layer can be
+ * checked on build nodes that have no real backend installed.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+#define   GPUCC_LOADER_IMPLEMENTATION
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "test_backend.h"
+
+/* @summary Check that the loader resolves the entry points of libgpucc.so through dlopen, and that unloading it restores the stubs.
+ */
+static void
+gpuccTestLoader
+(
+    void
+)
+{
+    GPUCC_LOADER_DISPATCH dispatch = {};
+    int32_t                  major = -1;
+    int32_t                  minor = -1;
+    int32_t                  patch = -1;
+    int32_t               major_ld = -2;
+    int32_t               minor_ld = -2;
+    int32_t               patch_ld = -2;
+
+    GPUCC_TEST_CHECK(gpuccLoaderPopulateDispatch(&dispatch) != 0);
+    GPUCC_TEST_CHECK(dispatch.ModuleHandle_GpuCC != NULL);
+    GPUCC_TEST_CHECK(dispatch.gpuccVersion  != gpuccVersion_Stub);
+    GPUCC_TEST_CHECK(dispatch.gpuccStartup  != gpuccStartup_Stub);
+    GPUCC_TEST_CHECK(dispatch.gpuccCreateCompiler != gpuccCreateCompiler_Stub);
+    GPUCC_TEST_CHECK(dispatch.gpuccRunWorkerProcess != gpuccRunWorkerProcess_Stub);
+    gpuccVersion(&major, &minor, &patch);
+    dispatch.gpuccVersion(&major_ld, &minor_ld, &patch_ld);
+    GPUCC_TEST_CHECK(major_ld == major && minor_ld == minor && patch_ld == patch);
+    GPUCC_TEST_CHECK(dispatch.gpuccSuccess(gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS)) != 0);
+    gpuccLoaderInvalidateDispatch(&dispatch);
+    GPUCC_TEST_CHECK(dispatch.ModuleHandle_GpuCC == NULL);
+    GPUCC_TEST_CHECK(dispatch.gpuccVersion == gpuccVersion_Stub);
+}
+
+/* @summary Check that each thread has its own thread context and last result, and that the context of a thread does not change between calls.
+ */
+static void
+gpuccTestThreadContext
+(
+    void
+)
+{
+    struct GPUCC_THREAD_CONTEXT *main_ctx = gpuccGetThreadContext();
+    struct GPUCC_THREAD_CONTEXT *other_ctx = nullptr;
+    struct GPUCC_THREAD_CONTEXT *other_again = nullptr;
+    GPUCC_RESULT                 other_result;
+
+    GPUCC_TEST_CHECK(main_ctx != nullptr);
+    GPUCC_TEST_CHECK(gpuccGetThreadContext() == main_ctx);
+    gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_TIMEOUT));
+
+    std::thread other([&] {
+        other_ctx    = gpuccGetThreadContext();
+        other_again  = gpuccGetThreadContext();
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_INVALID_ARGUMENT));
+        other_result = gpuccGetLastResult();
+    });
+    other.join();
+    GPUCC_TEST_CHECK(other_ctx != nullptr && other_ctx != main_ctx);
+    GPUCC_TEST_CHECK(other_again == other_ctx);
+    GPUCC_TEST_CHECK(other_result.LibraryResult == GPUCC_RESULT_CODE_INVALID_ARGUMENT);
+    GPUCC_TEST_CHECK(gpuccGetThreadContext() == main_ctx);
+    GPUCC_TEST_CHECK(gpuccGetLastResult().LibraryResult == GPUCC_RESULT_CODE_TIMEOUT);
+}
+
+/* @summary Check the byte and character counts reported by gpuccStringInfoUtf8, its rejection of malformed input, and the copy made by gpuccPutStringUtf8.
+ */
+static void
+gpuccTestUtf8
+(
+    void
+)
+{
+    GPUCC_STRING_INFO info;
+    uint8_t        buffer[32];
+    uint8_t          *dst = buffer;
+    char           *str_a = nullptr;
+    char           *str_b = nullptr;
+
+    GPUCC_TEST_CHECK(gpuccStringInfoUtf8(&info, "main") == 0);
+    GPUCC_TEST_CHECK(info.ByteCount == 5 && info.CharCount == 5);
+    /* U+00E9 (2 bytes), U+20AC (3 bytes) and U+1F600 (4 bytes). */
+    GPUCC_TEST_CHECK(gpuccStringInfoUtf8(&info, "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80") == 0);
+    GPUCC_TEST_CHECK(info.ByteCount == 10 && info.CharCount == 4);
+    GPUCC_TEST_CHECK(gpuccStringInfoUtf8(&info, nullptr) == 0);
+    GPUCC_TEST_CHECK(info.ByteCount == 1 && info.CharCount == 1);
+    /* A truncated sequence, an overlong encoding and a UTF-16 surrogate. */
+    GPUCC_TEST_CHECK(gpuccStringInfoUtf8(&info, "a\xC3") != 0);
+    GPUCC_TEST_CHECK(gpuccStringInfoUtf8(&info, "\xC0\xAF") != 0);
+    GPUCC_TEST_CHECK(gpuccStringInfoUtf8(&info, "\xED\xA0\x80") != 0);
+
+    str_a = gpuccPutStringUtf8(dst, "entry");
+    str_b = gpuccPutStringUtf8(dst, nullptr);
+    GPUCC_TEST_CHECK(str_a == (char*) buffer && strcmp(str_a, "entry") == 0);
+    GPUCC_TEST_CHECK(str_b == (char*) buffer + 6 && str_b[0] == 0);
+    GPUCC_TEST_CHECK(dst == buffer + 7);
+}
+
+/* @summary Check that a program compiles through the stand-in backend, and that a failed compile returns its log.
+ */
+static void
+gpuccTestCompile
+(
+    void
+)
+{
+    GPUCC_PROGRAM_COMPILER_INIT     config = {};
+    struct GPUCC_PROGRAM_COMPILER *compiler = nullptr;
+    struct GPUCC_PROGRAM_BYTECODE *container = nullptr;
+    char const                        *code = nullptr;
+    char const                         *log = nullptr;
+    GPUCC_RESULT                      result;
+
+    config.BytecodeType  = GPUCC_BYTECODE_TYPE_SPIRV;
+    config.TargetRuntime = GPUCC_TARGET_RUNTIME_VULKAN_1_1;
+    config.TargetProfile = "test";
+    compiler  = gpuccCreateCompilerTest(&config);
+    container = (compiler != nullptr) ? gpuccCreateBytecodeContainer(compiler) : nullptr;
+    GPUCC_TEST_CHECK(container != nullptr);
+    if (container == nullptr) {
+        gpuccDeleteCompiler(compiler);
+        return;
+    }
+    GPUCC_TEST_CHECK(gpuccQueryCompilerType(compiler) == GPUCC_COMPILER_TYPE_SHADERC);
+    GPUCC_TEST_CHECK(gpuccQueryBytecodeType(compiler) == GPUCC_BYTECODE_TYPE_SPIRV);
+
+    result = gpuccCompileProgramBytecode(container, "void main() {}", 14, "test.glsl", "main");
+    GPUCC_TEST_CHECK(gpuccSuccess(result));
+    code   = (char const*) gpuccQueryBytecodeBuffer(container);
+    GPUCC_TEST_CHECK(code != nullptr && strcmp(code, "main:void main() {}") == 0);
+    GPUCC_TEST_CHECK(gpuccQueryBytecodeSizeBytes(container) == 20);
+    GPUCC_TEST_CHECK(strcmp(gpuccQueryBytecodeEntryPoint(container), "main") == 0);
+    GPUCC_TEST_CHECK(strcmp(gpuccQueryBytecodeSourcePath(container), "test.glsl") == 0);
+
+    gpuccResetBytecodeContainer(container);
+    result = gpuccCompileProgramBytecode(container, "error", 5, "test.glsl", "main");
+    GPUCC_TEST_CHECK(result.LibraryResult == GPUCC_RESULT_CODE_COMPILE_FAILED);
+    GPUCC_TEST_CHECK(gpuccQueryBytecodeCompileResult(container).LibraryResult == GPUCC_RESULT_CODE_COMPILE_FAILED);
+    log    = gpuccQueryBytecodeLogBuffer(container);
+    GPUCC_TEST_CHECK(log != nullptr && strstr(log, "stand-in failure") != nullptr);
+
+    gpuccDeleteBytecodeContainer(container);
+    gpuccDeleteCompiler(compiler);
+}
+
+int main
+(
+    int    argc,
+    char **argv
+)
+{
+    GPUCC_PROCESS_CONTEXT_PLATFORM *pctx = gpuccGetProcessContext_();
+
+    (void) argc;
+    (void) argv;
+
+    /* The shared object constructor initializes the process context before main runs. */
+    GPUCC_TEST_CHECK(pctx != nullptr && pctx->InitializationFlag != 0);
+    GPUCC_TEST_CHECK(pctx->StartupFlag == 0);
+    gpuccTestLoader();
+    gpuccTestThreadContext();
+    gpuccTestUtf8();
+
+    if (gpuccFailure(gpuccStartup(GPUCC_USAGE_MODE_OFFLINE))) {
+        fprintf(stderr, "test_platform: gpuccStartup failed.\n");
+        return 1;
+    }
+    GPUCC_TEST_CHECK(pctx->StartupFlag != 0);
+    gpuccTestCompile();
+    gpuccShutdown();
+    GPUCC_TEST_CHECK(pctx->StartupFlag == 0);
+
+    if (g_FailureCount != 0) {
+        fprintf(stderr, "test_platform: %d check(s) failed.\n", g_FailureCount);
+        return 1;
+    }
+    printf("test_platform: all checks passed.\n");
+    return 0;
+}
@@ -0,0 +1,308 @@
+/**
+ * @summary test_publish.cc: Exercises published programs and tiered
+ * compilation through the stand-in compiler backend.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_async.h"
+#include "gpucc_tiered.h"
+#include "test_backend.h"
+
+/* @summary Define the number of milliseconds a drain may take before the test is considered hung.
+ */
+#ifndef GPUCC_TEST_DRAIN_TIMEOUT_MS
+#   define GPUCC_TEST_DRAIN_TIMEOUT_MS                                       10000
+#endif
+
+/* @summary Wait for every optimized compile queued or running on a tiered compiler to finish, without discarding any.
+ * @param tiered The tiered compiler.
+ * @return Non-zero if the compiles finished within GPUCC_TEST_DRAIN_TIMEOUT_MS.
+ */
+static int32_t
+gpuccTestWaitTieredIdle
+(
+    GPUCC_TIERED_COMPILER *tiered
+)
+{
+    std::unique_lock<std::mutex> lock(tiered->Lock);
+    return tiered->IdleSignal.wait_for(lock, std::chrono::milliseconds(GPUCC_TEST_DRAIN_TIMEOUT_MS), [tiered] { return tiered->OutstandingCount == 0; }) ? 1 : 0;
+}
+
+/* @summary Wait for the worker that ran a budgeted job to charge its CPU time, which happens after the job has completed.
+ * @param pool The compile pool.
+ * @return Non-zero if the budget of the current tick was exhausted within GPUCC_TEST_DRAIN_TIMEOUT_MS.
+ */
+static int32_t
+gpuccTestWaitBudgetExhausted
+(
+    GPUCC_COMPILE_POOL *pool
+)
+{
+    for (uint32_t i = 0; i < GPUCC_TEST_DRAIN_TIMEOUT_MS; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(pool->QueueLock);
+            if (pool->BudgetRemaining <= 0) {
+                return 1;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return 0;
+}
+
+/* @summary Count the blocks allocated through a counting host allocator that have not been freed.
+ */
+static std::atomic<int64_t> g_LiveAllocations(0);
+
+/* @summary Implement PFN_GpuCC_HostAllocate for the counting host allocator.
+ */
+static void*
+gpuccTestCountingAllocate
+(
+    void *user_data,
+    size_t     size,
+    size_t alignment
+)
+{
+    void *p = nullptr;
+    (void) user_data;
+    (void) alignment;
+    if ((p = malloc(size)) != nullptr) {
+        g_LiveAllocations.fetch_add(1);
+    }
+    return p;
+}
+
+/* @summary Implement PFN_GpuCC_HostReallocate for the counting host allocator.
+ */
+static void*
+gpuccTestCountingReallocate
+(
+    void *user_data,
+    void   *address,
+    size_t     size,
+    size_t alignment
+)
+{
+    void *p = nullptr;
+    (void) user_data;
+    (void) alignment;
+    if ((p = realloc(address, size)) != nullptr && address == nullptr) {
+        g_LiveAllocations.fetch_add(1);
+    }
+    return p;
+}
+
+/* @summary Implement PFN_GpuCC_HostFree for the counting host allocator.
+ */
+static void
+gpuccTestCountingFree
+(
+    void *user_data,
+    void   *address
+)
+{
+    (void) user_data;
+    if (address != nullptr) {
+        g_LiveAllocations.fetch_sub(1);
+        free(address);
+    }
+}
+
+/* @summary Check that publishing swaps the container seen by new readers, that a replaced container stays valid while a reader on any thread holds it, and that it is freed once the last such reader releases it.
+ */
+static void
+gpuccTestPublishSwapAndReclaim
+(
+    void
+)
+{
+    GPUCC_HOST_ALLOCATOR            counting = { gpuccTestCountingAllocate, gpuccTestCountingReallocate, gpuccTestCountingFree, nullptr };
+    GPUCC_PROGRAM_COMPILER_INIT       config = {};
+    struct GPUCC_PROGRAM_COMPILER  *compiler = nullptr;
+    struct GPUCC_PUBLISHED_PROGRAM  *program = nullptr;
+    struct GPUCC_PROGRAM_BYTECODE      *one = nullptr;
+    struct GPUCC_PROGRAM_BYTECODE      *two = nullptr;
+    struct GPUCC_PROGRAM_BYTECODE    *three = nullptr;
+    struct GPUCC_PROGRAM_BYTECODE   *reader = nullptr;
+    int64_t                            live = 0;
+    int64_t                      per_bytecode = 0;
+    std::mutex                         lock;
+    std::condition_variable          signal;
+    int32_t                           stage = 0;
+
+    config.BytecodeType  = GPUCC_BYTECODE_TYPE_SPIRV;
+    config.TargetRuntime = GPUCC_TARGET_RUNTIME_VULKAN_1_1;
+    config.TargetProfile = "test";
+    config.HostAllocator =&counting;
+    if ((compiler = gpuccCreateCompilerTest(&config)) == nullptr) {
+        GPUCC_TEST_CHECK(compiler != nullptr);
+        return;
+    }
+    live  = g_LiveAllocations.load();
+    one   = gpuccCreateBytecodeContainer(compiler);
+    per_bytecode = g_LiveAllocations.load() - live;
+    two   = gpuccCreateBytecodeContainer(compiler);
+    three = gpuccCreateBytecodeContainer(compiler);
+    GPUCC_TEST_CHECK(one != nullptr && two != nullptr && three != nullptr && per_bytecode > 0);
+    if ((program = gpuccCreatePublishedProgram(one)) == nullptr) {
+        GPUCC_TEST_CHECK(program != nullptr);
+        gpuccDeleteBytecodeContainer(three);
+        gpuccDeleteBytecodeContainer(two);
+        gpuccDeleteBytecodeContainer(one);
+        gpuccDeleteCompiler(compiler);
+        return;
+    }
+
+    /* A container replaced while this thread reads it survives until the outermost release. */
+    live = g_LiveAllocations.load();
+    GPUCC_TEST_CHECK(gpuccAcquirePublishedProgram(program) == one);
+    GPUCC_TEST_CHECK(gpuccSuccess(gpuccPublishProgramBytecode(program, two)));
+    GPUCC_TEST_CHECK(g_LiveAllocations.load() == live);
+    GPUCC_TEST_CHECK(gpuccAcquirePublishedProgram(program) == two);
+    gpuccReleasePublishedProgram(program);
+    GPUCC_TEST_CHECK(g_LiveAllocations.load() == live);
+    gpuccReleasePublishedProgram(program);
+    GPUCC_TEST_CHECK(g_LiveAllocations.load() == live - per_bytecode);
+
+    /* The same holds for a reader on another thread, whose release frees the container. */
+    live = g_LiveAllocations.load();
+    std::thread other([&] {
+        std::unique_lock<std::mutex> guard(lock);
+        reader = gpuccAcquirePublishedProgram(program);
+        stage  = 1;
+        signal.notify_all();
+        signal.wait(guard, [&] { return stage == 2; });
+        gpuccReleasePublishedProgram(program);
+    });
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        signal.wait(guard, [&] { return stage == 1; });
+    }
+    GPUCC_TEST_CHECK(reader == two);
+    GPUCC_TEST_CHECK(gpuccSuccess(gpuccPublishProgramBytecode(program, three)));
+    GPUCC_TEST_CHECK(gpuccAcquirePublishedProgram(program) == three);
+    gpuccReleasePublishedProgram(program);
+    GPUCC_TEST_CHECK(g_LiveAllocations.load() == live);
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stage = 2;
+    }
+    signal.notify_all();
+    other.join();
+    GPUCC_TEST_CHECK(g_LiveAllocations.load() == live - per_bytecode);
+
+    /* Deleting the program frees the current container. */
+    live = g_LiveAllocations.load();
+    gpuccDeletePublishedProgram(program);
+    GPUCC_TEST_CHECK(g_LiveAllocations.load() == live - per_bytecode);
+    gpuccDeleteCompiler(compiler);
+}
+
+/* @summary Check that draining a tiered compiler discards a queued optimized compile even when the background class is out of budget, rather than waiting for a scheduler tick.
+ */
+static void
+gpuccTestTieredDrainOutOfBudget
+(
+    void
+)
+{
+    static char const                 source[] = "void main() {}";
+    GPUCC_COMPILE_POOL                  *pool = gpuccGetProcessContext_()->CompilePool;
+    GPUCC_PROGRAM_COMPILER_INIT        config = {};
+    GPUCC_COMPILE_SCHEDULER_CONFIG  scheduler = {};
+    GPUCC_TIERED_COMPILER             *tiered = nullptr;
+    struct GPUCC_PUBLISHED_PROGRAM   *program = nullptr;
+    struct GPUCC_PROGRAM_BYTECODE    *current = nullptr;
+    std::mutex                     done_lock;
+    std::condition_variable      done_signal;
+    bool                                 done = false;
+
+    config.BytecodeType  = GPUCC_BYTECODE_TYPE_SPIRV;
+    config.TargetRuntime = GPUCC_TARGET_RUNTIME_VULKAN_1_1;
+    config.TargetProfile = "test";
+    if ((tiered = gpuccInitTieredCompiler(gpuccCreateCompilerTest(&config), gpuccCreateCompilerTest(&config))) == nullptr) {
+        GPUCC_TEST_CHECK(tiered != nullptr);
+        return;
+    }
+    GPUCC_TEST_CHECK(tiered->FastCompiler != nullptr && tiered->OptimizedCompiler != nullptr);
+    if ((program = gpuccCreatePublishedProgram(nullptr)) == nullptr) {
+        GPUCC_TEST_CHECK(program != nullptr);
+        gpuccDeleteTieredCompiler(tiered);
+        return;
+    }
+
+    /* A budget of one nanosecond lets one background job start, and that job exhausts it until the next tick, which never comes. */
+    scheduler.TickBudgetNanoseconds = 1;
+    scheduler.BudgetedPriority      = GPUCC_COMPILE_PRIORITY_BACKGROUND;
+    scheduler.WorkerThreadPriority  = GPUCC_WORKER_THREAD_PRIORITY_NORMAL;
+    GPUCC_TEST_CHECK(gpuccSuccess(gpuccConfigureCompileScheduler(&scheduler)));
+    GPUCC_TEST_CHECK(gpuccSuccess(gpuccCompileProgramTiered(tiered, program, source, sizeof(source) - 1, "test.glsl", "main", nullptr)));
+    GPUCC_TEST_CHECK(gpuccTestWaitTieredIdle(tiered) != 0);
+    GPUCC_TEST_CHECK(gpuccTestWaitBudgetExhausted(pool) != 0);
+
+    /* The second optimized compile stays queued. */
+    GPUCC_TEST_CHECK(gpuccSuccess(gpuccCompileProgramTiered(tiered, program, source, sizeof(source) - 1, "test.glsl", "main", nullptr)));
+    GPUCC_TEST_CHECK(gpuccQueryCompileQueueDepth(GPUCC_COMPILE_PRIORITY_BACKGROUND) == 1);
+
+    std::thread watchdog([&] {
+        std::unique_lock<std::mutex> lock(done_lock);
+        if (done_signal.wait_for(lock, std::chrono::milliseconds(GPUCC_TEST_DRAIN_TIMEOUT_MS), [&] { return done; }) == false) {
+            fprintf(stderr, "test_publish: gpuccDrainTieredCompiler did not return with the background class out of budget.\n");
+            _exit(1);
+        }
+    });
+    gpuccDrainTieredCompiler(tiered);
+    {
+        std::lock_guard<std::mutex> lock(done_lock);
+        done = true;
+    }
+    done_signal.notify_all();
+    watchdog.join();
+
+    /* The discarded compile did not replace the unoptimized build. */
+    GPUCC_TEST_CHECK(gpuccQueryCompileQueueDepth(GPUCC_COMPILE_PRIORITY_BACKGROUND) == 0);
+    current = gpuccAcquirePublishedProgram(program);
+    GPUCC_TEST_CHECK(current != nullptr && gpuccQueryBytecodeCompiler_(current) == tiered->FastCompiler);
+    gpuccReleasePublishedProgram(program);
+
+    scheduler.TickBudgetNanoseconds = 0;
+    GPUCC_TEST_CHECK(gpuccSuccess(gpuccConfigureCompileScheduler(&scheduler)));
+    gpuccDeletePublishedProgram(program);
+    gpuccDeleteTieredCompiler(tiered);
+}
+
+int main
+(
+    int    argc,
+    char **argv
+)
+{
+    (void) argc;
+    (void) argv;
+
+    if (gpuccFailure(gpuccStartup(GPUCC_USAGE_MODE_OFFLINE))) {
+        fprintf(stderr, "test_publish: gpuccStartup failed.\n");
+        return 1;
+    }
+    gpuccTestPublishSwapAndReclaim();
+    gpuccTestTieredDrainOutOfBudget();
+    gpuccShutdown();
+
+    if (g_FailureCount != 0) {
+        fprintf(stderr, "test_publish: %d check(s) failed.\n", g_FailureCount);
+        return 1;
+    }
+    printf("test_publish: all checks passed.\n");
+    return 0;
+}
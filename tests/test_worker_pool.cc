@@ -0,0 +1,392 @@
+/**
+ * @summary test_worker_pool.cc: Exercises worker process pools with a stand-in
+ * compiler backend whose behavior is selected by the source code, so that
+ * crashing, hanging and include forwarding can be triggered on demand. The
+ * test executable is its own worker host: it registers the stand-in with
+ * gpuccSetWorkerCompilerFactory and calls gpuccRunWorkerProcess on entry.
+ *
+ * Each successful compile returns the process ID of the worker that ran it,
+ * which lets the test observe when a worker is replaced.
+ */
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "gpucc.h"
+#include "gpucc_internal.h"
+#include "gpucc_worker.h"
+
+/* @summary Define the value stored in GPUCC_PROGRAM_COMPILER_BASE::BackendVersion by the stand-in backend.
+ */
+#ifndef GPUCC_TEST_BACKEND_VERSION
+#   define GPUCC_TEST_BACKEND_VERSION                                          0x0000544553540000ULL
+#endif
+
+/* @summary Define the size of the output buffer held by each bytecode container of the stand-in backend.
+ */
+#ifndef GPUCC_TEST_OUTPUT_SIZE
+#   define GPUCC_TEST_OUTPUT_SIZE                                                256
+#endif
+
+/* @summary Check a condition, reporting the line and counting the failure if it does not hold.
+ */
+#define GPUCC_TEST_CHECK(_cond)                                                \
+    do {                                                                       \
+        if (!(_cond)) {                                                        \
+            fprintf(stderr, "%s(%d): check failed: %s\n", __FILE__, __LINE__, #_cond); \
+            g_FailureCount++;                                                  \
+        }                                                                      \
+    } while (0)
+
+/* @summary Define the compiler record of the stand-in backend.
+ */
+typedef struct GPUCC_COMPILER_TEST {
+    GPUCC_PROGRAM_COMPILER_BASE    CommonFields;                               /* The fields common to all compiler types. Must be the first field. */
+} GPUCC_COMPILER_TEST;
+
+/* @summary Define the bytecode container of the stand-in backend.
+ */
+typedef struct GPUCC_BYTECODE_TEST {
+    GPUCC_PROGRAM_BYTECODE_BASE    CommonFields;                               /* The fields common to all bytecode types. Must be the first field. */
+    char                           Output[GPUCC_TEST_OUTPUT_SIZE];             /* The bytecode produced by the most recent compile. */
+} GPUCC_BYTECODE_TEST;
+
+/* @summary The number of failed checks.
+ */
+static int g_FailureCount = 0;
+
+/* @summary Implement PFN_CreateBytecode for the stand-in backend.
+ */
+static struct GPUCC_PROGRAM_BYTECODE*
+gpuccCreateProgramBytecodeTest
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    GPUCC_BYTECODE_TEST *code = nullptr;
+
+    if ((code = (GPUCC_BYTECODE_TEST*) gpuccHostAlloc(gpuccQueryCompilerHostAllocator_(compiler), sizeof(GPUCC_BYTECODE_TEST), alignof(GPUCC_BYTECODE_TEST))) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    } memset(code, 0, sizeof(GPUCC_BYTECODE_TEST));
+
+    code->CommonFields.Compiler      = compiler;
+    code->CommonFields.CompileResult = gpuccMakeResult(GPUCC_RESULT_CODE_EMPTY_BYTECODE_CONTAINER);
+    return (struct GPUCC_PROGRAM_BYTECODE*) code;
+}
+
+/* @summary Implement PFN_ResetBytecode for the stand-in backend.
+ */
+static void
+gpuccResetProgramBytecodeTest
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_BYTECODE_TEST *container_ =(GPUCC_BYTECODE_TEST*) bytecode;
+
+    container_->CommonFields.BytecodeSize   = 0;
+    container_->CommonFields.BytecodeBuffer = nullptr;
+    container_->CommonFields.LogBufferSize  = 0;
+    container_->CommonFields.LogBuffer      = nullptr;
+}
+
+/* @summary Implement PFN_DeleteBytecode for the stand-in backend.
+ */
+static void
+gpuccDeleteProgramBytecodeTest
+(
+    struct GPUCC_PROGRAM_BYTECODE *bytecode
+)
+{
+    GPUCC_BYTECODE_TEST    *container_ =(GPUCC_BYTECODE_TEST*) bytecode;
+    GPUCC_HOST_ALLOCATOR const  *alloc = gpuccQueryBytecodeHostAllocator_(bytecode);
+
+    gpuccResetProgramBytecodeTest(bytecode);
+    gpuccHostFree(alloc, container_->CommonFields.StringBuffer);
+    gpuccHostFree(alloc, container_);
+}
+
+/* @summary Implement PFN_CompileBytecode for the stand-in backend.
+ * A source containing "crash" kills the process, one containing "hang" never returns, and one containing "include" resolves common.h through the include handler.
+ * Otherwise the bytecode is "pid=<process ID>", followed by the content of common.h if it was included.
+ */
+static struct GPUCC_RESULT
+gpuccCompileBytecodeTest
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                  *source_code,
+    uint64_t                     source_size,
+    char const                  *source_path,
+    char const                  *entry_point
+)
+{
+    GPUCC_BYTECODE_TEST *container_ =(GPUCC_BYTECODE_TEST*) container;
+    GPUCC_INCLUDE_RESULT         inc;
+    int                           nb = 0;
+
+    (void) source_size;
+    (void) entry_point;
+    if (strstr(source_code, "crash") != nullptr) {
+        raise(SIGSEGV);
+    }
+    if (strstr(source_code, "hang") != nullptr) {
+        for ( ; ; ) {
+            pause();
+        }
+    }
+    nb = snprintf(container_->Output, sizeof(container_->Output), "pid=%d", (int) getpid());
+    if (strstr(source_code, "include") != nullptr) {
+        if (gpuccOpenInclude(container, "common.h", source_path, GPUCC_INCLUDE_TYPE_LOCAL, &inc) == 0) {
+            return gpuccMakeResult(GPUCC_RESULT_CODE_COMPILE_FAILED);
+        }
+        nb += snprintf(container_->Output + nb, sizeof(container_->Output) - nb, " %.*s", (int) inc.ContentSize, inc.Content);
+        gpuccCloseInclude(container, &inc);
+    }
+    container_->CommonFields.BytecodeBuffer =(uint8_t*) container_->Output;
+    container_->CommonFields.BytecodeSize   =(uint64_t) nb + 1;
+    return gpuccMakeResult(GPUCC_RESULT_CODE_SUCCESS);
+}
+
+/* @summary Implement PFN_CleanupCompiler for the stand-in backend, which holds no backend objects.
+ */
+static void
+gpuccCleanupCompilerTest
+(
+    struct GPUCC_PROGRAM_COMPILER *compiler
+)
+{
+    (void) compiler;
+}
+
+/* @summary Create a compiler that uses the stand-in backend, and run the setup gpuccCreateCompiler runs for a real backend through gpuccInitCompilerCommon.
+ * This function is also registered with gpuccSetWorkerCompilerFactory, so that the workers create the same backend.
+ * @param config The compiler configuration.
+ * @return The new compiler, or NULL if it could not be created.
+ */
+static struct GPUCC_PROGRAM_COMPILER*
+gpuccCreateCompilerTest
+(
+    struct GPUCC_PROGRAM_COMPILER_INIT *config
+)
+{
+    GPUCC_COMPILER_TEST         *tc = nullptr;
+    struct GPUCC_PROGRAM_COMPILER *c = nullptr;
+    GPUCC_HOST_ALLOCATOR       alloc;
+
+    if (gpuccInitHostAllocator(&alloc, config->HostAllocator) == 0) {
+        return nullptr;
+    }
+    if ((tc = (GPUCC_COMPILER_TEST*) gpuccHostAlloc(&alloc, sizeof(GPUCC_COMPILER_TEST), alignof(GPUCC_COMPILER_TEST))) == nullptr) {
+        gpuccSetLastResult(gpuccMakeResult(GPUCC_RESULT_CODE_OUT_OF_HOST_MEMORY));
+        return nullptr;
+    } memset(tc, 0, sizeof(GPUCC_COMPILER_TEST));
+
+    tc->CommonFields.CreateBytecode  = gpuccCreateProgramBytecodeTest;
+    tc->CommonFields.DeleteBytecode  = gpuccDeleteProgramBytecodeTest;
+    tc->CommonFields.ResetBytecode   = gpuccResetProgramBytecodeTest;
+    tc->CommonFields.CompileBytecode = gpuccCompileBytecodeTest;
+    tc->CommonFields.CleanupCompiler = gpuccCleanupCompilerTest;
+    tc->CommonFields.CompilerType    = GPUCC_COMPILER_TYPE_SHADERC;
+    tc->CommonFields.BytecodeType    = GPUCC_BYTECODE_TYPE_SPIRV;
+    tc->CommonFields.BackendVersion  = GPUCC_TEST_BACKEND_VERSION;
+    tc->CommonFields.HostAllocator   = alloc;
+    c = (struct GPUCC_PROGRAM_COMPILER*) tc;
+    return gpuccInitCompilerCommon(c, config);
+}
+
+/* @summary Implement PFN_GpuCC_ResolveInclude in the application, serving a single in-memory header.
+ */
+static int32_t
+gpuccTestResolveInclude
+(
+    void                  *user_data,
+    char const         *include_path,
+    char const      *requesting_path,
+    int32_t             include_type,
+    GPUCC_INCLUDE_RESULT   *o_result
+)
+{
+    static char const content[] = "COMMON";
+
+    (void) user_data;
+    (void) requesting_path;
+    (void) include_type;
+    if (strcmp(include_path, "common.h") != 0) {
+        return 0;
+    }
+    o_result->ResolvedPath = "common.h";
+    o_result->Content      = content;
+    o_result->ContentSize  = sizeof(content) - 1;
+    o_result->Context      = nullptr;
+    return 1;
+}
+
+/* @summary Implement PFN_GpuCC_ReleaseInclude in the application. The header is static, so there is nothing to release.
+ */
+static void
+gpuccTestReleaseInclude
+(
+    void                  *user_data,
+    GPUCC_INCLUDE_RESULT     *result
+)
+{
+    (void) user_data;
+    (void) result;
+}
+
+/* @summary Reset a container, compile a source string into it synchronously and return the process ID of the worker that compiled it.
+ * @param container The bytecode container.
+ * @param source The nul-terminated source code.
+ * @param o_result On return, the compile result.
+ * @return The worker process ID, or zero if the compile failed.
+ */
+static int
+gpuccTestCompile
+(
+    struct GPUCC_PROGRAM_BYTECODE *container,
+    char const                     *source,
+    GPUCC_RESULT                 *o_result
+)
+{
+    char const *code = nullptr;
+    int          pid = 0;
+
+    gpuccResetBytecodeContainer(container);
+    *o_result = gpuccCompileProgramBytecode(container, source, strlen(source), "test.glsl", "main");
+    if (gpuccFailure(*o_result) || (code = (char const*) gpuccQueryBytecodeBuffer(container)) == nullptr) {
+        return 0;
+    }
+    if (sscanf(code, "pid=%d", &pid) != 1) {
+        return 0;
+    }
+    return pid;
+}
+
+int main
+(
+    int    argc,
+    char **argv
+)
+{
+    GPUCC_WORKER_PROCESS_POOL_INIT  pool_init = {};
+    GPUCC_PROGRAM_COMPILER_INIT      compiler_init = {};
+    GPUCC_INCLUDE_HANDLER                 handler = {};
+    struct GPUCC_WORKER_PROCESS_POOL        *pool = nullptr;
+    struct GPUCC_PROGRAM_COMPILER       *compiler = nullptr;
+    struct GPUCC_PROGRAM_COMPILER        *retiring = nullptr;
+    struct GPUCC_PROGRAM_BYTECODE       *container = nullptr;
+    struct GPUCC_PROGRAM_BYTECODE         *retired = nullptr;
+    struct GPUCC_COMPILE_JOB                  *job = nullptr;
+    char const                                *log = nullptr;
+    int                                       pid0 = 0;
+    int                                       pid1 = 0;
+    int                                       pid2 = 0;
+    GPUCC_RESULT                            result;
+
+    gpuccSetWorkerCompilerFactory(gpuccCreateCompilerTest);
+    gpuccRunWorkerProcess(argc, argv);
+
+    if (gpuccFailure(gpuccStartup(GPUCC_USAGE_MODE_OFFLINE))) {
+        fprintf(stderr, "test_worker_pool: gpuccStartup failed.\n");
+        return 1;
+    }
+    /* This executable hosts its own workers. A short reply timeout keeps the hang test quick. */
+    pool_init.HostPath                 = "/proc/self/exe";
+    pool_init.WorkerCount              = 1;
+    pool_init.ReplyTimeoutMilliseconds = 500;
+    if ((pool = gpuccCreateWorkerProcessPoolEx(&pool_init)) == nullptr) {
+        fprintf(stderr, "test_worker_pool: gpuccCreateWorkerProcessPoolEx failed: %s.\n", gpuccErrorString(gpuccGetLastResult().LibraryResult));
+        gpuccShutdown();
+        return 1;
+    }
+    handler.Resolve                = gpuccTestResolveInclude;
+    handler.Release                = gpuccTestReleaseInclude;
+    compiler_init.TargetProfile    = "test";
+    compiler_init.IncludeHandler   = &handler;
+    compiler_init.WorkerPool       = pool;
+    compiler  = gpuccCreateCompilerTest(&compiler_init);
+    container = (compiler != nullptr) ? gpuccCreateBytecodeContainer(compiler) : nullptr;
+    GPUCC_TEST_CHECK(container != nullptr);
+    if (container == nullptr) {
+        gpuccDeleteCompiler(compiler);
+        gpuccDeleteWorkerProcessPool(pool);
+        gpuccShutdown();
+        return 1;
+    }
+
+    /* The compile runs in a worker, not in this process. */
+    pid0 = gpuccTestCompile(container, "void main() {}", &result);
+    GPUCC_TEST_CHECK(gpuccSuccess(result));
+    GPUCC_TEST_CHECK(pid0 != 0 && pid0 != (int) getpid());
+
+    /* Include requests are forwarded to the handler in this process. */
+    pid1 = gpuccTestCompile(container, "include", &result);
+    GPUCC_TEST_CHECK(gpuccSuccess(result));
+    GPUCC_TEST_CHECK(pid1 == pid0);
+    GPUCC_TEST_CHECK(strstr((char const*) gpuccQueryBytecodeBuffer(container), "COMMON") != nullptr);
+
+    /* A crashing backend fails the compile, and the worker is restarted for the next one. */
+    pid1 = gpuccTestCompile(container, "crash", &result);
+    GPUCC_TEST_CHECK(result.LibraryResult == GPUCC_RESULT_CODE_COMPILE_FAILED);
+    log  = gpuccQueryBytecodeLogBuffer(container);
+    GPUCC_TEST_CHECK(log != nullptr && strstr(log, "exited unexpectedly") != nullptr);
+    pid1 = gpuccTestCompile(container, "void main() { }", &result);
+    GPUCC_TEST_CHECK(gpuccSuccess(result));
+    GPUCC_TEST_CHECK(pid1 != 0 && pid1 != pid0);
+
+    /* A backend that stops responding is killed once the reply timeout elapses. */
+    pid2 = gpuccTestCompile(container, "hang", &result);
+    GPUCC_TEST_CHECK(result.LibraryResult == GPUCC_RESULT_CODE_COMPILE_FAILED);
+    log  = gpuccQueryBytecodeLogBuffer(container);
+    GPUCC_TEST_CHECK(log != nullptr && strstr(log, "did not respond") != nullptr);
+    pid2 = gpuccTestCompile(container, "void main() {  }", &result);
+    GPUCC_TEST_CHECK(gpuccSuccess(result));
+    GPUCC_TEST_CHECK(pid2 != 0 && pid2 != pid1);
+
+    /* Cancelling a compile kills the worker running it. */
+    gpuccResetBytecodeContainer(container);
+    job = gpuccCompileProgramBytecodeAsync(container, "hang ", 5, "test.glsl", "main");
+    GPUCC_TEST_CHECK(job != nullptr);
+    if (job != nullptr) {
+        usleep(50000);
+        gpuccCancelCompileJob(job);
+        result = gpuccWaitCompileJob(job, GPUCC_WAIT_INFINITE);
+        GPUCC_TEST_CHECK(result.LibraryResult == GPUCC_RESULT_CODE_CANCELLED);
+        gpuccDeleteCompileJob(job);
+    }
+    pid0 = gpuccTestCompile(container, "void main() {   }", &result);
+    GPUCC_TEST_CHECK(gpuccSuccess(result));
+    GPUCC_TEST_CHECK(pid0 != 0 && pid0 != pid2);
+
+    /* A worker retires after the number of compiles set by the recycling policy. The current worker has served one compile, so it retires after the next one. */
+    compiler_init.RecycleCompileCount = 2;
+    compiler_init.IncludeHandler      = nullptr;
+    retiring = gpuccCreateCompilerTest(&compiler_init);
+    retired  = (retiring != nullptr) ? gpuccCreateBytecodeContainer(retiring) : nullptr;
+    GPUCC_TEST_CHECK(retired != nullptr);
+    if (retired != nullptr) {
+        pid1 = gpuccTestCompile(retired, "void main() { return; }", &result);
+        GPUCC_TEST_CHECK(pid1 != 0 && pid1 == pid0);
+        pid2 = gpuccTestCompile(retired, "void main() {  return; }", &result);
+        GPUCC_TEST_CHECK(pid2 != 0 && pid2 != pid1);
+        pid0 = gpuccTestCompile(retired, "void main() {   return; }", &result);
+        GPUCC_TEST_CHECK(pid0 != 0 && pid0 == pid2);
+        pid1 = gpuccTestCompile(retired, "void main() {    return; }", &result);
+        GPUCC_TEST_CHECK(pid1 != 0 && pid1 != pid0);
+        gpuccDeleteBytecodeContainer(retired);
+    }
+    gpuccDeleteCompiler(retiring);
+
+    gpuccDeleteBytecodeContainer(container);
+    gpuccDeleteCompiler(compiler);
+    gpuccDeleteWorkerProcessPool(pool);
+    gpuccShutdown();
+    if (g_FailureCount != 0) {
+        fprintf(stderr, "test_worker_pool: %d check(s) failed.\n", g_FailureCount);
+        return 1;
+    }
+    printf("test_worker_pool: all checks passed.\n");
+    return 0;
+}
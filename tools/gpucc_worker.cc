@@ -0,0 +1,19 @@
+/**
+ * @summary gpucc_worker.cc: Implement the default host executable of worker
+ * process pools, which gpuccCreateWorkerProcessPool starts from the directory
+ * containing libgpucc.so. The process serves as the zygote of one pool, and
+ * does nothing when run by hand.
+ */
+#include <stdio.h>
+#include "gpucc.h"
+
+int main
+(
+    int    argc,
+    char **argv
+)
+{
+    gpuccRunWorkerProcess(argc, argv);
+    fprintf(stderr, "gpucc_worker: This program is started by GpuCC worker process pools and cannot be run directly.\n");
+    return 1;
+}